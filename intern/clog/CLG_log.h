@@ -139,6 +139,13 @@ void CLG_exit(void);
 void CLG_output_set(void *file_handle);
 void CLG_output_use_basename_set(int value);
 void CLG_output_use_timestamp_set(int value);
+/**
+ * Queue messages in a ring buffer, a drain thread formats and writes them out,
+ * so logging threads aren't slowed down by I/O (requires WITH_CLOG_PTHREADS).
+ */
+void CLG_output_buffered_set(int value);
+/** Write out queued messages, intended for crash handlers. */
+void CLG_buffered_flush(void);
 void CLG_fatal_fn_set(void (*fatal_fn)(void *file_handle));
 void CLG_backtrace_fn_set(void (*fatal_fn)(void *file_handle));
 
@@ -77,6 +77,8 @@ typedef struct CLogContext {
   CLG_LogType *types;
 #ifdef WITH_CLOG_PTHREADS
   pthread_mutex_t types_lock;
+  /** Optional deferred output, NULL when writing directly (the default). */
+  struct CLogRingBuffer *ring;
 #endif
 
   /* exclude, include filters.  */
@@ -382,10 +384,9 @@ static uint64_t clg_timestamp_ticks_get(void)
 /** \name Logging API
  * \{ */
 
-static void write_timestamp(CLogStringBuf *cstr, const uint64_t timestamp_tick_start)
+static void write_timestamp(CLogStringBuf *cstr, const uint64_t timestamp)
 {
   char timestamp_str[64];
-  const uint64_t timestamp = clg_timestamp_ticks_get() - timestamp_tick_start;
   const uint timestamp_len = snprintf(timestamp_str,
                                       sizeof(timestamp_str),
                                       "%" PRIu64 ".%03u ",
@@ -439,34 +440,274 @@ static void write_file_line_fn(CLogStringBuf *cstr,
   clg_str_append(cstr, ": ");
 }
 
-void CLG_log_str(CLG_LogType *lg,
-                 enum CLG_Severity severity,
-                 const char *file_line,
-                 const char *fn,
-                 const char *message)
+static void clg_write_message(CLogContext *ctx,
+                              CLG_LogType *lg,
+                              enum CLG_Severity severity,
+                              uint64_t timestamp,
+                              const char *file_line,
+                              const char *fn,
+                              const char *message)
 {
   CLogStringBuf cstr;
   char cstr_stack_buf[CLOG_BUF_LEN_INIT];
   clg_str_init(&cstr, cstr_stack_buf, sizeof(cstr_stack_buf));
 
-  if (lg->ctx->use_timestamp) {
-    write_timestamp(&cstr, lg->ctx->timestamp_tick_start);
+  if (ctx->use_timestamp) {
+    write_timestamp(&cstr, timestamp - ctx->timestamp_tick_start);
   }
 
-  write_severity(&cstr, severity, lg->ctx->use_color);
+  write_severity(&cstr, severity, ctx->use_color);
   write_type(&cstr, lg);
 
   {
-    write_file_line_fn(&cstr, file_line, fn, lg->ctx->use_basename);
+    write_file_line_fn(&cstr, file_line, fn, ctx->use_basename);
     clg_str_append(&cstr, message);
   }
   clg_str_append(&cstr, "\n");
 
   /* could be optional */
-  int bytes_written = write(lg->ctx->output, cstr.data, cstr.len);
+  int bytes_written = write(ctx->output, cstr.data, cstr.len);
   (void)bytes_written;
 
   clg_str_free(&cstr);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Deferred Output Ring Buffer
+ *
+ * Optional backend that only stores the message in a fixed size ring from the
+ * logging thread, a drain thread formats and writes the output. Slots are
+ * handed over lock-free (sequence counters, see #clg_ring_slot_acquire), so
+ * logging threads never wait on each other or on I/O.
+ * \{ */
+
+#ifdef WITH_CLOG_PTHREADS
+
+/** Must be a power of two. */
+#  define CLOG_RING_SLOTS 1024
+#  define CLOG_RING_MESSAGE_LEN 512
+
+typedef struct CLogRingSlot {
+  /**
+   * Hand-off counter: `pos` while a producer may claim the slot,
+   * `pos + 1` once the fields below are complete and the drain thread may
+   * read them, `pos + CLOG_RING_SLOTS` when the slot is free again.
+   */
+  uint64_t seq;
+
+  CLG_LogType *type;
+  enum CLG_Severity severity;
+  uint64_t timestamp;
+  /** Static strings from the CLOG macros, never freed. */
+  const char *file_line;
+  const char *fn;
+  /** Formatted message, truncated when it doesn't fit. */
+  char message[CLOG_RING_MESSAGE_LEN];
+} CLogRingSlot;
+
+typedef struct CLogRingBuffer {
+  CLogRingSlot slots[CLOG_RING_SLOTS];
+  /** Next sequence to reserve, any thread. */
+  uint64_t head;
+  /** Next sequence to write out, drain thread (guarded by #drain_mutex). */
+  uint64_t tail;
+  /** Messages lost because the ring was full. */
+  uint32_t dropped;
+
+  bool drain_exit;
+  pthread_t drain_thread;
+  /** Serializes draining (the drain thread and explicit flushes). */
+  pthread_mutex_t drain_mutex;
+} CLogRingBuffer;
+
+/** Atomic load, the add is only used for its barrier. */
+static uint64_t clg_ring_seq_load(uint64_t *p)
+{
+  return atomic_add_and_fetch_uint64(p, 0);
+}
+
+/**
+ * Reserve a slot for writing, returns NULL (dropping the message) when the
+ * ring is full, which beats blocking the logging thread behind I/O.
+ * Fill in the fields then call #clg_ring_slot_commit.
+ */
+static CLogRingSlot *clg_ring_slot_acquire(CLogRingBuffer *ring, uint64_t *r_pos)
+{
+  uint64_t pos = clg_ring_seq_load(&ring->head);
+  while (true) {
+    CLogRingSlot *slot = &ring->slots[pos & (CLOG_RING_SLOTS - 1)];
+    const uint64_t seq = clg_ring_seq_load(&slot->seq);
+    const int64_t dif = (int64_t)seq - (int64_t)pos;
+
+    if (dif == 0) {
+      if (atomic_cas_uint64(&ring->head, pos, pos + 1) == pos) {
+        *r_pos = pos;
+        return slot;
+      }
+    }
+    else if (dif < 0) {
+      atomic_fetch_and_add_uint32(&ring->dropped, 1);
+      return NULL;
+    }
+    /* Another thread claimed this position, try again from the new head. */
+    pos = clg_ring_seq_load(&ring->head);
+  }
+}
+
+static void clg_ring_slot_commit(CLogRingSlot *slot, uint64_t pos)
+{
+  /* The CAS is also the write barrier for the slot fields. */
+  atomic_cas_uint64(&slot->seq, pos, pos + 1);
+}
+
+/** Write out the oldest completed slot if any, drain_mutex must be held. */
+static bool clg_ring_drain_one(CLogContext *ctx, CLogRingBuffer *ring)
+{
+  const uint64_t pos = ring->tail;
+  CLogRingSlot *slot = &ring->slots[pos & (CLOG_RING_SLOTS - 1)];
+
+  if (clg_ring_seq_load(&slot->seq) != pos + 1) {
+    return false;
+  }
+
+  clg_write_message(
+      ctx, slot->type, slot->severity, slot->timestamp, slot->file_line, slot->fn, slot->message);
+
+  /* Hand the slot back to the producers. */
+  atomic_cas_uint64(&slot->seq, pos + 1, pos + CLOG_RING_SLOTS);
+  ring->tail = pos + 1;
+  return true;
+}
+
+static void clg_ring_drain_all(CLogContext *ctx, CLogRingBuffer *ring)
+{
+  while (clg_ring_drain_one(ctx, ring)) {
+    /* pass */
+  }
+
+  const uint32_t dropped = atomic_fetch_and_add_uint32(&ring->dropped, 0);
+  if (dropped != 0 && atomic_cas_uint32(&ring->dropped, dropped, 0) == dropped) {
+    char message[64];
+    const int message_len = snprintf(
+        message, sizeof(message), "%u log messages dropped (ring buffer full)\n", dropped);
+    int bytes_written = write(ctx->output, message, message_len);
+    (void)bytes_written;
+  }
+}
+
+static void *clg_ring_drain_thread_fn(void *arg)
+{
+  CLogContext *ctx = arg;
+  /* Keep a direct pointer, `ctx->ring` is cleared before this thread joins. */
+  CLogRingBuffer *ring = ctx->ring;
+
+  while (true) {
+    pthread_mutex_lock(&ring->drain_mutex);
+    clg_ring_drain_all(ctx, ring);
+    pthread_mutex_unlock(&ring->drain_mutex);
+
+    if (ring->drain_exit) {
+      break;
+    }
+
+#  ifdef _MSC_VER
+    Sleep(10);
+#  else
+    usleep(10000);
+#  endif
+  }
+  return NULL;
+}
+
+/**
+ * Write out everything completed so far. Safe to call from a crash handler:
+ * when the drain thread holds the mutex it is already writing, don't wait.
+ */
+static void clg_ctx_ring_flush(CLogContext *ctx)
+{
+  CLogRingBuffer *ring = ctx->ring;
+  if (ring == NULL) {
+    return;
+  }
+  if (pthread_mutex_trylock(&ring->drain_mutex) == 0) {
+    clg_ring_drain_all(ctx, ring);
+    pthread_mutex_unlock(&ring->drain_mutex);
+  }
+  fflush(ctx->output_file);
+}
+
+static void CLG_ctx_output_buffered_set(CLogContext *ctx, int value)
+{
+  if ((ctx->ring != NULL) == (bool)value) {
+    return;
+  }
+
+  if (value) {
+    CLogRingBuffer *ring = MEM_callocN(sizeof(*ring), __func__);
+    for (uint64_t i = 0; i < CLOG_RING_SLOTS; i++) {
+      ring->slots[i].seq = i;
+    }
+    pthread_mutex_init(&ring->drain_mutex, NULL);
+    ctx->ring = ring;
+    pthread_create(&ring->drain_thread, NULL, clg_ring_drain_thread_fn, ctx);
+  }
+  else {
+    CLogRingBuffer *ring = ctx->ring;
+    /* New messages write directly again, the drain thread writes out the
+     * remainder before it exits. */
+    ctx->ring = NULL;
+    ring->drain_exit = true;
+    pthread_join(ring->drain_thread, NULL);
+    pthread_mutex_destroy(&ring->drain_mutex);
+    MEM_freeN(ring);
+  }
+}
+
+#endif /* WITH_CLOG_PTHREADS */
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Logging API (Public)
+ * \{ */
+
+void CLG_log_str(CLG_LogType *lg,
+                 enum CLG_Severity severity,
+                 const char *file_line,
+                 const char *fn,
+                 const char *message)
+{
+#ifdef WITH_CLOG_PTHREADS
+  if (lg->ctx->ring != NULL) {
+    uint64_t pos;
+    CLogRingSlot *slot = clg_ring_slot_acquire(lg->ctx->ring, &pos);
+    if (slot != NULL) {
+      slot->type = lg;
+      slot->severity = severity;
+      slot->timestamp = clg_timestamp_ticks_get();
+      slot->file_line = file_line;
+      slot->fn = fn;
+      snprintf(slot->message, sizeof(slot->message), "%s", message);
+      clg_ring_slot_commit(slot, pos);
+    }
+
+    /* Don't hold back errors or back-traces, regular messages stay queued. */
+    if (severity >= CLG_SEVERITY_ERROR || lg->ctx->callbacks.backtrace_fn) {
+      clg_ctx_ring_flush(lg->ctx);
+    }
+    if (lg->ctx->callbacks.backtrace_fn) {
+      clg_ctx_backtrace(lg->ctx);
+    }
+    if (severity == CLG_SEVERITY_FATAL) {
+      clg_ctx_fatal_action(lg->ctx);
+    }
+    return;
+  }
+#endif
+
+  clg_write_message(lg->ctx, lg, severity, clg_timestamp_ticks_get(), file_line, fn, message);
 
   if (lg->ctx->callbacks.backtrace_fn) {
     clg_ctx_backtrace(lg->ctx);
@@ -484,12 +725,45 @@ void CLG_logf(CLG_LogType *lg,
               const char *fmt,
               ...)
 {
+#ifdef WITH_CLOG_PTHREADS
+  if (lg->ctx->ring != NULL) {
+    uint64_t pos;
+    CLogRingSlot *slot = clg_ring_slot_acquire(lg->ctx->ring, &pos);
+    if (slot != NULL) {
+      slot->type = lg;
+      slot->severity = severity;
+      slot->timestamp = clg_timestamp_ticks_get();
+      slot->file_line = file_line;
+      slot->fn = fn;
+
+      va_list ap;
+      va_start(ap, fmt);
+      vsnprintf(slot->message, sizeof(slot->message), fmt, ap);
+      va_end(ap);
+
+      clg_ring_slot_commit(slot, pos);
+    }
+
+    /* Don't hold back errors or back-traces, regular messages stay queued. */
+    if (severity >= CLG_SEVERITY_ERROR || lg->ctx->callbacks.backtrace_fn) {
+      clg_ctx_ring_flush(lg->ctx);
+    }
+    if (lg->ctx->callbacks.backtrace_fn) {
+      clg_ctx_backtrace(lg->ctx);
+    }
+    if (severity == CLG_SEVERITY_FATAL) {
+      clg_ctx_fatal_action(lg->ctx);
+    }
+    return;
+  }
+#endif
+
   CLogStringBuf cstr;
   char cstr_stack_buf[CLOG_BUF_LEN_INIT];
   clg_str_init(&cstr, cstr_stack_buf, sizeof(cstr_stack_buf));
 
   if (lg->ctx->use_timestamp) {
-    write_timestamp(&cstr, lg->ctx->timestamp_tick_start);
+    write_timestamp(&cstr, clg_timestamp_ticks_get() - lg->ctx->timestamp_tick_start);
   }
 
   write_severity(&cstr, severity, lg->ctx->use_color);
@@ -610,6 +884,10 @@ static CLogContext *CLG_ctx_init(void)
 
 static void CLG_ctx_free(CLogContext *ctx)
 {
+#ifdef WITH_CLOG_PTHREADS
+  CLG_ctx_output_buffered_set(ctx, false);
+#endif
+
   while (ctx->types != NULL) {
     CLG_LogType *item = ctx->types;
     ctx->types = item->next;
@@ -667,6 +945,25 @@ void CLG_output_use_timestamp_set(int value)
   CLG_ctx_output_use_timestamp_set(g_ctx, value);
 }
 
+void CLG_output_buffered_set(int value)
+{
+#ifdef WITH_CLOG_PTHREADS
+  CLG_ctx_output_buffered_set(g_ctx, value);
+#else
+  (void)value;
+#endif
+}
+
+void CLG_buffered_flush(void)
+{
+#ifdef WITH_CLOG_PTHREADS
+  /* May run from a crash handler, before initialization even. */
+  if (g_ctx != NULL) {
+    clg_ctx_ring_flush(g_ctx);
+  }
+#endif
+}
+
 void CLG_fatal_fn_set(void (*fatal_fn)(void *file_handle))
 {
   CLG_ctx_fatal_fn_set(g_ctx, fatal_fn);
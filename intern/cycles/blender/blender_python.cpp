@@ -949,6 +949,49 @@ static PyObject *enable_print_stats_func(PyObject * /*self*/, PyObject * /*args*
   Py_RETURN_NONE;
 }
 
+static PyObject *live_statistics_func(PyObject * /*self*/, PyObject *args)
+{
+  PyObject *pysession;
+
+  if (!PyArg_ParseTuple(args, "O", &pysession))
+    return NULL;
+
+  BlenderSession *session = (BlenderSession *)PyLong_AsVoidPtr(pysession);
+
+  LiveRenderStats stats;
+  if (session->session) {
+    session->session->get_live_statistics(&stats);
+  }
+
+  PyObject *dict = PyDict_New();
+
+  PyObject *value = PyLong_FromSize_t(stats.mem_used);
+  PyDict_SetItemString(dict, "mem_used", value);
+  Py_DECREF(value);
+
+  value = PyLong_FromSize_t(stats.mem_peak);
+  PyDict_SetItemString(dict, "mem_peak", value);
+  Py_DECREF(value);
+
+  value = PyFloat_FromDouble(stats.render_time);
+  PyDict_SetItemString(dict, "render_time", value);
+  Py_DECREF(value);
+
+  value = PyFloat_FromDouble(stats.samples_per_second);
+  PyDict_SetItemString(dict, "samples_per_second", value);
+  Py_DECREF(value);
+
+  value = PyFloat_FromDouble(stats.traversal_time);
+  PyDict_SetItemString(dict, "traversal_time", value);
+  Py_DECREF(value);
+
+  value = PyFloat_FromDouble(stats.shading_time);
+  PyDict_SetItemString(dict, "shading_time", value);
+  Py_DECREF(value);
+
+  return dict;
+}
+
 static PyObject *get_device_types_func(PyObject * /*self*/, PyObject * /*args*/)
 {
   vector<DeviceType> device_types = Device::available_types();
@@ -996,6 +1039,7 @@ static PyMethodDef methods[] = {
 
     /* Statistics. */
     {"enable_print_stats", enable_print_stats_func, METH_NOARGS, ""},
+    {"live_statistics", live_statistics_func, METH_VARARGS, ""},
 
     /* Resumable render */
     {"set_resumable_chunk", set_resumable_chunk_func, METH_VARARGS, ""},
@@ -655,8 +655,12 @@ void BlenderSession::bake(BL::Depsgraph &b_depsgraph_,
   ShaderEvalType shader_type = get_shader_type(pass_type);
   int bake_pass_filter = bake_pass_filter_get(pass_filter);
 
-  /* Initialize bake manager, before we load the baking kernels. */
-  scene->bake_manager->set(scene, b_object.name(), shader_type, bake_pass_filter);
+  /* Initialize bake manager, before we load the baking kernels. The bake
+   * operator submits a single object per call, but the manager accepts a
+   * list so multiple objects can be baked in one session. */
+  vector<string> bake_object_names;
+  bake_object_names.push_back(b_object.name());
+  scene->bake_manager->set(scene, bake_object_names, shader_type, bake_pass_filter);
 
   /* Passes are identified by name, so in order to return the combined pass we need to set the
    * name. */
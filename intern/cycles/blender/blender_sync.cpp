@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <stdlib.h>
+
 #include "render/background.h"
 #include "render/camera.h"
 #include "render/curves.h"
@@ -295,6 +297,18 @@ void BlenderSync::sync_integrator()
   integrator->sample_all_lights_indirect = get_boolean(cscene, "sample_all_lights_indirect");
   integrator->light_sampling_threshold = get_float(cscene, "light_sampling_threshold");
 
+  integrator->use_light_tree = get_boolean(cscene, "use_light_tree");
+  /* The tree is built along with the light distribution, and only used by the
+   * path integrator. Compare the effective state so switching the method also
+   * rebuilds the distribution and the kernel flag that comes with it. */
+  const bool use_light_tree = integrator->use_light_tree &&
+                              integrator->method == Integrator::PATH;
+  const bool prev_use_light_tree = previntegrator.use_light_tree &&
+                                   previntegrator.method == Integrator::PATH;
+  if (use_light_tree != prev_use_light_tree) {
+    scene->light_manager->need_update = true;
+  }
+
   if (RNA_boolean_get(&cscene, "use_adaptive_sampling")) {
     integrator->sampling_pattern = SAMPLING_PATTERN_PMJ;
     integrator->adaptive_min_samples = get_int(cscene, "adaptive_min_samples");
@@ -751,6 +765,14 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
     params.texture_limit = 0;
   }
 
+  /* No UI for the texture cache yet, expose it through an environment
+   * variable giving the cache budget in megabytes. */
+  const char *texture_cache_size = getenv("CYCLES_TEXTURE_CACHE_SIZE");
+  if (texture_cache_size && atoi(texture_cache_size) > 0) {
+    params.use_texture_cache = true;
+    params.texture_cache_size = atoi(texture_cache_size);
+  }
+
   /* TODO(sergey): Once OSL supports per-microarchitecture optimization get
    * rid of this.
    */
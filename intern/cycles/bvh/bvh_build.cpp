@@ -20,6 +20,7 @@
 #include "bvh/bvh_binning.h"
 #include "bvh/bvh_node.h"
 #include "bvh/bvh_params.h"
+#include "bvh/bvh_sort.h"
 #include "bvh_split.h"
 
 #include "render/curves.h"
@@ -54,6 +55,15 @@ class BVHBuildTask : public Task {
   BVHObjectBinning range_;
 };
 
+class BVHMortonClusterTask : public Task {
+ public:
+  BVHMortonClusterTask(BVHBuild *build, InnerNode *node, int child, int start, int size, int level)
+  {
+    run = function_bind(
+        &BVHBuild::thread_build_morton_cluster, build, node, child, start, size, level);
+  }
+};
+
 class BVHSpatialSplitBuildTask : public Task {
  public:
   BVHSpatialSplitBuildTask(BVHBuild *build,
@@ -468,6 +478,11 @@ BVHNode *BVHBuild::run()
     rootnode = build_node(root, &references, 0, 0);
     task_pool.wait_work();
   }
+  else if (use_morton_pre_cluster(root)) {
+    /* Pre-cluster references along a morton curve and run the binned builder
+     * on the resulting subtrees in parallel (waits on its own tasks). */
+    rootnode = build_node_morton(root);
+  }
   else {
     /* Perform multithreaded binning build. */
     BVHObjectBinning rootbin(root, (references.size()) ? &references[0] : NULL);
@@ -686,6 +701,112 @@ BVHNode *BVHBuild::build_node(const BVHObjectBinning &range, int level)
   return inner;
 }
 
+/* multithreaded morton curve pre-cluster builder
+ *
+ * The binned builder only goes wide once enough subtrees have been split off,
+ * which leaves most threads idle while the top of the tree is built. For large
+ * reference counts the references are first partitioned along a 30bit morton
+ * curve, whose upper splits are simple bit searches on the sorted array, and
+ * the regular binned builder runs on the resulting clusters in parallel. */
+
+bool BVHBuild::use_morton_pre_cluster(const BVHRange &root) const
+{
+  /* Spatial splits reorder and duplicate references during the build, and
+   * unaligned nodes need their heuristic on every level. Both are
+   * incompatible with a fixed upfront clustering. */
+  return !params.use_spatial_split && !params.use_unaligned_nodes &&
+         root.size() >= MORTON_CLUSTER_SIZE * 2;
+}
+
+int BVHBuild::morton_find_split(int start, int end, uint mask) const
+{
+  /* References are sorted along the curve, binary search the first one with
+   * the bit set. */
+  int lo = start, hi = end;
+  while (lo < hi) {
+    const int mid = lo + ((hi - lo) >> 1);
+    if (bvh_reference_morton_code(references[mid], morton_base, morton_scale) & mask) {
+      hi = mid;
+    }
+    else {
+      lo = mid + 1;
+    }
+  }
+  return lo;
+}
+
+void BVHBuild::build_morton_subtree(
+    InnerNode *parent, int child, int start, int end, int bit, int level)
+{
+  if (end - start <= MORTON_CLUSTER_SIZE || bit < 0) {
+    task_pool.push(new BVHMortonClusterTask(this, parent, child, start, end - start, level), true);
+    return;
+  }
+
+  const int split = morton_find_split(start, end, 1u << bit);
+  if (split == start || split == end) {
+    /* All codes agree on this bit, try the next one on the same range. */
+    build_morton_subtree(parent, child, start, end, bit - 1, level);
+    return;
+  }
+
+  /* Bounds are not known yet, they are refit once the clusters are built. */
+  InnerNode *inner = new InnerNode(BoundBox(BoundBox::empty));
+  parent->children[child] = inner;
+  morton_top_nodes.push_back(inner);
+
+  build_morton_subtree(inner, 0, start, split, bit - 1, level + 1);
+  build_morton_subtree(inner, 1, split, end, bit - 1, level + 1);
+}
+
+BVHNode *BVHBuild::build_node_morton(const BVHRange &root)
+{
+  /* Normalize centroids onto the morton grid. */
+  const BoundBox &cent_bounds = root.cent_bounds();
+  morton_base = cent_bounds.min;
+  morton_scale = bvh_morton_scale(cent_bounds);
+
+  /* Parallel sort of the references along the curve. */
+  bvh_reference_sort_morton(root.start(), root.end(), &references[0], cent_bounds);
+
+  /* Serial top-down split on the code bits, cluster builds go to the task
+   * pool. The dummy parent receives the root node, which can also come from
+   * a task when all references fall into a single cluster. */
+  morton_top_nodes.clear();
+  const BoundBox empty_bounds = BoundBox::empty;
+  InnerNode root_holder(empty_bounds);
+  build_morton_subtree(&root_holder, 0, root.start(), root.end(), 29, 0);
+  task_pool.wait_work();
+
+  /* Top nodes were created before their children, refit bounds in reverse. */
+  for (int i = (int)morton_top_nodes.size() - 1; i >= 0; i--) {
+    InnerNode *inner = morton_top_nodes[i];
+    if (inner->children[0] && inner->children[1]) {
+      inner->bounds = merge(inner->children[0]->bounds, inner->children[1]->bounds);
+    }
+  }
+
+  return root_holder.children[0];
+}
+
+void BVHBuild::thread_build_morton_cluster(
+    InnerNode *inner, int child, int start, int size, int level)
+{
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  /* Compute cluster bounds, the top-down clustering never looked at them. */
+  BoundBox bounds = BoundBox::empty, cent_bounds = BoundBox::empty;
+  for (int i = start; i < start + size; i++) {
+    bounds.grow(references[i].bounds());
+    cent_bounds.grow(references[i].bounds().center2());
+  }
+
+  BVHObjectBinning range(BVHRange(bounds, cent_bounds, start, size), &references[0]);
+  thread_build_node(inner, child, &range, level);
+}
+
 /* multithreaded spatial split builder */
 BVHNode *BVHBuild::build_node(const BVHRange &range,
                               vector<BVHReference> *references,
@@ -31,6 +31,7 @@ CCL_NAMESPACE_BEGIN
 
 class Boundbox;
 class BVHBuildTask;
+class BVHMortonClusterTask;
 class BVHNode;
 class BVHSpatialSplitBuildTask;
 class BVHParams;
@@ -62,6 +63,7 @@ class BVHBuild {
   friend class BVHObjectSplit;
   friend class BVHSpatialSplit;
   friend class BVHBuildTask;
+  friend class BVHMortonClusterTask;
   friend class BVHSpatialSplitBuildTask;
   friend class BVHObjectBinning;
 
@@ -95,6 +97,17 @@ class BVHBuild {
                                        int thread_id);
   thread_mutex build_mutex;
 
+  /* Morton curve pre-clustering of the upper tree. */
+  enum { MORTON_CLUSTER_SIZE = 64 * THREAD_TASK_SIZE };
+  bool use_morton_pre_cluster(const BVHRange &root) const;
+  BVHNode *build_node_morton(const BVHRange &root);
+  void build_morton_subtree(InnerNode *parent, int child, int start, int end, int bit, int level);
+  int morton_find_split(int start, int end, uint mask) const;
+  void thread_build_morton_cluster(InnerNode *node, int child, int start, int size, int level);
+  float3 morton_base;
+  float3 morton_scale;
+  vector<InnerNode *> morton_top_nodes;
+
   /* Progress. */
   void progress_update();
 
@@ -23,6 +23,11 @@
  * This implementation shares RTCDevices between Cycles instances. Eventually each instance should
  * get a separate RTCDevice to correctly keep track of memory usage.
  *
+ * Each Geometry owns a single BVH and thus a single RTCScene, which all objects instancing that
+ * geometry reference through RTC_GEOMETRY_TYPE_INSTANCE, so instanced meshes and hair never
+ * duplicate their bottom level acceleration structure. Hair uses Embree's native flat and round
+ * linear/Catmull-Rom curve primitives, selected by the curve shape and interpolation settings.
+ *
  * Vertex and index buffers are duplicated between Cycles device arrays and Embree. These could be
  * merged, which would require changes to intersection refinement, shader setup, mesh light
  * sampling and a few other places in Cycles where direct access to vertex data is required.
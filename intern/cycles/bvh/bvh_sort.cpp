@@ -26,16 +26,64 @@ CCL_NAMESPACE_BEGIN
 
 static const int BVH_SORT_THRESHOLD = 4096;
 
+/* Interleave the lower 10 bits with two zero bits in between. */
+static __forceinline uint bvh_morton_spread_bits(uint x)
+{
+  x = (x | (x << 16)) & 0x030000FF;
+  x = (x | (x << 8)) & 0x0300F00F;
+  x = (x | (x << 4)) & 0x030C30C3;
+  x = (x | (x << 2)) & 0x09249249;
+  return x;
+}
+
+float3 bvh_morton_scale(const BoundBox &cent_bounds)
+{
+  const float3 size = cent_bounds.size();
+  return make_float3(size.x > 0.0f ? 1023.0f / size.x : 0.0f,
+                     size.y > 0.0f ? 1023.0f / size.y : 0.0f,
+                     size.z > 0.0f ? 1023.0f / size.z : 0.0f);
+}
+
+uint bvh_reference_morton_code(const BVHReference &ref, const float3 &base, const float3 &scale)
+{
+  const float3 cent = ref.bounds().center2();
+  const uint x = (uint)clamp((cent.x - base.x) * scale.x, 0.0f, 1023.0f);
+  const uint y = (uint)clamp((cent.y - base.y) * scale.y, 0.0f, 1023.0f);
+  const uint z = (uint)clamp((cent.z - base.z) * scale.z, 0.0f, 1023.0f);
+  return (bvh_morton_spread_bits(x) << 2) | (bvh_morton_spread_bits(y) << 1) |
+         bvh_morton_spread_bits(z);
+}
+
 struct BVHReferenceCompare {
  public:
   int dim;
   const BVHUnaligned *unaligned_heuristic;
   const Transform *aligned_space;
 
+  /* Sort along the morton curve instead of a single dimension. */
+  bool use_morton;
+  float3 morton_base;
+  float3 morton_scale;
+
   BVHReferenceCompare(int dim,
                       const BVHUnaligned *unaligned_heuristic,
                       const Transform *aligned_space)
-      : dim(dim), unaligned_heuristic(unaligned_heuristic), aligned_space(aligned_space)
+      : dim(dim),
+        unaligned_heuristic(unaligned_heuristic),
+        aligned_space(aligned_space),
+        use_morton(false),
+        morton_base(make_float3(0.0f, 0.0f, 0.0f)),
+        morton_scale(make_float3(0.0f, 0.0f, 0.0f))
+  {
+  }
+
+  explicit BVHReferenceCompare(const BoundBox &cent_bounds)
+      : dim(0),
+        unaligned_heuristic(NULL),
+        aligned_space(NULL),
+        use_morton(true),
+        morton_base(cent_bounds.min),
+        morton_scale(bvh_morton_scale(cent_bounds))
   {
   }
 
@@ -52,15 +100,27 @@ struct BVHReferenceCompare {
    */
   __forceinline int compare(const BVHReference &ra, const BVHReference &rb) const
   {
-    BoundBox ra_bounds = get_prim_bounds(ra), rb_bounds = get_prim_bounds(rb);
-    float ca = ra_bounds.min[dim] + ra_bounds.max[dim];
-    float cb = rb_bounds.min[dim] + rb_bounds.max[dim];
+    if (use_morton) {
+      const uint code_a = bvh_reference_morton_code(ra, morton_base, morton_scale);
+      const uint code_b = bvh_reference_morton_code(rb, morton_base, morton_scale);
 
-    if (ca < cb)
-      return -1;
-    else if (ca > cb)
-      return 1;
-    else if (ra.prim_object() < rb.prim_object())
+      if (code_a < code_b)
+        return -1;
+      else if (code_a > code_b)
+        return 1;
+    }
+    else {
+      BoundBox ra_bounds = get_prim_bounds(ra), rb_bounds = get_prim_bounds(rb);
+      float ca = ra_bounds.min[dim] + ra_bounds.max[dim];
+      float cb = rb_bounds.min[dim] + rb_bounds.max[dim];
+
+      if (ca < cb)
+        return -1;
+      else if (ca > cb)
+        return 1;
+    }
+
+    if (ra.prim_object() < rb.prim_object())
       return -1;
     else if (ra.prim_object() > rb.prim_object())
       return 1;
@@ -172,15 +232,12 @@ static void bvh_reference_sort_threaded(TaskPool *task_pool,
   }
 }
 
-void bvh_reference_sort(int start,
-                        int end,
-                        BVHReference *data,
-                        int dim,
-                        const BVHUnaligned *unaligned_heuristic,
-                        const Transform *aligned_space)
+static void bvh_reference_sort_impl(int start,
+                                    int end,
+                                    BVHReference *data,
+                                    const BVHReferenceCompare &compare)
 {
   const int count = end - start;
-  BVHReferenceCompare compare(dim, unaligned_heuristic, aligned_space);
   if (count < BVH_SORT_THRESHOLD) {
     /* It is important to not use any mutex if array is small enough,
      * otherwise we end up in situation when we're going to sleep far
@@ -195,4 +252,21 @@ void bvh_reference_sort(int start,
   }
 }
 
+void bvh_reference_sort(int start,
+                        int end,
+                        BVHReference *data,
+                        int dim,
+                        const BVHUnaligned *unaligned_heuristic,
+                        const Transform *aligned_space)
+{
+  BVHReferenceCompare compare(dim, unaligned_heuristic, aligned_space);
+  bvh_reference_sort_impl(start, end, data, compare);
+}
+
+void bvh_reference_sort_morton(int start, int end, BVHReference *data, const BoundBox &cent_bounds)
+{
+  BVHReferenceCompare compare(cent_bounds);
+  bvh_reference_sort_impl(start, end, data, compare);
+}
+
 CCL_NAMESPACE_END
@@ -20,6 +20,8 @@
 
 #include <cstddef>
 
+#include "util/util_boundbox.h"
+
 CCL_NAMESPACE_BEGIN
 
 class BVHReference;
@@ -33,6 +35,17 @@ void bvh_reference_sort(int start,
                         const BVHUnaligned *unaligned_heuristic = NULL,
                         const Transform *aligned_space = NULL);
 
+/* Scale factor which maps centroids (in min+max space) of references inside
+ * cent_bounds onto the 10bit per axis morton grid. */
+float3 bvh_morton_scale(const BoundBox &cent_bounds);
+
+/* 30-bit morton code of a reference centroid on the grid defined by base and
+ * scale (see bvh_morton_scale). */
+uint bvh_reference_morton_code(const BVHReference &ref, const float3 &base, const float3 &scale);
+
+/* Sort references along the morton curve over their centroid bounds. */
+void bvh_reference_sort_morton(int start, int end, BVHReference *data, const BoundBox &cent_bounds);
+
 CCL_NAMESPACE_END
 
 #endif /* __BVH_SORT_H__ */
@@ -1106,6 +1106,33 @@ void CUDADevice::tex_alloc(device_texture &mem)
 {
   CUDAContextScope scope(this);
 
+  /* Sparse tiled volumes are sampled manually from linear memory in the
+   * kernel, no texture object is created for them. */
+  if (mem.info.sparse_data_offset) {
+    if (!mem.is_resident(this)) {
+      CUDAMem *cmem = &cuda_mem_map[&mem];
+      cmem->texobject = 0;
+    }
+    else {
+      CUDAMem *cmem = generic_alloc(mem);
+      if (!cmem) {
+        return;
+      }
+
+      cuda_assert(cuMemcpyHtoD(mem.device_pointer, mem.host_pointer, mem.memory_size()));
+    }
+
+    const uint slot = mem.slot;
+    if (slot >= texture_info.size()) {
+      texture_info.resize(slot + 128);
+    }
+
+    texture_info[slot] = mem.info;
+    texture_info[slot].data = (uint64_t)mem.device_pointer;
+    need_texture_info = true;
+    return;
+  }
+
   /* General variables for both architectures */
   string bind_name = mem.name;
   size_t dsize = datatype_size(mem.data_type);
@@ -2437,6 +2464,19 @@ void CUDADevice::task_add(DeviceTask &task)
     film_convert(task, task.buffer, task.rgba_byte, task.rgba_half);
   }
   else {
+    /* Process denoising tiles in a separate task, so the denoiser runs
+     * concurrently with path tracing of the remaining tiles. This needs two
+     * task pool threads: the denoise task blocks waiting for path traced
+     * neighbor tiles, so with a single thread it would starve the path
+     * tracing task it waits on. Fall back to one combined task then. */
+    if (task.type == DeviceTask::RENDER && (task.tile_types & RenderTile::DENOISE) &&
+        TaskScheduler::num_threads() > 1) {
+      DeviceTask denoise_task = task;
+      denoise_task.tile_types = RenderTile::DENOISE;
+      task_pool.push(new CUDADeviceTask(this, denoise_task));
+      task.tile_types &= ~RenderTile::DENOISE;
+    }
+
     task_pool.push(new CUDADeviceTask(this, task));
   }
 }
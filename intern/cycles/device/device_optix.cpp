@@ -577,11 +577,6 @@ class OptiXDevice : public CUDADevice {
       return;  // Abort early if there was an error previously
 
     if (task.type == DeviceTask::RENDER) {
-      if (thread_index != 0) {
-        // Only execute denoising in a single thread (see also 'task_add')
-        task.tile_types &= ~RenderTile::DENOISE;
-      }
-
       RenderTile tile;
       while (task.acquire_tile(this, tile, task.tile_types)) {
         if (tile.task == RenderTile::PATH_TRACE)
@@ -1487,6 +1482,21 @@ class OptiXDevice : public CUDADevice {
       return;
     }
 
+    // Process denoising tiles in a dedicated task, so the denoiser overlaps
+    // path tracing of the remaining tiles instead of serializing with it.
+    // This also keeps denoising in a single thread, which is required since
+    // there is only one denoiser state (the thread index is unused by it).
+    // Needs two task pool threads: the denoise task blocks on path traced
+    // neighbor tiles, so with a single thread it would starve the path
+    // tracing task it waits on. Fall back to one combined task then.
+    if (task.type == DeviceTask::RENDER && (task.tile_types & RenderTile::DENOISE) &&
+        TaskScheduler::num_threads() > 1) {
+      DeviceTask denoise_task = task;
+      denoise_task.tile_types = RenderTile::DENOISE;
+      task_pool.push(new OptiXDeviceTask(this, denoise_task, 0));
+      task.tile_types &= ~RenderTile::DENOISE;
+    }
+
     // Split task into smaller ones
     list<DeviceTask> tasks;
     task.split(tasks, info.cpu_threads);
@@ -237,7 +237,18 @@ ccl_device void kernel_bake_evaluate(
   if (prim == -1)
     return;
 
-  prim += kernel_data.bake.tri_offset;
+  /* With batched baking the object is looked up per pixel, with a single
+   * object it is uniform for the entire buffer. */
+  int object;
+  if (kernel_data.bake.num_objects > 1) {
+    const int4 bake_object = kernel_tex_fetch(__bake_objects, __float_as_uint(primitive[0]));
+    object = bake_object.x;
+    prim += bake_object.y;
+  }
+  else {
+    object = kernel_data.bake.object_index;
+    prim += kernel_data.bake.tri_offset;
+  }
 
   /* Random number generator. */
   uint rng_hash = hash_uint2(x, y) ^ kernel_data.integrator.seed;
@@ -267,7 +278,6 @@ ccl_device void kernel_bake_evaluate(
   }
 
   /* Shader data setup. */
-  int object = kernel_data.bake.object_index;
   int shader;
   float3 P, Ng;
 
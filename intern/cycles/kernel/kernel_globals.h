@@ -22,7 +22,9 @@
 #include "kernel/kernel_profiling.h"
 
 #ifdef __KERNEL_CPU__
+#  include "util/util_hash.h"
 #  include "util/util_map.h"
+#  include "util/util_math.h"
 #  include "util/util_vector.h"
 #endif
 
@@ -45,7 +47,81 @@ struct OSLThreadData;
 struct OSLShadingSystem;
 #  endif
 
-typedef unordered_map<float, float> CoverageMap;
+/* Flat, open addressed id -> weight map used to accumulate Cryptomatte
+ * coverage for a single pixel. A pixel only ever sees a handful of ids, so a
+ * small linear probing table backed by a single allocation avoids the per-id
+ * node allocations of unordered_map. No locking is needed since each pixel is
+ * only written by the thread rendering its tile. */
+class CoverageMap {
+ public:
+  CoverageMap() : num_used(0)
+  {
+  }
+
+  void add(const float id, const float weight)
+  {
+    /* Grow at 50% load to keep probe sequences short, also handles the
+     * initial allocation. */
+    if (num_used * 2 >= slots.size()) {
+      grow();
+    }
+
+    pair<float, float> *slot = find_slot(id);
+    if (slot->first == id_none) {
+      slot->first = id;
+      num_used++;
+    }
+    slot->second += weight;
+  }
+
+  bool empty() const
+  {
+    return num_used == 0;
+  }
+
+  /* Occupied slots in no particular order, empty slots have an id of
+   * id_none. */
+  const vector<pair<float, float>> &entries() const
+  {
+    return slots;
+  }
+
+  /* Empty slot sentinel, matches ID_NONE which the kernel never passes as a
+   * valid id. */
+  static constexpr float id_none = 0.0f;
+
+ private:
+  pair<float, float> *find_slot(const float id)
+  {
+    /* Linear probing, table size is a power of two and the load factor is
+     * kept below one so this always terminates. */
+    const size_t mask = slots.size() - 1;
+    size_t index = hash_uint(__float_as_uint(id)) & mask;
+    while (slots[index].first != id && slots[index].first != id_none) {
+      index = (index + 1) & mask;
+    }
+    return &slots[index];
+  }
+
+  void grow()
+  {
+    const size_t new_size = (slots.size() == 0) ? 16 : slots.size() * 2;
+    vector<pair<float, float>> old_slots(new_size, std::make_pair(id_none, 0.0f));
+    old_slots.swap(slots);
+    num_used = 0;
+
+    for (size_t i = 0; i < old_slots.size(); i++) {
+      if (old_slots[i].first != id_none) {
+        pair<float, float> *slot = find_slot(old_slots[i].first);
+        *slot = old_slots[i];
+        num_used++;
+      }
+    }
+  }
+
+  vector<pair<float, float>> slots;
+  size_t num_used;
+};
 
 struct Intersection;
 struct VolumeStep;
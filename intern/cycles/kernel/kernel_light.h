@@ -498,6 +498,12 @@ background_light_sample(KernelGlobals *kg, float3 P, float randu, float randv, f
 
 ccl_device float background_light_pdf(KernelGlobals *kg, float3 P, float3 direction)
 {
+  /* Probability of having selected the background light. With the light
+   * tree this is precomputed, as it does not depend on the position. */
+  const float pdf_lights = (kernel_data.integrator.use_light_tree) ?
+                               kernel_data.integrator.light_tree_background_pdf :
+                               kernel_data.integrator.pdf_lights;
+
   /* Probability of sampling portals instead of the map. */
   float portal_sampling_pdf = kernel_data.integrator.portal_pdf;
 
@@ -511,7 +517,7 @@ ccl_device float background_light_pdf(KernelGlobals *kg, float3 P, float3 direct
        * If map sampling is possible, it would be used instead,
        * otherwise fallback sampling is used. */
       if (portal_sampling_pdf == 1.0f) {
-        return kernel_data.integrator.pdf_lights / M_4PI_F;
+        return pdf_lights / M_4PI_F;
       }
       else {
         /* Force map sampling. */
@@ -523,10 +529,179 @@ ccl_device float background_light_pdf(KernelGlobals *kg, float3 P, float3 direct
     /* Evaluate PDF of sampling this direction by map sampling. */
     map_pdf = background_map_pdf(kg, direction) * (1.0f - portal_sampling_pdf);
   }
-  return (portal_pdf + map_pdf) * kernel_data.integrator.pdf_lights;
+  return (portal_pdf + map_pdf) * pdf_lights;
 }
 #endif
 
+/* Light Tree
+ *
+ * Importance based light selection for many-light scenes. Instead of picking
+ * an emitter proportional to area from the flat distribution, the tree is
+ * descended stochastically, at each node weighting the children by their
+ * energy over the squared distance to the shading point. Distant and
+ * background lights have no position and are kept in a separate segment at
+ * the end of __light_tree_emitters, selected proportional to energy. */
+
+ccl_device_inline float light_tree_emitter_energy(KernelGlobals *kg, int index)
+{
+  /* The normalized CDF delta of the flat distribution doubles as the
+   * relative energy of the emitter. */
+  return kernel_tex_fetch(__light_distribution, index + 1).totarea -
+         kernel_tex_fetch(__light_distribution, index).totarea;
+}
+
+ccl_device_inline float light_tree_node_importance(
+    const ccl_global KernelLightTreeNode *knode, float3 P)
+{
+  const float3 bounds_min = make_float3(knode->min_x, knode->min_y, knode->min_z);
+  const float3 bounds_max = make_float3(knode->max_x, knode->max_y, knode->max_z);
+  const float3 center = 0.5f * (bounds_min + bounds_max);
+
+  /* Clamp the squared distance to the bounding sphere radius, so that the
+   * importance stays finite for shading points inside or next to the node. */
+  const float d2 = max(len_squared(P - center), len_squared(bounds_max - center));
+  return knode->energy / max(d2, 1e-12f);
+}
+
+/* Stochastic traversal, returns an index into __light_distribution and
+ * rescales randu for reuse, like light_distribution_sample. */
+ccl_device int light_tree_sample(KernelGlobals *kg, float3 P, float *randu)
+{
+  const float infinite_energy = kernel_data.integrator.light_tree_infinite_energy;
+  const int num_tree = kernel_data.integrator.light_tree_num_emitters;
+  const int num_distribution = kernel_data.integrator.num_distribution;
+  float r = *randu;
+
+  if (r < infinite_energy || num_tree == 0) {
+    /* Distant and background lights, proportional to energy. */
+    float cdf = 0.0f;
+    for (int slot = num_tree; slot < num_distribution; slot++) {
+      const int index = kernel_tex_fetch(__light_tree_emitters, slot);
+      const float energy = light_tree_emitter_energy(kg, index) / infinite_energy;
+      cdf += energy;
+      if (r < cdf || slot == num_distribution - 1) {
+        *randu = saturate((r - (cdf - energy)) / energy);
+        return index;
+      }
+    }
+  }
+
+  r = saturate((r - infinite_energy) / (1.0f - infinite_energy));
+
+  int node_index = 0;
+  for (;;) {
+    const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes,
+                                                                    node_index);
+
+    if (knode->right_child == -1) {
+      /* Leaf, pick an emitter proportional to energy. */
+      float total = 0.0f;
+      for (int i = 0; i < knode->num_emitters; i++) {
+        const int index = kernel_tex_fetch(__light_tree_emitters, knode->first_emitter + i);
+        total += light_tree_emitter_energy(kg, index);
+      }
+
+      float cdf = 0.0f;
+      for (int i = 0; i < knode->num_emitters; i++) {
+        const int index = kernel_tex_fetch(__light_tree_emitters, knode->first_emitter + i);
+        /* Fall back to uniform selection for leaves filled with degenerate,
+         * zero energy emitters. */
+        const float energy = (total > 0.0f) ? light_tree_emitter_energy(kg, index) / total :
+                                              1.0f / knode->num_emitters;
+        cdf += energy;
+        if (r < cdf || i == knode->num_emitters - 1) {
+          *randu = saturate((r - (cdf - energy)) / energy);
+          return index;
+        }
+      }
+    }
+
+    const ccl_global KernelLightTreeNode *kleft = &kernel_tex_fetch(__light_tree_nodes,
+                                                                    node_index + 1);
+    const ccl_global KernelLightTreeNode *kright = &kernel_tex_fetch(__light_tree_nodes,
+                                                                     knode->right_child);
+
+    const float importance_left = light_tree_node_importance(kleft, P);
+    const float importance_right = light_tree_node_importance(kright, P);
+    const float total = importance_left + importance_right;
+    const float p_left = (total > 0.0f) ? importance_left / total : 0.5f;
+
+    /* Rescale r to reuse it on the next level, as in
+     * light_distribution_sample. */
+    if (r < p_left) {
+      r = r / p_left;
+      node_index = node_index + 1;
+    }
+    else {
+      r = (r - p_left) / (1.0f - p_left);
+      node_index = knode->right_child;
+    }
+  }
+}
+
+/* Probability of light_tree_sample returning this distribution index, found
+ * by deterministically replaying the traversal towards its emitter slot. */
+ccl_device float light_tree_pdf(KernelGlobals *kg, float3 P, int index)
+{
+  const int slot = kernel_tex_fetch(__light_to_tree, index);
+  const float energy = light_tree_emitter_energy(kg, index);
+
+  if (slot >= kernel_data.integrator.light_tree_num_emitters) {
+    /* Distant or background light. The group probability and the energy
+     * normalization within the group cancel out against each other. */
+    return energy;
+  }
+
+  /* Probability of descending into the tree at all. */
+  float pdf = 1.0f - kernel_data.integrator.light_tree_infinite_energy;
+
+  int node_index = 0;
+  for (;;) {
+    const ccl_global KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes,
+                                                                    node_index);
+
+    if (knode->right_child == -1) {
+      float total = 0.0f;
+      for (int i = 0; i < knode->num_emitters; i++) {
+        const int leaf_index = kernel_tex_fetch(__light_tree_emitters, knode->first_emitter + i);
+        total += light_tree_emitter_energy(kg, leaf_index);
+      }
+      return (total > 0.0f) ? pdf * energy / total : pdf / knode->num_emitters;
+    }
+
+    const ccl_global KernelLightTreeNode *kleft = &kernel_tex_fetch(__light_tree_nodes,
+                                                                    node_index + 1);
+    const ccl_global KernelLightTreeNode *kright = &kernel_tex_fetch(__light_tree_nodes,
+                                                                     knode->right_child);
+
+    const float importance_left = light_tree_node_importance(kleft, P);
+    const float importance_right = light_tree_node_importance(kright, P);
+    const float total = importance_left + importance_right;
+    const float p_left = (total > 0.0f) ? importance_left / total : 0.5f;
+
+    if (slot < kright->first_emitter) {
+      pdf *= p_left;
+      node_index = node_index + 1;
+    }
+    else {
+      pdf *= 1.0f - p_left;
+      node_index = knode->right_child;
+    }
+  }
+}
+
+/* Probability of selecting this lamp, for MIS weighting. */
+ccl_device_inline float light_distribution_pdf_lamp(KernelGlobals *kg, float3 P, int lamp)
+{
+  if (kernel_data.integrator.use_light_tree) {
+    const int index = kernel_data.integrator.num_distribution -
+                      kernel_data.integrator.num_all_lights + lamp;
+    return light_tree_pdf(kg, P, index);
+  }
+
+  return kernel_data.integrator.pdf_lights;
+}
+
 /* Regular Light */
 
 ccl_device_inline bool lamp_light_sample(
@@ -645,7 +820,7 @@ ccl_device_inline bool lamp_light_sample(
     }
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= light_distribution_pdf_lamp(kg, P, lamp);
 
   return (ls->pdf > 0.0f);
 }
@@ -783,7 +958,7 @@ ccl_device bool lamp_light_eval(
     return false;
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= light_distribution_pdf_lamp(kg, P, lamp);
 
   return true;
 }
@@ -822,12 +997,54 @@ ccl_device_inline bool triangle_world_space_vertices(
   return has_motion;
 }
 
-ccl_device_inline float triangle_light_pdf_area(KernelGlobals *kg,
-                                                const float3 Ng,
-                                                const float3 I,
-                                                float t)
+/* Probability density of selecting this triangle, over the triangle area. */
+ccl_device float light_distribution_pdf_triangle(KernelGlobals *kg, float3 P, int object, int prim)
+{
+  if (!kernel_data.integrator.use_light_tree) {
+    return kernel_data.integrator.pdf_triangles;
+  }
+
+  /* Find the triangle in the distribution, entries are ordered by object
+   * and primitive index. */
+  const int num_triangles = kernel_data.integrator.num_distribution -
+                            kernel_data.integrator.num_all_lights;
+  int first = 0;
+  int len = num_triangles;
+
+  while (len > 0) {
+    int half_len = len >> 1;
+    int middle = first + half_len;
+    const ccl_global KernelLightDistribution *kdistribution = &kernel_tex_fetch(
+        __light_distribution, middle);
+
+    if (kdistribution->mesh_light.object_id < object ||
+        (kdistribution->mesh_light.object_id == object && kdistribution->prim < prim)) {
+      first = middle + 1;
+      len = len - half_len - 1;
+    }
+    else {
+      len = half_len;
+    }
+  }
+
+  if (first >= num_triangles) {
+    return 0.0f;
+  }
+
+  const float pdf = light_tree_pdf(kg, P, first);
+
+  /* The flat distribution folds the triangle area into the CDF, so callers
+   * expect a density per unit area of the center frame triangle. */
+  float3 V[3];
+  triangle_world_space_vertices(kg, object, prim, -1.0f, V);
+  const float area = triangle_area(V[0], V[1], V[2]);
+
+  return (area != 0.0f) ? pdf / area : 0.0f;
+}
+
+ccl_device_inline float triangle_light_pdf_area(
+    KernelGlobals *kg, const float3 Ng, const float3 I, float t, float pdf)
 {
-  float pdf = kernel_data.integrator.pdf_triangles;
   float cos_pi = fabsf(dot(Ng, I));
 
   if (cos_pi == 0.0f)
@@ -852,10 +1069,12 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
   const float3 N = cross(e0, e1);
   const float distance_to_plane = fabsf(dot(N, sd->I * t)) / dot(N, N);
 
+  /* sd contains the point on the light source
+   * calculate Px, the point that we're shading */
+  const float3 Px = sd->P + sd->I * t;
+  const float pdf_selection = light_distribution_pdf_triangle(kg, Px, sd->object, sd->prim);
+
   if (longest_edge_squared > distance_to_plane * distance_to_plane) {
-    /* sd contains the point on the light source
-     * calculate Px, the point that we're shading */
-    const float3 Px = sd->P + sd->I * t;
     const float3 v0_p = V[0] - Px;
     const float3 v1_p = V[1] - Px;
     const float3 v2_p = V[2] - Px;
@@ -883,12 +1102,12 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
       else {
         area = 0.5f * len(N);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area * pdf_selection;
       return pdf / solid_angle;
     }
   }
   else {
-    float pdf = triangle_light_pdf_area(kg, sd->Ng, sd->I, t);
+    float pdf = triangle_light_pdf_area(kg, sd->Ng, sd->I, t, pdf_selection);
     if (has_motion) {
       const float area = 0.5f * len(N);
       if (UNLIKELY(area == 0.0f)) {
@@ -943,6 +1162,8 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
   ls->shader |= SHADER_USE_MIS;
   ls->type = LIGHT_TRIANGLE;
 
+  const float pdf_selection = light_distribution_pdf_triangle(kg, P, object, prim);
+
   float distance_to_plane = fabsf(dot(N0, V[0] - P) / dot(N0, N0));
 
   if (longest_edge_squared > distance_to_plane * distance_to_plane) {
@@ -1036,7 +1257,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
         triangle_world_space_vertices(kg, object, prim, -1.0f, V);
         area = triangle_area(V[0], V[1], V[2]);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area * pdf_selection;
       ls->pdf = pdf / solid_angle;
     }
   }
@@ -1058,7 +1279,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
     ls->P = u * V[0] + v * V[1] + t * V[2];
     /* compute incoming direction, distance and pdf */
     ls->D = normalize_len(ls->P - P, &ls->t);
-    ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t);
+    ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t, pdf_selection);
     if (has_motion && area != 0.0f) {
       /* scale the PDF.
        * area = the area the sample was taken from
@@ -1128,7 +1349,9 @@ ccl_device_noinline bool light_sample(KernelGlobals *kg,
 {
   if (lamp < 0) {
     /* sample index */
-    int index = light_distribution_sample(kg, &randu);
+    int index = (kernel_data.integrator.use_light_tree) ?
+                    light_tree_sample(kg, P, &randu) :
+                    light_distribution_sample(kg, &randu);
 
     /* fetch light data */
     const ccl_global KernelLightDistribution *kdistribution = &kernel_tex_fetch(
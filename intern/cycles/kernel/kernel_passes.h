@@ -154,7 +154,7 @@ ccl_device_inline size_t kernel_write_id_pass_cpu(
     float *buffer, size_t depth, float id, float matte_weight, CoverageMap *map)
 {
   if (map) {
-    (*map)[id] += matte_weight;
+    map->add(id, matte_weight);
     return 0;
   }
 #else /* __KERNEL_CPU__ */
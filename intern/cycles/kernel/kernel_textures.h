@@ -66,6 +66,9 @@ KERNEL_TEX(KernelLightDistribution, __light_distribution)
 KERNEL_TEX(KernelLight, __lights)
 KERNEL_TEX(float2, __light_background_marginal_cdf)
 KERNEL_TEX(float2, __light_background_conditional_cdf)
+KERNEL_TEX(KernelLightTreeNode, __light_tree_nodes)
+KERNEL_TEX(uint, __light_tree_emitters)
+KERNEL_TEX(uint, __light_to_tree)
 
 /* particles */
 KERNEL_TEX(KernelParticle, __particles)
@@ -86,4 +89,7 @@ KERNEL_TEX(TextureInfo, __texture_info)
 /* ies lights */
 KERNEL_TEX(float, __ies)
 
+/* baking */
+KERNEL_TEX(int4, __bake_objects)
+
 #undef KERNEL_TEX
@@ -1372,6 +1372,17 @@ typedef struct KernelIntegrator {
 
   int max_closures;
 
+  /* light tree */
+  int use_light_tree;
+  /* Number of emitters in the spatial tree, the remaining emitters up to
+   * num_distribution are distant and background lights without a position. */
+  int light_tree_num_emitters;
+  /* Normalized energy of the distant and background lights, which is also
+   * the probability of sampling that group instead of the tree. */
+  float light_tree_infinite_energy;
+  /* Selection probability of the background light in tree mode. */
+  float light_tree_background_pdf;
+
   int pad1;
 } KernelIntegrator;
 static_assert_align(KernelIntegrator, 16);
@@ -1445,6 +1456,10 @@ typedef struct KernelBake {
   int tri_offset;
   int type;
   int pass_filter;
+  /* When baking multiple objects in one session, the object is looked up
+   * per pixel in __bake_objects instead of the members above. */
+  int num_objects;
+  int pad1, pad2, pad3;
 } KernelBake;
 static_assert_align(KernelBake, 16);
 
@@ -1553,6 +1568,26 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+/* Binary BVH over emitters for importance based light selection. Nodes are
+ * stored in preorder, so the left child immediately follows its parent and
+ * only the right child index is stored. Leaves reference a contiguous slot
+ * range in __light_tree_emitters. */
+typedef struct KernelLightTreeNode {
+  /* Bounding box of the emitters below this node. */
+  float min_x, min_y, min_z;
+  float max_x, max_y, max_z;
+  /* Total emitter energy below this node, normalized by the scene total. */
+  float energy;
+  /* Index of the right child, or -1 for a leaf. */
+  int right_child;
+  /* Emitter slot range below this node, used to evaluate the probability
+   * of sampling a given emitter by replaying the traversal. */
+  int first_emitter;
+  int num_emitters;
+  int pad1, pad2;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
 typedef struct KernelParticle {
   int index;
   float age;
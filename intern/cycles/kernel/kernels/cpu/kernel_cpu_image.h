@@ -19,6 +19,12 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Sample a file backed image through the OIIO texture cache. Implemented on
+ * the host side in render/image.cpp so the kernels need no OIIO headers, and
+ * uses a float out parameter since float4 has a different layout in kernels
+ * compiled with SSE support. */
+void kernel_tex_image_interp_oiio(const TextureInfo &info, float x, float y, float *result);
+
 /* Make template functions private so symbols don't conflict between kernels with different
  * instruction sets. */
 namespace {
@@ -253,6 +259,31 @@ template<typename T> struct TextureInterpolator {
 
   /* ********  3D interpolation ******** */
 
+  /* Read a single voxel, with a tile index lookup for sparse tiled volumes. */
+  static ccl_always_inline float4 read_3d(const TextureInfo &info, int ix, int iy, int iz)
+  {
+    const T *data = (const T *)info.data;
+
+    if (info.sparse_data_offset) {
+      const uint *tile_index = (const uint *)info.data;
+      const int tiles_x = (info.width + TEX_TILE_MASK) >> TEX_TILE_SHIFT;
+      const int tiles_y = (info.height + TEX_TILE_MASK) >> TEX_TILE_SHIFT;
+      const int tile = (ix >> TEX_TILE_SHIFT) + (iy >> TEX_TILE_SHIFT) * tiles_x +
+                       (iz >> TEX_TILE_SHIFT) * tiles_x * tiles_y;
+      const uint offset = tile_index[tile];
+
+      if (offset == TEX_TILE_EMPTY) {
+        return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+      }
+
+      const int voxel = offset + (ix & TEX_TILE_MASK) + ((iy & TEX_TILE_MASK) << TEX_TILE_SHIFT) +
+                        ((iz & TEX_TILE_MASK) << (2 * TEX_TILE_SHIFT));
+      return read(data[info.sparse_data_offset + voxel]);
+    }
+
+    return read(data[ix + iy * info.width + iz * info.width * info.height]);
+  }
+
   static ccl_always_inline float4 interp_3d_closest(const TextureInfo &info,
                                                     float x,
                                                     float y,
@@ -288,8 +319,7 @@ template<typename T> struct TextureInterpolator {
         return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
     }
 
-    const T *data = (const T *)info.data;
-    return read(data[ix + iy * width + iz * width * height]);
+    return read_3d(info, ix, iy, iz);
   }
 
   static ccl_always_inline float4 interp_3d_linear(const TextureInfo &info,
@@ -336,19 +366,17 @@ template<typename T> struct TextureInterpolator {
         return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
     }
 
-    const T *data = (const T *)info.data;
     float4 r;
 
-    r = (1.0f - tz) * (1.0f - ty) * (1.0f - tx) *
-        read(data[ix + iy * width + iz * width * height]);
-    r += (1.0f - tz) * (1.0f - ty) * tx * read(data[nix + iy * width + iz * width * height]);
-    r += (1.0f - tz) * ty * (1.0f - tx) * read(data[ix + niy * width + iz * width * height]);
-    r += (1.0f - tz) * ty * tx * read(data[nix + niy * width + iz * width * height]);
+    r = (1.0f - tz) * (1.0f - ty) * (1.0f - tx) * read_3d(info, ix, iy, iz);
+    r += (1.0f - tz) * (1.0f - ty) * tx * read_3d(info, nix, iy, iz);
+    r += (1.0f - tz) * ty * (1.0f - tx) * read_3d(info, ix, niy, iz);
+    r += (1.0f - tz) * ty * tx * read_3d(info, nix, niy, iz);
 
-    r += tz * (1.0f - ty) * (1.0f - tx) * read(data[ix + iy * width + niz * width * height]);
-    r += tz * (1.0f - ty) * tx * read(data[nix + iy * width + niz * width * height]);
-    r += tz * ty * (1.0f - tx) * read(data[ix + niy * width + niz * width * height]);
-    r += tz * ty * tx * read(data[nix + niy * width + niz * width * height]);
+    r += tz * (1.0f - ty) * (1.0f - tx) * read_3d(info, ix, iy, niz);
+    r += tz * (1.0f - ty) * tx * read_3d(info, nix, iy, niz);
+    r += tz * ty * (1.0f - tx) * read_3d(info, ix, niy, niz);
+    r += tz * ty * tx * read_3d(info, nix, niy, niz);
 
     return r;
   }
@@ -424,15 +452,14 @@ template<typename T> struct TextureInterpolator {
     }
 
     const int xc[4] = {pix, ix, nix, nnix};
-    const int yc[4] = {width * piy, width * iy, width * niy, width * nniy};
-    const int zc[4] = {
-        width * height * piz, width * height * iz, width * height * niz, width * height * nniz};
+    const int yc[4] = {piy, iy, niy, nniy};
+    const int zc[4] = {piz, iz, niz, nniz};
     float u[4], v[4], w[4];
 
     /* Some helper macro to keep code reasonable size,
      * let compiler to inline all the matrix multiplications.
      */
-#define DATA(x, y, z) (read(data[xc[x] + yc[y] + zc[z]]))
+#define DATA(x, y, z) (read_3d(info, xc[x], yc[y], zc[z]))
 #define COL_TERM(col, row) \
   (v[col] * (u[0] * DATA(0, col, row) + u[1] * DATA(1, col, row) + u[2] * DATA(2, col, row) + \
              u[3] * DATA(3, col, row)))
@@ -444,7 +471,6 @@ template<typename T> struct TextureInterpolator {
     SET_CUBIC_SPLINE_WEIGHTS(w, tz);
 
     /* Actual interpolation. */
-    const T *data = (const T *)info.data;
     return ROW_TERM(0) + ROW_TERM(1) + ROW_TERM(2) + ROW_TERM(3);
 
 #undef COL_TERM
@@ -474,6 +500,12 @@ ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, fl
 {
   const TextureInfo &info = kernel_tex_fetch(__texture_info, id);
 
+  if (UNLIKELY(info.oiio_handle)) {
+    float f[4];
+    kernel_tex_image_interp_oiio(info, x, y, f);
+    return make_float4(f[0], f[1], f[2], f[3]);
+  }
+
   switch (info.data_type) {
     case IMAGE_DATA_TYPE_HALF:
       return TextureInterpolator<half>::interp(info, x, y);
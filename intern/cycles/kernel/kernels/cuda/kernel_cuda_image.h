@@ -118,6 +118,138 @@ ccl_device T kernel_tex_image_interp_bicubic_3d(
                 g1y * (g0x * tex3D<T>(tex, x0, y1, z1) + g1x * tex3D<T>(tex, x1, y1, z1)));
 }
 
+/* Sparse tiled 3D textures are sampled manually from linear memory, since
+ * they can not be bound as a CUDA 3D texture. */
+
+ccl_device int kernel_tex_wrap_periodic(int x, int width)
+{
+  x %= width;
+  if (x < 0)
+    x += width;
+  return x;
+}
+
+ccl_device int kernel_tex_wrap_clamp(int x, int width)
+{
+  return clamp(x, 0, width - 1);
+}
+
+/* Read a single voxel through the tile index. */
+ccl_device float4 kernel_tex_image_read_sparse_3d(const TextureInfo &info, int ix, int iy, int iz)
+{
+  const uint *tile_index = (const uint *)info.data;
+  const int tiles_x = (info.width + TEX_TILE_MASK) >> TEX_TILE_SHIFT;
+  const int tiles_y = (info.height + TEX_TILE_MASK) >> TEX_TILE_SHIFT;
+  const int tile = (ix >> TEX_TILE_SHIFT) + (iy >> TEX_TILE_SHIFT) * tiles_x +
+                   (iz >> TEX_TILE_SHIFT) * tiles_x * tiles_y;
+  const uint offset = tile_index[tile];
+
+  if (offset == TEX_TILE_EMPTY) {
+    return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+  }
+
+  const int voxel = offset + (ix & TEX_TILE_MASK) + ((iy & TEX_TILE_MASK) << TEX_TILE_SHIFT) +
+                    ((iz & TEX_TILE_MASK) << (2 * TEX_TILE_SHIFT));
+
+  if (info.data_type == IMAGE_DATA_TYPE_FLOAT4) {
+    const float4 *data = (const float4 *)info.data + info.sparse_data_offset;
+    return data[voxel];
+  }
+  else {
+    const float *data = (const float *)info.data + info.sparse_data_offset;
+    const float f = data[voxel];
+    return make_float4(f, f, f, 1.0f);
+  }
+}
+
+ccl_device float4 kernel_tex_image_interp_sparse_3d(
+    const TextureInfo &info, float x, float y, float z, uint interpolation)
+{
+  const int width = info.width;
+  const int height = info.height;
+  const int depth = info.depth;
+
+  if (interpolation == INTERPOLATION_CLOSEST) {
+    int ix = (int)floorf(x * width);
+    int iy = (int)floorf(y * height);
+    int iz = (int)floorf(z * depth);
+
+    switch (info.extension) {
+      case EXTENSION_REPEAT:
+        ix = kernel_tex_wrap_periodic(ix, width);
+        iy = kernel_tex_wrap_periodic(iy, height);
+        iz = kernel_tex_wrap_periodic(iz, depth);
+        break;
+      case EXTENSION_CLIP:
+        if (x < 0.0f || y < 0.0f || z < 0.0f || x > 1.0f || y > 1.0f || z > 1.0f) {
+          return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+        }
+        ATTR_FALLTHROUGH;
+      default:
+        ix = kernel_tex_wrap_clamp(ix, width);
+        iy = kernel_tex_wrap_clamp(iy, height);
+        iz = kernel_tex_wrap_clamp(iz, depth);
+        break;
+    }
+
+    return kernel_tex_image_read_sparse_3d(info, ix, iy, iz);
+  }
+
+  /* Trilinear interpolation, cubic falls back to this for sparse volumes. */
+  const float fx = x * width - 0.5f;
+  const float fy = y * height - 0.5f;
+  const float fz = z * depth - 0.5f;
+
+  int ix = (int)floorf(fx);
+  int iy = (int)floorf(fy);
+  int iz = (int)floorf(fz);
+  const float tx = fx - ix;
+  const float ty = fy - iy;
+  const float tz = fz - iz;
+  int nix = ix + 1;
+  int niy = iy + 1;
+  int niz = iz + 1;
+
+  switch (info.extension) {
+    case EXTENSION_REPEAT:
+      ix = kernel_tex_wrap_periodic(ix, width);
+      iy = kernel_tex_wrap_periodic(iy, height);
+      iz = kernel_tex_wrap_periodic(iz, depth);
+
+      nix = kernel_tex_wrap_periodic(nix, width);
+      niy = kernel_tex_wrap_periodic(niy, height);
+      niz = kernel_tex_wrap_periodic(niz, depth);
+      break;
+    case EXTENSION_CLIP:
+      if (x < 0.0f || y < 0.0f || z < 0.0f || x > 1.0f || y > 1.0f || z > 1.0f) {
+        return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+      }
+      ATTR_FALLTHROUGH;
+    default:
+      ix = kernel_tex_wrap_clamp(ix, width);
+      iy = kernel_tex_wrap_clamp(iy, height);
+      iz = kernel_tex_wrap_clamp(iz, depth);
+
+      nix = kernel_tex_wrap_clamp(nix, width);
+      niy = kernel_tex_wrap_clamp(niy, height);
+      niz = kernel_tex_wrap_clamp(niz, depth);
+      break;
+  }
+
+  float4 r;
+  r = (1.0f - tz) * (1.0f - ty) * (1.0f - tx) * kernel_tex_image_read_sparse_3d(info, ix, iy, iz);
+  r += (1.0f - tz) * (1.0f - ty) * tx * kernel_tex_image_read_sparse_3d(info, nix, iy, iz);
+  r += (1.0f - tz) * ty * (1.0f - tx) * kernel_tex_image_read_sparse_3d(info, ix, niy, iz);
+  r += (1.0f - tz) * ty * tx * kernel_tex_image_read_sparse_3d(info, nix, niy, iz);
+
+  r += tz * (1.0f - ty) * (1.0f - tx) * kernel_tex_image_read_sparse_3d(info, ix, iy, niz);
+  r += tz * (1.0f - ty) * tx * kernel_tex_image_read_sparse_3d(info, nix, iy, niz);
+  r += tz * ty * (1.0f - tx) * kernel_tex_image_read_sparse_3d(info, ix, niy, niz);
+  r += tz * ty * tx * kernel_tex_image_read_sparse_3d(info, nix, niy, niz);
+
+  return r;
+}
+
 ccl_device float4 kernel_tex_image_interp(KernelGlobals *kg, int id, float x, float y)
 {
   const TextureInfo &info = kernel_tex_fetch(__texture_info, id);
@@ -164,9 +296,13 @@ ccl_device float4 kernel_tex_image_interp_3d(KernelGlobals *kg,
   const float y = P.y;
   const float z = P.z;
 
-  CUtexObject tex = (CUtexObject)info.data;
   uint interpolation = (interp == INTERPOLATION_NONE) ? info.interpolation : interp;
 
+  if (info.sparse_data_offset) {
+    return kernel_tex_image_interp_sparse_3d(info, x, y, z, interpolation);
+  }
+
+  CUtexObject tex = (CUtexObject)info.data;
   const int texture_type = info.data_type;
   if (texture_type == IMAGE_DATA_TYPE_FLOAT4 || texture_type == IMAGE_DATA_TYPE_BYTE4 ||
       texture_type == IMAGE_DATA_TYPE_HALF4 || texture_type == IMAGE_DATA_TYPE_USHORT4) {
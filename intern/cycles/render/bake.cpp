@@ -85,15 +85,15 @@ BakeManager::~BakeManager()
 
 bool BakeManager::get_baking()
 {
-  return !object_name.empty();
+  return !object_names.empty();
 }
 
 void BakeManager::set(Scene *scene,
-                      const std::string &object_name_,
+                      const vector<std::string> &object_names_,
                       ShaderEvalType type_,
                       int pass_filter_)
 {
-  object_name = object_name_;
+  object_names = object_names_;
   type = type_;
   pass_filter = shader_type_to_pass_filter(type_, pass_filter_);
 
@@ -130,25 +130,52 @@ void BakeManager::device_update(Device * /*device*/,
 
   kbake->type = type;
   kbake->pass_filter = pass_filter;
+  kbake->num_objects = object_names.size();
 
-  int object_index = 0;
-  foreach (Object *object, scene->objects) {
-    const Geometry *geom = object->geometry;
-    if (object->name == object_name && geom->type == Geometry::MESH) {
-      kbake->object_index = object_index;
-      kbake->tri_offset = geom->prim_offset;
-      kintegrator->aa_samples = aa_samples(scene, object, type);
-      break;
+  if (object_names.empty()) {
+    need_update = false;
+    return;
+  }
+
+  int4 *bake_objects = dscene->bake_objects.alloc(object_names.size());
+  int num_aa_samples = 1;
+  bool found_any = false;
+
+  for (size_t i = 0; i < object_names.size(); i++) {
+    bake_objects[i] = make_int4(0, 0, 0, 0);
+
+    int object_index = 0;
+    foreach (Object *object, scene->objects) {
+      const Geometry *geom = object->geometry;
+      if (object->name == object_names[i] && geom->type == Geometry::MESH) {
+        bake_objects[i] = make_int4(object_index, geom->prim_offset, 0, 0);
+        num_aa_samples = max(num_aa_samples, aa_samples(scene, object, type));
+
+        if (!found_any) {
+          /* Single object baking reads these instead of the table. */
+          kbake->object_index = object_index;
+          kbake->tri_offset = geom->prim_offset;
+          found_any = true;
+        }
+        break;
+      }
+
+      object_index++;
     }
+  }
 
-    object_index++;
+  if (found_any) {
+    kintegrator->aa_samples = num_aa_samples;
   }
 
+  dscene->bake_objects.copy_to_device();
+
   need_update = false;
 }
 
-void BakeManager::device_free(Device * /*device*/, DeviceScene * /*dscene*/)
+void BakeManager::device_free(Device * /*device*/, DeviceScene *dscene)
 {
+  dscene->bake_objects.free();
 }
 
 CCL_NAMESPACE_END
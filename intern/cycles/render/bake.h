@@ -30,7 +30,13 @@ class BakeManager {
   BakeManager();
   ~BakeManager();
 
-  void set(Scene *scene, const std::string &object_name, ShaderEvalType type, int pass_filter);
+  /* Set the objects to bake. With more than one object, the bake primitive
+   * buffer is expected to carry the index into this list per pixel, so all
+   * objects can be baked in a single session. */
+  void set(Scene *scene,
+           const vector<std::string> &object_names,
+           ShaderEvalType type,
+           int pass_filter);
   bool get_baking();
 
   void device_update(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
@@ -41,7 +47,7 @@ class BakeManager {
  private:
   ShaderEvalType type;
   int pass_filter;
-  std::string object_name;
+  vector<std::string> object_names;
 };
 
 CCL_NAMESPACE_END
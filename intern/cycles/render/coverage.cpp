@@ -24,6 +24,7 @@
 #include "kernel/kernel_globals.h"
 #include "kernel/kernel_id_passes.h"
 
+#include "util/util_algorithm.h"
 #include "util/util_map.h"
 
 CCL_NAMESPACE_BEGIN
@@ -110,8 +111,11 @@ void Coverage::flatten_buffer(vector<CoverageMap> &coverage, const int pass_offs
 
         /* sort the cryptomatte pixel */
         vector<pair<float, float>> sorted_pixel;
-        for (CoverageMap::const_iterator it = pixel.begin(); it != pixel.end(); ++it) {
-          sorted_pixel.push_back(std::make_pair(it->second, it->first));
+        const vector<pair<float, float>> &slots = pixel.entries();
+        for (size_t slot = 0; slot < slots.size(); ++slot) {
+          if (slots[slot].first != CoverageMap::id_none) {
+            sorted_pixel.push_back(std::make_pair(slots[slot].second, slots[slot].first));
+          }
         }
         sort(sorted_pixel.begin(), sorted_pixel.end(), crypomatte_comp);
         int num_slots = 2 * (kernel_data.film.cryptomatte_depth);
@@ -25,7 +25,8 @@ CCL_NAMESPACE_BEGIN
 struct KernelGlobals;
 class RenderTile;
 
-typedef unordered_map<float, float> CoverageMap;
+/* Defined in kernel_globals.h. */
+class CoverageMap;
 
 class Coverage {
  public:
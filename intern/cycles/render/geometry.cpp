@@ -193,7 +193,14 @@ void Geometry::compute_bvh(
     vector<Object *> objects;
     objects.push_back(&object);
 
-    if (bvh && !need_update_rebuild) {
+    /* Refit is only possible when topology is unchanged and the existing tree
+     * was built with the same layout and split strategy, otherwise a switch
+     * of the render device or scene params would refit a mismatched tree. */
+    const bool can_refit = bvh != NULL && !need_update_rebuild &&
+                           bvh->params.bvh_layout == bvh_layout &&
+                           bvh->params.use_spatial_split == params->use_bvh_spatial_split;
+
+    if (can_refit) {
       progress->set_status(msg, "Refitting BVH");
 
       bvh->geometry = geometry;
@@ -843,6 +850,58 @@ void GeometryManager::mesh_calc_offset(Scene *scene)
   }
 }
 
+/* Packing of one geometry into its slice of the device arrays, run on the
+ * task pool. Slices of different geometries never overlap. */
+
+static void geometry_pack_triangles_task(Mesh *mesh,
+                                         Scene *scene,
+                                         const vector<uint> *tri_prim_index,
+                                         uint *tri_shader,
+                                         float4 *vnormal,
+                                         uint4 *tri_vindex,
+                                         uint *tri_patch,
+                                         float2 *tri_patch_uv)
+{
+  mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
+  mesh->pack_normals(&vnormal[mesh->vert_offset]);
+  mesh->pack_verts(*tri_prim_index,
+                   &tri_vindex[mesh->prim_offset],
+                   &tri_patch[mesh->prim_offset],
+                   &tri_patch_uv[mesh->vert_offset],
+                   mesh->vert_offset,
+                   mesh->prim_offset);
+}
+
+static void geometry_pack_curves_task(Hair *hair, Scene *scene, float4 *curve_keys, float4 *curves)
+{
+  hair->pack_curves(scene,
+                    &curve_keys[hair->curvekey_offset],
+                    &curves[hair->prim_offset],
+                    hair->curvekey_offset);
+}
+
+static void geometry_pack_patches_task(Mesh *mesh, uint *patch_data)
+{
+  mesh->pack_patches(
+      &patch_data[mesh->patch_offset], mesh->vert_offset, mesh->face_offset, mesh->corner_offset);
+
+  if (mesh->patch_table) {
+    mesh->patch_table->copy_adjusting_offsets(&patch_data[mesh->patch_table_offset],
+                                              mesh->patch_table_offset);
+  }
+}
+
+static void geometry_pack_displacement_verts_task(Mesh *mesh, float4 *prim_tri_verts)
+{
+  for (size_t i = 0; i < mesh->num_triangles(); ++i) {
+    Mesh::Triangle t = mesh->get_triangle(i);
+    size_t offset = 3 * (i + mesh->prim_offset);
+    prim_tri_verts[offset + 0] = float3_to_float4(mesh->verts[t.v[0]]);
+    prim_tri_verts[offset + 1] = float3_to_float4(mesh->verts[t.v[1]]);
+    prim_tri_verts[offset + 2] = float3_to_float4(mesh->verts[t.v[2]]);
+  }
+}
+
 void GeometryManager::device_update_mesh(
     Device *, DeviceScene *dscene, Scene *scene, bool for_displacement, Progress &progress)
 {
@@ -906,7 +965,13 @@ void GeometryManager::device_update_mesh(
     }
   }
 
-  /* Fill in all the arrays. */
+  /* Fill in all the arrays. Each geometry packs into its own slice of the
+   * device arrays, so the packing itself runs on the task pools. Triangles
+   * go on their own pool so their copy to the device can overlap with the
+   * packing of strands and patches. */
+  TaskPool tri_pool;
+  TaskPool pack_pool;
+
   if (tri_size != 0) {
     /* normals */
     progress.set_status("Updating Mesh", "Computing normals");
@@ -920,74 +985,75 @@ void GeometryManager::device_update_mesh(
     foreach (Geometry *geom, scene->geometry) {
       if (geom->type == Geometry::MESH) {
         Mesh *mesh = static_cast<Mesh *>(geom);
-        mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
-        mesh->pack_normals(&vnormal[mesh->vert_offset]);
-        mesh->pack_verts(tri_prim_index,
-                         &tri_vindex[mesh->prim_offset],
-                         &tri_patch[mesh->prim_offset],
-                         &tri_patch_uv[mesh->vert_offset],
-                         mesh->vert_offset,
-                         mesh->prim_offset);
-        if (progress.get_cancel())
-          return;
+        tri_pool.push(function_bind(&geometry_pack_triangles_task,
+                                    mesh,
+                                    scene,
+                                    &tri_prim_index,
+                                    tri_shader,
+                                    vnormal,
+                                    tri_vindex,
+                                    tri_patch,
+                                    tri_patch_uv));
       }
     }
-
-    /* vertex coordinates */
-    progress.set_status("Updating Mesh", "Copying Mesh to device");
-
-    dscene->tri_shader.copy_to_device();
-    dscene->tri_vnormal.copy_to_device();
-    dscene->tri_vindex.copy_to_device();
-    dscene->tri_patch.copy_to_device();
-    dscene->tri_patch_uv.copy_to_device();
   }
 
   if (curve_size != 0) {
-    progress.set_status("Updating Mesh", "Copying Strands to device");
-
     float4 *curve_keys = dscene->curve_keys.alloc(curve_key_size);
     float4 *curves = dscene->curves.alloc(curve_size);
 
     foreach (Geometry *geom, scene->geometry) {
       if (geom->type == Geometry::HAIR) {
         Hair *hair = static_cast<Hair *>(geom);
-        hair->pack_curves(scene,
-                          &curve_keys[hair->curvekey_offset],
-                          &curves[hair->prim_offset],
-                          hair->curvekey_offset);
-        if (progress.get_cancel())
-          return;
+        pack_pool.push(function_bind(&geometry_pack_curves_task, hair, scene, curve_keys, curves));
       }
     }
-
-    dscene->curve_keys.copy_to_device();
-    dscene->curves.copy_to_device();
   }
 
   if (patch_size != 0) {
-    progress.set_status("Updating Mesh", "Copying Patches to device");
-
     uint *patch_data = dscene->patches.alloc(patch_size);
 
     foreach (Geometry *geom, scene->geometry) {
       if (geom->type == Geometry::MESH) {
         Mesh *mesh = static_cast<Mesh *>(geom);
-        mesh->pack_patches(&patch_data[mesh->patch_offset],
-                           mesh->vert_offset,
-                           mesh->face_offset,
-                           mesh->corner_offset);
+        pack_pool.push(function_bind(&geometry_pack_patches_task, mesh, patch_data));
+      }
+    }
+  }
 
-        if (mesh->patch_table) {
-          mesh->patch_table->copy_adjusting_offsets(&patch_data[mesh->patch_table_offset],
-                                                    mesh->patch_table_offset);
-        }
+  if (tri_size != 0) {
+    tri_pool.wait_work();
 
-        if (progress.get_cancel())
-          return;
-      }
+    if (progress.get_cancel()) {
+      return;
     }
 
+    /* vertex coordinates */
+    progress.set_status("Updating Mesh", "Copying Mesh to device");
+
+    dscene->tri_shader.copy_to_device();
+    dscene->tri_vnormal.copy_to_device();
+    dscene->tri_vindex.copy_to_device();
+    dscene->tri_patch.copy_to_device();
+    dscene->tri_patch_uv.copy_to_device();
+  }
+
+  pack_pool.wait_work();
+
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  if (curve_size != 0) {
+    progress.set_status("Updating Mesh", "Copying Strands to device");
+
+    dscene->curve_keys.copy_to_device();
+    dscene->curves.copy_to_device();
+  }
+
+  if (patch_size != 0) {
+    progress.set_status("Updating Mesh", "Copying Patches to device");
+
     dscene->patches.copy_to_device();
   }
 
@@ -996,15 +1062,13 @@ void GeometryManager::device_update_mesh(
     foreach (Geometry *geom, scene->geometry) {
       if (geom->type == Geometry::MESH) {
         Mesh *mesh = static_cast<Mesh *>(geom);
-        for (size_t i = 0; i < mesh->num_triangles(); ++i) {
-          Mesh::Triangle t = mesh->get_triangle(i);
-          size_t offset = 3 * (i + mesh->prim_offset);
-          prim_tri_verts[offset + 0] = float3_to_float4(mesh->verts[t.v[0]]);
-          prim_tri_verts[offset + 1] = float3_to_float4(mesh->verts[t.v[1]]);
-          prim_tri_verts[offset + 2] = float3_to_float4(mesh->verts[t.v[2]]);
-        }
+        pack_pool.push(function_bind(&geometry_pack_displacement_verts_task, mesh, prim_tri_verts));
       }
     }
+    pack_pool.wait_work();
+    if (progress.get_cancel()) {
+      return;
+    }
     dscene->prim_tri_verts.copy_to_device();
   }
 }
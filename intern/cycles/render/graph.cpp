@@ -775,6 +775,34 @@ void ShaderGraph::compute_displacement_hash()
   displacement_hash = md5.get_hex();
 }
 
+string ShaderGraph::content_hash()
+{
+  /* Compute hash of all nodes, their socket values and links, so that
+   * structurally identical graphs can share one compiled shader. Node ids
+   * are assigned in creation order and so are comparable between graphs
+   * that were built the same way. */
+  MD5Hash md5;
+  foreach (ShaderNode *node, nodes) {
+    node->hash(md5);
+    foreach (ShaderInput *input, node->inputs) {
+      int link_id = (input->link) ? input->link->parent->id : -1;
+      md5.append((uint8_t *)&link_id, sizeof(link_id));
+      if (input->link) {
+        md5.append(input->link->name().string());
+      }
+    }
+
+    if (node->special_type == SHADER_SPECIAL_TYPE_OSL) {
+      /* Hash takes into account socket values, to detect changes
+       * in the code of the node we need an exception. */
+      OSLNode *oslnode = static_cast<OSLNode *>(node);
+      md5.append(oslnode->bytecode_hash);
+    }
+  }
+
+  return md5.get_hex();
+}
+
 void ShaderGraph::clean(Scene *scene)
 {
   /* Graph simplification */
@@ -335,6 +335,7 @@ class ShaderGraph {
 
   void remove_proxy_nodes();
   void compute_displacement_hash();
+  string content_hash();
   void simplify(Scene *scene);
   void finalize(Scene *scene,
                 bool do_bump = false,
@@ -30,6 +30,8 @@
 #include "util/util_texture.h"
 #include "util/util_unique_ptr.h"
 
+#include <OpenImageIO/texture.h>
+
 #ifdef WITH_OSL
 #  include <OSL/oslexec.h>
 #endif
@@ -247,6 +249,13 @@ ustring ImageLoader::osl_filepath() const
   return ustring();
 }
 
+bool ImageLoader::load_sparse_pixels(const ImageMetaData & /*metadata*/,
+                                     vector<uint> * /*tile_index*/,
+                                     vector<float> * /*voxels*/)
+{
+  return false;
+}
+
 bool ImageLoader::equals(const ImageLoader *a, const ImageLoader *b)
 {
   if (a == NULL && b == NULL) {
@@ -259,14 +268,27 @@ bool ImageLoader::equals(const ImageLoader *a, const ImageLoader *b)
 
 /* Image Manager */
 
+/* Shared OIIO texture system the CPU kernels sample through, set when the
+ * texture cache is enabled. */
+static OIIO::TextureSystem *texture_cache_ts = NULL;
+
 ImageManager::ImageManager(const DeviceInfo &info)
 {
   need_update = true;
   osl_texture_system = NULL;
+  texture_cache_system = NULL;
   animation_frame = 0;
 
   /* Set image limits */
   has_half_images = info.has_half_images;
+
+  /* The OpenCL kernels have no sparse tile lookup. */
+  sparse_volumes_supported = (info.type != DEVICE_OPENCL);
+  foreach (const DeviceInfo &subinfo, info.multi_devices) {
+    if (subinfo.type == DEVICE_OPENCL) {
+      sparse_volumes_supported = false;
+    }
+  }
 }
 
 ImageManager::~ImageManager()
@@ -280,6 +302,18 @@ void ImageManager::set_osl_texture_system(void *texture_system)
   osl_texture_system = texture_system;
 }
 
+void ImageManager::set_texture_cache(int max_size_mb)
+{
+  OIIO::TextureSystem *ts = OIIO::TextureSystem::create(true);
+  ts->attribute("max_memory_MB", (float)max_size_mb);
+  ts->attribute("automip", 1);
+  ts->attribute("accept_untiled", 1);
+  ts->attribute("accept_unmipped", 1);
+
+  texture_cache_system = ts;
+  texture_cache_ts = ts;
+}
+
 bool ImageManager::set_animation_frame_update(int frame)
 {
   if (frame != animation_frame) {
@@ -607,6 +641,55 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   return true;
 }
 
+bool ImageManager::file_load_sparse_image(Image *img)
+{
+  vector<uint> tile_index;
+  vector<float> voxels;
+
+  if (!img->loader->load_sparse_pixels(img->metadata, &tile_index, &voxels)) {
+    return false;
+  }
+  if (tile_index.empty()) {
+    return false;
+  }
+
+  /* The tile index table is stored in front of the voxel data, padded to a
+   * whole number of elements so the voxel offsets stay element aligned. */
+  const size_t channels = (img->metadata.type == IMAGE_DATA_TYPE_FLOAT4) ? 4 : 1;
+  const size_t elem_size = channels * sizeof(float);
+  const size_t table_elems = (tile_index.size() * sizeof(uint) + elem_size - 1) / elem_size;
+  const size_t num_voxel_elems = voxels.size() / channels;
+
+  float *texture_pixels;
+
+  {
+    thread_scoped_lock device_lock(device_mutex);
+    texture_pixels = (float *)img->mem->alloc(table_elems + num_voxel_elems, 0, 0);
+  }
+
+  memcpy(texture_pixels, tile_index.data(), tile_index.size() * sizeof(uint));
+  if (!voxels.empty()) {
+    memcpy((char *)texture_pixels + table_elems * elem_size,
+           voxels.data(),
+           voxels.size() * sizeof(float));
+  }
+
+  /* The memory is allocated as a 1D array, restore the volume dimensions
+   * that the kernel uses for the tile lookup. */
+  img->mem->info.width = img->metadata.width;
+  img->mem->info.height = img->metadata.height;
+  img->mem->info.depth = img->metadata.depth;
+  img->mem->info.sparse_data_offset = (uint)table_elems;
+
+  const size_t dense_size = img->metadata.width * img->metadata.height * img->metadata.depth *
+                            elem_size;
+  VLOG(1) << "Volume " << img->loader->name() << " stored as sparse tiles, using "
+          << string_human_readable_size((table_elems + num_voxel_elems) * elem_size) << " of "
+          << string_human_readable_size(dense_size) << " dense.";
+
+  return true;
+}
+
 void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Progress *progress)
 {
   if (progress->get_cancel()) {
@@ -637,6 +720,50 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
   img->mem->info.use_transform_3d = img->metadata.use_transform_3d;
   img->mem->info.transform_3d = img->metadata.transform_3d;
 
+  /* Sample file backed 2D images through the OIIO texture cache, so pixel
+   * tiles are paged in on demand during rendering instead of loaded here.
+   * Exotic color spaces have their pixels converted on load, those images
+   * keep going through the regular loading path. */
+  if (texture_cache_system && !img->builtin && !img->metadata.use_transform_3d &&
+      img->metadata.depth <= 1 &&
+      (img->metadata.colorspace == u_colorspace_raw ||
+       img->metadata.colorspace == u_colorspace_srgb)) {
+    const ustring filepath = img->loader->osl_filepath();
+    if (!filepath.empty()) {
+      OIIO::TextureSystem *ts = (OIIO::TextureSystem *)texture_cache_system;
+      OIIO::TextureSystem::TextureHandle *handle = ts->get_texture_handle(filepath);
+      if (handle) {
+        /* Allocate a single dummy pixel, so the slot gets registered with
+         * the device like any other texture. */
+        thread_scoped_lock device_lock(device_mutex);
+        memset(img->mem->alloc(1, 1), 0, img->mem->memory_size());
+        img->mem->info.oiio_handle = (uint64_t)(uintptr_t)handle;
+        img->mem->copy_to_device();
+
+        img->loader->cleanup();
+        img->need_load = false;
+        return;
+      }
+    }
+  }
+
+  /* Volumes from loaders that can produce sparse tiles skip the dense
+   * loading path entirely. The texture limit is not applied here, sparse
+   * volumes are already compact and can not be trivially scaled. */
+  if (sparse_volumes_supported && img->metadata.depth > 1 &&
+      (type == IMAGE_DATA_TYPE_FLOAT || type == IMAGE_DATA_TYPE_FLOAT4)) {
+    if (file_load_sparse_image(img)) {
+      {
+        thread_scoped_lock device_lock(device_mutex);
+        img->mem->copy_to_device();
+      }
+
+      img->loader->cleanup();
+      img->need_load = false;
+      return;
+    }
+  }
+
   /* Create new texture. */
   if (type == IMAGE_DATA_TYPE_FLOAT4) {
     if (!file_load_image<TypeDesc::FLOAT, float>(img, texture_limit)) {
@@ -833,6 +960,65 @@ void ImageManager::device_free(Device *device)
   images.clear();
 }
 
+/* Called from the CPU kernels, defined here so the kernels do not need the
+ * OIIO headers. Returns the result through a float array instead of float4
+ * since the kernels compile their own vector types. */
+void kernel_tex_image_interp_oiio(const TextureInfo &info, float x, float y, float *result)
+{
+  OIIO::TextureSystem *ts = texture_cache_ts;
+  OIIO::TextureSystem::TextureHandle *handle = (OIIO::TextureSystem::TextureHandle *)(uintptr_t)
+                                                   info.oiio_handle;
+
+  OIIO::TextureOpt opt;
+  opt.fill = 1.0f;
+
+  switch (info.interpolation) {
+    case INTERPOLATION_CLOSEST:
+      opt.interpmode = OIIO::TextureOpt::InterpClosest;
+      break;
+    case INTERPOLATION_LINEAR:
+      opt.interpmode = OIIO::TextureOpt::InterpBilinear;
+      break;
+    default:
+      opt.interpmode = OIIO::TextureOpt::InterpSmartBicubic;
+      break;
+  }
+
+  switch (info.extension) {
+    case EXTENSION_REPEAT:
+      opt.swrap = opt.twrap = OIIO::TextureOpt::WrapPeriodic;
+      break;
+    case EXTENSION_EXTEND:
+      opt.swrap = opt.twrap = OIIO::TextureOpt::WrapClamp;
+      break;
+    default:
+      opt.swrap = opt.twrap = OIIO::TextureOpt::WrapBlack;
+      break;
+  }
+
+  const bool single_channel = (info.data_type == IMAGE_DATA_TYPE_FLOAT ||
+                               info.data_type == IMAGE_DATA_TYPE_BYTE ||
+                               info.data_type == IMAGE_DATA_TYPE_HALF ||
+                               info.data_type == IMAGE_DATA_TYPE_USHORT);
+  const int nchannels = single_channel ? 1 : 4;
+
+  /* Cycles image rows are stored bottom up, the texture cache samples top
+   * down. No ray differentials are available at this call site, with zero
+   * derivatives the finest mip level is sampled. */
+  if (!ts->texture(
+          handle, NULL, opt, x, 1.0f - y, 0.0f, 0.0f, 0.0f, 0.0f, nchannels, result, NULL, NULL)) {
+    result[0] = TEX_IMAGE_MISSING_R;
+    result[1] = TEX_IMAGE_MISSING_G;
+    result[2] = TEX_IMAGE_MISSING_B;
+    result[3] = TEX_IMAGE_MISSING_A;
+  }
+  else if (single_channel) {
+    result[1] = result[0];
+    result[2] = result[0];
+    result[3] = 1.0f;
+  }
+}
+
 void ImageManager::collect_statistics(RenderStats *stats)
 {
   foreach (const Image *image, images) {
@@ -111,6 +111,16 @@ class ImageLoader {
                            const size_t pixels_size,
                            const bool associate_alpha) = 0;
 
+  /* Load 3D image contents as sparse tiles of TEX_TILE_SIZE^3 voxels.
+   * Fills the tile index with voxel offsets (TEX_TILE_EMPTY for empty tiles)
+   * and appends the voxels of occupied tiles to the voxels array, with 1 or
+   * 4 floats per voxel depending on the image type. Returns false when the
+   * source can not produce sparse tiles, in which case the dense
+   * load_pixels() path is used. */
+  virtual bool load_sparse_pixels(const ImageMetaData &metadata,
+                                  vector<uint> *tile_index,
+                                  vector<float> *voxels);
+
   /* Name for logs and stats. */
   virtual string name() const = 0;
 
@@ -179,6 +189,12 @@ class ImageManager {
   void device_free_builtin(Device *device);
 
   void set_osl_texture_system(void *texture_system);
+
+  /* Enable sampling of file backed 2D images through the OIIO texture cache
+   * with the given memory budget in megabytes, so pixel tiles are paged in
+   * on demand instead of loading all pixels. Only works on CPU devices. */
+  void set_texture_cache(int max_size_mb);
+
   bool set_animation_frame_update(int frame);
 
   void collect_statistics(RenderStats *stats);
@@ -204,6 +220,7 @@ class ImageManager {
 
  private:
   bool has_half_images;
+  bool sparse_volumes_supported;
 
   thread_mutex device_mutex;
   thread_mutex images_mutex;
@@ -211,6 +228,7 @@ class ImageManager {
 
   vector<Image *> images;
   void *osl_texture_system;
+  void *texture_cache_system;
 
   int add_image_slot(ImageLoader *loader, const ImageParams &params, const bool builtin);
   void add_image_user(int slot);
@@ -221,6 +239,8 @@ class ImageManager {
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
 
+  bool file_load_sparse_image(Image *img);
+
   void device_load_image(Device *device, Scene *scene, int slot, Progress *progress);
   void device_free_image(Device *device, int slot);
 
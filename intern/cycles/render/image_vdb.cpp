@@ -21,8 +21,59 @@
 #  include <openvdb/tools/Dense.h>
 #endif
 
+#include "util/util_foreach.h"
+#include "util/util_texture.h"
+
 CCL_NAMESPACE_BEGIN
 
+#ifdef WITH_OPENVDB
+/* Mark all tiles that overlap an active voxel or tile of the grid. */
+template<typename GridType>
+static void vdb_mark_occupied_tiles(const GridType &grid,
+                                    const openvdb::CoordBBox &bbox,
+                                    const int tiles_x,
+                                    const int tiles_y,
+                                    vector<uint> &tile_index)
+{
+  const openvdb::Coord grid_min = bbox.min();
+
+  for (typename GridType::ValueOnCIter iter = grid.cbeginValueOn(); iter; ++iter) {
+    openvdb::CoordBBox vbbox;
+    iter.getBoundingBox(vbbox);
+    vbbox.intersect(bbox);
+    if (vbbox.empty()) {
+      continue;
+    }
+
+    const int tx0 = (vbbox.min().x() - grid_min.x()) >> TEX_TILE_SHIFT;
+    const int ty0 = (vbbox.min().y() - grid_min.y()) >> TEX_TILE_SHIFT;
+    const int tz0 = (vbbox.min().z() - grid_min.z()) >> TEX_TILE_SHIFT;
+    const int tx1 = (vbbox.max().x() - grid_min.x()) >> TEX_TILE_SHIFT;
+    const int ty1 = (vbbox.max().y() - grid_min.y()) >> TEX_TILE_SHIFT;
+    const int tz1 = (vbbox.max().z() - grid_min.z()) >> TEX_TILE_SHIFT;
+
+    for (int tz = tz0; tz <= tz1; tz++) {
+      for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) {
+          tile_index[tx + ty * tiles_x + tz * tiles_x * tiles_y] = 0;
+        }
+      }
+    }
+  }
+}
+
+/* Copy one tile worth of voxels. Voxels past the bounding box of the grid
+ * read the zero background value. */
+template<typename GridType, typename VoxelType>
+static void vdb_copy_tile(const GridType &grid,
+                          const openvdb::CoordBBox &tile_bbox,
+                          VoxelType *voxels)
+{
+  openvdb::tools::Dense<VoxelType, openvdb::tools::LayoutXYZ> dense(tile_bbox, voxels);
+  openvdb::tools::copyToDense(grid, dense);
+}
+#endif
+
 VDBImageLoader::VDBImageLoader(const string &grid_name) : grid_name(grid_name)
 {
 }
@@ -161,6 +212,94 @@ bool VDBImageLoader::load_pixels(const ImageMetaData &, void *pixels, const size
 #endif
 }
 
+bool VDBImageLoader::load_sparse_pixels(const ImageMetaData &metadata,
+                                        vector<uint> *tile_index,
+                                        vector<float> *voxels)
+{
+#ifdef WITH_OPENVDB
+  /* Only the common grid types are supported, the other types are rare
+   * enough that the dense fallback is fine for them. */
+  const bool is_float = grid->isType<openvdb::FloatGrid>();
+  const bool is_vec3f = grid->isType<openvdb::Vec3fGrid>();
+  if (!is_float && !is_vec3f) {
+    return false;
+  }
+
+  const int tiles_x = ((int)metadata.width + TEX_TILE_MASK) >> TEX_TILE_SHIFT;
+  const int tiles_y = ((int)metadata.height + TEX_TILE_MASK) >> TEX_TILE_SHIFT;
+  const int tiles_z = ((int)metadata.depth + TEX_TILE_MASK) >> TEX_TILE_SHIFT;
+
+  tile_index->resize(tiles_x * tiles_y * tiles_z, TEX_TILE_EMPTY);
+
+  if (is_float) {
+    vdb_mark_occupied_tiles(
+        *openvdb::gridConstPtrCast<openvdb::FloatGrid>(grid), bbox, tiles_x, tiles_y, *tile_index);
+  }
+  else {
+    vdb_mark_occupied_tiles(
+        *openvdb::gridConstPtrCast<openvdb::Vec3fGrid>(grid), bbox, tiles_x, tiles_y, *tile_index);
+  }
+
+  /* Assign voxel offsets to the occupied tiles in storage order. */
+  size_t num_occupied = 0;
+  foreach (uint &offset, *tile_index) {
+    if (offset != TEX_TILE_EMPTY) {
+      offset = (uint)(num_occupied * TEX_TILE_VOXELS);
+      num_occupied++;
+    }
+  }
+
+  const size_t channels = (metadata.type == IMAGE_DATA_TYPE_FLOAT4) ? 4 : 1;
+  voxels->resize(num_occupied * TEX_TILE_VOXELS * channels);
+
+  /* Copy the voxels of the occupied tiles. */
+  const openvdb::Coord grid_min = bbox.min();
+
+  for (int tz = 0; tz < tiles_z; tz++) {
+    for (int ty = 0; ty < tiles_y; ty++) {
+      for (int tx = 0; tx < tiles_x; tx++) {
+        const uint offset = (*tile_index)[tx + ty * tiles_x + tz * tiles_x * tiles_y];
+        if (offset == TEX_TILE_EMPTY) {
+          continue;
+        }
+
+        const openvdb::Coord tile_min = grid_min + openvdb::Coord(tx << TEX_TILE_SHIFT,
+                                                                  ty << TEX_TILE_SHIFT,
+                                                                  tz << TEX_TILE_SHIFT);
+        const openvdb::CoordBBox tile_bbox(
+            tile_min, tile_min + openvdb::Coord(TEX_TILE_MASK, TEX_TILE_MASK, TEX_TILE_MASK));
+
+        if (is_float) {
+          vdb_copy_tile(*openvdb::gridConstPtrCast<openvdb::FloatGrid>(grid),
+                        tile_bbox,
+                        &(*voxels)[offset]);
+        }
+        else {
+          openvdb::Vec3f tile_voxels[TEX_TILE_VOXELS];
+          vdb_copy_tile(
+              *openvdb::gridConstPtrCast<openvdb::Vec3fGrid>(grid), tile_bbox, tile_voxels);
+
+          float *voxel = &(*voxels)[offset * 4];
+          for (int i = 0; i < TEX_TILE_VOXELS; i++, voxel += 4) {
+            voxel[0] = tile_voxels[i].x();
+            voxel[1] = tile_voxels[i].y();
+            voxel[2] = tile_voxels[i].z();
+            voxel[3] = 1.0f;
+          }
+        }
+      }
+    }
+  }
+
+  return true;
+#else
+  (void)metadata;
+  (void)tile_index;
+  (void)voxels;
+  return false;
+#endif
+}
+
 string VDBImageLoader::name() const
 {
   return grid_name;
@@ -37,6 +37,10 @@ class VDBImageLoader : public ImageLoader {
                            const size_t pixels_size,
                            const bool associate_alpha) override;
 
+  virtual bool load_sparse_pixels(const ImageMetaData &metadata,
+                                  vector<uint> *tile_index,
+                                  vector<float> *voxels) override;
+
   virtual string name() const override;
 
   virtual bool equals(const ImageLoader &other) const override;
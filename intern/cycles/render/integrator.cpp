@@ -75,6 +75,7 @@ NODE_DEFINE(Integrator)
 
   SOCKET_BOOLEAN(sample_all_lights_direct, "Sample All Lights Direct", true);
   SOCKET_BOOLEAN(sample_all_lights_indirect, "Sample All Lights Indirect", true);
+  SOCKET_BOOLEAN(use_light_tree, "Use Light Tree", false);
   SOCKET_FLOAT(light_sampling_threshold, "Light Sampling Threshold", 0.05f);
 
   static NodeEnum method_enum;
@@ -73,6 +73,7 @@ class Integrator : public Node {
 
   bool sample_all_lights_direct;
   bool sample_all_lights_indirect;
+  bool use_light_tree;
   float light_sampling_threshold;
 
   int adaptive_min_samples;
@@ -26,11 +26,14 @@
 #include "render/scene.h"
 #include "render/shader.h"
 
+#include "util/util_algorithm.h"
+#include "util/util_boundbox.h"
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_logging.h"
 #include "util/util_path.h"
 #include "util/util_progress.h"
+#include "util/util_task.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -273,6 +276,200 @@ bool LightManager::object_usable_as_light(Object *object)
   return false;
 }
 
+/* Light Tree
+ *
+ * Binary BVH over the emitters of the light distribution, used by the kernel
+ * for importance based light selection. Triangles and finite lamps are split
+ * at the median of their centroids along the longest axis. Distant and
+ * background lights have no position and are kept in a separate segment
+ * after the tree emitters. */
+
+static const int LIGHT_TREE_MAX_LEAF_SIZE = 4;
+static const int LIGHT_TREE_MIN_EMITTERS_PER_TASK = 4096;
+
+struct LightTreeEmitter {
+  BoundBox bounds;
+  float3 centroid;
+  float energy;
+  /* Index into the light distribution. */
+  int index;
+
+  explicit LightTreeEmitter(int index)
+      : bounds(BoundBox::empty), centroid(make_float3(0.0f, 0.0f, 0.0f)), energy(0.0f), index(index)
+  {
+  }
+};
+
+struct LightTreeCentroidLess {
+  explicit LightTreeCentroidLess(int axis) : axis(axis)
+  {
+  }
+
+  bool operator()(const LightTreeEmitter &a, const LightTreeEmitter &b) const
+  {
+    return a.centroid[axis] < b.centroid[axis];
+  }
+
+  int axis;
+};
+
+/* Number of nodes of a subtree, known in advance since emitter ranges are
+ * always split in half. This way nodes can be written to a preallocated
+ * array from multiple tasks, without synchronization. */
+static int light_tree_subtree_size(int num_emitters)
+{
+  if (num_emitters <= LIGHT_TREE_MAX_LEAF_SIZE) {
+    return 1;
+  }
+
+  const int num_left = num_emitters / 2;
+  return 1 + light_tree_subtree_size(num_left) + light_tree_subtree_size(num_emitters - num_left);
+}
+
+static void light_tree_build_subtree(TaskPool *pool,
+                                     LightTreeEmitter *emitters,
+                                     int num_emitters,
+                                     KernelLightTreeNode *nodes,
+                                     int node_index,
+                                     int first_emitter,
+                                     float energy_scale)
+{
+  KernelLightTreeNode *node = nodes + node_index;
+
+  BoundBox bounds = BoundBox::empty;
+  float energy = 0.0f;
+
+  for (int i = 0; i < num_emitters; i++) {
+    bounds.grow(emitters[i].bounds);
+    energy += emitters[i].energy;
+  }
+
+  node->min_x = bounds.min.x;
+  node->min_y = bounds.min.y;
+  node->min_z = bounds.min.z;
+  node->max_x = bounds.max.x;
+  node->max_y = bounds.max.y;
+  node->max_z = bounds.max.z;
+  node->energy = energy * energy_scale;
+  node->first_emitter = first_emitter;
+  node->num_emitters = num_emitters;
+  node->pad1 = 0;
+  node->pad2 = 0;
+
+  if (num_emitters <= LIGHT_TREE_MAX_LEAF_SIZE) {
+    node->right_child = -1;
+    return;
+  }
+
+  /* Split in half at the median of the centroids, along the longest axis. */
+  BoundBox centroid_bounds = BoundBox::empty;
+  for (int i = 0; i < num_emitters; i++) {
+    centroid_bounds.grow(emitters[i].centroid);
+  }
+
+  const float3 centroid_size = centroid_bounds.size();
+  int axis = 2;
+  if (centroid_size.x >= centroid_size.y && centroid_size.x >= centroid_size.z) {
+    axis = 0;
+  }
+  else if (centroid_size.y >= centroid_size.z) {
+    axis = 1;
+  }
+
+  const int num_left = num_emitters / 2;
+  std::nth_element(
+      emitters, emitters + num_left, emitters + num_emitters, LightTreeCentroidLess(axis));
+
+  const int left_index = node_index + 1;
+  const int right_index = left_index + light_tree_subtree_size(num_left);
+  node->right_child = right_index;
+
+  if (num_emitters >= LIGHT_TREE_MIN_EMITTERS_PER_TASK) {
+    pool->push(function_bind(&light_tree_build_subtree,
+                             pool,
+                             emitters,
+                             num_left,
+                             nodes,
+                             left_index,
+                             first_emitter,
+                             energy_scale));
+    pool->push(function_bind(&light_tree_build_subtree,
+                             pool,
+                             emitters + num_left,
+                             num_emitters - num_left,
+                             nodes,
+                             right_index,
+                             first_emitter + num_left,
+                             energy_scale));
+  }
+  else {
+    light_tree_build_subtree(pool, emitters, num_left, nodes, left_index, first_emitter, energy_scale);
+    light_tree_build_subtree(pool,
+                             emitters + num_left,
+                             num_emitters - num_left,
+                             nodes,
+                             right_index,
+                             first_emitter + num_left,
+                             energy_scale);
+  }
+}
+
+static void light_tree_build(DeviceScene *dscene,
+                             vector<LightTreeEmitter> &emitters,
+                             const vector<LightTreeEmitter> &infinite_emitters,
+                             float totarea,
+                             int background_index)
+{
+  KernelIntegrator *kintegrator = &dscene->data.integrator;
+  const int num_tree = emitters.size();
+  const int num_emitters = num_tree + infinite_emitters.size();
+  const float energy_scale = 1.0f / totarea;
+
+  if (num_tree > 0) {
+    const int num_nodes = light_tree_subtree_size(num_tree);
+    KernelLightTreeNode *nodes = dscene->light_tree_nodes.alloc(num_nodes);
+
+    TaskPool pool;
+    light_tree_build_subtree(&pool, &emitters[0], num_tree, nodes, 0, 0, energy_scale);
+    pool.wait_work();
+
+    dscene->light_tree_nodes.copy_to_device();
+  }
+  else {
+    dscene->light_tree_nodes.free();
+  }
+
+  uint *tree_emitters = dscene->light_tree_emitters.alloc(num_emitters);
+  uint *light_to_tree = dscene->light_to_tree.alloc(num_emitters);
+
+  for (int i = 0; i < num_tree; i++) {
+    tree_emitters[i] = emitters[i].index;
+    light_to_tree[emitters[i].index] = i;
+  }
+
+  float infinite_energy = 0.0f;
+  float background_energy = 0.0f;
+
+  for (size_t i = 0; i < infinite_emitters.size(); i++) {
+    const int slot = num_tree + i;
+    tree_emitters[slot] = infinite_emitters[i].index;
+    light_to_tree[infinite_emitters[i].index] = slot;
+    infinite_energy += infinite_emitters[i].energy * energy_scale;
+
+    if (infinite_emitters[i].index == background_index) {
+      background_energy = infinite_emitters[i].energy * energy_scale;
+    }
+  }
+
+  kintegrator->use_light_tree = true;
+  kintegrator->light_tree_num_emitters = num_tree;
+  kintegrator->light_tree_infinite_energy = infinite_energy;
+  kintegrator->light_tree_background_pdf = background_energy;
+
+  dscene->light_tree_emitters.copy_to_device();
+  dscene->light_to_tree.copy_to_device();
+}
+
 void LightManager::device_update_distribution(Device *,
                                               DeviceScene *dscene,
                                               Scene *scene,
@@ -323,6 +520,18 @@ void LightManager::device_update_distribution(Device *,
   size_t num_distribution = num_triangles + num_lights;
   VLOG(1) << "Total " << num_distribution << " of light distribution primitives.";
 
+  /* The tree is only used by the path integrator, branched paths assume the
+   * flat distribution when splitting samples over all lights. */
+  const bool use_light_tree = scene->integrator->use_light_tree &&
+                              scene->integrator->method == Integrator::PATH;
+  vector<LightTreeEmitter> tree_emitters;
+  vector<LightTreeEmitter> infinite_emitters;
+  int background_index = -1;
+
+  if (use_light_tree) {
+    tree_emitters.reserve(num_distribution);
+  }
+
   /* emission area */
   KernelLightDistribution *distribution = dscene->light_distribution.alloc(num_distribution + 1);
   float totarea = 0.0f;
@@ -379,6 +588,11 @@ void LightManager::device_update_distribution(Device *,
 
         Mesh::Triangle t = mesh->get_triangle(i);
         if (!t.valid(&mesh->verts[0])) {
+          if (use_light_tree) {
+            /* Degenerate triangles keep a zero energy emitter, so that tree
+             * and distribution indices stay in sync. */
+            tree_emitters.push_back(LightTreeEmitter(offset - 1));
+          }
           continue;
         }
         float3 p1 = mesh->verts[t.v[0]];
@@ -391,7 +605,18 @@ void LightManager::device_update_distribution(Device *,
           p3 = transform_point(&tfm, p3);
         }
 
-        totarea += triangle_area(p1, p2, p3);
+        const float area = triangle_area(p1, p2, p3);
+        totarea += area;
+
+        if (use_light_tree) {
+          LightTreeEmitter emitter(offset - 1);
+          emitter.bounds.grow(p1);
+          emitter.bounds.grow(p2);
+          emitter.bounds.grow(p3);
+          emitter.centroid = (p1 + p2 + p3) * (1.0f / 3.0f);
+          emitter.energy = area;
+          tree_emitters.push_back(emitter);
+        }
       }
     }
 
@@ -427,6 +652,33 @@ void LightManager::device_update_distribution(Device *,
     else if (light->type == LIGHT_BACKGROUND) {
       num_background_lights++;
       background_mis |= light->use_mis;
+      background_index = offset;
+    }
+
+    if (use_light_tree) {
+      LightTreeEmitter emitter(offset);
+      emitter.energy = lightarea;
+
+      if (light->type == LIGHT_DISTANT || light->type == LIGHT_BACKGROUND) {
+        infinite_emitters.push_back(emitter);
+      }
+      else if (light->type == LIGHT_AREA) {
+        const float3 axisu = light->axisu * (light->sizeu * light->size * 0.5f);
+        const float3 axisv = light->axisv * (light->sizev * light->size * 0.5f);
+        emitter.centroid = light->co;
+        emitter.bounds.grow(light->co - axisu - axisv);
+        emitter.bounds.grow(light->co - axisu + axisv);
+        emitter.bounds.grow(light->co + axisu - axisv);
+        emitter.bounds.grow(light->co + axisu + axisv);
+        tree_emitters.push_back(emitter);
+      }
+      else {
+        const float3 size = make_float3(light->size, light->size, light->size);
+        emitter.centroid = light->co;
+        emitter.bounds.grow(light->co - size);
+        emitter.bounds.grow(light->co + size);
+        tree_emitters.push_back(emitter);
+      }
     }
 
     light_index++;
@@ -491,6 +743,22 @@ void LightManager::device_update_distribution(Device *,
     /* CDF */
     dscene->light_distribution.copy_to_device();
 
+    /* Light tree */
+    if (use_light_tree) {
+      VLOG(1) << "Building light tree for " << tree_emitters.size() << " emitters.";
+      light_tree_build(dscene, tree_emitters, infinite_emitters, totarea, background_index);
+    }
+    else {
+      dscene->light_tree_nodes.free();
+      dscene->light_tree_emitters.free();
+      dscene->light_to_tree.free();
+
+      kintegrator->use_light_tree = false;
+      kintegrator->light_tree_num_emitters = 0;
+      kintegrator->light_tree_infinite_energy = 0.0f;
+      kintegrator->light_tree_background_pdf = 0.0f;
+    }
+
     /* Portals */
     if (num_portals > 0) {
       kintegrator->portal_offset = light_index;
@@ -505,6 +773,9 @@ void LightManager::device_update_distribution(Device *,
   }
   else {
     dscene->light_distribution.free();
+    dscene->light_tree_nodes.free();
+    dscene->light_tree_emitters.free();
+    dscene->light_to_tree.free();
 
     kintegrator->num_distribution = 0;
     kintegrator->num_all_lights = 0;
@@ -514,6 +785,10 @@ void LightManager::device_update_distribution(Device *,
     kintegrator->num_portals = 0;
     kintegrator->portal_offset = 0;
     kintegrator->portal_pdf = 0.0f;
+    kintegrator->use_light_tree = false;
+    kintegrator->light_tree_num_emitters = 0;
+    kintegrator->light_tree_infinite_energy = 0.0f;
+    kintegrator->light_tree_background_pdf = 0.0f;
 
     kfilm->pass_shadow_scale = 1.0f;
   }
@@ -954,6 +1229,9 @@ void LightManager::device_update(Device *device,
 void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_background)
 {
   dscene->light_distribution.free();
+  dscene->light_tree_nodes.free();
+  dscene->light_tree_emitters.free();
+  dscene->light_to_tree.free();
   dscene->lights.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
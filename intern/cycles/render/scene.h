@@ -108,6 +108,9 @@ class DeviceScene {
   device_vector<KernelLight> lights;
   device_vector<float2> light_background_marginal_cdf;
   device_vector<float2> light_background_conditional_cdf;
+  device_vector<KernelLightTreeNode> light_tree_nodes;
+  device_vector<uint> light_tree_emitters;
+  device_vector<uint> light_to_tree;
 
   /* particles */
   device_vector<KernelParticle> particles;
@@ -125,6 +128,9 @@ class DeviceScene {
   /* ies lights */
   device_vector<float> ies_lights;
 
+  /* baking */
+  device_vector<int4> bake_objects;
+
   KernelData data;
 
   DeviceScene(Device *device);
@@ -171,6 +177,13 @@ class SceneParams {
   bool persistent_data;
   int texture_limit;
 
+  /* Sample file backed 2D images through the OIIO texture cache, paging
+   * pixel tiles in on demand instead of loading all pixels up front.
+   * Only supported on CPU devices. */
+  bool use_texture_cache;
+  /* Memory budget of the texture cache in megabytes. */
+  int texture_cache_size;
+
   bool background;
 
   SceneParams()
@@ -183,6 +196,8 @@ class SceneParams {
     num_bvh_time_steps = 0;
     persistent_data = false;
     texture_limit = 0;
+    use_texture_cache = false;
+    texture_cache_size = 1024;
     background = true;
   }
 
@@ -193,7 +208,9 @@ class SceneParams {
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
-             persistent_data == params.persistent_data && texture_limit == params.texture_limit);
+             persistent_data == params.persistent_data && texture_limit == params.texture_limit &&
+             use_texture_cache == params.use_texture_cache &&
+             texture_cache_size == params.texture_cache_size);
   }
 };
 
@@ -1300,6 +1300,41 @@ void Session::collect_statistics(RenderStats *render_stats)
   }
 }
 
+void Session::get_live_statistics(LiveRenderStats *live_stats)
+{
+  live_stats->mem_used = stats.mem_used;
+  live_stats->mem_peak = stats.mem_peak;
+
+  double total_time, render_time;
+  progress.get_time(total_time, render_time);
+
+  live_stats->render_time = render_time;
+  live_stats->samples_per_second = (render_time > 0.0) ?
+                                       progress.get_rendered_pixel_samples() / render_time :
+                                       0.0;
+
+  if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
+    /* Profiler samples are taken at 1ms intervals, so the number of samples
+     * approximates the milliseconds spent in each state. */
+    const uint64_t traversal_samples = profiler.get_event(PROFILING_SCENE_INTERSECT) +
+                                       profiler.get_event(PROFILING_INTERSECT) +
+                                       profiler.get_event(PROFILING_INTERSECT_LOCAL) +
+                                       profiler.get_event(PROFILING_INTERSECT_SHADOW_ALL) +
+                                       profiler.get_event(PROFILING_INTERSECT_VOLUME) +
+                                       profiler.get_event(PROFILING_INTERSECT_VOLUME_ALL);
+    const uint64_t shading_samples = profiler.get_event(PROFILING_SHADER_SETUP) +
+                                     profiler.get_event(PROFILING_SHADER_EVAL) +
+                                     profiler.get_event(PROFILING_SHADER_APPLY) +
+                                     profiler.get_event(PROFILING_CLOSURE_EVAL) +
+                                     profiler.get_event(PROFILING_CLOSURE_SAMPLE) +
+                                     profiler.get_event(PROFILING_CLOSURE_VOLUME_EVAL) +
+                                     profiler.get_event(PROFILING_CLOSURE_VOLUME_SAMPLE);
+
+    live_stats->traversal_time = traversal_samples * 0.001;
+    live_stats->shading_time = shading_samples * 0.001;
+  }
+}
+
 int Session::get_max_closure_count()
 {
   if (scene->shader_manager->use_osl()) {
@@ -175,6 +175,10 @@ class Session {
 
   void collect_statistics(RenderStats *stats);
 
+  /* Sample the live statistics, cheap enough to call periodically while the
+   * render is in progress. */
+  void get_live_statistics(LiveRenderStats *stats);
+
  protected:
   struct DelayedReset {
     thread_mutex mutex;
@@ -224,6 +224,18 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* Live statistics. */
+
+LiveRenderStats::LiveRenderStats()
+{
+  mem_used = 0;
+  mem_peak = 0;
+  render_time = 0.0;
+  samples_per_second = 0.0;
+  traversal_time = 0.0;
+  shading_time = 0.0;
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
@@ -135,6 +135,27 @@ class ImageStats {
   NamedSizeStats textures;
 };
 
+/* Live render process statistics. Unlike RenderStats, sampling these is cheap
+ * enough to do periodically while the render is in progress, so that degraded
+ * nodes can be spotted mid-render instead of post-mortem. */
+class LiveRenderStats {
+ public:
+  LiveRenderStats();
+
+  /* Current and peak device memory usage in bytes, over all render devices. */
+  size_t mem_used;
+  size_t mem_peak;
+
+  /* Render time in seconds and samples per second since the render started. */
+  double render_time;
+  double samples_per_second;
+
+  /* Approximate time in seconds spent in BVH traversal and in shading so far,
+   * from the kernel profiler. Both are zero when profiling is disabled. */
+  double traversal_time;
+  double shading_time;
+};
+
 /* Render process statistics. */
 class RenderStats {
  public:
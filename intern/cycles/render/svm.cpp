@@ -46,6 +46,35 @@ void SVMShaderManager::reset(Scene * /*scene*/)
 {
 }
 
+void SVMShaderManager::device_update_shader_hash(Scene *scene,
+                                                 Shader *shader,
+                                                 Progress *progress,
+                                                 string *hash)
+{
+  if (progress->get_cancel()) {
+    return;
+  }
+  assert(shader->graph);
+
+  /* Finalize the graph the same way compilation will, the structural hash
+   * is only meaningful after constant folding has run. */
+  ShaderNode *output = shader->graph->output();
+  const bool has_bump = (shader->displacement_method != DISPLACE_TRUE) &&
+                        output->input("Surface")->link && output->input("Displacement")->link;
+
+  shader->graph->finalize(scene,
+                          has_bump,
+                          shader->has_integrator_dependency,
+                          shader->displacement_method == DISPLACE_BOTH);
+
+  /* The background shader compiles differently, keep it apart from regular
+   * shaders with an identical graph. */
+  const bool is_background = (shader == scene->background->get_shader(scene));
+
+  *hash = string_printf(
+      "%s_%d_%d", shader->graph->content_hash().c_str(), shader->displacement_method, is_background);
+}
+
 void SVMShaderManager::device_update_shader(Scene *scene,
                                             Shader *shader,
                                             Progress *progress,
@@ -85,37 +114,127 @@ void SVMShaderManager::device_update(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
-  /* Build all shaders. */
-  TaskPool task_pool;
-  vector<array<int4>> shader_svm_nodes(num_shaders);
-  for (int i = 0; i < num_shaders; i++) {
-    task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
-                                 this,
-                                 scene,
-                                 scene->shaders[i],
-                                 &progress,
-                                 &shader_svm_nodes[i]),
-                   false);
+  /* The cache only deduplicates within this update. Entries can not be kept across updates:
+   * the compiled code embeds image/IES slots whose references are owned by the shader that
+   * actually compiled, so cached code could point at slots that were freed or reused since. */
+  compile_cache.clear();
+
+  /* Finalize all graphs and compute their structural hashes, so shaders with
+   * identical graphs compile once per update. */
+  vector<string> shader_hashes(num_shaders);
+  {
+    TaskPool task_pool;
+    for (int i = 0; i < num_shaders; i++) {
+      task_pool.push(function_bind(&SVMShaderManager::device_update_shader_hash,
+                                   this,
+                                   scene,
+                                   scene->shaders[i],
+                                   &progress,
+                                   &shader_hashes[i]),
+                     false);
+    }
+    task_pool.wait_work();
   }
-  task_pool.wait_work();
 
   if (progress.get_cancel()) {
     return;
   }
 
+  /* Build shaders whose graph is not in the compile cache yet, one per
+   * unique graph. */
+  vector<int> new_shader_index;
+  {
+    set<string> new_hashes;
+    for (int i = 0; i < num_shaders; i++) {
+      const string &hash = shader_hashes[i];
+      if (compile_cache.find(hash) == compile_cache.end() &&
+          new_hashes.find(hash) == new_hashes.end()) {
+        new_hashes.insert(hash);
+        new_shader_index.push_back(i);
+      }
+    }
+  }
+
+  const int num_new_shaders = new_shader_index.size();
+
+  VLOG(1) << "Compiling " << num_new_shaders << " unique shaders, "
+          << num_shaders - num_new_shaders << " found in the cache.";
+
+  {
+    TaskPool task_pool;
+    vector<array<int4>> shader_svm_nodes(num_new_shaders);
+    for (int i = 0; i < num_new_shaders; i++) {
+      task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
+                                   this,
+                                   scene,
+                                   scene->shaders[new_shader_index[i]],
+                                   &progress,
+                                   &shader_svm_nodes[i]),
+                     false);
+    }
+    task_pool.wait_work();
+
+    if (progress.get_cancel()) {
+      return;
+    }
+
+    /* Store compiled code and the shader flags compilation computed in the
+     * cache, so shaders with the same graph can copy them. */
+    for (int i = 0; i < num_new_shaders; i++) {
+      Shader *shader = scene->shaders[new_shader_index[i]];
+      CachedShader &cached = compile_cache[shader_hashes[new_shader_index[i]]];
+
+      cached.svm_nodes.steal_data(shader_svm_nodes[i]);
+
+      cached.has_surface = shader->has_surface;
+      cached.has_surface_emission = shader->has_surface_emission;
+      cached.has_surface_transparent = shader->has_surface_transparent;
+      cached.has_surface_bssrdf = shader->has_surface_bssrdf;
+      cached.has_bump = shader->has_bump;
+      cached.has_bssrdf_bump = shader->has_bssrdf_bump;
+      cached.has_volume = shader->has_volume;
+      cached.has_displacement = shader->has_displacement;
+      cached.has_surface_spatial_varying = shader->has_surface_spatial_varying;
+      cached.has_volume_spatial_varying = shader->has_volume_spatial_varying;
+      cached.has_volume_attribute_dependency = shader->has_volume_attribute_dependency;
+      cached.has_integrator_dependency = shader->has_integrator_dependency;
+    }
+  }
+
   /* The global node list contains a jump table (one node per shader)
-   * followed by the nodes of all shaders. */
+   * followed by the nodes of all unique shaders, shaders with identical
+   * graphs share one entry. */
+  map<string, int> hash_node_offset;
   int svm_nodes_size = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
-    /* Since we're not copying the local jump node, the size ends up being one node lower. */
-    svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    const string &hash = shader_hashes[i];
+    if (hash_node_offset.find(hash) == hash_node_offset.end()) {
+      hash_node_offset[hash] = svm_nodes_size;
+      /* Since we're not copying the local jump node, the size ends up being one node lower. */
+      svm_nodes_size += compile_cache[hash].svm_nodes.size() - 1;
+    }
   }
 
   int4 *svm_nodes = dscene->svm_nodes.alloc(svm_nodes_size);
 
-  int node_offset = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
     Shader *shader = scene->shaders[i];
+    const CachedShader &cached = compile_cache[shader_hashes[i]];
+
+    /* Restore the flags for shaders that were not compiled this update. For
+     * freshly compiled shaders this matches what compilation just set. */
+    shader->has_surface = cached.has_surface;
+    shader->has_surface_emission = cached.has_surface_emission;
+    shader->has_surface_transparent = cached.has_surface_transparent;
+    shader->has_surface_bssrdf = cached.has_surface_bssrdf;
+    shader->has_bump = cached.has_bump;
+    shader->has_bssrdf_bump = cached.has_bssrdf_bump;
+    shader->has_volume = cached.has_volume;
+    shader->has_displacement = cached.has_displacement;
+    shader->has_surface_spatial_varying = cached.has_surface_spatial_varying;
+    shader->has_volume_spatial_varying = cached.has_volume_spatial_varying;
+    shader->has_volume_attribute_dependency = cached.has_volume_attribute_dependency;
+    shader->has_integrator_dependency = cached.has_integrator_dependency;
 
     shader->need_update = false;
     if (shader->use_mis && shader->has_surface_emission) {
@@ -125,24 +244,22 @@ void SVMShaderManager::device_update(Device *device,
     /* Update the global jump table.
      * Each compiled shader starts with a jump node that has offsets local
      * to the shader, so copy those and add the offset into the global node list. */
+    const int node_offset = hash_node_offset[shader_hashes[i]];
     int4 &global_jump_node = svm_nodes[shader->id];
-    int4 &local_jump_node = shader_svm_nodes[i][0];
+    const int4 &local_jump_node = cached.svm_nodes[0];
 
     global_jump_node.x = NODE_SHADER_JUMP;
     global_jump_node.y = local_jump_node.y - 1 + node_offset;
     global_jump_node.z = local_jump_node.z - 1 + node_offset;
     global_jump_node.w = local_jump_node.w - 1 + node_offset;
-
-    node_offset += shader_svm_nodes[i].size() - 1;
   }
 
-  /* Copy the nodes of each shader into the correct location. */
-  svm_nodes += num_shaders;
-  for (int i = 0; i < num_shaders; i++) {
-    int shader_size = shader_svm_nodes[i].size() - 1;
+  /* Copy the nodes of each unique shader into the correct location. */
+  typedef map<string, int> OffsetMap;
+  foreach (OffsetMap::value_type &entry, hash_node_offset) {
+    const array<int4> &nodes = compile_cache[entry.first].svm_nodes;
 
-    memcpy(svm_nodes, &shader_svm_nodes[i][1], sizeof(int4) * shader_size);
-    svm_nodes += shader_size;
+    memcpy(svm_nodes + entry.second, &nodes[1], sizeof(int4) * (nodes.size() - 1));
   }
 
   if (progress.get_cancel()) {
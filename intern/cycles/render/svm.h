@@ -22,6 +22,7 @@
 #include "render/shader.h"
 
 #include "util/util_array.h"
+#include "util/util_map.h"
 #include "util/util_set.h"
 #include "util/util_string.h"
 #include "util/util_thread.h"
@@ -50,10 +51,34 @@ class SVMShaderManager : public ShaderManager {
   void device_free(Device *device, DeviceScene *dscene, Scene *scene);
 
  protected:
+  /* Compiled SVM code and the shader flags that compilation computed, shared
+   * between shaders with structurally identical graphs. Cleared at the start
+   * of every device update: the compiled code embeds image slots whose
+   * references are only held by the shader that compiled it. */
+  struct CachedShader {
+    array<int4> svm_nodes;
+
+    bool has_surface;
+    bool has_surface_emission;
+    bool has_surface_transparent;
+    bool has_surface_bssrdf;
+    bool has_bump;
+    bool has_bssrdf_bump;
+    bool has_volume;
+    bool has_displacement;
+    bool has_surface_spatial_varying;
+    bool has_volume_spatial_varying;
+    bool has_volume_attribute_dependency;
+    bool has_integrator_dependency;
+  };
+
+  void device_update_shader_hash(Scene *scene, Shader *shader, Progress *progress, string *hash);
   void device_update_shader(Scene *scene,
                             Shader *shader,
                             Progress *progress,
                             array<int4> *svm_nodes);
+
+  map<string, CachedShader> compile_cache;
 };
 
 /* Graph Compiler */
@@ -495,6 +495,55 @@ bool TileManager::finish_tile(const int index, const bool need_denoise, bool &de
   }
 }
 
+int TileManager::steal_tile(vector<list<int>> &tile_lists, int device)
+{
+  /* Steal from the device which has the most tiles left, so that all devices
+   * run out of work at roughly the same time. */
+  list<int> *victim = NULL;
+  foreach (list<int> &tile_list, tile_lists) {
+    if (victim == NULL || tile_list.size() > victim->size()) {
+      victim = &tile_list;
+    }
+  }
+
+  if (victim == NULL || victim->empty()) {
+    return -1;
+  }
+
+  /* Move the back half of the victim list over, so the victim keeps working
+   * through its own tile order and repeated stealing stays cheap. Devices
+   * outside of the logical range (a separate denoising device) have no own
+   * list and just grab single tiles. */
+  if (device < tile_lists.size() && victim->size() > 1) {
+    list<int> &own_list = tile_lists[device];
+    list<int>::iterator middle = victim->begin();
+    for (size_t i = (victim->size() + 1) / 2; i != 0; i--) {
+      middle++;
+    }
+    own_list.splice(own_list.begin(), *victim, middle, victim->end());
+    victim = &own_list;
+  }
+
+  int tile_index = victim->front();
+  victim->pop_front();
+  return tile_index;
+}
+
+int TileManager::next_tile_index(vector<list<int>> &tile_lists, int device, bool preserve_device)
+{
+  if (device < tile_lists.size() && !tile_lists[device].empty()) {
+    int tile_index = tile_lists[device].front();
+    tile_lists[device].pop_front();
+    return tile_index;
+  }
+
+  if (preserve_device) {
+    return -1;
+  }
+
+  return steal_tile(tile_lists, device);
+}
+
 bool TileManager::next_tile(Tile *&tile, int device, uint tile_types)
 {
   /* Preserve device if requested, unless this is a separate denoising device that just wants to
@@ -502,24 +551,7 @@ bool TileManager::next_tile(Tile *&tile, int device, uint tile_types)
   const bool preserve_device = preserve_tile_device && device < num_devices;
 
   if (tile_types & RenderTile::DENOISE) {
-    int tile_index = -1;
-    int logical_device = preserve_device ? device : 0;
-
-    while (logical_device < state.denoising_tiles.size()) {
-      if (state.denoising_tiles[logical_device].empty()) {
-        if (preserve_device) {
-          break;
-        }
-        else {
-          logical_device++;
-          continue;
-        }
-      }
-
-      tile_index = state.denoising_tiles[logical_device].front();
-      state.denoising_tiles[logical_device].pop_front();
-      break;
-    }
+    int tile_index = next_tile_index(state.denoising_tiles, device, preserve_device);
 
     if (tile_index >= 0) {
       tile = &state.tiles[tile_index];
@@ -528,24 +560,7 @@ bool TileManager::next_tile(Tile *&tile, int device, uint tile_types)
   }
 
   if (tile_types & RenderTile::PATH_TRACE) {
-    int tile_index = -1;
-    int logical_device = preserve_device ? device : 0;
-
-    while (logical_device < state.render_tiles.size()) {
-      if (state.render_tiles[logical_device].empty()) {
-        if (preserve_device) {
-          break;
-        }
-        else {
-          logical_device++;
-          continue;
-        }
-      }
-
-      tile_index = state.render_tiles[logical_device].front();
-      state.render_tiles[logical_device].pop_front();
-      break;
-    }
+    int tile_index = next_tile_index(state.render_tiles, device, preserve_device);
 
     if (tile_index >= 0) {
       tile = &state.tiles[tile_index];
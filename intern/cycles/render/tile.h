@@ -165,6 +165,11 @@ class TileManager {
   /* Generate tile list, return number of tiles. */
   int gen_tiles(bool sliced);
   void gen_render_tiles();
+
+  /* Acquire the next tile index for a device from the given per-device lists,
+   * stealing work from other devices when its own list has run out. */
+  int next_tile_index(vector<list<int>> &tile_lists, int device, bool preserve_device);
+  int steal_tile(vector<list<int>> &tile_lists, int device);
 };
 
 CCL_NAMESPACE_END
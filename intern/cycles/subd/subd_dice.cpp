@@ -56,19 +56,6 @@ void EdgeDice::reserve(int num_verts, int num_triangles)
   params.mesh->num_subd_verts += num_verts;
 }
 
-void EdgeDice::set_vert(Patch *patch, int index, float2 uv)
-{
-  float3 P, N;
-
-  patch->eval(&P, NULL, NULL, &N, uv.x, uv.y);
-
-  assert(index < params.mesh->verts.size());
-
-  mesh_P[index] = P;
-  mesh_N[index] = N;
-  params.mesh->vert_patch_uv[index + vert_offset] = make_float2(uv.x, uv.y);
-}
-
 void EdgeDice::add_triangle(Patch *patch, int v0, int v1, int v2)
 {
   Mesh *mesh = params.mesh;
@@ -152,12 +139,20 @@ float3 QuadDice::eval_projected(Subpatch &sub, float u, float v)
   return P;
 }
 
-void QuadDice::set_vert(Subpatch &sub, int index, float u, float v)
+void QuadDice::eval_vert(Subpatch &sub, int index, float u, float v, vector<SubpatchVert> *verts)
 {
-  EdgeDice::set_vert(sub.patch, index, map_uv(sub, u, v));
+  float2 uv = map_uv(sub, u, v);
+
+  SubpatchVert vert;
+  vert.index = index;
+  vert.uv = uv;
+
+  sub.patch->eval(&vert.P, NULL, NULL, &vert.N, uv.x, uv.y);
+
+  verts->push_back(vert);
 }
 
-void QuadDice::set_side(Subpatch &sub, int edge)
+void QuadDice::eval_side(Subpatch &sub, int edge, vector<SubpatchVert> *verts)
 {
   int t = sub.edges[edge].T;
 
@@ -186,7 +181,50 @@ void QuadDice::set_side(Subpatch &sub, int edge)
         break;
     }
 
-    set_vert(sub, sub.get_vert_along_edge(edge, i), u, v);
+    eval_vert(sub, sub.get_vert_along_edge(edge, i), u, v, verts);
+  }
+}
+
+void QuadDice::eval_verts(Subpatch *sub_, vector<SubpatchVert> *verts)
+{
+  Subpatch &sub = *sub_;
+
+  int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
+  int Mv = max(sub.edge_v0.T, sub.edge_v1.T);
+  Mu = max(Mu, 2);
+  Mv = max(Mv, 2);
+
+  /* inner grid */
+  float du = 1.0f / (float)Mu;
+  float dv = 1.0f / (float)Mv;
+
+  for (int j = 1; j < Mv; j++) {
+    for (int i = 1; i < Mu; i++) {
+      eval_vert(sub,
+                sub.inner_grid_vert_offset + (i - 1) + (j - 1) * (Mu - 1),
+                i * du,
+                j * dv,
+                verts);
+    }
+  }
+
+  /* sides */
+  eval_side(sub, 0, verts);
+  eval_side(sub, 1, verts);
+  eval_side(sub, 2, verts);
+  eval_side(sub, 3, verts);
+}
+
+void QuadDice::commit_verts(const vector<SubpatchVert> &verts)
+{
+  for (size_t i = 0; i < verts.size(); i++) {
+    const SubpatchVert &vert = verts[i];
+
+    assert(vert.index < params.mesh->verts.size());
+
+    mesh_P[vert.index] = vert.P;
+    mesh_N[vert.index] = vert.N;
+    params.mesh->vert_patch_uv[vert.index + vert_offset] = vert.uv;
   }
 }
 
@@ -224,33 +262,23 @@ float QuadDice::scale_factor(Subpatch &sub, int Mu, int Mv)
   return S;
 }
 
-void QuadDice::add_grid(Subpatch &sub, int Mu, int Mv, int offset)
+void QuadDice::add_grid_triangles(Subpatch &sub, int Mu, int Mv, int offset)
 {
-  /* create inner grid */
-  float du = 1.0f / (float)Mu;
-  float dv = 1.0f / (float)Mv;
-
-  for (int j = 1; j < Mv; j++) {
-    for (int i = 1; i < Mu; i++) {
-      float u = i * du;
-      float v = j * dv;
-
-      set_vert(sub, offset + (i - 1) + (j - 1) * (Mu - 1), u, v);
-
-      if (i < Mu - 1 && j < Mv - 1) {
-        int i1 = offset + (i - 1) + (j - 1) * (Mu - 1);
-        int i2 = offset + i + (j - 1) * (Mu - 1);
-        int i3 = offset + i + j * (Mu - 1);
-        int i4 = offset + (i - 1) + j * (Mu - 1);
-
-        add_triangle(sub.patch, i1, i2, i3);
-        add_triangle(sub.patch, i1, i3, i4);
-      }
+  /* triangulate inner grid */
+  for (int j = 1; j < Mv - 1; j++) {
+    for (int i = 1; i < Mu - 1; i++) {
+      int i1 = offset + (i - 1) + (j - 1) * (Mu - 1);
+      int i2 = offset + i + (j - 1) * (Mu - 1);
+      int i3 = offset + i + j * (Mu - 1);
+      int i4 = offset + (i - 1) + j * (Mu - 1);
+
+      add_triangle(sub.patch, i1, i2, i3);
+      add_triangle(sub.patch, i1, i3, i4);
     }
   }
 }
 
-void QuadDice::dice(Subpatch &sub)
+void QuadDice::dice_triangles(Subpatch &sub)
 {
   /* compute inner grid size with scale factor */
   int Mu = max(sub.edge_u0.T, sub.edge_u1.T);
@@ -266,13 +294,7 @@ void QuadDice::dice(Subpatch &sub)
   Mv = max((int)ceilf(S * Mv), 2);  // XXX handle 0 & 1?
 
   /* inner grid */
-  add_grid(sub, Mu, Mv, sub.inner_grid_vert_offset);
-
-  /* sides */
-  set_side(sub, 0);
-  set_side(sub, 1);
-  set_side(sub, 2);
-  set_side(sub, 3);
+  add_grid_triangles(sub, Mu, Mv, sub.inner_grid_vert_offset);
 
   stitch_triangles(sub, 0);
   stitch_triangles(sub, 1);
@@ -280,4 +302,13 @@ void QuadDice::dice(Subpatch &sub)
   stitch_triangles(sub, 3);
 }
 
+void QuadDice::dice(Subpatch &sub)
+{
+  vector<SubpatchVert> verts;
+
+  eval_verts(&sub, &verts);
+  commit_verts(verts);
+  dice_triangles(sub);
+}
+
 CCL_NAMESPACE_END
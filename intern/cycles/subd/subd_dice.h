@@ -71,7 +71,6 @@ class EdgeDice {
 
   void reserve(int num_verts, int num_triangles);
 
-  void set_vert(Patch *patch, int index, float2 uv);
   void add_triangle(Patch *patch, int v0, int v1, int v2);
 
   void stitch_triangles(Subpatch &sub, int edge);
@@ -81,20 +80,34 @@ class EdgeDice {
 
 class QuadDice : public EdgeDice {
  public:
+  /* Evaluated limit surface vert of a subpatch, to be committed to the mesh
+   * arrays later. Keeping evaluation and commit separate allows evaluating
+   * multiple subpatches in parallel, verts on edges shared between
+   * subpatches are simply evaluated twice. */
+  struct SubpatchVert {
+    int index;
+    float3 P;
+    float3 N;
+    float2 uv;
+  };
+
   explicit QuadDice(const SubdParams &params);
 
   float3 eval_projected(Subpatch &sub, float u, float v);
 
   float2 map_uv(Subpatch &sub, float u, float v);
-  void set_vert(Subpatch &sub, int index, float u, float v);
 
-  void add_grid(Subpatch &sub, int Mu, int Mv, int offset);
+  void eval_vert(Subpatch &sub, int index, float u, float v, vector<SubpatchVert> *verts);
+  void eval_side(Subpatch &sub, int edge, vector<SubpatchVert> *verts);
+  void eval_verts(Subpatch *sub, vector<SubpatchVert> *verts);
+  void commit_verts(const vector<SubpatchVert> &verts);
 
-  void set_side(Subpatch &sub, int edge);
+  void add_grid_triangles(Subpatch &sub, int Mu, int Mv, int offset);
 
   float quad_area(const float3 &a, const float3 &b, const float3 &c, const float3 &d);
   float scale_factor(Subpatch &sub, int Mu, int Mv);
 
+  void dice_triangles(Subpatch &sub);
   void dice(Subpatch &sub);
 };
 
@@ -25,6 +25,7 @@
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_math.h"
+#include "util/util_task.h"
 #include "util/util_types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -333,15 +334,22 @@ int DiagSplit::alloc_verts(int n)
 
 Edge *DiagSplit::alloc_edge()
 {
+  if (edge_groups.empty()) {
+    edge_groups.emplace_back();
+  }
+
+  deque<Edge> &edges = edge_groups.back();
   edges.emplace_back();
   return &edges.back();
 }
 
-void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
+void DiagSplit::split_faces(Patch *patches,
+                            size_t patches_byte_stride,
+                            int face_start,
+                            int face_end,
+                            int patch_index)
 {
-  int patch_index = 0;
-
-  for (int f = 0; f < params.mesh->subd_faces.size(); f++) {
+  for (int f = face_start; f < face_end; f++) {
     Mesh::SubdFace &face = params.mesh->subd_faces[f];
 
     Patch *patch = (Patch *)(((char *)patches) + patch_index * patches_byte_stride);
@@ -357,6 +365,66 @@ void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
       split_ngon(face, patch, patches_byte_stride);
     }
   }
+}
+
+void DiagSplit::split_patches(Patch *patches, size_t patches_byte_stride)
+{
+  const int num_faces = params.mesh->subd_faces.size();
+
+  /* Split faces in parallel, one worker DiagSplit per task so no
+   * synchronization on the edge and vert allocators is needed. Workers are
+   * merged in face order below, keeping the result deterministic. */
+  const int faces_per_task = max(num_faces / (TaskScheduler::num_threads() * 4), 8);
+  const int num_tasks = (num_faces + faces_per_task - 1) / faces_per_task;
+
+  vector<DiagSplit> workers;
+  workers.resize(num_tasks, DiagSplit(params));
+
+  TaskPool pool;
+
+  int patch_index = 0;
+  for (int task = 0; task < num_tasks; task++) {
+    const int face_start = task * faces_per_task;
+    const int face_end = min(face_start + faces_per_task, num_faces);
+
+    pool.push(function_bind(&DiagSplit::split_faces,
+                            &workers[task],
+                            patches,
+                            patches_byte_stride,
+                            face_start,
+                            face_end,
+                            patch_index));
+
+    for (int f = face_start; f < face_end; f++) {
+      Mesh::SubdFace &face = params.mesh->subd_faces[f];
+      patch_index += face.is_quad() ? 1 : face.num_corners;
+    }
+  }
+
+  pool.wait_work();
+
+  /* Merge worker results in face order. Vert indices are rebased onto the
+   * main allocator, edge groups are spliced over without moving elements so
+   * that edge pointers held by the subpatches stay valid. */
+  foreach (DiagSplit &worker, workers) {
+    const int vert_base = num_alloced_verts;
+    num_alloced_verts += worker.num_alloced_verts;
+
+    foreach (deque<Edge> &group, worker.edge_groups) {
+      foreach (Edge &edge, group) {
+        if (edge.start_vert_index >= 0) {
+          edge.start_vert_index += vert_base;
+        }
+        if (edge.end_vert_index >= 0) {
+          edge.end_vert_index += vert_base;
+        }
+      }
+    }
+
+    edge_groups.splice(edge_groups.end(), worker.edge_groups);
+
+    subpatches.insert(subpatches.end(), worker.subpatches.begin(), worker.subpatches.end());
+  }
 
   params.mesh->vert_to_stitching_key_map.clear();
   params.mesh->vert_stitching_map.clear();
@@ -607,14 +675,16 @@ void DiagSplit::post_split()
 
   /* All patches are now split, and all T values known. */
 
-  foreach (Edge &edge, edges) {
-    if (edge.second_vert_index < 0) {
-      edge.second_vert_index = alloc_verts(edge.T - 1);
-    }
+  foreach (deque<Edge> &edges, edge_groups) {
+    foreach (Edge &edge, edges) {
+      if (edge.second_vert_index < 0) {
+        edge.second_vert_index = alloc_verts(edge.T - 1);
+      }
 
-    if (edge.is_stitch_edge) {
-      num_stitch_verts = max(num_stitch_verts,
-                             max(edge.stitch_start_vert_index, edge.stitch_end_vert_index));
+      if (edge.is_stitch_edge) {
+        num_stitch_verts = max(num_stitch_verts,
+                               max(edge.stitch_start_vert_index, edge.stitch_end_vert_index));
+      }
     }
   }
 
@@ -630,44 +700,51 @@ void DiagSplit::post_split()
   typedef unordered_map<pair<int, int>, int, pair_hasher> edge_stitch_verts_map_t;
   edge_stitch_verts_map_t edge_stitch_verts_map;
 
-  foreach (Edge &edge, edges) {
-    if (edge.is_stitch_edge) {
-      if (edge.stitch_edge_T == 0) {
-        edge.stitch_edge_T = edge.T;
-      }
+  foreach (deque<Edge> &edges, edge_groups) {
+    foreach (Edge &edge, edges) {
+      if (edge.is_stitch_edge) {
+        if (edge.stitch_edge_T == 0) {
+          edge.stitch_edge_T = edge.T;
+        }
 
-      if (edge_stitch_verts_map.find(edge.stitch_edge_key) == edge_stitch_verts_map.end()) {
-        edge_stitch_verts_map[edge.stitch_edge_key] = num_stitch_verts;
-        num_stitch_verts += edge.stitch_edge_T - 1;
+        if (edge_stitch_verts_map.find(edge.stitch_edge_key) == edge_stitch_verts_map.end()) {
+          edge_stitch_verts_map[edge.stitch_edge_key] = num_stitch_verts;
+          num_stitch_verts += edge.stitch_edge_T - 1;
+        }
       }
     }
   }
 
   /* Set start and end indices for edges generated from a split. */
-  foreach (Edge &edge, edges) {
-    if (edge.start_vert_index < 0) {
-      /* Fixup offsets. */
-      if (edge.top_indices_decrease) {
-        edge.top_offset = edge.top->T - edge.top_offset;
+  foreach (deque<Edge> &edges, edge_groups) {
+    foreach (Edge &edge, edges) {
+      if (edge.start_vert_index < 0) {
+        /* Fixup offsets. */
+        if (edge.top_indices_decrease) {
+          edge.top_offset = edge.top->T - edge.top_offset;
+        }
+
+        edge.start_vert_index = edge.top->get_vert_along_edge(edge.top_offset);
       }
 
-      edge.start_vert_index = edge.top->get_vert_along_edge(edge.top_offset);
-    }
+      if (edge.end_vert_index < 0) {
+        if (edge.bottom_indices_decrease) {
+          edge.bottom_offset = edge.bottom->T - edge.bottom_offset;
+        }
 
-    if (edge.end_vert_index < 0) {
-      if (edge.bottom_indices_decrease) {
-        edge.bottom_offset = edge.bottom->T - edge.bottom_offset;
+        edge.end_vert_index = edge.bottom->get_vert_along_edge(edge.bottom_offset);
       }
-
-      edge.end_vert_index = edge.bottom->get_vert_along_edge(edge.bottom_offset);
     }
   }
 
   int vert_offset = params.mesh->verts.size();
 
   /* Add verts to stitching map. */
-  foreach (const Edge &edge, edges) {
-    if (edge.is_stitch_edge) {
+  foreach (const deque<Edge> &edges, edge_groups) {
+    foreach (const Edge &edge, edges) {
+      if (!edge.is_stitch_edge) {
+        continue;
+      }
       int second_stitch_vert_index = edge_stitch_verts_map[edge.stitch_edge_key];
 
       for (int i = 0; i <= edge.T; i++) {
@@ -721,14 +798,6 @@ void DiagSplit::post_split()
   int num_verts = num_alloced_verts;
   int num_triangles = 0;
 
-  for (size_t i = 0; i < subpatches.size(); i++) {
-    subpatches[i].inner_grid_vert_offset = num_verts;
-    num_verts += subpatches[i].calc_num_inner_verts();
-    num_triangles += subpatches[i].calc_num_triangles();
-  }
-
-  dice.reserve(num_verts, num_triangles);
-
   for (size_t i = 0; i < subpatches.size(); i++) {
     Subpatch &sub = subpatches[i];
 
@@ -737,12 +806,54 @@ void DiagSplit::post_split()
     sub.edge_v0.T = max(sub.edge_v0.T, 1);
     sub.edge_v1.T = max(sub.edge_v1.T, 1);
 
-    dice.dice(sub);
+    sub.inner_grid_vert_offset = num_verts;
+    num_verts += sub.calc_num_inner_verts();
+    num_triangles += sub.calc_num_triangles();
+  }
+
+  dice.reserve(num_verts, num_triangles);
+
+  /* Evaluate limit surface verts in parallel, in chunks so the scratch memory
+   * stays bounded and can be released before the next chunk is evaluated.
+   * Committing the verts to the mesh arrays is serial and in subpatch order,
+   * which keeps the result identical to a serial dice. */
+  static const int DICE_VERTS_PER_CHUNK = 1 << 20;
+
+  for (size_t chunk_start = 0; chunk_start < subpatches.size();) {
+    size_t chunk_end = chunk_start;
+    int chunk_verts = 0;
+
+    while (chunk_end < subpatches.size() && chunk_verts < DICE_VERTS_PER_CHUNK) {
+      chunk_verts += subpatches[chunk_end].calc_num_inner_verts();
+      chunk_end++;
+    }
+
+    vector<vector<QuadDice::SubpatchVert>> chunk_scratch(chunk_end - chunk_start);
+
+    TaskPool pool;
+
+    for (size_t i = chunk_start; i < chunk_end; i++) {
+      pool.push(function_bind(
+          &QuadDice::eval_verts, &dice, &subpatches[i], &chunk_scratch[i - chunk_start]));
+    }
+
+    pool.wait_work();
+
+    for (size_t i = chunk_start; i < chunk_end; i++) {
+      dice.commit_verts(chunk_scratch[i - chunk_start]);
+    }
+
+    chunk_start = chunk_end;
+  }
+
+  /* Add triangles serially so they end up in deterministic order. */
+  for (size_t i = 0; i < subpatches.size(); i++) {
+    dice.dice_triangles(subpatches[i]);
   }
 
   /* Cleanup */
   subpatches.clear();
-  edges.clear();
+  edge_groups.clear();
 }
 
 CCL_NAMESPACE_END
@@ -26,11 +26,10 @@
 #include "subd/subd_subpatch.h"
 
 #include "util/util_deque.h"
+#include "util/util_list.h"
 #include "util/util_types.h"
 #include "util/util_vector.h"
 
-#include <deque>
-
 CCL_NAMESPACE_BEGIN
 
 class Mesh;
@@ -40,8 +39,10 @@ class DiagSplit {
   SubdParams params;
 
   vector<Subpatch> subpatches;
-  /* deque is used so that element pointers remain vaild when size is changed. */
-  deque<Edge> edges;
+  /* deque is used so that element pointers remain vaild when size is changed.
+   * Worker splits keep a single group, the groups of all workers are spliced
+   * into the main split without moving any elements when merging. */
+  list<deque<Edge>> edge_groups;
 
   float3 to_world(Patch *patch, float2 uv);
   int T(Patch *patch, float2 Pstart, float2 Pend, bool recursive_resolve = false);
@@ -57,6 +58,14 @@ class DiagSplit {
   int num_alloced_verts = 0;
   int alloc_verts(int n); /* Returns start index of new verts. */
 
+  /* Split a range of faces, used to split faces in parallel with one
+   * DiagSplit per task. */
+  void split_faces(Patch *patches,
+                   size_t patches_byte_stride,
+                   int face_start,
+                   int face_end,
+                   int patch_index);
+
  public:
   Edge *alloc_edge();
 
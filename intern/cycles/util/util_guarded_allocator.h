@@ -31,6 +31,13 @@ CCL_NAMESPACE_BEGIN
 void util_guarded_mem_alloc(size_t n);
 void util_guarded_mem_free(size_t n);
 
+void *util_guarded_numa_malloc(size_t size);
+void util_guarded_numa_free(void *p, size_t size);
+
+/* Allocations of at least this size are placed on the NUMA node of the
+ * allocating thread, smaller ones are not worth the page granularity. */
+#define UTIL_GUARDED_NUMA_THRESHOLD (1024 * 1024)
+
 /* Guarded allocator for the use with STL. */
 template<typename T> class GuardedAllocator {
  public:
@@ -58,16 +65,21 @@ template<typename T> class GuardedAllocator {
       return NULL;
     }
     T *mem;
+    if (size >= UTIL_GUARDED_NUMA_THRESHOLD) {
+      mem = (T *)util_guarded_numa_malloc(size);
+    }
+    else {
 #ifdef WITH_BLENDER_GUARDEDALLOC
-    /* C++ standard requires allocation functions to allocate memory suitably
-     * aligned for any standard type. This is 16 bytes for 64 bit platform as
-     * far as i concerned. We might over-align on 32bit here, but that should
-     * be all safe actually.
-     */
-    mem = (T *)MEM_mallocN_aligned(size, 16, "Cycles Alloc");
+      /* C++ standard requires allocation functions to allocate memory suitably
+       * aligned for any standard type. This is 16 bytes for 64 bit platform as
+       * far as i concerned. We might over-align on 32bit here, but that should
+       * be all safe actually.
+       */
+      mem = (T *)MEM_mallocN_aligned(size, 16, "Cycles Alloc");
 #else
-    mem = (T *)malloc(size);
+      mem = (T *)malloc(size);
 #endif
+    }
     if (mem == NULL) {
       throw std::bad_alloc();
     }
@@ -76,13 +88,19 @@ template<typename T> class GuardedAllocator {
 
   void deallocate(T *p, size_t n)
   {
-    util_guarded_mem_free(n * sizeof(T));
+    const size_t size = n * sizeof(T);
+    util_guarded_mem_free(size);
     if (p != NULL) {
+      if (size >= UTIL_GUARDED_NUMA_THRESHOLD) {
+        util_guarded_numa_free(p, size);
+      }
+      else {
 #ifdef WITH_BLENDER_GUARDEDALLOC
-      MEM_freeN(p);
+        MEM_freeN(p);
 #else
-      free(p);
+        free(p);
 #endif
+      }
     }
   }
 
@@ -212,6 +212,13 @@ class Progress {
     return 0.0f;
   }
 
+  uint64_t get_rendered_pixel_samples()
+  {
+    thread_scoped_lock lock(progress_mutex);
+
+    return pixel_samples;
+  }
+
   void add_samples(uint64_t pixel_samples_, int tile_sample)
   {
     thread_scoped_lock lock(progress_mutex);
@@ -145,6 +145,19 @@ int system_cpu_num_active_group_processors()
   return numaAPI_GetNumCurrentNodesProcessors();
 }
 
+void *system_cpu_numa_alloc_local(size_t size)
+{
+  if (!system_cpu_ensure_initialized()) {
+    return NULL;
+  }
+  return numaAPI_AllocateLocal(size);
+}
+
+void system_cpu_numa_free(void *start, size_t size)
+{
+  numaAPI_Free(start, size);
+}
+
 #if !defined(_WIN32) || defined(FREE_WINDOWS)
 static void __cpuid(int data[4], int selector)
 {
@@ -212,6 +225,10 @@ struct CPUCapabilities {
   bool fma4;
   bool bmi1;
   bool bmi2;
+  bool avx512f;
+  bool avx512dq;
+  bool avx512bw;
+  bool avx512vl;
 };
 
 static CPUCapabilities &system_cpu_capabilities()
@@ -243,9 +260,9 @@ static CPUCapabilities &system_cpu_capabilities()
       bool os_uses_xsave_xrestore = (result[2] & ((int)1 << 27)) != 0;
       bool cpu_avx_support = (result[2] & ((int)1 << 28)) != 0;
 
+      uint32_t xcr_feature_mask = 0;
       if (os_uses_xsave_xrestore && cpu_avx_support) {
         // Check if the OS will save the YMM registers
-        uint32_t xcr_feature_mask;
 #  if defined(__GNUC__)
         int edx; /* not used */
         /* actual opcode for xgetbv */
@@ -253,8 +270,6 @@ static CPUCapabilities &system_cpu_capabilities()
 #  elif defined(_MSC_VER) && defined(_XCR_XFEATURE_ENABLED_MASK)
         xcr_feature_mask = (uint32_t)_xgetbv(
             _XCR_XFEATURE_ENABLED_MASK); /* min VS2010 SP1 compiler is required */
-#  else
-        xcr_feature_mask = 0;
 #  endif
         caps.avx = (xcr_feature_mask & 0x6) == 0x6;
       }
@@ -265,6 +280,13 @@ static CPUCapabilities &system_cpu_capabilities()
       caps.bmi1 = (result[1] & ((int)1 << 3)) != 0;
       caps.bmi2 = (result[1] & ((int)1 << 8)) != 0;
       caps.avx2 = (result[1] & ((int)1 << 5)) != 0;
+
+      /* AVX-512 additionally needs the OS to save the opmask and ZMM state. */
+      const bool os_uses_zmm = (xcr_feature_mask & 0xe6) == 0xe6;
+      caps.avx512f = os_uses_zmm && (result[1] & ((int)1 << 16)) != 0;
+      caps.avx512dq = os_uses_zmm && (result[1] & ((int)1 << 17)) != 0;
+      caps.avx512bw = os_uses_zmm && (result[1] & ((int)1 << 30)) != 0;
+      caps.avx512vl = os_uses_zmm && (result[1] & ((unsigned int)1 << 31)) != 0;
     }
 
     caps_init = true;
@@ -303,6 +325,17 @@ bool system_cpu_support_avx2()
   return caps.sse && caps.sse2 && caps.sse3 && caps.ssse3 && caps.sse41 && caps.avx && caps.f16c &&
          caps.avx2 && caps.fma3 && caps.bmi1 && caps.bmi2;
 }
+
+bool system_cpu_support_avx512()
+{
+  CPUCapabilities &caps = system_cpu_capabilities();
+  /* Require the full Skylake-X feature set. The VL extension lets the kernel
+   * stay on 256 bit registers, which avoids the worst of the AVX-512 clock
+   * throttling on CPUs where wide vector instructions run at a lower
+   * frequency license. */
+  return system_cpu_support_avx2() && caps.avx512f && caps.avx512dq && caps.avx512bw &&
+         caps.avx512vl;
+}
 #else
 
 bool system_cpu_support_sse2()
@@ -329,6 +362,11 @@ bool system_cpu_support_avx2()
   return false;
 }
 
+bool system_cpu_support_avx512()
+{
+  return false;
+}
+
 #endif
 
 bool system_call_self(const vector<string> &args)
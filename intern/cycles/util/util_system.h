@@ -52,6 +52,13 @@ bool system_cpu_run_thread_on_node(int node);
  * thread affinity). */
 int system_cpu_num_active_group_processors();
 
+/* Allocate memory on the NUMA node the calling thread is running on.
+ *
+ * Returns NULL when no NUMA support is available, the memory is to be freed
+ * with system_cpu_numa_free() with the same size. */
+void *system_cpu_numa_alloc_local(size_t size);
+void system_cpu_numa_free(void *start, size_t size);
+
 string system_cpu_brand_string();
 int system_cpu_bits();
 bool system_cpu_support_sse2();
@@ -59,6 +66,7 @@ bool system_cpu_support_sse3();
 bool system_cpu_support_sse41();
 bool system_cpu_support_avx();
 bool system_cpu_support_avx2();
+bool system_cpu_support_avx512();
 
 size_t system_physical_ram();
 
@@ -77,15 +77,22 @@ void TaskPool::wait_work(Summary *stats)
      * we can get into deadlock */
     TaskScheduler::Entry work_entry;
     bool found_entry = false;
-    list<TaskScheduler::Entry>::iterator it;
 
-    for (it = TaskScheduler::queue.begin(); it != TaskScheduler::queue.end(); it++) {
-      TaskScheduler::Entry &entry = *it;
+    foreach (list<TaskScheduler::Entry> &queue, TaskScheduler::queues) {
+      list<TaskScheduler::Entry>::iterator it;
 
-      if (entry.pool == this) {
-        work_entry = entry;
-        found_entry = true;
-        TaskScheduler::queue.erase(it);
+      for (it = queue.begin(); it != queue.end(); it++) {
+        TaskScheduler::Entry &entry = *it;
+
+        if (entry.pool == this) {
+          work_entry = entry;
+          found_entry = true;
+          queue.erase(it);
+          break;
+        }
+      }
+
+      if (found_entry) {
         break;
       }
     }
@@ -191,10 +198,12 @@ int TaskScheduler::users = 0;
 vector<thread *> TaskScheduler::threads;
 bool TaskScheduler::do_exit = false;
 
-list<TaskScheduler::Entry> TaskScheduler::queue;
+vector<list<TaskScheduler::Entry>> TaskScheduler::queues;
 thread_mutex TaskScheduler::queue_mutex;
 thread_condition_variable TaskScheduler::queue_cond;
 
+thread_local int TaskScheduler::local_queue = -1;
+
 namespace {
 
 /* Get number of processors on each of the available nodes. The result is sized
@@ -331,11 +340,24 @@ void TaskScheduler::init(int num_threads)
   /* Compute distribution on NUMA nodes. */
   vector<int> thread_nodes = distribute_threads_on_nodes(num_threads);
 
+  /* Create one task queue per NUMA node that has worker threads pinned to
+   * it, with a single shared queue when no affinity is used. */
+  int num_queues = 1;
+  foreach (int node, thread_nodes) {
+    if (node + 1 > num_queues) {
+      num_queues = node + 1;
+    }
+  }
+  queues.clear();
+  queues.resize(num_queues);
+
   /* Launch threads that will be waiting for work. */
   threads.resize(num_threads);
   for (int thread_index = 0; thread_index < num_threads; ++thread_index) {
-    threads[thread_index] = new thread(function_bind(&TaskScheduler::thread_run, thread_index + 1),
-                                       thread_nodes[thread_index]);
+    const int node = thread_nodes[thread_index];
+    const int queue_index = (node >= 0) ? node : 0;
+    threads[thread_index] = new thread(
+        function_bind(&TaskScheduler::thread_run, thread_index + 1, queue_index), node);
   }
 }
 
@@ -364,34 +386,52 @@ void TaskScheduler::free_memory()
 {
   assert(users == 0);
   threads.free_memory();
+  queues.free_memory();
 }
 
-bool TaskScheduler::thread_wait_pop(Entry &entry)
+bool TaskScheduler::thread_wait_pop(int queue_index, Entry &entry)
 {
   thread_scoped_lock queue_lock(queue_mutex);
 
-  while (queue.empty() && !do_exit)
-    queue_cond.wait(queue_lock);
+  while (true) {
+    /* Prefer tasks from the thread's own node. */
+    list<Entry> *queue = &queues[queue_index];
+
+    /* Steal from the fullest other node when the own node ran dry. */
+    if (queue->empty()) {
+      queue = NULL;
+      foreach (list<Entry> &other_queue, queues) {
+        if (!other_queue.empty() && (queue == NULL || other_queue.size() > queue->size())) {
+          queue = &other_queue;
+        }
+      }
+    }
 
-  if (queue.empty()) {
-    assert(do_exit);
-    return false;
-  }
+    if (queue != NULL) {
+      entry = queue->front();
+      queue->pop_front();
+      return true;
+    }
 
-  entry = queue.front();
-  queue.pop_front();
+    if (do_exit) {
+      return false;
+    }
 
-  return true;
+    queue_cond.wait(queue_lock);
+  }
 }
 
-void TaskScheduler::thread_run(int thread_id)
+void TaskScheduler::thread_run(int thread_id, int queue_index)
 {
   Entry entry;
 
   /* todo: test affinity/denormal mask */
 
+  /* Nested tasks pushed from this thread stay on its own node. */
+  local_queue = queue_index;
+
   /* keep popping off tasks */
-  while (thread_wait_pop(entry)) {
+  while (thread_wait_pop(queue_index, entry)) {
     /* run task */
     entry.task->run(thread_id);
 
@@ -409,10 +449,23 @@ void TaskScheduler::push(Entry &entry, bool front)
 
   /* add entry to queue */
   TaskScheduler::queue_mutex.lock();
+  if (queues.empty()) {
+    /* Pushed before the scheduler was initialized. */
+    queues.resize(1);
+  }
+
+  int queue_index = local_queue;
+  if (queue_index < 0 || queue_index >= (int)queues.size()) {
+    /* Threads outside of the scheduler distribute tasks round robin over
+     * the nodes. */
+    static int round_robin = 0;
+    queue_index = round_robin++ % queues.size();
+  }
+
   if (front)
-    TaskScheduler::queue.push_front(entry);
+    queues[queue_index].push_front(entry);
   else
-    TaskScheduler::queue.push_back(entry);
+    queues[queue_index].push_back(entry);
 
   TaskScheduler::queue_cond.notify_one();
   TaskScheduler::queue_mutex.unlock();
@@ -422,21 +475,24 @@ void TaskScheduler::clear(TaskPool *pool)
 {
   thread_scoped_lock queue_lock(TaskScheduler::queue_mutex);
 
-  /* erase all tasks from this pool from the queue */
-  list<Entry>::iterator it = queue.begin();
+  /* erase all tasks from this pool from the queues */
   int done = 0;
 
-  while (it != queue.end()) {
-    Entry &entry = *it;
+  foreach (list<Entry> &queue, queues) {
+    list<Entry>::iterator it = queue.begin();
+
+    while (it != queue.end()) {
+      Entry &entry = *it;
 
-    if (entry.pool == pool) {
-      done++;
-      delete entry.task;
+      if (entry.pool == pool) {
+        done++;
+        delete entry.task;
 
-      it = queue.erase(it);
+        it = queue.erase(it);
+      }
+      else
+        it++;
     }
-    else
-      it++;
   }
 
   queue_lock.unlock();
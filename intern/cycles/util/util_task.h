@@ -122,8 +122,9 @@ class TaskPool {
 
 /* Task Scheduler
  *
- * Central scheduler that holds running threads ready to execute tasks. A singe
- * queue holds the task from all pools. */
+ * Central scheduler that holds running threads ready to execute tasks. One
+ * queue per NUMA node holds the tasks from all pools, worker threads steal
+ * from other nodes when their own node has no work left. */
 
 class TaskScheduler {
  public:
@@ -156,12 +157,20 @@ class TaskScheduler {
   static vector<thread *> threads;
   static bool do_exit;
 
-  static list<Entry> queue;
+  /* Per NUMA node task queues, so worker threads prefer tasks pushed from
+   * their own node and only steal across sockets when their node runs dry.
+   * All queues share a single mutex and condition, individual queue
+   * operations are cheap. */
+  static vector<list<Entry>> queues;
   static thread_mutex queue_mutex;
   static thread_condition_variable queue_cond;
 
-  static void thread_run(int thread_id);
-  static bool thread_wait_pop(Entry &entry);
+  /* Queue the current thread pushes to. Worker threads push to their node
+   * local queue, threads outside of the scheduler distribute round robin. */
+  static thread_local int local_queue;
+
+  static void thread_run(int thread_id, int queue_index);
+  static bool thread_wait_pop(int queue_index, Entry &entry);
 
   static void push(Entry &entry, bool front);
   static void clear(TaskPool *pool);
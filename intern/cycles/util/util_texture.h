@@ -33,6 +33,14 @@ CCL_NAMESPACE_BEGIN
 /* Texture type. */
 #define kernel_tex_type(tex) (tex & IMAGE_DATA_TYPE_MASK)
 
+/* Sparse tiled 3D textures, volumes are split into tiles of this size and
+ * only occupied tiles are stored. */
+#define TEX_TILE_SHIFT 3
+#define TEX_TILE_SIZE (1 << TEX_TILE_SHIFT)
+#define TEX_TILE_MASK (TEX_TILE_SIZE - 1)
+#define TEX_TILE_VOXELS (TEX_TILE_SIZE * TEX_TILE_SIZE * TEX_TILE_SIZE)
+#define TEX_TILE_EMPTY (~0u)
+
 /* Interpolation types for textures
  * cuda also use texture space to store other objects */
 typedef enum InterpolationType {
@@ -93,6 +101,9 @@ typedef enum ExtensionType {
 typedef struct TextureInfo {
   /* Pointer, offset or texture depending on device. */
   uint64_t data;
+  /* OIIO texture handle when sampling through the texture cache.
+   * Only used by CPU devices, zero otherwise. */
+  uint64_t oiio_handle;
   /* Data Type */
   uint data_type;
   /* Buffer number for OpenCL. */
@@ -103,6 +114,10 @@ typedef struct TextureInfo {
   uint width, height, depth;
   /* Transform for 3D textures. */
   uint use_transform_3d;
+  /* Element offset of the voxel data for sparse tiled 3D textures, with the
+   * tile index table in front of it. Zero for dense textures. */
+  uint sparse_data_offset;
+  uint pad[3];
   Transform transform_3d;
 } TextureInfo;
 
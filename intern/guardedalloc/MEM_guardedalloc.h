@@ -171,6 +171,13 @@ extern bool (*MEM_consistency_check)(void);
 /** Attempt to enforce OSX (or other OS's) to have malloc and stack nonzero */
 extern void (*MEM_set_memory_debug)(void);
 
+/** Record size and name of every N-th allocation (zero disables),
+ * a cheap way to attribute memory use to call sites. */
+extern void (*MEM_set_memory_sampling)(unsigned int interval);
+
+/** Print the recorded allocation samples, aggregated by call site. */
+extern void (*MEM_printmemlist_samples)(void);
+
 /** Memory usage stats. */
 extern size_t (*MEM_get_memory_in_use)(void);
 /** Get amount of memory blocks in use. */
@@ -55,6 +55,8 @@ void (*MEM_printmemlist_stats)(void) = MEM_lockfree_printmemlist_stats;
 void (*MEM_set_error_callback)(void (*func)(const char *)) = MEM_lockfree_set_error_callback;
 bool (*MEM_consistency_check)(void) = MEM_lockfree_consistency_check;
 void (*MEM_set_memory_debug)(void) = MEM_lockfree_set_memory_debug;
+void (*MEM_set_memory_sampling)(unsigned int interval) = MEM_lockfree_set_memory_sampling;
+void (*MEM_printmemlist_samples)(void) = MEM_lockfree_printmemlist_samples;
 size_t (*MEM_get_memory_in_use)(void) = MEM_lockfree_get_memory_in_use;
 unsigned int (*MEM_get_memory_blocks_in_use)(void) = MEM_lockfree_get_memory_blocks_in_use;
 void (*MEM_reset_peak_memory)(void) = MEM_lockfree_reset_peak_memory;
@@ -114,6 +116,8 @@ void MEM_use_guarded_allocator(void)
   MEM_set_error_callback = MEM_guarded_set_error_callback;
   MEM_consistency_check = MEM_guarded_consistency_check;
   MEM_set_memory_debug = MEM_guarded_set_memory_debug;
+  MEM_set_memory_sampling = MEM_guarded_set_memory_sampling;
+  MEM_printmemlist_samples = MEM_guarded_printmemlist_samples;
   MEM_get_memory_in_use = MEM_guarded_get_memory_in_use;
   MEM_get_memory_blocks_in_use = MEM_guarded_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_guarded_reset_peak_memory;
@@ -239,6 +239,19 @@ void MEM_guarded_set_memory_debug(void)
   malloc_debug_memset = true;
 }
 
+/* The guarded allocator tracks every block, no need to sample. */
+void MEM_guarded_set_memory_sampling(unsigned int interval)
+{
+  (void)interval; /* Ignored. */
+}
+
+void MEM_guarded_printmemlist_samples(void)
+{
+  printf(
+      "\nmemory sampling is only used by the lockfree allocator, "
+      "the guarded allocator tracks all blocks (see MEM_printmemlist_stats)\n");
+}
+
 size_t MEM_guarded_allocN_len(const void *vmemh)
 {
   if (vmemh) {
@@ -140,6 +140,8 @@ void MEM_lockfree_printmemlist_stats(void);
 void MEM_lockfree_set_error_callback(void (*func)(const char *));
 bool MEM_lockfree_consistency_check(void);
 void MEM_lockfree_set_memory_debug(void);
+void MEM_lockfree_set_memory_sampling(unsigned int interval);
+void MEM_lockfree_printmemlist_samples(void);
 size_t MEM_lockfree_get_memory_in_use(void);
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void);
 void MEM_lockfree_reset_peak_memory(void);
@@ -183,6 +185,8 @@ void MEM_guarded_printmemlist_stats(void);
 void MEM_guarded_set_error_callback(void (*func)(const char *));
 bool MEM_guarded_consistency_check(void);
 void MEM_guarded_set_memory_debug(void);
+void MEM_guarded_set_memory_sampling(unsigned int interval);
+void MEM_guarded_printmemlist_samples(void);
 size_t MEM_guarded_get_memory_in_use(void);
 unsigned int MEM_guarded_get_memory_blocks_in_use(void);
 void MEM_guarded_reset_peak_memory(void);
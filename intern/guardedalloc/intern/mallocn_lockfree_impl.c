@@ -89,6 +89,122 @@ print_error(const char *str, ...)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Allocation Sampling
+ *
+ * When enabled, every N-th allocation records its size against the allocation
+ * name (a static string identifying the call site, see #MEM_mallocN). This
+ * attributes memory use to call sites at a fraction of the overhead of the
+ * guarded allocator, multiplying the sampled sizes by the interval gives an
+ * estimate of the real totals.
+ * \{ */
+
+/* Must be a power of two. */
+#define SAMPLE_SITES_NUM 1024
+
+typedef struct MemSampleSite {
+  /** Allocation name, a static string (never freed), NULL while unused. */
+  const char *name;
+  /** Sampled bytes and number of samples, multiply by the interval to estimate totals. */
+  size_t size;
+  unsigned int count;
+} MemSampleSite;
+
+static MemSampleSite sample_sites[SAMPLE_SITES_NUM];
+/** Samples recorded after the table filled up. */
+static size_t sample_overflow_size = 0;
+static unsigned int sample_overflow_count = 0;
+/** Sample every N-th allocation, zero when disabled. */
+static unsigned int sample_interval = 0;
+static unsigned int sample_counter = 0;
+
+static unsigned int mem_sample_hash(const char *str)
+{
+  /* djb2 */
+  unsigned int h = 5381;
+  for (const unsigned char *p = (const unsigned char *)str; *p; p++) {
+    h = (h * 33) ^ (unsigned int)*p;
+  }
+  return h;
+}
+
+static void mem_sample(size_t len, const char *str)
+{
+  if (atomic_add_and_fetch_u(&sample_counter, 1) % sample_interval != 0) {
+    return;
+  }
+
+  const unsigned int hash = mem_sample_hash(str);
+  for (unsigned int i = 0; i < SAMPLE_SITES_NUM; i++) {
+    MemSampleSite *site = &sample_sites[(hash + i) & (SAMPLE_SITES_NUM - 1)];
+    const char *name = site->name;
+    if (name == NULL) {
+      /* Claim the slot, when racing another thread use whichever name won. */
+      name = atomic_cas_ptr((void **)&site->name, NULL, (void *)str);
+      if (name == NULL) {
+        name = str;
+      }
+    }
+    /* Compare the contents too, equal literals aren't always the same pointer
+     * across compilation units. */
+    if (name == str || strcmp(name, str) == 0) {
+      atomic_add_and_fetch_z(&site->size, len);
+      atomic_add_and_fetch_u(&site->count, 1);
+      return;
+    }
+  }
+
+  atomic_add_and_fetch_z(&sample_overflow_size, len);
+  atomic_add_and_fetch_u(&sample_overflow_count, 1);
+}
+
+void MEM_lockfree_set_memory_sampling(unsigned int interval)
+{
+  sample_interval = interval;
+}
+
+static int mem_sample_site_cmp(const void *a, const void *b)
+{
+  const MemSampleSite *site_a = a;
+  const MemSampleSite *site_b = b;
+  if (site_a->size != site_b->size) {
+    return (site_a->size < site_b->size) ? 1 : -1;
+  }
+  return 0;
+}
+
+void MEM_lockfree_printmemlist_samples(void)
+{
+  if (sample_interval == 0) {
+    printf("\nno memory samples recorded (enable with --debug-memory-sample)\n");
+    return;
+  }
+
+  /* Copy so sorting doesn't disturb concurrent sampling. */
+  MemSampleSite sites[SAMPLE_SITES_NUM];
+  memcpy(sites, sample_sites, sizeof(sites));
+  qsort(sites, SAMPLE_SITES_NUM, sizeof(MemSampleSite), mem_sample_site_cmp);
+
+  printf("\nmemory samples (every %u-th allocation, sizes are estimates):\n", sample_interval);
+  for (unsigned int i = 0; i < SAMPLE_SITES_NUM; i++) {
+    const MemSampleSite *site = &sites[i];
+    if (site->name == NULL || site->count == 0) {
+      continue;
+    }
+    printf("%10.3f MB %8u samples: %s\n",
+           (double)(site->size * (size_t)sample_interval) / (double)(1024 * 1024),
+           site->count,
+           site->name);
+  }
+  if (sample_overflow_count != 0) {
+    printf("%10.3f MB %8u samples: (call site table full)\n",
+           (double)(sample_overflow_size * (size_t)sample_interval) / (double)(1024 * 1024),
+           sample_overflow_count);
+  }
+}
+
+/** \} */
+
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
@@ -237,6 +353,10 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
 
+    if (UNLIKELY(sample_interval != 0)) {
+      mem_sample(len, str);
+    }
+
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
@@ -282,6 +402,10 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
 
+    if (UNLIKELY(sample_interval != 0)) {
+      mem_sample(len, str);
+    }
+
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
@@ -353,6 +477,10 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
 
+    if (UNLIKELY(sample_interval != 0)) {
+      mem_sample(len, str);
+    }
+
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
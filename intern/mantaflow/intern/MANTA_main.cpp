@@ -40,6 +40,7 @@
 
 #include "BLI_fileops.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_fluid_types.h"
@@ -1223,6 +1224,44 @@ static void assertGridItems(vector<MANTA::GridItem> gList)
   UNUSED_VARS(resPrev);
 }
 
+struct MantaFilesReadData {
+  MANTA *manta;
+  vector<MANTA::FileItem> *files;
+  int *results;
+};
+
+void MANTA::updateGridsFromFilesTask(void *__restrict userdata,
+                                     const int file,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MantaFilesReadData *data = static_cast<MantaFilesReadData *>(userdata);
+  FileItem &item = (*data->files)[file];
+
+  if (BLI_exists(item.filename.c_str())) {
+    data->results[file] = data->manta->updateGridsFromFile(item.filename, item.grids);
+    assert(data->results[file]);
+  }
+}
+
+int MANTA::updateGridsFromFiles(vector<FileItem> &files)
+{
+  /* Every cache file decodes into its own set of grids, so files can be read and
+   * decompressed concurrently. */
+  vector<int> results(files.size(), 0);
+  MantaFilesReadData data = {this, &files, results.data()};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (files.size() > 1);
+  BLI_task_parallel_range(0, (int)files.size(), &data, updateGridsFromFilesTask, &settings);
+
+  int result = 0;
+  for (vector<int>::iterator it = results.begin(); it != results.end(); ++it) {
+    result += *it;
+  }
+  return result;
+}
+
 bool MANTA::updateSmokeStructures(FluidModifierData *mmd, int framenr)
 {
   if (MANTA::with_debug)
@@ -1328,13 +1367,7 @@ bool MANTA::updateSmokeStructures(FluidModifierData *mmd, int framenr)
   }
 
   /* Update files from data directory. */
-  for (vector<FileItem>::iterator it = filesData.begin(); it != filesData.end(); ++it) {
-    FileItem item = *it;
-    if (BLI_exists(item.filename.c_str())) {
-      result += updateGridsFromFile(item.filename, item.grids);
-      assert(result);
-    }
-  }
+  result += updateGridsFromFiles(filesData);
 
   return mSmokeFromFile = result;
 }
@@ -1445,22 +1478,10 @@ bool MANTA::updateNoiseStructures(FluidModifierData *mmd, int framenr)
   }
 
   /* Update files from data directory. */
-  for (vector<FileItem>::iterator it = filesData.begin(); it != filesData.end(); ++it) {
-    FileItem item = *it;
-    if (BLI_exists(item.filename.c_str())) {
-      result += updateGridsFromFile(item.filename, item.grids);
-      assert(result);
-    }
-  }
+  result += updateGridsFromFiles(filesData);
 
   /* Update files from noise directory. */
-  for (vector<FileItem>::iterator it = filesNoise.begin(); it != filesNoise.end(); ++it) {
-    FileItem item = *it;
-    if (BLI_exists(item.filename.c_str())) {
-      result += updateGridsFromFile(item.filename, item.grids);
-      assert(result);
-    }
-  }
+  result += updateGridsFromFiles(filesNoise);
 
   return mNoiseFromFile = result;
 }
@@ -909,6 +909,10 @@ struct MANTA {
   bool updateMeshFromFile(string filename);
   bool updateParticlesFromFile(string filename, bool isSecondarySys, bool isVelData);
   bool updateGridsFromFile(string filename, vector<GridItem> grids);
+  int updateGridsFromFiles(vector<FileItem> &files);
+  static void updateGridsFromFilesTask(void *__restrict userdata,
+                                       int file,
+                                       const struct TaskParallelTLS *__restrict tls);
   string getDirectory(struct FluidModifierData *mmd, string subdirectory);
   string getFile(struct FluidModifierData *mmd,
                  string subdirectory,
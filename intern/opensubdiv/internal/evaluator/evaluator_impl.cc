@@ -748,9 +748,16 @@ OpenSubdiv_EvaluatorImpl::~OpenSubdiv_EvaluatorImpl()
 }
 
 OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorInternal(
-    OpenSubdiv_TopologyRefiner *topology_refiner)
+    OpenSubdiv_TopologyRefiner *topology_refiner, eOpenSubdivEvaluator evaluator_type)
 {
   using blender::opensubdiv::vector;
+  // Only the CPU evaluator has an evaluation output implemented. GPU backed
+  // evaluators (GLSL compute and transform feedback) additionally require a
+  // context bound to the thread which performs the evaluation, which is not
+  // the case for the dependency graph evaluation threads where the evaluator
+  // is currently used from. Fall back to CPU evaluation until there is a
+  // consumer which evaluates with a context bound, keeping results on the GPU.
+  (void)evaluator_type;
   TopologyRefiner *refiner = topology_refiner->impl->topology_refiner;
   if (refiner == NULL) {
     // Happens on bad topology.
@@ -27,6 +27,7 @@
 #include <opensubdiv/far/patchTable.h>
 
 #include "internal/base/memory.h"
+#include "opensubdiv_capi_type.h"
 
 struct OpenSubdiv_PatchCoord;
 struct OpenSubdiv_TopologyRefiner;
@@ -151,7 +152,7 @@ struct OpenSubdiv_EvaluatorImpl {
 };
 
 OpenSubdiv_EvaluatorImpl *openSubdiv_createEvaluatorInternal(
-    struct OpenSubdiv_TopologyRefiner *topology_refiner);
+    struct OpenSubdiv_TopologyRefiner *topology_refiner, eOpenSubdivEvaluator evaluator_type);
 
 void openSubdiv_deleteEvaluatorInternal(OpenSubdiv_EvaluatorImpl *evaluator);
 
@@ -19,6 +19,8 @@
 #ifndef OPENSUBDIV_EVALUATOR_CAPI_H_
 #define OPENSUBDIV_EVALUATOR_CAPI_H_
 
+#include "opensubdiv_capi_type.h"  // for eOpenSubdivEvaluator
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -126,8 +128,13 @@ typedef struct OpenSubdiv_Evaluator {
   struct OpenSubdiv_EvaluatorImpl *impl;
 } OpenSubdiv_Evaluator;
 
+// Create an evaluator of the given type.
+//
+// When the requested evaluator is not supported in the current configuration
+// (missing hardware support, or no context for a GPU backed evaluator) the
+// evaluator falls back to CPU evaluation.
 OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
-    struct OpenSubdiv_TopologyRefiner *topology_refiner);
+    struct OpenSubdiv_TopologyRefiner *topology_refiner, eOpenSubdivEvaluator evaluator_type);
 
 void openSubdiv_deleteEvaluator(OpenSubdiv_Evaluator *evaluator);
 
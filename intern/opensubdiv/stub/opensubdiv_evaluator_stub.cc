@@ -21,7 +21,8 @@
 #include <cstddef>
 
 OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
-    struct OpenSubdiv_TopologyRefiner * /*topology_refiner*/)
+    struct OpenSubdiv_TopologyRefiner * /*topology_refiner*/,
+    eOpenSubdivEvaluator /*evaluator_type*/)
 {
   return NULL;
 }
@@ -204,6 +204,8 @@ void RB_body_set_scale(rbRigidBody *body, const float scale[3]);
 void RB_body_get_position(rbRigidBody *body, float v_out[3]);
 /* Get RigidBody's orientation as quaternion */
 void RB_body_get_orientation(rbRigidBody *body, float v_out[4]);
+/* Get RigidBody's position and orientation in one call */
+void RB_body_get_loc_rot(rbRigidBody *body, float loc[3], float rot[4]);
 
 /* ............ */
 
@@ -635,6 +635,15 @@ void RB_body_get_orientation(rbRigidBody *object, float v_out[4])
   copy_quat_btquat(v_out, body->getWorldTransform().getRotation());
 }
 
+void RB_body_get_loc_rot(rbRigidBody *object, float loc[3], float rot[4])
+{
+  btRigidBody *body = object->body;
+  const btTransform &trans = body->getWorldTransform();
+
+  copy_v3_btvec3(loc, trans.getOrigin());
+  copy_quat_btquat(rot, trans.getRotation());
+}
+
 /* ............ */
 /* Overrides for simulation */
 
@@ -1968,6 +1968,8 @@ class SEQUENCER_PT_view(SequencerButtonsPanel_Output, Panel):
 
         if ed:
             col.prop(ed, "use_prefetch")
+            if ed.use_prefetch:
+                col.prop(ed, "prefetch_frames")
 
 
 class SEQUENCER_PT_frame_overlay(SequencerButtonsPanel_Output, Panel):
@@ -68,6 +68,10 @@ void BLF_aspect(int fontid, float x, float y, float z);
 void BLF_position(int fontid, float x, float y, float z);
 void BLF_size(int fontid, int size, int dpi);
 
+/* Pre-rasterize the common glyphs for the current size & dpi,
+ * to avoid doing it during the first draw. */
+void BLF_cache_warm(int fontid);
+
 /* goal: small but useful color API */
 void BLF_color4ubv(int fontid, const unsigned char rgba[4]);
 void BLF_color3ubv(int fontid, const unsigned char rgb[3]);
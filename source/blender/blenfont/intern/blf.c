@@ -433,6 +433,15 @@ void BLF_size(int fontid, int size, int dpi)
   }
 }
 
+void BLF_cache_warm(int fontid)
+{
+  FontBLF *font = blf_get(fontid);
+
+  if (font) {
+    blf_font_cache_warm(font);
+  }
+}
+
 #if BLF_BLUR_ENABLE
 void BLF_blur(int fontid, int size)
 {
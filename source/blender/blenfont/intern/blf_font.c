@@ -194,10 +194,19 @@ static GPUTexture *blf_batch_cache_texture_load(void)
     int offset_x = bitmap_len_landed % tex_width;
     int offset_y = bitmap_len_landed / tex_width;
 
-    /* TODO(germano): Update more than one row in a single call. */
     while (remain) {
-      int remain_row = tex_width - offset_x;
-      int width = remain > remain_row ? remain_row : remain;
+      int width, rows;
+      if (offset_x == 0 && remain >= tex_width) {
+        /* Upload all complete rows in a single call. */
+        width = tex_width;
+        rows = remain / tex_width;
+      }
+      else {
+        /* Partial row at the start or end of the pending range. */
+        int remain_row = tex_width - offset_x;
+        width = remain > remain_row ? remain_row : remain;
+        rows = 1;
+      }
       GPU_texture_update_sub(gc->texture,
                              GPU_DATA_UNSIGNED_BYTE,
                              &gc->bitmap_result[bitmap_len_landed],
@@ -205,13 +214,13 @@ static GPUTexture *blf_batch_cache_texture_load(void)
                              offset_y,
                              0,
                              width,
-                             1,
+                             rows,
                              0);
 
-      bitmap_len_landed += width;
-      remain -= width;
+      bitmap_len_landed += width * rows;
+      remain -= width * rows;
       offset_x = 0;
-      offset_y += 1;
+      offset_y += rows;
     }
 
     gc->bitmap_len_landed = bitmap_len_landed;
@@ -413,6 +422,24 @@ static void blf_font_ensure_ascii_kerning(FontBLF *font,
   } \
   (void)0
 
+/* Pre-rasterize the glyphs and kerning table used by most interface text, so the
+ * work is done when this is called (e.g. on startup) instead of hitching the first
+ * draw. Copying the bitmaps into the cache texture still happens lazily since it
+ * needs a GPU context, but that is a memcpy and a single batched upload. */
+void blf_font_cache_warm(FontBLF *font)
+{
+  GlyphCacheBLF *gc = blf_glyph_cache_acquire(font);
+
+  blf_font_ensure_ascii_table(font, gc);
+
+  BLF_KERNING_VARS(font, has_kerning, kern_mode);
+  if (has_kerning) {
+    blf_font_ensure_ascii_kerning(font, gc, kern_mode);
+  }
+
+  blf_glyph_cache_release(font);
+}
+
 static void blf_font_draw_ex(FontBLF *font,
                              GlyphCacheBLF *gc,
                              const char *str,
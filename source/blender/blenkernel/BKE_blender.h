@@ -35,6 +35,12 @@ void BKE_blender_free(void);
 void BKE_blender_globals_init(void);
 void BKE_blender_globals_clear(void);
 
+/* Startup profiling (`--startup-profile`), records wall-clock time per startup stage. */
+void BKE_blender_startup_profile_enable(void);
+bool BKE_blender_startup_profile_is_enabled(void);
+void BKE_blender_startup_profile_stage(const char *stage);
+void BKE_blender_startup_profile_print(void);
+
 void BKE_blender_userdef_data_swap(struct UserDef *userdef_dst, struct UserDef *userdef_src);
 void BKE_blender_userdef_data_set(struct UserDef *userdef);
 void BKE_blender_userdef_data_set_and_free(struct UserDef *userdef);
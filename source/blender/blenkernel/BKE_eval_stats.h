@@ -0,0 +1,64 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BKE_EVAL_STATS_H__
+#define __BKE_EVAL_STATS_H__
+
+/** \file
+ * \ingroup bke
+ *
+ * Named timing statistics gathered by mesh evaluation stages.
+ *
+ * Stages report samples under a stable name, the accumulated values can be
+ * queried as JSON (from Python via `bpy.app.eval_stats`) or are printed per
+ * dependency graph evaluation when depsgraph timing debug is enabled.
+ *
+ * Collection is disabled by default, instrumented code is expected to check
+ * #BKE_eval_stats_is_enabled() before doing any timing work.
+ *
+ * All functions are safe to call from multiple threads.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Enable or disable sample collection. */
+void BKE_eval_stats_enable(bool enable);
+/* True when collection was enabled explicitly, or implied by a debug flag. */
+bool BKE_eval_stats_is_enabled(void);
+
+/* Accumulate a timing sample (in seconds) under the given name. */
+void BKE_eval_stats_sample_add(const char *name, double value);
+
+/* Clear all accumulated samples, keeping collection state. */
+void BKE_eval_stats_reset(void);
+
+/* Serialize all accumulated samples into a JSON object, mapping each name to
+ * its total time and number of samples. Returned string is to be freed with
+ * MEM_freeN(). */
+char *BKE_eval_stats_as_json(void);
+
+/* Free all memory owned by the statistics storage, on exit. */
+void BKE_eval_stats_free(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BKE_EVAL_STATS_H__ */
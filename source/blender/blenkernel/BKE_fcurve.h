@@ -188,6 +188,11 @@ void BKE_fcurves_copy(ListBase *dst, ListBase *src);
 
 void BKE_fcurve_foreach_id(struct FCurve *fcu, struct LibraryForeachIDData *data);
 
+/* Free the baked playback cache of the curve (see #FCurveSampleCache), so a
+ * next playback evaluation re-bakes it. To be called on any change which
+ * affects the evaluated values. */
+void BKE_fcurve_sample_cache_free(struct FCurve *fcu);
+
 /* find matching F-Curve in the given list of F-Curves */
 struct FCurve *BKE_fcurve_find(ListBase *list, const char rna_path[], const int array_index);
 
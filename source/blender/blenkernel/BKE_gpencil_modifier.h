@@ -79,6 +79,13 @@ typedef enum {
   eGpencilModifierTypeFlag_NoUserAdd = (1 << 5),
   /** Can't be applied. */
   eGpencilModifierTypeFlag_NoApply = (1 << 6),
+
+  /**
+   * The #deformStroke callback only reads shared data and writes to the
+   * stroke it is given, so the strokes of a frame can be deformed in
+   * parallel tasks.
+   */
+  eGpencilModifierTypeFlag_ThreadedDeform = (1 << 7),
 } GpencilModifierTypeFlag;
 
 /* IMPORTANT! Keep ObjectWalkFunc and IDWalkFunc signatures compatible. */
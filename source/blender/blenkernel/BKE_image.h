@@ -325,6 +325,8 @@ int BKE_image_get_tile_from_pos(struct Image *ima,
                                 float r_uv[2],
                                 float r_ofs[2]);
 
+void BKE_image_load_all_tiles(struct Image *ima);
+
 void BKE_image_get_size(struct Image *image, struct ImageUser *iuser, int *r_width, int *r_height);
 void BKE_image_get_size_fl(struct Image *image, struct ImageUser *iuser, float r_size[2]);
 void BKE_image_get_aspect(struct Image *image, float *r_aspx, float *r_aspy);
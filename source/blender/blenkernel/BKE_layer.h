@@ -101,6 +101,9 @@ void BKE_scene_collection_sync(const struct Scene *scene);
 void BKE_layer_collection_sync(const struct Scene *scene, struct ViewLayer *view_layer);
 void BKE_layer_collection_local_sync(struct ViewLayer *view_layer, struct View3D *v3d);
 
+void BKE_layer_collection_resync_forbid(void);
+void BKE_layer_collection_resync_allow(void);
+
 void BKE_main_collection_sync_remap(const struct Main *bmain);
 
 struct LayerCollection *BKE_layer_collection_first_from_scene_collection(
@@ -378,6 +378,10 @@ enum {
 void BKE_lnor_spacearr_init(MLoopNorSpaceArray *lnors_spacearr,
                             const int numLoops,
                             const char data_type);
+void BKE_lnor_spacearr_tls_init(MLoopNorSpaceArray *lnors_spacearr,
+                                MLoopNorSpaceArray *lnors_spacearr_tls);
+void BKE_lnor_spacearr_tls_join(MLoopNorSpaceArray *lnors_spacearr,
+                                MLoopNorSpaceArray *lnors_spacearr_tls);
 void BKE_lnor_spacearr_clear(MLoopNorSpaceArray *lnors_spacearr);
 void BKE_lnor_spacearr_free(MLoopNorSpaceArray *lnors_spacearr);
 MLoopNorSpace *BKE_lnor_space_create(MLoopNorSpaceArray *lnors_spacearr);
@@ -536,6 +540,13 @@ void BKE_mesh_recalc_looptri(const struct MLoop *mloop,
                              int totloop,
                              int totpoly,
                              struct MLoopTri *mlooptri);
+void BKE_mesh_recalc_looptri_range(const struct MLoop *mloop,
+                                   const struct MPoly *mpoly,
+                                   const struct MVert *mvert,
+                                   int totpoly,
+                                   int poly_start,
+                                   int poly_len,
+                                   struct MLoopTri *mlooptri);
 void BKE_mesh_convert_mfaces_to_mpolys(struct Mesh *mesh);
 void BKE_mesh_do_versions_convert_mfaces_to_mpolys(struct Mesh *mesh);
 void BKE_mesh_convert_mfaces_to_mpolys_ex(struct ID *id,
@@ -578,6 +589,10 @@ struct Mesh *BKE_mesh_merge_verts(struct Mesh *mesh,
                                   const int *vtargetmap,
                                   const int tot_vtargetmap,
                                   const int merge_mode);
+int BKE_mesh_merge_verts_map_create_by_distance(const struct MVert *mverts,
+                                                const int totvert,
+                                                const float merge_dist,
+                                                int **r_vtargetmap);
 
 /* flush flags */
 void BKE_mesh_flush_hidden_from_verts_ex(const struct MVert *mvert,
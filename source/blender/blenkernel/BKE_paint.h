@@ -312,6 +312,12 @@ typedef struct SculptSession {
   struct MeshElemMap *pmap;
   int *pmap_mem;
 
+  /* Precomputed vertex-to-vertex adjacency in the same compressed layout as
+   * the poly map above, used by the PBVH_FACES neighbor iterator. Built with
+   * the poly map and freed with it on topology changes. */
+  struct MeshElemMap *vnmap;
+  int *vnmap_mem;
+
   /* Mesh Face Sets */
   /* Total number of polys of the base mesh. */
   int totfaces;
@@ -332,6 +338,10 @@ typedef struct SculptSession {
 
   /* PBVH acceleration structure */
   struct PBVH *pbvh;
+  /* The PBVH was kept across a geometry update and must be rebuilt before use,
+   * see #BKE_sculpt_object_pbvh_ensure (the rebuild reuses the current nodes
+   * when the topology did not change). */
+  bool needs_pbvh_rebuild;
   bool show_mask;
   bool show_face_sets;
 
@@ -308,6 +308,7 @@ bool BKE_sequencer_proxy_rebuild_context(struct Main *bmain,
                                          struct Sequence *seq,
                                          struct GSet *file_list,
                                          ListBase *queue);
+bool BKE_sequencer_proxy_rebuild_parallel_supported(struct SeqIndexBuildContext *context);
 void BKE_sequencer_proxy_rebuild(struct SeqIndexBuildContext *context,
                                  short *stop,
                                  short *do_update,
@@ -362,6 +363,22 @@ void BKE_sequencer_cache_iterate(struct Scene *scene,
                                                     float cost));
 bool BKE_sequencer_cache_is_full(struct Scene *scene);
 
+/* Timeline strip thumbnails. Stored in a dedicated bucket with its own eviction,
+ * so they survive frame cache pressure and recycling. */
+struct ImBuf *BKE_sequencer_thumbnail_cache_get(struct Scene *scene,
+                                                struct Sequence *seq,
+                                                float cfra);
+void BKE_sequencer_thumbnail_cache_put(
+    struct Main *bmain, struct Scene *scene, struct Sequence *seq, float cfra, struct ImBuf *ibuf);
+void BKE_sequencer_thumbnail_cache_cleanup(struct Scene *scene, struct Sequence *seq);
+void BKE_sequencer_thumbnails_render(struct Main *bmain,
+                                     struct Scene *scene,
+                                     struct Sequence *seq,
+                                     int frame_start,
+                                     int frame_end,
+                                     int frame_step,
+                                     const short *stop);
+
 /* **********************************************************************
  * seqprefetch.c
  *
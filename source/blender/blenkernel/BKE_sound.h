@@ -38,9 +38,20 @@ struct Main;
 struct Sequence;
 struct bSound;
 
+#define SOUND_WAVEFORM_MAX_LEVELS 16
+
 typedef struct SoundWaveform {
   int length;
   float *data;
+
+  /**
+   * Min/max/rms triplets of #data successively halved per level, so zoomed out drawing reads
+   * a resolution matching the pixel density instead of every sample. levels[0] has length / 2
+   * entries. Unused levels are NULL.
+   */
+  int num_levels;
+  int levels_length[SOUND_WAVEFORM_MAX_LEVELS];
+  float *levels[SOUND_WAVEFORM_MAX_LEVELS];
 } SoundWaveform;
 
 void BKE_sound_init_once(void);
@@ -874,6 +874,17 @@ void BKE_mesh_wrapper_deferred_finalize(Mesh *me_eval,
   BLI_assert(me_eval->runtime.wrapper_type_finalize == 0);
 }
 
+/**
+ * Evaluate the modifier stack on \a ob, always from the first modifier.
+ *
+ * \note Caching per-modifier results to resume evaluation from the first changed modifier has
+ * been considered, but can not be done correctly with the current design: a modifier's output
+ * depends on data we have no way to version (armature poses, target object geometry, textures,
+ * the frame for physics), while the dependency graph only tags the object's geometry as a whole.
+ * Any such cache would have to guess at invalidation, and a stale guess here means silently
+ * wrong evaluation results. Finer grained re-evaluation needs per-dependency versioning in the
+ * dependency graph first.
+ */
 static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
                                 Scene *scene,
                                 Object *ob,
@@ -1579,7 +1590,9 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
       /* apply vertex coordinates or build a DerivedMesh as necessary */
       if (mesh_final) {
         if (deformed_verts) {
-          Mesh *mesh_tmp = BKE_mesh_copy_for_eval(mesh_final, false);
+          /* Reference copy: layer data is ref-counted now,
+           * so freeing the source right after is fine. */
+          Mesh *mesh_tmp = BKE_mesh_copy_for_eval(mesh_final, true);
           if (mesh_final != mesh_cage) {
             BKE_id_free(NULL, mesh_final);
           }
@@ -1588,7 +1601,7 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
         }
         else if (mesh_final == mesh_cage) {
           /* 'me' may be changed by this modifier, so we need to copy it. */
-          mesh_final = BKE_mesh_copy_for_eval(mesh_final, false);
+          mesh_final = BKE_mesh_copy_for_eval(mesh_final, true);
         }
       }
       else {
@@ -1660,7 +1673,7 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
 
     if (r_cage && i == cageIndex) {
       if (mesh_final && deformed_verts) {
-        mesh_cage = BKE_mesh_copy_for_eval(mesh_final, false);
+        mesh_cage = BKE_mesh_copy_for_eval(mesh_final, true);
         BKE_mesh_vert_coords_apply(mesh_cage, deformed_verts);
       }
       else if (mesh_final) {
@@ -1690,7 +1703,7 @@ static void editbmesh_calc_modifiers(struct Depsgraph *depsgraph,
    * then we need to build one. */
   if (mesh_final) {
     if (deformed_verts) {
-      Mesh *mesh_tmp = BKE_mesh_copy_for_eval(mesh_final, false);
+      Mesh *mesh_tmp = BKE_mesh_copy_for_eval(mesh_final, true);
       if (mesh_final != mesh_cage) {
         BKE_id_free(NULL, mesh_final);
       }
@@ -1809,6 +1822,20 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
   const bool is_mesh_eval_owned = (mesh_eval != mesh->runtime.mesh_eval);
   BKE_object_eval_assign_data(ob, &mesh_eval->id, is_mesh_eval_owned);
 
+  /* Reuse the BVH trees stashed from the previous evaluated mesh
+   * (see #BKE_object_free_derived_caches), refitting them onto the new geometry
+   * is much cheaper than rebuilding them when the topology did not change. */
+  if (ob->runtime.bvh_cache_stash != NULL) {
+    if (mesh_eval->runtime.bvh_cache == NULL) {
+      mesh_eval->runtime.bvh_cache = ob->runtime.bvh_cache_stash;
+      bvhcache_refit_mesh(mesh_eval->runtime.bvh_cache, mesh_eval);
+    }
+    else {
+      bvhcache_free(ob->runtime.bvh_cache_stash);
+    }
+    ob->runtime.bvh_cache_stash = NULL;
+  }
+
   ob->runtime.mesh_deform_eval = mesh_deform_eval;
   ob->runtime.last_data_mask = *dataMask;
   ob->runtime.last_need_mapping = need_mapping;
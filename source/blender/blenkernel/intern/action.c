@@ -42,6 +42,8 @@
 
 #include "BLT_translation.h"
 
+#include "atomic_ops.h"
+
 #include "BKE_action.h"
 #include "BKE_anim_visualization.h"
 #include "BKE_animsys.h"
@@ -104,6 +106,12 @@ static void action_copy_data(Main *UNUSED(bmain),
   bActionGroup *group_dst, *group_src;
   FCurve *fcurve_dst, *fcurve_src;
 
+  /* Every copy gets a new version, so NLA strip caches built from the previous
+   * contents of an in-place updated copy (e.g. copy-on-write) are detected as
+   * stale. The counter is global since copies can run in multiple threads. */
+  static uint32_t eval_version_counter = 0;
+  action_dst->eval_version = atomic_add_and_fetch_uint32(&eval_version_counter, 1);
+
   /* Duplicate the lists of groups and markers. */
   BLI_duplicatelist(&action_dst->groups, &action_src->groups);
   BLI_duplicatelist(&action_dst->markers, &action_src->markers);
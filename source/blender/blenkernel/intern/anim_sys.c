@@ -536,32 +536,58 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
  * This performs a set of standard checks. If extra checks are required,
  * separate code should be used.
  */
+static void animsys_evaluate_fcurve(PointerRNA *ptr,
+                                    FCurve *fcu,
+                                    float ctime,
+                                    bool flush_to_original)
+{
+  /* Check if this F-Curve doesn't belong to a muted group. */
+  if ((fcu->grp != NULL) && (fcu->grp->flag & AGRP_MUTED)) {
+    return;
+  }
+  /* Check if this curve should be skipped. */
+  if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED))) {
+    return;
+  }
+  /* Skip empty curves, as if muted. */
+  if (BKE_fcurve_is_empty(fcu)) {
+    return;
+  }
+  PathResolvedRNA anim_rna;
+  if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    const float curval = calculate_fcurve(&anim_rna, fcu, ctime);
+    BKE_animsys_write_rna_setting(&anim_rna, curval);
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+    }
+  }
+}
+
+/* Threshold over which the channel list is snapshot into a contiguous array,
+ * see animsys_evaluate_fcurves(). */
+#define FCURVES_AS_ARRAY_LEN_MIN 256
+
 static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      ListBase *list,
                                      float ctime,
                                      bool flush_to_original)
 {
-  /* Calculate then execute each curve. */
-  LISTBASE_FOREACH (FCurve *, fcu, list) {
-    /* Check if this F-Curve doesn't belong to a muted group. */
-    if ((fcu->grp != NULL) && (fcu->grp->flag & AGRP_MUTED)) {
-      continue;
+  /* For heavy rigs the pointer-chasing of the linked list dominates cache behavior
+   * (the RNA resolution per curve evicts the next link), iterating a contiguous
+   * snapshot of the channel pointers measurably helps there.
+   * For typical short lists the snapshot isn't worth the allocation. */
+  if (BLI_listbase_count_at_most(list, FCURVES_AS_ARRAY_LEN_MIN) == FCURVES_AS_ARRAY_LEN_MIN) {
+    int fcurves_len;
+    FCurve **fcurves = (FCurve **)BLI_listbase_as_array(list, &fcurves_len);
+    for (int i = 0; i < fcurves_len; i++) {
+      animsys_evaluate_fcurve(ptr, fcurves[i], ctime, flush_to_original);
     }
-    /* Check if this curve should be skipped. */
-    if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED))) {
-      continue;
-    }
-    /* Skip empty curves, as if muted. */
-    if (BKE_fcurve_is_empty(fcu)) {
-      continue;
-    }
-    PathResolvedRNA anim_rna;
-    if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
-      const float curval = calculate_fcurve(&anim_rna, fcu, ctime);
-      BKE_animsys_write_rna_setting(&anim_rna, curval);
-      if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
-      }
+    MEM_freeN(fcurves);
+  }
+  else {
+    /* Calculate then execute each curve. */
+    LISTBASE_FOREACH (FCurve *, fcu, list) {
+      animsys_evaluate_fcurve(ptr, fcu, ctime, flush_to_original);
     }
   }
 }
@@ -1713,6 +1739,18 @@ static void nlaeval_fmodifiers_split_stacks(ListBase *list1, ListBase *list2)
 
 /* ---------------------- */
 
+/* Check whether an F-Curve of a strip's action is excluded from evaluation. */
+static bool nlastrip_fcurve_is_skipped(FCurve *fcu)
+{
+  if (fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) {
+    return true;
+  }
+  if ((fcu->grp) && (fcu->grp->flag & AGRP_MUTED)) {
+    return true;
+  }
+  return BKE_fcurve_is_empty(fcu);
+}
+
 /* evaluate action-clip strip */
 static void nlastrip_evaluate_actionclip(PointerRNA *ptr,
                                          NlaEvalData *channels,
@@ -1754,33 +1792,71 @@ static void nlastrip_evaluate_actionclip(PointerRNA *ptr,
       .influence = strip->influence,
   };
 
+  /* The raw values of an action-clip strip depend only on the action contents
+   * and the strip-local time, not on influence or blend mode, so they can be
+   * reused between frames while the strip holds still (extend/hold regions,
+   * stepped animation, static layers under an animated top strip). Caching is
+   * restricted to evaluated copies: the action of such a strip gets a new
+   * #bAction.eval_version whenever its contents are updated, which makes
+   * staleness detection reliable. */
+  int num_values = 0;
+  for (fcu = strip->act->curves.first; fcu; fcu = fcu->next) {
+    if (!nlastrip_fcurve_is_skipped(fcu)) {
+      num_values++;
+    }
+  }
+
+  NlaStripCache *cache = strip->cache;
+  if (cache != NULL && !(cache->act_version == strip->act->eval_version &&
+                         cache->strip_time == strip->strip_time &&
+                         cache->num_values == num_values)) {
+    MEM_SAFE_FREE(strip->cache);
+    cache = NULL;
+  }
+  const bool cache_valid = (cache != NULL);
+
+  if (cache == NULL && strip->orig_strip != NULL) {
+    /* Values are stored in the same allocation, right after the header. */
+    cache = MEM_mallocN(sizeof(NlaStripCache) + sizeof(float) * num_values, "NlaStripCache");
+    cache->values = (float *)(cache + 1);
+    cache->strip_time = strip->strip_time;
+    cache->act_version = strip->act->eval_version;
+    cache->num_values = num_values;
+    strip->cache = cache;
+  }
+
   /* Evaluate all the F-Curves in the action,
    * saving the relevant pointers to data that will need to be used. */
+  int value_index = 0;
   for (fcu = strip->act->curves.first; fcu; fcu = fcu->next) {
     float value = 0.0f;
 
     /* check if this curve should be skipped */
-    if (fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) {
+    if (nlastrip_fcurve_is_skipped(fcu)) {
       continue;
     }
-    if ((fcu->grp) && (fcu->grp->flag & AGRP_MUTED)) {
-      continue;
-    }
-    if (BKE_fcurve_is_empty(fcu)) {
-      continue;
+
+    if (cache_valid) {
+      value = cache->values[value_index];
     }
+    else {
+      /* evaluate the F-Curve's value for the time given in the strip
+       * NOTE: we use the modified time here, since strip's F-Curve Modifiers
+       * are applied on top of this.
+       */
+      value = evaluate_fcurve(fcu, evaltime);
 
-    /* evaluate the F-Curve's value for the time given in the strip
-     * NOTE: we use the modified time here, since strip's F-Curve Modifiers
-     * are applied on top of this.
-     */
-    value = evaluate_fcurve(fcu, evaltime);
+      /* apply strip's F-Curve Modifiers on this value
+       * NOTE: we apply the strip's original evaluation time not the modified one
+       * (as per standard F-Curve eval)
+       */
+      evaluate_value_fmodifiers(&storage, &tmp_modifiers, fcu, &value, strip->strip_time);
 
-    /* apply strip's F-Curve Modifiers on this value
-     * NOTE: we apply the strip's original evaluation time not the modified one
-     * (as per standard F-Curve eval)
-     */
-    evaluate_value_fmodifiers(&storage, &tmp_modifiers, fcu, &value, strip->strip_time);
+      if (cache != NULL) {
+        cache->values[value_index] = value;
+      }
+    }
+    value_index++;
 
     /* Get an NLA evaluation channel to work with,
      * and accumulate the evaluated value with the value(s)
@@ -26,6 +26,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
 
@@ -616,6 +617,21 @@ BLI_INLINE bPoseChannel *pose_pchan_get_indexed(Object *ob, int pchan_index)
   return pose->chan_array[pchan_index];
 }
 
+static void pose_eval_init_channel_cb(void *__restrict userdata,
+                                      const int pchan_index,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  bPose *pose = userdata;
+  bPoseChannel *pchan = pose->chan_array[pchan_index];
+
+  pchan->flag &= ~(POSE_DONE | POSE_CHAIN | POSE_IKTREE | POSE_IKSPLINE);
+
+  /* Free B-Bone shape data cache if it's not a B-Bone. */
+  if (pchan->bone == NULL || pchan->bone->segments <= 1) {
+    BKE_pose_channel_free_bbone_cache(&pchan->runtime);
+  }
+}
+
 void BKE_pose_eval_init(struct Depsgraph *depsgraph, Scene *UNUSED(scene), Object *object)
 {
   bPose *pose = object->pose;
@@ -632,18 +648,18 @@ void BKE_pose_eval_init(struct Depsgraph *depsgraph, Scene *UNUSED(scene), Objec
   /* imat is needed for solvers. */
   invert_m4_m4(object->imat, object->obmat);
 
-  /* clear flags */
-  for (bPoseChannel *pchan = pose->chanbase.first; pchan != NULL; pchan = pchan->next) {
-    pchan->flag &= ~(POSE_DONE | POSE_CHAIN | POSE_IKTREE | POSE_IKSPLINE);
-
-    /* Free B-Bone shape data cache if it's not a B-Bone. */
-    if (pchan->bone == NULL || pchan->bone->segments <= 1) {
-      BKE_pose_channel_free_bbone_cache(&pchan->runtime);
-    }
-  }
-
   BLI_assert(pose->chan_array != NULL || BLI_listbase_is_empty(&pose->chanbase));
 
+  /* Clear flags. The bones themselves are separate operation nodes evaluated
+   * concurrently by the dependency graph, which makes this entry operation the
+   * remaining whole-pose serial loop, so spread it over threads for heavy
+   * rigs. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(
+      0, BLI_listbase_count(&pose->chanbase), pose, pose_eval_init_channel_cb, &settings);
+
   if (object->proxy != NULL) {
     object->proxy->proxy_from = object;
   }
@@ -33,6 +33,8 @@
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
 
+#include "PIL_time.h"
+
 #include "IMB_imbuf.h"
 #include "IMB_moviecache.h"
 
@@ -44,6 +46,7 @@
 #include "BKE_brush.h"
 #include "BKE_cachefile.h"
 #include "BKE_callbacks.h"
+#include "BKE_eval_stats.h"
 #include "BKE_global.h"
 #include "BKE_idprop.h"
 #include "BKE_image.h"
@@ -97,6 +100,8 @@ void BKE_blender_free(void)
 
   BKE_callback_global_finalize();
 
+  BKE_eval_stats_free();
+
   IMB_moviecache_destruct();
 
   free_nodesystem();
@@ -165,6 +170,73 @@ void BKE_blender_globals_clear(void)
 
 /***/
 
+/* -------------------------------------------------------------------- */
+/** \name Startup Profiling
+ *
+ * Wall-clock timings of the startup stages (DNA init, RNA init, startup.blend read, Python
+ * init, ...), enabled with `--startup-profile`. Stages are marked from `creator.c` and
+ * `wm_init_exit.c`; the result is printed as a single JSON object on stdout so render farm
+ * tooling can parse it from the log.
+ * \{ */
+
+#define STARTUP_PROFILE_STAGES_MAX 32
+
+static struct {
+  bool enabled;
+  double time_prev;
+  int stages_num;
+  const char *stage_names[STARTUP_PROFILE_STAGES_MAX];
+  double stage_times[STARTUP_PROFILE_STAGES_MAX];
+} g_startup_profile = {false};
+
+void BKE_blender_startup_profile_enable(void)
+{
+  /* May be called a second time from argument parsing, keep the first time-stamp. */
+  if (g_startup_profile.enabled) {
+    return;
+  }
+  g_startup_profile.enabled = true;
+  g_startup_profile.time_prev = PIL_check_seconds_timer();
+}
+
+bool BKE_blender_startup_profile_is_enabled(void)
+{
+  return g_startup_profile.enabled;
+}
+
+/**
+ * Record the time spent since the previous mark (or since enabling) as stage \a stage.
+ * \a stage must point to a static string.
+ */
+void BKE_blender_startup_profile_stage(const char *stage)
+{
+  if (!g_startup_profile.enabled || g_startup_profile.stages_num == STARTUP_PROFILE_STAGES_MAX) {
+    return;
+  }
+  const double time_now = PIL_check_seconds_timer();
+  g_startup_profile.stage_names[g_startup_profile.stages_num] = stage;
+  g_startup_profile.stage_times[g_startup_profile.stages_num] = time_now -
+                                                                g_startup_profile.time_prev;
+  g_startup_profile.stages_num++;
+  g_startup_profile.time_prev = time_now;
+}
+
+void BKE_blender_startup_profile_print(void)
+{
+  if (!g_startup_profile.enabled) {
+    return;
+  }
+  double time_total = 0.0;
+  printf("startup-profile: {");
+  for (int i = 0; i < g_startup_profile.stages_num; i++) {
+    printf("\"%s\": %.4f, ", g_startup_profile.stage_names[i], g_startup_profile.stage_times[i]);
+    time_total += g_startup_profile.stage_times[i];
+  }
+  printf("\"total\": %.4f}\n", time_total);
+}
+
+/** \} */
+
 static void keymap_item_free(wmKeyMapItem *kmi)
 {
   if (kmi->properties) {
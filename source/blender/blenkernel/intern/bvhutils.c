@@ -160,6 +160,86 @@ void bvhcache_free(BVHCache *bvh_cache)
   MEM_freeN(bvh_cache);
 }
 
+/**
+ * Refit the cached trees onto the geometry of \a mesh, so a cache taken from a previous
+ * evaluation can be reused when only vertex positions changed.
+ *
+ * Only the tree types whose leafs map trivially onto mesh elements are refitted
+ * (verts, edges, looptris), and only when their leaf count still matches the mesh.
+ * Every other cached tree is freed, as are negative (NULL tree) entries.
+ * Since refitting recomputes all leaf bounds from \a mesh, the resulting trees are
+ * always valid, at worst with a suboptimal hierarchy.
+ */
+void bvhcache_refit_mesh(BVHCache *bvh_cache, struct Mesh *mesh)
+{
+  for (BVHCacheType index = 0; index < BVHTREE_MAX_ITEM; index++) {
+    BVHCacheItem *item = &bvh_cache->items[index];
+    if (!item->is_filled) {
+      continue;
+    }
+    BVHTree *tree = item->tree;
+    bool keep = false;
+    if (tree != NULL) {
+      switch (index) {
+        case BVHTREE_FROM_VERTS: {
+          if (BLI_bvhtree_get_len(tree) == mesh->totvert) {
+            const MVert *vert = mesh->mvert;
+            for (int i = 0; i < mesh->totvert; i++) {
+              BLI_bvhtree_update_node(tree, i, vert[i].co, NULL, 1);
+            }
+            keep = true;
+          }
+          break;
+        }
+        case BVHTREE_FROM_EDGES: {
+          if (BLI_bvhtree_get_len(tree) == mesh->totedge) {
+            const MVert *vert = mesh->mvert;
+            const MEdge *edge = mesh->medge;
+            for (int i = 0; i < mesh->totedge; i++) {
+              float co[2][3];
+              copy_v3_v3(co[0], vert[edge[i].v1].co);
+              copy_v3_v3(co[1], vert[edge[i].v2].co);
+              BLI_bvhtree_update_node(tree, i, co[0], NULL, 2);
+            }
+            keep = true;
+          }
+          break;
+        }
+        case BVHTREE_FROM_LOOPTRI: {
+          const int looptri_len = BKE_mesh_runtime_looptri_len(mesh);
+          if (BLI_bvhtree_get_len(tree) == looptri_len) {
+            const MVert *vert = mesh->mvert;
+            const MLoop *mloop = mesh->mloop;
+            const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(mesh);
+            for (int i = 0; i < looptri_len; i++) {
+              float co[3][3];
+              copy_v3_v3(co[0], vert[mloop[looptri[i].tri[0]].v].co);
+              copy_v3_v3(co[1], vert[mloop[looptri[i].tri[1]].v].co);
+              copy_v3_v3(co[2], vert[mloop[looptri[i].tri[2]].v].co);
+              BLI_bvhtree_update_node(tree, i, co[0], NULL, 3);
+            }
+            keep = true;
+          }
+          break;
+        }
+        default: {
+          /* Trees over element subsets or edit-mesh data cannot be matched up
+           * with the new mesh, drop them. */
+          break;
+        }
+      }
+    }
+    if (keep) {
+      BLI_bvhtree_update_tree(tree);
+    }
+    else {
+      BLI_bvhtree_free(tree);
+      item->tree = NULL;
+      item->is_filled = false;
+    }
+  }
+}
+
 /** \} */
 /* -------------------------------------------------------------------- */
 /** \name Local Callbacks
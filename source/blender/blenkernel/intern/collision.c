@@ -666,33 +666,47 @@ DO_INLINE void collision_interpolateOnTriangle(float to[3],
   VECADDMUL(to, v3, w3);
 }
 
-static int cloth_collision_response_static(ClothModifierData *clmd,
-                                           CollisionModifierData *collmd,
-                                           Object *collob,
-                                           CollPair *collpair,
-                                           uint collision_count,
-                                           const float dt)
+/* Impulse contribution of a single collision pair. Impulses are computed in parallel
+ * (they only read vertex state), then merged into the per-vertex accumulators
+ * serially in pair order, so results do not depend on thread scheduling. */
+typedef struct CollPairImpulse {
+  float ia[3][3];
+  float ib[3][3];
+  bool active;
+} CollPairImpulse;
+
+typedef struct CollResponseData {
+  ClothModifierData *clmd;
+  CollisionModifierData *collmd;
+  Object *collob;
+  CollPair *collisions;
+  CollPairImpulse *impulses;
+} CollResponseData;
+
+static void cloth_collision_impulse_calc(void *__restrict userdata,
+                                         const int index,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  int result = 0;
-  Cloth *cloth1;
+  CollResponseData *data = (CollResponseData *)userdata;
+  ClothModifierData *clmd = data->clmd;
+  CollisionModifierData *collmd = data->collmd;
+  Object *collob = data->collob;
+  CollPair *collpair = &data->collisions[index];
+  CollPairImpulse *imp = &data->impulses[index];
+  Cloth *cloth1 = clmd->clothObject;
   float w1, w2, w3, u1, u2, u3;
   float v1[3], v2[3], relativeVelocity[3];
   float magrelVel;
   float epsilon2 = BLI_bvhtree_get_epsilon(collmd->bvhtree);
   const bool is_hair = (clmd->hairdata != NULL);
+  int result = 0;
 
-  cloth1 = clmd->clothObject;
-
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float i1[3], i2[3], i3[3];
-
-    zero_v3(i1);
-    zero_v3(i2);
-    zero_v3(i3);
+  {
+    float *i1 = imp->ia[0], *i2 = imp->ia[1], *i3 = imp->ia[2];
 
     /* Only handle static collisions here. */
     if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
+      return;
     }
 
     /* Compute barycentric coordinates and relative "velocity" for both collision points. */
@@ -781,14 +795,10 @@ static int cloth_collision_response_static(ClothModifierData *clmd,
       impulse = magrelVel / 1.5f;
 
       VECADDMUL(i1, collpair->normal, w1 * impulse);
-      cloth1->verts[collpair->ap1].impulse_count++;
-
       VECADDMUL(i2, collpair->normal, w2 * impulse);
-      cloth1->verts[collpair->ap2].impulse_count++;
 
       if (!is_hair) {
         VECADDMUL(i3, collpair->normal, w3 * impulse);
-        cloth1->verts[collpair->ap3].impulse_count++;
       }
 
       time_multiplier = 1.0f / (clmd->sim_parms->dt * clmd->sim_parms->timescale);
@@ -835,46 +845,90 @@ static int cloth_collision_response_static(ClothModifierData *clmd,
           VECADDMUL(i3, collpair->normal, w3 * impulse);
         }
 
-        cloth1->verts[collpair->ap1].impulse_count++;
-        cloth1->verts[collpair->ap2].impulse_count++;
-
-        if (!is_hair) {
-          cloth1->verts[collpair->ap3].impulse_count++;
-        }
-
         result = 1;
       }
     }
 
-    if (result) {
-      float clamp = clmd->coll_parms->clamp * dt;
+    imp->active = (result != 0);
+  }
+}
 
-      if ((clamp > 0.0f) &&
-          ((len_v3(i1) > clamp) || (len_v3(i2) > clamp) || (len_v3(i3) > clamp))) {
-        return 0;
-      }
+static int cloth_collision_response_static(ClothModifierData *clmd,
+                                           CollisionModifierData *collmd,
+                                           Object *collob,
+                                           CollPair *collpair,
+                                           uint collision_count,
+                                           const float dt)
+{
+  Cloth *cloth1 = clmd->clothObject;
+  const bool is_hair = (clmd->hairdata != NULL);
+  const float clamp = clmd->coll_parms->clamp * dt;
+  int result = 0;
 
-      for (int j = 0; j < 3; j++) {
-        if (cloth1->verts[collpair->ap1].impulse_count > 0 &&
-            fabsf(cloth1->verts[collpair->ap1].impulse[j]) < fabsf(i1[j])) {
-          cloth1->verts[collpair->ap1].impulse[j] = i1[j];
-        }
+  if (collision_count == 0) {
+    return 0;
+  }
 
-        if (cloth1->verts[collpair->ap2].impulse_count > 0 &&
-            fabsf(cloth1->verts[collpair->ap2].impulse[j]) < fabsf(i2[j])) {
-          cloth1->verts[collpair->ap2].impulse[j] = i2[j];
-        }
+  CollPairImpulse *impulses = MEM_callocN(sizeof(*impulses) * collision_count, __func__);
 
-        if (!is_hair) {
-          if (cloth1->verts[collpair->ap3].impulse_count > 0 &&
-              fabsf(cloth1->verts[collpair->ap3].impulse[j]) < fabsf(i3[j])) {
-            cloth1->verts[collpair->ap3].impulse[j] = i3[j];
-          }
+  CollResponseData data = {
+      .clmd = clmd,
+      .collmd = collmd,
+      .collob = collob,
+      .collisions = collpair,
+      .impulses = impulses,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (collision_count > 256);
+  BLI_task_parallel_range(0, collision_count, &data, cloth_collision_impulse_calc, &settings);
+
+  for (int i = 0; i < collision_count; i++) {
+    CollPairImpulse *imp = &impulses[i];
+    const CollPair *pair = &collpair[i];
+
+    if (!imp->active) {
+      continue;
+    }
+
+    cloth1->verts[pair->ap1].impulse_count++;
+    cloth1->verts[pair->ap2].impulse_count++;
+
+    if (!is_hair) {
+      cloth1->verts[pair->ap3].impulse_count++;
+    }
+
+    if ((clamp > 0.0f) && ((len_v3(imp->ia[0]) > clamp) || (len_v3(imp->ia[1]) > clamp) ||
+                           (len_v3(imp->ia[2]) > clamp))) {
+      MEM_freeN(impulses);
+      return 0;
+    }
+
+    for (int j = 0; j < 3; j++) {
+      if (cloth1->verts[pair->ap1].impulse_count > 0 &&
+          fabsf(cloth1->verts[pair->ap1].impulse[j]) < fabsf(imp->ia[0][j])) {
+        cloth1->verts[pair->ap1].impulse[j] = imp->ia[0][j];
+      }
+
+      if (cloth1->verts[pair->ap2].impulse_count > 0 &&
+          fabsf(cloth1->verts[pair->ap2].impulse[j]) < fabsf(imp->ia[1][j])) {
+        cloth1->verts[pair->ap2].impulse[j] = imp->ia[1][j];
+      }
+
+      if (!is_hair) {
+        if (cloth1->verts[pair->ap3].impulse_count > 0 &&
+            fabsf(cloth1->verts[pair->ap3].impulse[j]) < fabsf(imp->ia[2][j])) {
+          cloth1->verts[pair->ap3].impulse[j] = imp->ia[2][j];
         }
       }
     }
+
+    result = 1;
   }
 
+  MEM_freeN(impulses);
+
   return result;
 }
 
@@ -903,26 +957,33 @@ static void cloth_selfcollision_impulse_vert(const float clamp_sq,
   vert->impulse_count++;
 }
 
-static int cloth_selfcollision_response_static(ClothModifierData *clmd,
-                                               CollPair *collpair,
-                                               uint collision_count,
-                                               const float dt)
+typedef struct SelfCollResponseData {
+  ClothModifierData *clmd;
+  CollPair *collisions;
+  CollPairImpulse *impulses;
+} SelfCollResponseData;
+
+static void cloth_selfcollision_impulse_calc(void *__restrict userdata,
+                                             const int index,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  int result = 0;
-  Cloth *cloth1;
+  SelfCollResponseData *data = (SelfCollResponseData *)userdata;
+  ClothModifierData *clmd = data->clmd;
+  CollPair *collpair = &data->collisions[index];
+  CollPairImpulse *imp = &data->impulses[index];
+  Cloth *cloth1 = clmd->clothObject;
   float w1, w2, w3, u1, u2, u3;
   float v1[3], v2[3], relativeVelocity[3];
   float magrelVel;
+  int result = 0;
 
-  cloth1 = clmd->clothObject;
-
-  for (int i = 0; i < collision_count; i++, collpair++) {
-    float ia[3][3] = {{0.0f}};
-    float ib[3][3] = {{0.0f}};
+  {
+    float(*ia)[3] = imp->ia;
+    float(*ib)[3] = imp->ib;
 
     /* Only handle static collisions here. */
     if (collpair->flag & (COLLISION_IN_FUTURE | COLLISION_INACTIVE)) {
-      continue;
+      return;
     }
 
     /* Compute barycentric coordinates for both collision points. */
@@ -1061,20 +1122,59 @@ static int cloth_selfcollision_response_static(ClothModifierData *clmd,
       }
     }
 
-    if (result) {
-      float clamp_sq = clmd->coll_parms->self_clamp * dt;
-      clamp_sq *= clamp_sq;
+    imp->active = (result != 0);
+  }
+}
+
+static int cloth_selfcollision_response_static(ClothModifierData *clmd,
+                                               CollPair *collpair,
+                                               uint collision_count,
+                                               const float dt)
+{
+  Cloth *cloth1 = clmd->clothObject;
+  float clamp_sq = clmd->coll_parms->self_clamp * dt;
+  int result = 0;
+
+  clamp_sq *= clamp_sq;
+
+  if (collision_count == 0) {
+    return 0;
+  }
+
+  CollPairImpulse *impulses = MEM_callocN(sizeof(*impulses) * collision_count, __func__);
 
-      cloth_selfcollision_impulse_vert(clamp_sq, ia[0], &cloth1->verts[collpair->ap1]);
-      cloth_selfcollision_impulse_vert(clamp_sq, ia[1], &cloth1->verts[collpair->ap2]);
-      cloth_selfcollision_impulse_vert(clamp_sq, ia[2], &cloth1->verts[collpair->ap3]);
+  SelfCollResponseData data = {
+      .clmd = clmd,
+      .collisions = collpair,
+      .impulses = impulses,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (collision_count > 256);
+  BLI_task_parallel_range(0, collision_count, &data, cloth_selfcollision_impulse_calc, &settings);
 
-      cloth_selfcollision_impulse_vert(clamp_sq, ib[0], &cloth1->verts[collpair->bp1]);
-      cloth_selfcollision_impulse_vert(clamp_sq, ib[1], &cloth1->verts[collpair->bp2]);
-      cloth_selfcollision_impulse_vert(clamp_sq, ib[2], &cloth1->verts[collpair->bp3]);
+  for (int i = 0; i < collision_count; i++) {
+    CollPairImpulse *imp = &impulses[i];
+    const CollPair *pair = &collpair[i];
+
+    if (!imp->active) {
+      continue;
     }
+
+    cloth_selfcollision_impulse_vert(clamp_sq, imp->ia[0], &cloth1->verts[pair->ap1]);
+    cloth_selfcollision_impulse_vert(clamp_sq, imp->ia[1], &cloth1->verts[pair->ap2]);
+    cloth_selfcollision_impulse_vert(clamp_sq, imp->ia[2], &cloth1->verts[pair->ap3]);
+
+    cloth_selfcollision_impulse_vert(clamp_sq, imp->ib[0], &cloth1->verts[pair->bp1]);
+    cloth_selfcollision_impulse_vert(clamp_sq, imp->ib[1], &cloth1->verts[pair->bp2]);
+    cloth_selfcollision_impulse_vert(clamp_sq, imp->ib[2], &cloth1->verts[pair->bp3]);
+
+    result = 1;
   }
 
+  MEM_freeN(impulses);
+
   return result;
 }
 
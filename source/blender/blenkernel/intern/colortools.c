@@ -1532,6 +1532,76 @@ static void scopes_update_reduce(const void *__restrict UNUSED(userdata),
   }
 }
 
+/* FNV-1a style mixing, only has to tell "same pixels" apart from "changed pixels". */
+static uint64_t scopes_hash_bytes(uint64_t hash, const void *data, size_t size)
+{
+  const unsigned char *bytes = data;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 0x100000001b3;
+  }
+  return hash;
+}
+
+/**
+ * Signature of the image content and of every setting that changes the scope result.
+ * Pixel data is sampled in evenly spread blocks, hashing every byte of a large float
+ * buffer would cost nearly as much as the scan this is meant to skip.
+ */
+static uint64_t scopes_content_hash(const Scopes *scopes,
+                                    const ImBuf *ibuf,
+                                    const ColorManagedViewSettings *view_settings,
+                                    const ColorManagedDisplaySettings *display_settings)
+{
+  uint64_t hash = 0xcbf29ce484222325;
+
+  hash = scopes_hash_bytes(hash, &ibuf->x, sizeof(ibuf->x));
+  hash = scopes_hash_bytes(hash, &ibuf->y, sizeof(ibuf->y));
+  hash = scopes_hash_bytes(hash, &ibuf->channels, sizeof(ibuf->channels));
+
+  hash = scopes_hash_bytes(hash, &scopes->wavefrm_mode, sizeof(scopes->wavefrm_mode));
+  hash = scopes_hash_bytes(hash, &scopes->accuracy, sizeof(scopes->accuracy));
+  hash = scopes_hash_bytes(hash, &scopes->sample_full, sizeof(scopes->sample_full));
+
+  hash = scopes_hash_bytes(hash, view_settings->look, strlen(view_settings->look));
+  hash = scopes_hash_bytes(
+      hash, view_settings->view_transform, strlen(view_settings->view_transform));
+  hash = scopes_hash_bytes(hash, &view_settings->exposure, sizeof(view_settings->exposure));
+  hash = scopes_hash_bytes(hash, &view_settings->gamma, sizeof(view_settings->gamma));
+  hash = scopes_hash_bytes(
+      hash, display_settings->display_device, strlen(display_settings->display_device));
+  if ((view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) &&
+      (view_settings->curve_mapping != NULL)) {
+    hash = scopes_hash_bytes(hash,
+                             &view_settings->curve_mapping->changed_timestamp,
+                             sizeof(view_settings->curve_mapping->changed_timestamp));
+  }
+
+  const unsigned char *buffer;
+  size_t buffer_size;
+  if (ibuf->rect_float) {
+    buffer = (const unsigned char *)ibuf->rect_float;
+    buffer_size = sizeof(float) * (size_t)ibuf->channels * ibuf->x * ibuf->y;
+  }
+  else {
+    buffer = (const unsigned char *)ibuf->rect;
+    buffer_size = sizeof(unsigned int) * (size_t)ibuf->x * ibuf->y;
+  }
+
+  const size_t block_size = 1024;
+  const size_t num_blocks = 256;
+  if (buffer_size <= block_size * num_blocks) {
+    hash = scopes_hash_bytes(hash, buffer, buffer_size);
+  }
+  else {
+    const size_t step = (buffer_size - block_size) / (num_blocks - 1);
+    for (size_t i = 0; i < num_blocks; i++) {
+      hash = scopes_hash_bytes(hash, buffer + i * step, block_size);
+    }
+  }
+
+  return hash;
+}
+
 void BKE_scopes_update(Scopes *scopes,
                        ImBuf *ibuf,
                        const ColorManagedViewSettings *view_settings,
@@ -1562,6 +1632,14 @@ void BKE_scopes_update(Scopes *scopes,
     return;
   }
 
+  /* Many notifiers reset `ok` without the displayed image actually changing. Skip the
+   * full scan when neither the pixels nor any setting affecting the result did change. */
+  const uint64_t buffer_hash = scopes_content_hash(scopes, ibuf, view_settings, display_settings);
+  if (buffer_hash == scopes->buffer_hash && scopes->waveform_1 != NULL) {
+    scopes->ok = 1;
+    return;
+  }
+
   scopes->hist.channels = 3;
   scopes->hist.x_resolution = 256;
 
@@ -1688,6 +1766,7 @@ void BKE_scopes_update(Scopes *scopes,
     IMB_display_buffer_release(cache_handle);
   }
 
+  scopes->buffer_hash = buffer_hash;
   scopes->ok = 1;
 }
 
@@ -35,12 +35,14 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_pointcloud_types.h"
 
+#include "BLI_ghash.h"
 #include "BLI_math.h"
 #include "BLI_math_color_blend.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -2035,6 +2037,108 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 }
 #endif
 
+/* -------------------------------------------------------------------- */
+/** \name Shared Layer Data Reference Counting
+ *
+ * Layers copied with #CD_REFERENCE used to borrow the source data unmanaged:
+ * the source had to outlive every copy, forcing full duplication in code paths
+ * that free intermediate meshes (see #BKE_mesh_copy_for_eval usages).
+ * Instead, count the referencing layers per data pointer, so shared data stays
+ * valid until its last user is gone, whatever order owner and references are
+ * freed in. Writers still have to make layers private first, via
+ * #CustomData_duplicate_referenced_layer and friends.
+ *
+ * Entries only exist while data is actually shared, so the table stays tiny
+ * (and is freed entirely when it empties).
+ * \{ */
+
+/** Tag for the owning (non #CD_FLAG_NOFREE) layer having been freed already. */
+#define SHARING_OWNER_FREED (1 << 30)
+
+static struct {
+  /** Layer data pointer -> number of referencing layers, with #SHARING_OWNER_FREED tag. */
+  GHash *map;
+  ThreadMutex mutex;
+} customdata_sharing = {NULL, BLI_MUTEX_INITIALIZER};
+
+/** Count \a layerdata as referenced by one more #CD_FLAG_NOFREE layer. */
+static void customdata_sharing_add_user(void *layerdata)
+{
+  if (layerdata == NULL) {
+    return;
+  }
+  BLI_mutex_lock(&customdata_sharing.mutex);
+  if (customdata_sharing.map == NULL) {
+    customdata_sharing.map = BLI_ghash_ptr_new(__func__);
+  }
+  void **val_p;
+  if (BLI_ghash_ensure_p(customdata_sharing.map, layerdata, &val_p)) {
+    *val_p = POINTER_FROM_INT(POINTER_AS_INT(*val_p) + 1);
+  }
+  else {
+    *val_p = POINTER_FROM_INT(1);
+  }
+  BLI_mutex_unlock(&customdata_sharing.mutex);
+}
+
+/**
+ * Drop one reference to \a layerdata.
+ *
+ * \return true when the caller must actually free the data:
+ * the owning layer is already gone and this was its last reference.
+ */
+static bool customdata_sharing_remove_user(void *layerdata)
+{
+  bool do_free = false;
+  BLI_mutex_lock(&customdata_sharing.mutex);
+  if (customdata_sharing.map != NULL) {
+    void **val_p = BLI_ghash_lookup_p(customdata_sharing.map, layerdata);
+    if (val_p != NULL) {
+      const int val = POINTER_AS_INT(*val_p);
+      const int users = (val & ~SHARING_OWNER_FREED) - 1;
+      BLI_assert(users >= 0);
+      if (users == 0) {
+        BLI_ghash_remove(customdata_sharing.map, layerdata, NULL, NULL);
+        do_free = (val & SHARING_OWNER_FREED) != 0;
+        if (BLI_ghash_len(customdata_sharing.map) == 0) {
+          BLI_ghash_free(customdata_sharing.map, NULL, NULL);
+          customdata_sharing.map = NULL;
+        }
+      }
+      else {
+        *val_p = POINTER_FROM_INT(users | (val & SHARING_OWNER_FREED));
+      }
+    }
+    /* No entry: referenced data that was never registered
+     * (e.g. #CD_ASSIGN of foreign data tagged no-free), never free it. */
+  }
+  BLI_mutex_unlock(&customdata_sharing.mutex);
+  return do_free;
+}
+
+/**
+ * The owning layer of \a layerdata is being freed.
+ *
+ * \return true when the data must actually be freed now,
+ * false when outstanding references keep it alive (the last one frees).
+ */
+static bool customdata_sharing_owner_free(void *layerdata)
+{
+  bool do_free = true;
+  BLI_mutex_lock(&customdata_sharing.mutex);
+  if (customdata_sharing.map != NULL) {
+    void **val_p = BLI_ghash_lookup_p(customdata_sharing.map, layerdata);
+    if (val_p != NULL) {
+      *val_p = POINTER_FROM_INT(POINTER_AS_INT(*val_p) | SHARING_OWNER_FREED);
+      do_free = false;
+    }
+  }
+  BLI_mutex_unlock(&customdata_sharing.mutex);
+  return do_free;
+}
+
+/** \} */
+
 bool CustomData_merge(const struct CustomData *source,
                       struct CustomData *dest,
                       CustomDataMask mask,
@@ -2149,18 +2253,30 @@ void CustomData_copy(const struct CustomData *source,
 
 static void customData_free_layer__internal(CustomDataLayer *layer, int totelem)
 {
-  const LayerTypeInfo *typeInfo;
+  bool do_free;
 
-  if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
-    typeInfo = layerType_getInfo(layer->type);
+  if (layer->data == NULL) {
+    return;
+  }
+
+  if (layer->flag & CD_FLAG_NOFREE) {
+    /* Referenced data: only free when the owning layer is already gone
+     * and this was the last reference. */
+    do_free = customdata_sharing_remove_user(layer->data);
+  }
+  else {
+    /* Owned data: defer the free while references to it are still alive. */
+    do_free = customdata_sharing_owner_free(layer->data);
+  }
+
+  if (do_free) {
+    const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
 
     if (typeInfo->free) {
       typeInfo->free(layer->data, totelem, typeInfo->size);
     }
 
-    if (layer->data) {
-      MEM_freeN(layer->data);
-    }
+    MEM_freeN(layer->data);
   }
 }
 
@@ -2550,6 +2666,12 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
   data->layers[index].flag = flag;
   data->layers[index].data = newlayerdata;
 
+  if (alloctype == CD_REFERENCE) {
+    /* Count this layer as a user of the shared data,
+     * see customData_free_layer__internal. */
+    customdata_sharing_add_user(newlayerdata);
+  }
+
   /* Set default name if none exists. Note we only call DATA_()  once
    * we know there is a default name, to avoid overhead of locale lookups
    * in the depsgraph. */
@@ -2740,18 +2862,27 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
      * So in case a custom copy function is defined, use it!
      */
     const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+    void *data_old = layer->data;
 
     if (typeInfo->copy) {
       void *dst_data = MEM_malloc_arrayN(
           (size_t)totelem, typeInfo->size, "CD duplicate ref layer");
-      typeInfo->copy(layer->data, dst_data, totelem);
+      typeInfo->copy(data_old, dst_data, totelem);
       layer->data = dst_data;
     }
     else {
-      layer->data = MEM_dupallocN(layer->data);
+      layer->data = MEM_dupallocN(data_old);
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+
+    /* This may have been the last reference to data whose owner was freed already. */
+    if (customdata_sharing_remove_user(data_old)) {
+      if (typeInfo->free) {
+        typeInfo->free(data_old, totelem, typeInfo->size);
+      }
+      MEM_freeN(data_old);
+    }
   }
 
   return layer->data;
@@ -3619,7 +3750,7 @@ void CustomData_bmesh_free_block_data(CustomData *data, void *block)
   }
 }
 
-static void CustomData_bmesh_alloc_block(CustomData *data, void **block)
+void CustomData_bmesh_alloc_block(CustomData *data, void **block)
 {
 
   if (*block) {
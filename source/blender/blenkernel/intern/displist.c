@@ -40,6 +40,7 @@
 #include "BLI_memarena.h"
 #include "BLI_scanfill.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_anim_path.h"
@@ -313,6 +314,87 @@ bool BKE_displist_surfindex_get(DispList *dl, int a, int *b, int *p1, int *p2, i
 /* ICC with the optimization -02 causes crashes. */
 #  pragma intel optimization_level 1
 #endif
+/* Spline with its display list allocated up front, so the evaluation
+ * of each spline can run as an independent task. */
+typedef struct CurveToDisplistEntry {
+  const Nurb *nu;
+  DispList *dl;
+  int resolu;
+} CurveToDisplistEntry;
+
+static void curve_to_displist_entry_eval(const CurveToDisplistEntry *entry)
+{
+  const Nurb *nu = entry->nu;
+  DispList *dl = entry->dl;
+  float *data = dl->verts;
+  const int resolu = entry->resolu;
+  int a;
+
+  if (nu->type == CU_BEZIER) {
+    const BezTriple *prevbezt = nu->bezt;
+    const BezTriple *bezt = prevbezt + 1;
+
+    if (dl->type == DL_POLY) {
+      a = nu->pntsu;
+    }
+    else {
+      a = nu->pntsu - 1;
+    }
+
+    while (a--) {
+      if (a == 0 && dl->type == DL_POLY) {
+        bezt = nu->bezt;
+      }
+
+      if (prevbezt->h2 == HD_VECT && bezt->h1 == HD_VECT) {
+        copy_v3_v3(data, prevbezt->vec[1]);
+        data += 3;
+      }
+      else {
+        int j;
+        for (j = 0; j < 3; j++) {
+          BKE_curve_forward_diff_bezier(prevbezt->vec[1][j],
+                                        prevbezt->vec[2][j],
+                                        bezt->vec[0][j],
+                                        bezt->vec[1][j],
+                                        data + j,
+                                        resolu,
+                                        3 * sizeof(float));
+        }
+
+        data += 3 * resolu;
+      }
+
+      if (a == 0 && dl->type == DL_SEGM) {
+        copy_v3_v3(data, bezt->vec[1]);
+      }
+
+      prevbezt = bezt;
+      bezt++;
+    }
+  }
+  else if (nu->type == CU_NURBS) {
+    BKE_nurb_makeCurve(nu, data, NULL, NULL, NULL, resolu, 3 * sizeof(float));
+  }
+  else if (nu->type == CU_POLY) {
+    const BPoint *bp = nu->bp;
+    a = dl->nr;
+    while (a--) {
+      copy_v3_v3(data, bp->vec);
+      bp++;
+      data += 3;
+    }
+  }
+}
+
+static void curve_to_displist_entry_eval_cb(void *__restrict userdata,
+                                            const int index,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CurveToDisplistEntry *entries = userdata;
+  curve_to_displist_entry_eval(&entries[index]);
+}
+
 static void curve_to_displist(Curve *cu,
                               ListBase *nubase,
                               ListBase *dispbase,
@@ -321,11 +403,15 @@ static void curve_to_displist(Curve *cu,
   Nurb *nu;
   DispList *dl;
   BezTriple *bezt, *prevbezt;
-  BPoint *bp;
-  float *data;
   int a, len, resolu;
   const bool editmode = (!for_render && (cu->editnurb || cu->editfont));
 
+  const int tot_nu = BLI_listbase_count(nubase);
+  CurveToDisplistEntry *entries = MEM_mallocN(sizeof(*entries) * tot_nu, __func__);
+  int tot_entries = 0;
+
+  /* First pass: count and allocate the display list of every spline, evaluation runs
+   * as parallel tasks below (important for text objects, one spline per character). */
   nu = nubase->first;
   while (nu) {
     if (nu->hide == 0 || editmode == false) {
@@ -378,52 +464,15 @@ static void curve_to_displist(Curve *cu,
         dl->col = nu->mat_nr;
         dl->charidx = nu->charidx;
 
-        data = dl->verts;
-
         /* check that (len != 2) so we don't immediately loop back on ourselves */
         if (nu->flagu & CU_NURB_CYCLIC && (dl->nr != 2)) {
           dl->type = DL_POLY;
-          a = nu->pntsu;
         }
         else {
           dl->type = DL_SEGM;
-          a = nu->pntsu - 1;
         }
 
-        prevbezt = nu->bezt;
-        bezt = prevbezt + 1;
-
-        while (a--) {
-          if (a == 0 && dl->type == DL_POLY) {
-            bezt = nu->bezt;
-          }
-
-          if (prevbezt->h2 == HD_VECT && bezt->h1 == HD_VECT) {
-            copy_v3_v3(data, prevbezt->vec[1]);
-            data += 3;
-          }
-          else {
-            int j;
-            for (j = 0; j < 3; j++) {
-              BKE_curve_forward_diff_bezier(prevbezt->vec[1][j],
-                                            prevbezt->vec[2][j],
-                                            bezt->vec[0][j],
-                                            bezt->vec[1][j],
-                                            data + j,
-                                            resolu,
-                                            3 * sizeof(float));
-            }
-
-            data += 3 * resolu;
-          }
-
-          if (a == 0 && dl->type == DL_SEGM) {
-            copy_v3_v3(data, bezt->vec[1]);
-          }
-
-          prevbezt = bezt;
-          bezt++;
-        }
+        entries[tot_entries++] = (CurveToDisplistEntry){nu, dl, resolu};
       }
       else if (nu->type == CU_NURBS) {
         len = (resolu * SEGMENTSU(nu));
@@ -437,14 +486,14 @@ static void curve_to_displist(Curve *cu,
         dl->col = nu->mat_nr;
         dl->charidx = nu->charidx;
 
-        data = dl->verts;
         if (nu->flagu & CU_NURB_CYCLIC) {
           dl->type = DL_POLY;
         }
         else {
           dl->type = DL_SEGM;
         }
-        BKE_nurb_makeCurve(nu, data, NULL, NULL, NULL, resolu, 3 * sizeof(float));
+
+        entries[tot_entries++] = (CurveToDisplistEntry){nu, dl, resolu};
       }
       else if (nu->type == CU_POLY) {
         len = nu->pntsu;
@@ -456,7 +505,6 @@ static void curve_to_displist(Curve *cu,
         dl->col = nu->mat_nr;
         dl->charidx = nu->charidx;
 
-        data = dl->verts;
         if ((nu->flagu & CU_NURB_CYCLIC) && (dl->nr != 2)) {
           dl->type = DL_POLY;
         }
@@ -464,17 +512,19 @@ static void curve_to_displist(Curve *cu,
           dl->type = DL_SEGM;
         }
 
-        a = len;
-        bp = nu->bp;
-        while (a--) {
-          copy_v3_v3(data, bp->vec);
-          bp++;
-          data += 3;
-        }
+        entries[tot_entries++] = (CurveToDisplistEntry){nu, dl, resolu};
       }
     }
     nu = nu->next;
   }
+
+  /* Second pass: evaluate, every entry only reads its spline and writes its own verts. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8;
+  BLI_task_parallel_range(0, tot_entries, entries, curve_to_displist_entry_eval_cb, &settings);
+
+  MEM_freeN(entries);
 }
 
 /**
@@ -41,6 +41,11 @@ struct BMBVHTree {
   const float (*cos_cage)[3];
   bool cos_cage_free;
 
+  /* Maps tree leaf order to looptri index when faces were filtered out on creation,
+   * NULL when all looptris were inserted (needed by #BKE_bmbvh_refit). */
+  int *leaf_looptri_map;
+  int leaf_tot;
+
   int flag;
 };
 
@@ -113,9 +118,15 @@ BMBVHTree *BKE_bmbvh_new_ex(BMesh *bm,
 
   bmtree->tree = BLI_bvhtree_new(tottri, epsilon, 8, 8);
 
+  bmtree->leaf_tot = tottri;
+  if (test_fn && (tottri != looptris_tot)) {
+    bmtree->leaf_looptri_map = MEM_mallocN(sizeof(*bmtree->leaf_looptri_map) * tottri, __func__);
+  }
+
   f_test_prev = NULL;
   test_fn_ret = false;
 
+  int leaf_index = 0;
   for (i = 0; i < looptris_tot; i++) {
     if (test_fn) {
       /* note, the arrays wont align now! take care */
@@ -141,6 +152,11 @@ BMBVHTree *BKE_bmbvh_new_ex(BMesh *bm,
       copy_v3_v3(cos[2], looptris[i][2]->v->co);
     }
 
+    if (bmtree->leaf_looptri_map) {
+      bmtree->leaf_looptri_map[leaf_index] = i;
+    }
+    leaf_index++;
+
     BLI_bvhtree_insert(bmtree->tree, i, (float *)cos, 3);
   }
 
@@ -191,10 +207,48 @@ void BKE_bmbvh_free(BMBVHTree *bmtree)
   if (bmtree->cos_cage && bmtree->cos_cage_free) {
     MEM_freeN((void *)bmtree->cos_cage);
   }
+  if (bmtree->leaf_looptri_map) {
+    MEM_freeN(bmtree->leaf_looptri_map);
+  }
 
   MEM_freeN(bmtree);
 }
 
+/**
+ * Refit the tree to the current vertex positions, for when only coordinates changed
+ * and the topology (and any face filtering) is intact. Much cheaper than a rebuild
+ * since the tree structure is kept as-is and only the bounds are updated.
+ */
+void BKE_bmbvh_refit(BMBVHTree *bmtree)
+{
+  float cos[3][3];
+  int i;
+
+  if (bmtree->cos_cage) {
+    BM_mesh_elem_index_ensure(bmtree->bm, BM_VERT);
+  }
+
+  for (i = 0; i < bmtree->leaf_tot; i++) {
+    const int tri_index = bmtree->leaf_looptri_map ? bmtree->leaf_looptri_map[i] : i;
+    BMLoop **ltri = bmtree->looptris[tri_index];
+
+    if (bmtree->cos_cage) {
+      copy_v3_v3(cos[0], bmtree->cos_cage[BM_elem_index_get(ltri[0]->v)]);
+      copy_v3_v3(cos[1], bmtree->cos_cage[BM_elem_index_get(ltri[1]->v)]);
+      copy_v3_v3(cos[2], bmtree->cos_cage[BM_elem_index_get(ltri[2]->v)]);
+    }
+    else {
+      copy_v3_v3(cos[0], ltri[0]->v->co);
+      copy_v3_v3(cos[1], ltri[1]->v->co);
+      copy_v3_v3(cos[2], ltri[2]->v->co);
+    }
+
+    BLI_bvhtree_update_node(bmtree->tree, i, (float *)cos, NULL, 3);
+  }
+
+  BLI_bvhtree_update_tree(bmtree->tree);
+}
+
 BVHTree *BKE_bmbvh_tree_get(BMBVHTree *bmtree)
 {
   return bmtree->tree;
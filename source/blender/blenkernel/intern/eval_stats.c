@@ -0,0 +1,125 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include "BKE_eval_stats.h"
+
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_dynstr.h"
+#include "BLI_ghash.h"
+#include "BLI_string.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_global.h"
+
+/* Accumulated samples for a single name. */
+typedef struct EvalStatsValue {
+  double total;
+  int num_samples;
+} EvalStatsValue;
+
+static struct {
+  /* Maps name (owned string) to an owned EvalStatsValue, created lazily on
+   * the first sample. */
+  GHash *values;
+  bool is_enabled;
+} g_eval_stats = {NULL, false};
+
+static ThreadMutex g_eval_stats_mutex = BLI_MUTEX_INITIALIZER;
+
+void BKE_eval_stats_enable(bool enable)
+{
+  g_eval_stats.is_enabled = enable;
+}
+
+bool BKE_eval_stats_is_enabled(void)
+{
+  /* Depsgraph timing debug prints the statistics per evaluation, so it also
+   * implies collecting them. */
+  return g_eval_stats.is_enabled || (G.debug & G_DEBUG_DEPSGRAPH_TIME) != 0;
+}
+
+void BKE_eval_stats_sample_add(const char *name, double value)
+{
+  if (!BKE_eval_stats_is_enabled()) {
+    return;
+  }
+  BLI_mutex_lock(&g_eval_stats_mutex);
+  if (g_eval_stats.values == NULL) {
+    g_eval_stats.values = BLI_ghash_str_new("eval stats values");
+  }
+  EvalStatsValue *stats_value = BLI_ghash_lookup(g_eval_stats.values, name);
+  if (stats_value == NULL) {
+    stats_value = MEM_callocN(sizeof(EvalStatsValue), "eval stats value");
+    BLI_ghash_insert(g_eval_stats.values, BLI_strdup(name), stats_value);
+  }
+  stats_value->total += value;
+  stats_value->num_samples++;
+  BLI_mutex_unlock(&g_eval_stats_mutex);
+}
+
+void BKE_eval_stats_reset(void)
+{
+  BLI_mutex_lock(&g_eval_stats_mutex);
+  if (g_eval_stats.values != NULL) {
+    BLI_ghash_clear(g_eval_stats.values, MEM_freeN, MEM_freeN);
+  }
+  BLI_mutex_unlock(&g_eval_stats_mutex);
+}
+
+char *BKE_eval_stats_as_json(void)
+{
+  DynStr *ds = BLI_dynstr_new();
+  BLI_dynstr_append(ds, "{");
+  BLI_mutex_lock(&g_eval_stats_mutex);
+  if (g_eval_stats.values != NULL) {
+    GHashIterator gh_iter;
+    bool is_first = true;
+    GHASH_ITER (gh_iter, g_eval_stats.values) {
+      const char *name = BLI_ghashIterator_getKey(&gh_iter);
+      const EvalStatsValue *stats_value = BLI_ghashIterator_getValue(&gh_iter);
+      BLI_dynstr_appendf(ds,
+                         "%s\"%s\": {\"total\": %f, \"samples\": %d}",
+                         is_first ? "" : ", ",
+                         name,
+                         stats_value->total,
+                         stats_value->num_samples);
+      is_first = false;
+    }
+  }
+  BLI_mutex_unlock(&g_eval_stats_mutex);
+  BLI_dynstr_append(ds, "}");
+  char *result = BLI_dynstr_get_cstring(ds);
+  BLI_dynstr_free(ds);
+  return result;
+}
+
+void BKE_eval_stats_free(void)
+{
+  BLI_mutex_lock(&g_eval_stats_mutex);
+  if (g_eval_stats.values != NULL) {
+    BLI_ghash_free(g_eval_stats.values, MEM_freeN, MEM_freeN);
+    g_eval_stats.values = NULL;
+  }
+  BLI_mutex_unlock(&g_eval_stats_mutex);
+}
@@ -52,6 +52,8 @@
 
 #include "CLG_log.h"
 
+#include "atomic_ops.h"
+
 #define SMALL -1.0e-10
 #define SELECT 1
 
@@ -75,6 +77,7 @@ void BKE_fcurve_free(FCurve *fcu)
   /* free curve data */
   MEM_SAFE_FREE(fcu->bezt);
   MEM_SAFE_FREE(fcu->fpt);
+  MEM_SAFE_FREE(fcu->sample_cache);
 
   /* free RNA-path, as this were allocated when getting the path string */
   MEM_SAFE_FREE(fcu->rna_path);
@@ -132,6 +135,9 @@ FCurve *BKE_fcurve_copy(const FCurve *fcu)
   fcu_d->bezt = MEM_dupallocN(fcu_d->bezt);
   fcu_d->fpt = MEM_dupallocN(fcu_d->fpt);
 
+  /* do not share the playback cache, the copy re-bakes its own when needed */
+  fcu_d->sample_cache = NULL;
+
   /* copy rna-path */
   fcu_d->rna_path = MEM_dupallocN(fcu_d->rna_path);
 
@@ -988,6 +994,9 @@ void fcurve_store_samples(FCurve *fcu, void *data, int start, int end, FcuSample
   fcu->bezt = NULL;
   fcu->fpt = new_fpt;
   fcu->totvert = end - start + 1;
+
+  /* the keyframes which the playback cache was baked from are gone */
+  BKE_fcurve_sample_cache_free(fcu);
 }
 
 /* ***************************** F-Curve Sanity ********************************* */
@@ -1072,6 +1081,12 @@ void calchandles_fcurve_ex(FCurve *fcu, eBezTriple_Flag handle_sel_flag)
   BezTriple *bezt, *prev, *next;
   int a = fcu->totvert;
 
+  /* Handles get recalculated on about every keyframe edit, which makes this a
+   * convenient central point to throw away the baked playback cache. */
+  if (fcu != NULL) {
+    BKE_fcurve_sample_cache_free(fcu);
+  }
+
   /* Error checking:
    * - need at least two points
    * - need bezier keys
@@ -1498,6 +1513,62 @@ static float fcurve_eval_keyframes_extrapolate(
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/* Try to resolve the keyframe segment which contains evaltime from the cursor
+ * stored by the previous evaluation of the curve. During linear playback the
+ * evaluation time almost always stays within the same segment, or moves on to
+ * the next one, which makes the binary search over all keyframes unnecessary.
+ *
+ * Returns false when the cursor can not give a confident answer, in which
+ * case the caller falls back to the binary search. Uses the same threshold as
+ * the binary search for detecting evaluation exactly on a keyframe. */
+static bool fcurve_cursor_find_index(const FCurve *fcu,
+                                     const BezTriple *bezts,
+                                     float evaltime,
+                                     unsigned int *r_index,
+                                     bool *r_exact)
+{
+  const float threshold = 0.0001f;
+  unsigned int a = fcu->last_eval_index;
+
+  if (a >= fcu->totvert) {
+    return false;
+  }
+
+  /* Check the cursor segment itself, then the one right after it. */
+  for (int step = 0; step < 2; step++, a++) {
+    if (a >= fcu->totvert) {
+      return false;
+    }
+    const float key_x = bezts[a].vec[1][0];
+    if (fabsf(key_x - evaltime) < threshold) {
+      *r_index = a;
+      *r_exact = true;
+      return true;
+    }
+    if (evaltime < key_x) {
+      if (a == 0) {
+        *r_index = a;
+        *r_exact = false;
+        return true;
+      }
+      const float prev_x = bezts[a - 1].vec[1][0];
+      if (fabsf(prev_x - evaltime) < threshold) {
+        *r_index = a - 1;
+        *r_exact = true;
+        return true;
+      }
+      if (prev_x < evaltime) {
+        *r_index = a;
+        *r_exact = false;
+        return true;
+      }
+      /* Evaluation time moved before the cursor segment. */
+      return false;
+    }
+  }
+  return false;
+}
+
 static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, float evaltime)
 {
   const float eps = 1.e-8f;
@@ -1516,8 +1587,16 @@ static float fcurve_eval_keyframes_interpolate(FCurve *fcu, BezTriple *bezts, fl
    * - 0.00001 is too fine:
    *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
-   */
-  a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+   *
+   * The search is skipped entirely when the cursor from the previous
+   * evaluation still points at the right segment. */
+  if (!fcurve_cursor_find_index(fcu, bezts, evaltime, &a, &exact)) {
+    a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  }
+  /* Like curval, the cursor is not threadsafe: for actions shared between
+   * datablocks it is only a racy hint, which is fine since any stored value
+   * gets validated before use. */
+  fcu->last_eval_index = a;
   bezt = bezts + a;
 
   if (exact) {
@@ -1854,10 +1933,86 @@ static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
   return cvalue;
 }
 
+/* ***************************** F-Curve - Playback Cache ***************************** */
+
+/* Baked playback cache: a flat array of fully evaluated values (keyframe
+ * interpolation plus F-Modifiers), one per frame over the keyframed range.
+ * Built lazily on the first whole-frame evaluation of an eligible curve,
+ * thrown away by #BKE_fcurve_sample_cache_free on any edit. */
+
+/* Minimum number of keyframes before baking pays off. */
+#define FCURVE_SAMPLE_CACHE_MIN_KEYFRAMES 16
+/* Upper limit of baked samples, keeps memory use of curves with very wide
+ * keyframe ranges bounded. */
+#define FCURVE_SAMPLE_CACHE_MAX_SAMPLES 65536
+
+void BKE_fcurve_sample_cache_free(FCurve *fcu)
+{
+  MEM_SAFE_FREE(fcu->sample_cache);
+}
+
+static FCurveSampleCache *fcurve_sample_cache_ensure(FCurve *fcu)
+{
+  FCurveSampleCache *cache = fcu->sample_cache;
+  if (cache != NULL) {
+    return cache;
+  }
+  const int start = (int)floorf(fcu->bezt[0].vec[1][0]);
+  const int end = (int)ceilf(fcu->bezt[fcu->totvert - 1].vec[1][0]);
+  const int len = end - start + 1;
+  if (len < 1 || len > FCURVE_SAMPLE_CACHE_MAX_SAMPLES) {
+    return NULL;
+  }
+  /* Values are stored in the same allocation, right after the header. */
+  cache = MEM_mallocN(sizeof(FCurveSampleCache) + sizeof(float) * len, "FCurveSampleCache");
+  cache->values = (float *)(cache + 1);
+  cache->start = start;
+  cache->len = len;
+  for (int i = 0; i < len; i++) {
+    cache->values[i] = evaluate_fcurve_ex(fcu, (float)(start + i), 0.0f);
+  }
+  /* Publish atomically: evaluation of an action shared between datablocks can
+   * run in multiple threads, the first finished bake wins. Invalidation only
+   * happens from edit code, which never runs during evaluation. */
+  if (atomic_cas_ptr((void **)&fcu->sample_cache, NULL, cache) != NULL) {
+    MEM_freeN(cache);
+  }
+  return fcu->sample_cache;
+}
+
+/* Evaluate the curve through the playback cache. Only whole-frame evaluation
+ * of keyframed curves inside the keyframed range is served from the cache;
+ * everything else (sub-frame times for motion blur, extrapolation, drivers)
+ * returns false and keeps using the exact curve math. */
+static bool fcurve_sample_cache_evaluate(FCurve *fcu, float evaltime, float *r_cvalue)
+{
+  if (fcu->bezt == NULL || fcu->totvert < FCURVE_SAMPLE_CACHE_MIN_KEYFRAMES) {
+    return false;
+  }
+  const float frame_f = floorf(evaltime + 0.5f);
+  if (fabsf(evaltime - frame_f) > 0.0001f) {
+    return false;
+  }
+  FCurveSampleCache *cache = fcurve_sample_cache_ensure(fcu);
+  if (cache == NULL) {
+    return false;
+  }
+  const int frame = (int)frame_f;
+  if (frame < cache->start || frame >= cache->start + cache->len) {
+    return false;
+  }
+  *r_cvalue = cache->values[frame - cache->start];
+  return true;
+}
+
 float evaluate_fcurve(FCurve *fcu, float evaltime)
 {
   BLI_assert(fcu->driver == NULL);
 
+  float cvalue;
+  if (fcurve_sample_cache_evaluate(fcu, evaltime, &cvalue)) {
+    return cvalue;
+  }
   return evaluate_fcurve_ex(fcu, evaltime, 0.0);
 }
 
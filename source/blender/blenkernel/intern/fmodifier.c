@@ -1146,6 +1146,11 @@ FModifier *add_fmodifier(ListBase *modifiers, int type, FCurve *owner_fcu)
     calchandles_fcurve(owner_fcu);
   }
 
+  /* any modifier changes the evaluated values */
+  if (owner_fcu) {
+    BKE_fcurve_sample_cache_free(owner_fcu);
+  }
+
   /* return modifier for further editing */
   return fcm;
 }
@@ -1218,6 +1223,11 @@ bool remove_fmodifier(ListBase *modifiers, FModifier *fcm)
   /* removing the cycles modifier requires a handle update */
   FCurve *update_fcu = (fcm->type == FMODIFIER_TYPE_CYCLES) ? fcm->curve : NULL;
 
+  /* any modifier changes the evaluated values */
+  if (fcm->curve) {
+    BKE_fcurve_sample_cache_free(fcm->curve);
+  }
+
   /* free modifier's special data (stored inside fcm->data) */
   if (fcm->data) {
     if (fmi && fmi->free_data) {
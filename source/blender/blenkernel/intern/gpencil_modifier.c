@@ -29,6 +29,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -862,6 +863,63 @@ void BKE_gpencil_prepare_eval_data(Depsgraph *depsgraph, Scene *scene, Object *o
   BKE_gpencil_update_orig_pointers(ob_orig, (Object *)ob);
 }
 
+typedef struct tGpencilDeformStrokesData {
+  GpencilModifierData *md;
+  const GpencilModifierTypeInfo *mti;
+  Depsgraph *depsgraph;
+  Object *ob;
+  bGPDlayer *gpl;
+  bGPDframe *gpf;
+  bGPDstroke **strokes;
+} tGpencilDeformStrokesData;
+
+static void gpencil_deform_stroke_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  tGpencilDeformStrokesData *data = userdata;
+  data->mti->deformStroke(
+      data->md, data->depsgraph, data->ob, data->gpl, data->gpf, data->strokes[i]);
+}
+
+/* Deform all strokes of a frame in parallel tasks. Only valid for modifiers
+ * which set eGpencilModifierTypeFlag_ThreadedDeform, i.e. whose deformStroke
+ * callback is fully independent per stroke. */
+static void gpencil_deform_frame_strokes_threaded(GpencilModifierData *md,
+                                                  const GpencilModifierTypeInfo *mti,
+                                                  Depsgraph *depsgraph,
+                                                  Object *ob,
+                                                  bGPDlayer *gpl,
+                                                  bGPDframe *gpf)
+{
+  const int totstrokes = BLI_listbase_count(&gpf->strokes);
+  if (totstrokes == 0) {
+    return;
+  }
+
+  bGPDstroke **strokes = MEM_malloc_arrayN(totstrokes, sizeof(bGPDstroke *), __func__);
+  int i = 0;
+  LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+    strokes[i++] = gps;
+  }
+
+  tGpencilDeformStrokesData data = {
+      .md = md,
+      .mti = mti,
+      .depsgraph = depsgraph,
+      .ob = ob,
+      .gpl = gpl,
+      .gpf = gpf,
+      .strokes = strokes,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (totstrokes > 8);
+  BLI_task_parallel_range(0, totstrokes, &data, gpencil_deform_stroke_cb, &settings);
+
+  MEM_freeN(strokes);
+}
+
 /* Calculate gpencil modifiers */
 void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
@@ -903,8 +961,13 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
           }
 
           if (mti->deformStroke) {
-            LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
-              mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
+            if (mti->flags & eGpencilModifierTypeFlag_ThreadedDeform) {
+              gpencil_deform_frame_strokes_threaded(md, mti, depsgraph, ob, gpl, gpf);
+            }
+            else {
+              LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
+                mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
+              }
             }
           }
         }
@@ -63,6 +63,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_mempool.h"
 #include "BLI_system.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h" /* for stamp timecode format */
 #include "BLI_utildefines.h"
@@ -163,6 +164,9 @@ static void image_free_data(ID *id)
 {
   Image *image = (Image *)id;
 
+  /* The playback prefetch thread may still be decoding into this image. */
+  BKE_scene_playback_prefetch_stop();
+
   /* Also frees animdata. */
   BKE_image_free_buffers(image);
 
@@ -247,6 +251,39 @@ static void imagecache_keydata(void *userkey, int *framenr, int *proxy, int *ren
   *render_flags = 0;
 }
 
+typedef struct ImageCachePriorityData {
+  int framenr;
+} ImageCachePriorityData;
+
+static void *imagecache_getprioritydata(void *key_v)
+{
+  ImageCacheKey *key = key_v;
+  ImageCachePriorityData *priority_data;
+
+  priority_data = MEM_callocN(sizeof(*priority_data), "image cache priority data");
+  priority_data->framenr = IMA_INDEX_ENTRY(key->index);
+
+  return priority_data;
+}
+
+/* Frames close to the last requested one are the most expensive to lose: they are what scrubbing
+ * back and forth needs. Rank buffers by their distance to that frame, so a big sequence evicts
+ * its own distant frames before anything from the current working set. */
+static int imagecache_getitempriority(void *last_userkey_v, void *priority_data_v)
+{
+  ImageCacheKey *last_userkey = last_userkey_v;
+  ImageCachePriorityData *priority_data = priority_data_v;
+
+  return -abs(IMA_INDEX_ENTRY(last_userkey->index) - priority_data->framenr);
+}
+
+static void imagecache_prioritydeleter(void *priority_data_v)
+{
+  ImageCachePriorityData *priority_data = priority_data_v;
+
+  MEM_freeN(priority_data);
+}
+
 static void imagecache_put(Image *image, int index, ImBuf *ibuf)
 {
   ImageCacheKey key;
@@ -258,6 +295,10 @@ static void imagecache_put(Image *image, int index, ImBuf *ibuf)
     image->cache = IMB_moviecache_create(
         "Image Datablock Cache", sizeof(ImageCacheKey), imagecache_hashhash, imagecache_hashcmp);
     IMB_moviecache_set_getdata_callback(image->cache, imagecache_keydata);
+    IMB_moviecache_set_priority_callback(image->cache,
+                                         imagecache_getprioritydata,
+                                         imagecache_getitempriority,
+                                         imagecache_prioritydeleter);
   }
 
   key.index = index;
@@ -4083,6 +4124,105 @@ static ImBuf *image_load_sequence_file(Image *ima, ImageUser *iuser, int entry,
   return ibuf;
 }
 
+typedef struct LoadTileItem {
+  ImageTile *tile;
+  char filepath[FILE_MAX];
+  ImBuf *ibuf;
+} LoadTileItem;
+
+typedef struct LoadTilesData {
+  LoadTileItem *items;
+  int flag;
+  const char *colorspace;
+} LoadTilesData;
+
+static void load_tile_file_fn(void *__restrict userdata,
+                              const int i,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoadTilesData *data = userdata;
+  LoadTileItem *item = &data->items[i];
+
+  item->ibuf = IMB_loadiffname(item->filepath, data->flag, data->colorspace);
+}
+
+/**
+ * Load all tiles of a tiled image into the cache, reading the files concurrently.
+ *
+ * The per-tile lazy loading in #image_acquire_ibuf is serialized by the image mutex, which
+ * makes decoding the files dominate e.g. building the GPU tile array. Reading a tile file is
+ * independent from the others, so only the cache bookkeeping runs under the lock here.
+ * Tiles which are already cached, missing on disk, or turn out to be multi-layer EXR files
+ * are left to the regular lazy loading path.
+ */
+void BKE_image_load_all_tiles(Image *ima)
+{
+  if (ima == NULL || ima->source != IMA_SRC_TILED || ima->type != IMA_TYPE_IMAGE) {
+    return;
+  }
+
+  LoadTilesData data;
+  data.items = MEM_calloc_arrayN(
+      (size_t)BLI_listbase_count(&ima->tiles), sizeof(LoadTileItem), __func__);
+  data.flag = IB_rect | IB_multilayer | IB_metadata | imbuf_alpha_flags_for_image(ima);
+  data.colorspace = ima->colorspace_settings.name;
+
+  /* Collect the tiles which are not in the cache yet, and their file paths. */
+  BLI_mutex_lock(image_mutex);
+  int tot_load = 0;
+  LISTBASE_FOREACH (ImageTile *, tile, &ima->tiles) {
+    ImBuf *ibuf = image_get_cached_ibuf_for_index_entry(ima, 0, tile->tile_number);
+    if (ibuf != NULL) {
+      IMB_freeImBuf(ibuf);
+      continue;
+    }
+
+    LoadTileItem *item = &data.items[tot_load++];
+    item->tile = tile;
+
+    ImageUser iuser;
+    BKE_imageuser_default(&iuser);
+    iuser.tile = tile->tile_number;
+    BKE_image_user_file_path(&iuser, ima, item->filepath);
+  }
+  BLI_mutex_unlock(image_mutex);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, tot_load, &data, load_tile_file_fn, &settings);
+
+  BLI_mutex_lock(image_mutex);
+  for (int i = 0; i < tot_load; i++) {
+    LoadTileItem *item = &data.items[i];
+    if (item->ibuf == NULL) {
+      continue;
+    }
+
+#ifdef WITH_OPENEXR
+    if (item->ibuf->ftype == IMB_FTYPE_OPENEXR && item->ibuf->userdata &&
+        IMB_exr_has_multilayer(item->ibuf->userdata)) {
+      /* Multi-layer files change the image type, let #image_acquire_ibuf handle them. */
+      IMB_freeImBuf(item->ibuf);
+      continue;
+    }
+#endif
+
+    ImageUser iuser;
+    BKE_imageuser_default(&iuser);
+    iuser.tile = item->tile->tile_number;
+
+    image_initialize_after_load(ima, &iuser, item->ibuf);
+    image_assign_ibuf(ima, item->ibuf, 0, item->tile->tile_number);
+
+    /* The cache holds a reference now, drop the one from loading. */
+    IMB_freeImBuf(item->ibuf);
+  }
+  BLI_mutex_unlock(image_mutex);
+
+  MEM_freeN(data.items);
+}
+
 static ImBuf *image_load_sequence_multilayer(Image *ima, ImageUser *iuser, int entry, int frame)
 {
   struct ImBuf *ibuf = NULL;
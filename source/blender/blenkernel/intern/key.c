@@ -1280,6 +1280,12 @@ static float **keyblock_get_per_block_weights(Object *ob, Key *key, WeightsArray
 
   for (keyblock = key->block.first, keyblock_index = 0; keyblock;
        keyblock = keyblock->next, keyblock_index++) {
+    /* Skip non-contributing key-blocks, #do_rel_key ignores them (see there). */
+    if (keyblock == key->refkey || (keyblock->flag & KEYBLOCK_MUTE) ||
+        keyblock->curval == 0.0f) {
+      per_keyblock_weights[keyblock_index] = NULL;
+      continue;
+    }
     per_keyblock_weights[keyblock_index] = get_weights_array(ob, keyblock->vgroup, cache);
   }
 
@@ -350,9 +350,16 @@ Lattice *BKE_lattice_copy(Main *bmain, const Lattice *lt)
 }
 
 typedef struct LatticeDeformData {
-  Object *object;
-  float *latticedata;
+  /* Convert from object space to deform space */
   float latmat[4][4];
+  /* Cached reference to the lattice to use for evaluation. When in edit mode this attribute
+   * is set to the edit mode lattice. */
+  const Lattice *lt;
+  /* Pre-calculated deformation vectors. */
+  float *latticedata;
+  /* Cached vertex group and weights, looked up once to avoid doing so per deformed vertex. */
+  const MDeformVert *dvert;
+  int defgrp_index;
 } LatticeDeformData;
 
 LatticeDeformData *init_latt_deform(Object *oblatt, Object *ob)
@@ -417,36 +424,37 @@ LatticeDeformData *init_latt_deform(Object *oblatt, Object *ob)
 
   lattice_deform_data = MEM_mallocN(sizeof(LatticeDeformData), "Lattice Deform Data");
   lattice_deform_data->latticedata = latticedata;
-  lattice_deform_data->object = oblatt;
+  lattice_deform_data->lt = lt;
   copy_m4_m4(lattice_deform_data->latmat, latmat);
 
+  /* Resolve the vertex group once instead of once per deformed vertex. */
+  lattice_deform_data->dvert = lt->dvert;
+  lattice_deform_data->defgrp_index = (lt->vgroup[0] && lt->dvert) ?
+                                          BKE_object_defgroup_name_index(oblatt, lt->vgroup) :
+                                          -1;
+
   return lattice_deform_data;
 }
 
 void calc_latt_deform(LatticeDeformData *lattice_deform_data, float co[3], float weight)
 {
-  Object *ob = lattice_deform_data->object;
-  Lattice *lt = ob->data;
+  const Lattice *lt = lattice_deform_data->lt;
   float u, v, w, tu[4], tv[4], tw[4];
   float vec[3];
   int idx_w, idx_v, idx_u;
   int ui, vi, wi, uu, vv, ww;
 
   /* vgroup influence */
-  int defgrp_index = -1;
+  const int defgrp_index = lattice_deform_data->defgrp_index;
+  const MDeformVert *dvert = lattice_deform_data->dvert;
   float co_prev[3], weight_blend = 0.0f;
-  MDeformVert *dvert = BKE_lattice_deform_verts_get(ob);
   float *__restrict latticedata = lattice_deform_data->latticedata;
 
-  if (lt->editlatt) {
-    lt = lt->editlatt->latt;
-  }
   if (latticedata == NULL) {
     return;
   }
 
-  if (lt->vgroup[0] && dvert) {
-    defgrp_index = BKE_object_defgroup_name_index(ob, lt->vgroup);
+  if (defgrp_index != -1) {
     copy_v3_v3(co_prev, co);
   }
 
@@ -759,6 +767,50 @@ static bool calc_curve_deform(
   return false;
 }
 
+typedef struct CurveDeformUserdata {
+  Object *cuOb;
+  CurveDeform *cd;
+  float (*vert_coords)[3];
+  MDeformVert *dvert;
+  int defgrp_index;
+  bool invert_vgroup;
+  /* When bounds are computed first, the coordinates are left in curve space by that pass. */
+  bool already_in_curvespace;
+  short defaxis;
+} CurveDeformUserdata;
+
+static void curve_deform_vert_task(void *__restrict userdata,
+                                   const int index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CurveDeformUserdata *data = userdata;
+  float *co = data->vert_coords[index];
+
+  if (data->dvert != NULL) {
+    const float weight = data->invert_vgroup ?
+                             1.0f -
+                                 BKE_defvert_find_weight(data->dvert + index, data->defgrp_index) :
+                             BKE_defvert_find_weight(data->dvert + index, data->defgrp_index);
+    if (weight > 0.0f) {
+      float vec[3];
+      if (!data->already_in_curvespace) {
+        mul_m4_v3(data->cd->curvespace, co);
+      }
+      copy_v3_v3(vec, co);
+      calc_curve_deform(data->cuOb, vec, data->defaxis, data->cd, NULL);
+      interp_v3_v3v3(co, co, vec, weight);
+      mul_m4_v3(data->cd->objectspace, co);
+    }
+  }
+  else {
+    if (!data->already_in_curvespace) {
+      mul_m4_v3(data->cd->curvespace, co);
+    }
+    calc_curve_deform(data->cuOb, co, data->defaxis, data->cd, NULL);
+    mul_m4_v3(data->cd->objectspace, co);
+  }
+}
+
 void curve_deform_verts(Object *cuOb,
                         Object *target,
                         float (*vert_coords)[3],
@@ -793,29 +845,24 @@ void curve_deform_verts(Object *cuOb,
     cd.dmax[0] = cd.dmax[1] = cd.dmax[2] = 0.0f;
   }
 
-  if (dvert) {
-    MDeformVert *dvert_iter;
-    float vec[3];
-
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0, dvert_iter = dvert; a < numVerts; a++, dvert_iter++) {
-        const float weight = invert_vgroup ?
-                                 1.0f - BKE_defvert_find_weight(dvert_iter, defgrp_index) :
-                                 BKE_defvert_find_weight(dvert_iter, defgrp_index);
+  CurveDeformUserdata data = {
+      .cuOb = cuOb,
+      .cd = &cd,
+      .vert_coords = vert_coords,
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+      .invert_vgroup = invert_vgroup,
+      .already_in_curvespace = false,
+      .defaxis = defaxis,
+  };
 
-        if (weight > 0.0f) {
-          mul_m4_v3(cd.curvespace, vert_coords[a]);
-          copy_v3_v3(vec, vert_coords[a]);
-          calc_curve_deform(cuOb, vec, defaxis, &cd, NULL);
-          interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight);
-          mul_m4_v3(cd.objectspace, vert_coords[a]);
-        }
-      }
-    }
-    else {
-      /* set mesh min/max bounds */
-      INIT_MINMAX(cd.dmin, cd.dmax);
+  if ((cu->flag & CU_DEFORM_BOUNDS_OFF) == 0) {
+    /* Set mesh min/max bounds from the vertices that will deform.
+     * This pass stays serial (min/max accumulation), but is cheap next to the deform itself. */
+    INIT_MINMAX(cd.dmin, cd.dmax);
 
+    if (dvert) {
+      MDeformVert *dvert_iter;
       for (a = 0, dvert_iter = dvert; a < numVerts; a++, dvert_iter++) {
         const float weight = invert_vgroup ?
                                  1.0f - BKE_defvert_find_weight(dvert_iter, defgrp_index) :
@@ -825,46 +872,20 @@ void curve_deform_verts(Object *cuOb,
           minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
         }
       }
-
-      for (a = 0, dvert_iter = dvert; a < numVerts; a++, dvert_iter++) {
-        const float weight = invert_vgroup ?
-                                 1.0f - BKE_defvert_find_weight(dvert_iter, defgrp_index) :
-                                 BKE_defvert_find_weight(dvert_iter, defgrp_index);
-
-        if (weight > 0.0f) {
-          /* already in 'cd.curvespace', prev for loop */
-          copy_v3_v3(vec, vert_coords[a]);
-          calc_curve_deform(cuOb, vec, defaxis, &cd, NULL);
-          interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight);
-          mul_m4_v3(cd.objectspace, vert_coords[a]);
-        }
-      }
-    }
-  }
-  else {
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0; a < numVerts; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
-        calc_curve_deform(cuOb, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
     }
     else {
-      /* set mesh min max bounds */
-      INIT_MINMAX(cd.dmin, cd.dmax);
-
       for (a = 0; a < numVerts; a++) {
         mul_m4_v3(cd.curvespace, vert_coords[a]);
         minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
       }
-
-      for (a = 0; a < numVerts; a++) {
-        /* already in 'cd.curvespace', prev for loop */
-        calc_curve_deform(cuOb, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
     }
+    data.already_in_curvespace = true;
   }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 32;
+  BLI_task_parallel_range(0, numVerts, &data, curve_deform_vert_task, &settings);
 }
 
 /* input vec and orco = local coord in armature space */
@@ -849,6 +849,25 @@ static void layer_collection_sync(ViewLayer *view_layer,
   BLI_assert(BLI_listbase_count(lb_scene) == BLI_listbase_count(lb_layer));
 }
 
+static bool no_resync = false;
+
+/**
+ * Forbid view layer syncs, caller is expected to call
+ * #BKE_layer_collection_resync_allow, followed by an explicit sync of all the affected
+ * view layers (e.g. #BKE_main_collection_sync).
+ *
+ * Used when adding or removing many objects in a batch, to avoid a full resync per object.
+ */
+void BKE_layer_collection_resync_forbid(void)
+{
+  no_resync = true;
+}
+
+void BKE_layer_collection_resync_allow(void)
+{
+  no_resync = false;
+}
+
 /**
  * Update view layer collection tree from collections used in the scene.
  * This is used when collections are removed or added, both while editing
@@ -856,6 +875,10 @@ static void layer_collection_sync(ViewLayer *view_layer,
  */
 void BKE_layer_collection_sync(const Scene *scene, ViewLayer *view_layer)
 {
+  if (no_resync) {
+    return;
+  }
+
   if (!scene->master_collection) {
     /* Happens for old files that don't have versioning applied yet. */
     return;
@@ -1324,9 +1324,10 @@ BLI_INLINE unsigned int layer_bucket_index_from_xy(MaskRasterLayer *layer, const
           layer->buckets_x);
 }
 
-static float layer_bucket_depth_from_xy(MaskRasterLayer *layer, const float xy[2])
+static float layer_bucket_depth_from_index(MaskRasterLayer *layer,
+                                           const unsigned int index,
+                                           const float xy[2])
 {
-  unsigned int index = layer_bucket_index_from_xy(layer, xy);
   unsigned int *face_index = layer->buckets_face[index];
 
   if (face_index) {
@@ -1353,6 +1354,94 @@ static float layer_bucket_depth_from_xy(MaskRasterLayer *layer, const float xy[2
   }
 }
 
+static float layer_bucket_depth_from_xy(MaskRasterLayer *layer, const float xy[2])
+{
+  return layer_bucket_depth_from_index(layer, layer_bucket_index_from_xy(layer, xy), xy);
+}
+
+BLI_INLINE float maskrasterize_layer_falloff(const MaskRasterLayer *layer, float value_layer)
+{
+  switch (layer->falloff) {
+    case PROP_SMOOTH:
+      /* ease - gives less hard lines for dilate/erode feather */
+      value_layer = (3.0f * value_layer * value_layer -
+                     2.0f * value_layer * value_layer * value_layer);
+      break;
+    case PROP_SPHERE:
+      value_layer = sqrtf(2.0f * value_layer - value_layer * value_layer);
+      break;
+    case PROP_ROOT:
+      value_layer = sqrtf(value_layer);
+      break;
+    case PROP_SHARP:
+      value_layer = value_layer * value_layer;
+      break;
+    case PROP_INVSQUARE:
+      value_layer = value_layer * (2.0f - value_layer);
+      break;
+    case PROP_LIN:
+    default:
+      /* nothing */
+      break;
+  }
+
+  if (layer->blend != MASK_BLEND_REPLACE) {
+    value_layer *= layer->alpha;
+  }
+
+  return value_layer;
+}
+
+BLI_INLINE float maskrasterize_layer_blend(const MaskRasterLayer *layer,
+                                           float value,
+                                           float value_layer)
+{
+  if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
+    value_layer = 1.0f - value_layer;
+  }
+
+  switch (layer->blend) {
+    case MASK_BLEND_MERGE_ADD:
+      value += value_layer * (1.0f - value);
+      break;
+    case MASK_BLEND_MERGE_SUBTRACT:
+      value -= value_layer * value;
+      break;
+    case MASK_BLEND_ADD:
+      value += value_layer;
+      break;
+    case MASK_BLEND_SUBTRACT:
+      value -= value_layer;
+      break;
+    case MASK_BLEND_LIGHTEN:
+      value = max_ff(value, value_layer);
+      break;
+    case MASK_BLEND_DARKEN:
+      value = min_ff(value, value_layer);
+      break;
+    case MASK_BLEND_MUL:
+      value *= value_layer;
+      break;
+    case MASK_BLEND_REPLACE:
+      value = (value * (1.0f - layer->alpha)) + (value_layer * layer->alpha);
+      break;
+    case MASK_BLEND_DIFFERENCE:
+      value = fabsf(value - value_layer);
+      break;
+    default: /* same as add */
+      CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
+      BLI_assert(0);
+      value += value_layer;
+      break;
+  }
+
+  /* clamp after applying each layer so we don't get
+   * issues subtracting after accumulating over 1.0f */
+  CLAMP(value, 0.0f, 1.0f);
+
+  return value;
+}
+
 float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2])
 {
   /* can't do this because some layers may invert */
@@ -1370,82 +1459,14 @@ float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float x
 
     /* also used as signal for unused layer (when render is disabled) */
     if (layer->alpha != 0.0f && BLI_rctf_isect_pt_v(&layer->bounds, xy)) {
-      value_layer = 1.0f - layer_bucket_depth_from_xy(layer, xy);
-
-      switch (layer->falloff) {
-        case PROP_SMOOTH:
-          /* ease - gives less hard lines for dilate/erode feather */
-          value_layer = (3.0f * value_layer * value_layer -
-                         2.0f * value_layer * value_layer * value_layer);
-          break;
-        case PROP_SPHERE:
-          value_layer = sqrtf(2.0f * value_layer - value_layer * value_layer);
-          break;
-        case PROP_ROOT:
-          value_layer = sqrtf(value_layer);
-          break;
-        case PROP_SHARP:
-          value_layer = value_layer * value_layer;
-          break;
-        case PROP_INVSQUARE:
-          value_layer = value_layer * (2.0f - value_layer);
-          break;
-        case PROP_LIN:
-        default:
-          /* nothing */
-          break;
-      }
-
-      if (layer->blend != MASK_BLEND_REPLACE) {
-        value_layer *= layer->alpha;
-      }
+      value_layer = maskrasterize_layer_falloff(layer,
+                                                1.0f - layer_bucket_depth_from_xy(layer, xy));
     }
     else {
       value_layer = 0.0f;
     }
 
-    if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
-      value_layer = 1.0f - value_layer;
-    }
-
-    switch (layer->blend) {
-      case MASK_BLEND_MERGE_ADD:
-        value += value_layer * (1.0f - value);
-        break;
-      case MASK_BLEND_MERGE_SUBTRACT:
-        value -= value_layer * value;
-        break;
-      case MASK_BLEND_ADD:
-        value += value_layer;
-        break;
-      case MASK_BLEND_SUBTRACT:
-        value -= value_layer;
-        break;
-      case MASK_BLEND_LIGHTEN:
-        value = max_ff(value, value_layer);
-        break;
-      case MASK_BLEND_DARKEN:
-        value = min_ff(value, value_layer);
-        break;
-      case MASK_BLEND_MUL:
-        value *= value_layer;
-        break;
-      case MASK_BLEND_REPLACE:
-        value = (value * (1.0f - layer->alpha)) + (value_layer * layer->alpha);
-        break;
-      case MASK_BLEND_DIFFERENCE:
-        value = fabsf(value - value_layer);
-        break;
-      default: /* same as add */
-        CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
-        BLI_assert(0);
-        value += value_layer;
-        break;
-    }
-
-    /* clamp after applying each layer so we don't get
-     * issues subtracting after accumulating over 1.0f */
-    CLAMP(value, 0.0f, 1.0f);
+    value = maskrasterize_layer_blend(layer, value, value_layer);
   }
 
   return value;
@@ -1467,19 +1488,47 @@ static void maskrasterize_buffer_cb(void *__restrict userdata,
   MaskRasterizeBufferData *data = userdata;
 
   MaskRasterHandle *mr_handle = data->mr_handle;
-  float *buffer = data->buffer;
+  float *row = data->buffer + (size_t)y * data->width;
 
   const uint width = data->width;
   const float x_inv = data->x_inv;
   const float x_px_ofs = data->x_px_ofs;
+  const float y_f = ((float)y * data->y_inv) + data->y_px_ofs;
 
-  uint i = (uint)y * width;
-  float xy[2];
-  xy[1] = ((float)y * data->y_inv) + data->y_px_ofs;
-  for (uint x = 0; x < width; x++, i++) {
-    xy[0] = ((float)x * x_inv) + x_px_ofs;
+  /* Iterate layer-outer instead of sampling every pixel through
+   * #BKE_maskrasterize_handle_sample: the layer bounds test and the bucket row
+   * offset are constant along a scan-line, so they are calculated here once
+   * instead of once per pixel. */
+  copy_vn_fl(row, (int)width, 0.0f);
 
-    buffer[i] = BKE_maskrasterize_handle_sample(mr_handle, xy);
+  const uint layers_tot = mr_handle->layers_tot;
+  MaskRasterLayer *layer = mr_handle->layers;
+  for (uint layer_index = 0; layer_index < layers_tot; layer_index++, layer++) {
+    /* also used as signal for unused layer (when render is disabled) */
+    const bool row_in_bounds = (layer->alpha != 0.0f && y_f >= layer->bounds.ymin &&
+                                y_f <= layer->bounds.ymax);
+    uint bucket_row_index = 0;
+    if (row_in_bounds) {
+      bucket_row_index = ((uint)((y_f - layer->bounds.ymin) * layer->buckets_xy_scalar[1])) *
+                         layer->buckets_x;
+    }
+
+    for (uint x = 0; x < width; x++) {
+      const float xy[2] = {((float)x * x_inv) + x_px_ofs, y_f};
+      float value_layer;
+
+      if (row_in_bounds && xy[0] >= layer->bounds.xmin && xy[0] <= layer->bounds.xmax) {
+        const uint index = bucket_row_index +
+                           (uint)((xy[0] - layer->bounds.xmin) * layer->buckets_xy_scalar[0]);
+        value_layer = maskrasterize_layer_falloff(
+            layer, 1.0f - layer_bucket_depth_from_index(layer, index, xy));
+      }
+      else {
+        value_layer = 0.0f;
+      }
+
+      row[x] = maskrasterize_layer_blend(layer, row[x], value_layer);
+    }
   }
 }
 
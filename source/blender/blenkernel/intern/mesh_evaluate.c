@@ -43,10 +43,12 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_stack.h"
 #include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.h"
 #include "BKE_editmesh_cache.h"
+#include "BKE_eval_stats.h"
 #include "BKE_global.h"
 #include "BKE_mesh.h"
 #include "BKE_multires.h"
@@ -293,6 +295,47 @@ static void mesh_calc_normals_poly_prepare_cb(void *__restrict userdata,
   }
 }
 
+typedef struct MeshCalcNormalsAccumData {
+  const MLoop *mloop;
+  const float (*lnors_weighted)[3];
+  float (*vnors)[3];
+  /* One private accumulator of \a numVerts normals per stripe. */
+  float (*vnors_stripe)[3];
+  int numVerts;
+  int numLoops;
+  int stripe_len;
+  int stripes_num;
+} MeshCalcNormalsAccumData;
+
+static void mesh_calc_normals_poly_accum_cb(void *__restrict userdata,
+                                            const int stripe,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshCalcNormalsAccumData *data = userdata;
+  const MLoop *mloop = data->mloop;
+  const float(*lnors_weighted)[3] = data->lnors_weighted;
+  float(*vnors)[3] = data->vnors_stripe + (size_t)stripe * (size_t)data->numVerts;
+
+  const int lidx_start = stripe * data->stripe_len;
+  const int lidx_end = min_ii(lidx_start + data->stripe_len, data->numLoops);
+
+  for (int lidx = lidx_start; lidx < lidx_end; lidx++) {
+    add_v3_v3(vnors[mloop[lidx].v], lnors_weighted[lidx]);
+  }
+}
+
+static void mesh_calc_normals_poly_reduce_cb(void *__restrict userdata,
+                                             const int vidx,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MeshCalcNormalsAccumData *data = userdata;
+  float *no = data->vnors[vidx];
+
+  for (int stripe = 0; stripe < data->stripes_num; stripe++) {
+    add_v3_v3(no, data->vnors_stripe[(size_t)stripe * (size_t)data->numVerts + (size_t)vidx]);
+  }
+}
+
 static void mesh_calc_normals_poly_finalize_cb(void *__restrict userdata,
                                                const int vidx,
                                                const TaskParallelTLS *__restrict UNUSED(tls))
@@ -367,12 +410,43 @@ void BKE_mesh_calc_normals_poly(MVert *mverts,
   /* Compute poly normals, and prepare weighted loop normals. */
   BLI_task_parallel_range(0, numPolys, &data, mesh_calc_normals_poly_prepare_cb, &settings);
 
-  /* Actually accumulate weighted loop normals into vertex ones. */
-  /* Unfortunately, not possible to thread that
-   * (not in a reasonable, totally lock- and barrier-free fashion),
-   * since several loops will point to the same vertex... */
-  for (int lidx = 0; lidx < numLoops; lidx++) {
-    add_v3_v3(vnors[mloop[lidx].v], data.lnors_weighted[lidx]);
+  /* Actually accumulate weighted loop normals into vertex ones.
+   *
+   * Several loops point to the same vertex, so this can't simply be a parallel loop over loops.
+   * Instead split the loops into contiguous ascending stripes, accumulate each stripe into a
+   * private buffer, then reduce the buffers per vertex in stripe order. The striping changes the
+   * summation grouping, so the result is not bitwise identical to the serial loop below, but the
+   * stripe count is a fixed constant: for a given mesh the rounding is the same on every machine,
+   * regardless of its thread count. */
+  const int accum_stripes_num = 8;
+  if (numLoops >= 16384) {
+    MeshCalcNormalsAccumData accum_data = {
+        .mloop = mloop,
+        .lnors_weighted = (const float(*)[3])lnors_weighted,
+        .vnors = vnors,
+        .vnors_stripe = MEM_calloc_arrayN(
+            (size_t)accum_stripes_num * (size_t)numVerts, sizeof(float[3]), __func__),
+        .numVerts = numVerts,
+        .numLoops = numLoops,
+        .stripe_len = (numLoops + accum_stripes_num - 1) / accum_stripes_num,
+        .stripes_num = accum_stripes_num,
+    };
+
+    TaskParallelSettings accum_settings;
+    BLI_parallel_range_settings_defaults(&accum_settings);
+    accum_settings.min_iter_per_thread = 1;
+
+    BLI_task_parallel_range(
+        0, accum_stripes_num, &accum_data, mesh_calc_normals_poly_accum_cb, &accum_settings);
+    BLI_task_parallel_range(
+        0, numVerts, &accum_data, mesh_calc_normals_poly_reduce_cb, &settings);
+
+    MEM_freeN(accum_data.vnors_stripe);
+  }
+  else {
+    for (int lidx = 0; lidx < numLoops; lidx++) {
+      add_v3_v3(vnors[mloop[lidx].v], data.lnors_weighted[lidx]);
+    }
   }
 
   /* Normalize and validate computed vertex normals. */
@@ -446,6 +520,8 @@ void BKE_mesh_ensure_normals_for_display(Mesh *mesh)
  * but does update the normals in the CD_MVERT layer. */
 void BKE_mesh_calc_normals(Mesh *mesh)
 {
+  const double eval_stats_time_start = BKE_eval_stats_is_enabled() ? PIL_check_seconds_timer() :
+                                                                     0.0;
 #ifdef DEBUG_TIME
   TIMEIT_START_AVERAGED(BKE_mesh_calc_normals);
 #endif
@@ -461,6 +537,10 @@ void BKE_mesh_calc_normals(Mesh *mesh)
 #ifdef DEBUG_TIME
   TIMEIT_END_AVERAGED(BKE_mesh_calc_normals);
 #endif
+  if (BKE_eval_stats_is_enabled()) {
+    BKE_eval_stats_sample_add("mesh_calc_normals",
+                              PIL_check_seconds_timer() - eval_stats_time_start);
+  }
   mesh->runtime.cd_dirty_vert &= ~CD_MASK_NORMAL;
 }
 
@@ -542,6 +622,36 @@ void BKE_lnor_spacearr_init(MLoopNorSpaceArray *lnors_spacearr,
   lnors_spacearr->data_type = data_type;
 }
 
+/**
+ * Utility for multi-threaded calculation that ensures
+ * `lnors_spacearr_tls` doesn't share memory with `lnors_spacearr`
+ * that would cause it not to be thread safe.
+ *
+ * \note This works as long as threads never operate on the same loops at once.
+ */
+void BKE_lnor_spacearr_tls_init(MLoopNorSpaceArray *lnors_spacearr,
+                                MLoopNorSpaceArray *lnors_spacearr_tls)
+{
+  *lnors_spacearr_tls = *lnors_spacearr;
+  lnors_spacearr_tls->num_spaces = 0;
+  lnors_spacearr_tls->mem = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+}
+
+/**
+ * Utility for multi-threaded calculation
+ * that merges `lnors_spacearr_tls` into `lnors_spacearr`.
+ */
+void BKE_lnor_spacearr_tls_join(MLoopNorSpaceArray *lnors_spacearr,
+                                MLoopNorSpaceArray *lnors_spacearr_tls)
+{
+  BLI_assert(lnors_spacearr->data_type == lnors_spacearr_tls->data_type);
+  BLI_assert(lnors_spacearr->mem != lnors_spacearr_tls->mem);
+  lnors_spacearr->num_spaces += lnors_spacearr_tls->num_spaces;
+  BLI_memarena_merge(lnors_spacearr->mem, lnors_spacearr_tls->mem);
+  BLI_memarena_free(lnors_spacearr_tls->mem);
+  lnors_spacearr_tls->mem = NULL;
+}
+
 void BKE_lnor_spacearr_clear(MLoopNorSpaceArray *lnors_spacearr)
 {
   lnors_spacearr->num_spaces = 0;
@@ -779,8 +889,6 @@ void BKE_lnor_space_custom_normal_to_data(MLoopNorSpace *lnor_space,
 typedef struct LoopSplitTaskData {
   /* Specific to each instance (each task). */
 
-  /** We have to create those outside of tasks, since afaik memarena is not threadsafe. */
-  MLoopNorSpace *lnor_space;
   float (*lnor)[3];
   const MLoop *ml_curr;
   const MLoop *ml_prev;
@@ -802,6 +910,8 @@ typedef struct LoopSplitTaskDataCommon {
    * Note we do not need to protect it, though, since two different tasks will *always* affect
    * different elements in the arrays. */
   MLoopNorSpaceArray *lnors_spacearr;
+  /** Only guards joining the per-worker space arenas back into \a lnors_spacearr. */
+  SpinLock lnors_spacearr_lock;
   float (*loopnors)[3];
   short (*clnors_data)[2];
 
@@ -1025,16 +1135,16 @@ void BKE_mesh_loop_manifold_fan_around_vert_next(const MLoop *mloops,
   /* And now we are back in sync, mlfan_curr_index is the index of mlfan_curr! Pff! */
 }
 
-static void split_loop_nor_single_do(LoopSplitTaskDataCommon *common_data, LoopSplitTaskData *data)
+static void split_loop_nor_single_do(LoopSplitTaskDataCommon *common_data,
+                                     MLoopNorSpaceArray *lnors_spacearr,
+                                     LoopSplitTaskData *data)
 {
-  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
   const short(*clnors_data)[2] = common_data->clnors_data;
 
   const MVert *mverts = common_data->mverts;
   const MEdge *medges = common_data->medges;
   const float(*polynors)[3] = common_data->polynors;
 
-  MLoopNorSpace *lnor_space = data->lnor_space;
   float(*lnor)[3] = data->lnor;
   const MLoop *ml_curr = data->ml_curr;
   const MLoop *ml_prev = data->ml_prev;
@@ -1062,6 +1172,8 @@ static void split_loop_nor_single_do(LoopSplitTaskDataCommon *common_data, LoopS
   if (lnors_spacearr) {
     float vec_curr[3], vec_prev[3];
 
+    MLoopNorSpace *lnor_space = BKE_lnor_space_create(lnors_spacearr);
+
     const unsigned int mv_pivot_index = ml_curr->v; /* The vertex we are "fanning" around! */
     const MVert *mv_pivot = &mverts[mv_pivot_index];
     const MEdge *me_curr = &medges[ml_curr->e];
@@ -1087,9 +1199,10 @@ static void split_loop_nor_single_do(LoopSplitTaskDataCommon *common_data, LoopS
   }
 }
 
-static void split_loop_nor_fan_do(LoopSplitTaskDataCommon *common_data, LoopSplitTaskData *data)
+static void split_loop_nor_fan_do(LoopSplitTaskDataCommon *common_data,
+                                  MLoopNorSpaceArray *lnors_spacearr,
+                                  LoopSplitTaskData *data)
 {
-  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
   float(*loopnors)[3] = common_data->loopnors;
   short(*clnors_data)[2] = common_data->clnors_data;
 
@@ -1101,7 +1214,7 @@ static void split_loop_nor_fan_do(LoopSplitTaskDataCommon *common_data, LoopSpli
   const int *loop_to_poly = common_data->loop_to_poly;
   const float(*polynors)[3] = common_data->polynors;
 
-  MLoopNorSpace *lnor_space = data->lnor_space;
+  MLoopNorSpace *lnor_space = lnors_spacearr ? BKE_lnor_space_create(lnors_spacearr) : NULL;
 #if 0 /* Not needed for 'fan' loops. */
   float(*lnor)[3] = data->lnor;
 #endif
@@ -1301,6 +1414,7 @@ static void split_loop_nor_fan_do(LoopSplitTaskDataCommon *common_data, LoopSpli
 }
 
 static void loop_split_worker_do(LoopSplitTaskDataCommon *common_data,
+                                 MLoopNorSpaceArray *lnors_spacearr,
                                  LoopSplitTaskData *data,
                                  BLI_Stack *edge_vectors)
 {
@@ -1308,11 +1422,11 @@ static void loop_split_worker_do(LoopSplitTaskDataCommon *common_data,
   if (data->e2l_prev) {
     BLI_assert((edge_vectors == NULL) || BLI_stack_is_empty(edge_vectors));
     data->edge_vectors = edge_vectors;
-    split_loop_nor_fan_do(common_data, data);
+    split_loop_nor_fan_do(common_data, lnors_spacearr, data);
   }
   else {
     /* No need for edge_vectors for 'single' case! */
-    split_loop_nor_single_do(common_data, data);
+    split_loop_nor_single_do(common_data, lnors_spacearr, data);
   }
 }
 
@@ -1321,10 +1435,20 @@ static void loop_split_worker(TaskPool *__restrict pool, void *taskdata)
   LoopSplitTaskDataCommon *common_data = BLI_task_pool_user_data(pool);
   LoopSplitTaskData *data = taskdata;
 
+  /* Thread-local spacearr: shares the loop arrays with the common one (two tasks never touch the
+   * same loops), but owns its memarena, so workers allocate their lnor spaces contention-free.
+   * Joined back into the common arena once this task's block is done. */
+  MLoopNorSpaceArray lnors_spacearr_buf = {NULL};
+  MLoopNorSpaceArray *lnors_spacearr = NULL;
+
   /* Temp edge vectors stack, only used when computing lnor spacearr. */
-  BLI_Stack *edge_vectors = common_data->lnors_spacearr ?
-                                BLI_stack_new(sizeof(float[3]), __func__) :
-                                NULL;
+  BLI_Stack *edge_vectors = NULL;
+
+  if (common_data->lnors_spacearr) {
+    lnors_spacearr = &lnors_spacearr_buf;
+    BKE_lnor_spacearr_tls_init(common_data->lnors_spacearr, lnors_spacearr);
+    edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
+  }
 
 #ifdef DEBUG_TIME
   TIMEIT_START_AVERAGED(loop_split_worker);
@@ -1336,10 +1460,16 @@ static void loop_split_worker(TaskPool *__restrict pool, void *taskdata)
       break;
     }
 
-    loop_split_worker_do(common_data, data, edge_vectors);
+    loop_split_worker_do(common_data, lnors_spacearr, data, edge_vectors);
   }
 
-  if (edge_vectors) {
+  if (lnors_spacearr) {
+    /* Fan-in: hand this worker's spaces over to the common arena,
+     * once per task block so the lock is essentially uncontended. */
+    BLI_spin_lock(&common_data->lnors_spacearr_lock);
+    BKE_lnor_spacearr_tls_join(common_data->lnors_spacearr, lnors_spacearr);
+    BLI_spin_unlock(&common_data->lnors_spacearr_lock);
+
     BLI_stack_free(edge_vectors);
   }
 
@@ -1540,9 +1670,6 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
           data->e2l_prev = NULL; /* Tag as 'single' task. */
 #endif
           data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
         }
         /* We *do not need* to check/tag loops as already computed!
          * Due to the fact a loop only links to one of its two edges,
@@ -1563,9 +1690,6 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
           data->ml_prev_index = ml_prev_index;
           data->e2l_prev = e2l_prev; /* Also tag as 'fan' task. */
           data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
         }
 
         if (pool) {
@@ -1576,7 +1700,7 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
           }
         }
         else {
-          loop_split_worker_do(common_data, data, edge_vectors);
+          loop_split_worker_do(common_data, lnors_spacearr, data, edge_vectors);
         }
       }
 
@@ -1720,6 +1844,8 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
     loop_split_generator(NULL, &common_data);
   }
   else {
+    BLI_spin_init(&common_data.lnors_spacearr_lock);
+
     TaskPool *task_pool = BLI_task_pool_create(&common_data, TASK_PRIORITY_HIGH);
 
     loop_split_generator(task_pool, &common_data);
@@ -1727,6 +1853,8 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
     BLI_task_pool_work_and_wait(task_pool);
 
     BLI_task_pool_free(task_pool);
+
+    BLI_spin_end(&common_data.lnors_spacearr_lock);
   }
 
   MEM_freeN(edge_to_loops);
@@ -3234,146 +3362,224 @@ int BKE_mesh_tessface_calc_ex(CustomData *fdata,
 #undef ML_TO_MF_QUAD
 }
 
+/** Polygon count under which full tessellation isn't worth the threading overhead. */
+#define MESH_FACE_TESSELLATE_THREADED_LIMIT 4096
+
 /**
- * Calculate tessellation into #MLoopTri which exist only for this purpose.
+ * Tessellate a single polygon.
+ *
+ * \param mlt: Destination, pointing at this polygon's first triangle
+ * (their position in the array follows from the topology alone,
+ * see #poly_to_tri_count with the polygon's loop-start).
+ * \param pf_arena_p: Lazily initialized arena, shared between calls (only used for ngons).
  */
-void BKE_mesh_recalc_looptri(const MLoop *mloop,
-                             const MPoly *mpoly,
-                             const MVert *mvert,
-                             int totloop,
-                             int totpoly,
-                             MLoopTri *mlooptri)
+BLI_INLINE void mesh_calc_tessellation_for_face(const MLoop *mloop,
+                                                const MPoly *mpoly,
+                                                const MVert *mvert,
+                                                const int poly_index,
+                                                MLoopTri *mlt,
+                                                MemArena **pf_arena_p)
 {
-  /* use this to avoid locking pthread for _every_ polygon
-   * and calling the fill function */
+  const MPoly *mp = &mpoly[poly_index];
+  const unsigned int mp_loopstart = (unsigned int)mp->loopstart;
+  const unsigned int mp_totloop = (unsigned int)mp->totloop;
+  unsigned int l1, l2, l3;
+  unsigned int j;
 
-#define USE_TESSFACE_SPEEDUP
+#define ML_TO_MLT(i1, i2, i3) \
+  { \
+    l1 = mp_loopstart + i1; \
+    l2 = mp_loopstart + i2; \
+    l3 = mp_loopstart + i3; \
+    ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3); \
+    mlt->poly = (unsigned int)poly_index; \
+  } \
+  ((void)0)
+
+  if (mp_totloop < 3) {
+    /* do nothing */
+  }
+  else if (mp_totloop == 3) {
+    ML_TO_MLT(0, 1, 2);
+  }
+  else if (mp_totloop == 4) {
+    ML_TO_MLT(0, 1, 2);
+    MLoopTri *mlt_a = mlt++;
+    ML_TO_MLT(0, 2, 3);
+    MLoopTri *mlt_b = mlt;
+
+    if (UNLIKELY(is_quad_flip_v3_first_third_fast(mvert[mloop[mlt_a->tri[0]].v].co,
+                                                  mvert[mloop[mlt_a->tri[1]].v].co,
+                                                  mvert[mloop[mlt_a->tri[2]].v].co,
+                                                  mvert[mloop[mlt_b->tri[2]].v].co))) {
+      /* flip out of degenerate 0-2 state. */
+      mlt_a->tri[2] = mlt_b->tri[2];
+      mlt_b->tri[0] = mlt_a->tri[1];
+    }
+  }
+  else {
+    const MLoop *ml;
+    const float *co_curr, *co_prev;
 
-  const MPoly *mp;
-  const MLoop *ml;
-  MLoopTri *mlt;
-  MemArena *arena = NULL;
-  int poly_index, mlooptri_index;
-  unsigned int j;
+    float normal[3];
 
-  mlooptri_index = 0;
-  mp = mpoly;
-  for (poly_index = 0; poly_index < totpoly; poly_index++, mp++) {
-    const unsigned int mp_loopstart = (unsigned int)mp->loopstart;
-    const unsigned int mp_totloop = (unsigned int)mp->totloop;
-    unsigned int l1, l2, l3;
-    if (mp_totloop < 3) {
-      /* do nothing */
+    float axis_mat[3][3];
+    float(*projverts)[2];
+    unsigned int(*tris)[3];
+
+    const unsigned int totfilltri = mp_totloop - 2;
+
+    MemArena *pf_arena = *pf_arena_p;
+    if (UNLIKELY(pf_arena == NULL)) {
+      pf_arena = *pf_arena_p = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
     }
 
-#ifdef USE_TESSFACE_SPEEDUP
+    tris = BLI_memarena_alloc(pf_arena, sizeof(*tris) * (size_t)totfilltri);
+    projverts = BLI_memarena_alloc(pf_arena, sizeof(*projverts) * (size_t)mp_totloop);
 
-#  define ML_TO_MLT(i1, i2, i3) \
-    { \
-      mlt = &mlooptri[mlooptri_index]; \
-      l1 = mp_loopstart + i1; \
-      l2 = mp_loopstart + i2; \
-      l3 = mp_loopstart + i3; \
-      ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3); \
-      mlt->poly = (unsigned int)poly_index; \
-    } \
-    ((void)0)
+    zero_v3(normal);
 
-    else if (mp_totloop == 3) {
-      ML_TO_MLT(0, 1, 2);
-      mlooptri_index++;
+    /* calc normal, flipped: to get a positive 2d cross product */
+    ml = mloop + mp_loopstart;
+    co_prev = mvert[ml[mp_totloop - 1].v].co;
+    for (j = 0; j < mp_totloop; j++, ml++) {
+      co_curr = mvert[ml->v].co;
+      add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
+      co_prev = co_curr;
     }
-    else if (mp_totloop == 4) {
-      ML_TO_MLT(0, 1, 2);
-      MLoopTri *mlt_a = mlt;
-      mlooptri_index++;
-      ML_TO_MLT(0, 2, 3);
-      MLoopTri *mlt_b = mlt;
-      mlooptri_index++;
-
-      if (UNLIKELY(is_quad_flip_v3_first_third_fast(mvert[mloop[mlt_a->tri[0]].v].co,
-                                                    mvert[mloop[mlt_a->tri[1]].v].co,
-                                                    mvert[mloop[mlt_a->tri[2]].v].co,
-                                                    mvert[mloop[mlt_b->tri[2]].v].co))) {
-        /* flip out of degenerate 0-2 state. */
-        mlt_a->tri[2] = mlt_b->tri[2];
-        mlt_b->tri[0] = mlt_a->tri[1];
-      }
+    if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
+      normal[2] = 1.0f;
     }
-#endif /* USE_TESSFACE_SPEEDUP */
-    else {
-      const float *co_curr, *co_prev;
 
-      float normal[3];
+    /* project verts to 2d */
+    axis_dominant_v3_to_m3_negate(axis_mat, normal);
 
-      float axis_mat[3][3];
-      float(*projverts)[2];
-      unsigned int(*tris)[3];
+    ml = mloop + mp_loopstart;
+    for (j = 0; j < mp_totloop; j++, ml++) {
+      mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
+    }
 
-      const unsigned int totfilltri = mp_totloop - 2;
+    BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, pf_arena);
 
-      if (UNLIKELY(arena == NULL)) {
-        arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
-      }
+    /* apply fill */
+    for (j = 0; j < totfilltri; j++, mlt++) {
+      unsigned int *tri = tris[j];
 
-      tris = BLI_memarena_alloc(arena, sizeof(*tris) * (size_t)totfilltri);
-      projverts = BLI_memarena_alloc(arena, sizeof(*projverts) * (size_t)mp_totloop);
+      /* set loop indices, transformed to vert indices later */
+      l1 = mp_loopstart + tri[0];
+      l2 = mp_loopstart + tri[1];
+      l3 = mp_loopstart + tri[2];
 
-      zero_v3(normal);
+      ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3);
+      mlt->poly = (unsigned int)poly_index;
+    }
 
-      /* calc normal, flipped: to get a positive 2d cross product */
-      ml = mloop + mp_loopstart;
-      co_prev = mvert[ml[mp_totloop - 1].v].co;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        co_curr = mvert[ml->v].co;
-        add_newell_cross_v3_v3v3(normal, co_prev, co_curr);
-        co_prev = co_curr;
-      }
-      if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
-        normal[2] = 1.0f;
-      }
+    BLI_memarena_clear(pf_arena);
+  }
 
-      /* project verts to 2d */
-      axis_dominant_v3_to_m3_negate(axis_mat, normal);
+#undef ML_TO_MLT
+}
 
-      ml = mloop + mp_loopstart;
-      for (j = 0; j < mp_totloop; j++, ml++) {
-        mul_v2_m3v3(projverts[j], axis_mat, mvert[ml->v].co);
-      }
+typedef struct TessellationUserTLS {
+  MemArena *pf_arena;
+} TessellationUserTLS;
 
-      BLI_polyfill_calc_arena(projverts, mp_totloop, 1, tris, arena);
+typedef struct TessellationUserData {
+  const MLoop *mloop;
+  const MPoly *mpoly;
+  const MVert *mvert;
+  MLoopTri *mlooptri;
+} TessellationUserData;
 
-      /* apply fill */
-      for (j = 0; j < totfilltri; j++) {
-        unsigned int *tri = tris[j];
+static void mesh_calc_tessellation_for_face_fn(void *__restrict userdata,
+                                               const int index,
+                                               const TaskParallelTLS *__restrict tls)
+{
+  const TessellationUserData *data = userdata;
+  TessellationUserTLS *tls_data = tls->userdata_chunk;
+  const int tri_index = poly_to_tri_count(index, data->mpoly[index].loopstart);
+
+  mesh_calc_tessellation_for_face(data->mloop,
+                                  data->mpoly,
+                                  data->mvert,
+                                  index,
+                                  &data->mlooptri[tri_index],
+                                  &tls_data->pf_arena);
+}
 
-        mlt = &mlooptri[mlooptri_index];
+static void mesh_calc_tessellation_for_face_free_fn(const void *__restrict UNUSED(userdata),
+                                                    void *__restrict tls_v)
+{
+  TessellationUserTLS *tls_data = tls_v;
+  if (tls_data->pf_arena) {
+    BLI_memarena_free(tls_data->pf_arena);
+  }
+}
 
-        /* set loop indices, transformed to vert indices later */
-        l1 = mp_loopstart + tri[0];
-        l2 = mp_loopstart + tri[1];
-        l3 = mp_loopstart + tri[2];
+/**
+ * Recalculate tessellation for a range of polygons only.
+ *
+ * A polygon's triangles depend on nothing but its own loops and vertex coordinates,
+ * so when vertices moved while topology is unchanged (deform-only updates),
+ * only the affected range needs recomputing,
+ * see #BKE_mesh_runtime_looptri_update_range.
+ */
+void BKE_mesh_recalc_looptri_range(const MLoop *mloop,
+                                   const MPoly *mpoly,
+                                   const MVert *mvert,
+                                   int totpoly,
+                                   int poly_start,
+                                   int poly_len,
+                                   MLoopTri *mlooptri)
+{
+  MemArena *pf_arena = NULL;
 
-        ARRAY_SET_ITEMS(mlt->tri, l1, l2, l3);
-        mlt->poly = (unsigned int)poly_index;
+  BLI_assert(poly_start >= 0 && poly_len >= 0 && (poly_start + poly_len) <= totpoly);
+  UNUSED_VARS_NDEBUG(totpoly);
 
-        mlooptri_index++;
-      }
+  for (int poly_index = poly_start; poly_index < poly_start + poly_len; poly_index++) {
+    const int tri_index = poly_to_tri_count(poly_index, mpoly[poly_index].loopstart);
+    mesh_calc_tessellation_for_face(mloop, mpoly, mvert, poly_index, &mlooptri[tri_index], &pf_arena);
+  }
 
-      BLI_memarena_clear(arena);
-    }
+  if (pf_arena) {
+    BLI_memarena_free(pf_arena);
   }
+}
 
-  if (arena) {
-    BLI_memarena_free(arena);
-    arena = NULL;
+/**
+ * Calculate tessellation into #MLoopTri which exist only for this purpose.
+ */
+void BKE_mesh_recalc_looptri(const MLoop *mloop,
+                             const MPoly *mpoly,
+                             const MVert *mvert,
+                             int totloop,
+                             int totpoly,
+                             MLoopTri *mlooptri)
+{
+  UNUSED_VARS(totloop);
+
+  if (totpoly < MESH_FACE_TESSELLATE_THREADED_LIMIT) {
+    BKE_mesh_recalc_looptri_range(mloop, mpoly, mvert, totpoly, 0, totpoly, mlooptri);
+    return;
   }
 
-  BLI_assert(mlooptri_index == poly_to_tri_count(totpoly, totloop));
-  UNUSED_VARS_NDEBUG(totloop);
+  TessellationUserTLS tls_data_dummy = {NULL};
 
-#undef USE_TESSFACE_SPEEDUP
-#undef ML_TO_MLT
+  TessellationUserData data = {
+      .mloop = mloop,
+      .mpoly = mpoly,
+      .mvert = mvert,
+      .mlooptri = mlooptri,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &tls_data_dummy;
+  settings.userdata_chunk_size = sizeof(tls_data_dummy);
+  settings.func_free = mesh_calc_tessellation_for_face_free_fn;
+
+  BLI_task_parallel_range(0, totpoly, &data, mesh_calc_tessellation_for_face_fn, &settings);
 }
 
 static void bm_corners_to_loops_ex(ID *id,
@@ -29,6 +29,8 @@
 
 #include "BLI_edgehash.h"
 #include "BLI_ghash.h"
+#include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "BLI_utildefines_stack.h"
 
@@ -206,6 +208,241 @@ static bool poly_gset_compare_fn(const void *k1, const void *k2)
   }
 }
 
+/* Generic utility stuff for merge-by-distance map creation. */
+
+/* Threading the bucketing stages only pays off on reasonably large meshes. */
+#define MERGE_VERTS_PARALLEL_LIMIT 4096
+
+typedef struct MergeVertsCell {
+  int co[3];
+} MergeVertsCell;
+
+typedef struct MergeVertsBucketsData {
+  const MVert *mverts;
+  float cell_size_inv;
+  float merge_dist_sq;
+
+  /** Per-vertex spatial-hash cell coordinates. */
+  MergeVertsCell *cells;
+  /** Maps a cell to the head of its vertex chain (-1 terminated, via #next_in_bucket). */
+  GHash *cell_map;
+  const int *next_in_bucket;
+
+  /** Exclusive offsets of each vertex' pairs within #pairs (counts during the first pass). */
+  uint *pairs_offset;
+  uint (*pairs)[2];
+} MergeVertsBucketsData;
+
+static unsigned int merge_verts_cell_hash_fn(const void *key)
+{
+  const MergeVertsCell *cell = key;
+  /* Classic 3d spatial hash. */
+  return ((unsigned int)cell->co[0] * 73856093u) ^ ((unsigned int)cell->co[1] * 19349663u) ^
+         ((unsigned int)cell->co[2] * 83492791u);
+}
+
+static bool merge_verts_cell_cmp_fn(const void *k1, const void *k2)
+{
+  /* Note: no padding in MergeVertsCell, plain memcmp is fine.
+   * Returns false on equality (GHash convention). */
+  return memcmp(k1, k2, sizeof(MergeVertsCell)) != 0;
+}
+
+static void merge_verts_calc_cells_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MergeVertsBucketsData *data = userdata;
+  const float *co = data->mverts[i].co;
+  MergeVertsCell *cell = &data->cells[i];
+
+  cell->co[0] = (int)floorf(co[0] * data->cell_size_inv);
+  cell->co[1] = (int)floorf(co[1] * data->cell_size_inv);
+  cell->co[2] = (int)floorf(co[2] * data->cell_size_inv);
+}
+
+/**
+ * Scan the 27 cells around vertex \a i for lower-index vertices within merge distance.
+ * When \a r_pairs is NULL only counts the pairs, otherwise writes them.
+ */
+static uint merge_verts_collect_pairs(const MergeVertsBucketsData *data,
+                                      const int i,
+                                      uint (*r_pairs)[2])
+{
+  const MergeVertsCell *cell = &data->cells[i];
+  const float *co = data->mverts[i].co;
+  uint pairs_num = 0;
+  MergeVertsCell key;
+  int x, y, z;
+
+  for (x = -1; x <= 1; x++) {
+    for (y = -1; y <= 1; y++) {
+      for (z = -1; z <= 1; z++) {
+        int j;
+
+        key.co[0] = cell->co[0] + x;
+        key.co[1] = cell->co[1] + y;
+        key.co[2] = cell->co[2] + z;
+
+        j = POINTER_AS_INT(BLI_ghash_lookup_default(data->cell_map, &key, POINTER_FROM_INT(-1)));
+        for (; j != -1; j = data->next_in_bucket[j]) {
+          if ((j < i) && (len_squared_v3v3(co, data->mverts[j].co) <= data->merge_dist_sq)) {
+            if (r_pairs) {
+              r_pairs[pairs_num][0] = (uint)j;
+              r_pairs[pairs_num][1] = (uint)i;
+            }
+            pairs_num++;
+          }
+        }
+      }
+    }
+  }
+
+  return pairs_num;
+}
+
+static void merge_verts_count_pairs_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MergeVertsBucketsData *data = userdata;
+  data->pairs_offset[i + 1] = merge_verts_collect_pairs(data, i, NULL);
+}
+
+static void merge_verts_fill_pairs_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MergeVertsBucketsData *data = userdata;
+  merge_verts_collect_pairs(data, i, data->pairs + data->pairs_offset[i]);
+}
+
+static int merge_verts_find_root(int *parent, int v)
+{
+  int root = v;
+  while (parent[root] != root) {
+    root = parent[root];
+  }
+  /* Compress the path for later lookups. */
+  while (parent[v] != root) {
+    const int v_next = parent[v];
+    parent[v] = root;
+    v = v_next;
+  }
+  return root;
+}
+
+/**
+ * Compute a merge-by-distance vertex target map, usable by #BKE_mesh_merge_verts.
+ *
+ * Verts are bucketed in a spatial hash (in parallel), then connected components of the
+ * 'closer than \a merge_dist' relation are merged with a union-find,
+ * each vertex mapping to the lowest index of its component.
+ *
+ * \param r_vtargetmap: The computed map, aligned with \a totvert, to be freed by the caller.
+ * A value of -1 means the vertex is kept (it is a merge target or is not merged at all).
+ * The map is guaranteed not to contain any chained mapping (v1 -> v2 -> v3 etc.).
+ * \return The number of mapped (i.e. merged away) vertices.
+ */
+int BKE_mesh_merge_verts_map_create_by_distance(const MVert *mverts,
+                                                const int totvert,
+                                                const float merge_dist,
+                                                int **r_vtargetmap)
+{
+  int *vtargetmap = MEM_malloc_arrayN(totvert, sizeof(*vtargetmap), __func__);
+  int *next_in_bucket = MEM_malloc_arrayN(totvert, sizeof(*next_in_bucket), __func__);
+  uint *pairs_offset = MEM_malloc_arrayN((size_t)totvert + 1, sizeof(*pairs_offset), __func__);
+  int *parent;
+  uint pairs_num;
+  int tot_vtargetmap = 0;
+  int i;
+
+  MergeVertsBucketsData data = {
+      .mverts = mverts,
+      .cell_size_inv = 1.0f / max_ff(merge_dist, FLT_EPSILON),
+      .merge_dist_sq = merge_dist * merge_dist,
+      .cells = MEM_malloc_arrayN(totvert, sizeof(MergeVertsCell), __func__),
+      .next_in_bucket = next_in_bucket,
+      .pairs_offset = pairs_offset,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (totvert > MERGE_VERTS_PARALLEL_LIMIT);
+
+  BLI_task_parallel_range(0, totvert, &data, merge_verts_calc_cells_cb, &settings);
+
+  /* Build per-cell vertex chains, each vertex pushed at the head of its cell's chain. */
+  data.cell_map = BLI_ghash_new_ex(
+      merge_verts_cell_hash_fn, merge_verts_cell_cmp_fn, __func__, totvert);
+  for (i = 0; i < totvert; i++) {
+    void **val_p;
+    if (BLI_ghash_ensure_p(data.cell_map, &data.cells[i], &val_p)) {
+      next_in_bucket[i] = POINTER_AS_INT(*val_p);
+    }
+    else {
+      next_in_bucket[i] = -1;
+    }
+    *val_p = POINTER_FROM_INT(i);
+  }
+
+  /* Collect all 'closer than merge_dist' vertex pairs,
+   * counting first so that the filling pass can run fully in parallel. */
+  pairs_offset[0] = 0;
+  BLI_task_parallel_range(0, totvert, &data, merge_verts_count_pairs_cb, &settings);
+  for (i = 0; i < totvert; i++) {
+    pairs_offset[i + 1] += pairs_offset[i];
+  }
+  pairs_num = pairs_offset[totvert];
+
+  if (pairs_num != 0) {
+    data.pairs = MEM_malloc_arrayN(pairs_num, sizeof(*data.pairs), __func__);
+    BLI_task_parallel_range(0, totvert, &data, merge_verts_fill_pairs_cb, &settings);
+  }
+
+  /* Union-find merge, the lowest index of each component becomes the merge target. */
+  parent = vtargetmap; /* Reused as parent array, flattened into the final map below. */
+  for (i = 0; i < totvert; i++) {
+    parent[i] = i;
+  }
+  for (uint p = 0; p < pairs_num; p++) {
+    const int root_a = merge_verts_find_root(parent, (int)data.pairs[p][0]);
+    const int root_b = merge_verts_find_root(parent, (int)data.pairs[p][1]);
+    if (root_a != root_b) {
+      if (root_a < root_b) {
+        parent[root_b] = root_a;
+      }
+      else {
+        parent[root_a] = root_b;
+      }
+    }
+  }
+  /* Flatten all paths first, only then tag the roots as -1
+   * (would confuse #merge_verts_find_root otherwise). */
+  for (i = 0; i < totvert; i++) {
+    merge_verts_find_root(parent, i);
+  }
+  for (i = 0; i < totvert; i++) {
+    if (vtargetmap[i] != i) {
+      tot_vtargetmap++;
+    }
+    else {
+      vtargetmap[i] = -1;
+    }
+  }
+
+  if (data.pairs != NULL) {
+    MEM_freeN(data.pairs);
+  }
+  BLI_ghash_free(data.cell_map, NULL, NULL);
+  MEM_freeN(pairs_offset);
+  MEM_freeN(next_in_bucket);
+  MEM_freeN(data.cells);
+
+  *r_vtargetmap = vtargetmap;
+  return tot_vtargetmap;
+}
+
 /**
  * Merge Verts
  *
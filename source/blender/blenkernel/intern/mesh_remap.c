@@ -36,6 +36,8 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_bvhutils.h"
@@ -493,6 +495,194 @@ typedef struct IslandResult {
 /* Will be enough in 99% of cases. */
 #define MREMAP_DEFAULT_BUFSIZE 32
 
+/* Threading a mapping only pays off once there are enough destination elements,
+ * BVH queries on small meshes are cheap. */
+#define MREMAP_PARALLEL_LIMIT 4096
+
+typedef struct MeshRemapVertsData {
+  int mode;
+  const SpaceTransform *space_transform;
+  float max_dist;
+  float max_dist_sq;
+  float ray_radius;
+
+  const MVert *verts_dst;
+
+  const MEdge *edges_src;
+  MPoly *polys_src;
+  MLoop *loops_src;
+  const float (*vcos_src)[3];
+
+  BVHTreeFromMesh *treedata;
+
+  MeshPairRemap *r_map;
+  /** Protects #mesh_remap_item_define, the mapping memarena is not thread-safe. */
+  SpinLock map_lock;
+} MeshRemapVertsData;
+
+typedef struct MeshRemapVertsTLS {
+  BVHTreeNearest nearest;
+  BVHTreeRayHit rayhit;
+  /* Buffers for #mesh_remap_interp_poly_data_get, lazily allocated. */
+  size_t buff_size;
+  float (*vcos)[3];
+  int *indices;
+  float *weights;
+} MeshRemapVertsTLS;
+
+static void mesh_remap_calc_verts_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  MeshRemapVertsData *data = userdata;
+  MeshRemapVertsTLS *tls_data = tls->userdata_chunk;
+  BVHTreeFromMesh *treedata = data->treedata;
+  const float full_weight = 1.0f;
+  float tmp_co[3], tmp_no[3];
+  float hit_dist = FLT_MAX;
+
+  int sources_num = 0;
+  int index_buf[2];
+  float weight_buf[2];
+  const int *indices = NULL;
+  const float *weights = NULL;
+
+  copy_v3_v3(tmp_co, data->verts_dst[i].co);
+
+  /* Convert the vertex to tree coordinates, if needed. */
+  if (data->space_transform) {
+    BLI_space_transform_apply(data->space_transform, tmp_co);
+  }
+
+  if (data->mode == MREMAP_MODE_VERT_NEAREST) {
+    if (mesh_remap_bvhtree_query_nearest(
+            treedata, &tls_data->nearest, tmp_co, data->max_dist_sq, &hit_dist)) {
+      index_buf[0] = tls_data->nearest.index;
+      weight_buf[0] = full_weight;
+      sources_num = 1;
+      indices = index_buf;
+      weights = weight_buf;
+    }
+  }
+  else if (ELEM(data->mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
+    if (mesh_remap_bvhtree_query_nearest(
+            treedata, &tls_data->nearest, tmp_co, data->max_dist_sq, &hit_dist)) {
+      const MEdge *me = &data->edges_src[tls_data->nearest.index];
+      const float *v1cos = data->vcos_src[me->v1];
+      const float *v2cos = data->vcos_src[me->v2];
+
+      if (data->mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
+        const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
+        const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
+        index_buf[0] = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
+        weight_buf[0] = full_weight;
+        sources_num = 1;
+      }
+      else {
+        index_buf[0] = (int)me->v1;
+        index_buf[1] = (int)me->v2;
+
+        /* Weight is inverse of point factor here... */
+        weight_buf[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
+        CLAMP(weight_buf[0], 0.0f, 1.0f);
+        weight_buf[1] = 1.0f - weight_buf[0];
+        sources_num = 2;
+      }
+      indices = index_buf;
+      weights = weight_buf;
+    }
+  }
+  else if (data->mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
+    normal_short_to_float_v3(tmp_no, data->verts_dst[i].no);
+    if (data->space_transform) {
+      BLI_space_transform_apply_normal(data->space_transform, tmp_no);
+    }
+
+    if (mesh_remap_bvhtree_query_raycast(treedata,
+                                         &tls_data->rayhit,
+                                         tmp_co,
+                                         tmp_no,
+                                         data->ray_radius,
+                                         data->max_dist,
+                                         &hit_dist)) {
+      const MLoopTri *lt = &treedata->looptri[tls_data->rayhit.index];
+      MPoly *mp_src = &data->polys_src[lt->poly];
+      sources_num = mesh_remap_interp_poly_data_get(mp_src,
+                                                    data->loops_src,
+                                                    data->vcos_src,
+                                                    tls_data->rayhit.co,
+                                                    &tls_data->buff_size,
+                                                    &tls_data->vcos,
+                                                    false,
+                                                    &tls_data->indices,
+                                                    &tls_data->weights,
+                                                    true,
+                                                    NULL);
+      indices = tls_data->indices;
+      weights = tls_data->weights;
+    }
+  }
+  else { /* #MREMAP_MODE_VERT_POLY_NEAREST or #MREMAP_MODE_VERT_POLYINTERP_NEAREST. */
+    if (mesh_remap_bvhtree_query_nearest(
+            treedata, &tls_data->nearest, tmp_co, data->max_dist_sq, &hit_dist)) {
+      const MLoopTri *lt = &treedata->looptri[tls_data->nearest.index];
+      MPoly *mp = &data->polys_src[lt->poly];
+
+      if (data->mode == MREMAP_MODE_VERT_POLY_NEAREST) {
+        mesh_remap_interp_poly_data_get(mp,
+                                        data->loops_src,
+                                        data->vcos_src,
+                                        tls_data->nearest.co,
+                                        &tls_data->buff_size,
+                                        &tls_data->vcos,
+                                        false,
+                                        &tls_data->indices,
+                                        &tls_data->weights,
+                                        false,
+                                        &index_buf[0]);
+        weight_buf[0] = full_weight;
+        sources_num = 1;
+        indices = index_buf;
+        weights = weight_buf;
+      }
+      else {
+        sources_num = mesh_remap_interp_poly_data_get(mp,
+                                                      data->loops_src,
+                                                      data->vcos_src,
+                                                      tls_data->nearest.co,
+                                                      &tls_data->buff_size,
+                                                      &tls_data->vcos,
+                                                      false,
+                                                      &tls_data->indices,
+                                                      &tls_data->weights,
+                                                      true,
+                                                      NULL);
+        indices = tls_data->indices;
+        weights = tls_data->weights;
+      }
+    }
+  }
+
+  BLI_spin_lock(&data->map_lock);
+  if (sources_num) {
+    mesh_remap_item_define(data->r_map, i, hit_dist, 0, sources_num, indices, weights);
+  }
+  else {
+    /* No source for this dest vertex! */
+    BKE_mesh_remap_item_define_invalid(data->r_map, i);
+  }
+  BLI_spin_unlock(&data->map_lock);
+}
+
+static void mesh_remap_calc_verts_free_cb(const void *__restrict UNUSED(userdata),
+                                          void *__restrict chunk)
+{
+  MeshRemapVertsTLS *tls_data = chunk;
+  MEM_SAFE_FREE(tls_data->vcos);
+  MEM_SAFE_FREE(tls_data->indices);
+  MEM_SAFE_FREE(tls_data->weights);
+}
+
 void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
                                          const SpaceTransform *space_transform,
                                          const float max_dist,
@@ -519,198 +709,66 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
   }
   else {
     BVHTreeFromMesh treedata = {NULL};
-    BVHTreeNearest nearest = {0};
-    BVHTreeRayHit rayhit = {0};
-    float hit_dist;
-    float tmp_co[3], tmp_no[3];
+    float(*vcos_src)[3] = NULL;
+    bool is_valid_mode = true;
+
+    MeshRemapVertsData data = {
+        .mode = mode,
+        .space_transform = space_transform,
+        .max_dist = max_dist,
+        .max_dist_sq = max_dist_sq,
+        .ray_radius = ray_radius,
+        .verts_dst = verts_dst,
+        .treedata = &treedata,
+        .r_map = r_map,
+    };
 
     if (mode == MREMAP_MODE_VERT_NEAREST) {
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
     }
     else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
-      MEdge *edges_src = me_src->medge;
-      float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
+      vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
+      data.edges_src = me_src->medge;
+      data.vcos_src = (const float(*)[3])vcos_src;
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          MEdge *me = &edges_src[nearest.index];
-          const float *v1cos = vcos_src[me->v1];
-          const float *v2cos = vcos_src[me->v2];
-
-          if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
-            const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
-            const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
-            const int index = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-          }
-          else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
-            int indices[2];
-            float weights[2];
-
-            indices[0] = (int)me->v1;
-            indices[1] = (int)me->v2;
-
-            /* Weight is inverse of point factor here... */
-            weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
-            CLAMP(weights[0], 0.0f, 1.0f);
-            weights[1] = 1.0f - weights[0];
-
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 2, indices, weights);
-          }
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-
-      MEM_freeN(vcos_src);
     }
     else if (ELEM(mode,
                   MREMAP_MODE_VERT_POLY_NEAREST,
                   MREMAP_MODE_VERT_POLYINTERP_NEAREST,
                   MREMAP_MODE_VERT_POLYINTERP_VNORPROJ)) {
-      MPoly *polys_src = me_src->mpoly;
-      MLoop *loops_src = me_src->mloop;
-      float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
-
-      size_t tmp_buff_size = MREMAP_DEFAULT_BUFSIZE;
-      float(*vcos)[3] = MEM_mallocN(sizeof(*vcos) * tmp_buff_size, __func__);
-      int *indices = MEM_mallocN(sizeof(*indices) * tmp_buff_size, __func__);
-      float *weights = MEM_mallocN(sizeof(*weights) * tmp_buff_size, __func__);
+      vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
+      data.polys_src = me_src->mpoly;
+      data.loops_src = me_src->mloop;
+      data.vcos_src = (const float(*)[3])vcos_src;
 
       BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
+    }
+    else {
+      CLOG_WARN(&LOG, "Unsupported mesh-to-mesh vertex mapping mode (%d)!", mode);
+      memset(r_map->items, 0, sizeof(*r_map->items) * (size_t)numverts_dst);
+      is_valid_mode = false;
+    }
 
-      if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
-          normal_short_to_float_v3(tmp_no, verts_dst[i].no);
-
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-            BLI_space_transform_apply_normal(space_transform, tmp_no);
-          }
-
-          if (mesh_remap_bvhtree_query_raycast(
-                  &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[rayhit.index];
-            MPoly *mp_src = &polys_src[lt->poly];
-            const int sources_num = mesh_remap_interp_poly_data_get(mp_src,
-                                                                    loops_src,
-                                                                    (const float(*)[3])vcos_src,
-                                                                    rayhit.co,
-                                                                    &tmp_buff_size,
-                                                                    &vcos,
-                                                                    false,
-                                                                    &indices,
-                                                                    &weights,
-                                                                    true,
-                                                                    NULL);
-
-            mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
-          }
-        }
-      }
-      else {
-        nearest.index = -1;
-
-        for (i = 0; i < numverts_dst; i++) {
-          copy_v3_v3(tmp_co, verts_dst[i].co);
+    if (is_valid_mode) {
+      MeshRemapVertsTLS tls_data = {.nearest = {.index = -1}};
 
-          /* Convert the vertex to tree coordinates, if needed. */
-          if (space_transform) {
-            BLI_space_transform_apply(space_transform, tmp_co);
-          }
+      BLI_spin_init(&data.map_lock);
 
-          if (mesh_remap_bvhtree_query_nearest(
-                  &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-            const MLoopTri *lt = &treedata.looptri[nearest.index];
-            MPoly *mp = &polys_src[lt->poly];
-
-            if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
-              int index;
-              mesh_remap_interp_poly_data_get(mp,
-                                              loops_src,
-                                              (const float(*)[3])vcos_src,
-                                              nearest.co,
-                                              &tmp_buff_size,
-                                              &vcos,
-                                              false,
-                                              &indices,
-                                              &weights,
-                                              false,
-                                              &index);
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (numverts_dst > MREMAP_PARALLEL_LIMIT);
+      settings.userdata_chunk = &tls_data;
+      settings.userdata_chunk_size = sizeof(tls_data);
+      settings.func_free = mesh_remap_calc_verts_free_cb;
+      BLI_task_parallel_range(0, numverts_dst, &data, mesh_remap_calc_verts_cb, &settings);
 
-              mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-            }
-            else if (mode == MREMAP_MODE_VERT_POLYINTERP_NEAREST) {
-              const int sources_num = mesh_remap_interp_poly_data_get(mp,
-                                                                      loops_src,
-                                                                      (const float(*)[3])vcos_src,
-                                                                      nearest.co,
-                                                                      &tmp_buff_size,
-                                                                      &vcos,
-                                                                      false,
-                                                                      &indices,
-                                                                      &weights,
-                                                                      true,
-                                                                      NULL);
-
-              mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-            }
-          }
-          else {
-            /* No source for this dest vertex! */
-            BKE_mesh_remap_item_define_invalid(r_map, i);
-          }
-        }
-      }
+      BLI_spin_end(&data.map_lock);
+    }
 
+    if (vcos_src) {
       MEM_freeN(vcos_src);
-      MEM_freeN(vcos);
-      MEM_freeN(indices);
-      MEM_freeN(weights);
     }
-    else {
-      CLOG_WARN(&LOG, "Unsupported mesh-to-mesh vertex mapping mode (%d)!", mode);
-      memset(r_map->items, 0, sizeof(*r_map->items) * (size_t)numverts_dst);
-    }
-
     free_bvhtree_from_mesh(&treedata);
   }
 }
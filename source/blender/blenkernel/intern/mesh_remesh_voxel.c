@@ -32,6 +32,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_mesh_types.h"
@@ -57,6 +58,44 @@
 #endif
 
 #ifdef WITH_OPENVDB
+/* Gathering the mesh into the flat arrays the OpenVDB converter wants, and copying its output
+ * back, can be a noticeable part of the remesh time on dense sculpts, so those copies are
+ * threaded (the level set conversion itself is already parallel inside OpenVDB). */
+typedef struct VoxelRemeshCopyData {
+  const Mesh *mesh;
+  const MVertTri *verttri;
+  float *verts;
+  unsigned int *faces;
+  const float *vertices_out;
+} VoxelRemeshCopyData;
+
+static void remesh_voxel_gather_verts_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VoxelRemeshCopyData *data = userdata;
+  copy_v3_v3(&data->verts[i * 3], data->mesh->mvert[i].co);
+}
+
+static void remesh_voxel_gather_faces_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VoxelRemeshCopyData *data = userdata;
+  const MVertTri *vt = &data->verttri[i];
+  data->faces[i * 3] = vt->tri[0];
+  data->faces[i * 3 + 1] = vt->tri[1];
+  data->faces[i * 3 + 2] = vt->tri[2];
+}
+
+static void remesh_voxel_copy_verts_out_cb(void *__restrict userdata,
+                                           const int i,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VoxelRemeshCopyData *data = userdata;
+  copy_v3_v3(data->mesh->mvert[i].co, &data->vertices_out[i * 3]);
+}
+
 struct OpenVDBLevelSet *BKE_mesh_remesh_voxel_ovdb_mesh_to_level_set_create(
     Mesh *mesh, struct OpenVDBTransform *transform)
 {
@@ -73,19 +112,17 @@ struct OpenVDBLevelSet *BKE_mesh_remesh_voxel_ovdb_mesh_to_level_set_create(
   unsigned int *faces = (unsigned int *)MEM_malloc_arrayN(
       totfaces * 3, sizeof(unsigned int), "remesh_intput_faces");
 
-  for (unsigned int i = 0; i < totverts; i++) {
-    MVert *mvert = &mesh->mvert[i];
-    verts[i * 3] = mvert->co[0];
-    verts[i * 3 + 1] = mvert->co[1];
-    verts[i * 3 + 2] = mvert->co[2];
-  }
+  VoxelRemeshCopyData data = {
+      .mesh = mesh,
+      .verttri = verttri,
+      .verts = verts,
+      .faces = faces,
+  };
 
-  for (unsigned int i = 0; i < totfaces; i++) {
-    MVertTri *vt = &verttri[i];
-    faces[i * 3] = vt->tri[0];
-    faces[i * 3 + 1] = vt->tri[1];
-    faces[i * 3 + 2] = vt->tri[2];
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, (int)totverts, &data, remesh_voxel_gather_verts_cb, &settings);
+  BLI_task_parallel_range(0, (int)totfaces, &data, remesh_voxel_gather_faces_cb, &settings);
 
   struct OpenVDBLevelSet *level_set = OpenVDBLevelSet_create(false, NULL);
   OpenVDBLevelSet_mesh_to_level_set(level_set, verts, faces, totverts, totfaces, transform);
@@ -114,8 +151,15 @@ Mesh *BKE_mesh_remesh_voxel_ovdb_volume_to_mesh_nomain(struct OpenVDBLevelSet *l
                                    (output_mesh.totquads * 4) + (output_mesh.tottriangles * 3),
                                    output_mesh.totquads + output_mesh.tottriangles);
 
-  for (int i = 0; i < output_mesh.totvertices; i++) {
-    copy_v3_v3(mesh->mvert[i].co, &output_mesh.vertices[i * 3]);
+  {
+    VoxelRemeshCopyData data = {
+        .mesh = mesh,
+        .vertices_out = output_mesh.vertices,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(
+        0, output_mesh.totvertices, &data, remesh_voxel_copy_verts_out_cb, &settings);
   }
 
   MPoly *mp = mesh->mpoly;
@@ -146,6 +146,29 @@ void BKE_mesh_runtime_looptri_recalc(Mesh *mesh)
   mesh->runtime.looptris.array_wip = NULL;
 }
 
+/**
+ * Update the looptri cache in place for a range of polygons whose vertex coordinates
+ * changed, instead of tagging the whole cache dirty and recomputing it from scratch.
+ * A no-op when the cache isn't computed yet (the next ensure computes it in full).
+ *
+ * \warning Only valid while the mesh topology is unchanged (deform-only updates).
+ */
+void BKE_mesh_runtime_looptri_update_range(Mesh *mesh, int poly_start, int poly_len)
+{
+  BLI_rw_mutex_lock(&loops_cache_lock, THREAD_LOCK_WRITE);
+  if (mesh->runtime.looptris.array != NULL) {
+    BLI_assert(mesh->runtime.looptris.len == poly_to_tri_count(mesh->totpoly, mesh->totloop));
+    BKE_mesh_recalc_looptri_range(mesh->mloop,
+                                  mesh->mpoly,
+                                  mesh->mvert,
+                                  mesh->totpoly,
+                                  poly_start,
+                                  poly_len,
+                                  mesh->runtime.looptris.array);
+  }
+  BLI_rw_mutex_unlock(&loops_cache_lock);
+}
+
 /* This is a ported copy of dm_getNumLoopTri(dm). */
 int BKE_mesh_runtime_looptri_len(const Mesh *mesh)
 {
@@ -29,6 +29,7 @@
 #include "DNA_scene_types.h"
 
 #include "BKE_customdata.h"
+#include "BKE_eval_stats.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
 #include "BKE_mesh_runtime.h"
@@ -40,6 +41,8 @@
 
 #include "DEG_depsgraph_query.h"
 
+#include "PIL_time.h"
+
 #include "multires_reshape.h"
 
 /* -------------------------------------------------------------------- */
@@ -52,6 +55,8 @@ bool multiresModifier_reshapeFromVertcos(struct Depsgraph *depsgraph,
                                          const float (*vert_coords)[3],
                                          const int num_vert_coords)
 {
+  const double eval_stats_time_start = BKE_eval_stats_is_enabled() ? PIL_check_seconds_timer() :
+                                                                     0.0;
   MultiresReshapeContext reshape_context;
   if (!multires_reshape_context_create_from_object(&reshape_context, depsgraph, object, mmd)) {
     return false;
@@ -66,6 +71,10 @@ bool multiresModifier_reshapeFromVertcos(struct Depsgraph *depsgraph,
   multires_reshape_smooth_object_grids_with_details(&reshape_context);
   multires_reshape_object_grids_to_tangent_displacement(&reshape_context);
   multires_reshape_context_free(&reshape_context);
+  if (BKE_eval_stats_is_enabled()) {
+    BKE_eval_stats_sample_add("multires_reshape",
+                              PIL_check_seconds_timer() - eval_stats_time_start);
+  }
   return true;
 }
 
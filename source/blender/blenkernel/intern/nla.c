@@ -97,6 +97,9 @@ void BKE_nlastrip_free(ListBase *strips, NlaStrip *strip, bool do_id_user)
   /* free own F-Modifiers */
   free_fmodifiers(&strip->modifiers);
 
+  /* free runtime evaluation cache */
+  MEM_SAFE_FREE(strip->cache);
+
   /* free the strip itself */
   if (strips) {
     BLI_freelinkN(strips, strip);
@@ -183,6 +186,9 @@ NlaStrip *BKE_nlastrip_copy(Main *bmain,
   strip_d = MEM_dupallocN(strip);
   strip_d->next = strip_d->prev = NULL;
 
+  /* evaluation cache is never shared between copies */
+  strip_d->cache = NULL;
+
   /* handle action */
   if (strip_d->act) {
     if (use_same_action) {
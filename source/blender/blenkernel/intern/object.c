@@ -73,6 +73,7 @@
 #include "BKE_anim_visualization.h"
 #include "BKE_animsys.h"
 #include "BKE_armature.h"
+#include "BKE_bvhutils.h"
 #include "BKE_camera.h"
 #include "BKE_collection.h"
 #include "BKE_constraint.h"
@@ -291,6 +292,12 @@ static void object_free_data(ID *id)
   MEM_SAFE_FREE(ob->iuser);
   MEM_SAFE_FREE(ob->runtime.bb);
 
+  /* Freeing the modifiers above stashes the BVH trees of the evaluated mesh again. */
+  if (ob->runtime.bvh_cache_stash != NULL) {
+    bvhcache_free(ob->runtime.bvh_cache_stash);
+    ob->runtime.bvh_cache_stash = NULL;
+  }
+
   BLI_freelistN(&ob->defbase);
   BLI_freelistN(&ob->fmaps);
   if (ob->pose) {
@@ -887,7 +894,16 @@ void BKE_object_free_derived_caches(Object *ob)
     if (ob->runtime.is_data_eval_owned) {
       ID *data_eval = ob->runtime.data_eval;
       if (GS(data_eval->name) == ID_ME) {
-        BKE_mesh_eval_delete((Mesh *)data_eval);
+        Mesh *mesh_eval = (Mesh *)data_eval;
+        /* Keep the BVH trees of the evaluated mesh around, the next evaluation refits them
+         * onto its result when the topology still matches (see #mesh_build_data),
+         * which is much cheaper than a full rebuild for deform-only changes. */
+        if (ob->runtime.bvh_cache_stash != NULL) {
+          bvhcache_free(ob->runtime.bvh_cache_stash);
+        }
+        ob->runtime.bvh_cache_stash = mesh_eval->runtime.bvh_cache;
+        mesh_eval->runtime.bvh_cache = NULL;
+        BKE_mesh_eval_delete(mesh_eval);
       }
       else {
         BKE_libblock_free_datablock(data_eval, 0);
@@ -4282,6 +4298,7 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int UNUSED(flag))
   Object_Runtime *runtime = &object->runtime;
   runtime->data_eval = NULL;
   runtime->mesh_deform_eval = NULL;
+  runtime->bvh_cache_stash = NULL;
   runtime->curve_cache = NULL;
 }
 
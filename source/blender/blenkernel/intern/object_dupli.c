@@ -28,6 +28,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_memarena.h"
 #include "BLI_string_utf8.h"
 
 #include "BLI_math.h"
@@ -63,6 +64,20 @@
 
 /* Dupli-Geometry */
 
+typedef struct DupliListStore {
+  /** Must be the first member, the public API hands out a #ListBase pointer
+   * (see #object_duplilist and #free_object_duplilist). */
+  ListBase duplilist;
+  /** All #DupliObject entries are allocated here, freed in one go with the list,
+   * a huge number of small individual allocations is too slow for dense instancing. */
+  struct MemArena *arena;
+
+  /** Name hash of the last instanced object, instancers like particle systems
+   * create many duplis of the same object in a row, no point re-hashing the name. */
+  Object *name_hash_ob;
+  unsigned int name_hash;
+} DupliListStore;
+
 typedef struct DupliContext {
   Depsgraph *depsgraph;
   /** XXX child objects are selected from this group if set, could be nicer. */
@@ -80,8 +95,11 @@ typedef struct DupliContext {
 
   const struct DupliGenerator *gen;
 
-  /** Result containers. */
-  ListBase *duplilist; /* legacy doubly-linked list */
+  /** Hash of the instancing object name, every dupli of this context XORs it in. */
+  unsigned int object_name_hash;
+
+  /** Result container. */
+  DupliListStore *store;
 } DupliContext;
 
 typedef struct DupliGenerator {
@@ -115,7 +133,9 @@ static void init_context(DupliContext *r_ctx,
 
   r_ctx->gen = get_dupli_generator(r_ctx);
 
-  r_ctx->duplilist = NULL;
+  r_ctx->object_name_hash = BLI_hash_int(BLI_hash_string(ob->id.name + 2));
+
+  r_ctx->store = NULL;
 }
 
 /* create sub-context for recursive duplis */
@@ -131,6 +151,9 @@ static void copy_dupli_context(
   }
 
   r_ctx->object = ob;
+  if (ob != ctx->object) {
+    r_ctx->object_name_hash = BLI_hash_int(BLI_hash_string(ob->id.name + 2));
+  }
   if (mat) {
     mul_m4_m4m4(r_ctx->space_mat, (float(*)[4])ctx->space_mat, mat);
   }
@@ -145,13 +168,14 @@ static void copy_dupli_context(
  */
 static DupliObject *make_dupli(const DupliContext *ctx, Object *ob, float mat[4][4], int index)
 {
+  DupliListStore *store = ctx->store;
   DupliObject *dob;
   int i;
 
   /* add a DupliObject instance to the result container */
-  if (ctx->duplilist) {
-    dob = MEM_callocN(sizeof(DupliObject), "dupli object");
-    BLI_addtail(ctx->duplilist, dob);
+  if (store) {
+    dob = BLI_memarena_calloc(store->arena, sizeof(DupliObject));
+    BLI_addtail(&store->duplilist, dob);
   }
   else {
     return NULL;
@@ -183,7 +207,11 @@ static DupliObject *make_dupli(const DupliContext *ctx, Object *ob, float mat[4]
 
   /* random number */
   /* the logic here is designed to match Cycles */
-  dob->random_id = BLI_hash_string(dob->ob->id.name + 2);
+  if (store->name_hash_ob != ob) {
+    store->name_hash_ob = ob;
+    store->name_hash = BLI_hash_string(ob->id.name + 2);
+  }
+  dob->random_id = store->name_hash;
 
   if (dob->persistent_id[0] != INT_MAX) {
     for (i = 0; i < MAX_DUPLI_RECUR * 2; i++) {
@@ -195,7 +223,7 @@ static DupliObject *make_dupli(const DupliContext *ctx, Object *ob, float mat[4]
   }
 
   if (ctx->object != ob) {
-    dob->random_id ^= BLI_hash_int(BLI_hash_string(ctx->object->id.name + 2));
+    dob->random_id ^= ctx->object_name_hash;
   }
 
   return dob;
@@ -1123,19 +1151,24 @@ static const DupliGenerator *get_dupli_generator(const DupliContext *ctx)
 /* Returns a list of DupliObject */
 ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
 {
-  ListBase *duplilist = MEM_callocN(sizeof(ListBase), "duplilist");
+  DupliListStore *store = MEM_callocN(sizeof(DupliListStore), "duplilist");
+  store->arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+
   DupliContext ctx;
   init_context(&ctx, depsgraph, sce, ob, NULL);
   if (ctx.gen) {
-    ctx.duplilist = duplilist;
+    ctx.store = store;
     ctx.gen->make_duplis(&ctx);
   }
 
-  return duplilist;
+  return &store->duplilist;
 }
 
 void free_object_duplilist(ListBase *lb)
 {
-  BLI_freelistN(lb);
-  MEM_freeN(lb);
+  /* The list is the first member of the store allocated in #object_duplilist. */
+  DupliListStore *store = (DupliListStore *)lb;
+
+  BLI_memarena_free(store->arena);
+  MEM_freeN(store);
 }
@@ -764,6 +764,74 @@ bool BKE_ocean_ensure(struct OceanModifierData *omd)
   return true;
 }
 
+typedef struct OceanInitSpectrumData {
+  Ocean *o;
+  int seed;
+} OceanInitSpectrumData;
+
+static void ocean_compute_spectrum_row(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  OceanInitSpectrumData *data = userdata;
+  Ocean *o = data->o;
+  /* The RNG is reseeded for every texel below, so rows are independent,
+   * a row-local RNG gives results identical to the serial loop. */
+  RNG *rng = BLI_rng_new(data->seed);
+  int j;
+
+  for (j = 0; j < o->_N; j++) {
+    /* This ensures we get a value tied to the surface location, avoiding dramatic surface
+     * change with changing resolution. */
+    int new_seed = data->seed + BLI_hash_int_2d(o->_kx[i] * 360.0f, o->_kz[j] * 360.0f);
+
+    BLI_rng_seed(rng, new_seed);
+    float r1 = gaussRand(rng);
+    float r2 = gaussRand(rng);
+
+    fftw_complex r1r2;
+    init_complex(r1r2, r1, r2);
+    switch (o->_spectrum) {
+      case MOD_OCEAN_SPECTRUM_JONSWAP:
+        mul_complex_f(o->_h0[i * o->_N + j],
+                      r1r2,
+                      (float)(sqrt(BLI_ocean_spectrum_jonswap(o, o->_kx[i], o->_kz[j]) / 2.0f)));
+        mul_complex_f(o->_h0_minus[i * o->_N + j],
+                      r1r2,
+                      (float)(sqrt(BLI_ocean_spectrum_jonswap(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
+        break;
+      case MOD_OCEAN_SPECTRUM_TEXEL_MARSEN_ARSLOE:
+        mul_complex_f(
+            o->_h0[i * o->_N + j],
+            r1r2,
+            (float)(sqrt(BLI_ocean_spectrum_texelmarsenarsloe(o, o->_kx[i], o->_kz[j]) / 2.0f)));
+        mul_complex_f(
+            o->_h0_minus[i * o->_N + j],
+            r1r2,
+            (float)(sqrt(BLI_ocean_spectrum_texelmarsenarsloe(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
+        break;
+      case MOD_OCEAN_SPECTRUM_PIERSON_MOSKOWITZ:
+        mul_complex_f(
+            o->_h0[i * o->_N + j],
+            r1r2,
+            (float)(sqrt(BLI_ocean_spectrum_piersonmoskowitz(o, o->_kx[i], o->_kz[j]) / 2.0f)));
+        mul_complex_f(
+            o->_h0_minus[i * o->_N + j],
+            r1r2,
+            (float)(sqrt(BLI_ocean_spectrum_piersonmoskowitz(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
+        break;
+      default:
+        mul_complex_f(
+            o->_h0[i * o->_N + j], r1r2, (float)(sqrt(Ph(o, o->_kx[i], o->_kz[j]) / 2.0f)));
+        mul_complex_f(
+            o->_h0_minus[i * o->_N + j], r1r2, (float)(sqrt(Ph(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
+        break;
+    }
+  }
+
+  BLI_rng_free(rng);
+}
+
 void BKE_ocean_init_from_modifier(struct Ocean *ocean, struct OceanModifierData const *omd)
 {
   short do_heightfield, do_chop, do_normals, do_jacobian;
@@ -819,7 +887,6 @@ void BKE_ocean_init(struct Ocean *o,
                     short do_jacobian,
                     int seed)
 {
-  RNG *rng;
   int i, j, ii;
 
   BLI_rw_mutex_lock(&o->oceanmutex, THREAD_LOCK_WRITE);
@@ -894,61 +961,16 @@ void BKE_ocean_init(struct Ocean *o,
     }
   }
 
-  rng = BLI_rng_new(seed);
-
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j < o->_N; j++) {
-      /* This ensures we get a value tied to the surface location, avoiding dramatic surface
-       * change with changing resolution. */
-      int new_seed = seed + BLI_hash_int_2d(o->_kx[i] * 360.0f, o->_kz[j] * 360.0f);
-
-      BLI_rng_seed(rng, new_seed);
-      float r1 = gaussRand(rng);
-      float r2 = gaussRand(rng);
-
-      fftw_complex r1r2;
-      init_complex(r1r2, r1, r2);
-      switch (o->_spectrum) {
-        case MOD_OCEAN_SPECTRUM_JONSWAP:
-          mul_complex_f(o->_h0[i * o->_N + j],
-                        r1r2,
-                        (float)(sqrt(BLI_ocean_spectrum_jonswap(o, o->_kx[i], o->_kz[j]) / 2.0f)));
-          mul_complex_f(
-              o->_h0_minus[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_jonswap(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
-          break;
-        case MOD_OCEAN_SPECTRUM_TEXEL_MARSEN_ARSLOE:
-          mul_complex_f(
-              o->_h0[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_texelmarsenarsloe(o, o->_kx[i], o->_kz[j]) / 2.0f)));
-          mul_complex_f(
-              o->_h0_minus[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_texelmarsenarsloe(o, -o->_kx[i], -o->_kz[j]) /
-                           2.0f)));
-          break;
-        case MOD_OCEAN_SPECTRUM_PIERSON_MOSKOWITZ:
-          mul_complex_f(
-              o->_h0[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_piersonmoskowitz(o, o->_kx[i], o->_kz[j]) / 2.0f)));
-          mul_complex_f(
-              o->_h0_minus[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_piersonmoskowitz(o, -o->_kx[i], -o->_kz[j]) /
-                           2.0f)));
-          break;
-        default:
-          mul_complex_f(
-              o->_h0[i * o->_N + j], r1r2, (float)(sqrt(Ph(o, o->_kx[i], o->_kz[j]) / 2.0f)));
-          mul_complex_f(o->_h0_minus[i * o->_N + j],
-                        r1r2,
-                        (float)(sqrt(Ph(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
-          break;
-      }
-    }
+  /* Initialize the spectrum amplitudes, one row per task, the RNG is reseeded per texel. */
+  {
+    OceanInitSpectrumData data = {
+        .o = o,
+        .seed = seed,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (o->_M > 16);
+    BLI_task_parallel_range(0, o->_M, &data, ocean_compute_spectrum_row, &settings);
   }
 
   o->_fft_in = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
@@ -1011,8 +1033,6 @@ void BKE_ocean_init(struct Ocean *o,
   BLI_rw_mutex_unlock(&o->oceanmutex);
 
   set_height_normalize_factor(o);
-
-  BLI_rng_free(rng);
 }
 
 void BKE_ocean_free_data(struct Ocean *oc)
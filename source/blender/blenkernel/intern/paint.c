@@ -40,6 +40,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -1294,7 +1295,7 @@ void BKE_sculptsession_bm_to_me(Object *ob, bool reorder)
   }
 }
 
-static void sculptsession_free_pbvh(Object *object)
+static void sculptsession_free_pbvh(Object *object, const bool keep_pbvh_for_rebuild)
 {
   SculptSession *ss = object->sculpt;
 
@@ -1303,13 +1304,24 @@ static void sculptsession_free_pbvh(Object *object)
   }
 
   if (ss->pbvh) {
-    BKE_pbvh_free(ss->pbvh);
-    ss->pbvh = NULL;
+    if (keep_pbvh_for_rebuild) {
+      /* Keep the tree so the rebuild in #BKE_sculpt_object_pbvh_ensure can
+       * reuse its nodes when the topology did not change. */
+      ss->needs_pbvh_rebuild = true;
+    }
+    else {
+      BKE_pbvh_free(ss->pbvh);
+      ss->pbvh = NULL;
+      ss->needs_pbvh_rebuild = false;
+    }
   }
 
   MEM_SAFE_FREE(ss->pmap);
   MEM_SAFE_FREE(ss->pmap_mem);
 
+  MEM_SAFE_FREE(ss->vnmap);
+  MEM_SAFE_FREE(ss->vnmap_mem);
+
   MEM_SAFE_FREE(ss->layer_base);
 
   MEM_SAFE_FREE(ss->preview_vert_index_list);
@@ -1348,7 +1360,7 @@ void BKE_sculptsession_free(Object *ob)
       BM_mesh_free(ss->bm);
     }
 
-    sculptsession_free_pbvh(ob);
+    sculptsession_free_pbvh(ob, false);
 
     MEM_SAFE_FREE(ss->pmap);
     MEM_SAFE_FREE(ss->pmap_mem);
@@ -1471,6 +1483,81 @@ static bool sculpt_modifiers_active(Scene *scene, Sculpt *sd, Object *ob)
   return false;
 }
 
+typedef struct SculptVertNeighborMapData {
+  const MeshElemMap *pmap;
+  const MPoly *mpoly;
+  const MLoop *mloop;
+  MeshElemMap *vnmap;
+} SculptVertNeighborMapData;
+
+static void sculpt_vert_neighbor_map_build_cb(void *__restrict userdata,
+                                              const int v,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SculptVertNeighborMapData *data = userdata;
+  const MeshElemMap *vert_map = &data->pmap[v];
+  MeshElemMap *neighbors = &data->vnmap[v];
+
+  for (int i = 0; i < vert_map->count; i++) {
+    const MPoly *p = &data->mpoly[vert_map->indices[i]];
+    uint f_adj_v[2];
+    if (poly_get_adj_loops_from_vert(p, data->mloop, (uint)v, f_adj_v) != -1) {
+      for (int j = 0; j < 2; j++) {
+        if (f_adj_v[j] == (uint)v) {
+          continue;
+        }
+        bool known = false;
+        for (int k = 0; k < neighbors->count; k++) {
+          if (neighbors->indices[k] == (int)f_adj_v[j]) {
+            known = true;
+            break;
+          }
+        }
+        if (!known) {
+          neighbors->indices[neighbors->count++] = (int)f_adj_v[j];
+        }
+      }
+    }
+  }
+}
+
+/* Precompute the vertex-to-vertex adjacency of the mesh in the same compressed
+ * layout as the vertex-to-poly map, so the PBVH_FACES neighbor iterator only
+ * reads two arrays instead of walking the poly map for every stroke step.
+ * Valid for as long as the topology does not change, freed together with the
+ * poly map it is built from (see sculptsession_free_pbvh). */
+static void sculpt_vert_neighbor_map_create(SculptSession *ss, const Mesh *me)
+{
+  MeshElemMap *vnmap = MEM_callocN(sizeof(MeshElemMap) * (size_t)me->totvert, __func__);
+
+  /* Every poly incident to a vertex contributes at most two neighbors,
+   * reserve that upper bound for each vertex. */
+  size_t indices_num = 0;
+  for (int v = 0; v < me->totvert; v++) {
+    indices_num += 2 * (size_t)ss->pmap[v].count;
+  }
+  int *vnmap_mem = MEM_mallocN(sizeof(int) * indices_num, __func__);
+
+  size_t offset = 0;
+  for (int v = 0; v < me->totvert; v++) {
+    vnmap[v].indices = vnmap_mem + offset;
+    offset += 2 * (size_t)ss->pmap[v].count;
+  }
+
+  SculptVertNeighborMapData data = {
+      .pmap = ss->pmap,
+      .mpoly = me->mpoly,
+      .mloop = me->mloop,
+      .vnmap = vnmap,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, me->totvert, &data, sculpt_vert_neighbor_map_build_cb, &settings);
+
+  ss->vnmap = vnmap;
+  ss->vnmap_mem = vnmap_mem;
+}
+
 /**
  * \param need_mask: So that the evaluated mesh that is returned has mask data.
  */
@@ -1569,6 +1656,10 @@ static void sculpt_update_object(
   if (need_pmap && ob->type == OB_MESH && !ss->pmap) {
     BKE_mesh_vert_poly_map_create(
         &ss->pmap, &ss->pmap_mem, me->mpoly, me->mloop, me->totvert, me->totpoly, me->totloop);
+
+    if (BKE_pbvh_type(ss->pbvh) == PBVH_FACES) {
+      sculpt_vert_neighbor_map_create(ss, me);
+    }
   }
 
   pbvh_show_mask_set(ss->pbvh, ss->show_mask);
@@ -1631,8 +1722,14 @@ void BKE_sculpt_update_object_before_eval(Object *ob)
     if (!ss->cache && !ss->filter_cache) {
       /* We free pbvh on changes, except in the middle of drawing a stroke
        * since it can't deal with changing PVBH node organization, we hope
-       * topology does not change in the meantime .. weak. */
-      sculptsession_free_pbvh(ob);
+       * topology does not change in the meantime .. weak.
+       *
+       * A mesh PBVH is kept in sculpt mode, the rebuild right after the
+       * evaluation reuses its nodes when the topology did not change. */
+      const bool keep_pbvh_for_rebuild = (ss->pbvh != NULL &&
+                                          BKE_pbvh_type(ss->pbvh) == PBVH_FACES &&
+                                          (ob->mode & OB_MODE_SCULPT) != 0 && ss->bm == NULL);
+      sculptsession_free_pbvh(ob, keep_pbvh_for_rebuild);
 
       BKE_sculptsession_free_deformMats(ob->sculpt);
 
@@ -1817,7 +1914,13 @@ static PBVH *build_pbvh_from_regular_mesh(Object *ob, Mesh *me_eval_deform, bool
 {
   Mesh *me = BKE_object_get_original_mesh(ob);
   const int looptris_num = poly_to_tri_count(me->totpoly, me->totloop);
-  PBVH *pbvh = BKE_pbvh_new();
+
+  /* Build into the PBVH kept across the geometry update when there is one,
+   * so its nodes can be reused (see #BKE_pbvh_build_mesh). */
+  PBVH *pbvh = ob->sculpt->pbvh;
+  if (pbvh == NULL) {
+    pbvh = BKE_pbvh_new();
+  }
   BKE_pbvh_respect_hide_set(pbvh, respect_hide);
 
   MLoopTri *looptri = MEM_malloc_arrayN(looptris_num, sizeof(*looptri), __func__);
@@ -1868,6 +1971,17 @@ static PBVH *build_pbvh_from_ccg(Object *ob, SubdivCCG *subdiv_ccg, bool respect
   return pbvh;
 }
 
+/* A PBVH kept across a geometry update (see #BKE_sculpt_update_object_before_eval)
+ * can only be reused by the regular mesh build, free it when the object switched
+ * to another PBVH type in the meantime. */
+static void sculpt_object_pbvh_free_for_rebuild(Object *ob)
+{
+  if (ob->sculpt->pbvh != NULL) {
+    BKE_pbvh_free(ob->sculpt->pbvh);
+    ob->sculpt->pbvh = NULL;
+  }
+}
+
 PBVH *BKE_sculpt_object_pbvh_ensure(Depsgraph *depsgraph, Object *ob)
 {
   if (ob == NULL || ob->sculpt == NULL) {
@@ -1882,7 +1996,7 @@ PBVH *BKE_sculpt_object_pbvh_ensure(Depsgraph *depsgraph, Object *ob)
   }
 
   PBVH *pbvh = ob->sculpt->pbvh;
-  if (pbvh != NULL) {
+  if (pbvh != NULL && !ob->sculpt->needs_pbvh_rebuild) {
     /* NOTE: It is possible that grids were re-allocated due to modifier
      * stack. Need to update those pointers. */
     if (BKE_pbvh_type(pbvh) == PBVH_GRIDS) {
@@ -1898,20 +2012,25 @@ PBVH *BKE_sculpt_object_pbvh_ensure(Depsgraph *depsgraph, Object *ob)
 
   if (ob->sculpt->bm != NULL) {
     /* Sculpting on a BMesh (dynamic-topology) gets a special PBVH. */
+    sculpt_object_pbvh_free_for_rebuild(ob);
     pbvh = build_pbvh_for_dynamic_topology(ob);
   }
   else {
     Object *object_eval = DEG_get_evaluated_object(depsgraph, ob);
     Mesh *mesh_eval = object_eval->data;
     if (mesh_eval->runtime.subdiv_ccg != NULL) {
+      sculpt_object_pbvh_free_for_rebuild(ob);
       pbvh = build_pbvh_from_ccg(ob, mesh_eval->runtime.subdiv_ccg, respect_hide);
     }
     else if (ob->type == OB_MESH) {
+      /* A PBVH kept across the geometry update is rebuilt in place here,
+       * reusing its nodes when the topology did not change. */
       Mesh *me_eval_deform = object_eval->runtime.mesh_deform_eval;
       pbvh = build_pbvh_from_regular_mesh(ob, me_eval_deform, respect_hide);
     }
   }
 
+  ob->sculpt->needs_pbvh_rebuild = false;
   ob->sculpt->pbvh = pbvh;
   return pbvh;
 }
@@ -1251,8 +1251,8 @@ static int psys_thread_context_init_distribute(ParticleThreadContext *ctx,
     }
 
     if (orig_index) {
-      BLI_qsort_r(
-          particle_element, totpart, sizeof(int), distribute_compare_orig_index, orig_index);
+      BLI_sort_parallel(
+          particle_element, (size_t)totpart, sizeof(int), distribute_compare_orig_index, orig_index);
     }
   }
 
@@ -51,6 +51,13 @@
 
 #define LEAF_LIMIT 10000
 
+/* An incremental rebuild keeps the current nodes when no more than this
+ * fraction of the leaf nodes drifted past their build-time bounds. */
+#define REBUILD_DRIFT_MAX_LEAFS 0.25f
+/* How far (relative to the leaf size) a leaf may grow outside the bounds it
+ * was partitioned with before it counts as drifted. */
+#define REBUILD_DRIFT_THRESHOLD 0.5f
+
 //#define PERFCNTRS
 
 #define STACK_FIXED_DEPTH 100
@@ -372,11 +379,22 @@ int BKE_pbvh_count_grid_quads(BLI_bitmap **grid_hidden,
     const BLI_bitmap *gh = grid_hidden[grid_indices[i]];
 
     if (gh) {
-      /* grid hidden are present, have to check each element */
-      for (int y = 0; y < gridsize - 1; y++) {
-        for (int x = 0; x < gridsize - 1; x++) {
-          if (!paint_is_grid_face_hidden(gh, gridsize, x, y)) {
-            totquad++;
+      /* Fully visible and fully hidden grids can be counted in bulk. */
+      const size_t hidden_len = BLI_bitmap_count_set(gh, (size_t)(gridsize * gridsize));
+
+      if (hidden_len == 0) {
+        totquad += gridarea;
+      }
+      else if (hidden_len == (size_t)(gridsize * gridsize)) {
+        /* pass */
+      }
+      else {
+        /* grid hidden are present, have to check each element */
+        for (int y = 0; y < gridsize - 1; y++) {
+          for (int x = 0; x < gridsize - 1; x++) {
+            if (!paint_is_grid_face_hidden(gh, gridsize, x, y)) {
+              totquad++;
+            }
           }
         }
       }
@@ -535,13 +553,127 @@ static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int off
             offset + count - end);
 }
 
+static void pbvh_node_free_data(PBVHNode *node)
+{
+  if (node->flag & PBVH_Leaf) {
+    if (node->draw_buffers) {
+      GPU_pbvh_buffers_free(node->draw_buffers);
+    }
+    if (node->vert_indices) {
+      MEM_freeN((void *)node->vert_indices);
+    }
+    if (node->face_vert_indices) {
+      MEM_freeN((void *)node->face_vert_indices);
+    }
+    if (node->bm_faces) {
+      BLI_gset_free(node->bm_faces, NULL);
+    }
+    if (node->bm_unique_verts) {
+      BLI_gset_free(node->bm_unique_verts, NULL);
+    }
+    if (node->bm_other_verts) {
+      BLI_gset_free(node->bm_other_verts, NULL);
+    }
+  }
+}
+
+/* Return true when the new leaf bounds extend outside the bounds the leaf was
+ * partitioned with by more than #REBUILD_DRIFT_THRESHOLD of the leaf size. */
+static bool leaf_bounds_drifted(const BB *vb_old, const BB *vb_new)
+{
+  const float pad = REBUILD_DRIFT_THRESHOLD * max_fff(vb_old->bmax[0] - vb_old->bmin[0],
+                                                      vb_old->bmax[1] - vb_old->bmin[1],
+                                                      vb_old->bmax[2] - vb_old->bmin[2]);
+
+  for (int axis = 0; axis < 3; axis++) {
+    if ((vb_new->bmin[axis] < vb_old->bmin[axis] - pad) ||
+        (vb_new->bmax[axis] > vb_old->bmax[axis] + pad)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Try to keep the current tree when rebuilding: when the primitive count did
+ * not change and the leafs are still reasonably close to the bounds they were
+ * partitioned with, only the bounds need to be refit onto the new coordinates.
+ * Node indices (and with them the GPU batches and sculpt undo references)
+ * stay valid, where a full rebuild invalidates them.
+ *
+ * The caller is responsible for checking that the other element counts still
+ * match. A count match does not strictly guarantee an unchanged topology, but
+ * since the bounds are recomputed from the new primitives anyway the tree
+ * stays valid either way, at worst with a suboptimal partitioning (which the
+ * drift check then catches on the next rebuild). */
+static bool pbvh_build_incremental(PBVH *pbvh, BBC *prim_bbc, int totprim)
+{
+  if (pbvh->totnode == 0 || totprim != pbvh->totprim) {
+    return false;
+  }
+
+  int totleaf = 0, totdrifted = 0;
+
+  /* Refit the leaf bounds, counting how many leafs no longer match the
+   * partitioning they were built with. */
+  for (int i = 0; i < pbvh->totnode; i++) {
+    PBVHNode *node = &pbvh->nodes[i];
+    if (!(node->flag & PBVH_Leaf)) {
+      continue;
+    }
+    totleaf++;
+
+    BB vb;
+    BB_reset(&vb);
+    const int offset = (int)(node->prim_indices - pbvh->prim_indices);
+    for (int j = offset + (int)node->totprim - 1; j >= offset; j--) {
+      BB_expand_with_bb(&vb, (BB *)(&prim_bbc[pbvh->prim_indices[j]]));
+    }
+    if (leaf_bounds_drifted(&node->vb, &vb)) {
+      totdrifted++;
+    }
+    node->vb = vb;
+    node->orig_vb = vb;
+  }
+
+  if ((float)totdrifted > (float)totleaf * REBUILD_DRIFT_MAX_LEAFS) {
+    /* Too many leafs moved away from their partitioning, a full rebuild gives
+     * a better tree (it overwrites the bounds set above). */
+    return false;
+  }
+
+  /* Propagate the new bounds up the tree, children are always stored after
+   * their parent so a reverse walk visits them first. */
+  for (int i = pbvh->totnode - 1; i >= 0; i--) {
+    PBVHNode *node = &pbvh->nodes[i];
+    if (node->flag & PBVH_Leaf) {
+      node->flag |= PBVH_UpdateBB | PBVH_UpdateOriginalBB | PBVH_UpdateDrawBuffers |
+                    PBVH_UpdateRedraw | PBVH_UpdateNormals;
+    }
+    else {
+      BB_reset(&node->vb);
+      BB_expand_with_bb(&node->vb, &pbvh->nodes[node->children_offset].vb);
+      BB_expand_with_bb(&node->vb, &pbvh->nodes[node->children_offset + 1].vb);
+      node->orig_vb = node->vb;
+      node->flag |= PBVH_UpdateRedraw;
+    }
+  }
+
+  return true;
+}
+
 static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 {
+  if (pbvh->totnode) {
+    /* Full rebuild over an existing tree: node indices are not kept,
+     * so all node data (including the GPU buffers) has to go. */
+    for (int i = 0; i < pbvh->totnode; i++) {
+      pbvh_node_free_data(&pbvh->nodes[i]);
+    }
+    memset(pbvh->nodes, 0, sizeof(PBVHNode) * pbvh->node_mem_count);
+  }
+
   if (totprim != pbvh->totprim) {
     pbvh->totprim = totprim;
-    if (pbvh->nodes) {
-      MEM_freeN(pbvh->nodes);
-    }
     if (pbvh->prim_indices) {
       MEM_freeN(pbvh->prim_indices);
     }
@@ -549,11 +681,11 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
     for (int i = 0; i < totprim; i++) {
       pbvh->prim_indices[i] = i;
     }
-    pbvh->totnode = 0;
-    if (pbvh->node_mem_count < 100) {
-      pbvh->node_mem_count = 100;
-      pbvh->nodes = MEM_callocN(sizeof(PBVHNode) * pbvh->node_mem_count, "bvh initial nodes");
-    }
+  }
+  pbvh->totnode = 0;
+  if (pbvh->node_mem_count < 100) {
+    pbvh->node_mem_count = 100;
+    pbvh->nodes = MEM_callocN(sizeof(PBVHNode) * pbvh->node_mem_count, "bvh initial nodes");
   }
 
   pbvh->totnode = 1;
@@ -561,7 +693,12 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 }
 
 /**
- * Do a full rebuild with on Mesh data structure.
+ * Do a rebuild with on Mesh data structure.
+ *
+ * May be called on a PBVH that already holds a tree, in which case the current
+ * nodes are reused when the element counts still match and the leaf bounds did
+ * not drift too far (see #pbvh_build_incremental), otherwise a full rebuild
+ * replaces them.
  *
  * \note Unlike mpoly/mloop/verts, looptri is **totally owned** by PBVH
  * (which means it may rewrite it if needed, see #BKE_pbvh_vert_coords_apply().
@@ -581,6 +718,21 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   BBC *prim_bbc = NULL;
   BB cb;
 
+  /* When building over an existing tree the current nodes can be kept,
+   * but only when the element counts still match (see pbvh_build_incremental). */
+  const bool try_incremental = (pbvh->totnode != 0 && pbvh->type == PBVH_FACES &&
+                                pbvh->totvert == totvert);
+
+  if (pbvh->deformed && pbvh->verts) {
+    /* A rebuild starts over from the undeformed mesh coordinates. */
+    MEM_freeN((void *)pbvh->verts);
+  }
+  pbvh->deformed = false;
+  if (pbvh->looptri) {
+    /* The looptri array is owned by the PBVH, free the one of the previous build. */
+    MEM_freeN((void *)pbvh->looptri);
+  }
+
   pbvh->mesh = mesh;
   pbvh->type = PBVH_FACES;
   pbvh->mpoly = mpoly;
@@ -619,7 +771,27 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   }
 
   if (looptri_num) {
-    pbvh_build(pbvh, &cb, prim_bbc, looptri_num);
+    if (try_incremental && pbvh_build_incremental(pbvh, prim_bbc, looptri_num)) {
+      /* The kept draw buffers still point into the arrays of the previous
+       * build, their contents are refreshed through #PBVH_UpdateDrawBuffers. */
+      for (int i = 0; i < pbvh->totnode; i++) {
+        PBVHNode *node = &pbvh->nodes[i];
+        if ((node->flag & PBVH_Leaf) && node->draw_buffers) {
+          GPU_pbvh_mesh_buffers_update_pointers(node->draw_buffers, mpoly, mloop, looptri, verts);
+        }
+      }
+    }
+    else {
+      pbvh_build(pbvh, &cb, prim_bbc, looptri_num);
+    }
+  }
+  else if (pbvh->totnode) {
+    /* The mesh lost all its faces, drop the old tree. */
+    for (int i = 0; i < pbvh->totnode; i++) {
+      pbvh_node_free_data(&pbvh->nodes[i]);
+    }
+    memset(pbvh->nodes, 0, sizeof(PBVHNode) * pbvh->node_mem_count);
+    pbvh->totnode = 0;
   }
 
   MEM_freeN(prim_bbc);
@@ -684,28 +856,7 @@ PBVH *BKE_pbvh_new(void)
 void BKE_pbvh_free(PBVH *pbvh)
 {
   for (int i = 0; i < pbvh->totnode; i++) {
-    PBVHNode *node = &pbvh->nodes[i];
-
-    if (node->flag & PBVH_Leaf) {
-      if (node->draw_buffers) {
-        GPU_pbvh_buffers_free(node->draw_buffers);
-      }
-      if (node->vert_indices) {
-        MEM_freeN((void *)node->vert_indices);
-      }
-      if (node->face_vert_indices) {
-        MEM_freeN((void *)node->face_vert_indices);
-      }
-      if (node->bm_faces) {
-        BLI_gset_free(node->bm_faces, NULL);
-      }
-      if (node->bm_unique_verts) {
-        BLI_gset_free(node->bm_unique_verts, NULL);
-      }
-      if (node->bm_other_verts) {
-        BLI_gset_free(node->bm_other_verts, NULL);
-      }
-    }
+    pbvh_node_free_data(&pbvh->nodes[i]);
   }
 
   if (pbvh->deformed) {
@@ -25,6 +25,7 @@
 #include "BLI_heap_simple.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_DerivedMesh.h"
@@ -748,6 +749,19 @@ typedef struct EdgeQueue {
 #endif
 } EdgeQueue;
 
+/**
+ * Edges collected by the threaded gather pass, to be merged into the heap.
+ * The heap, the vertex-pair pool and the edge tags are all shared state,
+ * so only the main thread may touch them; worker threads append here instead.
+ */
+typedef struct EdgeQueueCandidates {
+  struct {
+    BMEdge *e;
+    float priority;
+  } *items;
+  int items_len, items_len_alloc;
+} EdgeQueueCandidates;
+
 typedef struct {
   EdgeQueue *q;
   BLI_mempool *pool;
@@ -755,8 +769,28 @@ typedef struct {
   int cd_vert_mask_offset;
   int cd_vert_node_offset;
   int cd_face_node_offset;
+
+  /**
+   * When non-NULL, #edge_queue_insert records candidates here instead of
+   * inserting into the heap, deferring all shared-state writes to the merge.
+   */
+  EdgeQueueCandidates *candidates;
 } EdgeQueueContext;
 
+static void edge_queue_candidates_append(EdgeQueueCandidates *candidates,
+                                         BMEdge *e,
+                                         const float priority)
+{
+  if (UNLIKELY(candidates->items_len == candidates->items_len_alloc)) {
+    candidates->items_len_alloc = MAX2(candidates->items_len_alloc * 2, 64);
+    candidates->items = MEM_reallocN(candidates->items,
+                                     sizeof(*candidates->items) * candidates->items_len_alloc);
+  }
+  candidates->items[candidates->items_len].e = e;
+  candidates->items[candidates->items_len].priority = priority;
+  candidates->items_len++;
+}
+
 /* only tag'd edges are in the queue */
 #ifdef USE_EDGEQUEUE_TAG
 #  define EDGE_QUEUE_TEST(e) (BM_elem_flag_test((CHECK_TYPE_INLINE(e, BMEdge *), e), BM_ELEM_TAG))
@@ -847,6 +881,12 @@ static void edge_queue_insert(EdgeQueueContext *eq_ctx, BMEdge *e, float priorit
        (check_mask(eq_ctx, e->v1) || check_mask(eq_ctx, e->v2))) &&
       !(BM_elem_flag_test_bool(e->v1, BM_ELEM_HIDDEN) ||
         BM_elem_flag_test_bool(e->v2, BM_ELEM_HIDDEN))) {
+    if (eq_ctx->candidates != NULL) {
+      /* Gather pass running from a worker thread,
+       * the heap insertion and edge tagging happen in the serial merge. */
+      edge_queue_candidates_append(eq_ctx->candidates, e, priority);
+      return;
+    }
     BMVert **pair = BLI_mempool_alloc(eq_ctx->pool);
     pair[0] = e->v1;
     pair[1] = e->v2;
@@ -992,6 +1032,90 @@ static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
   }
 }
 
+typedef struct EdgeQueueTaskData {
+  EdgeQueueContext *eq_ctx;
+  PBVH *pbvh;
+  void (*edge_queue_face_add)(EdgeQueueContext *eq_ctx, BMFace *f);
+  /* One candidate buffer per node, so workers never share any writable state. */
+  EdgeQueueCandidates *node_candidates;
+} EdgeQueueTaskData;
+
+static void edge_queue_nodes_task_cb(void *__restrict userdata,
+                                     const int n,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  EdgeQueueTaskData *data = userdata;
+  PBVHNode *node = &data->pbvh->nodes[n];
+
+  /* Check leaf nodes marked for topology update */
+  if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
+      !(node->flag & PBVH_FullyHidden)) {
+    /* Local context so each worker appends to its own node's candidate buffer.
+     * The tests done here only read mesh data, the edge tags are guaranteed
+     * clean at this point so the tag checks in the add functions are no-ops. */
+    EdgeQueueContext eq_ctx = *data->eq_ctx;
+    eq_ctx.candidates = &data->node_candidates[n];
+
+    GSetIterator gs_iter;
+
+    /* Check each face */
+    GSET_ITER (gs_iter, node->bm_faces) {
+      BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
+
+      data->edge_queue_face_add(&eq_ctx, f);
+    }
+  }
+}
+
+/**
+ * Run the expensive part of edge queue creation (range tests, edge length
+ * tests and the skinny-face traversal) over the topology nodes in parallel,
+ * then merge the per-node candidates into the heap on this thread. Merging in
+ * node order keeps the heap contents identical to the old serial loop, with
+ * the edge tags de-duplicating edges found from multiple nodes.
+ *
+ * BMesh modification stays serial: element pools and flags are not
+ * thread-safe, so only this read-only scan can be threaded.
+ */
+static void edge_queue_nodes_gather(EdgeQueueContext *eq_ctx,
+                                    PBVH *pbvh,
+                                    void (*edge_queue_face_add)(EdgeQueueContext *eq_ctx,
+                                                                BMFace *f))
+{
+  EdgeQueueTaskData data = {
+      .eq_ctx = eq_ctx,
+      .pbvh = pbvh,
+      .edge_queue_face_add = edge_queue_face_add,
+      .node_candidates = MEM_callocN(sizeof(*data.node_candidates) * pbvh->totnode, __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, pbvh->totnode, &data, edge_queue_nodes_task_cb, &settings);
+
+  for (int n = 0; n < pbvh->totnode; n++) {
+    EdgeQueueCandidates *candidates = &data.node_candidates[n];
+
+    for (int i = 0; i < candidates->items_len; i++) {
+      BMEdge *e = candidates->items[i].e;
+
+#ifdef USE_EDGEQUEUE_TAG
+      if (EDGE_QUEUE_TEST(e)) {
+        /* Already in the queue (found from another node or recursion). */
+        continue;
+      }
+#endif
+      edge_queue_insert(eq_ctx, e, candidates->items[i].priority);
+    }
+
+    if (candidates->items != NULL) {
+      MEM_freeN(candidates->items);
+    }
+  }
+
+  MEM_freeN(data.node_candidates);
+}
+
 /* Create a priority queue containing vertex pairs connected by a long
  * edge as defined by PBVH.bm_max_edge_len.
  *
@@ -1037,22 +1161,7 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (int n = 0; n < pbvh->totnode; n++) {
-    PBVHNode *node = &pbvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_nodes_gather(eq_ctx, pbvh, long_edge_queue_face_add);
 }
 
 /* Create a priority queue containing vertex pairs connected by a
@@ -1096,22 +1205,7 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (int n = 0; n < pbvh->totnode; n++) {
-    PBVHNode *node = &pbvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_nodes_gather(eq_ctx, pbvh, short_edge_queue_face_add);
 }
 
 /*************************** Topology update **************************/
@@ -69,10 +69,6 @@
 
 #include "BIK_api.h"
 
-#ifdef WITH_BULLET
-#  include "RBI_api.h"
-#endif
-
 /* both in intern */
 #ifdef WITH_SMOKE
 #  include "smoke_API.h"
@@ -1461,10 +1457,8 @@ static int ptcache_rigidbody_write(int index, void *rb_v, void **data, int UNUSE
     RigidBodyOb *rbo = ob->rigidbody_object;
 
     if (rbo->type == RBO_TYPE_ACTIVE) {
-#ifdef WITH_BULLET
-      RB_body_get_position(rbo->shared->physics_object, rbo->pos);
-      RB_body_get_orientation(rbo->shared->physics_object, rbo->orn);
-#endif
+      /* rbo->pos/orn are copied back from Bullet in a batched pass right after stepping,
+       * see rigidbody_sync_motion_states(). */
       PTCACHE_DATA_FROM(data, BPHYS_DATA_LOCATION, rbo->pos);
       PTCACHE_DATA_FROM(data, BPHYS_DATA_ROTATION, rbo->orn);
     }
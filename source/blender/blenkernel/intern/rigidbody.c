@@ -35,6 +35,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -1808,6 +1809,34 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 }
 
+static void rigidbody_sync_motion_states_cb(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RigidBodyWorld *rbw = userdata;
+  Object *ob = rbw->objects[i];
+  RigidBodyOb *rbo = (ob) ? ob->rigidbody_object : NULL;
+
+  if (rbo && rbo->type == RBO_TYPE_ACTIVE && rbo->shared->physics_object) {
+    RB_body_get_loc_rot(rbo->shared->physics_object, rbo->pos, rbo->orn);
+  }
+}
+
+/* Copy the simulated transforms of all active bodies back into their RigidBodyOb in one
+ * batched pass, so the point cache and transform sync don't have to query Bullet per body. */
+static void rigidbody_sync_motion_states(RigidBodyWorld *rbw)
+{
+  TaskParallelSettings settings;
+
+  if (rbw->objects == NULL) {
+    return;
+  }
+
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (rbw->numbodies > 256);
+  BLI_task_parallel_range(0, rbw->numbodies, rbw, rigidbody_sync_motion_states_cb, &settings);
+}
+
 static void rigidbody_update_simulation_post_step(Depsgraph *depsgraph, RigidBodyWorld *rbw)
 {
   ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
@@ -2046,6 +2075,8 @@ void BKE_rigidbody_do_simulation(Depsgraph *depsgraph, Scene *scene, float ctime
                               INT_MAX,
                               1.0f / (float)rbw->steps_per_second * min_ff(rbw->time_scale, 1.0f));
 
+    rigidbody_sync_motion_states(rbw);
+
     rigidbody_update_simulation_post_step(depsgraph, rbw);
 
     /* write cache for current frame */
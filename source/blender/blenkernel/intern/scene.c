@@ -32,6 +32,7 @@
 #include "DNA_curveprofile_types.h"
 #include "DNA_defaults.h"
 #include "DNA_gpencil_types.h"
+#include "DNA_image_types.h"
 #include "DNA_linestyle_types.h"
 #include "DNA_mask_types.h"
 #include "DNA_mesh_types.h"
@@ -72,6 +73,7 @@
 #include "BKE_editmesh.h"
 #include "BKE_fcurve.h"
 #include "BKE_freestyle.h"
+#include "BKE_global.h"
 #include "BKE_gpencil.h"
 #include "BKE_icons.h"
 #include "BKE_idprop.h"
@@ -1503,6 +1505,117 @@ void BKE_scene_graph_evaluated_ensure(Depsgraph *depsgraph, Main *bmain)
   scene_graph_update_tagged(depsgraph, bmain, true);
 }
 
+/* Playback media prefetch: decoding movie and image sequence frames is often
+ * the dominant cost of a playback frame step, and playback direction makes the
+ * next frame perfectly predictable. While frame N is displayed the main thread
+ * idles in the playback timer, so a single background thread decodes the media
+ * of the expected next frame into the image caches, similar to what the
+ * sequencer prefetch in seqprefetch.c does for strips. */
+
+typedef struct PlaybackPrefetchItem {
+  struct PlaybackPrefetchItem *next, *prev;
+  Image *ima;
+  /* Snapshot of one user of the image, with framenr set to the prefetch frame,
+   * so the background thread never reads data the main thread may modify. */
+  ImageUser iuser;
+} PlaybackPrefetchItem;
+
+typedef struct PlaybackPrefetchGatherData {
+  ListBase items;
+  int cfra_next;
+} PlaybackPrefetchGatherData;
+
+static struct {
+  ListBase threads;
+  ListBase items;
+  bool running;
+  int last_cfra;
+} g_playback_prefetch = {{NULL, NULL}, {NULL, NULL}, false, 0};
+
+/* Guards the state above: render and exporter jobs step frames through
+ * BKE_scene_graph_update_for_newframe from their own threads, while the main
+ * thread starts and stops prefetching during playback. The sequencer prefetch
+ * guards its equivalent state the same way. */
+static ThreadMutex playback_prefetch_mutex = BLI_MUTEX_INITIALIZER;
+
+static void *playback_prefetch_run(void *UNUSED(arg))
+{
+  LISTBASE_FOREACH (PlaybackPrefetchItem *, item, &g_playback_prefetch.items) {
+    /* Loads the frame into the image cache when it is not there yet, the
+     * buffer itself is not needed here. Image acquisition is thread-safe. */
+    BKE_image_has_ibuf(item->ima, &item->iuser);
+  }
+  return NULL;
+}
+
+static void playback_prefetch_stop_no_lock(void)
+{
+  if (g_playback_prefetch.running) {
+    BLI_threadpool_end(&g_playback_prefetch.threads);
+    g_playback_prefetch.running = false;
+  }
+  BLI_freelistN(&g_playback_prefetch.items);
+}
+
+void BKE_scene_playback_prefetch_stop(void)
+{
+  BLI_mutex_lock(&playback_prefetch_mutex);
+  playback_prefetch_stop_no_lock();
+  BLI_mutex_unlock(&playback_prefetch_mutex);
+}
+
+static void playback_prefetch_gather_cb(Image *ima,
+                                        ID *UNUSED(iuser_id),
+                                        ImageUser *iuser,
+                                        void *customdata)
+{
+  PlaybackPrefetchGatherData *data = customdata;
+
+  if (!ELEM(ima->source, IMA_SRC_MOVIE, IMA_SRC_SEQUENCE)) {
+    return;
+  }
+  if ((iuser->flag & IMA_ANIM_ALWAYS) == 0) {
+    return;
+  }
+
+  PlaybackPrefetchItem *item = MEM_callocN(sizeof(*item), "PlaybackPrefetchItem");
+  item->ima = ima;
+  item->iuser = *iuser;
+  item->iuser.framenr = BKE_image_user_frame_get(iuser, data->cfra_next, NULL);
+  BLI_addtail(&data->items, item);
+}
+
+static void playback_prefetch_start(Main *bmain, Scene *scene)
+{
+  BLI_mutex_lock(&playback_prefetch_mutex);
+
+  /* Finish (or discard) the prefetch of the previous frame step first. */
+  playback_prefetch_stop_no_lock();
+
+  if (G.is_rendering) {
+    BLI_mutex_unlock(&playback_prefetch_mutex);
+    return;
+  }
+
+  /* Guess the next frame from the step direction of the previous frame change,
+   * a wrong guess (scrubbing, playback reversal) only wastes one decode. */
+  const int step = (scene->r.cfra >= g_playback_prefetch.last_cfra) ? scene->r.frame_step :
+                                                                      -scene->r.frame_step;
+  PlaybackPrefetchGatherData data = {{NULL, NULL}, scene->r.cfra + step};
+  g_playback_prefetch.last_cfra = scene->r.cfra;
+
+  BKE_image_walk_all_users(bmain, &data, playback_prefetch_gather_cb);
+
+  if (!BLI_listbase_is_empty(&data.items)) {
+    g_playback_prefetch.items = data.items;
+    BLI_threadpool_init(&g_playback_prefetch.threads, playback_prefetch_run, 1);
+    BLI_threadpool_insert(&g_playback_prefetch.threads, NULL);
+    g_playback_prefetch.running = true;
+  }
+
+  BLI_mutex_unlock(&playback_prefetch_mutex);
+}
+
 /* applies changes right away, does all sets too */
 void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph, Main *bmain)
 {
@@ -1556,6 +1669,9 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph, Main *bmain)
       break;
     }
   }
+
+  /* Start decoding the media of the expected next frame in the background. */
+  playback_prefetch_start(bmain, scene);
 }
 
 /**
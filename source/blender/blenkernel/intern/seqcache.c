@@ -95,6 +95,7 @@
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
 #define DCACHE_CURRENT_VERSION 1
+#define DCACHE_WRITE_QUEUE_MAX 8
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in imb intern */
 
 typedef struct DiskCacheHeaderEntry {
@@ -116,8 +117,25 @@ typedef struct SeqDiskCache {
   ListBase files;
   ThreadMutex read_write_mutex;
   size_t size_total;
+
+  /* Compression and IO run on a background thread, so rendering threads only queue frames. */
+  ListBase write_queue;
+  int write_queue_len;
+  ThreadMutex write_queue_mutex;
+  ThreadCondition write_queue_cond;
+  ListBase write_threads;
+  bool write_exit;
 } SeqDiskCache;
 
+/* Frame waiting to be compressed and written by the background writer thread. */
+typedef struct DiskCacheWrite {
+  struct DiskCacheWrite *next, *prev;
+  char path[FILE_MAX];
+  float nfra;
+  /* Referenced on queuing, freed by the writer thread. */
+  ImBuf *ibuf;
+} DiskCacheWrite;
+
 typedef struct DiskCacheFile {
   struct DiskCacheFile *next, *prev;
   char path[FILE_MAX];
@@ -141,6 +159,8 @@ typedef struct SeqCache {
   struct SeqCacheKey *last_key;
   size_t memory_used;
   SeqDiskCache *disk_cache;
+  /* Timeline strip thumbnails, evicted independently of the frame cache. */
+  struct GHash *thumbs_hash;
 } SeqCache;
 
 typedef struct SeqCacheItem {
@@ -163,9 +183,19 @@ typedef struct SeqCacheKey {
   int type;
 } SeqCacheKey;
 
+/* Limit on the number of cached strip thumbnails. Thumbnails are small, so a simple count
+ * cap is enough; entries furthest from the newly inserted frame are evicted first. */
+#define SEQ_THUMB_CACHE_LIMIT 1000
+
+typedef struct SeqThumbnailKey {
+  struct Sequence *seq;
+  float nfra;
+} SeqThumbnailKey;
+
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
 static float seq_cache_cfra_to_frame_index(Sequence *seq, float cfra);
 static float seq_cache_frame_index_to_cfra(Sequence *seq, float nfra);
+static void seq_disk_cache_clear_write_queue(SeqDiskCache *disk_cache);
 
 static char *seq_disk_cache_base_dir(void)
 {
@@ -309,7 +339,8 @@ static bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
   return true;
 }
 
-static DiskCacheFile *seq_disk_cache_get_file_entry_by_path(SeqDiskCache *disk_cache, char *path)
+static DiskCacheFile *seq_disk_cache_get_file_entry_by_path(SeqDiskCache *disk_cache,
+                                                            const char *path)
 {
   DiskCacheFile *cache_file = disk_cache->files.first;
 
@@ -323,7 +354,7 @@ static DiskCacheFile *seq_disk_cache_get_file_entry_by_path(SeqDiskCache *disk_c
 }
 
 /* Update file size and timestamp. */
-static void seq_disk_cache_update_file(SeqDiskCache *disk_cache, char *path)
+static void seq_disk_cache_update_file(SeqDiskCache *disk_cache, const char *path)
 {
   DiskCacheFile *cache_file;
   int64_t size_before;
@@ -464,6 +495,10 @@ static void seq_disk_cache_invalidate(Scene *scene,
   int end;
   SeqDiskCache *disk_cache = scene->ed->cache->disk_cache;
 
+  /* Drop queued writes first, so a stale frame can not land on disk after its file was
+   * deleted. Taking the read/write mutex below waits for any write still in flight. */
+  seq_disk_cache_clear_write_queue(disk_cache);
+
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   start = seq_changed->startdisp - DCACHE_IMAGES_PER_FILE;
@@ -522,7 +557,7 @@ static size_t seq_disk_cache_write_header(FILE *file, DiskCacheHeader *header)
   return fwrite(header, sizeof(*header), 1, file);
 }
 
-static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCacheHeader *header)
+static int seq_disk_cache_add_header_entry(float nfra, ImBuf *ibuf, DiskCacheHeader *header)
 {
   int i;
   uint64_t offset = sizeof(*header);
@@ -555,7 +590,7 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
   }
 
   header->entry[i].offset = offset;
-  header->entry[i].frameno = key->nfra;
+  header->entry[i].frameno = nfra;
 
   /* Store colorspace name of ibuf. */
   const char *colorspace_name;
@@ -584,11 +619,11 @@ static int seq_disk_cache_get_header_entry(SeqCacheKey *key, DiskCacheHeader *he
   return -1;
 }
 
-static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache,
+                                      const char *path,
+                                      float nfra,
+                                      ImBuf *ibuf)
 {
-  char path[FILE_MAX];
-
-  seq_disk_cache_get_file_path(disk_cache, key, path, sizeof(path));
   BLI_make_existing_file(path);
 
   FILE *file = BLI_fopen(path, "rb+");
@@ -603,7 +638,7 @@ static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key
   DiskCacheHeader header;
   memset(&header, 0, sizeof(header));
   seq_disk_cache_read_header(file, &header);
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+  int entry_index = seq_disk_cache_add_header_entry(nfra, ibuf, &header);
   size_t bytes_written = deflate_imbuf_to_file(
       ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
 
@@ -622,6 +657,74 @@ static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key
   return false;
 }
 
+static void *seq_disk_cache_write_thread_run(void *data)
+{
+  SeqDiskCache *disk_cache = data;
+
+  BLI_mutex_lock(&disk_cache->write_queue_mutex);
+  while (1) {
+    while (BLI_listbase_is_empty(&disk_cache->write_queue) && !disk_cache->write_exit) {
+      BLI_condition_wait(&disk_cache->write_queue_cond, &disk_cache->write_queue_mutex);
+    }
+
+    if (disk_cache->write_exit) {
+      break;
+    }
+
+    DiskCacheWrite *write = disk_cache->write_queue.first;
+    BLI_remlink(&disk_cache->write_queue, write);
+    disk_cache->write_queue_len--;
+    BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+
+    BLI_mutex_lock(&disk_cache->read_write_mutex);
+    seq_disk_cache_write_file(disk_cache, write->path, write->nfra, write->ibuf);
+    seq_disk_cache_enforce_limits(disk_cache);
+    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+
+    IMB_freeImBuf(write->ibuf);
+    MEM_freeN(write);
+
+    BLI_mutex_lock(&disk_cache->write_queue_mutex);
+  }
+  BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+
+  return NULL;
+}
+
+static void seq_disk_cache_enqueue_write(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+{
+  BLI_mutex_lock(&disk_cache->write_queue_mutex);
+
+  if (disk_cache->write_queue_len >= DCACHE_WRITE_QUEUE_MAX) {
+    /* The writer can not keep up. Drop the frame rather than stall rendering or keep an
+     * unbounded amount of image buffers referenced. */
+    BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+    return;
+  }
+
+  DiskCacheWrite *write = MEM_callocN(sizeof(DiskCacheWrite), "DiskCacheWrite");
+  seq_disk_cache_get_file_path(disk_cache, key, write->path, sizeof(write->path));
+  write->nfra = key->nfra;
+  write->ibuf = ibuf;
+  IMB_refImBuf(ibuf);
+
+  BLI_addtail(&disk_cache->write_queue, write);
+  disk_cache->write_queue_len++;
+  BLI_condition_notify_one(&disk_cache->write_queue_cond);
+  BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+}
+
+static void seq_disk_cache_clear_write_queue(SeqDiskCache *disk_cache)
+{
+  BLI_mutex_lock(&disk_cache->write_queue_mutex);
+  LISTBASE_FOREACH (DiskCacheWrite *, write, &disk_cache->write_queue) {
+    IMB_freeImBuf(write->ibuf);
+  }
+  BLI_freelistN(&disk_cache->write_queue);
+  disk_cache->write_queue_len = 0;
+  BLI_mutex_unlock(&disk_cache->write_queue_mutex);
+}
+
 static ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 {
   char path[FILE_MAX];
@@ -728,6 +831,34 @@ static bool seq_cache_hashcmp(const void *a_, const void *b_)
           seq_cmp_render_data(&a->context, &b->context));
 }
 
+static unsigned int seq_thumbnail_hashhash(const void *key_)
+{
+  const SeqThumbnailKey *key = key_;
+  unsigned int rval = *(const unsigned int *)&key->nfra;
+
+  rval ^= ((intptr_t)key->seq) << 6;
+
+  return rval;
+}
+
+static bool seq_thumbnail_hashcmp(const void *a_, const void *b_)
+{
+  const SeqThumbnailKey *a = a_;
+  const SeqThumbnailKey *b = b_;
+
+  return (a->seq != b->seq) || (a->nfra != b->nfra);
+}
+
+static void seq_thumbnail_keyfree(void *key)
+{
+  MEM_freeN(key);
+}
+
+static void seq_thumbnail_valfree(void *val)
+{
+  IMB_freeImBuf((ImBuf *)val);
+}
+
 static float seq_cache_cfra_to_frame_index(Sequence *seq, float cfra)
 {
   return cfra - seq->start;
@@ -1051,6 +1182,10 @@ static void seq_disk_cache_create(Main *bmain, Scene *scene)
   seq_disk_cache_handle_versioning(cache->disk_cache);
   seq_disk_cache_get_files(cache->disk_cache, seq_disk_cache_base_dir());
   cache->disk_cache->timestamp = scene->ed->disk_cache_timestamp;
+  BLI_mutex_init(&cache->disk_cache->write_queue_mutex);
+  BLI_condition_init(&cache->disk_cache->write_queue_cond);
+  BLI_threadpool_init(&cache->disk_cache->write_threads, seq_disk_cache_write_thread_run, 1);
+  BLI_threadpool_insert(&cache->disk_cache->write_threads, cache->disk_cache);
   BLI_mutex_unlock(&cache_create_lock);
 }
 
@@ -1062,6 +1197,8 @@ static void seq_cache_create(Main *bmain, Scene *scene)
     cache->keys_pool = BLI_mempool_create(sizeof(SeqCacheKey), 0, 64, BLI_MEMPOOL_NOP);
     cache->items_pool = BLI_mempool_create(sizeof(SeqCacheItem), 0, 64, BLI_MEMPOOL_NOP);
     cache->hash = BLI_ghash_new(seq_cache_hashhash, seq_cache_hashcmp, "SeqCache hash");
+    cache->thumbs_hash = BLI_ghash_new(
+        seq_thumbnail_hashhash, seq_thumbnail_hashcmp, "SeqCache thumbnails");
     cache->last_key = NULL;
     cache->bmain = bmain;
     BLI_mutex_init(&cache->iterator_mutex);
@@ -1107,11 +1244,21 @@ void BKE_sequencer_cache_destruct(Scene *scene)
   }
 
   BLI_ghash_free(cache->hash, seq_cache_keyfree, seq_cache_valfree);
+  BLI_ghash_free(cache->thumbs_hash, seq_thumbnail_keyfree, seq_thumbnail_valfree);
   BLI_mempool_destroy(cache->keys_pool);
   BLI_mempool_destroy(cache->items_pool);
   BLI_mutex_end(&cache->iterator_mutex);
 
   if (cache->disk_cache != NULL) {
+    /* Stop the writer thread, writes still queued are dropped. */
+    BLI_mutex_lock(&cache->disk_cache->write_queue_mutex);
+    cache->disk_cache->write_exit = true;
+    BLI_condition_notify_one(&cache->disk_cache->write_queue_cond);
+    BLI_mutex_unlock(&cache->disk_cache->write_queue_mutex);
+    BLI_threadpool_end(&cache->disk_cache->write_threads);
+    seq_disk_cache_clear_write_queue(cache->disk_cache);
+    BLI_condition_end(&cache->disk_cache->write_queue_cond);
+    BLI_mutex_end(&cache->disk_cache->write_queue_mutex);
     BLI_freelistN(&cache->disk_cache->files);
     BLI_mutex_end(&cache->disk_cache->read_write_mutex);
     MEM_freeN(cache->disk_cache);
@@ -1210,6 +1357,22 @@ void BKE_sequencer_cache_cleanup_sequence(Scene *scene,
       BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
     }
   }
+
+  /* Strip content changed, thumbnails of that strip are stale too. */
+  if (invalidate_source) {
+    GHashIterator thumb_iter;
+    BLI_ghashIterator_init(&thumb_iter, cache->thumbs_hash);
+    while (!BLI_ghashIterator_done(&thumb_iter)) {
+      SeqThumbnailKey *thumb_key = BLI_ghashIterator_getKey(&thumb_iter);
+      BLI_ghashIterator_step(&thumb_iter);
+
+      if (thumb_key->seq == seq) {
+        BLI_ghash_remove(
+            cache->thumbs_hash, thumb_key, seq_thumbnail_keyfree, seq_thumbnail_valfree);
+      }
+    }
+  }
+
   cache->last_key = NULL;
   seq_cache_unlock(scene);
 }
@@ -1409,10 +1572,8 @@ void BKE_sequencer_cache_put(const SeqRenderData *context,
         seq_disk_cache_create(context->bmain, context->scene);
       }
 
-      BLI_mutex_lock(&cache->disk_cache->read_write_mutex);
-      seq_disk_cache_write_file(cache->disk_cache, key, i);
-      BLI_mutex_unlock(&cache->disk_cache->read_write_mutex);
-      seq_disk_cache_enforce_limits(cache->disk_cache);
+      /* Compression and IO happen on the writer thread, rendering is not blocked. */
+      seq_disk_cache_enqueue_write(cache->disk_cache, key, i);
     }
   }
 }
@@ -1455,3 +1616,105 @@ bool BKE_sequencer_cache_is_full(Scene *scene)
 
   return memory_total < cache->memory_used;
 }
+
+/* **************************** Strip thumbnails *************************** */
+
+/* Evict the entry furthest from `cfra`, so scrubbing around the playhead keeps its thumbnails
+ * while frames far off-screen are recycled first. */
+static void seq_thumbnail_evict_furthest(SeqCache *cache, float cfra)
+{
+  SeqThumbnailKey *furthest_key = NULL;
+  float furthest_distance = -1.0f;
+
+  GHashIterator gh_iter;
+  BLI_ghashIterator_init(&gh_iter, cache->thumbs_hash);
+  while (!BLI_ghashIterator_done(&gh_iter)) {
+    SeqThumbnailKey *key = BLI_ghashIterator_getKey(&gh_iter);
+    BLI_ghashIterator_step(&gh_iter);
+
+    float distance = fabsf(seq_cache_frame_index_to_cfra(key->seq, key->nfra) - cfra);
+    if (distance > furthest_distance) {
+      furthest_distance = distance;
+      furthest_key = key;
+    }
+  }
+
+  if (furthest_key) {
+    BLI_ghash_remove(
+        cache->thumbs_hash, furthest_key, seq_thumbnail_keyfree, seq_thumbnail_valfree);
+  }
+}
+
+struct ImBuf *BKE_sequencer_thumbnail_cache_get(Scene *scene, Sequence *seq, float cfra)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (!cache) {
+    return NULL;
+  }
+
+  seq_cache_lock(scene);
+
+  SeqThumbnailKey key;
+  key.seq = seq;
+  key.nfra = seq_cache_cfra_to_frame_index(seq, cfra);
+
+  ImBuf *ibuf = BLI_ghash_lookup(cache->thumbs_hash, &key);
+  if (ibuf) {
+    IMB_refImBuf(ibuf);
+  }
+
+  seq_cache_unlock(scene);
+  return ibuf;
+}
+
+void BKE_sequencer_thumbnail_cache_put(
+    Main *bmain, Scene *scene, Sequence *seq, float cfra, struct ImBuf *ibuf)
+{
+  if (ibuf == NULL || seq == NULL) {
+    return;
+  }
+
+  if (!scene->ed->cache) {
+    seq_cache_create(bmain, scene);
+  }
+
+  seq_cache_lock(scene);
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+
+  if (BLI_ghash_len(cache->thumbs_hash) >= SEQ_THUMB_CACHE_LIMIT) {
+    seq_thumbnail_evict_furthest(cache, cfra);
+  }
+
+  SeqThumbnailKey *key = MEM_mallocN(sizeof(SeqThumbnailKey), "SeqThumbnailKey");
+  key->seq = seq;
+  key->nfra = seq_cache_cfra_to_frame_index(seq, cfra);
+
+  IMB_refImBuf(ibuf);
+  BLI_ghash_reinsert(cache->thumbs_hash, key, ibuf, seq_thumbnail_keyfree, seq_thumbnail_valfree);
+
+  seq_cache_unlock(scene);
+}
+
+/* Remove thumbnails of given strip, or all thumbnails when seq is NULL. */
+void BKE_sequencer_thumbnail_cache_cleanup(Scene *scene, Sequence *seq)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (!cache) {
+    return;
+  }
+
+  seq_cache_lock(scene);
+
+  GHashIterator gh_iter;
+  BLI_ghashIterator_init(&gh_iter, cache->thumbs_hash);
+  while (!BLI_ghashIterator_done(&gh_iter)) {
+    SeqThumbnailKey *key = BLI_ghashIterator_getKey(&gh_iter);
+    BLI_ghashIterator_step(&gh_iter);
+
+    if (seq == NULL || key->seq == seq) {
+      BLI_ghash_remove(cache->thumbs_hash, key, seq_thumbnail_keyfree, seq_thumbnail_valfree);
+    }
+  }
+
+  seq_cache_unlock(scene);
+}
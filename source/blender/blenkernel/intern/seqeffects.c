@@ -59,6 +59,10 @@
 
 #include "RE_pipeline.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 #include "BLF_api.h"
 
 static struct SeqEffectHandle get_sequence_effect_impl(int seq_type);
@@ -587,6 +591,45 @@ static void do_alphaunder_effect(const SeqRenderData *context,
 
 /*********************** Cross *************************/
 
+static void cross_effect_byte_row(const unsigned char *rt1,
+                                  const unsigned char *rt2,
+                                  unsigned char *rt,
+                                  int x,
+                                  int fac1,
+                                  int fac2)
+{
+#ifdef __SSE2__
+  /* Blend two pixels (eight channels) per iteration with 8.8 fixed point factors.
+   * The blended sum fits 16 bits since fac1 + fac2 == 256. */
+  const __m128i fac1_v = _mm_set1_epi16(fac1);
+  const __m128i fac2_v = _mm_set1_epi16(fac2);
+  const __m128i zero = _mm_setzero_si128();
+
+  for (; x >= 2; x -= 2) {
+    __m128i px1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)rt1), zero);
+    __m128i px2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)rt2), zero);
+    __m128i sum = _mm_add_epi16(_mm_mullo_epi16(px1, fac1_v), _mm_mullo_epi16(px2, fac2_v));
+    sum = _mm_srli_epi16(sum, 8);
+    _mm_storel_epi64((__m128i *)rt, _mm_packus_epi16(sum, sum));
+
+    rt1 += 8;
+    rt2 += 8;
+    rt += 8;
+  }
+#endif
+
+  while (x--) {
+    rt[0] = (fac1 * rt1[0] + fac2 * rt2[0]) >> 8;
+    rt[1] = (fac1 * rt1[1] + fac2 * rt2[1]) >> 8;
+    rt[2] = (fac1 * rt1[2] + fac2 * rt2[2]) >> 8;
+    rt[3] = (fac1 * rt1[3] + fac2 * rt2[3]) >> 8;
+
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
+  }
+}
+
 static void do_cross_effect_byte(float facf0,
                                  float facf1,
                                  int x,
@@ -596,10 +639,8 @@ static void do_cross_effect_byte(float facf0,
                                  unsigned char *out)
 {
   int fac1, fac2, fac3, fac4;
-  int xo;
   unsigned char *rt1, *rt2, *rt;
 
-  xo = x;
   rt1 = rect1;
   rt2 = rect2;
   rt = out;
@@ -610,45 +651,59 @@ static void do_cross_effect_byte(float facf0,
   fac3 = 256 - fac4;
 
   while (y--) {
-    x = xo;
-    while (x--) {
-      rt[0] = (fac1 * rt1[0] + fac2 * rt2[0]) >> 8;
-      rt[1] = (fac1 * rt1[1] + fac2 * rt2[1]) >> 8;
-      rt[2] = (fac1 * rt1[2] + fac2 * rt2[2]) >> 8;
-      rt[3] = (fac1 * rt1[3] + fac2 * rt2[3]) >> 8;
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    cross_effect_byte_row(rt1, rt2, rt, x, fac1, fac2);
+    rt1 += 4 * x;
+    rt2 += 4 * x;
+    rt += 4 * x;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
-      rt[0] = (fac3 * rt1[0] + fac4 * rt2[0]) >> 8;
-      rt[1] = (fac3 * rt1[1] + fac4 * rt2[1]) >> 8;
-      rt[2] = (fac3 * rt1[2] + fac4 * rt2[2]) >> 8;
-      rt[3] = (fac3 * rt1[3] + fac4 * rt2[3]) >> 8;
+    cross_effect_byte_row(rt1, rt2, rt, x, fac3, fac4);
+    rt1 += 4 * x;
+    rt2 += 4 * x;
+    rt += 4 * x;
+  }
+}
 
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+static void cross_effect_float_row(
+    const float *rt1, const float *rt2, float *rt, int x, float fac1, float fac2)
+{
+#ifdef __SSE2__
+  /* One pixel per vector, a lane per channel. */
+  const __m128 fac1_v = _mm_set1_ps(fac1);
+  const __m128 fac2_v = _mm_set1_ps(fac2);
+
+  for (; x > 0; x--) {
+    _mm_storeu_ps(rt,
+                  _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(rt1), fac1_v),
+                             _mm_mul_ps(_mm_loadu_ps(rt2), fac2_v)));
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
+  }
+#else
+  while (x--) {
+    rt[0] = fac1 * rt1[0] + fac2 * rt2[0];
+    rt[1] = fac1 * rt1[1] + fac2 * rt2[1];
+    rt[2] = fac1 * rt1[2] + fac2 * rt2[2];
+    rt[3] = fac1 * rt1[3] + fac2 * rt2[3];
+
+    rt1 += 4;
+    rt2 += 4;
+    rt += 4;
   }
+#endif
 }
 
 static void do_cross_effect_float(
     float facf0, float facf1, int x, int y, float *rect1, float *rect2, float *out)
 {
   float fac1, fac2, fac3, fac4;
-  int xo;
   float *rt1, *rt2, *rt;
 
-  xo = x;
   rt1 = rect1;
   rt2 = rect2;
   rt = out;
@@ -659,34 +714,20 @@ static void do_cross_effect_float(
   fac3 = 1.0f - fac4;
 
   while (y--) {
-    x = xo;
-    while (x--) {
-      rt[0] = fac1 * rt1[0] + fac2 * rt2[0];
-      rt[1] = fac1 * rt1[1] + fac2 * rt2[1];
-      rt[2] = fac1 * rt1[2] + fac2 * rt2[2];
-      rt[3] = fac1 * rt1[3] + fac2 * rt2[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    cross_effect_float_row(rt1, rt2, rt, x, fac1, fac2);
+    rt1 += 4 * x;
+    rt2 += 4 * x;
+    rt += 4 * x;
 
     if (y == 0) {
       break;
     }
     y--;
 
-    x = xo;
-    while (x--) {
-      rt[0] = fac3 * rt1[0] + fac4 * rt2[0];
-      rt[1] = fac3 * rt1[1] + fac4 * rt2[1];
-      rt[2] = fac3 * rt1[2] + fac4 * rt2[2];
-      rt[3] = fac3 * rt1[3] + fac4 * rt2[3];
-
-      rt1 += 4;
-      rt2 += 4;
-      rt += 4;
-    }
+    cross_effect_float_row(rt1, rt2, rt, x, fac3, fac4);
+    rt1 += 4 * x;
+    rt2 += 4 * x;
+    rt += 4 * x;
   }
 }
 
@@ -77,6 +77,8 @@ typedef struct PrefetchJob {
   /* prefetch area */
   float cfra;
   int num_frames_prefetched;
+  /** 1 renders ahead of the playhead, -1 behind it (backwards scrubbing). */
+  int direction;
 
   /* control */
   bool running;
@@ -181,15 +183,21 @@ static bool seq_prefetch_is_cache_full(Scene *scene)
 
 static float seq_prefetch_cfra(PrefetchJob *pfjob)
 {
-  return pfjob->cfra + pfjob->num_frames_prefetched;
+  return pfjob->cfra + pfjob->direction * pfjob->num_frames_prefetched;
 }
 
 void BKE_sequencer_prefetch_get_time_range(Scene *scene, int *start, int *end)
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(scene);
 
-  *start = pfjob->cfra;
-  *end = seq_prefetch_cfra(pfjob);
+  if (pfjob->direction == 1) {
+    *start = pfjob->cfra;
+    *end = seq_prefetch_cfra(pfjob);
+  }
+  else {
+    *start = seq_prefetch_cfra(pfjob);
+    *end = pfjob->cfra;
+  }
 }
 
 static void seq_prefetch_free_depsgraph(PrefetchJob *pfjob)
@@ -228,23 +236,38 @@ static void seq_prefetch_init_depsgraph(PrefetchJob *pfjob)
 static void seq_prefetch_update_area(PrefetchJob *pfjob)
 {
   int cfra = pfjob->scene->r.cfra;
+  int moved = cfra - (int)pfjob->cfra;
+
+  if (moved == 0) {
+    return;
+  }
+
+  /* Render behind the playhead only when the user is heading that way. Timeline playback
+   * always advances, so a backwards jump then is a loop, not a direction change. */
+  int direction = (moved < 0 && !seq_prefetch_is_playing(pfjob->bmain)) ? -1 : 1;
+
+  /* turn around */
+  if (direction != pfjob->direction) {
+    pfjob->direction = direction;
+    pfjob->cfra = cfra;
+    pfjob->num_frames_prefetched = 1;
+    return;
+  }
 
   /* rebase */
-  if (cfra > pfjob->cfra) {
-    int delta = cfra - pfjob->cfra;
+  if (direction * moved > 0) {
     pfjob->cfra = cfra;
-    pfjob->num_frames_prefetched -= delta;
+    pfjob->num_frames_prefetched -= direction * moved;
 
     if (pfjob->num_frames_prefetched <= 1) {
       pfjob->num_frames_prefetched = 1;
     }
+    return;
   }
 
   /* reset */
-  if (cfra < pfjob->cfra) {
-    pfjob->cfra = cfra;
-    pfjob->num_frames_prefetched = 1;
-  }
+  pfjob->cfra = cfra;
+  pfjob->num_frames_prefetched = 1;
 }
 
 void BKE_sequencer_prefetch_stop_all(void)
@@ -409,8 +432,12 @@ static bool seq_prefetch_do_skip_frame(Scene *scene)
 
 static bool seq_prefetch_need_suspend(PrefetchJob *pfjob)
 {
+  const Editing *ed = pfjob->scene->ed;
+  const float limit_cfra = (pfjob->direction == 1) ? pfjob->scene->r.efra : pfjob->scene->r.sfra;
+
   return seq_prefetch_is_cache_full(pfjob->scene) || seq_prefetch_is_scrubbing(pfjob->bmain) ||
-         (seq_prefetch_cfra(pfjob) >= pfjob->scene->r.efra);
+         (pfjob->direction * (seq_prefetch_cfra(pfjob) - limit_cfra) >= 0) ||
+         (ed->prefetch_frames > 0 && pfjob->num_frames_prefetched >= ed->prefetch_frames);
 }
 
 static void seq_prefetch_do_suspend(PrefetchJob *pfjob)
@@ -430,7 +457,8 @@ static void *seq_prefetch_frames(void *job)
 {
   PrefetchJob *pfjob = (PrefetchJob *)job;
 
-  while (seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra) {
+  while ((pfjob->direction == 1) ? (seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra) :
+                                   (seq_prefetch_cfra(pfjob) >= pfjob->scene->r.sfra)) {
     pfjob->scene_eval->ed->prefetch_job = NULL;
 
     seq_prefetch_update_depsgraph(pfjob);
@@ -461,7 +489,7 @@ static void *seq_prefetch_frames(void *job)
 
     /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
     if (pfjob->num_frames_prefetched > 5 &&
-        (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2) {
+        pfjob->direction * (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2) {
       break;
     }
 
@@ -498,6 +526,7 @@ static PrefetchJob *seq_prefetch_start(const SeqRenderData *context, float cfra)
       pfjob->bmain_eval = BKE_main_new();
 
       pfjob->scene = context->scene;
+      pfjob->direction = 1;
       seq_prefetch_init_depsgraph(pfjob);
     }
   }
@@ -48,6 +48,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -1783,6 +1784,148 @@ static void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
   }
 }
 
+/* ************************* strip thumbnails ************************** */
+
+/* Maximum height of a cached thumbnail, width follows the source aspect ratio. */
+#define SEQ_THUMB_HEIGHT 128
+
+/* Open a private anim for thumbnail decoding, so the job never touches seq->anims
+ * that the render thread is using. Existing proxies are reused through the index dir. */
+static struct anim *seq_thumbnail_open_anim(Scene *scene, Sequence *seq)
+{
+  char name[FILE_MAX];
+  Editing *ed = scene->ed;
+  StripProxy *proxy = seq->strip->proxy;
+
+  BLI_join_dirfile(name, sizeof(name), seq->strip->dir, seq->strip->stripdata->name);
+  BLI_path_abs(name, BKE_main_blendfile_path_from_global());
+
+  struct anim *anim = openanim(
+      name, IB_rect, seq->streamindex, seq->strip->colorspace_settings.name);
+  if (anim == NULL) {
+    return NULL;
+  }
+
+  if (proxy && ((proxy->storage & SEQ_STORAGE_PROXY_CUSTOM_DIR) != 0 ||
+                (ed->proxy_storage == SEQ_EDIT_PROXY_DIR_STORAGE))) {
+    char dir[FILE_MAX];
+    if (ed->proxy_storage == SEQ_EDIT_PROXY_DIR_STORAGE) {
+      BLI_strncpy(dir, ed->proxy_dir[0] ? ed->proxy_dir : "//BL_proxy", sizeof(dir));
+    }
+    else {
+      BLI_strncpy(dir, proxy->dir, sizeof(dir));
+    }
+    BLI_path_abs(dir, BKE_main_blendfile_path_from_global());
+    seq_proxy_index_dir_set(anim, dir);
+  }
+
+  return anim;
+}
+
+static ImBuf *seq_thumbnail_scale(ImBuf *ibuf)
+{
+  /* Drawing uses the byte rect directly. */
+  if (ibuf->rect_float && ibuf->rect == NULL) {
+    IMB_rect_from_float(ibuf);
+  }
+  if (ibuf->rect == NULL) {
+    IMB_freeImBuf(ibuf);
+    return NULL;
+  }
+  if (ibuf->rect_float) {
+    imb_freerectfloatImBuf(ibuf);
+  }
+
+  if (ibuf->y > SEQ_THUMB_HEIGHT) {
+    const int width = max_ii(1, ibuf->x * SEQ_THUMB_HEIGHT / ibuf->y);
+    IMB_scaleImBuf(ibuf, width, SEQ_THUMB_HEIGHT);
+  }
+
+  return ibuf;
+}
+
+/* Render thumbnails of a strip into the thumbnail cache, one every frame_step frames.
+ * Designed to run on a background job: sources are decoded with JPEG-sized proxies
+ * when available and already cached frames are skipped. */
+void BKE_sequencer_thumbnails_render(Main *bmain,
+                                     Scene *scene,
+                                     Sequence *seq,
+                                     int frame_start,
+                                     int frame_end,
+                                     int frame_step,
+                                     const short *stop)
+{
+  struct anim *anim = NULL;
+
+  if (!ELEM(seq->type, SEQ_TYPE_MOVIE, SEQ_TYPE_IMAGE)) {
+    return;
+  }
+
+  if (seq->type == SEQ_TYPE_MOVIE) {
+    anim = seq_thumbnail_open_anim(scene, seq);
+    if (anim == NULL) {
+      return;
+    }
+  }
+
+  /* Decode at proxy resolution when proxies are built, thumbnails are scaled down anyway. */
+  IMB_Proxy_Size psize = (seq->flag & SEQ_USE_PROXY) ? IMB_PROXY_25 : IMB_PROXY_NONE;
+
+  frame_step = max_ii(frame_step, 1);
+
+  for (int cfra = frame_start; cfra <= frame_end && !*stop; cfra += frame_step) {
+    if (cfra < seq->startdisp || cfra >= seq->enddisp) {
+      continue;
+    }
+
+    ImBuf *ibuf = BKE_sequencer_thumbnail_cache_get(scene, seq, cfra);
+    if (ibuf) {
+      IMB_freeImBuf(ibuf);
+      continue;
+    }
+
+    if (seq->type == SEQ_TYPE_MOVIE) {
+      float nr = BKE_sequencer_give_stripelem_index(seq, cfra);
+      ibuf = IMB_anim_absolute(anim,
+                               nr + seq->anim_startofs,
+                               seq->strip->proxy ? seq->strip->proxy->tc : IMB_TC_RECORD_RUN,
+                               psize);
+      /* Fetching for requested proxy size failed, try fetching the original instead. */
+      if (ibuf == NULL && psize != IMB_PROXY_NONE) {
+        ibuf = IMB_anim_absolute(anim,
+                                 nr + seq->anim_startofs,
+                                 seq->strip->proxy ? seq->strip->proxy->tc : IMB_TC_RECORD_RUN,
+                                 IMB_PROXY_NONE);
+      }
+    }
+    else {
+      StripElem *s_elem = BKE_sequencer_give_stripelem(seq, cfra);
+      if (s_elem) {
+        char name[FILE_MAX];
+        BLI_join_dirfile(name, sizeof(name), seq->strip->dir, s_elem->name);
+        BLI_path_abs(name, BKE_main_blendfile_path_from_global());
+        ibuf = IMB_loadiffname(name, IB_rect, seq->strip->colorspace_settings.name);
+      }
+    }
+
+    if (ibuf == NULL) {
+      continue;
+    }
+
+    ibuf = seq_thumbnail_scale(ibuf);
+    if (ibuf == NULL) {
+      continue;
+    }
+
+    BKE_sequencer_thumbnail_cache_put(bmain, scene, seq, cfra, ibuf);
+    IMB_freeImBuf(ibuf);
+  }
+
+  if (anim) {
+    IMB_free_anim(anim);
+  }
+}
+
 static bool seq_proxy_get_fname(Editing *ed,
                                 Sequence *seq,
                                 int cfra,
@@ -2175,6 +2318,14 @@ bool BKE_sequencer_proxy_rebuild_context(Main *bmain,
   return true;
 }
 
+bool BKE_sequencer_proxy_rebuild_parallel_supported(SeqIndexBuildContext *context)
+{
+  /* Movie strips rebuild through the imbuf indexer and every context owns a private decoder,
+   * so they can run concurrently. Other strip types render their frames through the sequencer
+   * pipeline, which is not re-entrant. */
+  return context->seq->type == SEQ_TYPE_MOVIE;
+}
+
 void BKE_sequencer_proxy_rebuild(SeqIndexBuildContext *context,
                                  short *stop,
                                  short *do_update,
@@ -3956,6 +4107,35 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+typedef struct RenderStripTask {
+  const SeqRenderData *context;
+  Sequence *seq;
+  float cfra;
+  ImBuf **r_ibuf;
+} RenderStripTask;
+
+static void seq_render_strip_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  RenderStripTask *task = taskdata;
+  SeqRenderState state;
+
+  sequencer_state_init(&state);
+  *task->r_ibuf = seq_render_strip(task->context, &state, task->seq, task->cfra);
+}
+
+/* Strip types that only touch their own runtime data (own anim handle, plain file reads)
+ * while rendering, so independent layers can render concurrently before the blend pass.
+ * Scene, meta and similar strips pull shared state into the render, and modifiers can do
+ * the same through their mask input strip. */
+static bool seq_render_strip_is_independent(Sequence *seq)
+{
+  if (seq->modifiers.first != NULL) {
+    return false;
+  }
+
+  return ELEM(seq->type, SEQ_TYPE_MOVIE, SEQ_TYPE_IMAGE);
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
@@ -4024,13 +4204,43 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+
+  /* Render independent layers of the blend pass concurrently. The blending below stays
+   * serial and picks up the results. */
+  ImBuf *prerendered[MAXSEQ + 1] = {NULL};
+  RenderStripTask tasks[MAXSEQ + 1];
+  int num_tasks = 0;
+
+  for (int j = i; j < count; j++) {
+    Sequence *seq = seq_arr[j];
+
+    if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT &&
+        seq_render_strip_is_independent(seq)) {
+      tasks[num_tasks].context = context;
+      tasks[num_tasks].seq = seq;
+      tasks[num_tasks].cfra = cfra;
+      tasks[num_tasks].r_ibuf = &prerendered[j];
+      num_tasks++;
+    }
+  }
+
+  if (num_tasks > 1) {
+    TaskPool *task_pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    for (int j = 0; j < num_tasks; j++) {
+      BLI_task_pool_push(task_pool, seq_render_strip_task, &tasks[j], false, NULL);
+    }
+    BLI_task_pool_work_and_wait(task_pool);
+    BLI_task_pool_free(task_pool);
+  }
+
   for (; i < count; i++) {
     begin = seq_estimate_render_cost_begin();
     Sequence *seq = seq_arr[i];
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, cfra);
+      ImBuf *ibuf2 = (prerendered[i] != NULL) ? prerendered[i] :
+                                                seq_render_strip(context, state, seq, cfra);
 
       out = seq_render_strip_stack_apply_effect(context, seq, cfra, ibuf1, ibuf2);
 
@@ -26,6 +26,7 @@
 #include <math.h>
 #include <memory.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
@@ -99,8 +100,87 @@ typedef struct ShrinkwrapCalcCBData {
 
   float *proj_axis;
   SpaceTransform *local2aux;
+
+  /* Optional spatial ordering of the vertices, see #shrinkwrap_order_verts_spatial. */
+  const int *vert_order;
 } ShrinkwrapCalcCBData;
 
+typedef struct ShrinkwrapSpatialOrderVert {
+  uint code;
+  int index;
+} ShrinkwrapSpatialOrderVert;
+
+/* Spread the lowest 10 bits of n over every third bit, for Morton code interleaving. */
+BLI_INLINE uint shrinkwrap_morton_part_1by2(uint n)
+{
+  n &= 0x3ff;
+  n = (n ^ (n << 16)) & 0xff0000ff;
+  n = (n ^ (n << 8)) & 0x0300f00f;
+  n = (n ^ (n << 4)) & 0x030c30c3;
+  n = (n ^ (n << 2)) & 0x09249249;
+  return n;
+}
+
+static int shrinkwrap_spatial_order_cmp(const void *a_v, const void *b_v)
+{
+  const ShrinkwrapSpatialOrderVert *a = a_v, *b = b_v;
+  if (a->code != b->code) {
+    return (a->code < b->code) ? -1 : 1;
+  }
+  /* Keep mesh order within a cell, so the ordering is fully deterministic. */
+  return (a->index < b->index) ? -1 : 1;
+}
+
+/**
+ * Order the query vertices along a coarse space-filling (Morton) curve.
+ *
+ * Successive nearest queries then tend to land on nearby parts of the target, which keeps the
+ * upper levels of the BVH in cache and makes the proximity heuristic in the callbacks (seeding
+ * the search radius from the previous hit) effective even when the mesh vertex order jumps
+ * around the model. Returns NULL for small vertex counts, where the sort isn't worth it;
+ * the callers then simply keep mesh order.
+ */
+static int *shrinkwrap_order_verts_spatial(const ShrinkwrapCalcData *calc)
+{
+  if (calc->numVerts <= BKE_MESH_OMP_LIMIT) {
+    return NULL;
+  }
+
+  ShrinkwrapSpatialOrderVert *sort_verts = MEM_malloc_arrayN(
+      (size_t)calc->numVerts, sizeof(*sort_verts), __func__);
+
+  float min[3], max[3], scale[3];
+  INIT_MINMAX(min, max);
+  for (int i = 0; i < calc->numVerts; i++) {
+    minmax_v3v3_v3(min, max, calc->vert ? calc->vert[i].co : calc->vertexCos[i]);
+  }
+  for (int axis = 0; axis < 3; axis++) {
+    const float size = max[axis] - min[axis];
+    scale[axis] = (size > FLT_EPSILON) ? 1023.0f / size : 0.0f;
+  }
+
+  for (int i = 0; i < calc->numVerts; i++) {
+    const float *co = calc->vert ? calc->vert[i].co : calc->vertexCos[i];
+    uint code = 0;
+    for (int axis = 0; axis < 3; axis++) {
+      const uint cell = (uint)((co[axis] - min[axis]) * scale[axis]);
+      code |= shrinkwrap_morton_part_1by2(cell) << axis;
+    }
+    sort_verts[i].code = code;
+    sort_verts[i].index = i;
+  }
+
+  qsort(sort_verts, (size_t)calc->numVerts, sizeof(*sort_verts), shrinkwrap_spatial_order_cmp);
+
+  int *order = MEM_malloc_arrayN((size_t)calc->numVerts, sizeof(int), __func__);
+  for (int i = 0; i < calc->numVerts; i++) {
+    order[i] = sort_verts[i].index;
+  }
+  MEM_freeN(sort_verts);
+
+  return order;
+}
+
 /* Checks if the modifier needs target normals with these settings. */
 bool BKE_shrinkwrap_needs_normals(int shrinkType, int shrinkMode)
 {
@@ -344,7 +424,7 @@ void BKE_shrinkwrap_compute_boundary_data(struct Mesh *mesh)
  * for each vertex performs a nearest vertex search on the tree
  */
 static void shrinkwrap_calc_nearest_vertex_cb_ex(void *__restrict userdata,
-                                                 const int i,
+                                                 const int iter,
                                                  const TaskParallelTLS *__restrict tls)
 {
   ShrinkwrapCalcCBData *data = userdata;
@@ -353,6 +433,8 @@ static void shrinkwrap_calc_nearest_vertex_cb_ex(void *__restrict userdata,
   BVHTreeFromMesh *treeData = &data->tree->treeData;
   BVHTreeNearest *nearest = tls->userdata_chunk;
 
+  const int i = data->vert_order ? data->vert_order[iter] : iter;
+
   float *co = calc->vertexCos[i];
   float tmp_co[3];
   float weight = BKE_defvert_array_find_weight_safe(calc->dvert, i, calc->vgroup);
@@ -413,9 +495,12 @@ static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
   nearest.index = -1;
   nearest.dist_sq = FLT_MAX;
 
+  int *vert_order = shrinkwrap_order_verts_spatial(calc);
+
   ShrinkwrapCalcCBData data = {
       .calc = calc,
       .tree = calc->tree,
+      .vert_order = vert_order,
   };
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
@@ -424,6 +509,8 @@ static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
   settings.userdata_chunk_size = sizeof(nearest);
   BLI_task_parallel_range(
       0, calc->numVerts, &data, shrinkwrap_calc_nearest_vertex_cb_ex, &settings);
+
+  MEM_SAFE_FREE(vert_order);
 }
 
 /*
@@ -1120,7 +1207,7 @@ void BKE_shrinkwrap_find_nearest_surface(struct ShrinkwrapTreeData *tree,
  * NN matches for each vertex
  */
 static void shrinkwrap_calc_nearest_surface_point_cb_ex(void *__restrict userdata,
-                                                        const int i,
+                                                        const int iter,
                                                         const TaskParallelTLS *__restrict tls)
 {
   ShrinkwrapCalcCBData *data = userdata;
@@ -1128,6 +1215,8 @@ static void shrinkwrap_calc_nearest_surface_point_cb_ex(void *__restrict userdat
   ShrinkwrapCalcData *calc = data->calc;
   BVHTreeNearest *nearest = tls->userdata_chunk;
 
+  const int i = data->vert_order ? data->vert_order[iter] : iter;
+
   float *co = calc->vertexCos[i];
   float tmp_co[3];
   float weight = BKE_defvert_array_find_weight_safe(calc->dvert, i, calc->vgroup);
@@ -1382,10 +1471,13 @@ static void shrinkwrap_calc_nearest_surface_point(ShrinkwrapCalcData *calc)
   nearest.index = -1;
   nearest.dist_sq = FLT_MAX;
 
+  int *vert_order = shrinkwrap_order_verts_spatial(calc);
+
   /* Find the nearest vertex */
   ShrinkwrapCalcCBData data = {
       .calc = calc,
       .tree = calc->tree,
+      .vert_order = vert_order,
   };
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
@@ -1394,6 +1486,8 @@ static void shrinkwrap_calc_nearest_surface_point(ShrinkwrapCalcData *calc)
   settings.userdata_chunk_size = sizeof(nearest);
   BLI_task_parallel_range(
       0, calc->numVerts, &data, shrinkwrap_calc_nearest_surface_point_cb_ex, &settings);
+
+  MEM_SAFE_FREE(vert_order);
 }
 
 /* Main shrinkwrap function */
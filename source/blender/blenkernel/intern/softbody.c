@@ -56,6 +56,7 @@
 #include "DNA_scene_types.h"
 
 #include "BLI_ghash.h"
+#include "BLI_kdopbvh.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_threads.h"
@@ -271,11 +272,101 @@ typedef struct ccd_Mesh {
   const MVertTri *tri;
   int safety;
   ccdf_minmax *mima;
+  /* BVH over the face AABBs in mima, so the collision scans don't have to visit every face. */
+  BVHTree *bvhtree;
   /* Axis Aligned Bounding Box AABB */
   float bbmin[3];
   float bbmax[3];
 } ccd_Mesh;
 
+/* Build or refit the face AABB tree, the leaf bounds are the mima boxes
+ * (hull padded, spanning current and previous vertex positions). */
+static void ccd_mesh_bvhtree_from_mima(ccd_Mesh *pccd_M, const bool create)
+{
+  const ccdf_minmax *mima;
+  int i;
+
+  if (create) {
+    pccd_M->bvhtree = BLI_bvhtree_new(pccd_M->tri_num, 0.0f, 4, 6);
+  }
+
+  for (i = 0, mima = pccd_M->mima; i < pccd_M->tri_num; i++, mima++) {
+    float bv[2][3] = {
+        {mima->minx, mima->miny, mima->minz},
+        {mima->maxx, mima->maxy, mima->maxz},
+    };
+
+    if (create) {
+      BLI_bvhtree_insert(pccd_M->bvhtree, i, bv[0], 2);
+    }
+    else {
+      BLI_bvhtree_update_node(pccd_M->bvhtree, i, bv[0], NULL, 2);
+    }
+  }
+
+  if (create) {
+    BLI_bvhtree_balance(pccd_M->bvhtree);
+  }
+  else {
+    BLI_bvhtree_update_tree(pccd_M->bvhtree);
+  }
+}
+
+/* Visit every face whose mima box overlaps the given AABB, through the tree. */
+
+typedef struct ccd_OverlapWalkData {
+  const float *aabbmin;
+  const float *aabbmax;
+  void (*test_fn)(int tri_index, void *test_data);
+  void *test_data;
+} ccd_OverlapWalkData;
+
+static bool ccd_overlap_walk_parent_cb(const BVHTreeAxisRange *bounds, void *userdata)
+{
+  const ccd_OverlapWalkData *data = userdata;
+
+  return (bounds[0].min <= data->aabbmax[0]) && (bounds[0].max >= data->aabbmin[0]) &&
+         (bounds[1].min <= data->aabbmax[1]) && (bounds[1].max >= data->aabbmin[1]) &&
+         (bounds[2].min <= data->aabbmax[2]) && (bounds[2].max >= data->aabbmin[2]);
+}
+
+static bool ccd_overlap_walk_leaf_cb(const BVHTreeAxisRange *bounds, int index, void *userdata)
+{
+  ccd_OverlapWalkData *data = userdata;
+
+  if (ccd_overlap_walk_parent_cb(bounds, userdata)) {
+    data->test_fn(index, data->test_data);
+  }
+  return true;
+}
+
+static bool ccd_overlap_walk_order_cb(const BVHTreeAxisRange *UNUSED(bounds),
+                                      char UNUSED(axis),
+                                      void *UNUSED(userdata))
+{
+  return true;
+}
+
+static void ccd_mesh_tris_overlapping_aabb(const ccd_Mesh *ccdm,
+                                           const float aabbmin[3],
+                                           const float aabbmax[3],
+                                           void (*test_fn)(int tri_index, void *test_data),
+                                           void *test_data)
+{
+  ccd_OverlapWalkData data = {
+      .aabbmin = aabbmin,
+      .aabbmax = aabbmax,
+      .test_fn = test_fn,
+      .test_data = test_data,
+  };
+
+  BLI_bvhtree_walk_dfs(ccdm->bvhtree,
+                       ccd_overlap_walk_parent_cb,
+                       ccd_overlap_walk_leaf_cb,
+                       ccd_overlap_walk_order_cb,
+                       &data);
+}
+
 static ccd_Mesh *ccd_mesh_make(Object *ob)
 {
   CollisionModifierData *cmd;
@@ -361,6 +452,8 @@ static ccd_Mesh *ccd_mesh_make(Object *ob)
     mima->maxz = max_ff(mima->maxz, v[2] + hull);
   }
 
+  ccd_mesh_bvhtree_from_mima(pccd_M, true);
+
   return pccd_M;
 }
 static void ccd_mesh_update(Object *ob, ccd_Mesh *pccd_M)
@@ -481,7 +574,9 @@ static void ccd_mesh_update(Object *ob, ccd_Mesh *pccd_M)
     mima->maxy = max_ff(mima->maxy, v[1] + hull);
     mima->maxz = max_ff(mima->maxz, v[2] + hull);
   }
-  return;
+
+  /* The topology is unchanged, refitting the tree is enough. */
+  ccd_mesh_bvhtree_from_mima(pccd_M, false);
 }
 
 static void ccd_mesh_free(ccd_Mesh *ccdm)
@@ -494,6 +589,7 @@ static void ccd_mesh_free(ccd_Mesh *ccdm)
       MEM_freeN((void *)ccdm->mprevvert);
     }
     MEM_freeN(ccdm->mima);
+    BLI_bvhtree_free(ccdm->bvhtree);
     MEM_freeN(ccdm);
     ccdm = NULL;
   }
@@ -1146,6 +1242,57 @@ static int sb_detect_face_pointCached(float face_v1[3],
   return deflected;
 }
 
+typedef struct ccd_FaceCollTestData {
+  const ccd_Mesh *ccdm;
+  Object *ob;
+  const float *face_v1, *face_v2, *face_v3;
+  float *damp;
+  float *force;
+  float time;
+  int deflected;
+} ccd_FaceCollTestData;
+
+static void ccd_face_coll_test(int tri_index, void *test_data)
+{
+  ccd_FaceCollTestData *data = test_data;
+  const ccd_Mesh *ccdm = data->ccdm;
+  const MVertTri *vt = &ccdm->tri[tri_index];
+  const MVert *mvert = ccdm->mvert;
+  const MVert *mprevvert = ccdm->mprevvert;
+  const float time = data->time;
+  const float tune = 10.0f;
+  float nv1[3], nv2[3], nv3[3], edge1[3], edge2[3], d_nvect[3];
+  float t;
+
+  copy_v3_v3(nv1, mvert[vt->tri[0]].co);
+  copy_v3_v3(nv2, mvert[vt->tri[1]].co);
+  copy_v3_v3(nv3, mvert[vt->tri[2]].co);
+
+  if (mprevvert) {
+    mul_v3_fl(nv1, time);
+    madd_v3_v3fl(nv1, mprevvert[vt->tri[0]].co, 1.0f - time);
+
+    mul_v3_fl(nv2, time);
+    madd_v3_v3fl(nv2, mprevvert[vt->tri[1]].co, 1.0f - time);
+
+    mul_v3_fl(nv3, time);
+    madd_v3_v3fl(nv3, mprevvert[vt->tri[2]].co, 1.0f - time);
+  }
+
+  /* switch origin to be nv2*/
+  sub_v3_v3v3(edge1, nv1, nv2);
+  sub_v3_v3v3(edge2, nv3, nv2);
+  cross_v3_v3v3(d_nvect, edge2, edge1);
+  normalize_v3(d_nvect);
+  if (isect_line_segment_tri_v3(nv1, nv2, data->face_v1, data->face_v2, data->face_v3, &t, NULL) ||
+      isect_line_segment_tri_v3(nv2, nv3, data->face_v1, data->face_v2, data->face_v3, &t, NULL) ||
+      isect_line_segment_tri_v3(nv3, nv1, data->face_v1, data->face_v2, data->face_v3, &t, NULL)) {
+    madd_v3_v3fl(data->force, d_nvect, -0.5f);
+    *data->damp = tune * data->ob->pd->pdef_sbdamp;
+    data->deflected = 2;
+  }
+}
+
 static int sb_detect_face_collisionCached(float face_v1[3],
                                           const float face_v2[3],
                                           const float face_v3[3],
@@ -1157,9 +1304,8 @@ static int sb_detect_face_collisionCached(float face_v1[3],
   Object *ob;
   GHash *hash;
   GHashIterator *ihash;
-  float nv1[3], nv2[3], nv3[3], edge1[3], edge2[3], d_nvect[3], aabbmin[3], aabbmax[3];
-  float t, tune = 10.0f;
-  int a, deflected = 0;
+  float aabbmin[3], aabbmax[3];
+  int deflected = 0;
 
   aabbmin[0] = min_fff(face_v1[0], face_v2[0], face_v3[0]);
   aabbmin[1] = min_fff(face_v1[1], face_v2[1], face_v3[1]);
@@ -1177,18 +1323,7 @@ static int sb_detect_face_collisionCached(float face_v1[3],
     {
       /* only with deflecting set */
       if (ob->pd && ob->pd->deflect) {
-        const MVert *mvert = NULL;
-        const MVert *mprevvert = NULL;
-        const MVertTri *vt = NULL;
-        const ccdf_minmax *mima = NULL;
-
         if (ccdm) {
-          mvert = ccdm->mvert;
-          vt = ccdm->tri;
-          mprevvert = ccdm->mprevvert;
-          mima = ccdm->mima;
-          a = ccdm->tri_num;
-
           if ((aabbmax[0] < ccdm->bbmin[0]) || (aabbmax[1] < ccdm->bbmin[1]) ||
               (aabbmax[2] < ccdm->bbmin[2]) || (aabbmin[0] > ccdm->bbmax[0]) ||
               (aabbmin[1] > ccdm->bbmax[1]) || (aabbmin[2] > ccdm->bbmax[2])) {
@@ -1205,49 +1340,20 @@ static int sb_detect_face_collisionCached(float face_v1[3],
         }
 
         /* use mesh*/
-        while (a--) {
-          if ((aabbmax[0] < mima->minx) || (aabbmin[0] > mima->maxx) ||
-              (aabbmax[1] < mima->miny) || (aabbmin[1] > mima->maxy) ||
-              (aabbmax[2] < mima->minz) || (aabbmin[2] > mima->maxz)) {
-            mima++;
-            vt++;
-            continue;
-          }
-
-          if (mvert) {
-
-            copy_v3_v3(nv1, mvert[vt->tri[0]].co);
-            copy_v3_v3(nv2, mvert[vt->tri[1]].co);
-            copy_v3_v3(nv3, mvert[vt->tri[2]].co);
-
-            if (mprevvert) {
-              mul_v3_fl(nv1, time);
-              madd_v3_v3fl(nv1, mprevvert[vt->tri[0]].co, 1.0f - time);
-
-              mul_v3_fl(nv2, time);
-              madd_v3_v3fl(nv2, mprevvert[vt->tri[1]].co, 1.0f - time);
-
-              mul_v3_fl(nv3, time);
-              madd_v3_v3fl(nv3, mprevvert[vt->tri[2]].co, 1.0f - time);
-            }
-          }
-
-          /* switch origin to be nv2*/
-          sub_v3_v3v3(edge1, nv1, nv2);
-          sub_v3_v3v3(edge2, nv3, nv2);
-          cross_v3_v3v3(d_nvect, edge2, edge1);
-          normalize_v3(d_nvect);
-          if (isect_line_segment_tri_v3(nv1, nv2, face_v1, face_v2, face_v3, &t, NULL) ||
-              isect_line_segment_tri_v3(nv2, nv3, face_v1, face_v2, face_v3, &t, NULL) ||
-              isect_line_segment_tri_v3(nv3, nv1, face_v1, face_v2, face_v3, &t, NULL)) {
-            madd_v3_v3fl(force, d_nvect, -0.5f);
-            *damp = tune * ob->pd->pdef_sbdamp;
-            deflected = 2;
-          }
-          mima++;
-          vt++;
-        } /* while a */
-      }   /* if (ob->pd && ob->pd->deflect) */
+        ccd_FaceCollTestData test_data = {
+            .ccdm = ccdm,
+            .ob = ob,
+            .face_v1 = face_v1,
+            .face_v2 = face_v2,
+            .face_v3 = face_v3,
+            .damp = damp,
+            .force = force,
+            .time = time,
+            .deflected = deflected,
+        };
+        ccd_mesh_tris_overlapping_aabb(ccdm, aabbmin, aabbmax, ccd_face_coll_test, &test_data);
+        deflected = test_data.deflected;
+      } /* if (ob->pd && ob->pd->deflect) */
       BLI_ghashIterator_step(ihash);
     }
   } /* while () */
@@ -1325,6 +1431,63 @@ static void scan_for_ext_face_forces(Object *ob, float timenow)
 
 /* +++ the spring external section*/
 
+typedef struct ccd_EdgeCollTestData {
+  const ccd_Mesh *ccdm;
+  Object *ob;
+  const float *edge_v1, *edge_v2;
+  float el;
+  float *damp;
+  float *force;
+  float time;
+  int deflected;
+} ccd_EdgeCollTestData;
+
+static void ccd_edge_coll_test(int tri_index, void *test_data)
+{
+  ccd_EdgeCollTestData *data = test_data;
+  const ccd_Mesh *ccdm = data->ccdm;
+  const MVertTri *vt = &ccdm->tri[tri_index];
+  const MVert *mvert = ccdm->mvert;
+  const MVert *mprevvert = ccdm->mprevvert;
+  const float time = data->time;
+  float nv1[3], nv2[3], nv3[3], edge1[3], edge2[3], d_nvect[3];
+  float t;
+
+  copy_v3_v3(nv1, mvert[vt->tri[0]].co);
+  copy_v3_v3(nv2, mvert[vt->tri[1]].co);
+  copy_v3_v3(nv3, mvert[vt->tri[2]].co);
+
+  if (mprevvert) {
+    mul_v3_fl(nv1, time);
+    madd_v3_v3fl(nv1, mprevvert[vt->tri[0]].co, 1.0f - time);
+
+    mul_v3_fl(nv2, time);
+    madd_v3_v3fl(nv2, mprevvert[vt->tri[1]].co, 1.0f - time);
+
+    mul_v3_fl(nv3, time);
+    madd_v3_v3fl(nv3, mprevvert[vt->tri[2]].co, 1.0f - time);
+  }
+
+  /* switch origin to be nv2*/
+  sub_v3_v3v3(edge1, nv1, nv2);
+  sub_v3_v3v3(edge2, nv3, nv2);
+
+  cross_v3_v3v3(d_nvect, edge2, edge1);
+  normalize_v3(d_nvect);
+  if (isect_line_segment_tri_v3(data->edge_v1, data->edge_v2, nv1, nv2, nv3, &t, NULL)) {
+    float v1[3], v2[3];
+    float intrusiondepth, i1, i2;
+    sub_v3_v3v3(v1, data->edge_v1, nv2);
+    sub_v3_v3v3(v2, data->edge_v2, nv2);
+    i1 = dot_v3v3(v1, d_nvect);
+    i2 = dot_v3v3(v2, d_nvect);
+    intrusiondepth = -min_ff(i1, i2) / data->el;
+    madd_v3_v3fl(data->force, d_nvect, intrusiondepth);
+    *data->damp = data->ob->pd->pdef_sbdamp;
+    data->deflected = 2;
+  }
+}
+
 static int sb_detect_edge_collisionCached(float edge_v1[3],
                                           const float edge_v2[3],
                                           float *damp,
@@ -1335,9 +1498,9 @@ static int sb_detect_edge_collisionCached(float edge_v1[3],
   Object *ob;
   GHash *hash;
   GHashIterator *ihash;
-  float nv1[3], nv2[3], nv3[3], edge1[3], edge2[3], d_nvect[3], aabbmin[3], aabbmax[3];
-  float t, el;
-  int a, deflected = 0;
+  float aabbmin[3], aabbmax[3];
+  float el;
+  int deflected = 0;
 
   minmax_v3v3_v3(aabbmin, aabbmax, edge_v1);
   minmax_v3v3_v3(aabbmin, aabbmax, edge_v2);
@@ -1353,18 +1516,7 @@ static int sb_detect_edge_collisionCached(float edge_v1[3],
     {
       /* only with deflecting set */
       if (ob->pd && ob->pd->deflect) {
-        const MVert *mvert = NULL;
-        const MVert *mprevvert = NULL;
-        const MVertTri *vt = NULL;
-        const ccdf_minmax *mima = NULL;
-
         if (ccdm) {
-          mvert = ccdm->mvert;
-          mprevvert = ccdm->mprevvert;
-          vt = ccdm->tri;
-          mima = ccdm->mima;
-          a = ccdm->tri_num;
-
           if ((aabbmax[0] < ccdm->bbmin[0]) || (aabbmax[1] < ccdm->bbmin[1]) ||
               (aabbmax[2] < ccdm->bbmin[2]) || (aabbmin[0] > ccdm->bbmax[0]) ||
               (aabbmin[1] > ccdm->bbmax[1]) || (aabbmin[2] > ccdm->bbmax[2])) {
@@ -1381,56 +1533,20 @@ static int sb_detect_edge_collisionCached(float edge_v1[3],
         }
 
         /* use mesh*/
-        while (a--) {
-          if ((aabbmax[0] < mima->minx) || (aabbmin[0] > mima->maxx) ||
-              (aabbmax[1] < mima->miny) || (aabbmin[1] > mima->maxy) ||
-              (aabbmax[2] < mima->minz) || (aabbmin[2] > mima->maxz)) {
-            mima++;
-            vt++;
-            continue;
-          }
-
-          if (mvert) {
-
-            copy_v3_v3(nv1, mvert[vt->tri[0]].co);
-            copy_v3_v3(nv2, mvert[vt->tri[1]].co);
-            copy_v3_v3(nv3, mvert[vt->tri[2]].co);
-
-            if (mprevvert) {
-              mul_v3_fl(nv1, time);
-              madd_v3_v3fl(nv1, mprevvert[vt->tri[0]].co, 1.0f - time);
-
-              mul_v3_fl(nv2, time);
-              madd_v3_v3fl(nv2, mprevvert[vt->tri[1]].co, 1.0f - time);
-
-              mul_v3_fl(nv3, time);
-              madd_v3_v3fl(nv3, mprevvert[vt->tri[2]].co, 1.0f - time);
-            }
-          }
-
-          /* switch origin to be nv2*/
-          sub_v3_v3v3(edge1, nv1, nv2);
-          sub_v3_v3v3(edge2, nv3, nv2);
-
-          cross_v3_v3v3(d_nvect, edge2, edge1);
-          normalize_v3(d_nvect);
-          if (isect_line_segment_tri_v3(edge_v1, edge_v2, nv1, nv2, nv3, &t, NULL)) {
-            float v1[3], v2[3];
-            float intrusiondepth, i1, i2;
-            sub_v3_v3v3(v1, edge_v1, nv2);
-            sub_v3_v3v3(v2, edge_v2, nv2);
-            i1 = dot_v3v3(v1, d_nvect);
-            i2 = dot_v3v3(v2, d_nvect);
-            intrusiondepth = -min_ff(i1, i2) / el;
-            madd_v3_v3fl(force, d_nvect, intrusiondepth);
-            *damp = ob->pd->pdef_sbdamp;
-            deflected = 2;
-          }
-
-          mima++;
-          vt++;
-        } /* while a */
-      }   /* if (ob->pd && ob->pd->deflect) */
+        ccd_EdgeCollTestData test_data = {
+            .ccdm = ccdm,
+            .ob = ob,
+            .edge_v1 = edge_v1,
+            .edge_v2 = edge_v2,
+            .el = el,
+            .damp = damp,
+            .force = force,
+            .time = time,
+            .deflected = deflected,
+        };
+        ccd_mesh_tris_overlapping_aabb(ccdm, aabbmin, aabbmax, ccd_edge_coll_test, &test_data);
+        deflected = test_data.deflected;
+      } /* if (ob->pd && ob->pd->deflect) */
       BLI_ghashIterator_step(ihash);
     }
   } /* while () */
@@ -1618,6 +1734,99 @@ static int choose_winner(
   return (winner);
 }
 
+typedef struct ccd_VertexCollTestData {
+  const ccd_Mesh *ccdm;
+  Object *ob;
+  float *opco;
+  float time;
+  float innerfacethickness, outerfacethickness;
+  float ee, ff, fa;
+  float *damp;
+  float *outerforceaccu;
+  float *innerforceaccu;
+  float *avel;
+  float *intrusion;
+  int *cavel;
+  int *ci;
+  int *deflected;
+} ccd_VertexCollTestData;
+
+static void ccd_vertex_coll_test(int tri_index, void *test_data)
+{
+  ccd_VertexCollTestData *data = test_data;
+  const ccd_Mesh *ccdm = data->ccdm;
+  const MVertTri *vt = &ccdm->tri[tri_index];
+  const MVert *mvert = ccdm->mvert;
+  const MVert *mprevvert = ccdm->mprevvert;
+  const float time = data->time;
+  float nv1[3], nv2[3], nv3[3], edge1[3], edge2[3], d_nvect[3], dv1[3], ve[3];
+  float vv1[3], vv2[3], vv3[3];
+  float facedist, force_mag_norm;
+
+  copy_v3_v3(nv1, mvert[vt->tri[0]].co);
+  copy_v3_v3(nv2, mvert[vt->tri[1]].co);
+  copy_v3_v3(nv3, mvert[vt->tri[2]].co);
+
+  if (mprevvert) {
+    /* Grab the average speed of the collider vertices before we spoil nvX
+     * humm could be done once a SB steps but then we' need to store that too
+     * since the AABB reduced probability to get here drastically
+     * it might be a nice tradeoff CPU <--> memory.
+     */
+    sub_v3_v3v3(vv1, nv1, mprevvert[vt->tri[0]].co);
+    sub_v3_v3v3(vv2, nv2, mprevvert[vt->tri[1]].co);
+    sub_v3_v3v3(vv3, nv3, mprevvert[vt->tri[2]].co);
+
+    mul_v3_fl(nv1, time);
+    madd_v3_v3fl(nv1, mprevvert[vt->tri[0]].co, 1.0f - time);
+
+    mul_v3_fl(nv2, time);
+    madd_v3_v3fl(nv2, mprevvert[vt->tri[1]].co, 1.0f - time);
+
+    mul_v3_fl(nv3, time);
+    madd_v3_v3fl(nv3, mprevvert[vt->tri[2]].co, 1.0f - time);
+  }
+
+  /* switch origin to be nv2*/
+  sub_v3_v3v3(edge1, nv1, nv2);
+  sub_v3_v3v3(edge2, nv3, nv2);
+  /* Abuse dv1 to have vertex in question at *origin* of triangle. */
+  sub_v3_v3v3(dv1, data->opco, nv2);
+
+  cross_v3_v3v3(d_nvect, edge2, edge1);
+  normalize_v3(d_nvect);
+  facedist = dot_v3v3(dv1, d_nvect);
+
+  if ((facedist > data->innerfacethickness) && (facedist < data->outerfacethickness)) {
+    if (isect_point_tri_prism_v3(data->opco, nv1, nv2, nv3)) {
+      force_mag_norm = (float)exp(-data->ee * facedist);
+      if (facedist > data->outerfacethickness * data->ff) {
+        force_mag_norm = (float)force_mag_norm * data->fa * (facedist - data->outerfacethickness) *
+                         (facedist - data->outerfacethickness);
+      }
+      *data->damp = data->ob->pd->pdef_sbdamp;
+      if (facedist > 0.0f) {
+        *data->damp *= (1.0f - facedist / data->outerfacethickness);
+        madd_v3_v3fl(data->outerforceaccu, d_nvect, force_mag_norm);
+        *data->deflected = 3;
+      }
+      else {
+        madd_v3_v3fl(data->innerforceaccu, d_nvect, force_mag_norm);
+        if (*data->deflected < 2) {
+          *data->deflected = 2;
+        }
+      }
+      if ((mprevvert) && (*data->damp > 0.0f)) {
+        choose_winner(ve, data->opco, nv1, nv2, nv3, vv1, vv2, vv3);
+        add_v3_v3(data->avel, ve);
+        (*data->cavel)++;
+      }
+      *data->intrusion += facedist;
+      (*data->ci)++;
+    }
+  }
+}
+
 static int sb_detect_vertex_collisionCached(float opco[3],
                                             float facenormal[3],
                                             float *damp,
@@ -1630,12 +1839,10 @@ static int sb_detect_vertex_collisionCached(float opco[3],
   Object *ob = NULL;
   GHash *hash;
   GHashIterator *ihash;
-  float nv1[3], nv2[3], nv3[3], edge1[3], edge2[3], d_nvect[3], dv1[3], ve[3],
-      avel[3] = {0.0, 0.0, 0.0}, vv1[3], vv2[3], vv3[3], coledge[3] = {0.0f, 0.0f, 0.0f},
-      mindistedge = 1000.0f, outerforceaccu[3], innerforceaccu[3], facedist,
-      /* n_mag, */ /* UNUSED */ force_mag_norm, minx, miny, minz, maxx, maxy, maxz,
+  float avel[3] = {0.0, 0.0, 0.0}, coledge[3] = {0.0f, 0.0f, 0.0f}, mindistedge = 1000.0f,
+      outerforceaccu[3], innerforceaccu[3], force_mag_norm,
       innerfacethickness = -0.5f, outerfacethickness = 0.2f, ee = 5.0f, ff = 0.1f, fa = 1;
-  int a, deflected = 0, cavel = 0, ci = 0;
+  int deflected = 0, cavel = 0, ci = 0;
   /* init */
   *intrusion = 0.0f;
   hash = vertexowner->soft->scratch->colliderhash;
@@ -1650,28 +1857,10 @@ static int sb_detect_vertex_collisionCached(float opco[3],
     {
       /* only with deflecting set */
       if (ob->pd && ob->pd->deflect) {
-        const MVert *mvert = NULL;
-        const MVert *mprevvert = NULL;
-        const MVertTri *vt = NULL;
-        const ccdf_minmax *mima = NULL;
-
         if (ccdm) {
-          mvert = ccdm->mvert;
-          mprevvert = ccdm->mprevvert;
-          vt = ccdm->tri;
-          mima = ccdm->mima;
-          a = ccdm->tri_num;
-
-          minx = ccdm->bbmin[0];
-          miny = ccdm->bbmin[1];
-          minz = ccdm->bbmin[2];
-
-          maxx = ccdm->bbmax[0];
-          maxy = ccdm->bbmax[1];
-          maxz = ccdm->bbmax[2];
-
-          if ((opco[0] < minx) || (opco[1] < miny) || (opco[2] < minz) || (opco[0] > maxx) ||
-              (opco[1] > maxy) || (opco[2] > maxz)) {
+          if ((opco[0] < ccdm->bbmin[0]) || (opco[1] < ccdm->bbmin[1]) ||
+              (opco[2] < ccdm->bbmin[2]) || (opco[0] > ccdm->bbmax[0]) ||
+              (opco[1] > ccdm->bbmax[1]) || (opco[2] > ccdm->bbmax[2])) {
             /* outside the padded boundbox --> collision object is too far away */
             BLI_ghashIterator_step(ihash);
             continue;
@@ -1693,86 +1882,27 @@ static int sb_detect_vertex_collisionCached(float opco[3],
         fa = 1.0f / fa;
         avel[0] = avel[1] = avel[2] = 0.0f;
         /* use mesh*/
-        while (a--) {
-          if ((opco[0] < mima->minx) || (opco[0] > mima->maxx) || (opco[1] < mima->miny) ||
-              (opco[1] > mima->maxy) || (opco[2] < mima->minz) || (opco[2] > mima->maxz)) {
-            mima++;
-            vt++;
-            continue;
-          }
-
-          if (mvert) {
-
-            copy_v3_v3(nv1, mvert[vt->tri[0]].co);
-            copy_v3_v3(nv2, mvert[vt->tri[1]].co);
-            copy_v3_v3(nv3, mvert[vt->tri[2]].co);
-
-            if (mprevvert) {
-              /* Grab the average speed of the collider vertices before we spoil nvX
-               * humm could be done once a SB steps but then we' need to store that too
-               * since the AABB reduced probability to get here drastically
-               * it might be a nice tradeoff CPU <--> memory.
-               */
-              sub_v3_v3v3(vv1, nv1, mprevvert[vt->tri[0]].co);
-              sub_v3_v3v3(vv2, nv2, mprevvert[vt->tri[1]].co);
-              sub_v3_v3v3(vv3, nv3, mprevvert[vt->tri[2]].co);
-
-              mul_v3_fl(nv1, time);
-              madd_v3_v3fl(nv1, mprevvert[vt->tri[0]].co, 1.0f - time);
-
-              mul_v3_fl(nv2, time);
-              madd_v3_v3fl(nv2, mprevvert[vt->tri[1]].co, 1.0f - time);
-
-              mul_v3_fl(nv3, time);
-              madd_v3_v3fl(nv3, mprevvert[vt->tri[2]].co, 1.0f - time);
-            }
-          }
-
-          /* switch origin to be nv2*/
-          sub_v3_v3v3(edge1, nv1, nv2);
-          sub_v3_v3v3(edge2, nv3, nv2);
-          /* Abuse dv1 to have vertex in question at *origin* of triangle. */
-          sub_v3_v3v3(dv1, opco, nv2);
-
-          cross_v3_v3v3(d_nvect, edge2, edge1);
-          /* n_mag = */ /* UNUSED */ normalize_v3(d_nvect);
-          facedist = dot_v3v3(dv1, d_nvect);
-          // so rules are
-          //
-
-          if ((facedist > innerfacethickness) && (facedist < outerfacethickness)) {
-            if (isect_point_tri_prism_v3(opco, nv1, nv2, nv3)) {
-              force_mag_norm = (float)exp(-ee * facedist);
-              if (facedist > outerfacethickness * ff) {
-                force_mag_norm = (float)force_mag_norm * fa * (facedist - outerfacethickness) *
-                                 (facedist - outerfacethickness);
-              }
-              *damp = ob->pd->pdef_sbdamp;
-              if (facedist > 0.0f) {
-                *damp *= (1.0f - facedist / outerfacethickness);
-                madd_v3_v3fl(outerforceaccu, d_nvect, force_mag_norm);
-                deflected = 3;
-              }
-              else {
-                madd_v3_v3fl(innerforceaccu, d_nvect, force_mag_norm);
-                if (deflected < 2) {
-                  deflected = 2;
-                }
-              }
-              if ((mprevvert) && (*damp > 0.0f)) {
-                choose_winner(ve, opco, nv1, nv2, nv3, vv1, vv2, vv3);
-                add_v3_v3(avel, ve);
-                cavel++;
-              }
-              *intrusion += facedist;
-              ci++;
-            }
-          }
-
-          mima++;
-          vt++;
-        } /* while a */
-      }   /* if (ob->pd && ob->pd->deflect) */
+        ccd_VertexCollTestData test_data = {
+            .ccdm = ccdm,
+            .ob = ob,
+            .opco = opco,
+            .time = time,
+            .innerfacethickness = innerfacethickness,
+            .outerfacethickness = outerfacethickness,
+            .ee = ee,
+            .ff = ff,
+            .fa = fa,
+            .damp = damp,
+            .outerforceaccu = outerforceaccu,
+            .innerforceaccu = innerforceaccu,
+            .avel = avel,
+            .intrusion = intrusion,
+            .cavel = &cavel,
+            .ci = &ci,
+            .deflected = &deflected,
+        };
+        ccd_mesh_tris_overlapping_aabb(ccdm, opco, opco, ccd_vertex_coll_test, &test_data);
+      } /* if (ob->pd && ob->pd->deflect) */
       BLI_ghashIterator_step(ihash);
     }
   } /* while () */
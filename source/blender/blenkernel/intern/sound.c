@@ -920,6 +920,9 @@ void BKE_sound_free_waveform(bSound *sound)
       if (waveform->data) {
         MEM_freeN(waveform->data);
       }
+      for (int level = 0; level < waveform->num_levels; level++) {
+        MEM_freeN(waveform->levels[level]);
+      }
       MEM_freeN(waveform);
     }
 
@@ -929,6 +932,36 @@ void BKE_sound_free_waveform(bSound *sound)
   sound->tags &= ~SOUND_TAGS_WAVEFORM_NO_RELOAD;
 }
 
+/* Build min/max/rms mip levels of the waveform by successive halving, so drawing can pick a
+ * resolution matching the zoom instead of scanning every sample of long takes. */
+static void sound_build_waveform_pyramid(SoundWaveform *waveform)
+{
+  const float *src = waveform->data;
+  int src_length = waveform->length;
+
+  while (src_length >= 4 && waveform->num_levels < SOUND_WAVEFORM_MAX_LEVELS) {
+    const int level_length = src_length / 2;
+    float *level = MEM_mallocN((size_t)level_length * sizeof(float) * 3,
+                               "SoundWaveform.level");
+
+    for (int i = 0; i < level_length; i++) {
+      const float *a = src + (size_t)(i * 2) * 3;
+      const float *b = a + 3;
+
+      level[i * 3] = min_ff(a[0], b[0]);
+      level[i * 3 + 1] = max_ff(a[1], b[1]);
+      level[i * 3 + 2] = sqrtf((a[2] * a[2] + b[2] * b[2]) * 0.5f);
+    }
+
+    waveform->levels[waveform->num_levels] = level;
+    waveform->levels_length[waveform->num_levels] = level_length;
+    waveform->num_levels++;
+
+    src = level;
+    src_length = level_length;
+  }
+}
+
 void BKE_sound_read_waveform(Main *bmain, bSound *sound, short *stop)
 {
   bool need_close_audio_handles = false;
@@ -939,7 +972,7 @@ void BKE_sound_read_waveform(Main *bmain, bSound *sound, short *stop)
   }
 
   AUD_SoundInfo info = AUD_getInfo(sound->playback_handle);
-  SoundWaveform *waveform = MEM_mallocN(sizeof(SoundWaveform), "SoundWaveform");
+  SoundWaveform *waveform = MEM_callocN(sizeof(SoundWaveform), "SoundWaveform");
 
   if (info.length > 0) {
     int length = info.length * SOUND_WAVE_SAMPLES_PER_SECOND;
@@ -947,6 +980,10 @@ void BKE_sound_read_waveform(Main *bmain, bSound *sound, short *stop)
     waveform->data = MEM_mallocN(length * sizeof(float) * 3, "SoundWaveform.samples");
     waveform->length = AUD_readSound(
         sound->playback_handle, waveform->data, length, SOUND_WAVE_SAMPLES_PER_SECOND, stop);
+
+    if (!*stop) {
+      sound_build_waveform_pyramid(waveform);
+    }
   }
   else {
     /* Create an empty waveform here if the sound couldn't be
@@ -1031,6 +1031,8 @@ static void subdiv_ccg_average_inner_grids_task(void *__restrict userdata_v,
 typedef struct AverageGridsBoundariesData {
   SubdivCCG *subdiv_ccg;
   CCGKey *key;
+  /* Optional, when non-NULL only boundaries of effected grids are averaged. */
+  const BLI_bitmap *effected_grids;
 } AverageGridsBoundariesData;
 
 typedef struct AverageGridsBoundariesTLSData {
@@ -1077,6 +1079,23 @@ static void subdiv_ccg_average_grids_boundary(SubdivCCG *subdiv_ccg,
   }
 }
 
+/* Returns true if the adjacent edge writes to any of the effected grids. */
+static bool subdiv_ccg_adjacent_edge_is_effected(const SubdivCCG *subdiv_ccg,
+                                                 const SubdivCCGAdjacentEdge *adjacent_edge,
+                                                 const BLI_bitmap *effected_grids)
+{
+  const int grid_size2 = subdiv_ccg->grid_size * 2;
+  for (int face_index = 0; face_index < adjacent_edge->num_adjacent_faces; face_index++) {
+    for (int i = 1; i < grid_size2 - 1; i++) {
+      const int grid_index = adjacent_edge->boundary_coords[face_index][i].grid_index;
+      if (BLI_BITMAP_TEST_BOOL(effected_grids, grid_index)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 static void subdiv_ccg_average_grids_boundaries_task(void *__restrict userdata_v,
                                                      const int adjacent_edge_index,
                                                      const TaskParallelTLS *__restrict tls_v)
@@ -1086,6 +1105,10 @@ static void subdiv_ccg_average_grids_boundaries_task(void *__restrict userdata_v
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   CCGKey *key = data->key;
   SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[adjacent_edge_index];
+  if (data->effected_grids != NULL &&
+      !subdiv_ccg_adjacent_edge_is_effected(subdiv_ccg, adjacent_edge, data->effected_grids)) {
+    return;
+  }
   subdiv_ccg_average_grids_boundary(subdiv_ccg, key, adjacent_edge, tls);
 }
 
@@ -1099,6 +1122,8 @@ static void subdiv_ccg_average_grids_boundaries_free(const void *__restrict UNUS
 typedef struct AverageGridsCornerData {
   SubdivCCG *subdiv_ccg;
   CCGKey *key;
+  /* Optional, when non-NULL only corners of effected grids are averaged. */
+  const BLI_bitmap *effected_grids;
 } AverageGridsCornerData;
 
 static void subdiv_ccg_average_grids_corners(SubdivCCG *subdiv_ccg,
@@ -1126,6 +1151,19 @@ static void subdiv_ccg_average_grids_corners(SubdivCCG *subdiv_ccg,
   }
 }
 
+/* Returns true if the adjacent vertex writes to any of the effected grids. */
+static bool subdiv_ccg_adjacent_vertex_is_effected(const SubdivCCGAdjacentVertex *adjacent_vertex,
+                                                   const BLI_bitmap *effected_grids)
+{
+  for (int face_index = 0; face_index < adjacent_vertex->num_adjacent_faces; face_index++) {
+    const int grid_index = adjacent_vertex->corner_coords[face_index].grid_index;
+    if (BLI_BITMAP_TEST_BOOL(effected_grids, grid_index)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static void subdiv_ccg_average_grids_corners_task(void *__restrict userdata_v,
                                                   const int adjacent_vertex_index,
                                                   const TaskParallelTLS *__restrict UNUSED(tls_v))
@@ -1134,16 +1172,23 @@ static void subdiv_ccg_average_grids_corners_task(void *__restrict userdata_v,
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   CCGKey *key = data->key;
   SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[adjacent_vertex_index];
+  if (data->effected_grids != NULL &&
+      !subdiv_ccg_adjacent_vertex_is_effected(adjacent_vertex, data->effected_grids)) {
+    return;
+  }
   subdiv_ccg_average_grids_corners(subdiv_ccg, key, adjacent_vertex);
 }
 
-static void subdiv_ccg_average_all_boundaries(SubdivCCG *subdiv_ccg, CCGKey *key)
+static void subdiv_ccg_average_boundaries(SubdivCCG *subdiv_ccg,
+                                          CCGKey *key,
+                                          const BLI_bitmap *effected_grids)
 {
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
   AverageGridsBoundariesData boundaries_data = {
       .subdiv_ccg = subdiv_ccg,
       .key = key,
+      .effected_grids = effected_grids,
   };
   AverageGridsBoundariesTLSData tls_data = {NULL};
   parallel_range_settings.userdata_chunk = &tls_data;
@@ -1156,13 +1201,16 @@ static void subdiv_ccg_average_all_boundaries(SubdivCCG *subdiv_ccg, CCGKey *key
                           &parallel_range_settings);
 }
 
-static void subdiv_ccg_average_all_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
+static void subdiv_ccg_average_corners(SubdivCCG *subdiv_ccg,
+                                       CCGKey *key,
+                                       const BLI_bitmap *effected_grids)
 {
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
   AverageGridsCornerData corner_data = {
       .subdiv_ccg = subdiv_ccg,
       .key = key,
+      .effected_grids = effected_grids,
   };
   BLI_task_parallel_range(0,
                           subdiv_ccg->num_adjacent_vertices,
@@ -1173,8 +1221,8 @@ static void subdiv_ccg_average_all_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
 
 static void subdiv_ccg_average_all_boundaries_and_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
 {
-  subdiv_ccg_average_all_boundaries(subdiv_ccg, key);
-  subdiv_ccg_average_all_corners(subdiv_ccg, key);
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, NULL);
+  subdiv_ccg_average_corners(subdiv_ccg, key, NULL);
 }
 
 void BKE_subdiv_ccg_average_grids(SubdivCCG *subdiv_ccg)
@@ -1235,9 +1283,18 @@ void BKE_subdiv_ccg_average_stitch_faces(SubdivCCG *subdiv_ccg,
                           &data,
                           subdiv_ccg_stitch_face_inner_grids_task,
                           &parallel_range_settings);
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
-  subdiv_ccg_average_all_boundaries_and_corners(subdiv_ccg, &key);
+  /* Only average boundaries and corners which are adjacent to the modified
+   * faces, a small brush would otherwise re-stitch the entire grid set. */
+  BLI_bitmap *effected_grids = BLI_BITMAP_NEW(subdiv_ccg->num_grids, "effected grids");
+  for (int i = 0; i < num_effected_faces; i++) {
+    const SubdivCCGFace *face = (const SubdivCCGFace *)effected_faces[i];
+    for (int corner = 0; corner < face->num_grids; corner++) {
+      BLI_BITMAP_ENABLE(effected_grids, face->start_grid_index + corner);
+    }
+  }
+  subdiv_ccg_average_boundaries(subdiv_ccg, &key, effected_grids);
+  subdiv_ccg_average_corners(subdiv_ccg, &key, effected_grids);
+  MEM_freeN(effected_grids);
 }
 
 void BKE_subdiv_ccg_topology_counters(const SubdivCCG *subdiv_ccg,
@@ -48,7 +48,12 @@ bool BKE_subdiv_eval_begin(Subdiv *subdiv)
   }
   else if (subdiv->evaluator == NULL) {
     BKE_subdiv_stats_begin(&subdiv->stats, SUBDIV_STATS_EVALUATOR_CREATE);
-    subdiv->evaluator = openSubdiv_createEvaluatorFromTopologyRefiner(subdiv->topology_refiner);
+    /* Evaluation happens from the dependency graph threads and the result is
+     * consumed by mesh building on the CPU, so request the CPU evaluator. A
+     * GPU backed type can be requested here once the draw engine can consume
+     * a GPU-resident result. */
+    subdiv->evaluator = openSubdiv_createEvaluatorFromTopologyRefiner(subdiv->topology_refiner,
+                                                                      OPENSUBDIV_EVALUATOR_CPU);
     BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_EVALUATOR_CREATE);
     if (subdiv->evaluator == NULL) {
       return false;
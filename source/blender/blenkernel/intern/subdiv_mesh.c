@@ -33,6 +33,7 @@
 #include "BLI_math_vector.h"
 
 #include "BKE_customdata.h"
+#include "BKE_eval_stats.h"
 #include "BKE_key.h"
 #include "BKE_mesh.h"
 #include "BKE_subdiv.h"
@@ -1227,6 +1228,11 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
   Mesh *result = subdiv_context.subdiv_mesh;
   // BKE_mesh_validate(result, true, true);
   BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH);
+  if (BKE_eval_stats_is_enabled()) {
+    BKE_eval_stats_sample_add("subdiv_to_mesh", subdiv->stats.subdiv_to_mesh_time);
+    BKE_eval_stats_sample_add("subdiv_to_mesh_geometry",
+                              subdiv->stats.subdiv_to_mesh_geometry_time);
+  }
   if (!subdiv_context.can_evaluate_normals) {
     result->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
   }
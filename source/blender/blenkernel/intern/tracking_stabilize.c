@@ -1133,45 +1133,31 @@ static void stabilization_data_to_mat4(float pixel_aspect,
  *
  * NOTE: all tracks need to be initialized before calling this function.
  */
-static float calculate_autoscale_factor(StabContext *ctx, int size, float aspect)
+/* Check how far the stabilized frame edges cut into the original frame for a single
+ * frame, and return the scale factor needed to hide any black border. */
+static float autoscale_factor_for_frame(StabContext *ctx, int cfra, int size, float aspect)
 {
-  MovieTrackingStabilization *stab = ctx->stab;
   float pixel_aspect = ctx->tracking->camera.pixel_aspect;
   int height = size, width = aspect * size;
-
-  int sfra = INT_MAX, efra = INT_MIN;
   float scale = 1.0f, scale_step = 0.0f;
 
-  /* Calculate maximal frame range of tracks where stabilization is active. */
-  LISTBASE_FOREACH (MovieTrackingTrack *, track, &ctx->tracking->tracks) {
-    if ((track->flag & TRACK_USE_2D_STAB) ||
-        ((stab->flag & TRACKING_STABILIZE_ROTATION) && (track->flag & TRACK_USE_2D_STAB_ROT))) {
-      int first_frame = track->markers[0].framenr;
-      int last_frame = track->markers[track->markersnr - 1].framenr;
-      sfra = min_ii(sfra, first_frame);
-      efra = max_ii(efra, last_frame);
-    }
-  }
-
-  use_values_from_fcurves(ctx, true);
-  for (int cfra = sfra; cfra <= efra; cfra++) {
-    float translation[2], pivot[2], angle, tmp_scale;
-    float mat[4][4];
-    const float points[4][2] = {{0.0f, 0.0f}, {0.0f, height}, {width, height}, {width, 0.0f}};
-    const bool do_compensate = true;
-    /* Calculate stabilization parameters for the current frame. */
-    stabilization_determine_offset_for_frame(
-        ctx, cfra, aspect, translation, pivot, &angle, &scale_step);
-    stabilization_calculate_data(ctx,
-                                 cfra,
-                                 size,
-                                 aspect,
-                                 do_compensate,
-                                 scale_step,
-                                 translation,
-                                 pivot,
-                                 &tmp_scale,
-                                 &angle);
+  float translation[2], pivot[2], angle, tmp_scale;
+  float mat[4][4];
+  const float points[4][2] = {{0.0f, 0.0f}, {0.0f, height}, {width, height}, {width, 0.0f}};
+  const bool do_compensate = true;
+  /* Calculate stabilization parameters for the current frame. */
+  stabilization_determine_offset_for_frame(
+      ctx, cfra, aspect, translation, pivot, &angle, &scale_step);
+  stabilization_calculate_data(ctx,
+                               cfra,
+                               size,
+                               aspect,
+                               do_compensate,
+                               scale_step,
+                               translation,
+                               pivot,
+                               &tmp_scale,
+                               &angle);
     /* Compose transformation matrix. */
     /* NOTE: Here we operate in NON-COMPENSATED coordinates, meaning we have
      * to construct transformation matrix using proper pivot point.
@@ -1238,7 +1224,70 @@ static float calculate_autoscale_factor(StabContext *ctx, int size, float aspect
         }
       }
     }
+
+  return scale;
+}
+
+typedef struct AutoscaleTaskData {
+  StabContext *ctx;
+  int sfra;
+  int size;
+  float aspect;
+} AutoscaleTaskData;
+
+static void autoscale_task_fn(void *__restrict userdata,
+                              const int i,
+                              const TaskParallelTLS *__restrict tls)
+{
+  AutoscaleTaskData *task_data = userdata;
+  float *max_scale = tls->userdata_chunk;
+
+  *max_scale = max_ff(
+      *max_scale,
+      autoscale_factor_for_frame(task_data->ctx, task_data->sfra + i, task_data->size, task_data->aspect));
+}
+
+static void autoscale_reduce_fn(const void *__restrict UNUSED(userdata),
+                                void *__restrict chunk_join,
+                                void *__restrict chunk)
+{
+  float *join = chunk_join;
+  const float *max_scale = chunk;
+  *join = max_ff(*join, *max_scale);
+}
+
+static float calculate_autoscale_factor(StabContext *ctx, int size, float aspect)
+{
+  MovieTrackingStabilization *stab = ctx->stab;
+
+  int sfra = INT_MAX, efra = INT_MIN;
+  float scale = 1.0f;
+
+  /* Calculate maximal frame range of tracks where stabilization is active. */
+  LISTBASE_FOREACH (MovieTrackingTrack *, track, &ctx->tracking->tracks) {
+    if ((track->flag & TRACK_USE_2D_STAB) ||
+        ((stab->flag & TRACKING_STABILIZE_ROTATION) && (track->flag & TRACK_USE_2D_STAB_ROT))) {
+      int first_frame = track->markers[0].framenr;
+      int last_frame = track->markers[track->markersnr - 1].framenr;
+      sfra = min_ii(sfra, first_frame);
+      efra = max_ii(efra, last_frame);
+    }
   }
+
+  use_values_from_fcurves(ctx, true);
+  if (sfra <= efra) {
+    /* Examining a frame only reads the context and evaluates f-curves, so the frames can
+     * run in parallel; for long clips this scan dominates the whole stabilization setup. */
+    AutoscaleTaskData task_data = {ctx, sfra, size, aspect};
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 8;
+    settings.userdata_chunk = &scale;
+    settings.userdata_chunk_size = sizeof(scale);
+    settings.func_reduce = autoscale_reduce_fn;
+    BLI_task_parallel_range(0, efra - sfra + 1, &task_data, autoscale_task_fn, &settings);
+  }
+
   if (stab->maxscale > 0.0f) {
     scale = min_ff(scale, stab->maxscale);
   }
@@ -1346,12 +1395,16 @@ static void tracking_stabilize_frame_interpolation_cb(
 
   interpolation_func interpolation = data->interpolation;
 
-  for (int i = 0; i < tmpibuf->x; i++) {
-    float vec[3] = {i, j, 0.0f};
+  /* The warp is affine: transform the row start once and step along the columns,
+   * instead of a full matrix multiply per pixel. */
+  float row_start[3] = {0.0f, j, 0.0f};
+  mul_v3_m4v3(row_start, mat, row_start);
 
-    mul_v3_m4v3(vec, mat, vec);
+  for (int i = 0; i < tmpibuf->x; i++) {
+    const float u = row_start[0] + i * mat[0][0];
+    const float v = row_start[1] + i * mat[0][1];
 
-    interpolation(ibuf, tmpibuf, vec[0], vec[1], i, j);
+    interpolation(ibuf, tmpibuf, u, v, i, j);
   }
 }
 
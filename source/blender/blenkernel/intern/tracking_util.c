@@ -780,9 +780,32 @@ static ImBuf *accessor_get_ibuf(TrackingImageAccessor *accessor,
     return ibuf;
   }
   CACHE_PRINTF("Calculate new buffer for frame %d\n", frame);
+  /* Whole-frame buffers (no region) are shared by all markers tracked on the
+   * frame, so when many tracking tasks miss the cache at the same time they
+   * would all perform the same expensive conversion. Serialize calculation of
+   * those buffers: all threads but the first will find the result in the
+   * cache after waiting on the mutex. Region buffers are per-marker and are
+   * still calculated fully in parallel. */
+  const bool is_shared_buffer = (region == NULL);
+  if (is_shared_buffer) {
+    BLI_mutex_lock(&accessor->process_mutex);
+    BLI_spin_lock(&accessor->cache_lock);
+    ibuf = accesscache_get(
+        accessor, clip_index, frame, input_mode, downscale, region, transform_key);
+    BLI_spin_unlock(&accessor->cache_lock);
+    if (ibuf != NULL) {
+      CACHE_PRINTF("Used buffer calculated by another thread for frame %d\n", frame);
+      ibuf->userflags |= IB_PERSISTENT;
+      BLI_mutex_unlock(&accessor->process_mutex);
+      return ibuf;
+    }
+  }
   /* And now we do postprocessing of the original frame. */
   orig_ibuf = accessor_get_preprocessed_ibuf(accessor, clip_index, frame);
   if (orig_ibuf == NULL) {
+    if (is_shared_buffer) {
+      BLI_mutex_unlock(&accessor->process_mutex);
+    }
     return NULL;
   }
   /* Cut a region if requested. */
@@ -889,6 +912,9 @@ static ImBuf *accessor_get_ibuf(TrackingImageAccessor *accessor,
   accesscache_put(
       accessor, clip_index, frame, input_mode, downscale, region, transform_key, final_ibuf);
   BLI_spin_unlock(&accessor->cache_lock);
+  if (is_shared_buffer) {
+    BLI_mutex_unlock(&accessor->process_mutex);
+  }
   return final_ibuf;
 }
 
@@ -1015,6 +1041,7 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
                                                     accessor_release_mask_callback);
 
   BLI_spin_init(&accessor->cache_lock);
+  BLI_mutex_init(&accessor->process_mutex);
 
   return accessor;
 }
@@ -1024,5 +1051,6 @@ void tracking_image_accessor_destroy(TrackingImageAccessor *accessor)
   IMB_moviecache_free(accessor->cache);
   libmv_FrameAccessorDestroy(accessor->libmv_accessor);
   BLI_spin_end(&accessor->cache_lock);
+  BLI_mutex_end(&accessor->process_mutex);
   MEM_freeN(accessor);
 }
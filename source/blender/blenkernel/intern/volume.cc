@@ -230,6 +230,102 @@ static struct VolumeFileCache {
   std::mutex mutex;
 } GLOBAL_CACHE;
 
+/* Global Volume File Metadata Cache
+ *
+ * Caches the grid list and file-level metadata of recently opened VDB files,
+ * so datablocks pointing at the same file (heavily instanced volumes, or
+ * original and copy-on-write copies) don't each re-open and parse it.
+ *
+ * Entries are invalidated when the file changes on disk, and the least
+ * recently used files are evicted beyond a fixed number. The metadata is
+ * small; the voxel trees are shared and freed separately through the grid
+ * cache above. */
+
+static struct VolumeFileMetadataCache {
+  struct Entry {
+    std::string filepath;
+    /* Modification time and size of the file when it was read, to detect
+     * changes on disk. */
+    int64_t mtime = 0;
+    int64_t filesize = 0;
+    /* Grids without tree data, and file metadata, as read by
+     * readAllGridMetadata(). */
+    openvdb::GridPtrVec grids;
+    openvdb::MetaMap::Ptr metadata;
+    /* Error message if an error occurred during reading. */
+    std::string error_msg;
+  };
+
+  /* Get the metadata for a file, reading it if it is not cached yet or
+   * changed on disk. Returns false if reading failed, with the error
+   * message in r_error_msg. */
+  bool get(const char *filepath,
+           openvdb::GridPtrVec &r_grids,
+           openvdb::MetaMap::Ptr &r_metadata,
+           std::string &r_error_msg)
+  {
+    BLI_stat_t st;
+    const bool has_stat = (BLI_stat(filepath, &st) != -1);
+    const int64_t mtime = has_stat ? (int64_t)st.st_mtime : 0;
+    const int64_t filesize = has_stat ? (int64_t)st.st_size : 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+      if (it->filepath == filepath) {
+        if (it->mtime == mtime && it->filesize == filesize) {
+          /* Move to the front for least-recently-used eviction. */
+          entries.splice(entries.begin(), entries, it);
+          Entry &entry = entries.front();
+          r_grids = entry.grids;
+          r_metadata = entry.metadata;
+          r_error_msg = entry.error_msg;
+          return entry.error_msg.empty();
+        }
+        /* File changed on disk, read it again below. */
+        entries.erase(it);
+        break;
+      }
+    }
+
+    Entry entry;
+    entry.filepath = filepath;
+    entry.mtime = mtime;
+    entry.filesize = filesize;
+
+    openvdb::io::File file(filepath);
+    try {
+      file.setCopyMaxBytes(0);
+      file.open();
+      entry.grids = *(file.readAllGridMetadata());
+      entry.metadata = file.getMetadata();
+    }
+    catch (const openvdb::IoError &e) {
+      entry.error_msg = e.what();
+    }
+
+    entries.push_front(std::move(entry));
+    while (entries.size() > max_entries) {
+      entries.pop_back();
+    }
+
+    Entry &front = entries.front();
+    r_grids = front.grids;
+    r_metadata = front.metadata;
+    r_error_msg = front.error_msg;
+    return front.error_msg.empty();
+  }
+
+ protected:
+  /* Enough for typical numbers of unique files in a scene, while bounding
+   * memory usage over long file sequences. */
+  static const size_t max_entries = 32;
+  /* Cache contents, most recently used first. */
+  std::list<Entry> entries;
+  /* Mutex for multithreaded access. */
+  std::mutex mutex;
+} METADATA_CACHE;
+
 /* VolumeGrid
  *
  * Wrapper around OpenVDB grid. Grids loaded from OpenVDB files are always
@@ -661,27 +757,11 @@ bool BKE_volume_load(Volume *volume, Main *bmain)
     return false;
   }
 
-  /* Test if file exists. */
-  if (!BLI_exists(grids.filepath)) {
-    char filename[FILE_MAX];
-    BLI_split_file_part(grids.filepath, filename, sizeof(filename));
-    grids.error_msg = filename + std::string(" not found");
-    CLOG_INFO(&LOG, 1, "Volume %s: %s", volume_name, grids.error_msg.c_str());
-    return false;
-  }
-
-  /* Open OpenVDB file. */
-  openvdb::io::File file(grids.filepath);
+  /* Get grid list and file metadata, through the cache so heavily instanced
+   * files are only opened and parsed once. */
   openvdb::GridPtrVec vdb_grids;
 
-  try {
-    file.setCopyMaxBytes(0);
-    file.open();
-    vdb_grids = *(file.readAllGridMetadata());
-    grids.metadata = file.getMetadata();
-  }
-  catch (const openvdb::IoError &e) {
-    grids.error_msg = e.what();
+  if (!METADATA_CACHE.get(grids.filepath, vdb_grids, grids.metadata, grids.error_msg)) {
     CLOG_INFO(&LOG, 1, "Volume %s: %s", volume_name, grids.error_msg.c_str());
   }
 
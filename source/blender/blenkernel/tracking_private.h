@@ -140,6 +140,9 @@ typedef struct TrackingImageAccessor {
   int start_frame;
   struct libmv_FrameAccessor *libmv_accessor;
   SpinLock cache_lock;
+  /* Serializes calculation of whole-frame buffers, so concurrent tracking
+   * tasks missing the cache don't all convert the same frame. */
+  ThreadMutex process_mutex;
 } TrackingImageAccessor;
 
 TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR_CLIP],
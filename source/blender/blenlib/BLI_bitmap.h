@@ -114,6 +114,8 @@ void BLI_bitmap_flip_all(BLI_bitmap *bitmap, size_t bits);
 void BLI_bitmap_copy_all(BLI_bitmap *dst, const BLI_bitmap *src, size_t bits);
 void BLI_bitmap_and_all(BLI_bitmap *dst, const BLI_bitmap *src, size_t bits);
 void BLI_bitmap_or_all(BLI_bitmap *dst, const BLI_bitmap *src, size_t bits);
+size_t BLI_bitmap_count_set(const BLI_bitmap *bitmap, size_t bits);
+int BLI_bitmap_find_next_set(const BLI_bitmap *bitmap, size_t bits, size_t index_start);
 
 #ifdef __cplusplus
 }
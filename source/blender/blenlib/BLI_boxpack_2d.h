@@ -50,6 +50,11 @@ void BLI_box_pack_2d(BoxPack *boxarray,
                      float *tot_width,
                      float *tot_height);
 
+void BLI_box_pack_2d_fast(BoxPack *boxarray,
+                          const unsigned int len,
+                          float *r_tot_x,
+                          float *r_tot_y);
+
 typedef struct FixedSizeBoxPack {
   struct FixedSizeBoxPack *next, *prev;
   int x, y;
@@ -0,0 +1,98 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BLI_FLATHASH_H__
+#define __BLI_FLATHASH_H__
+
+/** \file
+ * \ingroup bli
+ *
+ * FlatHash is an open-addressing hash-map with the same key/value semantics and callback
+ * types as #GHash, for callers where lookup speed matters more than pointer stability.
+ *
+ * Unlike #GHash there is no allocation per entry: keys and values live in one flat slot
+ * array, with a byte of metadata per slot that is probed a group (16 slots) at a time,
+ * using SSE2 when available. This makes lookups mostly one cache-line of metadata plus
+ * the matching slot, at the cost that entry pointers are invalidated by insertion
+ * (so there is no `ensure_p` style API) and iteration order changes on grow.
+ *
+ * Use #GHash when entries are removed a lot or `lookup_p`/`ensure_p` are needed.
+ */
+
+#include "BLI_compiler_attrs.h"
+#include "BLI_ghash.h" /* For the hash/compare/free callback types. */
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FlatHash FlatHash;
+
+FlatHash *BLI_flathash_new_ex(GHashHashFP hashfp,
+                              GHashCmpFP cmpfp,
+                              const char *info,
+                              const unsigned int nentries_reserve) ATTR_MALLOC
+    ATTR_WARN_UNUSED_RESULT;
+FlatHash *BLI_flathash_new(GHashHashFP hashfp,
+                           GHashCmpFP cmpfp,
+                           const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+void BLI_flathash_free(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+void BLI_flathash_clear(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+void BLI_flathash_reserve(FlatHash *fh, const unsigned int nentries_reserve);
+
+void BLI_flathash_insert(FlatHash *fh, void *key, void *val);
+bool BLI_flathash_reinsert(
+    FlatHash *fh, void *key, void *val, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+void *BLI_flathash_lookup(const FlatHash *fh, const void *key) ATTR_WARN_UNUSED_RESULT;
+void *BLI_flathash_lookup_default(const FlatHash *fh,
+                                  const void *key,
+                                  void *val_default) ATTR_WARN_UNUSED_RESULT;
+bool BLI_flathash_haskey(const FlatHash *fh, const void *key) ATTR_WARN_UNUSED_RESULT;
+bool BLI_flathash_remove(FlatHash *fh,
+                         const void *key,
+                         GHashKeyFreeFP keyfreefp,
+                         GHashValFreeFP valfreefp);
+unsigned int BLI_flathash_len(const FlatHash *fh) ATTR_WARN_UNUSED_RESULT;
+
+/** \name Iterator
+ *
+ * Iteration order is unspecified and changes when the table grows,
+ * inserting or removing entries while iterating is not supported.
+ * \{ */
+
+typedef struct FlatHashIterator {
+  const FlatHash *fh;
+  unsigned int slot;
+} FlatHashIterator;
+
+void BLI_flathashIterator_init(FlatHashIterator *fhi, const FlatHash *fh);
+void BLI_flathashIterator_step(FlatHashIterator *fhi);
+bool BLI_flathashIterator_done(const FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+void *BLI_flathashIterator_getKey(const FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+void *BLI_flathashIterator_getValue(const FlatHashIterator *fhi) ATTR_WARN_UNUSED_RESULT;
+
+#define FLATHASH_ITER(fhi_, fh_) \
+  for (BLI_flathashIterator_init(&fhi_, fh_); BLI_flathashIterator_done(&fhi_) == false; \
+       BLI_flathashIterator_step(&fhi_))
+
+/** \} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_FLATHASH_H__ */
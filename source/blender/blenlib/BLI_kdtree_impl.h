@@ -43,6 +43,10 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS]) AT
 int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
                                  const float co[KD_DIMS],
                                  KDTreeNearest *r_nearest) ATTR_NONNULL(1, 2);
+void BLI_kdtree_nd_(find_nearest_batched)(const KDTree *tree,
+                                          const float (*co_array)[KD_DIMS],
+                                          unsigned int co_array_len,
+                                          KDTreeNearest *r_nearest) ATTR_NONNULL(1, 2, 4);
 
 int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
                                    const float co[KD_DIMS],
@@ -99,6 +99,8 @@ int BLI_listbase_count_at_most(const struct ListBase *listbase,
                                const int count_max) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
 int BLI_listbase_count(const struct ListBase *listbase) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
 void BLI_freelinkN(struct ListBase *listbase, void *vlink) ATTR_NONNULL(1);
+void **BLI_listbase_as_array(const struct ListBase *listbase,
+                             int *r_len) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1, 2);
 
 void BLI_listbase_swaplinks(struct ListBase *listbase, void *vlinka, void *vlinkb)
     ATTR_NONNULL(1, 2);
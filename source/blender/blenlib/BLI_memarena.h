@@ -39,6 +39,17 @@ extern "C" {
 struct MemArena;
 typedef struct MemArena MemArena;
 
+/**
+ * A saved arena position, for scoped temporary allocations,
+ * see #BLI_memarena_mark / #BLI_memarena_rewind.
+ * Only valid as long as the arena isn't cleared or freed, treat members as private.
+ */
+typedef struct MemArenaMark {
+  struct MemBuf *bufs;
+  unsigned char *curbuf;
+  size_t cursize;
+} MemArenaMark;
+
 struct MemArena *BLI_memarena_new(const size_t bufsize, const char *name) ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL(2) ATTR_MALLOC;
 void BLI_memarena_free(struct MemArena *ma) ATTR_NONNULL(1);
@@ -49,6 +60,14 @@ void *BLI_memarena_alloc(struct MemArena *ma, size_t size) ATTR_WARN_UNUSED_RESU
     ATTR_NONNULL(1) ATTR_MALLOC ATTR_ALLOC_SIZE(2);
 void *BLI_memarena_calloc(struct MemArena *ma, size_t size) ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL(1) ATTR_MALLOC ATTR_ALLOC_SIZE(2);
+void *BLI_memarena_alloc_aligned(struct MemArena *ma,
+                                 size_t size,
+                                 size_t align) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1) ATTR_MALLOC
+    ATTR_ALLOC_SIZE(2);
+void BLI_memarena_merge(struct MemArena *ma_dst, struct MemArena *ma_src) ATTR_NONNULL(1, 2);
+
+void BLI_memarena_mark(const struct MemArena *ma, MemArenaMark *r_mark) ATTR_NONNULL(1, 2);
+void BLI_memarena_rewind(struct MemArena *ma, const MemArenaMark *mark) ATTR_NONNULL(1, 2);
 
 void BLI_memarena_clear(MemArena *ma) ATTR_NONNULL(1);
 
@@ -84,6 +84,14 @@ enum {
    * order of allocation when no chunks have been freed.
    */
   BLI_MEMPOOL_ALLOW_ITER = (1 << 0),
+  /** Allow #BLI_mempool_alloc / #BLI_mempool_free to be called from multiple threads.
+   *
+   * Each thread allocates from a small per-thread cache (a 'magazine') that is refilled from
+   * and flushed back to the shared pool in batches, so concurrent allocation stays mostly
+   * uncontended. Everything else (clear, destroy, iteration, `as_array` etc.) still requires
+   * exclusive access to the pool.
+   */
+  BLI_MEMPOOL_THREADSAFE = (1 << 1),
 };
 
 void BLI_mempool_iternew(BLI_mempool *pool, BLI_mempool_iter *iter) ATTR_NONNULL();
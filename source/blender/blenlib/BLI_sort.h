@@ -40,4 +40,11 @@ void BLI_qsort_r(void *a, size_t n, size_t es, BLI_sort_cmp_t cmp, void *thunk)
 #endif
     ;
 
+/* Stable parallel merge sort, for large arrays. */
+void BLI_sort_parallel(void *a, size_t n, size_t es, BLI_sort_cmp_t cmp, void *thunk)
+#ifdef __GNUC__
+    __attribute__((nonnull(1, 5)))
+#endif
+    ;
+
 #endif /* __BLI_SORT_H__ */
@@ -313,6 +313,31 @@ struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
 bool BLI_task_graph_node_push_work(struct TaskNode *task_node);
 void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_node);
 
+/* Task Tracing
+ *
+ * Lightweight instrumentation of task execution (task pools, parallel ranges, task graphs):
+ * per-task begin/end timestamps plus a count of how many workers were busy, written out in the
+ * Chrome trace event format so recordings can be inspected in `chrome://tracing`.
+ *
+ * Recording is cheap enough to toggle at runtime (an atomic check per task when disabled),
+ * see the `--debug-task-trace` command line option. */
+
+/** An in-flight traced task, filled in by #BLI_task_trace_span_begin. */
+typedef struct TaskTraceSpan {
+  double time_begin;
+  int occupancy_begin;
+} TaskTraceSpan;
+
+void BLI_task_trace_start(void);
+/** Stop recording and write the collected events to \a filepath (Chrome trace JSON). */
+void BLI_task_trace_stop_and_write(const char *filepath);
+bool BLI_task_trace_is_enabled(void);
+
+/** Record a task execution, to be wrapped around the user callback by task implementations.
+ * Only call when #BLI_task_trace_is_enabled returned true. */
+void BLI_task_trace_span_begin(TaskTraceSpan *span);
+void BLI_task_trace_span_end(const TaskTraceSpan *span, const char *name);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,439 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * Open-addressing hash-map, see BLI_flathash.h for an overview.
+ *
+ * Layout follows the 'SwissTable' scheme: one metadata byte per slot holding either
+ * a marker (empty/deleted, high bit set) or the low 7 bits of the key's hash
+ * (high bit clear), probed 16 slots at a time. A lookup scans metadata groups for
+ * bytes matching the query hash and only touches the slot array on a metadata hit,
+ * so a miss typically costs a single cache-line.
+ */
+
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math_bits.h"
+#include "BLI_sys_types.h"
+#include "BLI_utildefines.h"
+
+#include "BLI_flathash.h" /* own include */
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+#include "BLI_strict_flags.h"
+
+/* -------------------------------------------------------------------- */
+/** \name Internal Types & Constants
+ * \{ */
+
+/** Slots probed per metadata group, matches the SSE2 register width. */
+#define GROUP_LEN 16
+
+/** Metadata markers, distinguishable from hash bytes by the high bit. */
+#define SLOT_EMPTY 0x80
+#define SLOT_DELETED 0xfe
+
+#define SLOT_IS_FULL(ctrl) (((ctrl)&0x80) == 0)
+
+/** Grow when occupied (full + deleted) slots would exceed 7/8 of the table. */
+#define LOAD_FACTOR_NUM 7
+#define LOAD_FACTOR_DEN 8
+
+#define NSLOTS_MIN GROUP_LEN
+
+typedef struct FlatHashSlot {
+  void *key;
+  void *val;
+} FlatHashSlot;
+
+struct FlatHash {
+  GHashHashFP hashfp;
+  GHashCmpFP cmpfp;
+
+  /** Metadata, one byte per slot. */
+  uint8_t *ctrl;
+  FlatHashSlot *slots;
+  /** Power of two, at least #NSLOTS_MIN. */
+  uint nslots;
+  uint nentries;
+  uint ndeleted;
+};
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Internal Utilities
+ * \{ */
+
+/**
+ * Finalizer from MurmurHash3, to spread entropy of the (often weak) #GHashHashFP result
+ * over all bits before it is split into the probe position and the metadata byte.
+ */
+BLI_INLINE uint flathash_mix(uint h)
+{
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+BLI_INLINE uint8_t flathash_h2(const uint hash)
+{
+  return (uint8_t)(hash & 0x7f);
+}
+
+/** Bit-mask of slots in \a group whose metadata byte equals \a tag. */
+BLI_INLINE uint flathash_group_match(const uint8_t *group, const uint8_t tag)
+{
+#ifdef __SSE2__
+  const __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+  const __m128i match = _mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)tag));
+  return (uint)_mm_movemask_epi8(match);
+#else
+  uint mask = 0;
+  for (int i = 0; i < GROUP_LEN; i++) {
+    mask |= (uint)(group[i] == tag) << i;
+  }
+  return mask;
+#endif
+}
+
+/** Bit-mask of slots in \a group that are not full (empty or deleted). */
+BLI_INLINE uint flathash_group_match_non_full(const uint8_t *group)
+{
+#ifdef __SSE2__
+  /* The high metadata bit is exactly the 'not full' bit. */
+  return (uint)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+  uint mask = 0;
+  for (int i = 0; i < GROUP_LEN; i++) {
+    mask |= (uint)(!SLOT_IS_FULL(group[i])) << i;
+  }
+  return mask;
+#endif
+}
+
+BLI_INLINE uint flathash_ngroups(const FlatHash *fh)
+{
+  return fh->nslots / GROUP_LEN;
+}
+
+/** First probed group for \a hash, followup groups use triangular increments. */
+BLI_INLINE uint flathash_group_first(const FlatHash *fh, const uint hash)
+{
+  return (hash >> 7) & (flathash_ngroups(fh) - 1);
+}
+
+static void flathash_buckets_alloc(FlatHash *fh, const uint nslots)
+{
+  fh->nslots = nslots;
+  fh->ctrl = MEM_mallocN(sizeof(*fh->ctrl) * (size_t)nslots, "flathash ctrl");
+  fh->slots = MEM_mallocN(sizeof(*fh->slots) * (size_t)nslots, "flathash slots");
+  memset(fh->ctrl, SLOT_EMPTY, sizeof(*fh->ctrl) * (size_t)nslots);
+}
+
+/** Smallest valid table size that keeps \a nentries under the load factor. */
+static uint flathash_nslots_calc(const uint nentries)
+{
+  uint nslots = NSLOTS_MIN;
+  while ((uint64_t)nentries * LOAD_FACTOR_DEN >= (uint64_t)nslots * LOAD_FACTOR_NUM) {
+    nslots *= 2;
+  }
+  return nslots;
+}
+
+/**
+ * Find the slot to place a new (known absent) key into,
+ * the caller is responsible for the load factor leaving an empty slot to stop at.
+ */
+static uint flathash_slot_find_free(const FlatHash *fh, const uint hash)
+{
+  uint g = flathash_group_first(fh, hash);
+  for (uint probe = 0;; g = (g + ++probe) & (flathash_ngroups(fh) - 1)) {
+    const uint8_t *group = fh->ctrl + (size_t)g * GROUP_LEN;
+    uint match = flathash_group_match_non_full(group);
+    if (match) {
+      return (g * GROUP_LEN) + bitscan_forward_uint(match);
+    }
+  }
+}
+
+static void flathash_slot_occupy(FlatHash *fh, const uint slot, const uint hash)
+{
+  if (fh->ctrl[slot] == SLOT_DELETED) {
+    fh->ndeleted--;
+  }
+  fh->ctrl[slot] = flathash_h2(hash);
+  fh->nentries++;
+}
+
+static void flathash_resize(FlatHash *fh, const uint nslots_new)
+{
+  uint8_t *ctrl_old = fh->ctrl;
+  FlatHashSlot *slots_old = fh->slots;
+  const uint nslots_old = fh->nslots;
+
+  flathash_buckets_alloc(fh, nslots_new);
+  fh->ndeleted = 0;
+
+  for (uint i = 0; i < nslots_old; i++) {
+    if (SLOT_IS_FULL(ctrl_old[i])) {
+      const uint hash = flathash_mix(fh->hashfp(slots_old[i].key));
+      const uint slot = flathash_slot_find_free(fh, hash);
+      fh->ctrl[slot] = flathash_h2(hash);
+      fh->slots[slot] = slots_old[i];
+    }
+  }
+
+  MEM_freeN(ctrl_old);
+  MEM_freeN(slots_old);
+}
+
+/** Ensure one more entry fits without exceeding the load factor. */
+static void flathash_ensure_can_insert(FlatHash *fh)
+{
+  if ((uint64_t)(fh->nentries + fh->ndeleted + 1) * LOAD_FACTOR_DEN <
+      (uint64_t)fh->nslots * LOAD_FACTOR_NUM) {
+    return;
+  }
+  /* When mostly deleted slots are occupying the table, rehash at the same size. */
+  const uint nslots_new = (fh->nentries * 2 > fh->nslots) ? fh->nslots * 2 : fh->nslots;
+  flathash_resize(fh, MAX2(nslots_new, flathash_nslots_calc(fh->nentries + 1)));
+}
+
+/** Returns the slot index of \a key or the table size when not found. */
+static uint flathash_slot_lookup(const FlatHash *fh, const void *key, const uint hash)
+{
+  const uint8_t h2 = flathash_h2(hash);
+  uint g = flathash_group_first(fh, hash);
+  for (uint probe = 0;; g = (g + ++probe) & (flathash_ngroups(fh) - 1)) {
+    const uint8_t *group = fh->ctrl + (size_t)g * GROUP_LEN;
+    uint match = flathash_group_match(group, h2);
+    while (match) {
+      const uint slot = (g * GROUP_LEN) + bitscan_forward_clear_uint(&match);
+      if (fh->cmpfp(fh->slots[slot].key, key) == false) {
+        return slot;
+      }
+    }
+    if (flathash_group_match(group, SLOT_EMPTY)) {
+      return fh->nslots;
+    }
+    /* Tables are never fully occupied (see load factor), an empty slot always terminates. */
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Public API
+ * \{ */
+
+FlatHash *BLI_flathash_new_ex(GHashHashFP hashfp,
+                              GHashCmpFP cmpfp,
+                              const char *info,
+                              const uint nentries_reserve)
+{
+  FlatHash *fh = MEM_mallocN(sizeof(*fh), info);
+  fh->hashfp = hashfp;
+  fh->cmpfp = cmpfp;
+  fh->nentries = 0;
+  fh->ndeleted = 0;
+  flathash_buckets_alloc(fh, flathash_nslots_calc(nentries_reserve));
+  return fh;
+}
+
+FlatHash *BLI_flathash_new(GHashHashFP hashfp, GHashCmpFP cmpfp, const char *info)
+{
+  return BLI_flathash_new_ex(hashfp, cmpfp, info, 0);
+}
+
+static void flathash_entries_free(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  if (keyfreefp || valfreefp) {
+    for (uint i = 0; i < fh->nslots; i++) {
+      if (SLOT_IS_FULL(fh->ctrl[i])) {
+        if (keyfreefp) {
+          keyfreefp(fh->slots[i].key);
+        }
+        if (valfreefp) {
+          valfreefp(fh->slots[i].val);
+        }
+      }
+    }
+  }
+}
+
+void BLI_flathash_free(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  flathash_entries_free(fh, keyfreefp, valfreefp);
+  MEM_freeN(fh->ctrl);
+  MEM_freeN(fh->slots);
+  MEM_freeN(fh);
+}
+
+void BLI_flathash_clear(FlatHash *fh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  flathash_entries_free(fh, keyfreefp, valfreefp);
+  memset(fh->ctrl, SLOT_EMPTY, sizeof(*fh->ctrl) * (size_t)fh->nslots);
+  fh->nentries = 0;
+  fh->ndeleted = 0;
+}
+
+void BLI_flathash_reserve(FlatHash *fh, const uint nentries_reserve)
+{
+  const uint nslots = flathash_nslots_calc(nentries_reserve);
+  if (nslots > fh->nslots) {
+    flathash_resize(fh, nslots);
+  }
+}
+
+/**
+ * Insert a key/value pair, the key must not already exist in the table
+ * (matching #BLI_ghash_insert semantics).
+ */
+void BLI_flathash_insert(FlatHash *fh, void *key, void *val)
+{
+  const uint hash = flathash_mix(fh->hashfp(key));
+  BLI_assert(flathash_slot_lookup(fh, key, hash) == fh->nslots);
+  flathash_ensure_can_insert(fh);
+  const uint slot = flathash_slot_find_free(fh, hash);
+  flathash_slot_occupy(fh, slot, hash);
+  fh->slots[slot].key = key;
+  fh->slots[slot].val = val;
+}
+
+/**
+ * Insert or overwrite, returns true when an existing pair was replaced
+ * (matching #BLI_ghash_reinsert semantics).
+ */
+bool BLI_flathash_reinsert(
+    FlatHash *fh, void *key, void *val, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  const uint hash = flathash_mix(fh->hashfp(key));
+  const uint slot = flathash_slot_lookup(fh, key, hash);
+  if (slot != fh->nslots) {
+    if (keyfreefp) {
+      keyfreefp(fh->slots[slot].key);
+    }
+    if (valfreefp) {
+      valfreefp(fh->slots[slot].val);
+    }
+    fh->slots[slot].key = key;
+    fh->slots[slot].val = val;
+    return true;
+  }
+  flathash_ensure_can_insert(fh);
+  const uint slot_free = flathash_slot_find_free(fh, hash);
+  flathash_slot_occupy(fh, slot_free, hash);
+  fh->slots[slot_free].key = key;
+  fh->slots[slot_free].val = val;
+  return false;
+}
+
+void *BLI_flathash_lookup(const FlatHash *fh, const void *key)
+{
+  const uint slot = flathash_slot_lookup(fh, key, flathash_mix(fh->hashfp(key)));
+  return (slot != fh->nslots) ? fh->slots[slot].val : NULL;
+}
+
+void *BLI_flathash_lookup_default(const FlatHash *fh, const void *key, void *val_default)
+{
+  const uint slot = flathash_slot_lookup(fh, key, flathash_mix(fh->hashfp(key)));
+  return (slot != fh->nslots) ? fh->slots[slot].val : val_default;
+}
+
+bool BLI_flathash_haskey(const FlatHash *fh, const void *key)
+{
+  return flathash_slot_lookup(fh, key, flathash_mix(fh->hashfp(key))) != fh->nslots;
+}
+
+bool BLI_flathash_remove(FlatHash *fh,
+                         const void *key,
+                         GHashKeyFreeFP keyfreefp,
+                         GHashValFreeFP valfreefp)
+{
+  const uint slot = flathash_slot_lookup(fh, key, flathash_mix(fh->hashfp(key)));
+  if (slot == fh->nslots) {
+    return false;
+  }
+  if (keyfreefp) {
+    keyfreefp(fh->slots[slot].key);
+  }
+  if (valfreefp) {
+    valfreefp(fh->slots[slot].val);
+  }
+  fh->ctrl[slot] = SLOT_DELETED;
+  fh->nentries--;
+  fh->ndeleted++;
+  return true;
+}
+
+uint BLI_flathash_len(const FlatHash *fh)
+{
+  return fh->nentries;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Iterator
+ * \{ */
+
+static void flathash_iter_skip_to_full(FlatHashIterator *fhi)
+{
+  while ((fhi->slot < fhi->fh->nslots) && !SLOT_IS_FULL(fhi->fh->ctrl[fhi->slot])) {
+    fhi->slot++;
+  }
+}
+
+void BLI_flathashIterator_init(FlatHashIterator *fhi, const FlatHash *fh)
+{
+  fhi->fh = fh;
+  fhi->slot = 0;
+  flathash_iter_skip_to_full(fhi);
+}
+
+void BLI_flathashIterator_step(FlatHashIterator *fhi)
+{
+  fhi->slot++;
+  flathash_iter_skip_to_full(fhi);
+}
+
+bool BLI_flathashIterator_done(const FlatHashIterator *fhi)
+{
+  return fhi->slot >= fhi->fh->nslots;
+}
+
+void *BLI_flathashIterator_getKey(const FlatHashIterator *fhi)
+{
+  return fhi->fh->slots[fhi->slot].key;
+}
+
+void *BLI_flathashIterator_getValue(const FlatHashIterator *fhi)
+{
+  return fhi->fh->slots[fhi->slot].val;
+}
+
+/** \} */
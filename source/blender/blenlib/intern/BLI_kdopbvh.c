@@ -52,6 +52,10 @@
 
 #include "BLI_strict_flags.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 /* used for iterative_raycast */
 // #define USE_SKIP_LINKS
 
@@ -1003,7 +1007,12 @@ void BLI_bvhtree_insert(BVHTree *tree, int index, const float co[3], int numpoin
   }
 }
 
-/* call before BLI_bvhtree_update_tree() */
+/**
+ * Refit a leaf bounding volume in-place, call before #BLI_bvhtree_update_tree().
+ *
+ * Together these refit the tree bottom-up without re-balancing, which is much cheaper than a full
+ * #BLI_bvhtree_balance() for deforming geometry where the topology doesn't change.
+ */
 bool BLI_bvhtree_update_node(
     BVHTree *tree, int index, const float co[3], const float co_moving[3], int numpoints)
 {
@@ -1720,6 +1729,31 @@ static float fast_ray_nearest_hit(const BVHRayCastData *data, const BVHNode *nod
 {
   const float *bv = node->bv;
 
+#ifdef __SSE2__
+  /* Evaluate the three slab intervals at once, the near/far reordering is already
+   * encoded in `data->index` (see #bvhtree_ray_cast_data_precalc).
+   * Since `bv` min <= max per axis, the pair-wise cross comparisons of the scalar
+   * version reduce to `tnear > tfar`. */
+  const __m128 origin = _mm_setr_ps(
+      data->ray.origin[0], data->ray.origin[1], data->ray.origin[2], 0.0f);
+  const __m128 idot = _mm_setr_ps(data->idot_axis[0], data->idot_axis[1], data->idot_axis[2], 0.0f);
+  const __m128 bv_near = _mm_setr_ps(
+      bv[data->index[0]], bv[data->index[2]], bv[data->index[4]], 0.0f);
+  const __m128 bv_far = _mm_setr_ps(
+      bv[data->index[1]], bv[data->index[3]], bv[data->index[5]], 0.0f);
+
+  float t1[4], t2[4];
+  _mm_storeu_ps(t1, _mm_mul_ps(_mm_sub_ps(bv_near, origin), idot));
+  _mm_storeu_ps(t2, _mm_mul_ps(_mm_sub_ps(bv_far, origin), idot));
+
+  const float tnear = max_fff(t1[0], t1[1], t1[2]);
+  const float tfar = min_fff(t2[0], t2[1], t2[2]);
+
+  if ((tnear > tfar) || (tfar < 0.0f) || (tnear > data->hit.dist)) {
+    return FLT_MAX;
+  }
+  return tnear;
+#else
   float t1x = (bv[data->index[0]] - data->ray.origin[0]) * data->idot_axis[0];
   float t2x = (bv[data->index[1]] - data->ray.origin[0]) * data->idot_axis[0];
   float t1y = (bv[data->index[2]] - data->ray.origin[1]) * data->idot_axis[1];
@@ -1735,6 +1769,7 @@ static float fast_ray_nearest_hit(const BVHRayCastData *data, const BVHNode *nod
   else {
     return max_fff(t1x, t1y, t1z);
   }
+#endif
 }
 
 static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
@@ -178,6 +178,144 @@ void *BLI_memarena_calloc(MemArena *ma, size_t size)
   return ptr;
 }
 
+/**
+ * A version of #BLI_memarena_alloc with stricter alignment for this single allocation,
+ * without the whole-arena overhead of #BLI_memarena_use_align.
+ * Useful for bulk array allocations accessed with SIMD.
+ */
+void *BLI_memarena_alloc_aligned(MemArena *ma, size_t size, size_t align)
+{
+  const size_t align_prev = ma->align;
+  void *ptr;
+
+  /* Align must be a power of two. */
+  BLI_assert((align & (align - 1)) == 0);
+
+  if (align <= ma->align) {
+    return BLI_memarena_alloc(ma, size);
+  }
+
+  /* Pad the current position up-front (a new buffer is aligned on allocation),
+   * unlike #memarena_curbuf_align this can't be done unconditionally
+   * since the padding may exceed what's left of the buffer. */
+  if (ma->curbuf != NULL) {
+    unsigned char *curbuf_aligned = (unsigned char *)PADUP((intptr_t)ma->curbuf, (int)align);
+    const size_t pad = (size_t)(curbuf_aligned - ma->curbuf);
+
+    if (pad <= ma->cursize) {
+      ma->curbuf = curbuf_aligned;
+      ma->cursize -= pad;
+    }
+    else {
+      /* Doesn't fit, force a new (aligned) buffer. */
+      ma->cursize = 0;
+    }
+  }
+
+  ma->align = align;
+  ptr = BLI_memarena_alloc(ma, size);
+  ma->align = align_prev;
+
+  return ptr;
+}
+
+/**
+ * Transfer ownership of allocated blocks from `ma_src` into `ma_dst`,
+ * cleaning the contents of `ma_src`.
+ *
+ * Useful for thread-local arenas that are merged into a shared arena
+ * once their (contention free) allocations are done.
+ *
+ * \note Useful for multi-threaded tasks that need a thread-local #MemArena
+ * that is kept after the multi-threaded operation is completed.
+ */
+void BLI_memarena_merge(MemArena *ma_dst, MemArena *ma_src)
+{
+  /* Memory arenas must be compatible. */
+  BLI_assert(ma_dst != ma_src);
+  BLI_assert(ma_dst->align == ma_src->align);
+  BLI_assert(ma_dst->use_calloc == ma_src->use_calloc);
+  BLI_assert(ma_dst->bufsize == ma_src->bufsize);
+
+  if (ma_src->bufs == NULL) {
+    return;
+  }
+
+  if (UNLIKELY(ma_dst->bufs == NULL)) {
+    BLI_assert(ma_dst->curbuf == NULL);
+    ma_dst->bufs = ma_src->bufs;
+    ma_dst->curbuf = ma_src->curbuf;
+    ma_dst->cursize = ma_src->cursize;
+  }
+  else {
+    /* Keep the destination's current buffer as-is (it may have usable space left),
+     * link the source buffers in after it. */
+    struct MemBuf *mb_src_last = ma_src->bufs;
+    while (mb_src_last->next != NULL) {
+      mb_src_last = mb_src_last->next;
+    }
+    mb_src_last->next = ma_dst->bufs->next;
+    ma_dst->bufs->next = ma_src->bufs;
+    /* Unused space in the source's current buffer is simply wasted, that's fine:
+     * the source is expected to be merged only once. */
+  }
+
+  ma_src->bufs = NULL;
+  ma_src->curbuf = NULL;
+  ma_src->cursize = 0;
+
+  /* Not a realloc, the allocations keep their address,
+   * only book-keeping moves to the destination pool. */
+  VALGRIND_DESTROY_MEMPOOL(ma_src);
+  VALGRIND_CREATE_MEMPOOL(ma_src, 0, false);
+}
+
+/**
+ * Save the current position of the arena in \a r_mark,
+ * so allocations made after it can be discarded with #BLI_memarena_rewind.
+ */
+void BLI_memarena_mark(const MemArena *ma, MemArenaMark *r_mark)
+{
+  r_mark->bufs = ma->bufs;
+  r_mark->curbuf = ma->curbuf;
+  r_mark->cursize = ma->cursize;
+}
+
+/**
+ * Discard all allocations made since \a mark was taken, freeing whole buffers when possible.
+ *
+ * Scoped use only: rewinding invalidates every mark taken after this one,
+ * and a mark doesn't survive #BLI_memarena_clear / #BLI_memarena_free.
+ */
+void BLI_memarena_rewind(MemArena *ma, const MemArenaMark *mark)
+{
+  /* Free buffers allocated since the mark. */
+  while (ma->bufs != mark->bufs) {
+    struct MemBuf *mb_next = ma->bufs->next;
+
+    BLI_asan_unpoison(ma->bufs, (uint)MEM_allocN_len(ma->bufs));
+    MEM_freeN(ma->bufs);
+    ma->bufs = mb_next;
+  }
+
+  ma->curbuf = mark->curbuf;
+  ma->cursize = mark->cursize;
+
+  if (ma->curbuf != NULL) {
+    if (ma->use_calloc) {
+      /* Whatever was written past the mark has to read as zero again.
+       * The tail may include never used (still zeroed) bytes, clearing those is harmless. */
+      BLI_asan_unpoison(ma->curbuf, ma->cursize);
+      memset(ma->curbuf, 0, ma->cursize);
+    }
+    BLI_asan_poison(ma->curbuf, ma->cursize);
+  }
+
+  /* Note: allocations made since the mark stay registered in the valgrind mempool,
+   * there is no partial release. Acceptable for a debugging aid, it only makes
+   * use-after-rewind errors go undetected there. */
+}
+
 /**
  * Clear for reuse, avoids re-allocation when an arena may
  * otherwise be free'd and recreated.
@@ -160,6 +160,12 @@ void *BLI_memblock_alloc(BLI_memblock *mblk)
   return ptr;
 }
 
+/* Return the number of allocated elements. */
+int BLI_memblock_len_get(BLI_memblock *mblk)
+{
+  return mblk->elem_next;
+}
+
 void BLI_memblock_iternew(BLI_memblock *mblk, BLI_memblock_iter *iter)
 {
   /* Small copy of the memblock used for better cache coherence. */
@@ -34,6 +34,7 @@
 
 #include "atomic_ops.h"
 
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BLI_mempool.h" /* own include */
@@ -106,6 +107,33 @@ typedef struct BLI_mempool_chunk {
   struct BLI_mempool_chunk *next;
 } BLI_mempool_chunk;
 
+/** Number of per-thread caches, must be a power of two. Threads hash into these,
+ * a collision only costs some spin-lock contention on one magazine. */
+#define MEMPOOL_MAGAZINE_NUM 16
+/** Elements moved between a magazine and the shared free list per refill/flush. */
+#define MEMPOOL_MAGAZINE_REFILL 64
+/** Flush back to the shared free list when a magazine grows past this. */
+#define MEMPOOL_MAGAZINE_FLUSH_LEN (MEMPOOL_MAGAZINE_REFILL * 2)
+
+/**
+ * A per-thread cache of free elements for #BLI_MEMPOOL_THREADSAFE pools.
+ * Elements held here stay marked with #FREEWORD, so iteration skips them.
+ */
+typedef struct MempoolMagazine {
+  SpinLock lock;
+  /** Single linked list of cached free elements, #BLI_mempool.esize apart. */
+  BLI_freenode *free;
+  uint free_len;
+  /** Keep magazines on separate cache lines. */
+  char _pad[64];
+} MempoolMagazine;
+
+typedef struct MempoolThreadData {
+  /** Guards #BLI_mempool.free, #BLI_mempool.chunks and chunk allocation. */
+  SpinLock lock;
+  MempoolMagazine magazines[MEMPOOL_MAGAZINE_NUM];
+} MempoolThreadData;
+
 /**
  * The mempool, stores and tracks memory \a chunks and elements within those chunks \a free.
  */
@@ -135,6 +163,9 @@ struct BLI_mempool {
   /** Number of elements allocated in total. */
   uint totalloc;
 #endif
+
+  /** Only for #BLI_MEMPOOL_THREADSAFE pools, NULL otherwise. */
+  MempoolThreadData *thread_data;
 };
 
 #define MEMPOOL_ELEM_SIZE_MIN (sizeof(void *) * 2)
@@ -201,6 +232,10 @@ static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
   BLI_freenode *curnode = CHUNK_DATA(mpchunk);
   uint j;
 
+  /* Terminate before appending, for threadsafe pools readers
+   * may walk the chunk list while we add to it. */
+  mpchunk->next = NULL;
+
   /* append */
   if (pool->chunk_tail) {
     pool->chunk_tail->next = mpchunk;
@@ -210,7 +245,6 @@ static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
     pool->chunks = mpchunk;
   }
 
-  mpchunk->next = NULL;
   pool->chunk_tail = mpchunk;
 
   if (UNLIKELY(pool->free == NULL)) {
@@ -316,6 +350,17 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
 #endif
   pool->totused = 0;
 
+  if (flag & BLI_MEMPOOL_THREADSAFE) {
+    pool->thread_data = MEM_callocN(sizeof(*pool->thread_data), "memory pool thread data");
+    BLI_spin_init(&pool->thread_data->lock);
+    for (i = 0; i < MEMPOOL_MAGAZINE_NUM; i++) {
+      BLI_spin_init(&pool->thread_data->magazines[i].lock);
+    }
+  }
+  else {
+    pool->thread_data = NULL;
+  }
+
   if (totelem) {
     /* Allocate the actual chunks. */
     for (i = 0; i < maxchunks; i++) {
@@ -331,10 +376,141 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
   return pool;
 }
 
+/** Hash the calling thread to a magazine slot, collisions are harmless. */
+static MempoolMagazine *mempool_magazine_get(MempoolThreadData *thread_data)
+{
+  /* #pthread_t is opaque (a struct on some platforms), hash its bytes. */
+  pthread_t self = pthread_self();
+  const uchar *p = (const uchar *)&self;
+  uint h = 5381;
+  for (uint i = 0; i < (uint)sizeof(self); i++) {
+    h = (h * 33) ^ p[i];
+  }
+  return &thread_data->magazines[h & (MEMPOOL_MAGAZINE_NUM - 1)];
+}
+
+static void *mempool_alloc_threadsafe(BLI_mempool *pool)
+{
+  MempoolThreadData *thread_data = pool->thread_data;
+  MempoolMagazine *mag = mempool_magazine_get(thread_data);
+  BLI_freenode *free_pop;
+
+  BLI_spin_lock(&mag->lock);
+
+  if (UNLIKELY(mag->free == NULL)) {
+    /* Refill a batch from the shared free list,
+     * this is the only allocation path that takes the shared lock. */
+    BLI_spin_lock(&thread_data->lock);
+    for (uint i = 0; i < MEMPOOL_MAGAZINE_REFILL; i++) {
+      if (UNLIKELY(pool->free == NULL)) {
+        BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
+        mempool_chunk_add(pool, mpchunk, NULL);
+      }
+      BLI_freenode *node = pool->free;
+      pool->free = node->next;
+      node->next = mag->free;
+      mag->free = node;
+    }
+    BLI_spin_unlock(&thread_data->lock);
+    mag->free_len = MEMPOOL_MAGAZINE_REFILL;
+  }
+
+  free_pop = mag->free;
+  mag->free = free_pop->next;
+  mag->free_len--;
+
+  BLI_spin_unlock(&mag->lock);
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    free_pop->freeword = USEDWORD;
+  }
+
+  atomic_add_and_fetch_u(&pool->totused, 1);
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(pool, free_pop, pool->esize);
+#endif
+
+  return (void *)free_pop;
+}
+
+static void mempool_free_threadsafe(BLI_mempool *pool, void *addr)
+{
+  MempoolThreadData *thread_data = pool->thread_data;
+  MempoolMagazine *mag = mempool_magazine_get(thread_data);
+  BLI_freenode *newhead = addr;
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+#ifndef NDEBUG
+    /* This will detect double free's. */
+    BLI_assert(newhead->freeword != FREEWORD);
+#endif
+    newhead->freeword = FREEWORD;
+  }
+
+  BLI_spin_lock(&mag->lock);
+
+  newhead->next = mag->free;
+  mag->free = newhead;
+  mag->free_len++;
+
+  if (UNLIKELY(mag->free_len > MEMPOOL_MAGAZINE_FLUSH_LEN)) {
+    /* Flush a batch back to the shared free list, so one thread freeing
+     * what another allocates doesn't accumulate everything locally. */
+    BLI_spin_lock(&thread_data->lock);
+    for (uint i = 0; i < MEMPOOL_MAGAZINE_REFILL; i++) {
+      BLI_freenode *node = mag->free;
+      mag->free = node->next;
+      node->next = pool->free;
+      pool->free = node;
+    }
+    BLI_spin_unlock(&thread_data->lock);
+    mag->free_len -= MEMPOOL_MAGAZINE_REFILL;
+  }
+
+  BLI_spin_unlock(&mag->lock);
+
+  atomic_sub_and_fetch_u(&pool->totused, 1);
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_FREE(pool, addr);
+#endif
+}
+
+/** Move all magazine contents back to the shared free list,
+ * callers must have exclusive access to the pool. */
+static void mempool_magazines_drain(BLI_mempool *pool)
+{
+  MempoolThreadData *thread_data = pool->thread_data;
+  for (uint i = 0; i < MEMPOOL_MAGAZINE_NUM; i++) {
+    MempoolMagazine *mag = &thread_data->magazines[i];
+    while (mag->free) {
+      BLI_freenode *node = mag->free;
+      mag->free = node->next;
+      node->next = pool->free;
+      pool->free = node;
+    }
+    mag->free_len = 0;
+  }
+}
+
+static void mempool_thread_data_free(BLI_mempool *pool)
+{
+  BLI_spin_end(&pool->thread_data->lock);
+  for (uint i = 0; i < MEMPOOL_MAGAZINE_NUM; i++) {
+    BLI_spin_end(&pool->thread_data->magazines[i].lock);
+  }
+  MEM_freeN(pool->thread_data);
+}
+
 void *BLI_mempool_alloc(BLI_mempool *pool)
 {
   BLI_freenode *free_pop;
 
+  if (pool->thread_data) {
+    return mempool_alloc_threadsafe(pool);
+  }
+
   if (UNLIKELY(pool->free == NULL)) {
     /* Need to allocate a new chunk. */
     BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
@@ -375,6 +551,11 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
 {
   BLI_freenode *newhead = addr;
 
+  if (pool->thread_data) {
+    mempool_free_threadsafe(pool, addr);
+    return;
+  }
+
 #ifndef NDEBUG
   {
     BLI_mempool_chunk *chunk;
@@ -705,6 +886,10 @@ void BLI_mempool_clear_ex(BLI_mempool *pool, const int totelem_reserve)
   VALGRIND_CREATE_MEMPOOL(pool, 0, false);
 #endif
 
+  if (pool->thread_data) {
+    mempool_magazines_drain(pool);
+  }
+
   if (totelem_reserve == -1) {
     maxchunks = pool->maxchunks;
   }
@@ -756,6 +941,10 @@ void BLI_mempool_clear(BLI_mempool *pool)
  */
 void BLI_mempool_destroy(BLI_mempool *pool)
 {
+  if (pool->thread_data) {
+    mempool_thread_data_free(pool);
+  }
+
   mempool_chunk_free_all(pool->chunks);
 
 #ifdef WITH_MEM_VALGRIND
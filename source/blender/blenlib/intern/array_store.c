@@ -104,6 +104,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 
 #include "BLI_strict_flags.h"
 
@@ -160,6 +161,20 @@
 #  define BCHUNK_HASH_LEN 4
 #endif
 
+/* Compute the de-duplication hashes in parallel (both the boundary hashes over the new data
+ * and the table keys of the reference chunks), hashing is independent per slice/chunk.
+ */
+#define USE_HASH_TABLE_PARALLEL
+
+#ifdef USE_HASH_TABLE_PARALLEL
+/* Number of hashes each task computes (multiplied by stride).
+ */
+#  define BCHUNK_PARALLEL_HASH_BLOCK_LEN (1 << 15)
+/* Don't bother threading arrays with fewer hashes than this.
+ */
+#  define BCHUNK_PARALLEL_HASH_MIN_LEN (1 << 17)
+#endif
+
 /* Calculate the key once and reuse it
  */
 #define USE_HASH_TABLE_KEY_CACHE
@@ -784,6 +799,56 @@ static void hash_array_from_data(const BArrayInfo *info,
   }
 }
 
+#  ifdef USE_HASH_TABLE_PARALLEL
+
+typedef struct HashArrayFromDataCtx {
+  const BArrayInfo *info;
+  const uchar *data_slice;
+  size_t hash_array_len;
+  hash_key *hash_array;
+} HashArrayFromDataCtx;
+
+static void hash_array_from_data_parallel_fn(void *__restrict userdata,
+                                             const int block,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const HashArrayFromDataCtx *ctx = userdata;
+  const size_t i = (size_t)block * BCHUNK_PARALLEL_HASH_BLOCK_LEN;
+  const size_t i_len = MIN2((size_t)BCHUNK_PARALLEL_HASH_BLOCK_LEN, ctx->hash_array_len - i);
+  hash_array_from_data(ctx->info,
+                       &ctx->data_slice[i * ctx->info->chunk_stride],
+                       i_len * ctx->info->chunk_stride,
+                       &ctx->hash_array[i]);
+}
+
+/*
+ * A multi-threaded version of hash_array_from_data,
+ * every hash only depends on its own slice so blocks can be computed independently.
+ */
+static void hash_array_from_data_parallel(const BArrayInfo *info,
+                                          const uchar *data_slice,
+                                          const size_t data_slice_len,
+                                          hash_key *hash_array)
+{
+  const size_t hash_array_len = data_slice_len / info->chunk_stride;
+  const size_t blocks_len = (hash_array_len + (BCHUNK_PARALLEL_HASH_BLOCK_LEN - 1)) /
+                            BCHUNK_PARALLEL_HASH_BLOCK_LEN;
+
+  HashArrayFromDataCtx ctx = {
+      .info = info,
+      .data_slice = data_slice,
+      .hash_array_len = hash_array_len,
+      .hash_array = hash_array,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (hash_array_len >= BCHUNK_PARALLEL_HASH_MIN_LEN);
+  BLI_task_parallel_range(0, (int)blocks_len, &ctx, hash_array_from_data_parallel_fn, &settings);
+}
+
+#  endif /* USE_HASH_TABLE_PARALLEL */
+
 /*
  * Similar to hash_array_from_data,
  * but able to step into the next chunk if we run-out of data.
@@ -909,6 +974,28 @@ static hash_key key_from_chunk_ref(const BArrayInfo *info,
   }
 }
 
+#  ifdef USE_HASH_TABLE_PARALLEL
+
+typedef struct TableKeysFromCrefsCtx {
+  const BArrayInfo *info;
+  const BTableRef *table_ref_stack;
+  hash_key *keys;
+  size_t hash_store_len;
+} TableKeysFromCrefsCtx;
+
+static void table_keys_from_crefs_fn(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  const TableKeysFromCrefsCtx *ctx = userdata;
+  /* Note that writing into the chunk key-cache from multiple threads is fine here:
+   * the key for a chunk is deterministic, so racing threads only ever store the same value. */
+  ctx->keys[i] = key_from_chunk_ref(
+      ctx->info, ctx->table_ref_stack[i].cref, tls->userdata_chunk, ctx->hash_store_len);
+}
+
+#  endif /* USE_HASH_TABLE_PARALLEL */
+
 static const BChunkRef *table_lookup(const BArrayInfo *info,
                                      BTableRef **table,
                                      const size_t table_len,
@@ -1206,7 +1293,11 @@ static BChunkList *bchunk_list_from_data_merge(const BArrayInfo *info,
     const size_t table_hash_array_len = (data_len - i_prev) / info->chunk_stride;
     hash_key *table_hash_array = MEM_mallocN(sizeof(*table_hash_array) * table_hash_array_len,
                                              __func__);
+#  ifdef USE_HASH_TABLE_PARALLEL
+    hash_array_from_data_parallel(info, &data[i_prev], data_len - i_prev, table_hash_array);
+#  else
     hash_array_from_data(info, &data[i_prev], data_len - i_prev, table_hash_array);
+#  endif
 
     hash_accum(table_hash_array, table_hash_array_len, info->accum_steps);
 #else
@@ -1259,14 +1350,20 @@ static BChunkList *bchunk_list_from_data_merge(const BArrayInfo *info,
 
       while ((cref != chunk_list_reference_last) &&
              (chunk_list_reference_bytes_remaining >= info->accum_read_ahead_bytes)) {
+#if defined(USE_HASH_TABLE_ACCUMULATE) && defined(USE_HASH_TABLE_PARALLEL)
+        /* Only collect the references here, their keys are computed in parallel below. */
+        BLI_assert(table_ref_stack_n < chunk_list_reference_remaining_len);
+        BTableRef *tref = &table_ref_stack[table_ref_stack_n++];
+        tref->cref = cref;
+#else
         hash_key key = key_from_chunk_ref(info,
                                           cref
 
-#ifdef USE_HASH_TABLE_ACCUMULATE
+#  ifdef USE_HASH_TABLE_ACCUMULATE
                                           ,
                                           hash_store,
                                           hash_store_len
-#endif
+#  endif
         );
         size_t key_index = (size_t)(key % (hash_key)table_len);
         BTableRef *tref_prev = table[key_index];
@@ -1275,11 +1372,44 @@ static BChunkList *bchunk_list_from_data_merge(const BArrayInfo *info,
         tref->cref = cref;
         tref->next = tref_prev;
         table[key_index] = tref;
+#endif
 
         chunk_list_reference_bytes_remaining -= cref->link->data_len;
         cref = cref->next;
       }
 
+#if defined(USE_HASH_TABLE_ACCUMULATE) && defined(USE_HASH_TABLE_PARALLEL)
+      if (table_ref_stack_n != 0) {
+        hash_key *keys = MEM_mallocN(sizeof(*keys) * table_ref_stack_n, __func__);
+
+        TableKeysFromCrefsCtx ctx = {
+            .info = info,
+            .table_ref_stack = table_ref_stack,
+            .keys = keys,
+            .hash_store_len = hash_store_len,
+        };
+
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.use_threading = (table_ref_stack_n >= 256);
+        /* Every thread gets its own scratch space to accumulate hashes in. */
+        settings.userdata_chunk = hash_store;
+        settings.userdata_chunk_size = sizeof(hash_key) * hash_store_len;
+        BLI_task_parallel_range(
+            0, (int)table_ref_stack_n, &ctx, table_keys_from_crefs_fn, &settings);
+
+        /* Insert in walk order, so bucket chains match the single-threaded layout exactly. */
+        for (uint i = 0; i < table_ref_stack_n; i++) {
+          BTableRef *tref = &table_ref_stack[i];
+          const size_t key_index = (size_t)(keys[i] % (hash_key)table_len);
+          tref->next = table[key_index];
+          table[key_index] = tref;
+        }
+
+        MEM_freeN(keys);
+      }
+#endif
+
       BLI_assert(table_ref_stack_n <= chunk_list_reference_remaining_len);
 
 #ifdef USE_HASH_TABLE_ACCUMULATE
@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include "BLI_bitmap.h"
+#include "BLI_math_bits.h"
 #include "BLI_utildefines.h"
 
 /** Set or clear all bits in the bitmap. */
@@ -67,3 +68,54 @@ void BLI_bitmap_or_all(BLI_bitmap *dst, const BLI_bitmap *src, size_t bits)
     dst[i] |= src[i];
   }
 }
+
+/**
+ * Number of set bits in the first \a bits bits,
+ * a whole block at a time instead of testing every bit.
+ */
+size_t BLI_bitmap_count_set(const BLI_bitmap *bitmap, size_t bits)
+{
+  const size_t full_blocks = bits >> _BITMAP_POWER;
+  const uint rest = bits & _BITMAP_MASK;
+  size_t count = 0;
+
+  for (size_t i = 0; i < full_blocks; i++) {
+    count += (size_t)count_bits_i(bitmap[i]);
+  }
+  if (rest != 0) {
+    count += (size_t)count_bits_i(bitmap[full_blocks] & ((1u << rest) - 1));
+  }
+  return count;
+}
+
+/**
+ * Find the lowest set bit at or after \a index_start, -1 when there is none.
+ * Skips unset blocks, so sparse bitmaps scan much faster than per-bit testing.
+ *
+ * \note Bits past \a bits in the last block are ignored
+ * (they may be set by whole-block operations like #BLI_bitmap_flip_all).
+ */
+int BLI_bitmap_find_next_set(const BLI_bitmap *bitmap, size_t bits, size_t index_start)
+{
+  const size_t blocks_num = (bits + _BITMAP_MASK) >> _BITMAP_POWER;
+  size_t i = index_start >> _BITMAP_POWER;
+  BLI_bitmap block;
+
+  if (index_start >= bits) {
+    return -1;
+  }
+
+  /* Mask out bits before the start index in its block. */
+  block = bitmap[i] & ~(BLI_bitmap)((1u << (index_start & _BITMAP_MASK)) - 1);
+
+  while (true) {
+    if (block != 0) {
+      const size_t index = (i << _BITMAP_POWER) + bitscan_forward_uint(block);
+      return (index < bits) ? (int)index : -1;
+    }
+    if (++i == blocks_num) {
+      return -1;
+    }
+    block = bitmap[i];
+  }
+}
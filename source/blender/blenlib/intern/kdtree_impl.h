@@ -23,6 +23,7 @@
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
 #include "BLI_strict_flags.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #define _CONCAT_AUX(MACRO_ARG1, MACRO_ARG2) MACRO_ARG1##MACRO_ARG2
@@ -145,20 +146,15 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+/**
+ * Quicksort style partitioning so the median element (`nodes_len / 2`)
+ * ends up in place, with smaller values before it and larger after (along \a axis).
+ */
+static void kdtree_balance_median_partition(KDTreeNode *nodes, const uint nodes_len, uint axis)
 {
-  KDTreeNode *node;
   float co;
   uint left, right, median, i, j;
 
-  if (nodes_len <= 0) {
-    return KD_NODE_UNSET;
-  }
-  else if (nodes_len == 1) {
-    return 0 + ofs;
-  }
-
-  /* quicksort style sorting around median */
   left = 0;
   right = nodes_len - 1;
   median = nodes_len / 2;
@@ -189,6 +185,22 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
       left = i + 1;
     }
   }
+}
+
+static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (nodes_len == 1) {
+    return 0 + ofs;
+  }
+
+  median = nodes_len / 2;
+  kdtree_balance_median_partition(nodes, nodes_len, axis);
 
   /* set node and sort subnodes */
   node = &nodes[median];
@@ -201,6 +213,69 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   return median + ofs;
 }
 
+/* Below this amount of nodes, subtrees are balanced serially:
+ * pushing a task costs more than the work it distributes. */
+#define KD_BALANCE_PARALLEL_LEAF_LEN 4096
+
+/**
+ * The root of any (sub)tree is fully determined by its length and offset
+ * (always the median), so parents can link children before balancing them.
+ */
+BLI_INLINE uint kdtree_balance_subtree_root(const uint nodes_len, const uint ofs)
+{
+  return (nodes_len == 0) ? KD_NODE_UNSET : (nodes_len / 2) + ofs;
+}
+
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+} KDTreeBalanceTask;
+
+static void kdtree_balance_task_push(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, uint ofs);
+
+static void kdtree_balance_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  const KDTreeBalanceTask *task = taskdata;
+  KDTreeNode *nodes = task->nodes;
+  const uint nodes_len = task->nodes_len;
+  const uint median = nodes_len / 2;
+  uint axis = task->axis;
+  KDTreeNode *node;
+
+  if (nodes_len <= KD_BALANCE_PARALLEL_LEAF_LEN) {
+    kdtree_balance(nodes, nodes_len, axis, task->ofs);
+    return;
+  }
+
+  kdtree_balance_median_partition(nodes, nodes_len, axis);
+
+  /* Link the children now (their roots only depend on the lengths),
+   * balance them as separate tasks. */
+  node = &nodes[median];
+  node->d = axis;
+  axis = (axis + 1) % KD_DIMS;
+  node->left = kdtree_balance_subtree_root(median, task->ofs);
+  node->right = kdtree_balance_subtree_root(nodes_len - (median + 1), (median + 1) + task->ofs);
+
+  kdtree_balance_task_push(pool, nodes, median, axis, task->ofs);
+  kdtree_balance_task_push(
+      pool, nodes + median + 1, nodes_len - (median + 1), axis, (median + 1) + task->ofs);
+}
+
+static void kdtree_balance_task_push(
+    TaskPool *pool, KDTreeNode *nodes, uint nodes_len, uint axis, uint ofs)
+{
+  KDTreeBalanceTask *task = MEM_mallocN(sizeof(*task), __func__);
+  task->nodes = nodes;
+  task->nodes_len = nodes_len;
+  task->axis = axis;
+  task->ofs = ofs;
+  BLI_task_pool_push(pool, kdtree_balance_task_run, task, true, NULL);
+}
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -210,7 +285,18 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if ((tree->nodes_len > KD_BALANCE_PARALLEL_LEAF_LEN) && (BLI_task_scheduler_num_threads() > 1)) {
+    /* Subtrees are disjoint node ranges, balance them as tasks. */
+    TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    kdtree_balance_task_push(pool, tree->nodes, tree->nodes_len, 0, 0);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+
+    tree->root = kdtree_balance_subtree_root(tree->nodes_len, 0);
+  }
+  else {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -332,6 +418,43 @@ int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
   return min_node->index;
 }
 
+typedef struct KDTreeNearestBatchData {
+  const KDTree *tree;
+  const float (*co_array)[KD_DIMS];
+  KDTreeNearest *r_nearest;
+} KDTreeNearestBatchData;
+
+static void kdtree_find_nearest_batched_fn(void *__restrict userdata,
+                                           const int i,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeNearestBatchData *data = userdata;
+  if (BLI_kdtree_nd_(find_nearest)(data->tree, data->co_array[i], &data->r_nearest[i]) == -1) {
+    data->r_nearest[i].index = -1;
+  }
+}
+
+/**
+ * Answer a batch of nearest-point queries at once, in parallel for large batches.
+ *
+ * Equivalent to calling #BLI_kdtree_3d_find_nearest for every element of \a co_array,
+ * with results written to the matching index of \a r_nearest
+ * (#KDTreeNearest.index is -1 when nothing was found).
+ */
+void BLI_kdtree_nd_(find_nearest_batched)(const KDTree *tree,
+                                          const float (*co_array)[KD_DIMS],
+                                          uint co_array_len,
+                                          KDTreeNearest *r_nearest)
+{
+  KDTreeNearestBatchData data = {tree, co_array, r_nearest};
+  TaskParallelSettings settings;
+
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_array_len > 1024);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, (int)co_array_len, &data, kdtree_find_nearest_batched_fn, &settings);
+}
+
 /**
  * A version of #BLI_kdtree_3d_find_nearest which runs a callback
  * to filter out values.
@@ -591,6 +591,34 @@ int BLI_listbase_count(const ListBase *listbase)
   return count;
 }
 
+/**
+ * Returns an array with the links of \a listbase in order, or NULL when the list is empty.
+ * The number of links is stored in \a r_len.
+ *
+ * Useful to avoid the pointer-chasing of repeated or cache-unfriendly list traversal,
+ * the array is a snapshot: it is owned by the caller (free with #MEM_freeN)
+ * and is not updated when the list changes.
+ */
+void **BLI_listbase_as_array(const ListBase *listbase, int *r_len)
+{
+  const int len = BLI_listbase_count(listbase);
+  void **array;
+  int i = 0;
+
+  if (len == 0) {
+    *r_len = 0;
+    return NULL;
+  }
+
+  array = MEM_mallocN(sizeof(*array) * (size_t)len, __func__);
+  for (Link *link = listbase->first; link; link = link->next) {
+    array[i++] = link;
+  }
+
+  *r_len = len;
+  return array;
+}
+
 /**
  * Returns the nth element of \a listbase, numbering from 0.
  */
@@ -22,15 +22,18 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_sort.h"
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
 
 #if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8))
 /* do nothing! */
 #else
 
-#  include "BLI_utildefines.h"
-
-#  include "BLI_sort.h"
-
 #  ifdef min /* for msvc */
 #    undef min
 #  endif
@@ -183,3 +186,179 @@ loop:
 /* clang-format on */
 
 #endif /* __GLIBC__ */
+
+/* -------------------------------------------------------------------- */
+/** \name Parallel Merge Sort
+ * \{ */
+
+/* Below this amount of elements per chunk, splitting adds more overhead than the
+ * parallelism gains. */
+#define SORT_PARALLEL_CHUNK_LEN_MIN 4096
+
+/**
+ * Merge two consecutive sorted runs, \a run_a must already be copied out of \a dst.
+ * Stable: on ties the element of \a run_a wins.
+ */
+static void sort_merge_runs(char *dst,
+                            const char *run_a,
+                            size_t a_len,
+                            const char *run_b,
+                            size_t b_len,
+                            const size_t es,
+                            BLI_sort_cmp_t cmp,
+                            void *thunk)
+{
+  while (a_len && b_len) {
+    if (cmp(run_b, run_a, thunk) < 0) {
+      memcpy(dst, run_b, es);
+      run_b += es;
+      b_len--;
+    }
+    else {
+      memcpy(dst, run_a, es);
+      run_a += es;
+      a_len--;
+    }
+    dst += es;
+  }
+  if (a_len) {
+    memcpy(dst, run_a, a_len * es);
+  }
+  if (b_len) {
+    memcpy(dst, run_b, b_len * es);
+  }
+}
+
+/**
+ * Serial top-down merge sort of \a a, using \a tmp (same size) as scratch space.
+ */
+static void sort_serial_stable(
+    char *a, char *tmp, const size_t n, const size_t es, BLI_sort_cmp_t cmp, void *thunk)
+{
+  const size_t h = n / 2;
+
+  if (n < 2) {
+    return;
+  }
+
+  sort_serial_stable(a, tmp, h, es, cmp, thunk);
+  sort_serial_stable(a + (h * es), tmp + (h * es), n - h, es, cmp, thunk);
+
+  /* Often the data is partially ordered already, skip the merge then. */
+  if (cmp(a + (h * es), a + ((h - 1) * es), thunk) >= 0) {
+    return;
+  }
+
+  /* Only the left run needs to be copied out,
+   * the merge destination never overtakes the right run. */
+  memcpy(tmp, a, h * es);
+  sort_merge_runs(a, tmp, h, a + (h * es), n - h, es, cmp, thunk);
+}
+
+typedef struct SortParallelData {
+  char *src, *dst;
+  size_t n, es;
+  /* Elements per chunk in the chunk-sort pass, run width in merge passes. */
+  size_t width;
+  BLI_sort_cmp_t cmp;
+  void *thunk;
+} SortParallelData;
+
+static void sort_parallel_chunk_fn(void *__restrict userdata,
+                                   const int iter,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SortParallelData *data = userdata;
+  const size_t start = (size_t)iter * data->width;
+  const size_t len = MIN2(data->width, data->n - start);
+
+  sort_serial_stable(
+      data->src + (start * data->es), data->dst + (start * data->es), len, data->es, data->cmp, data->thunk);
+}
+
+static void sort_parallel_merge_fn(void *__restrict userdata,
+                                   const int iter,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SortParallelData *data = userdata;
+  const size_t es = data->es;
+  const size_t start = (size_t)iter * (data->width * 2);
+  const size_t a_len = MIN2(data->width, data->n - start);
+  const size_t b_len = MIN2(data->width, data->n - start - a_len);
+
+  sort_merge_runs(data->dst + (start * es),
+                  data->src + (start * es),
+                  a_len,
+                  data->src + ((start + a_len) * es),
+                  b_len,
+                  es,
+                  data->cmp,
+                  data->thunk);
+}
+
+/**
+ * Stable parallel merge sort, a drop-in replacement for #BLI_qsort_r on large arrays.
+ *
+ * Chunks are sorted in parallel, then merged pair-wise in passes that ping-pong between
+ * \a a and a scratch buffer. Falls back to a serial sort for small arrays or
+ * single threaded schedulers.
+ *
+ * \note Unlike #BLI_qsort_r this is stable: equal elements keep their relative order,
+ * at the cost of a temporary buffer of the same size as \a a.
+ */
+void BLI_sort_parallel(void *a, size_t n, size_t es, BLI_sort_cmp_t cmp, void *thunk)
+{
+  char *src = a;
+  char *tmp, *dst;
+  size_t nchunks, width;
+  TaskParallelSettings settings;
+  SortParallelData data;
+
+  if (n < 2) {
+    return;
+  }
+
+  tmp = MEM_mallocN(n * es, __func__);
+
+  nchunks = 1;
+  while ((nchunks < (size_t)BLI_task_scheduler_num_threads()) &&
+         ((n / (nchunks * 2)) >= SORT_PARALLEL_CHUNK_LEN_MIN)) {
+    nchunks *= 2;
+  }
+  width = (n + nchunks - 1) / nchunks;
+
+  data.src = src;
+  data.dst = tmp;
+  data.n = n;
+  data.es = es;
+  data.width = width;
+  data.cmp = cmp;
+  data.thunk = thunk;
+
+  /* Sort each chunk (serial merge sort, scratch space is the chunk's slice of `tmp`). */
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (nchunks > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, (int)nchunks, &data, sort_parallel_chunk_fn, &settings);
+
+  /* Merge pair-wise, doubling the run width each pass. */
+  dst = tmp;
+  for (; width < n; width *= 2) {
+    const size_t npairs = (n + (width * 2) - 1) / (width * 2);
+
+    data.src = src;
+    data.dst = dst;
+    data.width = width;
+    BLI_task_parallel_range(0, (int)npairs, &data, sort_parallel_merge_fn, &settings);
+
+    SWAP(char *, src, dst);
+  }
+
+  if (src != (char *)a) {
+    memcpy(a, src, n * es);
+  }
+
+  MEM_freeN(tmp);
+}
+
+/** \} */
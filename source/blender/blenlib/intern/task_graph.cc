@@ -94,7 +94,17 @@ struct TaskNode {
 #ifdef WITH_TBB
   tbb::flow::continue_msg run(const tbb::flow::continue_msg UNUSED(input))
   {
-    tbb::this_task_arena::isolate([this] { run_func(task_data); });
+    tbb::this_task_arena::isolate([this] {
+      if (UNLIKELY(BLI_task_trace_is_enabled())) {
+        TaskTraceSpan span;
+        BLI_task_trace_span_begin(&span);
+        run_func(task_data);
+        BLI_task_trace_span_end(&span, "task_graph");
+      }
+      else {
+        run_func(task_data);
+      }
+    });
     return tbb::flow::continue_msg();
   }
 #endif
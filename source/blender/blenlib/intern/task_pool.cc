@@ -115,11 +115,24 @@ class Task {
   void operator()() const
   {
 #ifdef WITH_TBB
-    tbb::this_task_arena::isolate([this] { run(pool, taskdata); });
+    tbb::this_task_arena::isolate([this] { run_maybe_traced(); });
 #else
-    run(pool, taskdata);
+    run_maybe_traced();
 #endif
   }
+
+  void run_maybe_traced() const
+  {
+    if (UNLIKELY(BLI_task_trace_is_enabled())) {
+      TaskTraceSpan span;
+      BLI_task_trace_span_begin(&span);
+      run(pool, taskdata);
+      BLI_task_trace_span_end(&span, "task_pool");
+    }
+    else {
+      run(pool, taskdata);
+    }
+  }
 };
 
 /* TBB Task Group.
@@ -90,11 +90,21 @@ struct RangeTask {
   void operator()(const tbb::blocked_range<int> &r) const
   {
     tbb::this_task_arena::isolate([this, r] {
+      TaskTraceSpan span;
+      const bool use_trace = BLI_task_trace_is_enabled();
+      if (UNLIKELY(use_trace)) {
+        BLI_task_trace_span_begin(&span);
+      }
+
       TaskParallelTLS tls;
       tls.userdata_chunk = userdata_chunk;
       for (int i = r.begin(); i != r.end(); ++i) {
         func(userdata, i, &tls);
       }
+
+      if (UNLIKELY(use_trace)) {
+        BLI_task_trace_span_end(&span, "parallel_range");
+      }
     });
   }
 
@@ -0,0 +1,151 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * Recording of task execution for scheduler debugging, see BLI_task.h.
+ *
+ * Events are appended to one shared vector under a mutex. This costs a lock per finished
+ * task, which is noise compared to the tasks themselves (tracing is meant for workloads
+ * where tasks are at least in the microsecond range); in return start/stop stay trivial.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "PIL_time.h"
+
+#include "BLI_task.h"
+
+namespace {
+
+struct TaskTraceEvent {
+  /** Must point to a static string. */
+  const char *name;
+  double time_begin;
+  double time_end;
+  /** Hash of the executing thread, only used to separate trace rows. */
+  size_t thread_id;
+  /** Number of busy workers when the task started / after it ended. */
+  int occupancy_begin;
+  int occupancy_end;
+};
+
+struct TaskTraceState {
+  std::atomic<bool> enabled{false};
+  std::atomic<int> workers_busy{0};
+  std::mutex events_mutex;
+  std::vector<TaskTraceEvent> events;
+  double time_start = 0.0;
+};
+
+TaskTraceState g_trace;
+
+}  // namespace
+
+bool BLI_task_trace_is_enabled(void)
+{
+  return g_trace.enabled.load(std::memory_order_relaxed);
+}
+
+void BLI_task_trace_start(void)
+{
+  std::lock_guard<std::mutex> lock(g_trace.events_mutex);
+  g_trace.events.clear();
+  g_trace.events.reserve(1 << 16);
+  g_trace.workers_busy.store(0, std::memory_order_relaxed);
+  g_trace.time_start = PIL_check_seconds_timer();
+  g_trace.enabled.store(true, std::memory_order_relaxed);
+}
+
+void BLI_task_trace_span_begin(TaskTraceSpan *span)
+{
+  span->occupancy_begin = g_trace.workers_busy.fetch_add(1, std::memory_order_relaxed) + 1;
+  span->time_begin = PIL_check_seconds_timer();
+}
+
+void BLI_task_trace_span_end(const TaskTraceSpan *span, const char *name)
+{
+  const double time_end = PIL_check_seconds_timer();
+  const int occupancy_end = g_trace.workers_busy.fetch_sub(1, std::memory_order_relaxed) - 1;
+  const size_t thread_id = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+  std::lock_guard<std::mutex> lock(g_trace.events_mutex);
+  /* Tracing may have been stopped while this task ran, drop the event then. */
+  if (!g_trace.enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  g_trace.events.push_back(
+      {name, span->time_begin, time_end, thread_id, span->occupancy_begin, occupancy_end});
+}
+
+/** Timestamps are microseconds relative to #TaskTraceState.time_start, as Chrome expects. */
+static double trace_time_us(const double time)
+{
+  return (time - g_trace.time_start) * 1.0e6;
+}
+
+void BLI_task_trace_stop_and_write(const char *filepath)
+{
+  std::lock_guard<std::mutex> lock(g_trace.events_mutex);
+
+  if (!g_trace.enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  g_trace.enabled.store(false, std::memory_order_relaxed);
+
+  FILE *file = fopen(filepath, "w");
+  if (file == NULL) {
+    fprintf(stderr, "Unable to write task trace to '%s'\n", filepath);
+    g_trace.events.clear();
+    return;
+  }
+
+  fprintf(file, "{\"traceEvents\":[\n");
+  bool first = true;
+  for (const TaskTraceEvent &event : g_trace.events) {
+    /* Duration event on the executing thread's row. */
+    fprintf(file,
+            "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}",
+            first ? "" : ",\n",
+            event.name,
+            event.thread_id,
+            trace_time_us(event.time_begin),
+            (event.time_end - event.time_begin) * 1.0e6);
+    /* Occupancy counter samples at both ends of the span,
+     * showing as a graph of busy workers over time. */
+    fprintf(file,
+            ",\n{\"name\":\"workers busy\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,"
+            "\"args\":{\"busy\":%d}}",
+            trace_time_us(event.time_begin),
+            event.occupancy_begin);
+    fprintf(file,
+            ",\n{\"name\":\"workers busy\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,"
+            "\"args\":{\"busy\":%d}}",
+            trace_time_us(event.time_end),
+            event.occupancy_end);
+    first = false;
+  }
+  fprintf(file, "\n]}\n");
+  fclose(file);
+
+  printf("Wrote task trace (%zu tasks) to '%s'\n", g_trace.events.size(), filepath);
+  g_trace.events.clear();
+}
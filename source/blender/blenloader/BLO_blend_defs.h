@@ -73,4 +73,24 @@ enum {
 
 #define BLEN_THUMB_MEMSIZE_FILE(_x, _y) (sizeof(int) * (2 + (size_t)(_x) * (size_t)(_y)))
 
+/**
+ * Optional table of contents, appended after the #ENDB block of uncompressed saves
+ * (readers stop at #ENDB, so older Blender versions simply ignore it).
+ *
+ * Layout, all values in the writing machine's byte order:
+ * - Per ID, in file order:
+ *   `uint32 name_len, char name[name_len], uint64 offset, uint64 size`
+ *   where name includes the two character ID code prefix,
+ *   offset/size span the ID block including all its DATA blocks.
+ * - Footer (last #BLEND_TOC_FOOTER_SIZE bytes of the file):
+ *   `uint64 entries_size, uint32 entries_count, uint32 version, char magic[8]`
+ *
+ * Readers that find no valid footer (old files, compressed files, foreign endianness)
+ * fall back to scanning the BHead list.
+ */
+#define BLEND_TOC_MAGIC "BlendTOC"
+#define BLEND_TOC_MAGIC_SIZE 8
+#define BLEND_TOC_VERSION 1
+#define BLEND_TOC_FOOTER_SIZE (8 + 4 + 4 + BLEND_TOC_MAGIC_SIZE)
+
 #endif /* __BLO_BLEND_DEFS_H__ */
@@ -84,6 +84,10 @@ extern void BLO_memfile_clear_future(MemFile *memfile);
 extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                          struct Main *bmain,
                                          struct Scene **r_scene);
+extern void *BLO_memfile_flatten(const struct MemFile *memfile, size_t *r_buffer_size);
 extern bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename);
+extern bool BLO_memfile_buffer_write_file(const void *buffer,
+                                          size_t buffer_size,
+                                          const char *filename);
 
 #endif /* __BLO_UNDOFILE_H__ */
@@ -144,6 +144,20 @@ LinkNode *BLO_blendhandle_get_datablock_names(BlendHandle *bh, int ofblocktype,
   BHead *bhead;
   int tot = 0;
 
+  /* Use the table of contents appended at save time when there is one,
+   * this avoids scanning every BHead of the file (a big win on network storage). */
+  if (blo_filedata_toc_ensure(fd)) {
+    LISTBASE_FOREACH (BlendTocEntry *, entry, &fd->toc_entries) {
+      if (GS(entry->name) == ofblocktype) {
+        BLI_linklist_prepend(&names, strdup(entry->name + 2));
+        tot++;
+      }
+    }
+
+    *tot_names = tot;
+    return names;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ofblocktype) {
       const char *idname = blo_bhead_id_name(fd, bhead);
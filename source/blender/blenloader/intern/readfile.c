@@ -106,6 +106,8 @@
 #include "BLI_linklist.h"
 #include "BLI_math.h"
 #include "BLI_mempool.h"
+#include "BLI_mmap.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BLT_translation.h"
@@ -272,6 +274,8 @@ typedef struct BHeadN {
   bool has_data;
 #endif
   bool is_memchunk_identical;
+  /** Result of the parallel DNA decoding pre-pass, consumed by #read_struct, may be NULL. */
+  void *decoded;
   struct BHead bhead;
 } BHeadN;
 
@@ -884,6 +888,7 @@ static BHeadN *get_bhead(FileData *fd)
           new_bhead->file_offset = fd->file_offset;
           new_bhead->has_data = false;
           new_bhead->is_memchunk_identical = false;
+          new_bhead->decoded = NULL;
           new_bhead->bhead = bhead;
           off64_t seek_new = fd->seek(fd, bhead.len, SEEK_CUR);
           if (seek_new == -1) {
@@ -907,6 +912,7 @@ static BHeadN *get_bhead(FileData *fd)
           new_bhead->has_data = true;
 #endif
           new_bhead->is_memchunk_identical = false;
+          new_bhead->decoded = NULL;
           new_bhead->bhead = bhead;
 
           readsize = fd->read(fd, new_bhead + 1, bhead.len, &new_bhead->is_memchunk_identical);
@@ -1018,6 +1024,7 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
   new_bhead_data->file_offset = new_bhead->file_offset;
   new_bhead_data->has_data = true;
   new_bhead_data->is_memchunk_identical = false;
+  new_bhead_data->decoded = NULL;
   if (!blo_bhead_read_data(fd, thisblock, new_bhead_data + 1)) {
     MEM_freeN(new_bhead_data);
     return NULL;
@@ -1193,6 +1200,50 @@ static off64_t fd_seek_data_from_file(FileData *filedata, off64_t offset, int wh
   return filedata->file_offset;
 }
 
+/* Memory-mapped file reading.
+ * By using mmap(), we can map a file so that it can be treated like normal memory,
+ * meaning that we can just read from it with memcpy() etc.
+ * This avoids system call overhead and can significantly speed up file loading.
+ */
+
+static int fd_read_from_mmap(FileData *filedata,
+                             void *buffer,
+                             uint size,
+                             bool *UNUSED(r_is_memchunck_identical))
+{
+  /* don't read more bytes then there are available in the buffer */
+  int readsize = (int)MIN2(size, (uint)(filedata->buffersize - filedata->file_offset));
+
+  if (!BLI_mmap_read(filedata->mmap_file, buffer, filedata->file_offset, readsize)) {
+    return 0;
+  }
+
+  filedata->file_offset += readsize;
+
+  return readsize;
+}
+
+static off64_t fd_seek_from_mmap(FileData *filedata, off64_t offset, int whence)
+{
+  off64_t new_offset;
+  if (whence == SEEK_CUR) {
+    new_offset = filedata->file_offset + offset;
+  }
+  else if (whence == SEEK_END) {
+    new_offset = filedata->buffersize + offset;
+  }
+  else {
+    new_offset = offset;
+  }
+
+  if (new_offset < 0 || new_offset > filedata->buffersize) {
+    return -1;
+  }
+
+  filedata->file_offset = new_offset;
+  return filedata->file_offset;
+}
+
 /* GZip file reading. */
 
 static int fd_read_gzip_from_file(FileData *filedata,
@@ -1375,9 +1426,24 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   }
 
   /* Regular file. */
+  BLI_mmap_file *mmap_file = NULL;
   if (memcmp(header, "BLENDER", sizeof(header)) == 0) {
     read_fn = fd_read_data_from_file;
     seek_fn = fd_seek_data_from_file;
+
+    /* Try to use a memory-mapped view of the file for zero-copy reads, falling back on
+     * regular reads if mapping fails (e.g. exotic file systems). Files that don't fit the
+     * `buffersize` range keep the plain read path too. */
+    const off64_t file_len = BLI_lseek(file, 0, SEEK_END);
+    BLI_lseek(file, 0, SEEK_SET);
+    if (file_len != -1 && file_len <= INT_MAX) {
+      mmap_file = BLI_mmap_open(file);
+      BLI_lseek(file, 0, SEEK_SET);
+      if (mmap_file != NULL) {
+        read_fn = fd_read_from_mmap;
+        seek_fn = fd_seek_from_mmap;
+      }
+    }
   }
 
   /* Gzip file. */
@@ -1411,6 +1477,11 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   fd->filedes = file;
   fd->gzfiledes = gzfile;
+  fd->mmap_file = mmap_file;
+  if (mmap_file != NULL) {
+    fd->buffersize = (int)BLI_lseek(file, 0, SEEK_END);
+    BLI_lseek(file, 0, SEEK_SET);
+  }
 
   fd->read = read_fn;
   fd->seek = seek_fn;
@@ -1451,6 +1522,94 @@ FileData *blo_filedata_from_file(const char *filepath, ReportList *reports)
   return NULL;
 }
 
+/**
+ * Read the optional table of contents appended after the ENDB block
+ * (layout documented at #BLEND_TOC_MAGIC), filling `fd->toc_entries`.
+ *
+ * \return false when the file has no (valid) table of contents,
+ * callers are expected to fall back on scanning the BHead list then.
+ */
+bool blo_filedata_toc_ensure(FileData *fd)
+{
+  if (fd->toc_checked) {
+    return !BLI_listbase_is_empty(&fd->toc_entries);
+  }
+  fd->toc_checked = true;
+
+  /* Needs random file access, also excludes compressed and memfile reading
+   * (compressed saves are written without a table of contents). */
+  if (fd->seek == NULL) {
+    return false;
+  }
+
+  const off64_t offset_backup = fd->file_offset;
+  const off64_t file_len = fd->seek(fd, 0, SEEK_END);
+  bool success = false;
+  uchar *entries_buf = NULL;
+
+  if (file_len >= (off64_t)(SIZEOFBLENDERHEADER + BLEND_TOC_FOOTER_SIZE)) {
+    uchar footer[BLEND_TOC_FOOTER_SIZE];
+    uint64_t entries_size;
+    uint32_t entries_count, version;
+
+    if ((fd->seek(fd, file_len - BLEND_TOC_FOOTER_SIZE, SEEK_SET) != -1) &&
+        (fd->read(fd, footer, sizeof(footer), NULL) == sizeof(footer))) {
+      memcpy(&entries_size, footer + 0, sizeof(entries_size));
+      memcpy(&entries_count, footer + 8, sizeof(entries_count));
+      memcpy(&version, footer + 12, sizeof(version));
+
+      /* The version check also rejects files written with a foreign byte order. */
+      if ((memcmp(footer + 16, BLEND_TOC_MAGIC, BLEND_TOC_MAGIC_SIZE) == 0) &&
+          (version == BLEND_TOC_VERSION) &&
+          (entries_size <= (uint64_t)(file_len - BLEND_TOC_FOOTER_SIZE)) &&
+          /* Each entry is at least 21 bytes (two lengths, offsets and one name byte). */
+          ((uint64_t)entries_count <= entries_size / 21)) {
+        const off64_t entries_offset = file_len - BLEND_TOC_FOOTER_SIZE - (off64_t)entries_size;
+        entries_buf = MEM_mallocN((size_t)entries_size, __func__);
+        if ((fd->seek(fd, entries_offset, SEEK_SET) != -1) &&
+            (fd->read(fd, entries_buf, (uint)entries_size, NULL) == (int)entries_size)) {
+          size_t cursor = 0;
+          success = true;
+          for (uint32_t i = 0; i < entries_count; i++) {
+            uint32_t name_len;
+            if (cursor + sizeof(name_len) > entries_size) {
+              success = false;
+              break;
+            }
+            memcpy(&name_len, entries_buf + cursor, sizeof(name_len));
+            cursor += sizeof(name_len);
+            if ((name_len == 0) || (name_len >= sizeof(((BlendTocEntry *)NULL)->name)) ||
+                (cursor + name_len + 2 * sizeof(uint64_t) > entries_size)) {
+              success = false;
+              break;
+            }
+            BlendTocEntry *entry = MEM_callocN(sizeof(*entry), "BlendTocEntry");
+            memcpy(entry->name, entries_buf + cursor, name_len);
+            cursor += name_len;
+            memcpy(&entry->offset, entries_buf + cursor, sizeof(entry->offset));
+            cursor += sizeof(entry->offset);
+            memcpy(&entry->size, entries_buf + cursor, sizeof(entry->size));
+            cursor += sizeof(entry->size);
+            BLI_addtail(&fd->toc_entries, entry);
+          }
+        }
+      }
+    }
+  }
+
+  if (entries_buf != NULL) {
+    MEM_freeN(entries_buf);
+  }
+  if (!success) {
+    BLI_freelistN(&fd->toc_entries);
+  }
+
+  /* Leave the regular read position untouched for the BHead streaming code. */
+  fd->seek(fd, offset_backup, SEEK_SET);
+
+  return success;
+}
+
 /**
  * Same as blo_filedata_from_file(), but does not reads DNA data, only header.
  * Use it for light access (e.g. thumbnail reading).
@@ -1478,20 +1637,32 @@ static int fd_read_gzip_from_memory(FileData *filedata,
   filedata->strm.next_out = (Bytef *)buffer;
   filedata->strm.avail_out = size;
 
-  // Inflate another chunk.
-  err = inflate(&filedata->strm, Z_SYNC_FLUSH);
+  while (filedata->strm.avail_out > 0) {
+    // Inflate another chunk.
+    err = inflate(&filedata->strm, Z_SYNC_FLUSH);
 
-  if (err == Z_STREAM_END) {
-    return 0;
-  }
-  else if (err != Z_OK) {
-    printf("fd_read_gzip_from_memory: zlib error\n");
-    return 0;
+    if (err == Z_STREAM_END) {
+      if (filedata->strm.avail_in == 0) {
+        /* True end of the data. */
+        break;
+      }
+      /* Files written with parallel compression are a concatenation of gzip members,
+       * continue inflating with the next one. */
+      if (inflateReset(&filedata->strm) != Z_OK) {
+        printf("fd_read_gzip_from_memory: zlib error\n");
+        break;
+      }
+    }
+    else if (err != Z_OK) {
+      printf("fd_read_gzip_from_memory: zlib error\n");
+      break;
+    }
   }
 
-  filedata->file_offset += size;
+  const int readsize = (int)(size - filedata->strm.avail_out);
+  filedata->file_offset += readsize;
 
-  return (size);
+  return readsize;
 }
 
 static int fd_read_gzip_from_memory_init(FileData *fd)
@@ -1569,6 +1740,11 @@ void blo_filedata_free(FileData *fd)
       close(fd->filedes);
     }
 
+    if (fd->mmap_file != NULL) {
+      BLI_mmap_free(fd->mmap_file);
+      fd->mmap_file = NULL;
+    }
+    BLI_freelistN(&fd->toc_entries);
     if (fd->gzfiledes != NULL) {
       gzclose(fd->gzfiledes);
     }
@@ -1586,13 +1762,22 @@ void blo_filedata_free(FileData *fd)
 
     /* Free all BHeadN data blocks */
 #ifndef NDEBUG
-    BLI_freelistN(&fd->bhead_list);
+    LISTBASE_FOREACH_MUTABLE (BHeadN *, new_bhead, &fd->bhead_list) {
+      /* Decoded data not consumed by #read_struct (e.g. skipped data-blocks). */
+      if (new_bhead->decoded != NULL) {
+        MEM_freeN(new_bhead->decoded);
+      }
+      MEM_freeN(new_bhead);
+    }
 #else
     /* Sanity check we're not keeping memory we don't need. */
     LISTBASE_FOREACH_MUTABLE (BHeadN *, new_bhead, &fd->bhead_list) {
       if (fd->seek != NULL && BHEAD_USE_READ_ON_DEMAND(&new_bhead->bhead)) {
         BLI_assert(new_bhead->has_data == 0);
       }
+      if (new_bhead->decoded != NULL) {
+        MEM_freeN(new_bhead->decoded);
+      }
       MEM_freeN(new_bhead);
     }
 #endif
@@ -2346,6 +2531,15 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
     BHead *bh_orig = bh;
 #endif
 
+    /* Use result of the parallel decoding pre-pass when available, see #read_structs_parallel.
+     * Ownership of the decoded memory is transferred to the caller. */
+    BHeadN *bhn = BHEADN_FROM_BHEAD(bh);
+    if (bhn->decoded != NULL) {
+      temp = bhn->decoded;
+      bhn->decoded = NULL;
+      return temp;
+    }
+
     /* switch is based on file dna */
     if (bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
@@ -2406,6 +2600,74 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
   return temp;
 }
 
+/* Parallel DNA decoding pre-pass.
+ *
+ * Decoding file data into runtime structs (endian switching, DNA reconstruction, or a plain
+ * copy when the file DNA matches) accounts for most of the serial time spent reading large
+ * files, while being fully independent per data-block. Decode all DATA blocks that are already
+ * in memory through a task pool up-front; #read_struct then merely takes ownership of the
+ * decoded memory during the (still serial) #read_libblock pass, where data-blocks are inserted
+ * into Main and the lib-link join stage runs as before.
+ *
+ * Blocks read on-demand from an uncompressed file (#USE_BHEAD_READ_ON_DEMAND) keep using the
+ * existing streaming path, since seeking the file descriptor is not thread-safe. */
+
+typedef struct BHeadDecodeTaskData {
+  BHeadN *first;
+  int count;
+} BHeadDecodeTaskData;
+
+static void read_structs_decode_task_fn(TaskPool *__restrict pool, void *taskdata)
+{
+  FileData *fd = BLI_task_pool_user_data(pool);
+  BHeadDecodeTaskData *data = taskdata;
+
+  BHeadN *bhn = data->first;
+  for (int i = 0; i < data->count; i++, bhn = bhn->next) {
+    if (bhn->bhead.code == DATA && bhn->has_data && bhn->bhead.len != 0) {
+      bhn->decoded = read_struct(fd, &bhn->bhead, "filedata");
+    }
+  }
+}
+
+static void read_structs_parallel(FileData *fd)
+{
+  /* Force reading all BHead's into #FileData.bhead_list (I/O stays serial). */
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    /* pass */
+  }
+
+  TaskPool *task_pool = BLI_task_pool_create(fd, TASK_PRIORITY_HIGH);
+
+  /* Batch decoding by payload size, so small data-blocks don't drown in scheduling overhead. */
+  const size_t chunk_size_limit = 1 << 20;
+  BHeadN *chunk_first = NULL;
+  int chunk_count = 0;
+  size_t chunk_size = 0;
+
+  LISTBASE_FOREACH (BHeadN *, bhn, &fd->bhead_list) {
+    if (chunk_first == NULL) {
+      chunk_first = bhn;
+      chunk_count = 0;
+      chunk_size = 0;
+    }
+    chunk_count++;
+    if (bhn->bhead.code == DATA && bhn->has_data) {
+      chunk_size += (size_t)bhn->bhead.len;
+    }
+    if (chunk_size >= chunk_size_limit || bhn->next == NULL) {
+      BHeadDecodeTaskData *data = MEM_mallocN(sizeof(*data), __func__);
+      data->first = chunk_first;
+      data->count = chunk_count;
+      BLI_task_pool_push(task_pool, read_structs_decode_task_fn, data, true, NULL);
+      chunk_first = NULL;
+    }
+  }
+
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+}
+
 /* Like read_struct, but gets a pointer without allocating. Only works for
  * undo since DNA must match. */
 static const void *peek_struct_undo(FileData *fd, BHead *bhead)
@@ -3236,6 +3498,9 @@ static void direct_link_fcurves(BlendDataReader *reader, ListBase *list)
     BLO_read_data_address(reader, &fcu->bezt);
     BLO_read_data_address(reader, &fcu->fpt);
 
+    /* runtime playback cache is never stored in files */
+    fcu->sample_cache = NULL;
+
     /* rna path */
     BLO_read_data_address(reader, &fcu->rna_path);
 
@@ -3363,6 +3628,9 @@ static void direct_link_nladata_strips(BlendDataReader *reader, ListBase *list)
   NlaStrip *strip;
 
   for (strip = list->first; strip; strip = strip->next) {
+    /* runtime data, no need to be saved */
+    strip->cache = NULL;
+
     /* strip's child strips */
     BLO_read_list(reader, &strip->strips);
     direct_link_nladata_strips(reader, &strip->strips);
@@ -6464,6 +6732,8 @@ static void direct_link_lightcache(BlendDataReader *reader, LightCache *cache)
 
   BLO_read_data_address(reader, &cache->cube_data);
   BLO_read_data_address(reader, &cache->grid_data);
+
+  cache->dirty_volumes = NULL; /* Runtime data. */
 }
 
 static void direct_link_view3dshading(BlendDataReader *reader, View3DShading *shading)
@@ -9839,6 +10109,40 @@ static void link_global(FileData *fd, BlendFileData *bfd)
 /** \name Versioning
  * \{ */
 
+typedef struct VersionIDPatchData {
+  BLOVersionIDPatchFn patch_fn;
+  void *patch_userdata;
+} VersionIDPatchData;
+
+static void do_versions_listbase_parallel_fn(void *__restrict userdata,
+                                             void *item,
+                                             int UNUSED(index),
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VersionIDPatchData *data = userdata;
+  data->patch_fn((ID *)item, data->patch_userdata);
+}
+
+/**
+ * Run a per-ID version patch over every ID in \a lb, from multiple threads when the list is
+ * long enough to be worth it.
+ *
+ * Opting a patch into this is only correct when it touches nothing outside the ID it is handed:
+ * no lookups into other `Main` lists that another patch may be mutating, no shared counters, and
+ * no dependency on list walk order. Patches with cross-ID state stay on plain serial loops.
+ */
+void blo_do_versions_listbase_parallel(ListBase *lb, BLOVersionIDPatchFn patch_fn, void *userdata)
+{
+  VersionIDPatchData data = {patch_fn, userdata};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Library files commonly hold only a handful of IDs per list,
+   * don't spin up workers for those. */
+  settings.use_threading = (BLI_listbase_count_at_most(lb, 64) == 64);
+  BLI_task_parallel_listbase(lb, &data, do_versions_listbase_parallel_fn, &settings);
+}
+
 /* initialize userdef with non-UI dependency stuff */
 /* other initializers (such as theme color defaults) go to resources.c */
 static void do_versions_userdef(FileData *fd, BlendFileData *bfd)
@@ -10290,6 +10594,12 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  if (fd->memfile == NULL && (fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
+    /* Decode data-block contents over all cores before the serial reconstruction pass below,
+     * see #read_structs_parallel. Not for undo, where most blocks are restored from old Main. */
+    read_structs_parallel(fd);
+  }
+
   while (bhead) {
     switch (bhead->code) {
       case DATA:
@@ -11593,116 +11903,124 @@ void BLO_expand_main(void *fdhandle, Main *mainvar)
 
     a = set_listbasepointers(mainvar, lbarray);
     while (a--) {
-      id = lbarray[a]->first;
-      while (id) {
-        if (id->tag & LIB_TAG_NEED_EXPAND) {
-          expand_id(fd, mainvar, id);
-
-          switch (GS(id->name)) {
-            case ID_OB:
-              expand_object(fd, mainvar, (Object *)id);
-              break;
-            case ID_ME:
-              expand_mesh(fd, mainvar, (Mesh *)id);
-              break;
-            case ID_CU:
-              expand_curve(fd, mainvar, (Curve *)id);
-              break;
-            case ID_MB:
-              expand_mball(fd, mainvar, (MetaBall *)id);
-              break;
-            case ID_SCE:
-              expand_scene(fd, mainvar, (Scene *)id);
-              break;
-            case ID_MA:
-              expand_material(fd, mainvar, (Material *)id);
-              break;
-            case ID_TE:
-              expand_texture(fd, mainvar, (Tex *)id);
-              break;
-            case ID_WO:
-              expand_world(fd, mainvar, (World *)id);
-              break;
-            case ID_LT:
-              expand_lattice(fd, mainvar, (Lattice *)id);
-              break;
-            case ID_LA:
-              expand_light(fd, mainvar, (Light *)id);
-              break;
-            case ID_KE:
-              expand_key(fd, mainvar, (Key *)id);
-              break;
-            case ID_CA:
-              expand_camera(fd, mainvar, (Camera *)id);
-              break;
-            case ID_SPK:
-              expand_speaker(fd, mainvar, (Speaker *)id);
-              break;
-            case ID_SO:
-              expand_sound(fd, mainvar, (bSound *)id);
-              break;
-            case ID_LP:
-              expand_lightprobe(fd, mainvar, (LightProbe *)id);
-              break;
-            case ID_AR:
-              expand_armature(fd, mainvar, (bArmature *)id);
-              break;
-            case ID_AC:
-              expand_action(fd, mainvar, (bAction *)id);  // XXX deprecated - old animation system
-              break;
-            case ID_GR:
-              expand_collection(fd, mainvar, (Collection *)id);
-              break;
-            case ID_NT:
-              expand_nodetree(fd, mainvar, (bNodeTree *)id);
-              break;
-            case ID_BR:
-              expand_brush(fd, mainvar, (Brush *)id);
-              break;
-            case ID_IP:
-              expand_ipo(fd, mainvar, (Ipo *)id);  // XXX deprecated - old animation system
-              break;
-            case ID_PA:
-              expand_particlesettings(fd, mainvar, (ParticleSettings *)id);
-              break;
-            case ID_MC:
-              expand_movieclip(fd, mainvar, (MovieClip *)id);
-              break;
-            case ID_MSK:
-              expand_mask(fd, mainvar, (Mask *)id);
-              break;
-            case ID_LS:
-              expand_linestyle(fd, mainvar, (FreestyleLineStyle *)id);
-              break;
-            case ID_GD:
-              expand_gpencil(fd, mainvar, (bGPdata *)id);
-              break;
-            case ID_CF:
-              expand_cachefile(fd, mainvar, (CacheFile *)id);
-              break;
-            case ID_WS:
-              expand_workspace(fd, mainvar, (WorkSpace *)id);
-              break;
-            case ID_HA:
-              expand_hair(fd, mainvar, (Hair *)id);
-              break;
-            case ID_PT:
-              expand_pointcloud(fd, mainvar, (PointCloud *)id);
-              break;
-            case ID_VO:
-              expand_volume(fd, mainvar, (Volume *)id);
-              break;
-            case ID_SIM:
-              expand_simulation(fd, mainvar, (Simulation *)id);
-              break;
-            default:
-              break;
-          }
+      /* Iterate each list until it stabilizes: expanding an ID routinely tags other IDs of the
+       * same type (parent/constraint/dupli-group chains between objects especially), handling
+       * those immediately avoids a full pass over every list per dependency level. */
+      bool do_it_lb = true;
+      while (do_it_lb) {
+        do_it_lb = false;
+        id = lbarray[a]->first;
+        while (id) {
+          if (id->tag & LIB_TAG_NEED_EXPAND) {
+            do_it_lb = true;
+            expand_id(fd, mainvar, id);
+
+            switch (GS(id->name)) {
+              case ID_OB:
+                expand_object(fd, mainvar, (Object *)id);
+                break;
+              case ID_ME:
+                expand_mesh(fd, mainvar, (Mesh *)id);
+                break;
+              case ID_CU:
+                expand_curve(fd, mainvar, (Curve *)id);
+                break;
+              case ID_MB:
+                expand_mball(fd, mainvar, (MetaBall *)id);
+                break;
+              case ID_SCE:
+                expand_scene(fd, mainvar, (Scene *)id);
+                break;
+              case ID_MA:
+                expand_material(fd, mainvar, (Material *)id);
+                break;
+              case ID_TE:
+                expand_texture(fd, mainvar, (Tex *)id);
+                break;
+              case ID_WO:
+                expand_world(fd, mainvar, (World *)id);
+                break;
+              case ID_LT:
+                expand_lattice(fd, mainvar, (Lattice *)id);
+                break;
+              case ID_LA:
+                expand_light(fd, mainvar, (Light *)id);
+                break;
+              case ID_KE:
+                expand_key(fd, mainvar, (Key *)id);
+                break;
+              case ID_CA:
+                expand_camera(fd, mainvar, (Camera *)id);
+                break;
+              case ID_SPK:
+                expand_speaker(fd, mainvar, (Speaker *)id);
+                break;
+              case ID_SO:
+                expand_sound(fd, mainvar, (bSound *)id);
+                break;
+              case ID_LP:
+                expand_lightprobe(fd, mainvar, (LightProbe *)id);
+                break;
+              case ID_AR:
+                expand_armature(fd, mainvar, (bArmature *)id);
+                break;
+              case ID_AC:
+                expand_action(fd, mainvar, (bAction *)id);  // XXX deprecated - old animation system
+                break;
+              case ID_GR:
+                expand_collection(fd, mainvar, (Collection *)id);
+                break;
+              case ID_NT:
+                expand_nodetree(fd, mainvar, (bNodeTree *)id);
+                break;
+              case ID_BR:
+                expand_brush(fd, mainvar, (Brush *)id);
+                break;
+              case ID_IP:
+                expand_ipo(fd, mainvar, (Ipo *)id);  // XXX deprecated - old animation system
+                break;
+              case ID_PA:
+                expand_particlesettings(fd, mainvar, (ParticleSettings *)id);
+                break;
+              case ID_MC:
+                expand_movieclip(fd, mainvar, (MovieClip *)id);
+                break;
+              case ID_MSK:
+                expand_mask(fd, mainvar, (Mask *)id);
+                break;
+              case ID_LS:
+                expand_linestyle(fd, mainvar, (FreestyleLineStyle *)id);
+                break;
+              case ID_GD:
+                expand_gpencil(fd, mainvar, (bGPdata *)id);
+                break;
+              case ID_CF:
+                expand_cachefile(fd, mainvar, (CacheFile *)id);
+                break;
+              case ID_WS:
+                expand_workspace(fd, mainvar, (WorkSpace *)id);
+                break;
+              case ID_HA:
+                expand_hair(fd, mainvar, (Hair *)id);
+                break;
+              case ID_PT:
+                expand_pointcloud(fd, mainvar, (PointCloud *)id);
+                break;
+              case ID_VO:
+                expand_volume(fd, mainvar, (Volume *)id);
+                break;
+              case ID_SIM:
+                expand_simulation(fd, mainvar, (Simulation *)id);
+                break;
+              default:
+                break;
+            }
 
-          do_it = true;
-          id->tag &= ~LIB_TAG_NEED_EXPAND;
+            do_it = true;
+            id->tag &= ~LIB_TAG_NEED_EXPAND;
+          }
+          id = id->next;
         }
-        id = id->next;
       }
     }
   }
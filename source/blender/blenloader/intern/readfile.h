@@ -81,6 +81,14 @@ typedef struct FileData {
   /** Regular file reading. */
   int filedes;
 
+  /** Memory-mapped file reading, may be NULL (fallback on regular reads). */
+  struct BLI_mmap_file *mmap_file;
+
+  /** Optional table of contents read from the file end (see #BLEND_TOC_MAGIC), may be empty. */
+  ListBase toc_entries;
+  /** Avoid re-checking the footer when there is no table of contents. */
+  bool toc_checked;
+
   /** Variables needed for reading from memory / stream. */
   const char *buffer;
   /** Variables needed for reading from memfile (undo). */
@@ -136,6 +144,16 @@ typedef struct FileData {
   struct ReportList *reports;
 } FileData;
 
+/** An entry of the optional table of contents, see #BLEND_TOC_MAGIC in BLO_blend_defs.h. */
+typedef struct BlendTocEntry {
+  struct BlendTocEntry *next, *prev;
+  /** Offset of the ID BHead from the start of the file, size includes all its DATA blocks. */
+  uint64_t offset;
+  uint64_t size;
+  /** Full ID name, including the two character code prefix (MAX_ID_NAME). */
+  char name[66];
+} BlendTocEntry;
+
 #define SIZEOFBLENDERHEADER 12
 
 /***/
@@ -146,6 +164,9 @@ void blo_split_main(ListBase *mainlist, struct Main *main);
 BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath);
 
 FileData *blo_filedata_from_file(const char *filepath, struct ReportList *reports);
+
+/** Read the optional table of contents, returns false when the file has none. */
+bool blo_filedata_toc_ensure(FileData *fd);
 FileData *blo_filedata_from_memory(const void *buffer, int buffersize, struct ReportList *reports);
 FileData *blo_filedata_from_memfile(struct MemFile *memfile,
                                     const struct BlendFileReadParams *params,
@@ -177,6 +198,15 @@ const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead);
 
 /* do versions stuff */
 
+/**
+ * A version patch applied to a single ID, used with #blo_do_versions_listbase_parallel.
+ * Must not access any state outside \a id (see the function for details).
+ */
+typedef void (*BLOVersionIDPatchFn)(struct ID *id, void *userdata);
+void blo_do_versions_listbase_parallel(struct ListBase *lb,
+                                       BLOVersionIDPatchFn patch_fn,
+                                       void *userdata);
+
 void blo_reportf_wrap(struct ReportList *reports, ReportType type, const char *format, ...)
     ATTR_PRINTF_FORMAT(3, 4);
 
@@ -42,6 +42,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_utildefines.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -215,14 +216,44 @@ struct Main *BLO_memfile_main_get(struct MemFile *memfile,
   return bmain_undo;
 }
 
+/**
+ * Copies the memfile contents into a single contiguous buffer, so the caller can write it to
+ * disk (or hand it to another thread) without keeping any reference to the undo stack.
+ *
+ * \return the buffer (to be freed with MEM_freeN), or NULL on allocation failure or empty
+ * memfile. \a r_buffer_size is set to the total size in bytes.
+ */
+void *BLO_memfile_flatten(const struct MemFile *memfile, size_t *r_buffer_size)
+{
+  MemFileChunk *chunk;
+
+  *r_buffer_size = memfile->size;
+  if (memfile->size == 0) {
+    return NULL;
+  }
+
+  char *buffer = MEM_mallocN(memfile->size, __func__);
+  if (buffer == NULL) {
+    return NULL;
+  }
+
+  size_t offset = 0;
+  for (chunk = memfile->chunks.first; chunk; chunk = chunk->next) {
+    BLI_assert(offset + chunk->size <= memfile->size);
+    memcpy(buffer + offset, chunk->buf, chunk->size);
+    offset += chunk->size;
+  }
+
+  return buffer;
+}
+
 /**
  * Saves .blend using undo buffer.
  *
  * \return success.
  */
-bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
+static int memfile_write_open(const char *filename)
 {
-  MemFileChunk *chunk;
   int file, oflags;
 
   /* note: This is currently used for autosave and 'quit.blend',
@@ -248,6 +279,17 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
             "Unable to save '%s': %s\n",
             filename,
             errno ? strerror(errno) : "Unknown error opening file");
+  }
+
+  return file;
+}
+
+bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
+{
+  MemFileChunk *chunk;
+  int file = memfile_write_open(filename);
+
+  if (file == -1) {
     return false;
   }
 
@@ -268,3 +310,42 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
   }
   return true;
 }
+
+/**
+ * Variant of #BLO_memfile_write_file for an already flattened buffer
+ * (see #BLO_memfile_flatten), safe to call from a worker thread.
+ */
+bool BLO_memfile_buffer_write_file(const void *buffer, size_t buffer_size, const char *filename)
+{
+  int file = memfile_write_open(filename);
+
+  if (file == -1) {
+    return false;
+  }
+
+  /* A single write() call has platform-dependent size limits, stay well below them. */
+  const size_t write_size_max = 1 << 28; /* 256MB. */
+  const char *buf = buffer;
+  size_t todo = buffer_size;
+  bool success = true;
+
+  while (todo != 0) {
+    const size_t write_size = MIN2(todo, write_size_max);
+    if ((size_t)write(file, buf, (uint)write_size) != write_size) {
+      success = false;
+      break;
+    }
+    buf += write_size;
+    todo -= write_size;
+  }
+
+  close(file);
+
+  if (!success) {
+    fprintf(stderr,
+            "Unable to save '%s': %s\n",
+            filename,
+            errno ? strerror(errno) : "Unknown error writing file");
+  }
+  return success;
+}
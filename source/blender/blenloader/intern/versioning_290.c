@@ -196,6 +196,59 @@ void do_versions_after_linking_290(Main *bmain, ReportList *UNUSED(reports))
   }
 }
 
+/* Per-ID patches run through #blo_do_versions_listbase_parallel,
+ * these must not touch state outside the ID they are handed. */
+
+static void version_screen_space_image_uv_opacity(ID *id, void *UNUSED(userdata))
+{
+  bScreen *screen = (bScreen *)id;
+  LISTBASE_FOREACH (ScrArea *, area, &screen->areabase) {
+    LISTBASE_FOREACH (SpaceLink *, sl, &area->spacedata) {
+      if (sl->spacetype == SPACE_IMAGE) {
+        SpaceImage *sima = (SpaceImage *)sl;
+        sima->uv_opacity = 1.0f;
+      }
+    }
+  }
+}
+
+static void version_brush_gpencil_random_curves(ID *id, void *UNUSED(userdata))
+{
+  Brush *brush = (Brush *)id;
+  if ((brush->gpencil_settings) && (brush->gpencil_settings->curve_rand_pressure == NULL)) {
+    brush->gpencil_settings->curve_rand_pressure = BKE_curvemapping_add(1, 0.0f, 0.0f, 1.0f, 1.0f);
+    brush->gpencil_settings->curve_rand_strength = BKE_curvemapping_add(1, 0.0f, 0.0f, 1.0f, 1.0f);
+    brush->gpencil_settings->curve_rand_uv = BKE_curvemapping_add(1, 0.0f, 0.0f, 1.0f, 1.0f);
+    brush->gpencil_settings->curve_rand_hue = BKE_curvemapping_add(1, 0.0f, 0.0f, 1.0f, 1.0f);
+    brush->gpencil_settings->curve_rand_saturation = BKE_curvemapping_add(
+        1, 0.0f, 0.0f, 1.0f, 1.0f);
+    brush->gpencil_settings->curve_rand_value = BKE_curvemapping_add(1, 0.0f, 0.0f, 1.0f, 1.0f);
+  }
+}
+
+static void version_object_weightvg_edit_flags(ID *id, void *UNUSED(userdata))
+{
+  Object *ob = (Object *)id;
+  LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+    if (md->type == eModifierType_WeightVGEdit) {
+      ((WeightVGEditModifierData *)md)->edit_flags &= ~MOD_WVG_EDIT_WEIGHTS_NORMALIZE;
+    }
+  }
+}
+
+static void version_object_modifier_ui_expand_flag(ID *id, void *UNUSED(userdata))
+{
+  Object *object = (Object *)id;
+  LISTBASE_FOREACH (ModifierData *, md, &object->modifiers) {
+    if (md->mode & eModifierMode_Expanded_DEPRECATED) {
+      md->ui_expand_flag = 1;
+    }
+    else {
+      md->ui_expand_flag = 0;
+    }
+  }
+}
+
 void blo_do_versions_290(FileData *fd, Library *UNUSED(lib), Main *bmain)
 {
   UNUSED_VARS(fd);
@@ -211,48 +264,20 @@ void blo_do_versions_290(FileData *fd, Library *UNUSED(lib), Main *bmain)
     }
 
     if (!DNA_struct_elem_find(fd->filesdna, "SpaceImage", "float", "uv_opacity")) {
-      for (bScreen *screen = bmain->screens.first; screen; screen = screen->id.next) {
-        LISTBASE_FOREACH (ScrArea *, area, &screen->areabase) {
-          LISTBASE_FOREACH (SpaceLink *, sl, &area->spacedata) {
-            if (sl->spacetype == SPACE_IMAGE) {
-              SpaceImage *sima = (SpaceImage *)sl;
-              sima->uv_opacity = 1.0f;
-            }
-          }
-        }
-      }
+      blo_do_versions_listbase_parallel(
+          &bmain->screens, version_screen_space_image_uv_opacity, NULL);
     }
 
     /* Init Grease Pencil new random curves. */
     if (!DNA_struct_elem_find(fd->filesdna, "BrushGpencilSettings", "float", "random_hue")) {
-      LISTBASE_FOREACH (Brush *, brush, &bmain->brushes) {
-        if ((brush->gpencil_settings) && (brush->gpencil_settings->curve_rand_pressure == NULL)) {
-          brush->gpencil_settings->curve_rand_pressure = BKE_curvemapping_add(
-              1, 0.0f, 0.0f, 1.0f, 1.0f);
-          brush->gpencil_settings->curve_rand_strength = BKE_curvemapping_add(
-              1, 0.0f, 0.0f, 1.0f, 1.0f);
-          brush->gpencil_settings->curve_rand_uv = BKE_curvemapping_add(1, 0.0f, 0.0f, 1.0f, 1.0f);
-          brush->gpencil_settings->curve_rand_hue = BKE_curvemapping_add(
-              1, 0.0f, 0.0f, 1.0f, 1.0f);
-          brush->gpencil_settings->curve_rand_saturation = BKE_curvemapping_add(
-              1, 0.0f, 0.0f, 1.0f, 1.0f);
-          brush->gpencil_settings->curve_rand_value = BKE_curvemapping_add(
-              1, 0.0f, 0.0f, 1.0f, 1.0f);
-        }
-      }
+      blo_do_versions_listbase_parallel(&bmain->brushes, version_brush_gpencil_random_curves, NULL);
     }
   }
 
   if (!MAIN_VERSION_ATLEAST(bmain, 290, 4)) {
     /* Clear old deprecated bit-flag from edit weights modifiers, we now use it for something else.
      */
-    LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
-      LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
-        if (md->type == eModifierType_WeightVGEdit) {
-          ((WeightVGEditModifierData *)md)->edit_flags &= ~MOD_WVG_EDIT_WEIGHTS_NORMALIZE;
-        }
-      }
-    }
+    blo_do_versions_listbase_parallel(&bmain->objects, version_object_weightvg_edit_flags, NULL);
   }
 
   /**
@@ -268,16 +293,8 @@ void blo_do_versions_290(FileData *fd, Library *UNUSED(lib), Main *bmain)
     /* Keep this block, even when empty. */
 
     if (!DNA_struct_elem_find(fd->filesdna, "ModifierData", "short", "ui_expand_flag")) {
-      for (Object *object = bmain->objects.first; object != NULL; object = object->id.next) {
-        LISTBASE_FOREACH (ModifierData *, md, &object->modifiers) {
-          if (md->mode & eModifierMode_Expanded_DEPRECATED) {
-            md->ui_expand_flag = 1;
-          }
-          else {
-            md->ui_expand_flag = 0;
-          }
-        }
-      }
+      blo_do_versions_listbase_parallel(
+          &bmain->objects, version_object_modifier_ui_expand_flag, NULL);
     }
   }
 }
@@ -149,6 +149,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 #include "MEM_guardedalloc.h"  // MEM_freeN
 
 #include "BKE_action.h"
@@ -196,8 +197,8 @@
 #define MYWRITE_BUFFER_SIZE (MEM_SIZE_OPTIMAL(1 << 17)) /* 128kb */
 #define MYWRITE_MAX_CHUNK (MEM_SIZE_OPTIMAL(1 << 15))   /* ~32kb */
 
-/** Use if we want to store how many bytes have been written to the file. */
-// #define USE_WRITE_DATA_LEN
+/** Store how many bytes have been written to the file (also used for TOC offsets). */
+#define USE_WRITE_DATA_LEN
 
 /* -------------------------------------------------------------------- */
 /** \name Internal Write Wrapper's (Abstracts Compression)
@@ -206,8 +207,12 @@
 typedef enum {
   WW_WRAP_NONE = 1,
   WW_WRAP_ZLIB,
+  /** Same on-disk format as #WW_WRAP_ZLIB, compressing blocks across all cores. */
+  WW_WRAP_ZLIB_PARALLEL,
 } eWriteWrapType;
 
+struct WWZlibParallelState;
+
 typedef struct WriteWrap WriteWrap;
 struct WriteWrap {
   /* callbacks */
@@ -222,6 +227,7 @@ struct WriteWrap {
   union {
     int file_handle;
     gzFile gz_handle;
+    struct WWZlibParallelState *zlib_parallel_handle;
   } _user_data;
 };
 
@@ -279,6 +285,166 @@ static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
+/* zlib, parallel block compression */
+
+/* Every block is compressed into an independent gzip member; gzip readers (including our own
+ * load paths) transparently concatenate members, so the result stays a regular `.blend` that
+ * any Blender can open. Compression of the blocks runs in a task pool over all cores, only the
+ * final file writes are serial. */
+
+#define FILE_HANDLE(ww) (ww)->_user_data.zlib_parallel_handle
+
+/** Uncompressed size per gzip member. Big enough to keep the deflate ratio close to the
+ * single-stream one, small enough to parallelize saves of moderately sized files. */
+#define ZLIB_PARALLEL_BLOCK_SIZE (1 << 22)
+/** Number of blocks buffered before compressing them as one parallel batch. */
+#define ZLIB_PARALLEL_MAX_PENDING 32
+
+typedef struct WWZlibParallelBlock {
+  char *data;
+  size_t data_len;
+  char *compressed;
+  size_t compressed_len;
+  bool failed;
+} WWZlibParallelBlock;
+
+typedef struct WWZlibParallelState {
+  int file;
+  /** Accumulation buffer for the block currently being filled. */
+  char *block;
+  size_t block_len;
+  /** Filled blocks waiting for the next batched parallel compression. */
+  WWZlibParallelBlock pending[ZLIB_PARALLEL_MAX_PENDING];
+  int pending_len;
+  bool error;
+} WWZlibParallelState;
+
+static void ww_zlib_parallel_compress_fn(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  WWZlibParallelBlock *block = taskdata;
+  z_stream strm = {NULL};
+
+  /* Same level as the "wb1" mode used by #ww_open_zlib, 16 selects the gzip container. */
+  if (deflateInit2(&strm, 1, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    block->failed = true;
+    return;
+  }
+
+  const size_t compressed_max = deflateBound(&strm, block->data_len);
+  block->compressed = MEM_mallocN(compressed_max, __func__);
+
+  strm.next_in = (Bytef *)block->data;
+  strm.avail_in = block->data_len;
+  strm.next_out = (Bytef *)block->compressed;
+  strm.avail_out = compressed_max;
+
+  if (deflate(&strm, Z_FINISH) != Z_STREAM_END) {
+    block->failed = true;
+  }
+  block->compressed_len = compressed_max - strm.avail_out;
+
+  deflateEnd(&strm);
+}
+
+static void ww_zlib_parallel_flush(WWZlibParallelState *state)
+{
+  if (state->pending_len == 0) {
+    return;
+  }
+
+  TaskPool *task_pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+  for (int i = 0; i < state->pending_len; i++) {
+    BLI_task_pool_push(task_pool, ww_zlib_parallel_compress_fn, &state->pending[i], false, NULL);
+  }
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+
+  /* Write the compressed members in their original order. */
+  for (int i = 0; i < state->pending_len; i++) {
+    WWZlibParallelBlock *block = &state->pending[i];
+    if (block->failed ||
+        (size_t)write(state->file, block->compressed, block->compressed_len) !=
+            block->compressed_len) {
+      state->error = true;
+    }
+    MEM_freeN(block->data);
+    if (block->compressed != NULL) {
+      MEM_freeN(block->compressed);
+    }
+  }
+  state->pending_len = 0;
+}
+
+static void ww_zlib_parallel_block_push(WWZlibParallelState *state)
+{
+  WWZlibParallelBlock *block = &state->pending[state->pending_len++];
+  memset(block, 0, sizeof(*block));
+  block->data = state->block;
+  block->data_len = state->block_len;
+
+  state->block = NULL;
+  state->block_len = 0;
+
+  if (state->pending_len == ZLIB_PARALLEL_MAX_PENDING) {
+    ww_zlib_parallel_flush(state);
+  }
+}
+
+static bool ww_open_zlib_parallel(WriteWrap *ww, const char *filepath)
+{
+  const int file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
+
+  if (file == -1) {
+    return false;
+  }
+
+  WWZlibParallelState *state = MEM_callocN(sizeof(*state), __func__);
+  state->file = file;
+  FILE_HANDLE(ww) = state;
+  return true;
+}
+static bool ww_close_zlib_parallel(WriteWrap *ww)
+{
+  WWZlibParallelState *state = FILE_HANDLE(ww);
+
+  /* The last (partial) block, plus anything still pending. */
+  if (state->block != NULL) {
+    ww_zlib_parallel_block_push(state);
+  }
+  ww_zlib_parallel_flush(state);
+
+  bool success = (close(state->file) != -1) && !state->error;
+  MEM_freeN(state);
+  return success;
+}
+static size_t ww_write_zlib_parallel(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  WWZlibParallelState *state = FILE_HANDLE(ww);
+  size_t remaining = buf_len;
+
+  while (remaining != 0) {
+    if (state->block == NULL) {
+      state->block = MEM_mallocN(ZLIB_PARALLEL_BLOCK_SIZE, __func__);
+      state->block_len = 0;
+    }
+    const size_t copy_len = MIN2(remaining, ZLIB_PARALLEL_BLOCK_SIZE - state->block_len);
+    memcpy(state->block + state->block_len, buf, copy_len);
+    state->block_len += copy_len;
+    buf += copy_len;
+    remaining -= copy_len;
+
+    if (state->block_len == ZLIB_PARALLEL_BLOCK_SIZE) {
+      ww_zlib_parallel_block_push(state);
+    }
+  }
+
+  return state->error ? 0 : buf_len;
+}
+
+#undef ZLIB_PARALLEL_MAX_PENDING
+#undef ZLIB_PARALLEL_BLOCK_SIZE
+#undef FILE_HANDLE
+
 /* --- end compression types --- */
 
 static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
@@ -293,6 +459,13 @@ static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
       r_ww->use_buf = false;
       break;
     }
+    case WW_WRAP_ZLIB_PARALLEL: {
+      r_ww->open = ww_open_zlib_parallel;
+      r_ww->close = ww_close_zlib_parallel;
+      r_ww->write = ww_write_zlib_parallel;
+      r_ww->use_buf = false;
+      break;
+    }
     default: {
       r_ww->open = ww_open_none;
       r_ww->close = ww_close_none;
@@ -322,6 +495,11 @@ typedef struct {
   size_t write_len;
 #endif
 
+  /** When set, record a table of contents entry per ID, appended after ENDB on file save. */
+  bool use_toc;
+  /** #BlendTocEntryWrite list, in file order. */
+  ListBase toc_entries;
+
   /** Set on unlikely case of an error (ignores further file writing).  */
   bool error;
 
@@ -342,6 +520,14 @@ typedef struct BlendWriter {
   WriteData *wd;
 } BlendWriter;
 
+/** Writer side of an entry in the optional table of contents, see #write_file_toc. */
+typedef struct BlendTocEntryWrite {
+  struct BlendTocEntryWrite *next, *prev;
+  uint64_t offset;
+  uint64_t size;
+  char name[MAX_ID_NAME];
+} BlendTocEntryWrite;
+
 static WriteData *writedata_new(WriteWrap *ww)
 {
   WriteData *wd = MEM_callocN(sizeof(*wd), "writedata");
@@ -383,6 +569,7 @@ static void writedata_free(WriteData *wd)
   if (wd->buf) {
     MEM_freeN(wd->buf);
   }
+  BLI_freelistN(&wd->toc_entries);
   MEM_freeN(wd);
 }
 
@@ -507,6 +694,13 @@ static bool mywrite_end(WriteData *wd)
  */
 static void mywrite_id_begin(WriteData *wd, ID *id)
 {
+  if (wd->use_toc) {
+    BlendTocEntryWrite *entry = MEM_callocN(sizeof(*entry), "BlendTocEntryWrite");
+    entry->offset = wd->write_len;
+    BLI_strncpy(entry->name, id->name, sizeof(entry->name));
+    BLI_addtail(&wd->toc_entries, entry);
+  }
+
   if (wd->use_memfile) {
     wd->mem.current_id_session_uuid = id->session_uuid;
 
@@ -534,6 +728,11 @@ static void mywrite_id_begin(WriteData *wd, ID *id)
  */
 static void mywrite_id_end(WriteData *wd, ID *UNUSED(id))
 {
+  if (wd->use_toc) {
+    BlendTocEntryWrite *entry = wd->toc_entries.last;
+    entry->size = wd->write_len - entry->offset;
+  }
+
   if (wd->use_memfile) {
     /* Very important to do it after every ID write now, otherwise we cannot know whether a
      * specific ID changed or not. */
@@ -4107,6 +4306,10 @@ static bool write_file_handle(Main *mainvar,
   wd = mywrite_begin(ww, compare, current);
   BlendWriter writer = {wd};
 
+  /* Table of contents only for regular uncompressed file saves: offsets are meaningless inside
+   * a compression stream, and undo steps have their own lookup structures. */
+  wd->use_toc = (ww != NULL) && ((write_flags & G_FILE_COMPRESS) == 0);
+
   sprintf(buf,
           "BLENDER%c%c%.3d",
           (sizeof(void *) == 8) ? '-' : '_',
@@ -4363,11 +4566,42 @@ static bool write_file_handle(Main *mainvar,
   bhead.code = ENDB;
   mywrite(wd, &bhead, sizeof(BHead));
 
+  if (wd->use_toc) {
+    write_file_toc(wd);
+  }
+
   blo_join_main(&mainlist);
 
   return mywrite_end(wd);
 }
 
+/**
+ * Append the table of contents after the ENDB block, so ID listing and partial extraction
+ * (asset browsing, linking) can seek directly instead of scanning every BHead.
+ * Layout documented at #BLEND_TOC_MAGIC.
+ */
+static void write_file_toc(WriteData *wd)
+{
+  const size_t entries_start = wd->write_len;
+  uint32_t entries_count = 0;
+
+  LISTBASE_FOREACH (BlendTocEntryWrite *, entry, &wd->toc_entries) {
+    const uint32_t name_len = (uint32_t)strlen(entry->name);
+    mywrite(wd, &name_len, sizeof(name_len));
+    mywrite(wd, entry->name, (int)name_len);
+    mywrite(wd, &entry->offset, sizeof(entry->offset));
+    mywrite(wd, &entry->size, sizeof(entry->size));
+    entries_count++;
+  }
+
+  const uint64_t entries_size = wd->write_len - entries_start;
+  const uint32_t version = BLEND_TOC_VERSION;
+  mywrite(wd, &entries_size, sizeof(entries_size));
+  mywrite(wd, &entries_count, sizeof(entries_count));
+  mywrite(wd, &version, sizeof(version));
+  mywrite(wd, BLEND_TOC_MAGIC, BLEND_TOC_MAGIC_SIZE);
+}
+
 /* do reverse file history: .blend1 -> .blend2, .blend -> .blend1 */
 /* return: success(0), failure(1) */
 static bool do_history(const char *name, ReportList *reports)
@@ -4443,7 +4677,7 @@ bool BLO_write_file(Main *mainvar,
   BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
 
   if (write_flags & G_FILE_COMPRESS) {
-    ww_type = WW_WRAP_ZLIB;
+    ww_type = WW_WRAP_ZLIB_PARALLEL;
   }
   else {
     ww_type = WW_WRAP_NONE;
@@ -552,6 +552,132 @@ void BM_verts_calc_normal_vcos(BMesh *bm,
   MEM_freeN(edgevec);
 }
 
+/**
+ * \brief BMesh Partial Normal Update
+ *
+ * Helpers to recompute only the normals affected by a set of moved vertices
+ * (their incident faces and every vertex of those faces), for modal tools
+ * that move a small part of a dense mesh each step.
+ */
+
+BLI_INLINE void bm_partial_elem_ensure_space(void ***elems, int elems_len, int *elems_len_alloc)
+{
+  if (elems_len == *elems_len_alloc) {
+    *elems_len_alloc = MAX2(*elems_len_alloc * 2, 64);
+    *elems = MEM_reallocN(*elems, sizeof(**elems) * (size_t)*elems_len_alloc);
+  }
+}
+
+/**
+ * Create the affected face & vertex sets from the vertices tagged in \a verts_mask.
+ *
+ * \param verts_mask: Bitmap over the vertex indices, true for vertices that moved.
+ * \param verts_mask_count: Number of vertices tagged in \a verts_mask (used to reserve space).
+ */
+BMPartialUpdate *BM_mesh_partial_create_from_verts(BMesh *bm,
+                                                   const uint *verts_mask,
+                                                   const int verts_mask_count)
+{
+  BMPartialUpdate *bmpinfo = MEM_callocN(sizeof(*bmpinfo), __func__);
+
+  int verts_len_alloc = MAX2(verts_mask_count, 64);
+  int faces_len_alloc = MAX2(verts_mask_count, 64);
+  bmpinfo->verts = MEM_mallocN(sizeof(*bmpinfo->verts) * (size_t)verts_len_alloc, __func__);
+  bmpinfo->faces = MEM_mallocN(sizeof(*bmpinfo->faces) * (size_t)faces_len_alloc, __func__);
+
+  BLI_bitmap *verts_used = BLI_BITMAP_NEW((size_t)bm->totvert, __func__);
+  BLI_bitmap *faces_used = BLI_BITMAP_NEW((size_t)bm->totface, __func__);
+
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_FACE);
+  BM_mesh_elem_table_ensure(bm, BM_VERT);
+
+  for (int i = 0; i < bm->totvert; i++) {
+    if (!BLI_BITMAP_TEST(verts_mask, i)) {
+      continue;
+    }
+    BMVert *v = bm->vtable[i];
+    BMIter fiter;
+    BMFace *f;
+
+    /* The vertex itself (also covers loose vertices). */
+    if (!BLI_BITMAP_TEST(verts_used, i)) {
+      BLI_BITMAP_ENABLE(verts_used, i);
+      bm_partial_elem_ensure_space(
+          (void ***)&bmpinfo->verts, bmpinfo->verts_len, &verts_len_alloc);
+      bmpinfo->verts[bmpinfo->verts_len++] = v;
+    }
+
+    BM_ITER_ELEM (f, &fiter, v, BM_FACES_OF_VERT) {
+      const int f_index = BM_elem_index_get(f);
+      if (BLI_BITMAP_TEST(faces_used, f_index)) {
+        continue;
+      }
+      BLI_BITMAP_ENABLE(faces_used, f_index);
+      bm_partial_elem_ensure_space((void ***)&bmpinfo->faces, bmpinfo->faces_len, &faces_len_alloc);
+      bmpinfo->faces[bmpinfo->faces_len++] = f;
+
+      /* Normals of all the faces vertices depend on this faces normal. */
+      BMLoop *l_iter, *l_first;
+      l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+      do {
+        const int v_index = BM_elem_index_get(l_iter->v);
+        if (!BLI_BITMAP_TEST(verts_used, v_index)) {
+          BLI_BITMAP_ENABLE(verts_used, v_index);
+          bm_partial_elem_ensure_space(
+              (void ***)&bmpinfo->verts, bmpinfo->verts_len, &verts_len_alloc);
+          bmpinfo->verts[bmpinfo->verts_len++] = l_iter->v;
+        }
+      } while ((l_iter = l_iter->next) != l_first);
+    }
+  }
+
+  MEM_freeN(verts_used);
+  MEM_freeN(faces_used);
+
+  return bmpinfo;
+}
+
+void BM_mesh_partial_destroy(BMPartialUpdate *bmpinfo)
+{
+  MEM_freeN(bmpinfo->verts);
+  MEM_freeN(bmpinfo->faces);
+  MEM_freeN(bmpinfo);
+}
+
+static void bm_partial_faces_normal_update_fn(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMFace **faces = userdata;
+  BM_face_normal_update(faces[i]);
+}
+
+static void bm_partial_verts_normal_update_fn(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BMVert **verts = userdata;
+  BM_vert_normal_update(verts[i]);
+}
+
+/**
+ * Partial counterpart of #BM_mesh_normals_update,
+ * only recomputes the normals of the faces & vertices in \a bmpinfo.
+ */
+void BM_mesh_normals_update_with_partial(const BMPartialUpdate *bmpinfo)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  settings.use_threading = (bmpinfo->faces_len >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(
+      0, bmpinfo->faces_len, bmpinfo->faces, bm_partial_faces_normal_update_fn, &settings);
+
+  settings.use_threading = (bmpinfo->verts_len >= BM_OMP_LIMIT);
+  BLI_task_parallel_range(
+      0, bmpinfo->verts_len, bmpinfo->verts, bm_partial_verts_normal_update_fn, &settings);
+}
+
 /**
  * Helpers for #BM_mesh_loop_normals_update and #BM_loops_calc_normal_vcos
  */
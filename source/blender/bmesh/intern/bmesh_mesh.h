@@ -42,6 +42,21 @@ void BM_mesh_data_free(BMesh *bm);
 void BM_mesh_clear(BMesh *bm);
 
 void BM_mesh_normals_update(BMesh *bm);
+
+/** Affected element sets for partial normal updates, see #BM_mesh_partial_create_from_verts. */
+typedef struct BMPartialUpdate {
+  BMVert **verts;
+  BMFace **faces;
+  int verts_len;
+  int faces_len;
+} BMPartialUpdate;
+
+BMPartialUpdate *BM_mesh_partial_create_from_verts(BMesh *bm,
+                                                   const uint *verts_mask,
+                                                   const int verts_mask_count);
+void BM_mesh_partial_destroy(BMPartialUpdate *bmpinfo);
+void BM_mesh_normals_update_with_partial(const BMPartialUpdate *bmpinfo);
+
 void BM_verts_calc_normal_vcos(BMesh *bm,
                                const float (*fnos)[3],
                                const float (*vcos)[3],
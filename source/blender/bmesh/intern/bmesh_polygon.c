@@ -35,6 +35,7 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
+#include "BLI_task.h"
 
 #include "bmesh.h"
 #include "bmesh_tools.h"
@@ -1534,145 +1535,188 @@ void BM_face_as_array_loop_quad(BMFace *f, BMLoop *r_loops[4])
  *
  * \note \a looptris Must be pre-allocated to at least the size of given by: poly_to_tri_count
  */
-void BM_mesh_calc_tessellation(BMesh *bm, BMLoop *(*looptris)[3], int *r_looptris_tot)
+/**
+ * \brief Tessellate a single face, writing into \a looptris.
+ *
+ * \return The number of triangles written (`efa->len - 2`).
+ */
+BLI_INLINE int bm_mesh_calc_tessellation_for_face(BMLoop *(*looptris)[3],
+                                                  BMFace *efa,
+                                                  MemArena **pf_arena_p)
 {
-  /* use this to avoid locking pthread for _every_ polygon
-   * and calling the fill function */
-#define USE_TESSFACE_SPEEDUP
-
-  /* this assumes all faces can be scan-filled, which isn't always true,
-   * worst case we over alloc a little which is acceptable */
-#ifndef NDEBUG
-  const int looptris_tot = poly_to_tri_count(bm->totface, bm->totloop);
-#endif
-
-  BMIter iter;
-  BMFace *efa;
-  int i = 0;
+  /* don't consider two-edged faces */
+  if (UNLIKELY(efa->len < 3)) {
+    return 0;
+  }
 
-  MemArena *arena = NULL;
+  if (efa->len == 3) {
+    /* no need to ensure the loop order, we know its ok */
+    BMLoop *l;
+    BMLoop **l_ptr = looptris[0];
+    l_ptr[0] = l = BM_FACE_FIRST_LOOP(efa);
+    l_ptr[1] = l = l->next;
+    l_ptr[2] = l->next;
+    return 1;
+  }
 
-  BM_ITER_MESH (efa, &iter, bm, BM_FACES_OF_MESH) {
-    /* don't consider two-edged faces */
-    if (UNLIKELY(efa->len < 3)) {
-      /* do nothing */
+  if (efa->len == 4) {
+    BMLoop *l;
+    BMLoop **l_ptr_a = looptris[0];
+    BMLoop **l_ptr_b = looptris[1];
+    (l_ptr_a[0] = l_ptr_b[0] = l = BM_FACE_FIRST_LOOP(efa));
+    (l_ptr_a[1] = l = l->next);
+    (l_ptr_a[2] = l_ptr_b[1] = l = l->next);
+    (l_ptr_b[2] = l->next);
+
+    if (UNLIKELY(is_quad_flip_v3_first_third_fast(
+            l_ptr_a[0]->v->co, l_ptr_a[1]->v->co, l_ptr_a[2]->v->co, l_ptr_b[2]->v->co))) {
+      /* flip out of degenerate 0-2 state. */
+      l_ptr_a[2] = l_ptr_b[2];
+      l_ptr_b[0] = l_ptr_a[1];
     }
+    return 2;
+  }
 
-#ifdef USE_TESSFACE_SPEEDUP
+  int j;
 
-    /* no need to ensure the loop order, we know its ok */
+  BMLoop *l_iter;
+  BMLoop *l_first;
+  BMLoop **l_arr;
 
-    else if (efa->len == 3) {
-#  if 0
-      int j;
-      BM_ITER_ELEM_INDEX(l, &liter, efa, BM_LOOPS_OF_FACE, j) {
-        looptris[i][j] = l;
-      }
-      i += 1;
-#  else
-      /* more cryptic but faster */
-      BMLoop *l;
-      BMLoop **l_ptr = looptris[i++];
-      l_ptr[0] = l = BM_FACE_FIRST_LOOP(efa);
-      l_ptr[1] = l = l->next;
-      l_ptr[2] = l->next;
-#  endif
-    }
-    else if (efa->len == 4) {
-#  if 0
-      BMLoop *ltmp[4];
-      int j;
-      BLI_array_grow_items(looptris, 2);
-      BM_ITER_ELEM_INDEX(l, &liter, efa, BM_LOOPS_OF_FACE, j) {
-        ltmp[j] = l;
-      }
+  float axis_mat[3][3];
+  float(*projverts)[2];
+  uint(*tris)[3];
 
-      looptris[i][0] = ltmp[0];
-      looptris[i][1] = ltmp[1];
-      looptris[i][2] = ltmp[2];
-      i += 1;
-
-      looptris[i][0] = ltmp[0];
-      looptris[i][1] = ltmp[2];
-      looptris[i][2] = ltmp[3];
-      i += 1;
-#  else
-      /* more cryptic but faster */
-      BMLoop *l;
-      BMLoop **l_ptr_a = looptris[i++];
-      BMLoop **l_ptr_b = looptris[i++];
-      (l_ptr_a[0] = l_ptr_b[0] = l = BM_FACE_FIRST_LOOP(efa));
-      (l_ptr_a[1] = l = l->next);
-      (l_ptr_a[2] = l_ptr_b[1] = l = l->next);
-      (l_ptr_b[2] = l->next);
-#  endif
-
-      if (UNLIKELY(is_quad_flip_v3_first_third_fast(
-              l_ptr_a[0]->v->co, l_ptr_a[1]->v->co, l_ptr_a[2]->v->co, l_ptr_b[2]->v->co))) {
-        /* flip out of degenerate 0-2 state. */
-        l_ptr_a[2] = l_ptr_b[2];
-        l_ptr_b[0] = l_ptr_a[1];
-      }
-    }
+  const int totfilltri = efa->len - 2;
 
-#endif /* USE_TESSFACE_SPEEDUP */
+  MemArena *pf_arena = *pf_arena_p;
+  if (UNLIKELY(pf_arena == NULL)) {
+    pf_arena = *pf_arena_p = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+  }
 
-    else {
-      int j;
+  tris = BLI_memarena_alloc(pf_arena, sizeof(*tris) * totfilltri);
+  l_arr = BLI_memarena_alloc(pf_arena, sizeof(*l_arr) * efa->len);
+  projverts = BLI_memarena_alloc(pf_arena, sizeof(*projverts) * efa->len);
 
-      BMLoop *l_iter;
-      BMLoop *l_first;
-      BMLoop **l_arr;
+  axis_dominant_v3_to_m3_negate(axis_mat, efa->no);
 
-      float axis_mat[3][3];
-      float(*projverts)[2];
-      uint(*tris)[3];
+  j = 0;
+  l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
+  do {
+    l_arr[j] = l_iter;
+    mul_v2_m3v3(projverts[j], axis_mat, l_iter->v->co);
+    j++;
+  } while ((l_iter = l_iter->next) != l_first);
 
-      const int totfilltri = efa->len - 2;
+  BLI_polyfill_calc_arena(projverts, efa->len, 1, tris, pf_arena);
 
-      if (UNLIKELY(arena == NULL)) {
-        arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
-      }
+  for (j = 0; j < totfilltri; j++) {
+    BMLoop **l_ptr = looptris[j];
+    uint *tri = tris[j];
 
-      tris = BLI_memarena_alloc(arena, sizeof(*tris) * totfilltri);
-      l_arr = BLI_memarena_alloc(arena, sizeof(*l_arr) * efa->len);
-      projverts = BLI_memarena_alloc(arena, sizeof(*projverts) * efa->len);
+    l_ptr[0] = l_arr[tri[0]];
+    l_ptr[1] = l_arr[tri[1]];
+    l_ptr[2] = l_arr[tri[2]];
+  }
 
-      axis_dominant_v3_to_m3_negate(axis_mat, efa->no);
+  BLI_memarena_clear(pf_arena);
 
-      j = 0;
-      l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
-      do {
-        l_arr[j] = l_iter;
-        mul_v2_m3v3(projverts[j], axis_mat, l_iter->v->co);
-        j++;
-      } while ((l_iter = l_iter->next) != l_first);
+  return totfilltri;
+}
 
-      BLI_polyfill_calc_arena(projverts, efa->len, 1, tris, arena);
+static void bm_mesh_calc_tessellation__single_threaded(BMesh *bm,
+                                                       BMLoop *(*looptris)[3],
+                                                       int *r_looptris_tot)
+{
+  /* this assumes all faces can be scan-filled, which isn't always true,
+   * worst case we over alloc a little which is acceptable */
+#ifndef NDEBUG
+  const int looptris_tot = poly_to_tri_count(bm->totface, bm->totloop);
+#endif
 
-      for (j = 0; j < totfilltri; j++) {
-        BMLoop **l_ptr = looptris[i++];
-        uint *tri = tris[j];
+  BMIter iter;
+  BMFace *efa;
+  int i = 0;
 
-        l_ptr[0] = l_arr[tri[0]];
-        l_ptr[1] = l_arr[tri[1]];
-        l_ptr[2] = l_arr[tri[2]];
-      }
+  MemArena *pf_arena = NULL;
 
-      BLI_memarena_clear(arena);
-    }
+  BM_ITER_MESH (efa, &iter, bm, BM_FACES_OF_MESH) {
+    i += bm_mesh_calc_tessellation_for_face(looptris + i, efa, &pf_arena);
   }
 
-  if (arena) {
-    BLI_memarena_free(arena);
-    arena = NULL;
+  if (pf_arena) {
+    BLI_memarena_free(pf_arena);
+    pf_arena = NULL;
   }
 
   *r_looptris_tot = i;
 
   BLI_assert(i <= looptris_tot);
+}
+
+typedef struct TessellationUserTLS {
+  MemArena *pf_arena;
+} TessellationUserTLS;
+
+typedef struct TessellationUserData {
+  BMFace **ftable;
+  BMLoop *(*looptris)[3];
+} TessellationUserData;
+
+static void bm_mesh_calc_tessellation_for_face_fn(void *__restrict userdata,
+                                                  const int index,
+                                                  const TaskParallelTLS *__restrict tls)
+{
+  TessellationUserData *data = userdata;
+  TessellationUserTLS *tls_data = tls->userdata_chunk;
+  BMFace *efa = data->ftable[index];
+  BMLoop *l = BM_FACE_FIRST_LOOP(efa);
+  const int offset = poly_to_tri_count(index, BM_elem_index_get(l));
+  bm_mesh_calc_tessellation_for_face(data->looptris + offset, efa, &tls_data->pf_arena);
+}
+
+static void bm_mesh_calc_tessellation_free_fn(const void *__restrict UNUSED(userdata),
+                                              void *__restrict tls_v)
+{
+  TessellationUserTLS *tls_data = tls_v;
+  if (tls_data->pf_arena) {
+    BLI_memarena_free(tls_data->pf_arena);
+  }
+}
 
-#undef USE_TESSFACE_SPEEDUP
+static void bm_mesh_calc_tessellation__multi_threaded(BMesh *bm,
+                                                      BMLoop *(*looptris)[3],
+                                                      int *r_looptris_tot)
+{
+  /* Tessellation offsets can be computed from the face & loop indices,
+   * since an n-gon always tessellates into `n - 2` triangles. */
+  BM_mesh_elem_index_ensure(bm, BM_LOOP | BM_FACE);
+  BM_mesh_elem_table_ensure(bm, BM_FACE);
+
+  TessellationUserTLS tls_data_dummy = {NULL};
+  TessellationUserData data = {
+      .ftable = bm->ftable,
+      .looptris = looptris,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &tls_data_dummy;
+  settings.userdata_chunk_size = sizeof(tls_data_dummy);
+  settings.func_free = bm_mesh_calc_tessellation_free_fn;
+  BLI_task_parallel_range(0, bm->totface, &data, bm_mesh_calc_tessellation_for_face_fn, &settings);
+
+  *r_looptris_tot = poly_to_tri_count(bm->totface, bm->totloop);
+}
+
+void BM_mesh_calc_tessellation(BMesh *bm, BMLoop *(*looptris)[3], int *r_looptris_tot)
+{
+  if (bm->totface < 1024) {
+    bm_mesh_calc_tessellation__single_threaded(bm, looptris, r_looptris_tot);
+  }
+  else {
+    bm_mesh_calc_tessellation__multi_threaded(bm, looptris, r_looptris_tot);
+  }
 }
 
 /**
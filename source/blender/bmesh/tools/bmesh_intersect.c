@@ -46,6 +46,7 @@
 
 #include "BLI_buffer.h"
 #include "BLI_kdopbvh.h"
+#include "BLI_task.h"
 
 #include "bmesh.h"
 #include "intern/bmesh_private.h"
@@ -844,6 +845,66 @@ finally:
 
 #ifdef USE_BVH
 
+/* -------------------------------------------------------------------- */
+/* Parallel pre-filter over the BVH overlap pairs.
+ *
+ * #bm_isect_tri_tri creates vertices and sets element API flags, so it has to run
+ * serially. Every path in it that modifies the mesh however requires the two triangles
+ * to come within #ISectEpsilon.eps_margin of each other (vert-vert/vert-edge/vert-tri
+ * accept within `eps2x`, the edge-edge case in #intersect_line_tri within `eps_margin`).
+ * Signed distance to a triangle's plane is affine over the triangle, so when all three
+ * vertices of one triangle lie on the same side of the other triangle's plane by more
+ * than that margin, the pair is a guaranteed no-op and the serial pass can skip it.
+ * AABB's padded by `eps_margin` overlap far more often than the triangles themselves
+ * on dense meshes, which makes this filter reject the bulk of the pairs. */
+
+struct ISectPrefilterData {
+  BMLoop *(*looptris)[3];
+  const BVHTreeOverlap *overlap;
+  const struct ISectEpsilon *epsilon;
+  char *pair_skip;
+};
+
+static bool isect_tri_sep_plane_test(const float *a_cos[3],
+                                     const float *b_cos[3],
+                                     const float margin)
+{
+  float b_nor[3];
+  if (normal_tri_v3(b_nor, UNPACK3(b_cos)) < FLT_EPSILON) {
+    /* Degenerate triangle, don't reject. */
+    return false;
+  }
+
+  float d[3];
+  for (int i = 0; i < 3; i++) {
+    d[i] = dot_v3v3(b_nor, a_cos[i]) - dot_v3v3(b_nor, b_cos[0]);
+  }
+
+  return ((d[0] > margin) && (d[1] > margin) && (d[2] > margin)) ||
+         ((d[0] < -margin) && (d[1] < -margin) && (d[2] < -margin));
+}
+
+static void isect_pair_prefilter_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct ISectPrefilterData *data = userdata;
+  BMLoop **a = data->looptris[data->overlap[i].indexA];
+  BMLoop **b = data->looptris[data->overlap[i].indexB];
+
+  const float *a_cos[3] = {a[0]->v->co, a[1]->v->co, a[2]->v->co};
+  const float *b_cos[3] = {b[0]->v->co, b[1]->v->co, b[2]->v->co};
+
+  /* Double the margin so float noise on a borderline pair can never reject
+   * what the exact tests would have accepted. */
+  const float margin = data->epsilon->eps_margin * 2.0f;
+
+  if (isect_tri_sep_plane_test(a_cos, b_cos, margin) ||
+      isect_tri_sep_plane_test(b_cos, a_cos, margin)) {
+    data->pair_skip[i] = true;
+  }
+}
+
 struct RaycastData {
   const float **looptris;
   BLI_Buffer *z_buffer;
@@ -1108,7 +1169,28 @@ bool BM_mesh_intersect(BMesh *bm,
   if (overlap) {
     uint i;
 
+    /* Reject pairs whose triangles are provably too far apart to interact,
+     * in parallel, so the serial intersection pass below only visits pairs
+     * which can actually modify the mesh. */
+    char *pair_skip = MEM_callocN(sizeof(*pair_skip) * tree_overlap_tot, __func__);
+    {
+      struct ISectPrefilterData prefilter_data = {
+          .looptris = looptris,
+          .overlap = overlap,
+          .epsilon = &s.epsilon,
+          .pair_skip = pair_skip,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (tree_overlap_tot > 1024);
+      BLI_task_parallel_range(
+          0, (int)tree_overlap_tot, &prefilter_data, isect_pair_prefilter_cb, &settings);
+    }
+
     for (i = 0; i < tree_overlap_tot; i++) {
+      if (pair_skip[i]) {
+        continue;
+      }
 #  ifdef USE_DUMP
       printf("  ((%d, %d), (\n", overlap[i].indexA, overlap[i].indexB);
 #  endif
@@ -1122,6 +1204,7 @@ bool BM_mesh_intersect(BMesh *bm,
       printf(")),\n");
 #  endif
     }
+    MEM_freeN(pair_skip);
     MEM_freeN(overlap);
   }
 
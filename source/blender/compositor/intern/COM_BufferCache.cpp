@@ -0,0 +1,129 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include "COM_BufferCache.h"
+
+#include <cstring>
+#include <map>
+
+#include "BLI_threads.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "COM_MemoryBuffer.h"
+
+/** \brief total size the cached buffers are allowed to occupy before eviction starts. */
+static const size_t COM_BUFFER_CACHE_LIMIT_BYTES = 512 * 1024 * 1024;
+
+struct CachedBuffer {
+  float *data;
+  size_t size_in_bytes;
+  int width;
+  int height;
+  unsigned int num_channels;
+  /** \brief tick of the last restore or store, used for least recently used eviction. */
+  uint64_t last_use;
+};
+
+static ThreadMutex s_bufferCacheMutex = BLI_MUTEX_INITIALIZER;
+static std::map<uint64_t, CachedBuffer> s_cachedBuffers;
+static size_t s_cachedBytes = 0;
+static uint64_t s_cacheTicks = 0;
+
+/** \brief evict least recently used buffers until the cache fits the size limit again. */
+static void buffer_cache_enforce_limit()
+{
+  while (s_cachedBytes > COM_BUFFER_CACHE_LIMIT_BYTES && !s_cachedBuffers.empty()) {
+    std::map<uint64_t, CachedBuffer>::iterator oldest = s_cachedBuffers.begin();
+    std::map<uint64_t, CachedBuffer>::iterator it = s_cachedBuffers.begin();
+    for (it++; it != s_cachedBuffers.end(); it++) {
+      if (it->second.last_use < oldest->second.last_use) {
+        oldest = it;
+      }
+    }
+    s_cachedBytes -= oldest->second.size_in_bytes;
+    MEM_freeN(oldest->second.data);
+    s_cachedBuffers.erase(oldest);
+  }
+}
+
+bool BufferCache::restore(uint64_t hash, MemoryBuffer *buffer)
+{
+  BLI_mutex_lock(&s_bufferCacheMutex);
+  std::map<uint64_t, CachedBuffer>::iterator it = s_cachedBuffers.find(hash);
+  if (it == s_cachedBuffers.end()) {
+    BLI_mutex_unlock(&s_bufferCacheMutex);
+    return false;
+  }
+
+  CachedBuffer &cached = it->second;
+  if (cached.width != buffer->getWidth() || cached.height != buffer->getHeight() ||
+      cached.num_channels != buffer->get_num_channels()) {
+    BLI_mutex_unlock(&s_bufferCacheMutex);
+    return false;
+  }
+
+  memcpy(buffer->getBuffer(), cached.data, cached.size_in_bytes);
+  cached.last_use = ++s_cacheTicks;
+  BLI_mutex_unlock(&s_bufferCacheMutex);
+  return true;
+}
+
+void BufferCache::store(uint64_t hash, MemoryBuffer *buffer)
+{
+  const size_t size_in_bytes = sizeof(float) * buffer->getWidth() * buffer->getHeight() *
+                               buffer->get_num_channels();
+  if (size_in_bytes > COM_BUFFER_CACHE_LIMIT_BYTES) {
+    return;
+  }
+
+  BLI_mutex_lock(&s_bufferCacheMutex);
+  std::map<uint64_t, CachedBuffer>::iterator it = s_cachedBuffers.find(hash);
+  if (it != s_cachedBuffers.end()) {
+    /* Already cached, content addressing guarantees the data is the same. */
+    it->second.last_use = ++s_cacheTicks;
+    BLI_mutex_unlock(&s_bufferCacheMutex);
+    return;
+  }
+
+  CachedBuffer cached;
+  cached.data = (float *)MEM_mallocN_aligned(size_in_bytes, 16, "COM_BufferCache");
+  cached.size_in_bytes = size_in_bytes;
+  cached.width = buffer->getWidth();
+  cached.height = buffer->getHeight();
+  cached.num_channels = buffer->get_num_channels();
+  cached.last_use = ++s_cacheTicks;
+  memcpy(cached.data, buffer->getBuffer(), size_in_bytes);
+
+  s_cachedBuffers[hash] = cached;
+  s_cachedBytes += size_in_bytes;
+  buffer_cache_enforce_limit();
+  BLI_mutex_unlock(&s_bufferCacheMutex);
+}
+
+void BufferCache::purge()
+{
+  BLI_mutex_lock(&s_bufferCacheMutex);
+  std::map<uint64_t, CachedBuffer>::iterator it;
+  for (it = s_cachedBuffers.begin(); it != s_cachedBuffers.end(); it++) {
+    MEM_freeN(it->second.data);
+  }
+  s_cachedBuffers.clear();
+  s_cachedBytes = 0;
+  BLI_mutex_unlock(&s_bufferCacheMutex);
+}
@@ -0,0 +1,57 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#ifndef __COM_BUFFERCACHE_H__
+#define __COM_BUFFERCACHE_H__
+
+#include <cstdint>
+
+class MemoryBuffer;
+
+/**
+ * \brief Cache of execution group output buffers that persists between compositor runs.
+ *
+ * Buffers are content addressed: the key is a hash over the editor nodes an operation tree was
+ * built from, see NodeOperation::computeContentHash(). When only a node at the end of the tree is
+ * edited, the buffers of the unchanged upstream groups are restored from the cache instead of
+ * being recomputed.
+ *
+ * The cache is bounded, least recently used buffers are evicted once the size limit is exceeded.
+ * All methods are thread safe.
+ * \ingroup Memory
+ */
+class BufferCache {
+ public:
+  /**
+   * \brief copy a cached buffer with the given content hash into the buffer. Returns false when
+   * there is no cached buffer for the hash or its dimensions do not match.
+   */
+  static bool restore(uint64_t hash, MemoryBuffer *buffer);
+
+  /**
+   * \brief store a copy of the fully rendered buffer under the given content hash.
+   */
+  static void store(uint64_t hash, MemoryBuffer *buffer);
+
+  /**
+   * \brief free all cached buffers, called when the compositor is deinitialized.
+   */
+  static void purge();
+};
+
+#endif /* __COM_BUFFERCACHE_H__ */
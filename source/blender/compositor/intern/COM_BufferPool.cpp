@@ -0,0 +1,77 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include "COM_BufferPool.h"
+
+#include <map>
+#include <unordered_map>
+
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+#include "MEM_guardedalloc.h"
+
+static ThreadMutex s_bufferPoolMutex = BLI_MUTEX_INITIALIZER;
+
+/** \brief released buffers available for reuse, keyed by their size in floats. */
+static std::multimap<size_t, float *> s_freeBuffers;
+
+/** \brief size in floats of every buffer handed out by the pool, including acquired ones. */
+static std::unordered_map<const float *, size_t> s_bufferSizes;
+
+float *BufferPool::acquire(size_t num_floats)
+{
+  BLI_mutex_lock(&s_bufferPoolMutex);
+  std::multimap<size_t, float *>::iterator it = s_freeBuffers.find(num_floats);
+  if (it != s_freeBuffers.end()) {
+    float *buffer = it->second;
+    s_freeBuffers.erase(it);
+    BLI_mutex_unlock(&s_bufferPoolMutex);
+    return buffer;
+  }
+  BLI_mutex_unlock(&s_bufferPoolMutex);
+
+  float *buffer = (float *)MEM_mallocN_aligned(sizeof(float) * num_floats, 16, "COM_MemoryBuffer");
+
+  BLI_mutex_lock(&s_bufferPoolMutex);
+  s_bufferSizes[buffer] = num_floats;
+  BLI_mutex_unlock(&s_bufferPoolMutex);
+
+  return buffer;
+}
+
+void BufferPool::release(float *buffer)
+{
+  BLI_mutex_lock(&s_bufferPoolMutex);
+  std::unordered_map<const float *, size_t>::iterator it = s_bufferSizes.find(buffer);
+  BLI_assert(it != s_bufferSizes.end());
+  s_freeBuffers.insert(std::make_pair(it->second, buffer));
+  BLI_mutex_unlock(&s_bufferPoolMutex);
+}
+
+void BufferPool::purge()
+{
+  BLI_mutex_lock(&s_bufferPoolMutex);
+  std::multimap<size_t, float *>::iterator it;
+  for (it = s_freeBuffers.begin(); it != s_freeBuffers.end(); it++) {
+    s_bufferSizes.erase(it->second);
+    MEM_freeN(it->second);
+  }
+  s_freeBuffers.clear();
+  BLI_mutex_unlock(&s_bufferPoolMutex);
+}
@@ -0,0 +1,56 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#ifndef __COM_BUFFERPOOL_H__
+#define __COM_BUFFERPOOL_H__
+
+#include <cstddef>
+
+/**
+ * \brief Pool of recycled MemoryBuffer data arrays.
+ *
+ * During execution every chunk of every complex operation allocates a MemoryBuffer per read
+ * operation and frees it again when the chunk is finished. As chunks all have the same size,
+ * recycling these allocations instead of going through the system allocator for each of them
+ * avoids most of the allocation churn of heavy node trees on large frames.
+ *
+ * All methods are thread safe, buffers are acquired and released from the worker threads that
+ * execute the chunks.
+ * \ingroup Memory
+ */
+class BufferPool {
+ public:
+  /**
+   * \brief acquire a buffer with room for num_floats floats, recycling a released buffer of the
+   * exact same size when one is available. The content of the buffer is undefined.
+   */
+  static float *acquire(size_t num_floats);
+
+  /**
+   * \brief return a buffer acquired with acquire() to the pool for reuse.
+   */
+  static void release(float *buffer);
+
+  /**
+   * \brief free all pooled buffers, called when compositing is finished. Buffers that are still
+   * acquired are not affected.
+   */
+  static void purge();
+};
+
+#endif /* __COM_BUFFERPOOL_H__ */
@@ -23,6 +23,7 @@
 
 #include "atomic_ops.h"
 
+#include "COM_BufferCache.h"
 #include "COM_ChunkOrder.h"
 #include "COM_Debug.h"
 #include "COM_ExecutionGroup.h"
@@ -59,6 +60,8 @@ ExecutionGroup::ExecutionGroup()
   this->m_chunksFinished = 0;
   BLI_rcti_init(&this->m_viewerBorder, 0, 0, 0, 0);
   this->m_executionStartTime = 0;
+  this->m_cacheHash = 0;
+  this->m_cacheHashValid = false;
 }
 
 CompositorPriority ExecutionGroup::getRenderPriotrity()
@@ -148,6 +151,62 @@ void ExecutionGroup::initExecution()
   }
   maxNumber++;
   this->m_cachedMaxReadBufferOffset = maxNumber;
+
+  this->m_cacheHash = 0;
+  this->m_cacheHashValid = false;
+}
+
+bool ExecutionGroup::restoreCachedBuffer(const CompositorContext &context)
+{
+  NodeOperation *operation = this->getOutputOperation();
+  if (!operation->isWriteBufferOperation() || this->m_numberOfChunks == 0) {
+    return false;
+  }
+
+  uint64_t hash;
+  if (!operation->computeContentHash(&hash)) {
+    return false;
+  }
+  /* The quality setting changes the result of several operations (blurs) without being part of
+   * any node, so it has to be part of the key. */
+  const int quality = (int)context.getQuality();
+  hash = (hash ^ (uint64_t)quality) * 0x100000001b3;
+
+  this->m_cacheHash = hash;
+  this->m_cacheHashValid = true;
+
+  WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+  MemoryBuffer *buffer = writeOperation->getMemoryProxy()->getBuffer();
+  if (buffer == NULL || !BufferCache::restore(hash, buffer)) {
+    return false;
+  }
+
+  /* Mark all chunks as executed so depending groups read the restored buffer without any work
+   * being scheduled for this group. */
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    this->m_chunkExecutionStates[index] = COM_ES_EXECUTED;
+  }
+  this->m_chunksFinished = this->m_numberOfChunks;
+  return true;
+}
+
+void ExecutionGroup::storeCachedBuffer()
+{
+  if (!this->m_cacheHashValid || this->m_numberOfChunks == 0 ||
+      this->m_chunksFinished != this->m_numberOfChunks) {
+    return;
+  }
+
+  NodeOperation *operation = this->getOutputOperation();
+  if (!operation->isWriteBufferOperation()) {
+    return;
+  }
+
+  WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+  MemoryBuffer *buffer = writeOperation->getMemoryProxy()->getBuffer();
+  if (buffer != NULL) {
+    BufferCache::store(this->m_cacheHash, buffer);
+  }
 }
 
 void ExecutionGroup::deinitExecution()
@@ -182,6 +182,18 @@ class ExecutionGroup {
    */
   double m_executionStartTime;
 
+  /**
+   * \brief content hash of the operations in this group, used as BufferCache key.
+   * \see restoreCachedBuffer
+   */
+  uint64_t m_cacheHash;
+
+  /**
+   * \brief could a content hash be computed for this group.
+   * \note false when any operation in the group depends on external data (renders, images).
+   */
+  bool m_cacheHashValid;
+
   // methods
   /**
    * \brief check whether parameter operation can be added to the execution group
@@ -382,6 +394,22 @@ class ExecutionGroup {
    */
   void deinitExecution();
 
+  /**
+   * \brief try to restore the output buffer of this group from the BufferCache.
+   * \note Only groups writing to a memory buffer can be restored. On a cache hit all chunks are
+   * marked as executed so depending groups read the restored buffer without scheduling work.
+   * \note must be called after initExecution and before the WorkScheduler is started.
+   * \return true when the buffer was restored from the cache
+   */
+  bool restoreCachedBuffer(const CompositorContext &context);
+
+  /**
+   * \brief store the output buffer of this group in the BufferCache for future runs.
+   * \note only stores when a content hash could be computed and all chunks have been executed.
+   * \note must be called after the WorkScheduler has stopped and before deinitExecution.
+   */
+  void storeCachedBuffer();
+
   /**
    * \brief schedule an ExecutionGroup
    * \note this method will return when all chunks have been calculated, or the execution has
@@ -177,6 +177,12 @@ void ExecutionSystem::execute()
     executionGroup->initExecution();
   }
 
+  // Restore buffers of groups whose content did not change since a previous run
+  for (index = 0; index < this->m_groups.size(); index++) {
+    ExecutionGroup *executionGroup = this->m_groups[index];
+    executionGroup->restoreCachedBuffer(this->m_context);
+  }
+
   WorkScheduler::start(this->m_context);
 
   executeGroups(COM_PRIORITY_HIGH);
@@ -188,6 +194,15 @@ void ExecutionSystem::execute()
   WorkScheduler::finish();
   WorkScheduler::stop();
 
+  // Store fully rendered group buffers for future runs, unless the user canceled and the
+  // buffers may only be partially filled
+  if (!(editingtree->test_break && editingtree->test_break(editingtree->tbh))) {
+    for (index = 0; index < this->m_groups.size(); index++) {
+      ExecutionGroup *executionGroup = this->m_groups[index];
+      executionGroup->storeCachedBuffer();
+    }
+  }
+
   editingtree->stats_draw(editingtree->sdh, TIP_("Compositing | De-initializing execution"));
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
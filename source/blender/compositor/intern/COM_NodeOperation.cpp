@@ -17,9 +17,18 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <typeinfo>
 
+#include "BLI_listbase.h"
+
+#include "BKE_node.h"
+
+#include "MEM_guardedalloc.h"
+
 #include "COM_ExecutionSystem.h"
+#include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
 #include "COM_defines.h"
 
 #include "COM_NodeOperation.h" /* own include */
@@ -37,6 +46,163 @@ NodeOperation::NodeOperation()
   this->m_isResolutionSet = false;
   this->m_openCL = false;
   this->m_btree = NULL;
+  this->m_editorNode = NULL;
+}
+
+/* FNV-1a, the hashes only need to be stable within a session. */
+static void hash_data(uint64_t *hash, const void *data, size_t size)
+{
+  const unsigned char *bytes = (const unsigned char *)data;
+  for (size_t index = 0; index < size; index++) {
+    *hash = (*hash ^ bytes[index]) * 0x100000001b3;
+  }
+}
+
+static void hash_int(uint64_t *hash, int value)
+{
+  hash_data(hash, &value, sizeof(value));
+}
+
+/**
+ * Only node types whose result is fully determined by their settings and inputs can be hashed.
+ * Nodes reading data that can change behind their back (renders, images, movie clips, masks,
+ * textures, time) are excluded, as are nodes whose storage contains pointers (curves), since
+ * their raw storage bytes do not reflect their content.
+ */
+static bool editor_node_is_hashable(const bNode *node)
+{
+  switch (node->type) {
+    case CMP_NODE_VALUE:
+    case CMP_NODE_RGB:
+    case CMP_NODE_MIX_RGB:
+    case CMP_NODE_ALPHAOVER:
+    case CMP_NODE_INVERT:
+    case CMP_NODE_GAMMA:
+    case CMP_NODE_BRIGHTCONTRAST:
+    case CMP_NODE_MATH:
+    case CMP_NODE_NORMAL:
+    case CMP_NODE_NORMALIZE:
+    case CMP_NODE_RGBTOBW:
+    case CMP_NODE_SEPRGBA:
+    case CMP_NODE_COMBRGBA:
+    case CMP_NODE_SEPHSVA:
+    case CMP_NODE_COMBHSVA:
+    case CMP_NODE_SEPYUVA:
+    case CMP_NODE_COMBYUVA:
+    case CMP_NODE_SEPYCCA:
+    case CMP_NODE_COMBYCCA:
+    case CMP_NODE_BLUR:
+    case CMP_NODE_DBLUR:
+    case CMP_NODE_BILATERALBLUR:
+    case CMP_NODE_DESPECKLE:
+    case CMP_NODE_FILTER:
+    case CMP_NODE_DILATEERODE:
+    case CMP_NODE_GLARE:
+    case CMP_NODE_SUNBEAMS:
+    case CMP_NODE_LENSDIST:
+    case CMP_NODE_FLIP:
+    case CMP_NODE_ROTATE:
+    case CMP_NODE_TRANSLATE:
+    case CMP_NODE_SCALE:
+    case CMP_NODE_TRANSFORM:
+    case CMP_NODE_CROP:
+    case CMP_NODE_SETALPHA:
+    case CMP_NODE_ID_MASK:
+    case CMP_NODE_PREMULKEY:
+    case CMP_NODE_COLORBALANCE:
+    case CMP_NODE_COLORCORRECTION:
+    case CMP_NODE_HUE_SAT:
+    case CMP_NODE_TONEMAP:
+    case CMP_NODE_MAP_VALUE:
+    case CMP_NODE_MAP_RANGE:
+    case CMP_NODE_ZCOMBINE:
+    case CMP_NODE_CHANNEL_MATTE:
+    case CMP_NODE_CHROMA_MATTE:
+    case CMP_NODE_COLOR_MATTE:
+    case CMP_NODE_DIFF_MATTE:
+    case CMP_NODE_DIST_MATTE:
+    case CMP_NODE_LUMA_MATTE:
+    case CMP_NODE_COLOR_SPILL:
+    case CMP_NODE_SWITCH:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static void hash_editor_node(uint64_t *hash, const bNode *node)
+{
+  hash_int(hash, node->type);
+  hash_int(hash, node->custom1);
+  hash_int(hash, node->custom2);
+  hash_data(hash, &node->custom3, sizeof(float));
+  hash_data(hash, &node->custom4, sizeof(float));
+
+  if (node->storage) {
+    hash_data(hash, node->storage, MEM_allocN_len(node->storage));
+  }
+
+  /* Unconnected input sockets contribute their default value. Connected sockets are covered by
+   * the hashes of the upstream operations. */
+  LISTBASE_FOREACH (const bNodeSocket *, socket, &node->inputs) {
+    if (socket->default_value) {
+      hash_data(hash, socket->default_value, MEM_allocN_len(socket->default_value));
+    }
+  }
+}
+
+bool NodeOperation::computeContentHash(uint64_t *r_hash)
+{
+  std::map<NodeOperation *, uint64_t> memo;
+  return computeContentHash(memo, r_hash);
+}
+
+bool NodeOperation::computeContentHash(std::map<NodeOperation *, uint64_t> &memo, uint64_t *r_hash)
+{
+  std::map<NodeOperation *, uint64_t>::iterator it = memo.find(this);
+  if (it != memo.end()) {
+    *r_hash = it->second;
+    return true;
+  }
+
+  uint64_t hash = 0xcbf29ce484222325; /* FNV-1a offset basis. */
+
+  const char *type_name = typeid(*this).name();
+  hash_data(&hash, type_name, strlen(type_name));
+  hash_int(&hash, this->m_width);
+  hash_int(&hash, this->m_height);
+
+  if (this->m_editorNode) {
+    if (!editor_node_is_hashable(this->m_editorNode)) {
+      return false;
+    }
+    hash_editor_node(&hash, this->m_editorNode);
+  }
+
+  if (this->isReadBufferOperation()) {
+    /* Read buffers have no input links, their content comes from the write buffer operation of
+     * the group they read from. */
+    ReadBufferOperation *read = (ReadBufferOperation *)this;
+    NodeOperation *write = read->getMemoryProxy()->getWriteBufferOperation();
+    uint64_t input_hash;
+    if (write == NULL || !write->computeContentHash(memo, &input_hash)) {
+      return false;
+    }
+    hash_data(&hash, &input_hash, sizeof(input_hash));
+  }
+
+  for (unsigned int index = 0; index < getNumberOfInputSockets(); index++) {
+    NodeOperation *input = getInputOperation(index);
+    uint64_t input_hash;
+    if (input == NULL || !input->computeContentHash(memo, &input_hash)) {
+      return false;
+    }
+    hash_data(&hash, &input_hash, sizeof(input_hash));
+  }
+
+  memo[this] = hash;
+  *r_hash = hash;
+  return true;
 }
 
 NodeOperation::~NodeOperation()
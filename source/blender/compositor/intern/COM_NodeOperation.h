@@ -19,7 +19,9 @@
 #ifndef __COM_NODEOPERATION_H__
 #define __COM_NODEOPERATION_H__
 
+#include <cstdint>
 #include <list>
+#include <map>
 #include <sstream>
 #include <string>
 
@@ -119,6 +121,13 @@ class NodeOperation : public SocketReader {
    */
   const bNodeTree *m_btree;
 
+  /**
+   * \brief the editor node this operation was created for, used for content hashing of cached
+   * buffers. NULL for helper operations inserted by the builder (read/write buffers, datatype
+   * conversions).
+   */
+  const bNode *m_editorNode;
+
   /**
    * \brief set to truth when resolution for this operation is set
    */
@@ -150,6 +159,26 @@ class NodeOperation : public SocketReader {
     return m_inputs.empty();
   }
 
+  void setEditorNode(const bNode *node)
+  {
+    this->m_editorNode = node;
+  }
+  const bNode *getEditorNode() const
+  {
+    return this->m_editorNode;
+  }
+
+  /**
+   * \brief compute a content hash over this operation and all operations upstream of it, for
+   * addressing cached buffers in the BufferCache.
+   *
+   * The hash covers the operation types, their resolutions and the settings of the editor nodes
+   * they were created from, so it only changes when the result of the operation can change.
+   * Returns false when no reliable hash can be computed, which is the case when any upstream node
+   * depends on data that is not part of its settings (renders, images, movie clips, masks, ...).
+   */
+  bool computeContentHash(uint64_t *r_hash);
+
   /**
    * \brief determine the resolution of this node
    * \note this method will not set the resolution, this is the responsibility of the caller
@@ -397,6 +426,12 @@ class NodeOperation : public SocketReader {
   SocketReader *getInputSocketReader(unsigned int inputSocketindex);
   NodeOperation *getInputOperation(unsigned int inputSocketindex);
 
+  /**
+   * \brief recursive worker of computeContentHash, the memo map makes operations shared between
+   * multiple downstream operations hash only once.
+   */
+  bool computeContentHash(std::map<NodeOperation *, uint64_t> &memo, uint64_t *r_hash);
+
   void deinitMutex();
   void initMutex();
   void lockMutex();
@@ -125,6 +125,9 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
 
 void NodeOperationBuilder::addOperation(NodeOperation *operation)
 {
+  /* Operations added outside of node conversion (read/write buffers, converters) keep a NULL
+   * editor node, which excludes them from content hashing on their own account. */
+  operation->setEditorNode(m_current_node ? m_current_node->getbNode() : NULL);
   m_operations.push_back(operation);
 }
 
@@ -23,6 +23,8 @@
 #include "BKE_node.h"
 #include "BKE_scene.h"
 
+#include "COM_BufferCache.h"
+#include "COM_BufferPool.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_MovieDistortionOperation.h"
 #include "COM_WorkScheduler.h"
@@ -105,11 +107,19 @@ void COM_execute(RenderData *rd,
   system->execute();
   delete system;
 
+  /* All MemoryBuffers are freed now, so the pooled allocations can be returned
+   * to the system allocator until the next composite. */
+  BufferPool::purge();
+
   BLI_mutex_unlock(&s_compositorMutex);
 }
 
 void COM_deinitialize()
 {
+  /* The buffer cache persists between composites so it can serve future runs, it is only freed
+   * when the compositor as a whole goes away. */
+  BufferCache::purge();
+
   if (is_compositorMutex_init) {
     BLI_mutex_lock(&s_compositorMutex);
     WorkScheduler::deinitialize();
@@ -63,6 +63,34 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Operation Tracing */
+
+/* Single row of the aggregated table of slowest operations. */
+typedef struct DEGTraceSlowestEntry {
+  char name[96];
+  float frame;
+  double time;
+} DEGTraceSlowestEntry;
+
+/* Start recording evaluated operations (start/stop time, evaluation thread)
+ * into a ring buffer of the given size. Zero or negative size selects a
+ * default. Re-enabling clears previously recorded events. */
+void DEG_debug_trace_enable(int max_events);
+void DEG_debug_trace_disable(void);
+bool DEG_debug_trace_is_enabled(void);
+
+/* Export all recorded events as Chrome trace JSON (chrome://tracing format).
+ * Returns false when the file can not be written. */
+bool DEG_debug_trace_export_chrome_json(const char *filepath);
+
+/* Aggregate recorded events into the slowest operations for every recorded
+ * frame, at most max_entries_per_frame entries per frame. Returns a
+ * MEM-allocated array of r_num_entries entries, or NULL when nothing was
+ * recorded. The caller is expected to free the array. */
+DEGTraceSlowestEntry *DEG_debug_trace_slowest_table(int max_entries_per_frame,
+                                                    int *r_num_entries);
+
 /* ************************************************ */
 
 /* Compare two dependency graphs. */
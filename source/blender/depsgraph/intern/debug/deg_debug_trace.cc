@@ -0,0 +1,279 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Tracing of operation evaluations.
+ *
+ * When enabled, every evaluated operation records its start time, duration
+ * and evaluation thread into a fixed-size ring buffer. The recorded timeline
+ * can be exported as Chrome trace JSON (to be opened in chrome://tracing or
+ * any compatible viewer), or aggregated into a table of the slowest
+ * operations per frame.
+ */
+
+#include "intern/debug/deg_debug_trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_string.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+#include "DEG_depsgraph_debug.h"
+
+#include "intern/depsgraph_type.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace DEG {
+
+namespace {
+
+struct TraceEvent {
+  char name[sizeof(((DEGTraceSlowestEntry *)nullptr)->name)];
+  float frame;
+  double start_time;
+  double duration;
+  uint64_t thread_id;
+};
+
+struct TraceState {
+  TraceState()
+  {
+    BLI_spin_init(&lock);
+  }
+
+  /* Lock held while accessing the ring buffer fields below. */
+  SpinLock lock;
+  /* Checked without the lock from the evaluation hot path, only modified from
+   * the main thread by enable/disable. */
+  bool enabled = false;
+
+  TraceEvent *events = nullptr;
+  int max_events = 0;
+  int num_events = 0;
+  /* Index at which the next event is to be recorded. */
+  int next_event = 0;
+};
+
+TraceState g_trace;
+
+/* Stable small identifier of the current thread, used as Chrome trace "tid"
+ * since thread handles are not portably convertible to an integer. */
+uint64_t trace_thread_id()
+{
+  static std::atomic<uint64_t> next_thread_id(0);
+  static thread_local uint64_t thread_id = ++next_thread_id;
+  return thread_id;
+}
+
+/* Copy all recorded events, in the order of recording. */
+Vector<TraceEvent> trace_events_snapshot()
+{
+  Vector<TraceEvent> events;
+  BLI_spin_lock(&g_trace.lock);
+  events.reserve(g_trace.num_events);
+  for (int i = 0; i < g_trace.num_events; i++) {
+    const int index = (g_trace.next_event - g_trace.num_events + i + g_trace.max_events) %
+                      g_trace.max_events;
+    events.append(g_trace.events[index]);
+  }
+  BLI_spin_unlock(&g_trace.lock);
+  return events;
+}
+
+void trace_write_json_string(FILE *f, const char *str)
+{
+  fputc('"', f);
+  for (const char *p = str; *p != '\0'; p++) {
+    if (*p == '"' || *p == '\\') {
+      fputc('\\', f);
+    }
+    fputc(*p, f);
+  }
+  fputc('"', f);
+}
+
+}  // namespace
+
+bool deg_debug_trace_is_enabled()
+{
+  return g_trace.enabled;
+}
+
+void deg_debug_trace_record(const OperationNode *operation_node,
+                            float frame,
+                            double start_time,
+                            double duration)
+{
+  TraceEvent event;
+  BLI_strncpy(event.name, operation_node->full_identifier().c_str(), sizeof(event.name));
+  event.frame = frame;
+  event.start_time = start_time;
+  event.duration = duration;
+  event.thread_id = trace_thread_id();
+  BLI_spin_lock(&g_trace.lock);
+  if (g_trace.events != nullptr) {
+    g_trace.events[g_trace.next_event] = event;
+    g_trace.next_event = (g_trace.next_event + 1) % g_trace.max_events;
+    if (g_trace.num_events < g_trace.max_events) {
+      g_trace.num_events++;
+    }
+  }
+  BLI_spin_unlock(&g_trace.lock);
+}
+
+}  // namespace DEG
+
+void DEG_debug_trace_enable(int max_events)
+{
+  DEG_debug_trace_disable();
+  if (max_events <= 0) {
+    max_events = 65536;
+  }
+  BLI_spin_lock(&DEG::g_trace.lock);
+  DEG::g_trace.events = (DEG::TraceEvent *)MEM_callocN(sizeof(DEG::TraceEvent) * max_events,
+                                                       "depsgraph trace events");
+  DEG::g_trace.max_events = max_events;
+  DEG::g_trace.num_events = 0;
+  DEG::g_trace.next_event = 0;
+  BLI_spin_unlock(&DEG::g_trace.lock);
+  DEG::g_trace.enabled = true;
+}
+
+void DEG_debug_trace_disable(void)
+{
+  DEG::g_trace.enabled = false;
+  BLI_spin_lock(&DEG::g_trace.lock);
+  MEM_SAFE_FREE(DEG::g_trace.events);
+  DEG::g_trace.max_events = 0;
+  DEG::g_trace.num_events = 0;
+  DEG::g_trace.next_event = 0;
+  BLI_spin_unlock(&DEG::g_trace.lock);
+}
+
+bool DEG_debug_trace_is_enabled(void)
+{
+  return DEG::deg_debug_trace_is_enabled();
+}
+
+bool DEG_debug_trace_export_chrome_json(const char *filepath)
+{
+  const DEG::Vector<DEG::TraceEvent> events = DEG::trace_events_snapshot();
+  FILE *f = BLI_fopen(filepath, "w");
+  if (f == nullptr) {
+    return false;
+  }
+  /* Use the first recorded event as origin of the trace clock. */
+  double base_time = 0.0;
+  if (!events.is_empty()) {
+    base_time = events[0].start_time;
+    for (const DEG::TraceEvent &event : events) {
+      base_time = std::min(base_time, event.start_time);
+    }
+  }
+  fprintf(f, "[\n");
+  bool is_first = true;
+  for (const DEG::TraceEvent &event : events) {
+    if (!is_first) {
+      fprintf(f, ",\n");
+    }
+    is_first = false;
+    fprintf(f, "{\"name\": ");
+    DEG::trace_write_json_string(f, event.name);
+    fprintf(f,
+            ", \"cat\": \"depsgraph\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, "
+            "\"pid\": 1, \"tid\": %llu, \"args\": {\"frame\": %f}}",
+            (event.start_time - base_time) * 1e6,
+            event.duration * 1e6,
+            (unsigned long long)event.thread_id,
+            event.frame);
+  }
+  fprintf(f, "\n]\n");
+  const bool ok = (ferror(f) == 0);
+  fclose(f);
+  return ok;
+}
+
+DEGTraceSlowestEntry *DEG_debug_trace_slowest_table(int max_entries_per_frame, int *r_num_entries)
+{
+  *r_num_entries = 0;
+  if (max_entries_per_frame <= 0) {
+    return nullptr;
+  }
+  DEG::Vector<DEG::TraceEvent> events = DEG::trace_events_snapshot();
+  if (events.is_empty()) {
+    return nullptr;
+  }
+  /* Merge repeated evaluations of the same operation within a frame, so the
+   * table reflects the total time an operation took on that frame. */
+  std::sort(events.begin(), events.end(), [](const DEG::TraceEvent &a, const DEG::TraceEvent &b) {
+    if (a.frame != b.frame) {
+      return a.frame < b.frame;
+    }
+    return strcmp(a.name, b.name) < 0;
+  });
+  DEG::Vector<DEG::TraceEvent> merged;
+  for (const DEG::TraceEvent &event : events) {
+    if (!merged.is_empty() && merged.last().frame == event.frame &&
+        STREQ(merged.last().name, event.name)) {
+      merged.last().duration += event.duration;
+    }
+    else {
+      merged.append(event);
+    }
+  }
+  /* Per frame, keep only the most expensive operations. */
+  DEG::Vector<DEGTraceSlowestEntry> table;
+  int frame_begin = 0;
+  while (frame_begin < (int)merged.size()) {
+    int frame_end = frame_begin + 1;
+    while (frame_end < (int)merged.size() && merged[frame_end].frame == merged[frame_begin].frame) {
+      frame_end++;
+    }
+    std::sort(merged.begin() + frame_begin,
+              merged.begin() + frame_end,
+              [](const DEG::TraceEvent &a, const DEG::TraceEvent &b) {
+                return a.duration > b.duration;
+              });
+    const int num_frame_entries = std::min(max_entries_per_frame, frame_end - frame_begin);
+    for (int i = 0; i < num_frame_entries; i++) {
+      const DEG::TraceEvent &event = merged[frame_begin + i];
+      DEGTraceSlowestEntry entry;
+      BLI_strncpy(entry.name, event.name, sizeof(entry.name));
+      entry.frame = event.frame;
+      entry.time = event.duration;
+      table.append(entry);
+    }
+    frame_begin = frame_end;
+  }
+  DEGTraceSlowestEntry *result = (DEGTraceSlowestEntry *)MEM_mallocN(
+      sizeof(DEGTraceSlowestEntry) * table.size(), "depsgraph trace slowest table");
+  memcpy(result, table.data(), sizeof(DEGTraceSlowestEntry) * table.size());
+  *r_num_entries = (int)table.size();
+  return result;
+}
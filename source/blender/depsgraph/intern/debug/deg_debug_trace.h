@@ -0,0 +1,45 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Recording side of the operation tracing. The public access to the recorded
+ * events (Chrome trace export, slowest operations table) is in
+ * DEG_depsgraph_debug.h.
+ */
+
+#pragma once
+
+namespace DEG {
+
+struct OperationNode;
+
+/* Cheap check used by the evaluation code to avoid any tracing overhead when
+ * tracing was not explicitly enabled. */
+bool deg_debug_trace_is_enabled();
+
+/* Record a single finished operation evaluation into the ring buffer.
+ * Thread-safe, called from evaluation threads. */
+void deg_debug_trace_record(const OperationNode *operation_node,
+                            float frame,
+                            double start_time,
+                            double duration);
+
+}  // namespace DEG
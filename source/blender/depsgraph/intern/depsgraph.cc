@@ -60,6 +60,8 @@ namespace DEG {
 Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluationMode mode)
     : time_source(nullptr),
       need_update(true),
+      relations_were_built(false),
+      check_relations_before_add(false),
       need_update_time(false),
       bmain(bmain),
       scene(scene),
@@ -167,7 +169,7 @@ void Depsgraph::clear_id_nodes()
 Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *description, int flags)
 {
   Relation *rel = nullptr;
-  if (flags & RELATION_CHECK_BEFORE_ADD) {
+  if ((flags & RELATION_CHECK_BEFORE_ADD) || check_relations_before_add) {
     rel = check_nodes_connected(from, to, description);
   }
   if (rel != nullptr) {
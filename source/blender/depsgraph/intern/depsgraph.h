@@ -107,6 +107,23 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update;
 
+  /* Indicates that relations were built at least once for this graph. Used to
+   * restrict the on-disk relations cache restore to the first build after the
+   * graph is created: the cache validation can not detect in-session edits
+   * which retarget relations between an unchanged node set. */
+  bool relations_were_built;
+
+  /* Original IDs whose relations are tagged for an incremental update. Only
+   * used when the whole graph is not tagged for rebuild: the relations update
+   * will then attempt to only rebuild nodes and incident relations of these
+   * IDs, with a full rebuild as a fallback. */
+  Set<ID *> need_update_relations_ids;
+
+  /* Check for an already existing relation before adding a new one. Enabled
+   * while relations are re-created by the incremental relations update, since
+   * part of the relations of an ID may have survived the update. */
+  bool check_relations_before_add;
+
   /* Indicates which ID types were updated. */
   char id_type_updated[MAX_LIBARRAY];
 
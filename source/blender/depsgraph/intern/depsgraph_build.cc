@@ -57,9 +57,12 @@
 #include "intern/node/deg_node_id.h"
 #include "intern/node/deg_node_operation.h"
 
+#include "intern/depsgraph_cache.h"
+#include "intern/depsgraph_physics.h"
 #include "intern/depsgraph_registry.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_type.h"
+#include "intern/eval/deg_eval_copy_on_write.h"
 
 /* ****************** */
 /* External Build API */
@@ -231,6 +234,8 @@ static void graph_build_finalize_common(DEG::Depsgraph *deg_graph, Main *bmain)
 #endif
   /* Relations are up to date. */
   deg_graph->need_update = false;
+  deg_graph->need_update_relations_ids.clear();
+  deg_graph->relations_were_built = true;
 }
 
 /* Build depsgraph for the given scene layer, and dump results in given graph container. */
@@ -254,14 +259,30 @@ void DEG_graph_build_from_view_layer(Depsgraph *graph,
   node_builder.begin_build();
   node_builder.build_view_layer(scene, view_layer, DEG::DEG_ID_LINKED_DIRECTLY);
   node_builder.end_build();
-  /* Hook up relationships between operations - to determine evaluation order. */
-  DEG::DepsgraphRelationBuilder relation_builder(bmain, deg_graph, &builder_cache);
-  relation_builder.begin_build();
-  relation_builder.build_view_layer(scene, view_layer, DEG::DEG_ID_LINKED_DIRECTLY);
-  relation_builder.build_copy_on_write_relations();
-  relation_builder.build_driver_relations();
+  /* Hook up relationships between operations - to determine evaluation order.
+   * When the relations cache is enabled and a valid cache file exists next to
+   * the .blend file, the relations are restored from it instead. Only the
+   * first build of a graph may restore: the cache validation can not detect
+   * in-session edits which retarget relations between an unchanged node set,
+   * so later rebuilds always run the relation builder. */
+  bool relations_restored = false;
+  if ((G.debug & G_DEBUG_DEPSGRAPH_CACHE) && !deg_graph->relations_were_built) {
+    relations_restored = DEG::deg_graph_cache_try_restore_relations(deg_graph);
+  }
+  if (!relations_restored) {
+    DEG::DepsgraphRelationBuilder relation_builder(bmain, deg_graph, &builder_cache);
+    relation_builder.begin_build();
+    relation_builder.build_view_layer(scene, view_layer, DEG::DEG_ID_LINKED_DIRECTLY);
+    relation_builder.build_copy_on_write_relations();
+    relation_builder.build_driver_relations();
+  }
   /* Finalize building. */
   graph_build_finalize_common(deg_graph, bmain);
+  /* Refresh the cache from the freshly built relations, so a next file open
+   * can skip the relations build. */
+  if ((G.debug & G_DEBUG_DEPSGRAPH_CACHE) && !relations_restored) {
+    DEG::deg_graph_cache_write(deg_graph);
+  }
   /* Finish statistics. */
   if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
     printf("Depsgraph built in %f seconds.\n", PIL_check_seconds_timer() - start_time);
@@ -478,12 +499,332 @@ void DEG_graph_build_from_ids(Depsgraph *graph,
   }
 }
 
+/* Incremental relations update.
+ *
+ * When all the IDs whose relations changed are known it is possible to avoid re-building the
+ * whole dependency graph: nodes of the tagged IDs are removed together with all their incident
+ * relations, re-created by the regular builders, and spliced back into the existing graph by
+ * re-creating relations of every ID which used to be connected to the removed nodes.
+ *
+ * The update falls back to a full rebuild whenever the graph can not be spliced reliably, see
+ * deg_graph_incremental_relations_update_is_possible(). */
+
+namespace DEG {
+namespace {
+
+class DepsgraphIncrementalNodeBuilder : public DepsgraphNodeBuilder {
+ public:
+  DepsgraphIncrementalNodeBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache)
+      : DepsgraphNodeBuilder(bmain, graph, cache)
+  {
+  }
+
+  /* Remove nodes of the given IDs from the graph, keeping enough state around to re-create them
+   * in-place with the regular build_id(). */
+  void begin_build_ids(const Vector<IDNode *> &id_nodes)
+  {
+    scene_ = graph_->scene;
+    view_layer_ = graph_->view_layer;
+    Set<ID *> removed_ids;
+    for (IDNode *id_node : id_nodes) {
+      removed_ids.add(id_node->id_orig);
+    }
+    /* Steal copy-on-write datablocks and runtime state of the ID nodes which are about to be
+     * removed, following what begin_build() does for the whole graph. */
+    for (IDNode *id_node : id_nodes) {
+      if (deg_copy_on_write_is_needed(id_node->id_type)) {
+        IDInfo *id_info = (IDInfo *)MEM_mallocN(sizeof(IDInfo), "depsgraph id info");
+        if (deg_copy_on_write_is_expanded(id_node->id_cow) &&
+            id_node->id_orig != id_node->id_cow) {
+          id_info->id_cow = id_node->id_cow;
+        }
+        else {
+          id_info->id_cow = nullptr;
+        }
+        id_info->previously_visible_components_mask = id_node->visible_components_mask;
+        id_info->previous_eval_flags = id_node->eval_flags;
+        id_info->previous_customdata_masks = id_node->customdata_masks;
+        id_info_hash_.add_new(id_node->id_orig, id_info);
+      }
+      id_node->id_cow = nullptr;
+    }
+    /* Save explicit entry tags of the removed operations, they are re-applied by end_build(). */
+    Vector<OperationNode *> tagged_operations;
+    for (OperationNode *op_node : graph_->entry_tags) {
+      ComponentNode *comp_node = op_node->owner;
+      IDNode *id_node = comp_node->owner;
+      if (!removed_ids.contains(id_node->id_orig)) {
+        continue;
+      }
+      SavedEntryTag entry_tag;
+      entry_tag.id_orig = id_node->id_orig;
+      entry_tag.component_type = comp_node->type;
+      entry_tag.opcode = op_node->opcode;
+      entry_tag.name = op_node->name;
+      entry_tag.name_tag = op_node->name_tag;
+      saved_entry_tags_.append(entry_tag);
+      tagged_operations.append(op_node);
+    }
+    for (OperationNode *op_node : tagged_operations) {
+      graph_->entry_tags.remove(op_node);
+    }
+    /* Collect and remove all relations incident to the removed nodes. The IDs on the other side
+     * of the removed relations are remembered: their relations are to be created again once the
+     * tagged IDs have been re-built. */
+    Set<Relation *> relations;
+    Set<OperationNode *> operations;
+    for (IDNode *id_node : id_nodes) {
+      collect_node_relations(id_node, &relations);
+      for (ComponentNode *comp_node : id_node->components.values()) {
+        collect_node_relations(comp_node, &relations);
+        for (OperationNode *op_node : comp_node->operations) {
+          collect_node_relations(op_node, &relations);
+          operations.add(op_node);
+        }
+      }
+    }
+    for (Relation *rel : relations) {
+      add_neighbor_of(rel->from, removed_ids);
+      add_neighbor_of(rel->to, removed_ids);
+      rel->unlink();
+      OBJECT_GUARDED_DELETE(rel, Relation);
+    }
+    /* Remove the operations from the flat list of the graph, preserving its order. */
+    Vector<OperationNode *> operations_left;
+    operations_left.reserve(graph_->operations.size());
+    for (OperationNode *op_node : graph_->operations) {
+      if (!operations.contains(op_node)) {
+        operations_left.append(op_node);
+      }
+    }
+    graph_->operations = operations_left;
+    /* Remove the ID nodes themselves. */
+    Vector<IDNode *> id_nodes_left;
+    id_nodes_left.reserve(graph_->id_nodes.size());
+    for (IDNode *id_node : graph_->id_nodes) {
+      if (!removed_ids.contains(id_node->id_orig)) {
+        id_nodes_left.append(id_node);
+      }
+    }
+    graph_->id_nodes = id_nodes_left;
+    for (IDNode *id_node : id_nodes) {
+      graph_->id_hash.remove(id_node->id_orig);
+      id_node->destroy();
+      OBJECT_GUARDED_DELETE(id_node, IDNode);
+    }
+    /* Keep the builder from descending into IDs which are still in the graph. */
+    for (IDNode *id_node : graph_->id_nodes) {
+      built_map_.tagBuild(id_node->id_orig);
+    }
+  }
+
+  /* Original IDs which had relations to the removed nodes. */
+  Set<ID *> neighbor_ids;
+
+ protected:
+  void collect_node_relations(Node *node, Set<Relation *> *relations)
+  {
+    for (Relation *rel : node->inlinks) {
+      relations->add(rel);
+    }
+    for (Relation *rel : node->outlinks) {
+      relations->add(rel);
+    }
+  }
+
+  void add_neighbor_of(Node *node, const Set<ID *> &removed_ids)
+  {
+    IDNode *id_node = node_id_owner(node);
+    if (id_node != nullptr && !removed_ids.contains(id_node->id_orig)) {
+      neighbor_ids.add(id_node->id_orig);
+    }
+  }
+
+  IDNode *node_id_owner(Node *node)
+  {
+    if (node->type == NodeType::TIMESOURCE) {
+      return nullptr;
+    }
+    if (node->type == NodeType::ID_REF) {
+      return (IDNode *)node;
+    }
+    if (node->type == NodeType::OPERATION) {
+      return ((OperationNode *)node)->owner->owner;
+    }
+    return ((ComponentNode *)node)->owner;
+  }
+};
+
+class DepsgraphIncrementalRelationBuilder : public DepsgraphRelationBuilder {
+ public:
+  DepsgraphIncrementalRelationBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache)
+      : DepsgraphRelationBuilder(bmain, graph, cache)
+  {
+  }
+
+  void begin_build_ids(const Set<ID *> &ids)
+  {
+    scene_ = graph_->scene;
+    /* Keep the builder from descending into IDs whose relations are intact. */
+    for (IDNode *id_node : graph_->id_nodes) {
+      if (!ids.contains(id_node->id_orig)) {
+        built_map_.tagBuild(id_node->id_orig);
+      }
+    }
+  }
+};
+
+/* Check whether relations of all the tagged IDs can be re-created with the generic build_id(),
+ * which is what the incremental update relies on. */
+bool deg_graph_incremental_relations_update_is_possible(Depsgraph *graph)
+{
+  /* When a big share of the graph is tagged a full rebuild is at least as cheap as walking all
+   * the relations incident to the tagged IDs. */
+  if (graph->need_update_relations_ids.size() * 8 > (uint32_t)graph->id_nodes.size()) {
+    return false;
+  }
+  for (ID *id : graph->need_update_relations_ids) {
+    IDNode *id_node = graph->find_id_node(id);
+    if (id_node == nullptr) {
+      /* The ID is new to the graph, impossible to know the context it is to be pulled in from. */
+      return false;
+    }
+    if (id_node->has_base) {
+      /* Objects with a base are built from their view layer with a base index, which can not be
+       * reproduced by build_id(). */
+      return false;
+    }
+    switch (GS(id->name)) {
+      case ID_AC:
+      case ID_AR:
+      case ID_CA:
+      case ID_KE:
+      case ID_LA:
+      case ID_LP:
+      case ID_NT:
+      case ID_MA:
+      case ID_TE:
+      case ID_IM:
+      case ID_WO:
+      case ID_MSK:
+      case ID_LS:
+      case ID_MC:
+      case ID_ME:
+      case ID_CU:
+      case ID_MB:
+      case ID_LT:
+      case ID_HA:
+      case ID_PT:
+      case ID_VO:
+      case ID_SPK:
+      case ID_SO:
+      case ID_CF:
+      case ID_OB:
+        break;
+      default:
+        /* Scenes and collections define bases, layers and visibility for other IDs, remaining
+         * types are not supported by build_id(). */
+        return false;
+    }
+  }
+  return true;
+}
+
+void deg_graph_relations_update_incremental(Depsgraph *graph, Main *bmain)
+{
+  const Set<ID *> &ids = graph->need_update_relations_ids;
+  Vector<IDNode *> id_nodes;
+  for (ID *id : ids) {
+    id_nodes.append(graph->find_id_node(id));
+  }
+  /* Linked state and visibility are derived from the view layer, which build_id() has no access
+   * to: restore them after the rebuild. */
+  struct SavedIDState {
+    ID *id;
+    eDepsNode_LinkedState_Type linked_state;
+    bool is_directly_visible;
+  };
+  Vector<SavedIDState> saved_states;
+  for (IDNode *id_node : id_nodes) {
+    SavedIDState state;
+    state.id = id_node->id_orig;
+    state.linked_state = id_node->linked_state;
+    state.is_directly_visible = id_node->is_directly_visible;
+    saved_states.append(state);
+  }
+  /* Remember which IDs were in the graph, so IDs newly pulled in by the rebuild can have their
+   * relations created as well. */
+  Set<ID *> previous_ids;
+  for (IDNode *id_node : graph->id_nodes) {
+    previous_ids.add(id_node->id_orig);
+  }
+  DepsgraphBuilderCache builder_cache;
+  /* Re-create nodes of the tagged IDs. */
+  DepsgraphIncrementalNodeBuilder node_builder(bmain, graph, &builder_cache);
+  node_builder.begin_build_ids(id_nodes);
+  for (ID *id : ids) {
+    node_builder.build_id(id);
+  }
+  node_builder.end_build();
+  for (const SavedIDState &state : saved_states) {
+    IDNode *id_node = graph->find_id_node(state.id);
+    if (id_node != nullptr) {
+      id_node->linked_state = state.linked_state;
+      id_node->is_directly_visible = state.is_directly_visible;
+    }
+  }
+  /* Relations are re-created for the tagged IDs, for the IDs newly pulled into the graph and for
+   * the IDs which used to be connected to the removed nodes. */
+  Set<ID *> relation_ids;
+  for (ID *id : ids) {
+    relation_ids.add(id);
+  }
+  for (ID *id : node_builder.neighbor_ids) {
+    relation_ids.add(id);
+  }
+  for (IDNode *id_node : graph->id_nodes) {
+    if (!previous_ids.contains(id_node->id_orig)) {
+      relation_ids.add(id_node->id_orig);
+    }
+  }
+  /* Existence of every relation is to be checked before it is added: IDs which kept a part of
+   * their relations are re-built as a whole, without the check this would create duplicates. */
+  graph->check_relations_before_add = true;
+  DepsgraphIncrementalRelationBuilder relation_builder(bmain, graph, &builder_cache);
+  relation_builder.begin_build();
+  relation_builder.begin_build_ids(relation_ids);
+  for (ID *id : relation_ids) {
+    relation_builder.build_id(id);
+  }
+  for (ID *id : relation_ids) {
+    IDNode *id_node = graph->find_id_node(id);
+    if (id_node == nullptr) {
+      continue;
+    }
+    relation_builder.build_copy_on_write_relations(id_node);
+    relation_builder.build_driver_relations(id_node);
+  }
+  graph->check_relations_before_add = false;
+  /* Physics relations are built lazily from the graph, drop possibly stale caches. */
+  clear_physics_relations(graph);
+  /* Same post-processing as after a full rebuild: cycle detection, visibility flush and
+   * re-tagging of the changed IDs. */
+  graph_build_finalize_common(graph, bmain);
+}
+
+}  // namespace
+}  // namespace DEG
+
 /* Tag graph relations for update. */
 void DEG_graph_tag_relations_update(Depsgraph *graph)
 {
   DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
   DEG::Depsgraph *deg_graph = reinterpret_cast<DEG::Depsgraph *>(graph);
   deg_graph->need_update = true;
+  /* The on-disk relations cache no longer matches the session state. */
+  if (G.debug & G_DEBUG_DEPSGRAPH_CACHE) {
+    DEG::deg_graph_cache_invalidate(deg_graph);
+  }
   /* NOTE: When relations are updated, it's quite possible that
    * we've got new bases in the scene. This means, we need to
    * re-create flat array of bases in view layer.
@@ -496,13 +837,48 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   }
 }
 
+/* Tag relations of the given ID for update. */
+void DEG_graph_id_tag_relations_update(Depsgraph *graph, ID *id)
+{
+  if (id == nullptr) {
+    DEG_graph_tag_relations_update(graph);
+    return;
+  }
+  DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  DEG::Depsgraph *deg_graph = reinterpret_cast<DEG::Depsgraph *>(graph);
+  deg_graph->need_update_relations_ids.add(id);
+  /* The on-disk relations cache no longer matches the session state. */
+  if (G.debug & G_DEBUG_DEPSGRAPH_CACHE) {
+    DEG::deg_graph_cache_invalidate(deg_graph);
+  }
+  /* Make sure the ID is re-evaluated against its new relations. */
+  DEG::IDNode *id_node = deg_graph->find_id_node(id);
+  if (id_node != nullptr) {
+    id_node->tag_update(deg_graph, DEG::DEG_UPDATE_SOURCE_RELATIONS);
+  }
+}
+
 /* Create or update relations in the specified graph. */
 void DEG_graph_relations_update(Depsgraph *graph, Main *bmain, Scene *scene, ViewLayer *view_layer)
 {
   DEG::Depsgraph *deg_graph = (DEG::Depsgraph *)graph;
   if (!deg_graph->need_update) {
-    /* Graph is up to date, nothing to do. */
-    return;
+    if (deg_graph->need_update_relations_ids.is_empty()) {
+      /* Graph is up to date, nothing to do. */
+      return;
+    }
+    if (DEG::deg_graph_incremental_relations_update_is_possible(deg_graph)) {
+      double start_time = 0.0;
+      if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+        start_time = PIL_check_seconds_timer();
+      }
+      DEG::deg_graph_relations_update_incremental(deg_graph, bmain);
+      if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+        printf("Depsgraph relations updated incrementally in %f seconds.\n",
+               PIL_check_seconds_timer() - start_time);
+      }
+      return;
+    }
   }
   DEG_graph_build_from_view_layer(graph, bmain, scene, view_layer);
 }
@@ -515,3 +891,12 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+/* Tag relations of the given ID for update in all registered dependency graphs. */
+void DEG_id_relations_tag_update(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations for update.\n", __func__);
+  for (DEG::Depsgraph *depsgraph : DEG::get_all_registered_graphs(bmain)) {
+    DEG_graph_id_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph), id);
+  }
+}
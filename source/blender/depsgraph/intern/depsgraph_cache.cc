@@ -0,0 +1,398 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * On-disk cache for dependency graph relations.
+ *
+ * The cache file stores the relations of a fully built graph, with endpoints
+ * addressed symbolically: operations are identified by the ID name and
+ * library of their owning datablock, the component type and name, the
+ * operation code, name and name tag. This allows the cache to be validated
+ * against a freshly built set of nodes: when every stored ID and operation
+ * resolves to an existing node and the node counts match, the stored
+ * relations describe the exact same topology the relation builder would
+ * create, and the relations build step can be skipped.
+ *
+ * Only the topology is cached. Evaluated (copy-on-write) datablock states
+ * reference runtime data and can not be stored on disk, so the first
+ * evaluation after file open still runs as usual.
+ */
+
+#include "intern/depsgraph_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_ID.h"
+#include "DNA_layer_types.h"
+#include "DNA_scene_types.h"
+
+#include "BLI_fileops.h"
+#include "BLI_listbase.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_global.h"
+#include "BKE_main.h"
+
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
+#include "intern/node/deg_node_time.h"
+
+namespace DEG {
+
+namespace {
+
+const int DEPSGRAPH_CACHE_MAGIC = 0x44454743; /* 'DEGC' */
+const int DEPSGRAPH_CACHE_VERSION = 1;
+
+/* Upper limit on the length of any serialized string, used as a sanity check
+ * against corrupted or truncated cache files. */
+const int DEPSGRAPH_CACHE_MAX_STRING = 4096;
+
+/* Get file path of the cache which corresponds to the given graph.
+ * Returns false when the graph can not have a cache (file was never saved). */
+bool cache_filepath_get(const Depsgraph *graph, char r_filepath[FILE_MAX])
+{
+  const char *blend_filepath = graph->bmain->name;
+  if (blend_filepath[0] == '\0') {
+    return false;
+  }
+  /* A single .blend file can own multiple dependency graphs (per scene, view
+   * layer and evaluation mode), so all of those are made part of the name. */
+  char suffix[MAX_ID_NAME + MAX_NAME + 32];
+  BLI_snprintf(suffix,
+               sizeof(suffix),
+               "%s-%s-%d.depscache",
+               graph->scene->id.name + 2,
+               graph->view_layer->name,
+               graph->mode);
+  BLI_filename_make_safe(suffix);
+  BLI_snprintf(r_filepath, FILE_MAX, "%s-%s", blend_filepath, suffix);
+  return true;
+}
+
+/* Relation names are expected to point to statically allocated strings, so
+ * names read from the cache are interned in a process-lifetime pool. The set
+ * of names is a small fixed vocabulary coming from the relation builders,
+ * which keeps the pool bounded. */
+const char *relation_name_intern(const string &name)
+{
+  static Map<string, const char *> pool;
+  return pool.lookup_or_add_cb(name, [&]() { return BLI_strdup(name.c_str()); });
+}
+
+void cache_write_int(FILE *f, int value)
+{
+  fwrite(&value, sizeof(int), 1, f);
+}
+
+void cache_write_string(FILE *f, const char *str)
+{
+  const int length = (int)strlen(str);
+  cache_write_int(f, length);
+  fwrite(str, sizeof(char), length, f);
+}
+
+bool cache_read_int(FILE *f, int *r_value)
+{
+  return fread(r_value, sizeof(int), 1, f) == 1;
+}
+
+bool cache_read_string(FILE *f, string *r_value)
+{
+  int length;
+  if (!cache_read_int(f, &length)) {
+    return false;
+  }
+  if (length < 0 || length > DEPSGRAPH_CACHE_MAX_STRING) {
+    return false;
+  }
+  r_value->resize(length);
+  if (length != 0 && fread(&(*r_value)[0], sizeof(char), length, f) != (size_t)length) {
+    return false;
+  }
+  return true;
+}
+
+/* Find original datablock by its full name and library file path. */
+ID *cache_find_id(Main *bmain, const string &name, const string &lib_filepath)
+{
+  if (name.size() < 3) {
+    return nullptr;
+  }
+  ListBase *lb = which_libbase(bmain, GS(name.c_str()));
+  if (lb == nullptr) {
+    return nullptr;
+  }
+  LISTBASE_FOREACH (ID *, id, lb) {
+    if (!STREQ(id->name, name.c_str())) {
+      continue;
+    }
+    if (lib_filepath.empty()) {
+      if (id->lib == nullptr) {
+        return id;
+      }
+    }
+    else if (id->lib != nullptr && STREQ(id->lib->filepath, lib_filepath.c_str())) {
+      return id;
+    }
+  }
+  return nullptr;
+}
+
+struct CachedRelation {
+  int from_index;
+  int to_index;
+  int flag;
+  string name;
+};
+
+bool cache_restore_relations(Depsgraph *graph, FILE *f)
+{
+  int magic, version;
+  if (!cache_read_int(f, &magic) || !cache_read_int(f, &version)) {
+    return false;
+  }
+  if (magic != DEPSGRAPH_CACHE_MAGIC || version != DEPSGRAPH_CACHE_VERSION) {
+    return false;
+  }
+  /* Resolve datablocks. Any mismatch with the freshly built set of ID nodes
+   * invalidates the cache. */
+  int num_ids;
+  if (!cache_read_int(f, &num_ids) || num_ids != (int)graph->id_nodes.size()) {
+    return false;
+  }
+  Vector<IDNode *> id_nodes;
+  id_nodes.reserve(num_ids);
+  for (int i = 0; i < num_ids; i++) {
+    string id_name, lib_filepath;
+    if (!cache_read_string(f, &id_name) || !cache_read_string(f, &lib_filepath)) {
+      return false;
+    }
+    ID *id = cache_find_id(graph->bmain, id_name, lib_filepath);
+    if (id == nullptr) {
+      return false;
+    }
+    IDNode *id_node = graph->find_id_node(id);
+    if (id_node == nullptr) {
+      return false;
+    }
+    id_nodes.append(id_node);
+  }
+  /* Resolve operation nodes. Index 0 is reserved for the time source. */
+  int num_operations;
+  if (!cache_read_int(f, &num_operations) || num_operations != (int)graph->operations.size()) {
+    return false;
+  }
+  Vector<Node *> nodes;
+  nodes.reserve(num_operations + 1);
+  nodes.append(graph->time_source);
+  for (int i = 0; i < num_operations; i++) {
+    int id_index, component_type, opcode, name_tag;
+    string component_name, operation_name;
+    if (!cache_read_int(f, &id_index) || !cache_read_int(f, &component_type) ||
+        !cache_read_string(f, &component_name) || !cache_read_int(f, &opcode) ||
+        !cache_read_string(f, &operation_name) || !cache_read_int(f, &name_tag)) {
+      return false;
+    }
+    if (id_index < 0 || id_index >= num_ids) {
+      return false;
+    }
+    if (component_type < 0 || component_type >= (int)NodeType::NUM_TYPES) {
+      return false;
+    }
+    ComponentNode *comp_node = id_nodes[id_index]->find_component((NodeType)component_type,
+                                                                  component_name.c_str());
+    if (comp_node == nullptr) {
+      return false;
+    }
+    OperationNode *op_node = comp_node->find_operation(
+        (OperationCode)opcode, operation_name.c_str(), name_tag);
+    if (op_node == nullptr) {
+      return false;
+    }
+    nodes.append(op_node);
+  }
+  /* Read all relations before creating any, so a truncated file can not leave
+   * the graph with a partial set of relations. */
+  int num_relations;
+  if (!cache_read_int(f, &num_relations) || num_relations < 0) {
+    return false;
+  }
+  Vector<CachedRelation> relations;
+  relations.reserve(num_relations);
+  for (int i = 0; i < num_relations; i++) {
+    CachedRelation cached;
+    if (!cache_read_int(f, &cached.from_index) || !cache_read_int(f, &cached.to_index) ||
+        !cache_read_int(f, &cached.flag) || !cache_read_string(f, &cached.name)) {
+      return false;
+    }
+    if (cached.from_index < 0 || cached.from_index > num_operations || cached.to_index < 0 ||
+        cached.to_index > num_operations) {
+      return false;
+    }
+    if (nodes[cached.from_index] == nullptr || nodes[cached.to_index] == nullptr) {
+      return false;
+    }
+    relations.append(cached);
+  }
+  /* Everything resolved against the built nodes, re-create the relations. */
+  for (const CachedRelation &cached : relations) {
+    Relation *rel = graph->add_new_relation(
+        nodes[cached.from_index], nodes[cached.to_index], relation_name_intern(cached.name));
+    rel->flag = cached.flag;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool deg_graph_cache_try_restore_relations(Depsgraph *graph)
+{
+  char filepath[FILE_MAX];
+  if (!cache_filepath_get(graph, filepath)) {
+    return false;
+  }
+  if (!BLI_exists(filepath)) {
+    return false;
+  }
+  /* Cache is stale when the .blend file was saved after it was written. */
+  if (BLI_file_older(filepath, graph->bmain->name)) {
+    return false;
+  }
+  FILE *f = BLI_fopen(filepath, "rb");
+  if (f == nullptr) {
+    return false;
+  }
+  const bool ok = cache_restore_relations(graph, f);
+  fclose(f);
+  if (ok && (G.debug & G_DEBUG_DEPSGRAPH_BUILD)) {
+    printf("Depsgraph relations restored from cache %s.\n", filepath);
+  }
+  return ok;
+}
+
+void deg_graph_cache_invalidate(Depsgraph *graph)
+{
+  char filepath[FILE_MAX];
+  if (!cache_filepath_get(graph, filepath)) {
+    return;
+  }
+  if (BLI_exists(filepath)) {
+    BLI_delete(filepath, false, false);
+  }
+}
+
+void deg_graph_cache_write(Depsgraph *graph)
+{
+  char filepath[FILE_MAX];
+  if (!cache_filepath_get(graph, filepath)) {
+    return;
+  }
+  /* Index all nodes which can be a relation endpoint.
+   * Index 0 is reserved for the time source. */
+  Map<const Node *, int> node_index;
+  if (graph->time_source != nullptr) {
+    node_index.add_new(graph->time_source, 0);
+  }
+  int index = 1;
+  for (OperationNode *op_node : graph->operations) {
+    node_index.add_new(op_node, index++);
+  }
+  Map<const ID *, int> id_index;
+  int num_ids = 0;
+  for (IDNode *id_node : graph->id_nodes) {
+    id_index.add_new(id_node->id_orig, num_ids++);
+  }
+  /* Collect relations, following outgoing links only so every relation is
+   * visited once. A relation with an endpoint which is neither an operation
+   * nor the time source can not be serialized, and makes the whole graph
+   * non-cacheable. */
+  Vector<const Relation *> relations;
+  for (OperationNode *op_node : graph->operations) {
+    for (const Relation *rel : op_node->outlinks) {
+      if (!node_index.contains(rel->to)) {
+        BLI_delete(filepath, false, false);
+        return;
+      }
+      relations.append(rel);
+    }
+  }
+  if (graph->time_source != nullptr) {
+    for (const Relation *rel : graph->time_source->outlinks) {
+      if (!node_index.contains(rel->to)) {
+        BLI_delete(filepath, false, false);
+        return;
+      }
+      relations.append(rel);
+    }
+  }
+  FILE *f = BLI_fopen(filepath, "wb");
+  if (f == nullptr) {
+    return;
+  }
+  cache_write_int(f, DEPSGRAPH_CACHE_MAGIC);
+  cache_write_int(f, DEPSGRAPH_CACHE_VERSION);
+  /* Datablocks. */
+  cache_write_int(f, num_ids);
+  for (IDNode *id_node : graph->id_nodes) {
+    const ID *id = id_node->id_orig;
+    cache_write_string(f, id->name);
+    cache_write_string(f, (id->lib != nullptr) ? id->lib->filepath : "");
+  }
+  /* Operation nodes, in the exact order of the graph storage. */
+  cache_write_int(f, (int)graph->operations.size());
+  for (OperationNode *op_node : graph->operations) {
+    const ComponentNode *comp_node = op_node->owner;
+    cache_write_int(f, id_index.lookup(comp_node->owner->id_orig));
+    cache_write_int(f, (int)comp_node->type);
+    cache_write_string(f, comp_node->name.c_str());
+    cache_write_int(f, (int)op_node->opcode);
+    cache_write_string(f, op_node->name.c_str());
+    cache_write_int(f, op_node->name_tag);
+  }
+  /* Relations. */
+  cache_write_int(f, (int)relations.size());
+  for (const Relation *rel : relations) {
+    cache_write_int(f, node_index.lookup(rel->from));
+    cache_write_int(f, node_index.lookup(rel->to));
+    cache_write_int(f, rel->flag);
+    cache_write_string(f, rel->name);
+  }
+  const bool ok = (ferror(f) == 0);
+  fclose(f);
+  if (!ok) {
+    BLI_delete(filepath, false, false);
+  }
+  else if (G.debug & G_DEBUG_DEPSGRAPH_BUILD) {
+    printf("Depsgraph relations cache written to %s.\n", filepath);
+  }
+}
+
+}  // namespace DEG
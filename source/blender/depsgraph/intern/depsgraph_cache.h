@@ -0,0 +1,54 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * On-disk cache for dependency graph relations, stored next to the .blend
+ * file. Allows to skip the relations build step when re-opening a file whose
+ * dependency graph topology did not change.
+ */
+
+#pragma once
+
+namespace DEG {
+
+struct Depsgraph;
+
+/* Attempt to restore relations of the given graph from the on-disk cache.
+ *
+ * Is expected to be called after all nodes were created by the node builder
+ * and before any relation builder runs. Returns true when all relations were
+ * successfully restored, in which case the relations build is to be skipped.
+ * Any validation failure (missing cache, stale cache, mismatch in IDs or
+ * operations) makes this function a no-op which returns false. */
+bool deg_graph_cache_try_restore_relations(Depsgraph *graph);
+
+/* Write relations of the given fully built graph to the on-disk cache.
+ * Failure to write the cache is not an error: the cache file is removed, so a
+ * next file open falls back to a full relations build. */
+void deg_graph_cache_write(Depsgraph *graph);
+
+/* Remove the on-disk cache of the given graph, if any. Called when relations
+ * are tagged for update in-session: such edits can change the relation
+ * topology without changing the node set, which the restore validation can
+ * not detect. */
+void deg_graph_cache_invalidate(Depsgraph *graph);
+
+}  // namespace DEG
@@ -25,13 +25,18 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+
 #include "PIL_time.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
 
+#include "BKE_eval_stats.h"
 #include "BKE_global.h"
 
 #include "DNA_node_types.h"
@@ -43,6 +48,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/eval/deg_eval_copy_on_write.h"
@@ -95,6 +101,9 @@ struct DepsgraphEvalState {
   bool do_stats;
   EvaluationStage stage;
   bool need_single_thread_pass;
+  /* Operations sorted by their evaluation priority, most expensive dependency
+   * chains first. */
+  Vector<OperationNode *> operations_by_priority;
 };
 
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
@@ -103,14 +112,17 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
-  if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+  /* Perform operation. Time is always measured, so the next evaluation can
+   * schedule the most expensive dependency chains first. */
+  const double start_time = PIL_check_seconds_timer();
+  operation_node->evaluate(depsgraph);
+  operation_node->stats.last_time = PIL_check_seconds_timer() - start_time;
+  if (deg_debug_trace_is_enabled()) {
+    deg_debug_trace_record(
+        operation_node, state->graph->ctime, start_time, operation_node->stats.last_time);
   }
-  else {
-    operation_node->evaluate(depsgraph);
+  if (state->do_stats) {
+    operation_node->stats.current_time += operation_node->stats.last_time;
   }
 }
 
@@ -177,6 +189,72 @@ void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
+/* Calculate critical-path priority of every operation: the cost of the longest dependency chain
+ * which starts at the operation, based on the evaluation times recorded during the previous
+ * evaluations. Scheduling expensive chains first keeps worker threads from idling at the end of
+ * the evaluation, waiting for a long chain which was queued behind many cheap operations. */
+void calculate_eval_priorities(Depsgraph *graph)
+{
+  enum {
+    PRIORITY_VISIT_IN_PROGRESS = (1 << 0),
+    PRIORITY_VISIT_DONE = (1 << 1),
+  };
+  /* Fallback cost for operations which have no recorded time yet. */
+  const double default_cost = 1e-6;
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = 0;
+  }
+  /* Iterative depth-first traversal towards the sinks of the graph, so priorities of children are
+   * always known when an operation is finalized. Relations tagged cyclic are skipped, same as
+   * during the scheduling itself. */
+  Vector<OperationNode *> stack;
+  for (OperationNode *root : graph->operations) {
+    if (root->custom_flags & PRIORITY_VISIT_DONE) {
+      continue;
+    }
+    stack.append(root);
+    while (!stack.is_empty()) {
+      OperationNode *node = stack.last();
+      if (node->custom_flags & PRIORITY_VISIT_DONE) {
+        stack.remove_last();
+        continue;
+      }
+      if ((node->custom_flags & PRIORITY_VISIT_IN_PROGRESS) == 0) {
+        node->custom_flags |= PRIORITY_VISIT_IN_PROGRESS;
+        for (Relation *rel : node->outlinks) {
+          if (rel->flag & RELATION_FLAG_CYCLIC) {
+            continue;
+          }
+          OperationNode *child = (OperationNode *)rel->to;
+          if (child->custom_flags & (PRIORITY_VISIT_DONE | PRIORITY_VISIT_IN_PROGRESS)) {
+            continue;
+          }
+          stack.append(child);
+        }
+        continue;
+      }
+      stack.remove_last();
+      double max_child_priority = 0.0;
+      for (Relation *rel : node->outlinks) {
+        if (rel->flag & RELATION_FLAG_CYCLIC) {
+          continue;
+        }
+        OperationNode *child = (OperationNode *)rel->to;
+        if ((child->custom_flags & PRIORITY_VISIT_DONE) == 0) {
+          /* Remnant of a dependency cycle. */
+          continue;
+        }
+        if (child->eval_priority > max_child_priority) {
+          max_child_priority = child->eval_priority;
+        }
+      }
+      const double cost = (node->stats.last_time > 0.0) ? node->stats.last_time : default_cost;
+      node->eval_priority = cost + max_child_priority;
+      node->custom_flags |= PRIORITY_VISIT_DONE;
+    }
+  }
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   const bool do_stats = state->do_stats;
@@ -187,6 +265,15 @@ void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
       node->stats.reset_current();
     }
   }
+  calculate_eval_priorities(graph);
+  /* Build the scheduling order for the initial scheduling passes, so expensive chains enter the
+   * task pool before the cheap operations. */
+  state->operations_by_priority = graph->operations;
+  std::sort(state->operations_by_priority.begin(),
+            state->operations_by_priority.end(),
+            [](const OperationNode *a, const OperationNode *b) {
+              return a->eval_priority > b->eval_priority;
+            });
 }
 
 bool is_metaball_object_operation(const OperationNode *operation_node)
@@ -280,7 +367,7 @@ void schedule_graph(DepsgraphEvalState *state,
                     ScheduleFunction *schedule_function,
                     ScheduleFunctionArgs... schedule_function_args)
 {
-  for (OperationNode *node : state->graph->operations) {
+  for (OperationNode *node : state->operations_by_priority) {
     schedule_node(state, node, false, schedule_function, schedule_function_args...);
   }
 }
@@ -291,18 +378,33 @@ void schedule_children(DepsgraphEvalState *state,
                        ScheduleFunction *schedule_function,
                        ScheduleFunctionArgs... schedule_function_args)
 {
+  /* Children which continue the most expensive dependency chain are scheduled first, so they are
+   * picked up by the workers before their cheaper siblings. */
+  double max_child_priority = 0.0;
   for (Relation *rel : node->outlinks) {
-    OperationNode *child = (OperationNode *)rel->to;
+    const OperationNode *child = (const OperationNode *)rel->to;
     BLI_assert(child->type == NodeType::OPERATION);
-    if (child->scheduled) {
-      /* Happens when having cyclic dependencies. */
-      continue;
+    if (child->eval_priority > max_child_priority) {
+      max_child_priority = child->eval_priority;
+    }
+  }
+  for (int pass = 0; pass < 2; pass++) {
+    for (Relation *rel : node->outlinks) {
+      OperationNode *child = (OperationNode *)rel->to;
+      const bool is_priority_child = (child->eval_priority >= max_child_priority);
+      if (is_priority_child != (pass == 0)) {
+        continue;
+      }
+      if (child->scheduled) {
+        /* Happens when having cyclic dependencies. */
+        continue;
+      }
+      schedule_node(state,
+                    child,
+                    (rel->flag & RELATION_FLAG_CYCLIC) == 0,
+                    schedule_function,
+                    schedule_function_args...);
     }
-    schedule_node(state,
-                  child,
-                  (rel->flag & RELATION_FLAG_CYCLIC) == 0,
-                  schedule_function,
-                  schedule_function_args...);
   }
 }
 
@@ -409,6 +511,14 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  /* With timing debug enabled, dump and reset the named mesh evaluation
+   * statistics, giving one JSON line per depsgraph evaluation. */
+  if (G.debug & G_DEBUG_DEPSGRAPH_TIME) {
+    char *json = BKE_eval_stats_as_json();
+    printf("Mesh evaluation statistics: %s\n", json);
+    MEM_freeN(json);
+    BKE_eval_stats_reset();
+  }
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
   graph->is_evaluating = false;
@@ -278,6 +278,7 @@ Node::Stats::Stats()
 void Node::Stats::reset()
 {
   current_time = 0.0;
+  last_time = 0.0;
 }
 
 void Node::Stats::reset_current()
@@ -160,6 +160,9 @@ struct Node {
     void reset_current();
     /* Time spend on this node during current graph evaluation. */
     double current_time;
+    /* Time spend on this node during its previous evaluation. Always recorded,
+     * used to prioritize scheduling of expensive dependency chains. */
+    double last_time;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
@@ -203,7 +203,7 @@ const char *operationCodeAsString(OperationCode opcode)
   return "UNKNOWN";
 }
 
-OperationNode::OperationNode() : name_tag(-1), flag(0)
+OperationNode::OperationNode() : eval_priority(0.0), name_tag(-1), flag(0)
 {
 }
 
@@ -262,6 +262,11 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Cost of the longest dependency chain which starts at this operation, based
+   * on evaluation times recorded during previous evaluations. Used to schedule
+   * the most expensive chains first. */
+  double eval_priority;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
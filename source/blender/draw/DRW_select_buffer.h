@@ -126,5 +126,6 @@ uint DRW_select_buffer_find_nearest_to_point(struct Depsgraph *depsgraph,
 void DRW_select_buffer_context_create(struct Base **bases,
                                       const uint bases_len,
                                       short select_mode);
+void DRW_select_buffer_free(void);
 
 #endif /* __DRW_SELECT_BUFFER_H__ */
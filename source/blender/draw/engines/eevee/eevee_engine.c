@@ -32,6 +32,7 @@
 
 #include "DNA_world_types.h"
 
+#include "eevee_lightcache.h"
 #include "eevee_private.h"
 
 #include "eevee_engine.h" /* own include */
@@ -382,6 +383,24 @@ static void eevee_id_object_update(void *UNUSED(vedata), Object *object)
   if (oedata != NULL && oedata->dd.recalc != 0) {
     oedata->need_update = true;
     oedata->dd.recalc = 0;
+
+    /* Remember where the change happened, so an incremental light cache bake
+     * can skip probes that cannot see it. */
+    const BoundBox *bb = BKE_object_boundbox_get(object);
+    if (bb != NULL) {
+      const DRWContextState *draw_ctx = DRW_context_state_get();
+      Scene *scene_orig = DEG_get_input_scene(draw_ctx->depsgraph);
+      if (scene_orig->eevee.light_cache_data != NULL) {
+        float bb_min[3], bb_max[3];
+        INIT_MINMAX(bb_min, bb_max);
+        for (int i = 0; i < 8; i++) {
+          float co[3];
+          mul_v3_m4v3(co, object->obmat, bb->vec[i]);
+          minmax_v3v3_v3(bb_min, bb_max, co);
+        }
+        EEVEE_lightcache_dirty_bounds_add(scene_orig->eevee.light_cache_data, bb_min, bb_max);
+      }
+    }
   }
 }
 
@@ -152,6 +152,14 @@ typedef struct EEVEE_LightBake {
   /** Pointer to the owner_id of the probe object. */
   LightProbe **cube_prb;
 
+  /* Incremental baking */
+  /** Probes that need to be re-rendered. The others keep their cached data. */
+  bool *grid_stale;
+  bool *cube_stale;
+  /** Changed object bounds consumed from the scene cache at bake start. Freed
+   * on successful completion, merged back when the bake is canceled. */
+  struct LightCacheDirtyVolumes *dirty_volumes;
+
   /* Dummy Textures */
   struct GPUTexture *dummy_color, *dummy_depth;
   struct GPUTexture *dummy_layer_color;
@@ -180,6 +188,43 @@ typedef struct EEVEE_LightBake {
 /** \name Light Cache
  * \{ */
 
+/* World space bounds of the objects that changed since the last bake. An
+ * incremental bake only re-renders probes whose influence volume intersects
+ * one of them. Runtime only, never saved with the cache. */
+#define DIRTY_VOLUME_MAX 64
+
+typedef struct LightCacheDirtyVolumes {
+  float bounds[DIRTY_VOLUME_MAX][2][3];
+  int len;
+  /** Too many changes accumulated, consider every probe stale. */
+  bool overflow;
+} LightCacheDirtyVolumes;
+
+/* Guards the dirty_volumes pointer: the drawing thread accumulates bounds
+ * while a background bake job may be consuming (or merging back) the list. */
+static ThreadMutex dirty_volumes_mutex = BLI_MUTEX_INITIALIZER;
+
+void EEVEE_lightcache_dirty_bounds_add(LightCache *lcache,
+                                       const float bb_min[3],
+                                       const float bb_max[3])
+{
+  BLI_mutex_lock(&dirty_volumes_mutex);
+  LightCacheDirtyVolumes *volumes = lcache->dirty_volumes;
+  if (volumes == NULL) {
+    volumes = lcache->dirty_volumes = MEM_callocN(sizeof(LightCacheDirtyVolumes),
+                                                  "LightCacheDirtyVolumes");
+  }
+  if (volumes->len == DIRTY_VOLUME_MAX) {
+    volumes->overflow = true;
+  }
+  else {
+    copy_v3_v3(volumes->bounds[volumes->len][0], bb_min);
+    copy_v3_v3(volumes->bounds[volumes->len][1], bb_max);
+    volumes->len++;
+  }
+  BLI_mutex_unlock(&dirty_volumes_mutex);
+}
+
 /* Return memory footprint in bytes. */
 static uint eevee_lightcache_memsize_get(LightCache *lcache)
 {
@@ -473,6 +518,7 @@ void EEVEE_lightcache_free(LightCache *lcache)
 
   MEM_SAFE_FREE(lcache->cube_data);
   MEM_SAFE_FREE(lcache->grid_data);
+  MEM_SAFE_FREE(lcache->dirty_volumes);
   MEM_freeN(lcache);
 }
 
@@ -571,6 +617,8 @@ static void eevee_lightbake_create_resources(EEVEE_LightBake *lbake)
   lbake->ref_cube_res = lbake->rt_res;
   lbake->cube_prb = MEM_callocN(sizeof(LightProbe *) * lbake->cube_len, "EEVEE Cube visgroup ptr");
   lbake->grid_prb = MEM_callocN(sizeof(LightProbe *) * lbake->grid_len, "EEVEE Grid visgroup ptr");
+  lbake->cube_stale = MEM_callocN(sizeof(bool) * lbake->cube_len, "EEVEE Cube stale flag");
+  lbake->grid_stale = MEM_callocN(sizeof(bool) * lbake->grid_len, "EEVEE Grid stale flag");
 
   lbake->grid_prev = DRW_texture_create_2d_array(lbake->irr_size[0],
                                                  lbake->irr_size[1],
@@ -716,6 +764,9 @@ void EEVEE_lightbake_job_data_free(void *custom_data)
 
   MEM_SAFE_FREE(lbake->cube_prb);
   MEM_SAFE_FREE(lbake->grid_prb);
+  MEM_SAFE_FREE(lbake->cube_stale);
+  MEM_SAFE_FREE(lbake->grid_stale);
+  MEM_SAFE_FREE(lbake->dirty_volumes);
 
   BLI_mutex_free(lbake->mutex);
 
@@ -1155,12 +1206,163 @@ static bool eevee_lightbake_cube_comp(EEVEE_LightProbe *prb_a, EEVEE_LightProbe
   } \
   ((void)0)
 
+static bool eevee_lightbake_dirty_volumes_overlap(const LightCacheDirtyVolumes *volumes,
+                                                  const float bb_min[3],
+                                                  const float bb_max[3])
+{
+  for (int i = 0; i < volumes->len; i++) {
+    if (isect_aabb_aabb_v3(bb_min, bb_max, volumes->bounds[i][0], volumes->bounds[i][1])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void eevee_lightbake_grid_bounds_get(const EEVEE_LightGrid *egrid,
+                                            float r_min[3],
+                                            float r_max[3])
+{
+  INIT_MINMAX(r_min, r_max);
+  for (int i = 0; i < 8; i++) {
+    float co[3];
+    copy_v3_v3(co, egrid->corner);
+    madd_v3_v3fl(co, egrid->increment_x, (i & 1) ? (egrid->resolution[0] - 1) : 0);
+    madd_v3_v3fl(co, egrid->increment_y, (i & 2) ? (egrid->resolution[1] - 1) : 0);
+    madd_v3_v3fl(co, egrid->increment_z, (i & 4) ? (egrid->resolution[2] - 1) : 0);
+    minmax_v3v3_v3(r_min, r_max, co);
+  }
+  /* The attenuation extends the influence outside of the sampled region
+   * (attenuation_scale = (1 / falloff) / distinf, attenuation_bias = 1 / falloff). */
+  const float fade_dist = egrid->attenuation_bias / max_ff(1e-8f, egrid->attenuation_scale);
+  for (int i = 0; i < 3; i++) {
+    r_min[i] -= fade_dist;
+    r_max[i] += fade_dist;
+  }
+}
+
+static void eevee_lightbake_cube_bounds_get(const EEVEE_LightProbe *eprb,
+                                            float r_min[3],
+                                            float r_max[3])
+{
+  /* attenuationmat maps world space to the unit influence volume. */
+  float imat[4][4];
+  invert_m4_m4(imat, eprb->attenuationmat);
+  INIT_MINMAX(r_min, r_max);
+  for (int i = 0; i < 8; i++) {
+    float co[3] = {(i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f};
+    mul_m4_v3(imat, co);
+    minmax_v3v3_v3(r_min, r_max, co);
+  }
+}
+
+/* Decide which probes actually need re-rendering. A probe is stale when its own
+ * data changed (transform, resolution, sample offset, ...) or when its influence
+ * volume intersects the bounds of an object that changed since the last bake. */
+static void eevee_lightbake_check_stale_probes(EEVEE_LightBake *lbake,
+                                               const EEVEE_LightGrid *grid_data_prev,
+                                               const EEVEE_LightProbe *cube_data_prev)
+{
+  Scene *scene_orig = DEG_get_input_scene(lbake->depsgraph);
+  LightCache *lcache = lbake->lcache;
+
+  /* Consume the changed object bounds accumulated on the original scene cache. */
+  LightCacheDirtyVolumes *volumes = NULL;
+  if (scene_orig->eevee.light_cache_data != NULL) {
+    BLI_mutex_lock(&dirty_volumes_mutex);
+    volumes = scene_orig->eevee.light_cache_data->dirty_volumes;
+    scene_orig->eevee.light_cache_data->dirty_volumes = NULL;
+    BLI_mutex_unlock(&dirty_volumes_mutex);
+  }
+
+  /* A world update re-renders the whole irradiance pool (see
+   * eevee_lightbake_render_world_sample), so everything is stale then. */
+  const bool all_stale = (lcache->flag & LIGHTCACHE_INCREMENTAL) == 0 ||
+                         (lcache->flag & LIGHTCACHE_UPDATE_WORLD) != 0 ||
+                         lbake->own_light_cache || (volumes && volumes->overflow);
+  lcache->flag &= ~LIGHTCACHE_INCREMENTAL;
+
+  /* World probes. */
+  lbake->grid_stale[0] = true;
+  lbake->cube_stale[0] = true;
+
+  for (int i = 1; i < lbake->grid_len; i++) {
+    bool stale = all_stale || (grid_data_prev == NULL) ||
+                 (memcmp(&grid_data_prev[i], &lcache->grid_data[i], sizeof(EEVEE_LightGrid)) != 0);
+    if (!stale && volumes != NULL) {
+      float bb_min[3], bb_max[3];
+      eevee_lightbake_grid_bounds_get(&lcache->grid_data[i], bb_min, bb_max);
+      stale = eevee_lightbake_dirty_volumes_overlap(volumes, bb_min, bb_max);
+    }
+    lbake->grid_stale[i] = stale;
+  }
+
+  for (int i = 1; i < lbake->cube_len; i++) {
+    bool stale = all_stale || (cube_data_prev == NULL) ||
+                 (memcmp(&cube_data_prev[i], &lcache->cube_data[i], sizeof(EEVEE_LightProbe)) !=
+                  0);
+    if (!stale && volumes != NULL) {
+      float bb_min[3], bb_max[3];
+      eevee_lightbake_cube_bounds_get(&lcache->cube_data[i], bb_min, bb_max);
+      stale = eevee_lightbake_dirty_volumes_overlap(volumes, bb_min, bb_max);
+    }
+    lbake->cube_stale[i] = stale;
+  }
+
+  /* Keep the consumed bounds around until the bake finishes: a canceled bake
+   * has to merge them back so the next one still sees the probes as stale. */
+  lbake->dirty_volumes = volumes;
+}
+
+static void eevee_lightbake_dirty_volumes_restore(EEVEE_LightBake *lbake)
+{
+  LightCacheDirtyVolumes *volumes = lbake->dirty_volumes;
+  if (volumes == NULL) {
+    return;
+  }
+  lbake->dirty_volumes = NULL;
+
+  LightCache *lcache = lbake->scene->eevee.light_cache_data;
+  if (lcache == NULL) {
+    MEM_freeN(volumes);
+    return;
+  }
+
+  BLI_mutex_lock(&dirty_volumes_mutex);
+  if (lcache->dirty_volumes == NULL) {
+    lcache->dirty_volumes = volumes;
+    volumes = NULL;
+  }
+  else {
+    /* Bounds were added while the bake was running, merge into those. */
+    LightCacheDirtyVolumes *dst = lcache->dirty_volumes;
+    dst->overflow |= volumes->overflow;
+    for (int i = 0; i < volumes->len; i++) {
+      if (dst->len == DIRTY_VOLUME_MAX) {
+        dst->overflow = true;
+        break;
+      }
+      copy_v3_v3(dst->bounds[dst->len][0], volumes->bounds[i][0]);
+      copy_v3_v3(dst->bounds[dst->len][1], volumes->bounds[i][1]);
+      dst->len++;
+    }
+  }
+  BLI_mutex_unlock(&dirty_volumes_mutex);
+
+  if (volumes != NULL) {
+    MEM_freeN(volumes);
+  }
+}
+
 static void eevee_lightbake_gather_probes(EEVEE_LightBake *lbake)
 {
   Depsgraph *depsgraph = lbake->depsgraph;
   Scene *scene_eval = DEG_get_evaluated_scene(depsgraph);
   LightCache *lcache = scene_eval->eevee.light_cache_data;
 
+  /* Snapshot the previous probe data to detect which probes changed. */
+  EEVEE_LightGrid *grid_data_prev = MEM_dupallocN(lcache->grid_data);
+  EEVEE_LightProbe *cube_data_prev = MEM_dupallocN(lcache->cube_data);
+
   /* At least one for the world */
   int grid_len = 1;
   int cube_len = 1;
@@ -1202,6 +1404,11 @@ static void eevee_lightbake_gather_probes(EEVEE_LightBake *lbake)
              lbake->cube_len - 1,
              eevee_lightbake_cube_comp);
 
+  eevee_lightbake_check_stale_probes(lbake, grid_data_prev, cube_data_prev);
+
+  MEM_SAFE_FREE(grid_data_prev);
+  MEM_SAFE_FREE(cube_data_prev);
+
   lbake->total = lbake->total_irr_samples * lbake->bounce_len + lbake->cube_len;
   lbake->done = 0;
 }
@@ -1304,11 +1511,26 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
         LightProbe *prb = *lbake->probe;
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
+        if (!lbake->grid_stale[lbake->grid_curr]) {
+          /* Cached data is still valid, only account for the skipped samples. */
+          lbake->done += lbake->grid_sample_len;
+          *lbake->progress = lbake->done / (float)lbake->total;
+          *lbake->do_update = 1;
+          continue;
+        }
         for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
              ++lbake->grid_sample) {
           lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
         }
       }
+      if (lbake->grid_len > 1 && !lbake->grid_stale[lbake->grid_len - 1]) {
+        /* eevee_lightbake_render_grid_sample only copies the bounce result with
+         * the last sample of the last grid. Do it here when that grid was
+         * skipped, so the next bounce reads up to date irradiance. */
+        eevee_lightbake_context_enable(lbake);
+        eevee_lightbake_copy_irradiance(lbake, lcache);
+        eevee_lightbake_context_disable(lbake);
+      }
     }
   }
 
@@ -1319,10 +1541,29 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
+      if (!lbake->cube_stale[lbake->cube_offset]) {
+        /* Cached cubemap is still valid. */
+        lcache->cube_len += 1;
+        lbake->done += 1;
+        *lbake->progress = lbake->done / (float)lbake->total;
+        *lbake->do_update = 1;
+        continue;
+      }
       lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
     }
   }
 
+  if (!G.is_break && *lbake->stop == 0) {
+    /* The per-sample callbacks clear these flags with the last probe, which
+     * does not happen when an incremental bake skips it. */
+    lcache->flag &= ~(LIGHTCACHE_UPDATE_GRID | LIGHTCACHE_UPDATE_CUBE);
+    /* Every stale probe was re-rendered, the consumed bounds are handled. */
+    MEM_SAFE_FREE(lbake->dirty_volumes);
+  }
+  else {
+    eevee_lightbake_dirty_volumes_restore(lbake);
+  }
+
   /* Read the resulting lighting data to save it to file/disk. */
   eevee_lightbake_context_enable(lbake);
   eevee_lightbake_readback_irradiance(lcache);
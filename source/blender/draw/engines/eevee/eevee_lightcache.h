@@ -62,5 +62,8 @@ struct LightCache *EEVEE_lightcache_create(const int grid_len,
 void EEVEE_lightcache_free(struct LightCache *lcache);
 bool EEVEE_lightcache_load(struct LightCache *lcache);
 void EEVEE_lightcache_info_update(struct SceneEEVEE *eevee);
+void EEVEE_lightcache_dirty_bounds_add(struct LightCache *lcache,
+                                       const float bb_min[3],
+                                       const float bb_max[3]);
 
 #endif /* __EEVEE_LIGHTCACHE_H__ */
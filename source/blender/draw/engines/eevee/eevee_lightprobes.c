@@ -761,8 +761,9 @@ void EEVEE_lightprobes_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *ved
         /* If we update grid we need to update the cube-maps too.
          * So always refresh cube-maps. */
         scene_orig->eevee.light_cache_data->flag |= LIGHTCACHE_UPDATE_CUBE;
-        /* Tag the lightcache to auto update. */
-        scene_orig->eevee.light_cache_data->flag |= LIGHTCACHE_UPDATE_AUTO;
+        /* Tag the lightcache to auto update, only rebaking stale probes. */
+        scene_orig->eevee.light_cache_data->flag |= LIGHTCACHE_UPDATE_AUTO |
+                                                    LIGHTCACHE_INCREMENTAL;
         /* Use a notifier to trigger the operator after drawing. */
         WM_event_add_notifier(draw_ctx->evil_C, NC_LIGHTPROBE, scene_orig);
       }
@@ -953,6 +953,12 @@ void EEVEE_materials_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedat
 
   BLI_ghash_free(pd->material_hash, NULL, NULL);
 
+  /* Opaque passes are order independent (depth tested), so group shading groups
+   * by shader to avoid redundant program & uniform binds on material heavy scenes. */
+  DRW_pass_sort_shgroup_shader(vedata->psl->material_ps);
+  DRW_pass_sort_shgroup_shader(vedata->psl->material_cull_ps);
+  DRW_pass_sort_shgroup_shader(vedata->psl->material_refract_ps);
+
   SET_FLAG_FROM_TEST(effects->enabled_effects, effects->sss_surface_count > 0, EFFECT_SSS);
 
   /* TODO(fclem) this is not really clean. Init should not be done in cache finish. */
@@ -589,6 +589,7 @@ typedef struct EEVEE_EffectsInfo {
   struct GPUTexture *sss_stencil;
   /* Volumetrics */
   int volume_current_sample;
+  bool volume_converged;
   struct GPUTexture *volume_scatter;
   struct GPUTexture *volume_transmit;
   /* SSR */
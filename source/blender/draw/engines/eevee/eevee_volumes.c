@@ -225,23 +225,42 @@ void EEVEE_volumes_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 
   /* Temporal Super sampling jitter */
   uint ht_primes[3] = {3, 7, 2};
+  const uint max_sample = (ht_primes[0] * ht_primes[1] * ht_primes[2]);
   uint current_sample = 0;
 
-  /* If TAA is in use do not use the history buffer. */
+  /* If TAA is in use the history buffer is used differently, see below. */
   bool do_taa = ((effects->enabled_effects & EFFECT_TAA) != 0);
 
+  effects->volume_converged = false;
+
   if (draw_ctx->evil_C != NULL) {
     struct wmWindowManager *wm = CTX_wm_manager(draw_ctx->evil_C);
     do_taa = do_taa && (ED_screen_animation_no_scrub(wm) == NULL);
   }
 
   if (do_taa) {
-    common_data->vol_history_alpha = 0.0f;
     current_sample = effects->taa_current_sample - 1;
     effects->volume_current_sample = -1;
+    if (DRW_state_is_image_render()) {
+      /* Each render sample stands on its own: do not use the history buffer. */
+      common_data->vol_history_alpha = 0.0f;
+    }
+    else {
+      /* During viewport TAA accumulation, blend the jittered froxel samples into a running
+       * average (weight n/(n+1) for the history at sample n) instead of discarding the history:
+       * the scattering/transmittance buffers then converge to the mean over the jitter cycle.
+       * Once TAA has accumulated a full cycle (the same count the image render path uses), that
+       * averaged result no longer changes and is reused instead of being recomputed. Any scene
+       * or camera change restarts TAA, which invalidates both the average and the reuse. */
+      common_data->vol_history_alpha = (txl->volume_prop_scattering == NULL) ?
+                                           0.0f :
+                                           (float)current_sample / (float)(current_sample + 1);
+      if (current_sample >= max_sample && txl->volume_scatter != NULL) {
+        effects->volume_converged = true;
+      }
+    }
   }
   else if (DRW_state_is_image_render()) {
-    const uint max_sample = (ht_primes[0] * ht_primes[1] * ht_primes[2]);
     current_sample = effects->volume_current_sample = (effects->volume_current_sample + 1) %
                                                       max_sample;
     if (current_sample != max_sample - 1) {
@@ -763,6 +782,13 @@ void EEVEE_volumes_compute(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   EEVEE_StorageList *stl = vedata->stl;
   EEVEE_EffectsInfo *effects = stl->effects;
   if ((effects->enabled_effects & EFFECT_VOLUMETRIC) != 0) {
+    if (effects->volume_converged) {
+      /* The accumulated result no longer changes: resolve with the last computed froxels. */
+      effects->volume_scatter = txl->volume_scatter;
+      effects->volume_transmit = txl->volume_transmit;
+      return;
+    }
+
     DRW_stats_group_start("Volumetrics");
 
     /* We sample the shadow-maps using shadow sampler. We need to enable Comparison mode.
@@ -512,17 +512,32 @@ static void drw_shgroup_bone_envelope(ArmatureDrawContext *ctx,
 extern void drw_batch_cache_validate(Object *custom);
 extern void drw_batch_cache_generate_requested(Object *custom);
 
-BLI_INLINE DRWCallBuffer *custom_bone_instance_shgroup(ArmatureDrawContext *ctx,
-                                                       DRWShadingGroup *grp,
-                                                       struct GPUBatch *custom_geom)
+/**
+ * Instance buffers for one custom shape object, resolved lazily.
+ * Heavy rigs instance the same shape on hundreds of bones, so the batch cache
+ * validation / requests must only run once per shape object and per frame.
+ */
+typedef struct CustomShapeBuffers {
+  /* Solid (surface / edge detection / loose edges) batches resolved. */
+  bool geom_resolved;
+  /* Wire drawtype (all edges) batch resolved. */
+  bool wire_resolved;
+
+  struct GPUBatch *surf;
+  DRWCallBuffer *solid_buf;
+  DRWCallBuffer *outline_buf;
+  DRWCallBuffer *loose_wire_buf;
+  DRWCallBuffer *all_wire_buf;
+} CustomShapeBuffers;
+
+BLI_INLINE CustomShapeBuffers *custom_bone_shape_buffers_get(ArmatureDrawContext *ctx,
+                                                             Object *custom)
 {
-  DRWCallBuffer *buf = BLI_ghash_lookup(ctx->custom_shapes_ghash, custom_geom);
-  if (buf == NULL) {
-    OVERLAY_InstanceFormats *formats = OVERLAY_shader_instance_formats_get();
-    buf = DRW_shgroup_call_buffer_instance(grp, formats->instance_bone, custom_geom);
-    BLI_ghash_insert(ctx->custom_shapes_ghash, custom_geom, buf);
+  void **val_p;
+  if (!BLI_ghash_ensure_p(ctx->custom_shapes_ghash, custom, &val_p)) {
+    *val_p = MEM_callocN(sizeof(CustomShapeBuffers), __func__);
   }
-  return buf;
+  return *val_p;
 }
 
 static void drw_shgroup_bone_custom_solid(ArmatureDrawContext *ctx,
@@ -532,42 +547,58 @@ static void drw_shgroup_bone_custom_solid(ArmatureDrawContext *ctx,
                                           const float outline_color[4],
                                           Object *custom)
 {
-  /* TODO(fclem) arg... less than ideal but we never iter on this object
-   * to assure batch cache is valid. */
-  drw_batch_cache_validate(custom);
-
-  struct GPUBatch *surf = DRW_cache_object_surface_get(custom);
-  struct GPUBatch *edges = DRW_cache_object_edge_detection_get(custom, NULL);
-  struct GPUBatch *ledges = DRW_cache_object_loose_edges_get(custom);
+  CustomShapeBuffers *cbufs = custom_bone_shape_buffers_get(ctx, custom);
   BoneInstanceData inst_data;
-  DRWCallBuffer *buf;
 
-  if (surf || edges || ledges) {
+  if (!cbufs->geom_resolved) {
+    /* TODO(fclem) arg... less than ideal but we never iter on this object
+     * to assure batch cache is valid. */
+    drw_batch_cache_validate(custom);
+
+    OVERLAY_InstanceFormats *formats = OVERLAY_shader_instance_formats_get();
+    struct GPUBatch *edges = DRW_cache_object_edge_detection_get(custom, NULL);
+    struct GPUBatch *ledges = DRW_cache_object_loose_edges_get(custom);
+    cbufs->surf = DRW_cache_object_surface_get(custom);
+    if (edges && ctx->custom_outline) {
+      cbufs->outline_buf = DRW_shgroup_call_buffer_instance(
+          ctx->custom_outline, formats->instance_bone, edges);
+    }
+    if (ledges) {
+      cbufs->loose_wire_buf = DRW_shgroup_call_buffer_instance(
+          ctx->custom_wire, formats->instance_bone, ledges);
+    }
+    cbufs->geom_resolved = true;
+
+    /* TODO(fclem) needs to be moved elsewhere. */
+    drw_batch_cache_generate_requested(custom);
+  }
+
+  if (cbufs->surf || cbufs->outline_buf || cbufs->loose_wire_buf) {
     mul_m4_m4m4(inst_data.mat, ctx->ob->obmat, bone_mat);
   }
 
-  if (surf && ctx->custom_solid) {
-    buf = custom_bone_instance_shgroup(ctx, ctx->custom_solid, surf);
+  if (cbufs->surf && ctx->custom_solid) {
+    /* Shading group can differ between contexts, create the buffer on first use. */
+    if (cbufs->solid_buf == NULL) {
+      OVERLAY_InstanceFormats *formats = OVERLAY_shader_instance_formats_get();
+      cbufs->solid_buf = DRW_shgroup_call_buffer_instance(
+          ctx->custom_solid, formats->instance_bone, cbufs->surf);
+    }
     OVERLAY_bone_instance_data_set_color_hint(&inst_data, hint_color);
     OVERLAY_bone_instance_data_set_color(&inst_data, bone_color);
-    DRW_buffer_add_entry_struct(buf, inst_data.mat);
+    DRW_buffer_add_entry_struct(cbufs->solid_buf, inst_data.mat);
   }
 
-  if (edges && ctx->custom_outline) {
-    buf = custom_bone_instance_shgroup(ctx, ctx->custom_outline, edges);
+  if (cbufs->outline_buf) {
     OVERLAY_bone_instance_data_set_color(&inst_data, outline_color);
-    DRW_buffer_add_entry_struct(buf, inst_data.mat);
+    DRW_buffer_add_entry_struct(cbufs->outline_buf, inst_data.mat);
   }
 
-  if (ledges) {
-    buf = custom_bone_instance_shgroup(ctx, ctx->custom_wire, ledges);
+  if (cbufs->loose_wire_buf) {
     OVERLAY_bone_instance_data_set_color_hint(&inst_data, outline_color);
     OVERLAY_bone_instance_data_set_color(&inst_data, outline_color);
-    DRW_buffer_add_entry_struct(buf, inst_data.mat);
+    DRW_buffer_add_entry_struct(cbufs->loose_wire_buf, inst_data.mat);
   }
-
-  /* TODO(fclem) needs to be moved elsewhere. */
-  drw_batch_cache_generate_requested(custom);
 }
 
 static void drw_shgroup_bone_custom_wire(ArmatureDrawContext *ctx,
@@ -575,23 +606,32 @@ static void drw_shgroup_bone_custom_wire(ArmatureDrawContext *ctx,
                                          const float color[4],
                                          Object *custom)
 {
-  /* TODO(fclem) arg... less than ideal but we never iter on this object
-   * to assure batch cache is valid. */
-  drw_batch_cache_validate(custom);
+  CustomShapeBuffers *cbufs = custom_bone_shape_buffers_get(ctx, custom);
+
+  if (!cbufs->wire_resolved) {
+    /* TODO(fclem) arg... less than ideal but we never iter on this object
+     * to assure batch cache is valid. */
+    drw_batch_cache_validate(custom);
+
+    struct GPUBatch *geom = DRW_cache_object_all_edges_get(custom);
+    if (geom) {
+      OVERLAY_InstanceFormats *formats = OVERLAY_shader_instance_formats_get();
+      cbufs->all_wire_buf = DRW_shgroup_call_buffer_instance(
+          ctx->custom_wire, formats->instance_bone, geom);
+    }
+    cbufs->wire_resolved = true;
 
-  struct GPUBatch *geom = DRW_cache_object_all_edges_get(custom);
+    /* TODO(fclem) needs to be moved elsewhere. */
+    drw_batch_cache_generate_requested(custom);
+  }
 
-  if (geom) {
-    DRWCallBuffer *buf = custom_bone_instance_shgroup(ctx, ctx->custom_wire, geom);
+  if (cbufs->all_wire_buf) {
     BoneInstanceData inst_data;
     mul_m4_m4m4(inst_data.mat, ctx->ob->obmat, bone_mat);
     OVERLAY_bone_instance_data_set_color_hint(&inst_data, color);
     OVERLAY_bone_instance_data_set_color(&inst_data, color);
-    DRW_buffer_add_entry_struct(buf, inst_data.mat);
+    DRW_buffer_add_entry_struct(cbufs->all_wire_buf, inst_data.mat);
   }
-
-  /* TODO(fclem) needs to be moved elsewhere. */
-  drw_batch_cache_generate_requested(custom);
 }
 
 static void drw_shgroup_bone_custom_empty(ArmatureDrawContext *ctx,
@@ -2247,8 +2287,8 @@ void OVERLAY_armature_cache_finish(OVERLAY_Data *vedata)
   for (int i = 0; i < 2; i++) {
     if (pd->armature_call_buffers[i].custom_shapes_ghash) {
       /* TODO(fclem): Do not free it for each frame but reuse it. Avoiding alloc cost. */
-      BLI_ghash_free(pd->armature_call_buffers[i].custom_shapes_ghash, NULL, NULL);
-      BLI_ghash_free(pd->armature_call_buffers[i].custom_shapes_transp_ghash, NULL, NULL);
+      BLI_ghash_free(pd->armature_call_buffers[i].custom_shapes_ghash, NULL, MEM_freeN);
+      BLI_ghash_free(pd->armature_call_buffers[i].custom_shapes_transp_ghash, NULL, MEM_freeN);
     }
   }
 }
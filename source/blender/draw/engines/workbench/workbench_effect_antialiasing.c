@@ -29,6 +29,15 @@
  *
  * This is done using an accumulation buffer and a final pass that will output the final color
  * to the scene buffer. We softly blend between SMAA and TAA to avoid really harsh transitions.
+ *
+ * Early convergence detection was considered and rejected: each TAA step re-renders the whole
+ * scene under a jittered projection, so converged regions cannot be masked out with scissors
+ * without also skipping the geometry pass they depend on, and the per-step accumulation blit
+ * that could be masked is negligible next to that scene render. Detecting convergence of the
+ * accumulation buffer itself would need a GPU read-back and stall every step. The cheap exits
+ * already exist: rendering stops once the sample count is reached (#workbench_antialiasing_setup
+ * returns false), and the SMAA passes are skipped after the first few samples once the
+ * accumulation is smooth enough (see `smaa_mix_factor`).
  */
 
 #include "ED_screen.h"
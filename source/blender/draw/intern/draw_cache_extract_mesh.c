@@ -4531,8 +4531,61 @@ static const MeshExtract extract_fdot_idx = {
  * \{ */
 typedef struct ExtractUserData {
   void *user_data;
+#ifdef DEBUG_TIME
+  /** Wall time spent in init/iteration/finish of this extractor, summed over
+   * all of its chunk tasks (they may run on multiple threads). */
+  float time;
+#endif
 } ExtractUserData;
 
+#ifdef DEBUG_TIME
+static const char *mesh_extract_name_get(const MeshExtract *extract)
+{
+#  define EXTRACT_NAME(name) \
+    if (extract == &extract_##name) { \
+      return #name; \
+    } \
+    ((void)0)
+  EXTRACT_NAME(pos_nor);
+  EXTRACT_NAME(lnor);
+  EXTRACT_NAME(lnor_hq);
+  EXTRACT_NAME(uv);
+  EXTRACT_NAME(tan);
+  EXTRACT_NAME(tan_hq);
+  EXTRACT_NAME(vcol);
+  EXTRACT_NAME(orco);
+  EXTRACT_NAME(edge_fac);
+  EXTRACT_NAME(weights);
+  EXTRACT_NAME(edit_data);
+  EXTRACT_NAME(edituv_data);
+  EXTRACT_NAME(stretch_area);
+  EXTRACT_NAME(stretch_angle);
+  EXTRACT_NAME(mesh_analysis);
+  EXTRACT_NAME(fdots_pos);
+  EXTRACT_NAME(fdots_nor);
+  EXTRACT_NAME(fdots_uv);
+  EXTRACT_NAME(fdots_edituv_data);
+  EXTRACT_NAME(poly_idx);
+  EXTRACT_NAME(edge_idx);
+  EXTRACT_NAME(vert_idx);
+  EXTRACT_NAME(fdot_idx);
+  EXTRACT_NAME(skin_roots);
+  EXTRACT_NAME(tris);
+  EXTRACT_NAME(lines);
+  EXTRACT_NAME(lines_with_lines_loose);
+  EXTRACT_NAME(points);
+  EXTRACT_NAME(fdots);
+  EXTRACT_NAME(lines_paint_mask);
+  EXTRACT_NAME(lines_adjacency);
+  EXTRACT_NAME(edituv_tris);
+  EXTRACT_NAME(edituv_lines);
+  EXTRACT_NAME(edituv_points);
+  EXTRACT_NAME(edituv_fdots);
+#  undef EXTRACT_NAME
+  return "unknown";
+}
+#endif
+
 typedef struct ExtractTaskData {
   void *next, *prev;
   const MeshRenderData *mr;
@@ -4630,12 +4683,25 @@ BLI_INLINE void mesh_extract_iter(const MeshRenderData *mr,
 
 static void extract_init(ExtractTaskData *data)
 {
+#ifdef DEBUG_TIME
+  const double start_time = PIL_check_seconds_timer();
+#endif
+
   data->user_data->user_data = data->extract->init(data->mr, data->buf);
+
+#ifdef DEBUG_TIME
+  atomic_add_and_fetch_fl(&data->user_data->time,
+                          (float)(PIL_check_seconds_timer() - start_time));
+#endif
 }
 
 static void extract_run(void *__restrict taskdata)
 {
   ExtractTaskData *data = (ExtractTaskData *)taskdata;
+#ifdef DEBUG_TIME
+  const double start_time = PIL_check_seconds_timer();
+#endif
+
   mesh_extract_iter(data->mr,
                     data->iter_type,
                     data->start,
@@ -4643,11 +4709,28 @@ static void extract_run(void *__restrict taskdata)
                     data->extract,
                     data->user_data->user_data);
 
+#ifdef DEBUG_TIME
+  /* Accumulate before the counter decrement, so the last task to finish sees
+   * the contributions of all the other chunk tasks. */
+  atomic_add_and_fetch_fl(&data->user_data->time,
+                          (float)(PIL_check_seconds_timer() - start_time));
+  const double finish_start_time = PIL_check_seconds_timer();
+#endif
+
   /* If this is the last task, we do the finish function. */
   int remainin_tasks = atomic_sub_and_fetch_int32(data->task_counter, 1);
   if (remainin_tasks == 0 && data->extract->finish != NULL) {
     data->extract->finish(data->mr, data->buf, data->user_data->user_data);
   }
+
+#ifdef DEBUG_TIME
+  if (remainin_tasks == 0) {
+    /* All chunk tasks of this extractor are done, report its total cost. */
+    const float time = atomic_add_and_fetch_fl(
+        &data->user_data->time, (float)(PIL_check_seconds_timer() - finish_start_time));
+    printf("  extract %-22s %6.2fms\n", mesh_extract_name_get(data->extract), time * 1000.0f);
+  }
+#endif
 }
 
 static void extract_init_and_run(void *__restrict taskdata)
@@ -33,6 +33,7 @@
 #include "DNA_particle_types.h"
 
 #include "BKE_duplilist.h"
+#include "BKE_object.h"
 
 #include "GPU_batch.h"
 #include "GPU_shader.h"
@@ -124,6 +125,57 @@ void DRW_hair_init(void)
   }
 }
 
+/**
+ * Screen space level of detail: drop subdivision levels for hair systems that
+ * cover few pixels. Each subdivision level doubles the segment count, so one
+ * level is dropped each time the projected size of the emitter halves below
+ * the threshold. All levels are cached in #ParticleHairCache.final, switching
+ * between them only re-runs the refine pass on first use.
+ */
+static int hair_subdiv_lod_level(const Object *object, int subdiv)
+{
+  /* Do not degrade final renders. */
+  if (subdiv <= 0 || DRW_state_is_image_render()) {
+    return subdiv;
+  }
+  const BoundBox *bb = BKE_object_boundbox_get((Object *)object);
+  if (bb == NULL) {
+    return subdiv;
+  }
+  /* Bounding sphere of the emitter in world space. Hairs can extend further
+   * out, so this is only a rough estimate of the on-screen density. */
+  float center[3], corner[3];
+  mid_v3_v3v3(center, bb->vec[0], bb->vec[6]);
+  mul_m4_v3(object->obmat, center);
+  mul_v3_m4v3(corner, object->obmat, bb->vec[6]);
+  const float radius = len_v3v3(center, corner);
+
+  float persmat[4][4], viewinv[4][4];
+  DRW_view_persmat_get(NULL, persmat, false);
+  DRW_view_viewmat_get(NULL, viewinv, true);
+
+  /* Keep full quality near or behind the near plane. */
+  const float w = mul_project_m4_v3_zfac(persmat, center);
+  if (w < 1e-8f) {
+    return subdiv;
+  }
+
+  /* Project the sphere extremes to get its radius in pixels. */
+  float p1[3], p2[3];
+  copy_v3_v3(p1, center);
+  madd_v3_v3v3fl(p2, center, viewinv[0], radius);
+  mul_project_m4_v3(persmat, p1);
+  mul_project_m4_v3(persmat, p2);
+  float diameter_px = len_v2v2(p1, p2) * DRW_viewport_size_get()[0];
+
+  const float subdiv_limit_px = 256.0f;
+  while (subdiv > 0 && diameter_px < subdiv_limit_px) {
+    subdiv--;
+    diameter_px *= 2.0f;
+  }
+  return subdiv;
+}
+
 DRWShadingGroup *DRW_shgroup_hair_create_sub(Object *object,
                                              ParticleSystem *psys,
                                              ModifierData *md,
@@ -136,7 +188,7 @@ DRWShadingGroup *DRW_shgroup_hair_create_sub(Object *object,
   Object *dupli_parent = DRW_object_get_dupli_parent(object);
   DupliObject *dupli_object = DRW_object_get_dupli(object);
 
-  int subdiv = scene->r.hair_subdiv;
+  int subdiv = hair_subdiv_lod_level(object, scene->r.hair_subdiv);
   int thickness_res = (scene->r.hair_type == SCE_HAIR_SHAPE_STRAND) ? 1 : 2;
 
   ParticleHairCache *hair_cache;
@@ -2706,6 +2706,7 @@ void DRW_engines_free(void)
   GPU_FRAMEBUFFER_FREE_SAFE(g_select_buffer.framebuffer_depth_only);
 
   DRW_hair_free();
+  DRW_select_buffer_free();
   DRW_shape_cache_free();
   DRW_stats_free();
   DRW_globals_free();
@@ -2039,6 +2039,55 @@ void DRW_pass_sort_shgroup_z(DRWPass *pass)
   pass->shgroups.last = last;
 }
 
+static int pass_shgroup_shader_sort(const void *a, const void *b)
+{
+  const DRWShadingGroup *shgrp_a = (const DRWShadingGroup *)a;
+  const DRWShadingGroup *shgrp_b = (const DRWShadingGroup *)b;
+
+  if (shgrp_a->shader != shgrp_b->shader) {
+    return (shgrp_a->shader > shgrp_b->shader) ? 1 : -1;
+  }
+  else {
+    /* If shaders are the same, keep original order. */
+    if (shgrp_a->z_sorting.original_index > shgrp_b->z_sorting.original_index) {
+      return -1;
+    }
+    else {
+      return 0;
+    }
+  }
+}
+
+/**
+ * Sort Shading groups to minimize shader switching during submission.
+ * The sort is stable so that the batching of consecutive draw calls sharing
+ * the same batch (see #draw_call_batching_do) is not disturbed.
+ * Only valid for order independent passes (e.g. opaque, depth tested).
+ */
+void DRW_pass_sort_shgroup_shader(DRWPass *pass)
+{
+  if (!(pass->shgroups.first && pass->shgroups.first->next)) {
+    /* Nothing to sort */
+    return;
+  }
+
+  uint index = 0;
+  DRWShadingGroup *shgroup = pass->shgroups.first;
+  do {
+    shgroup->z_sorting.original_index = index++;
+  } while ((shgroup = shgroup->next));
+
+  pass->shgroups.first = shgroup_sort_fn_r(pass->shgroups.first, pass_shgroup_shader_sort);
+
+  /* Find the new last */
+  DRWShadingGroup *last = pass->shgroups.first;
+  while ((last = last->next)) {
+    /* Reset the pass id for debugging. */
+    last->pass_handle = pass->handle;
+  }
+  pass->shgroups.last = last;
+}
+
 /**
  * Reverse Shading group submission order.
  */
@@ -20,10 +20,14 @@
  * \ingroup draw
  */
 
+#include <stdio.h>
+
 #include "BLI_listbase.h"
+#include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
 
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
 #include "BLF_api.h"
@@ -42,10 +46,13 @@
 #define MAX_NESTED_TIMER 8
 #define CHUNK_SIZE 8
 #define GPU_TIMER_FALLOFF 0.1
+/* Set this debug value to also export the timers as a chrome://tracing file. */
+#define GPU_TIMER_TRACE_DEBUG_VALUE 29
 
 typedef struct DRWTimer {
   GLuint query[2];
   GLuint64 time_average;
+  GLuint64 time_frame; /* Un-smoothed time of the last frame read back, for trace export. */
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
   bool is_query; /* Does this timer actually perform queries or is it just a group. */
@@ -120,8 +127,8 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
         glGenQueries(1, timer->query);
       }
 
-      glFinish();
-      /* Issue query for the next frame */
+      /* Issue query for the next frame. Queries are double buffered and only read back a frame
+       * late (see #DRW_stats_reset), so no synchronization is needed here. */
       glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
       DTP.is_querying = true;
     }
@@ -159,6 +166,52 @@ void DRW_stats_query_end(void)
   }
 }
 
+/* Append this frame's timers to a chrome://tracing (JSON Array Format) file inside the session
+ * temporary directory. Timestamps are rebuilt from the timer hierarchy since timer queries only
+ * give us durations, so events of a frame are laid out back to back on the trace timeline. */
+static void drw_stats_trace_write_frame(void)
+{
+  static FILE *trace_file = NULL;
+  static GLuint64 trace_time = 0;
+  GLuint64 lvl_time[MAX_NESTED_TIMER];
+
+  if (trace_file == NULL) {
+    char filepath[FILE_MAX];
+    BLI_join_dirfile(filepath, sizeof(filepath), BKE_tempdir_session(), "blender_gpu_trace.json");
+    trace_file = fopen(filepath, "w");
+    if (trace_file == NULL) {
+      return;
+    }
+    /* The trailing "]" can be left out, so the file stays valid while we keep appending. */
+    fputs("[\n", trace_file);
+    printf("Writing GPU timings trace to: %s\n", filepath);
+  }
+
+  lvl_time[0] = trace_time;
+  for (int i = 0; i < DTP.timer_increment; i++) {
+    DRWTimer *timer = &DTP.timers[i];
+    const GLuint64 time_start = lvl_time[timer->lvl];
+
+    BLI_assert(timer->lvl < MAX_NESTED_TIMER);
+    fprintf(trace_file,
+            "{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, "
+            "\"ts\": %.3f, \"dur\": %.3f},\n",
+            timer->name,
+            time_start / 1000.0,
+            timer->time_frame / 1000.0);
+
+    if (timer->lvl + 1 < MAX_NESTED_TIMER) {
+      lvl_time[timer->lvl + 1] = time_start;
+    }
+    lvl_time[timer->lvl] = time_start + timer->time_frame;
+  }
+
+  if (DTP.timer_increment > 0) {
+    trace_time = lvl_time[0];
+  }
+  fflush(trace_file);
+}
+
 void DRW_stats_reset(void)
 {
   BLI_assert((DTP.timer_increment - DTP.end_increment) <= 0 &&
@@ -168,6 +221,7 @@ void DRW_stats_reset(void)
 
   if (DTP.is_recording) {
     GLuint64 lvl_time[MAX_NESTED_TIMER] = {0};
+    GLuint64 lvl_time_frame[MAX_NESTED_TIMER] = {0};
 
     /* Swap queries for the next frame and sum up each lvl time. */
     for (int i = DTP.timer_increment - 1; i >= 0; i--) {
@@ -185,16 +239,24 @@ void DRW_stats_reset(void)
           time = 1000000000; /* 1ms default */
         }
 
+        timer->time_frame = time;
         timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
                               time * GPU_TIMER_FALLOFF;
         timer->time_average = MIN2(timer->time_average, 1000000000);
       }
       else {
         timer->time_average = lvl_time[timer->lvl + 1];
+        timer->time_frame = lvl_time_frame[timer->lvl + 1];
         lvl_time[timer->lvl + 1] = 0;
+        lvl_time_frame[timer->lvl + 1] = 0;
       }
 
       lvl_time[timer->lvl] += timer->time_average;
+      lvl_time_frame[timer->lvl] += timer->time_frame;
+    }
+
+    if (G.debug_value == GPU_TIMER_TRACE_DEBUG_VALUE) {
+      drw_stats_trace_write_frame();
     }
 
     DTP.is_recording = false;
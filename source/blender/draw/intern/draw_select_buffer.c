@@ -46,6 +46,75 @@
 /** \name Buffer of select ID's
  * \{ */
 
+/**
+ * Pixel pack buffers for reading back the select buffer.
+ *
+ * Reading integer pixels straight into client memory synchronizes with the GPU and hits a slow
+ * conversion path on most drivers. Going through a pixel buffer object keeps the transfer on the
+ * DMA path instead. Two buffers are cycled so that interactive selections which read every mouse
+ * move (circle select) never reuse a buffer the driver may still be transferring into.
+ */
+static struct {
+  GLuint pbo_ids[2];
+  uint pbo_sizes[2];
+  int pbo_cycle;
+} g_select_read = {{0}};
+
+static void select_buffer_read_pixels(const rcti *rect, uint *r_buf)
+{
+  const uint buf_size = BLI_rcti_size_x(rect) * BLI_rcti_size_y(rect) * sizeof(uint);
+  const int cycle = g_select_read.pbo_cycle;
+
+  if (g_select_read.pbo_ids[cycle] == 0) {
+    glGenBuffers(1, &g_select_read.pbo_ids[cycle]);
+  }
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, g_select_read.pbo_ids[cycle]);
+  if (g_select_read.pbo_sizes[cycle] < buf_size) {
+    glBufferData(GL_PIXEL_PACK_BUFFER, buf_size, NULL, GL_STREAM_READ);
+    g_select_read.pbo_sizes[cycle] = buf_size;
+  }
+
+  glReadPixels(rect->xmin,
+               rect->ymin,
+               BLI_rcti_size_x(rect),
+               BLI_rcti_size_y(rect),
+               GL_RED_INTEGER,
+               GL_UNSIGNED_INT,
+               NULL);
+
+  void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, buf_size, GL_MAP_READ_BIT);
+  if (data != NULL) {
+    memcpy(r_buf, data, buf_size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  }
+  else {
+    /* Mapping can fail on context loss, fall back to a synchronous read. */
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glReadPixels(rect->xmin,
+                 rect->ymin,
+                 BLI_rcti_size_x(rect),
+                 BLI_rcti_size_y(rect),
+                 GL_RED_INTEGER,
+                 GL_UNSIGNED_INT,
+                 r_buf);
+  }
+
+  g_select_read.pbo_cycle = (cycle + 1) % ARRAY_SIZE(g_select_read.pbo_ids);
+}
+
+void DRW_select_buffer_free(void)
+{
+  for (int i = 0; i < ARRAY_SIZE(g_select_read.pbo_ids); i++) {
+    if (g_select_read.pbo_ids[i] != 0) {
+      glDeleteBuffers(1, &g_select_read.pbo_ids[i]);
+      g_select_read.pbo_ids[i] = 0;
+      g_select_read.pbo_sizes[i] = 0;
+    }
+  }
+}
+
 /* Main function to read a block of pixels from the select frame buffer. */
 uint *DRW_select_buffer_read(struct Depsgraph *depsgraph,
                              struct ARegion *region,
@@ -85,13 +154,7 @@ uint *DRW_select_buffer_read(struct Depsgraph *depsgraph,
       GPUFrameBuffer *select_id_fb = DRW_engine_select_framebuffer_get();
       GPU_framebuffer_bind(select_id_fb);
       glReadBuffer(GL_COLOR_ATTACHMENT0);
-      glReadPixels(rect_clamp.xmin,
-                   rect_clamp.ymin,
-                   BLI_rcti_size_x(&rect_clamp),
-                   BLI_rcti_size_y(&rect_clamp),
-                   GL_RED_INTEGER,
-                   GL_UNSIGNED_INT,
-                   r_buf);
+      select_buffer_read_pixels(&rect_clamp, r_buf);
 
       if (!BLI_rcti_compare(rect, &rect_clamp)) {
         /* The rect has been clamped so you need to realign the buffer and fill in the blanks */
@@ -464,14 +464,21 @@ void animviz_calc_motionpaths(Depsgraph *depsgraph,
             sfra,
             efra,
             efra - sfra + 1);
+  /* NOTE: The bake loop is serial on purpose: depsgraph evaluation is stateful, so evaluating
+   * frame sub-ranges in parallel would need a full Main + depsgraph copy per worker (what the
+   * sequencer prefetch job does for its single background thread), which costs more than it
+   * saves for typical path ranges. */
   for (CFRA = sfra; CFRA <= efra; CFRA++) {
     if (range == ANIMVIZ_CALC_RANGE_CURRENT_FRAME) {
       /* For current frame, only update tagged. */
       BKE_scene_graph_update_tagged(depsgraph, bmain);
     }
     else {
-      /* Update relevant data for new frame. */
-      motionpaths_calc_update_scene(bmain, depsgraph);
+      /* Other ranges always run on the temporary targets-only depsgraph built by
+       * #animviz_depsgraph_build: evaluate it directly (as the sequencer prefetch job does),
+       * skipping the scene level frame change machinery (handlers, sound, editor notifications)
+       * which would otherwise run for every baked frame. */
+      DEG_evaluate_on_framechange(bmain, depsgraph, (float)CFRA);
     }
 
     /* perform baking for targets */
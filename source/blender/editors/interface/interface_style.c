@@ -487,13 +487,14 @@ void uiStyleInit(void)
       }
     }
     else {
-      /* ? just for speed to initialize?
-       * Yes, this build the glyph cache and create
-       * the texture.
-       */
+      /* Pre-rasterize the glyphs and kerning tables for the sizes used by
+       * most interface text, so the first redraw doesn't pay for it. */
       BLF_size(font->blf_id, 11 * U.pixelsize, U.dpi);
+      BLF_cache_warm(font->blf_id);
       BLF_size(font->blf_id, 12 * U.pixelsize, U.dpi);
+      BLF_cache_warm(font->blf_id);
       BLF_size(font->blf_id, 14 * U.pixelsize, U.dpi);
+      BLF_cache_warm(font->blf_id);
     }
   }
 
@@ -1313,7 +1313,7 @@ static void widgetbase_set_uniform_colors_ubv(uiWidgetBase *wtb,
  * \{ */
 
 /* keep in sync with shader */
-#define MAX_WIDGET_BASE_BATCH 6
+#define MAX_WIDGET_BASE_BATCH 16
 #define MAX_WIDGET_PARAMETERS 11
 
 static struct {
@@ -1343,9 +1343,10 @@ void UI_widgetbase_draw_cache_flush(void)
   }
   else {
     GPU_batch_program_set_builtin(batch, GPU_SHADER_2D_WIDGET_BASE_INST);
+    /* Only upload the used part of the parameters array. */
     GPU_batch_uniform_4fv_array(batch,
                                 "parameters",
-                                MAX_WIDGET_PARAMETERS * MAX_WIDGET_BASE_BATCH,
+                                MAX_WIDGET_PARAMETERS * g_widget_base_batch.count,
                                 (float *)g_widget_base_batch.params);
     GPU_batch_uniform_3fv(batch, "checkerColorAndSize", checker_params);
     GPU_matrix_bind(batch->interface);
@@ -38,6 +38,7 @@
 #endif
 
 #include "io_cache.h"
+#include "io_obj.h"
 
 void ED_operatortypes_io(void)
 {
@@ -54,6 +55,8 @@ void ED_operatortypes_io(void)
   WM_operatortype_append(WM_OT_usd_export);
 #endif
 
+  WM_operatortype_append(WM_OT_obj_export);
+
   WM_operatortype_append(CACHEFILE_OT_open);
   WM_operatortype_append(CACHEFILE_OT_reload);
 }
@@ -501,12 +501,6 @@ static void um_arraystore_free(UndoMesh *um)
 static void *undomesh_from_editmesh(UndoMesh *um, BMEditMesh *em, Key *key)
 {
   BLI_assert(BLI_array_is_zeroed(um, 1));
-#ifdef USE_ARRAY_STORE_THREAD
-  /* changes this waits is low, but must have finished */
-  if (um_arraystore.task_pool) {
-    BLI_task_pool_work_and_wait(um_arraystore.task_pool);
-  }
-#endif
   /* make sure shape keys work */
   um->me.key = key ? BKE_key_copy_nolib(key) : NULL;
 
@@ -528,6 +522,16 @@ static void *undomesh_from_editmesh(UndoMesh *um, BMEditMesh *em, Key *key)
 
 #ifdef USE_ARRAY_STORE
   {
+#  ifdef USE_ARRAY_STORE_THREAD
+    /* Wait for a previous push to finish encoding only now, after the BMesh to Mesh conversion
+     * above: this way the conversion overlaps with the previous encode. Until the wait, the
+     * background task may still be reading the previous state's arrays, so don't touch
+     * 'local_links' before this point. Chance this waits is low, but it must have finished. */
+    if (um_arraystore.task_pool) {
+      BLI_task_pool_work_and_wait(um_arraystore.task_pool);
+    }
+#  endif
+
     /* We could be more clever here,
      * the previous undo state may be from a separate mesh. */
     const UndoMesh *um_ref = um_arraystore.local_links.last ?
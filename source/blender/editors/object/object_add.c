@@ -2693,46 +2693,60 @@ void OBJECT_OT_convert(wmOperatorType *ot)
 /* used below, assumes id.new is correct */
 /* leaves selection of base/object unaltered */
 /* Does set ID->newid pointers. */
-static Base *object_add_duplicate_internal(
+/* Duplicates the object and links it into the collections of the original,
+ * without looking up the new base (there is none yet when view layer syncing is deferred). */
+static Object *object_add_duplicate_object_internal(
     Main *bmain, Scene *scene, ViewLayer *view_layer, Object *ob, int dupflag)
 {
-  Base *base, *basen = NULL;
+  Base *base;
   Object *obn;
 
   if (ob->mode & OB_MODE_POSE) {
     /* nothing? */
+    return NULL;
   }
-  else {
-    obn = ID_NEW_SET(ob, BKE_object_duplicate(bmain, ob, dupflag));
-    DEG_id_tag_update(&obn->id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY);
 
-    base = BKE_view_layer_base_find(view_layer, ob);
-    if ((base != NULL) && (base->flag & BASE_VISIBLE_DEPSGRAPH)) {
-      BKE_collection_object_add_from(bmain, scene, ob, obn);
-    }
-    else {
-      LayerCollection *layer_collection = BKE_layer_collection_get_active(view_layer);
-      BKE_collection_object_add(bmain, layer_collection->collection, obn);
-    }
+  obn = ID_NEW_SET(ob, BKE_object_duplicate(bmain, ob, dupflag));
+  DEG_id_tag_update(&obn->id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY);
 
-    basen = BKE_view_layer_base_find(view_layer, obn);
-    if (base != NULL) {
-      basen->local_view_bits = base->local_view_bits;
-    }
+  base = BKE_view_layer_base_find(view_layer, ob);
+  if ((base != NULL) && (base->flag & BASE_VISIBLE_DEPSGRAPH)) {
+    BKE_collection_object_add_from(bmain, scene, ob, obn);
+  }
+  else {
+    LayerCollection *layer_collection = BKE_layer_collection_get_active(view_layer);
+    BKE_collection_object_add(bmain, layer_collection->collection, obn);
+  }
 
-    /* 1) duplis should end up in same collection as the original
-     * 2) Rigid Body sim participants MUST always be part of a collection...
-     */
-    // XXX: is 2) really a good measure here?
-    if (ob->rigidbody_object || ob->rigidbody_constraint) {
-      Collection *collection;
-      for (collection = bmain->collections.first; collection; collection = collection->id.next) {
-        if (BKE_collection_has_object(collection, ob)) {
-          BKE_collection_object_add(bmain, collection, obn);
-        }
+  /* 1) duplis should end up in same collection as the original
+   * 2) Rigid Body sim participants MUST always be part of a collection...
+   */
+  // XXX: is 2) really a good measure here?
+  if (ob->rigidbody_object || ob->rigidbody_constraint) {
+    Collection *collection;
+    for (collection = bmain->collections.first; collection; collection = collection->id.next) {
+      if (BKE_collection_has_object(collection, ob)) {
+        BKE_collection_object_add(bmain, collection, obn);
       }
     }
   }
+
+  return obn;
+}
+
+static Base *object_add_duplicate_internal(
+    Main *bmain, Scene *scene, ViewLayer *view_layer, Object *ob, int dupflag)
+{
+  Object *obn = object_add_duplicate_object_internal(bmain, scene, view_layer, ob, dupflag);
+  if (obn == NULL) {
+    return NULL;
+  }
+
+  Base *basen = BKE_view_layer_base_find(view_layer, obn);
+  Base *base = BKE_view_layer_base_find(view_layer, ob);
+  if (base != NULL) {
+    basen->local_view_bits = base->local_view_bits;
+  }
   return basen;
 }
 
@@ -2777,18 +2791,54 @@ static int duplicate_exec(bContext *C, wmOperator *op)
   const bool linked = RNA_boolean_get(op->ptr, "linked");
   int dupflag = (linked) ? 0 : U.dupflag;
 
-  CTX_DATA_BEGIN (C, Base *, base, selected_bases) {
-    Base *basen = object_add_duplicate_internal(bmain, scene, view_layer, base->object, dupflag);
+  ListBase selected_bases;
+  CTX_data_selected_bases(C, &selected_bases);
+  const int bases_len = BLI_listbase_count(&selected_bases);
+  if (bases_len == 0) {
+    BLI_freelistN(&selected_bases);
+    return OPERATOR_CANCELLED;
+  }
+
+  Object **objects_new = MEM_callocN(sizeof(*objects_new) * bases_len, __func__);
+
+  /* Syncing the view layers after every duplicated object makes duplication of a
+   * large selection quadratic, so defer the sync and create the new bases in a
+   * single pass once all objects have been copied. */
+  BKE_layer_collection_resync_forbid();
+
+  int i = 0;
+  LISTBASE_FOREACH (CollectionPointerLink *, link, &selected_bases) {
+    Base *base = link->ptr.data;
+
+    objects_new[i] = object_add_duplicate_object_internal(
+        bmain, scene, view_layer, base->object, dupflag);
 
-    /* note that this is safe to do with this context iterator,
-     * the list is made in advance */
     ED_object_base_select(base, BA_DESELECT);
-    ED_object_base_select(basen, BA_SELECT);
+    i++;
+  }
 
+  BKE_layer_collection_resync_allow();
+  BKE_main_collection_sync(bmain);
+
+  /* Select the new bases, now that the deferred sync has created them. */
+  i = 0;
+  LISTBASE_FOREACH (CollectionPointerLink *, link, &selected_bases) {
+    Base *base = link->ptr.data;
+    Object *obn = objects_new[i];
+    i++;
+    if (obn == NULL) {
+      continue;
+    }
+
+    Base *basen = BKE_view_layer_base_find(view_layer, obn);
     if (basen == NULL) {
       continue;
     }
 
+    basen->local_view_bits = base->local_view_bits;
+
+    ED_object_base_select(basen, BA_SELECT);
+
     /* new object becomes active */
     if (BASACT(view_layer) == base) {
       ED_object_base_activate(C, basen);
@@ -2798,7 +2848,9 @@ static int duplicate_exec(bContext *C, wmOperator *op)
       DEG_id_tag_update(basen->object->data, 0);
     }
   }
-  CTX_DATA_END;
+
+  MEM_freeN(objects_new);
+  BLI_freelistN(&selected_bases);
 
   copy_object_set_idnew(C);
 
@@ -87,6 +87,9 @@
 
 #include "BLF_api.h"
 
+#include "bmesh.h"
+#include "bmesh_tools.h"
+
 #include "object_intern.h"  // own include
 
 /* TODO(sebpa): unstable, can lead to unrecoverable errors. */
@@ -123,33 +126,88 @@ static bool object_remesh_poll(bContext *C)
   return ED_operator_object_active_editable_mesh(C);
 }
 
-static int voxel_remesh_exec(bContext *C, wmOperator *op)
+typedef struct VoxelRemeshJob {
+  /* from wmJob */
+  struct Object *owner;
+  short *stop, *do_update;
+  float *progress;
+
+  int success;
+  bool is_nonblocking_job;
+} VoxelRemeshJob;
+
+static void voxel_remesh_free_job(void *customdata)
 {
-  Object *ob = CTX_data_active_object(C);
+  VoxelRemeshJob *vj = customdata;
+  MEM_freeN(vj);
+}
 
-  Mesh *mesh = ob->data;
-  Mesh *new_mesh;
+/* called by voxel remesh job, only to check job 'stop' value */
+static bool voxel_remesh_break_job(void *customdata)
+{
+  VoxelRemeshJob *vj = (VoxelRemeshJob *)customdata;
 
-  if (mesh->remesh_voxel_size <= 0.0f) {
-    BKE_report(op->reports, RPT_ERROR, "Voxel remesher cannot run with a voxel size of 0.0");
-    return OPERATOR_CANCELLED;
+  /* this is not nice yet, need to make the jobs list template better
+   * for identifying/acting upon various different jobs */
+  /* but for now we'll reuse the render break... */
+  bool should_break = (G.is_break);
+
+  if (should_break) {
+    vj->success = -1;
   }
 
+  return should_break;
+}
+
+static void voxel_remesh_start_job(void *customdata, short *stop, short *do_update, float *progress)
+{
+  VoxelRemeshJob *vj = customdata;
+
+  vj->stop = stop;
+  vj->do_update = do_update;
+  vj->progress = progress;
+  vj->success = 1;
+
+  if (vj->is_nonblocking_job) {
+    G.is_break = false; /* XXX shared with render - replace with job 'stop' switch */
+  }
+
+  Object *ob = vj->owner;
+  Mesh *mesh = ob->data;
+  Mesh *new_mesh;
+
   float isovalue = 0.0f;
   if (mesh->flag & ME_REMESH_REPROJECT_VOLUME) {
     isovalue = mesh->remesh_voxel_size * 0.3f;
   }
 
+  *progress = 0.1f;
+  *do_update = true;
+
   new_mesh = BKE_mesh_remesh_voxel_to_mesh_nomain(
       mesh, mesh->remesh_voxel_size, mesh->remesh_voxel_adaptivity, isovalue);
 
   if (!new_mesh) {
-    BKE_report(op->reports, RPT_ERROR, "Voxel remesher failed to create mesh");
-    return OPERATOR_CANCELLED;
+    vj->success = 0;
+    *do_update = true;
+    *stop = 0;
+    return;
+  }
+
+  /* The level set conversion itself is not interruptible,
+   * but the remaining heavy steps (poles, reprojection) are checked in between. */
+  if (voxel_remesh_break_job(vj)) {
+    BKE_id_free(NULL, new_mesh);
+    *do_update = true;
+    *stop = 0;
+    return;
   }
 
+  *progress = 0.5f;
+  *do_update = true;
+
   if (ob->mode == OB_MODE_SCULPT) {
-    ED_sculpt_undo_geometry_begin(ob, op->type->name);
+    ED_sculpt_undo_geometry_begin(ob, "Voxel Remesh");
   }
 
   if (mesh->flag & ME_REMESH_FIX_POLES && mesh->remesh_voxel_adaptivity <= 0.0f) {
@@ -174,6 +232,11 @@ static int voxel_remesh_exec(bContext *C, wmOperator *op)
     BKE_remesh_reproject_sculpt_face_sets(new_mesh, mesh);
   }
 
+  *progress = 0.9f;
+  *do_update = true;
+
+  /* The swap into the original mesh is intentionally not interruptible from here on,
+   * so a late cancel can never leave a half-updated mesh behind. */
   BKE_mesh_nomain_to_mesh(new_mesh, mesh, ob, &CD_MASK_MESH, true);
 
   if (mesh->flag & ME_REMESH_SMOOTH_NORMALS) {
@@ -185,9 +248,79 @@ static int voxel_remesh_exec(bContext *C, wmOperator *op)
   }
 
   BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_ALL);
-  DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  WM_event_add_notifier(C, NC_GEOM | ND_DATA, ob->data);
 
+  *progress = 1.0f;
+  *do_update = true;
+  *stop = 0;
+}
+
+static void voxel_remesh_end_job(void *customdata)
+{
+  VoxelRemeshJob *vj = customdata;
+
+  Object *ob = vj->owner;
+
+  if (vj->is_nonblocking_job) {
+    WM_set_locked_interface(G_MAIN->wm.first, false);
+  }
+
+  switch (vj->success) {
+    case 1:
+      DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+      WM_reportf(RPT_INFO, "Voxel remesher completed");
+      break;
+    case 0:
+      WM_reportf(RPT_ERROR, "Voxel remesher failed to create mesh");
+      break;
+    case -1:
+      WM_report(RPT_WARNING, "Voxel remesher cancelled");
+      break;
+  }
+}
+
+static int voxel_remesh_exec(bContext *C, wmOperator *op)
+{
+  Object *ob = CTX_data_active_object(C);
+  Mesh *mesh = ob->data;
+
+  if (mesh->remesh_voxel_size <= 0.0f) {
+    BKE_report(op->reports, RPT_ERROR, "Voxel remesher cannot run with a voxel size of 0.0");
+    return OPERATOR_CANCELLED;
+  }
+
+  VoxelRemeshJob *job = MEM_callocN(sizeof(VoxelRemeshJob), "VoxelRemeshJob");
+  job->owner = ob;
+
+  if (op->flag == 0) {
+    /* This is called directly from the exec operator, this operation is now blocking */
+    job->is_nonblocking_job = false;
+    short stop = 0, do_update = true;
+    float progress;
+    voxel_remesh_start_job(job, &stop, &do_update, &progress);
+    voxel_remesh_end_job(job);
+    voxel_remesh_free_job(job);
+
+    WM_event_add_notifier(C, NC_GEOM | ND_DATA, ob->data);
+  }
+  else {
+    /* Non blocking call. For when the operator has been called from the gui */
+    job->is_nonblocking_job = true;
+
+    wmJob *wm_job = WM_jobs_get(CTX_wm_manager(C),
+                                CTX_wm_window(C),
+                                CTX_data_scene(C),
+                                "Voxel Remesh",
+                                WM_JOB_PROGRESS,
+                                WM_JOB_TYPE_VOXEL_REMESH);
+
+    WM_jobs_customdata_set(wm_job, job, voxel_remesh_free_job);
+    WM_jobs_timer(wm_job, 0.1, NC_GEOM | ND_DATA, NC_GEOM | ND_DATA);
+    WM_jobs_callbacks(wm_job, voxel_remesh_start_job, NULL, NULL, voxel_remesh_end_job);
+
+    WM_set_locked_interface(CTX_wm_manager(C), true);
+
+    WM_jobs_start(CTX_wm_manager(C), wm_job);
+  }
   return OPERATOR_FINISHED;
 }
 
@@ -643,6 +776,9 @@ typedef struct QuadriFlowJob {
   bool preserve_paint_mask;
   bool smooth_normals;
 
+  bool use_input_decimation;
+  float input_decimation_ratio;
+
   int success;
   bool is_nonblocking_job;
 } QuadriFlowJob;
@@ -799,6 +935,24 @@ static Mesh *remesh_symmetry_mirror(Object *ob, Mesh *mesh, eSymmetryAxes symmet
   return mesh_mirror;
 }
 
+static Mesh *remesh_input_decimate(Mesh *mesh, const float ratio)
+{
+  BMesh *bm = BKE_mesh_to_bmesh_ex(mesh,
+                                   &(struct BMeshCreateParams){0},
+                                   &(struct BMeshFromMeshParams){
+                                       .calc_face_normal = true,
+                                   });
+
+  BM_mesh_decimate_collapse(bm, ratio, NULL, 1.0f, false, -1, 0.0f);
+
+  Mesh *mesh_decimated = BKE_mesh_from_bmesh_for_eval_nomain(bm, NULL, mesh);
+  BM_mesh_free(bm);
+
+  BKE_id_free(NULL, mesh);
+
+  return mesh_decimated;
+}
+
 static void quadriflow_start_job(void *customdata, short *stop, short *do_update, float *progress)
 {
   QuadriFlowJob *qj = customdata;
@@ -830,6 +984,12 @@ static void quadriflow_start_job(void *customdata, short *stop, short *do_update
   /* Bisect the input mesh using the paint symmetry settings */
   bisect_mesh = remesh_symmetry_bisect(bisect_mesh, qj->symmetry_axes);
 
+  /* Optionally decimate the input before running the solver, so high poly sculpts can be
+   * previewed at a draft resolution before committing to the full solve */
+  if (qj->use_input_decimation && qj->input_decimation_ratio < 1.0f) {
+    bisect_mesh = remesh_input_decimate(bisect_mesh, qj->input_decimation_ratio);
+  }
+
   new_mesh = BKE_mesh_remesh_quadriflow_to_mesh_nomain(
       bisect_mesh,
       qj->target_faces,
@@ -937,6 +1097,9 @@ static int quadriflow_remesh_exec(bContext *C, wmOperator *op)
   job->preserve_paint_mask = RNA_boolean_get(op->ptr, "preserve_paint_mask");
   job->smooth_normals = RNA_boolean_get(op->ptr, "smooth_normals");
 
+  job->use_input_decimation = RNA_boolean_get(op->ptr, "use_input_decimation");
+  job->input_decimation_ratio = RNA_float_get(op->ptr, "input_decimation_ratio");
+
   /* Update the target face count if symmetry is enabled */
   Sculpt *sd = CTX_data_tool_settings(C)->sculpt;
   if (sd && job->use_paint_symmetry) {
@@ -1049,6 +1212,10 @@ static bool quadriflow_poll_property(const bContext *C, wmOperator *op, const Pr
       return false;
     }
   }
+  else if (STREQ(prop_id, "input_decimation_ratio") &&
+           !RNA_boolean_get(op->ptr, "use_input_decimation")) {
+    return false;
+  }
 
   return true;
 }
@@ -1125,6 +1292,23 @@ void OBJECT_OT_quadriflow_remesh(wmOperatorType *ot)
                   "Smooth Normals",
                   "Set the output mesh normals to smooth");
 
+  RNA_def_boolean(ot->srna,
+                  "use_input_decimation",
+                  false,
+                  "Decimate Input",
+                  "Decimate the input mesh before remeshing, for a faster but less accurate "
+                  "preview of the final result");
+
+  RNA_def_float(ot->srna,
+                "input_decimation_ratio",
+                0.25f,
+                0.0f,
+                1.0f,
+                "Decimation Ratio",
+                "Ratio of input faces to keep when decimating before the remesh",
+                0.0f,
+                1.0f);
+
   RNA_def_enum(ot->srna,
                "mode",
                mode_type_items,
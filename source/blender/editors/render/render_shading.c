@@ -913,12 +913,14 @@ static void light_cache_bake_tag_cache(Scene *scene, wmOperator *op)
     switch (subset) {
       case LIGHTCACHE_SUBSET_ALL:
         scene->eevee.light_cache_data->flag |= LIGHTCACHE_UPDATE_GRID | LIGHTCACHE_UPDATE_CUBE;
+        scene->eevee.light_cache_data->flag &= ~LIGHTCACHE_INCREMENTAL;
         break;
       case LIGHTCACHE_SUBSET_CUBE:
         scene->eevee.light_cache_data->flag |= LIGHTCACHE_UPDATE_CUBE;
         break;
       case LIGHTCACHE_SUBSET_DIRTY:
-        /* Leave tag untouched. */
+        /* Leave tag untouched, only rebake the probes made stale by changes. */
+        scene->eevee.light_cache_data->flag |= LIGHTCACHE_INCREMENTAL;
         break;
     }
   }
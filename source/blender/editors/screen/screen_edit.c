@@ -1468,17 +1468,13 @@ void ED_refresh_viewport_fps(bContext *C)
 
   /* is anim playback running? */
   if (animtimer && (U.uiflag & USER_SHOW_FPS)) {
-    ScreenFrameRateInfo *fpsi = scene->fps_info;
-
     /* if there isn't any info, init it first */
-    if (fpsi == NULL) {
-      fpsi = scene->fps_info = MEM_callocN(sizeof(ScreenFrameRateInfo),
-                                           "refresh_viewport_fps fps_info");
+    if (scene->fps_info == NULL) {
+      scene->fps_info = MEM_callocN(sizeof(ScreenFrameRateInfo), "refresh_viewport_fps fps_info");
     }
 
-    /* update the values */
-    fpsi->redrawtime = fpsi->lredrawtime;
-    fpsi->lredrawtime = animtimer->ltime;
+    /* The actual times are stamped on buffer swap (see #wm_draw_update), so the meter
+     * shows measured presentation intervals instead of the timer period. */
   }
   else {
     /* playback stopped or shouldn't be running */
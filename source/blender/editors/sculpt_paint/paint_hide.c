@@ -148,7 +148,6 @@ static void partialvis_update_grids(Depsgraph *depsgraph,
   SCULPT_undo_push_node(ob, node, SCULPT_UNDO_HIDDEN);
 
   for (int i = 0; i < totgrid; i++) {
-    int any_hidden = 0;
     int g = grid_indices[i];
     BLI_bitmap *gh = grid_hidden[g];
 
@@ -185,19 +184,17 @@ static void partialvis_update_grids(Depsgraph *depsgraph,
 
           any_changed = true;
         }
-
-        /* Keep track of whether any elements are still hidden. */
-        if (BLI_BITMAP_TEST(gh, y * key.grid_size + x)) {
-          any_hidden = true;
-        }
-        else {
-          any_visible = true;
-        }
       }
     }
 
+    /* Count the hidden elements in bulk rather than testing every bit above. */
+    const size_t hidden_len = BLI_bitmap_count_set(gh, (size_t)key.grid_area);
+    if (hidden_len != (size_t)key.grid_area) {
+      any_visible = true;
+    }
+
     /* If everything in the grid is now visible, free the grid flags. */
-    if (!any_hidden) {
+    if (hidden_len == 0) {
       MEM_freeN(gh);
       grid_hidden[g] = NULL;
     }
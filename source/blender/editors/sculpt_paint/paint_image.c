@@ -87,23 +87,79 @@
  * Maybe it should be exposed as part of the paint operation,
  * but for now just give a public interface.
  */
-static ImagePaintPartialRedraw imapaintpartial = {0, 0, 0, 0, 0};
+/* Maximum number of dirty rectangles tracked per image update. A stroke step
+ * can touch distant parts of the image (wrapped painting, multiple symmetry
+ * tiles), and accumulating them in a single bounding box re-uploads nearly
+ * the entire texture for high resolution images. */
+#define IMAPAINT_PARTIAL_REDRAW_RECTS 8
+/* Rectangles closer than this are merged, uploading them separately gains
+ * nothing. */
+#define IMAPAINT_PARTIAL_REDRAW_MERGE_DIST 32
+
+static ImagePaintPartialRedraw imapaintpartial[IMAPAINT_PARTIAL_REDRAW_RECTS];
+static int imapaintpartial_tot = 0;
 
 ImagePaintPartialRedraw *get_imapaintpartial(void)
 {
-  return &imapaintpartial;
+  return &imapaintpartial[0];
 }
 
 void set_imapaintpartial(struct ImagePaintPartialRedraw *ippr)
 {
-  imapaintpartial = *ippr;
+  imapaintpartial[0] = *ippr;
+  imapaintpartial_tot = 1;
 }
 
 /* Imagepaint Partial Redraw & Dirty Region */
 
 void ED_imapaint_clear_partial_redraw(void)
 {
-  memset(&imapaintpartial, 0, sizeof(imapaintpartial));
+  imapaintpartial_tot = 0;
+}
+
+static void imapaint_partial_redraw_add(int x1, int y1, int x2, int y2)
+{
+  /* Merge into an overlapping or nearby rectangle if there is one. */
+  for (int i = 0; i < imapaintpartial_tot; i++) {
+    ImagePaintPartialRedraw *pr = &imapaintpartial[i];
+    if (x1 <= pr->x2 + IMAPAINT_PARTIAL_REDRAW_MERGE_DIST &&
+        x2 >= pr->x1 - IMAPAINT_PARTIAL_REDRAW_MERGE_DIST &&
+        y1 <= pr->y2 + IMAPAINT_PARTIAL_REDRAW_MERGE_DIST &&
+        y2 >= pr->y1 - IMAPAINT_PARTIAL_REDRAW_MERGE_DIST) {
+      pr->x1 = min_ii(pr->x1, x1);
+      pr->y1 = min_ii(pr->y1, y1);
+      pr->x2 = max_ii(pr->x2, x2);
+      pr->y2 = max_ii(pr->y2, y2);
+      return;
+    }
+  }
+
+  if (imapaintpartial_tot < IMAPAINT_PARTIAL_REDRAW_RECTS) {
+    ImagePaintPartialRedraw *pr = &imapaintpartial[imapaintpartial_tot++];
+    pr->x1 = x1;
+    pr->y1 = y1;
+    pr->x2 = x2;
+    pr->y2 = y2;
+    pr->enabled = 1;
+    return;
+  }
+
+  /* All rectangles in use: merge into the one whose bounds grow the least. */
+  ImagePaintPartialRedraw *pr_best = &imapaintpartial[0];
+  int best_area = INT_MAX;
+  for (int i = 0; i < imapaintpartial_tot; i++) {
+    ImagePaintPartialRedraw *pr = &imapaintpartial[i];
+    const int area = (max_ii(pr->x2, x2) - min_ii(pr->x1, x1)) *
+                     (max_ii(pr->y2, y2) - min_ii(pr->y1, y1));
+    if (area < best_area) {
+      best_area = area;
+      pr_best = pr;
+    }
+  }
+  pr_best->x1 = min_ii(pr_best->x1, x1);
+  pr_best->y1 = min_ii(pr_best->y1, y1);
+  pr_best->x2 = max_ii(pr_best->x2, x2);
+  pr_best->y2 = max_ii(pr_best->y2, y2);
 }
 
 void imapaint_region_tiles(
@@ -132,19 +188,7 @@ void ED_imapaint_dirty_region(
     return;
   }
 
-  if (!imapaintpartial.enabled) {
-    imapaintpartial.x1 = x;
-    imapaintpartial.y1 = y;
-    imapaintpartial.x2 = x + w;
-    imapaintpartial.y2 = y + h;
-    imapaintpartial.enabled = 1;
-  }
-  else {
-    imapaintpartial.x1 = min_ii(imapaintpartial.x1, x);
-    imapaintpartial.y1 = min_ii(imapaintpartial.y1, y);
-    imapaintpartial.x2 = max_ii(imapaintpartial.x2, x + w);
-    imapaintpartial.y2 = max_ii(imapaintpartial.y2, y + h);
-  }
+  imapaint_partial_redraw_add(x, y, x + w, y + h);
 
   imapaint_region_tiles(ibuf, x, y, w, h, &tilex, &tiley, &tilew, &tileh);
 
@@ -167,9 +211,11 @@ void ED_imapaint_dirty_region(
 void imapaint_image_update(
     SpaceImage *sima, Image *image, ImBuf *ibuf, ImageUser *iuser, short texpaint)
 {
-  if (imapaintpartial.x1 != imapaintpartial.x2 && imapaintpartial.y1 != imapaintpartial.y2) {
-    IMB_partial_display_buffer_update_delayed(
-        ibuf, imapaintpartial.x1, imapaintpartial.y1, imapaintpartial.x2, imapaintpartial.y2);
+  for (int i = 0; i < imapaintpartial_tot; i++) {
+    const ImagePaintPartialRedraw *pr = &imapaintpartial[i];
+    if (pr->x1 != pr->x2 && pr->y1 != pr->y2) {
+      IMB_partial_display_buffer_update_delayed(ibuf, pr->x1, pr->y1, pr->x2, pr->y2);
+    }
   }
 
   if (ibuf->mipmap[0]) {
@@ -178,11 +224,14 @@ void imapaint_image_update(
 
   /* todo: should set_tpage create ->rect? */
   if (texpaint || (sima && sima->lock)) {
-    int w = imapaintpartial.x2 - imapaintpartial.x1;
-    int h = imapaintpartial.y2 - imapaintpartial.y1;
-    if (w && h) {
-      /* Testing with partial update in uv editor too */
-      GPU_paint_update_image(image, iuser, imapaintpartial.x1, imapaintpartial.y1, w, h);
+    for (int i = 0; i < imapaintpartial_tot; i++) {
+      const ImagePaintPartialRedraw *pr = &imapaintpartial[i];
+      int w = pr->x2 - pr->x1;
+      int h = pr->y2 - pr->y1;
+      if (w && h) {
+        /* Testing with partial update in uv editor too */
+        GPU_paint_update_image(image, iuser, pr->x1, pr->y1, w, h);
+      }
     }
   }
 }
@@ -1849,6 +1849,7 @@ static void do_wpaint_brush_blur_task_cb_ex(void *__restrict userdata,
   const Brush *brush = data->brush;
   const StrokeCache *cache = ss->cache;
   Scene *scene = CTX_data_scene(data->C);
+  const float *precomputed_weight = data->wpd->precomputed_weight;
 
   float brush_size_pressure, brush_alpha_value, brush_alpha_pressure;
   get_brush_alpha_data(
@@ -1878,17 +1879,18 @@ static void do_wpaint_brush_blur_task_cb_ex(void *__restrict userdata,
       /* If the vertex is selected */
       if (!(use_face_sel || use_vert_sel) || v_flag & SELECT) {
         /* Get the average poly weight */
+        const MeshElemMap *vert_to_poly = &gmap->vert_to_poly[v_index];
         int total_hit_loops = 0;
         float weight_final = 0.0f;
-        for (int j = 0; j < gmap->vert_to_poly[v_index].count; j++) {
-          const int p_index = gmap->vert_to_poly[v_index].indices[j];
+        for (int j = 0; j < vert_to_poly->count; j++) {
+          const int p_index = vert_to_poly->indices[j];
           const MPoly *mp = &data->me->mpoly[p_index];
 
           total_hit_loops += mp->totloop;
           for (int k = 0; k < mp->totloop; k++) {
             const int l_index = mp->loopstart + k;
             const MLoop *ml = &data->me->mloop[l_index];
-            weight_final += data->wpd->precomputed_weight[ml->v];
+            weight_final += precomputed_weight[ml->v];
           }
         }
 
@@ -1991,8 +1993,9 @@ static void do_wpaint_brush_smear_task_cb_ex(void *__restrict userdata,
             /* Get the color of the loop in the opposite direction of the brush movement
              * (this callback is specifically for smear.) */
             float weight_final = 0.0;
-            for (int j = 0; j < gmap->vert_to_poly[v_index].count; j++) {
-              const int p_index = gmap->vert_to_poly[v_index].indices[j];
+            const MeshElemMap *vert_to_poly = &gmap->vert_to_poly[v_index];
+            for (int j = 0; j < vert_to_poly->count; j++) {
+              const int p_index = vert_to_poly->indices[j];
               const MPoly *mp = &data->me->mpoly[p_index];
               const MLoop *ml_other = &data->me->mloop[mp->loopstart];
               for (int k = 0; k < mp->totloop; k++, ml_other++) {
@@ -2841,10 +2844,11 @@ static void do_vpaint_brush_calc_average_color_cb_ex(void *__restrict userdata,
         /* If the vertex is selected for painting. */
         const MVert *mv = &data->me->mvert[v_index];
         if (!use_vert_sel || mv->flag & SELECT) {
-          accum->len += gmap->vert_to_loop[v_index].count;
+          const MeshElemMap *vert_to_loop = &gmap->vert_to_loop[v_index];
+          accum->len += vert_to_loop->count;
           /* if a vertex is within the brush region, then add it's color to the blend. */
-          for (int j = 0; j < gmap->vert_to_loop[v_index].count; j++) {
-            const int l_index = gmap->vert_to_loop[v_index].indices[j];
+          for (int j = 0; j < vert_to_loop->count; j++) {
+            const int l_index = vert_to_loop->indices[j];
             col = (char *)(&lcol[l_index]);
             /* Color is squared to compensate the sqrt color encoding. */
             accum->value[0] += col[0] * col[0];
@@ -2884,6 +2888,7 @@ static void do_vpaint_brush_draw_task_cb_ex(void *__restrict userdata,
   const Brush *brush = data->brush;
   const StrokeCache *cache = ss->cache;
   uint *lcol = data->lcol;
+  uint *previous_color = ss->mode.vpaint.previous_color;
   const Scene *scene = CTX_data_scene(data->C);
   float brush_size_pressure, brush_alpha_value, brush_alpha_pressure;
   get_brush_alpha_data(
@@ -2936,24 +2941,26 @@ static void do_vpaint_brush_draw_task_cb_ex(void *__restrict userdata,
             tex_alpha = tex_color_alpha_ubyte(
                 data, data->vpd->vertexcosnos[v_index].co, &color_final);
           }
+          const float final_alpha = 255 * brush_fade * brush_strength * tex_alpha *
+                                    brush_alpha_pressure * grid_alpha;
+
           /* For each poly owning this vert, paint each loop belonging to this vert. */
-          for (int j = 0; j < gmap->vert_to_poly[v_index].count; j++) {
-            const int p_index = gmap->vert_to_poly[v_index].indices[j];
-            const int l_index = gmap->vert_to_loop[v_index].indices[j];
+          const MeshElemMap *vert_to_poly = &gmap->vert_to_poly[v_index];
+          const MeshElemMap *vert_to_loop = &gmap->vert_to_loop[v_index];
+          for (int j = 0; j < vert_to_poly->count; j++) {
+            const int p_index = vert_to_poly->indices[j];
+            const int l_index = vert_to_loop->indices[j];
             BLI_assert(data->me->mloop[l_index].v == v_index);
             const MPoly *mp = &data->me->mpoly[p_index];
             if (!use_face_sel || mp->flag & ME_FACE_SEL) {
               uint color_orig = 0; /* unused when array is NULL */
-              if (ss->mode.vpaint.previous_color != NULL) {
+              if (previous_color != NULL) {
                 /* Get the previous loop color */
-                if (ss->mode.vpaint.previous_color[l_index] == 0) {
-                  ss->mode.vpaint.previous_color[l_index] = lcol[l_index];
+                if (previous_color[l_index] == 0) {
+                  previous_color[l_index] = lcol[l_index];
                 }
-                color_orig = ss->mode.vpaint.previous_color[l_index];
+                color_orig = previous_color[l_index];
               }
-              const float final_alpha = 255 * brush_fade * brush_strength * tex_alpha *
-                                        brush_alpha_pressure * grid_alpha;
-
               /* Mix the new color with the original based on final_alpha. */
               lcol[l_index] = vpaint_blend(data->vp,
                                            lcol[l_index],
@@ -2984,6 +2991,7 @@ static void do_vpaint_brush_blur_task_cb_ex(void *__restrict userdata,
   const Brush *brush = data->brush;
   const StrokeCache *cache = ss->cache;
   uint *lcol = data->lcol;
+  uint *previous_color = ss->mode.vpaint.previous_color;
   float brush_size_pressure, brush_alpha_value, brush_alpha_pressure;
   get_brush_alpha_data(
       scene, ss, brush, &brush_size_pressure, &brush_alpha_value, &brush_alpha_pressure);
@@ -3028,8 +3036,10 @@ static void do_vpaint_brush_blur_task_cb_ex(void *__restrict userdata,
           uint color_final = 0;
           int total_hit_loops = 0;
           uint blend[4] = {0};
-          for (int j = 0; j < gmap->vert_to_poly[v_index].count; j++) {
-            int p_index = gmap->vert_to_poly[v_index].indices[j];
+          const MeshElemMap *vert_to_poly = &gmap->vert_to_poly[v_index];
+          const MeshElemMap *vert_to_loop = &gmap->vert_to_loop[v_index];
+          for (int j = 0; j < vert_to_poly->count; j++) {
+            int p_index = vert_to_poly->indices[j];
             const MPoly *mp = &data->me->mpoly[p_index];
             if (!use_face_sel || mp->flag & ME_FACE_SEL) {
               total_hit_loops += mp->totloop;
@@ -3052,24 +3062,25 @@ static void do_vpaint_brush_blur_task_cb_ex(void *__restrict userdata,
             col[2] = round_fl_to_uchar(sqrtf(divide_round_i(blend[2], total_hit_loops)));
             col[3] = round_fl_to_uchar(sqrtf(divide_round_i(blend[3], total_hit_loops)));
 
+            const float final_alpha = 255 * brush_fade * brush_strength *
+                                      brush_alpha_pressure * grid_alpha;
+
             /* For each poly owning this vert,
              * paint each loop belonging to this vert. */
-            for (int j = 0; j < gmap->vert_to_poly[v_index].count; j++) {
-              const int p_index = gmap->vert_to_poly[v_index].indices[j];
-              const int l_index = gmap->vert_to_loop[v_index].indices[j];
+            for (int j = 0; j < vert_to_poly->count; j++) {
+              const int p_index = vert_to_poly->indices[j];
+              const int l_index = vert_to_loop->indices[j];
               BLI_assert(data->me->mloop[l_index].v == v_index);
               const MPoly *mp = &data->me->mpoly[p_index];
               if (!use_face_sel || mp->flag & ME_FACE_SEL) {
                 uint color_orig = 0; /* unused when array is NULL */
-                if (ss->mode.vpaint.previous_color != NULL) {
+                if (previous_color != NULL) {
                   /* Get the previous loop color */
-                  if (ss->mode.vpaint.previous_color[l_index] == 0) {
-                    ss->mode.vpaint.previous_color[l_index] = lcol[l_index];
+                  if (previous_color[l_index] == 0) {
+                    previous_color[l_index] = lcol[l_index];
                   }
-                  color_orig = ss->mode.vpaint.previous_color[l_index];
+                  color_orig = previous_color[l_index];
                 }
-                const float final_alpha = 255 * brush_fade * brush_strength *
-                                          brush_alpha_pressure * grid_alpha;
                 /* Mix the new color with the original
                  * based on the brush strength and the curve. */
                 lcol[l_index] = vpaint_blend(data->vp,
@@ -3102,6 +3113,7 @@ static void do_vpaint_brush_smear_task_cb_ex(void *__restrict userdata,
   const Brush *brush = data->brush;
   const StrokeCache *cache = ss->cache;
   uint *lcol = data->lcol;
+  uint *previous_color = ss->mode.vpaint.previous_color;
   float brush_size_pressure, brush_alpha_value, brush_alpha_pressure;
   get_brush_alpha_data(
       scene, ss, brush, &brush_size_pressure, &brush_alpha_value, &brush_alpha_pressure);
@@ -3158,9 +3170,11 @@ static void do_vpaint_brush_smear_task_cb_ex(void *__restrict userdata,
             /* Get the color of the loop in the opposite
              * direction of the brush movement */
             uint color_final = 0;
-            for (int j = 0; j < gmap->vert_to_poly[v_index].count; j++) {
-              const int p_index = gmap->vert_to_poly[v_index].indices[j];
-              const int l_index = gmap->vert_to_loop[v_index].indices[j];
+            const MeshElemMap *vert_to_poly = &gmap->vert_to_poly[v_index];
+            const MeshElemMap *vert_to_loop = &gmap->vert_to_loop[v_index];
+            for (int j = 0; j < vert_to_poly->count; j++) {
+              const int p_index = vert_to_poly->indices[j];
+              const int l_index = vert_to_loop->indices[j];
               BLI_assert(data->me->mloop[l_index].v == v_index);
               UNUSED_VARS_NDEBUG(l_index);
               const MPoly *mp = &data->me->mpoly[p_index];
@@ -3197,20 +3211,20 @@ static void do_vpaint_brush_smear_task_cb_ex(void *__restrict userdata,
 
               /* For each poly owning this vert,
                * paint each loop belonging to this vert. */
-              for (int j = 0; j < gmap->vert_to_poly[v_index].count; j++) {
-                const int p_index = gmap->vert_to_poly[v_index].indices[j];
-                const int l_index = gmap->vert_to_loop[v_index].indices[j];
+              for (int j = 0; j < vert_to_poly->count; j++) {
+                const int p_index = vert_to_poly->indices[j];
+                const int l_index = vert_to_loop->indices[j];
                 BLI_assert(data->me->mloop[l_index].v == v_index);
                 const MPoly *mp = &data->me->mpoly[p_index];
                 if (!use_face_sel || mp->flag & ME_FACE_SEL) {
                   /* Get the previous loop color */
                   uint color_orig = 0; /* unused when array is NULL */
-                  if (ss->mode.vpaint.previous_color != NULL) {
+                  if (previous_color != NULL) {
                     /* Get the previous loop color */
-                    if (ss->mode.vpaint.previous_color[l_index] == 0) {
-                      ss->mode.vpaint.previous_color[l_index] = lcol[l_index];
+                    if (previous_color[l_index] == 0) {
+                      previous_color[l_index] = lcol[l_index];
                     }
-                    color_orig = ss->mode.vpaint.previous_color[l_index];
+                    color_orig = previous_color[l_index];
                   }
                   /* Mix the new color with the original
                    * based on the brush strength and the curve. */
@@ -600,6 +600,7 @@ static void sculpt_vertex_neighbors_get_bmesh(SculptSession *ss,
   iter->num_duplicates = 0;
   iter->capacity = SCULPT_VERTEX_NEIGHBOR_FIXED_CAPACITY;
   iter->neighbors = iter->neighbors_fixed;
+  iter->is_cached = false;
 
   BM_ITER_ELEM (l, &liter, v, BM_LOOPS_OF_VERT) {
     const BMVert *adj_v[2] = {l->prev->v, l->next->v};
@@ -616,11 +617,23 @@ static void sculpt_vertex_neighbors_get_faces(SculptSession *ss,
                                               int index,
                                               SculptVertexNeighborIter *iter)
 {
+  if (ss->vnmap) {
+    /* Use the precomputed adjacency (see #SculptSession.vnmap), the neighbors
+     * are read in place and must not be freed by the iterator. */
+    iter->size = ss->vnmap[index].count;
+    iter->num_duplicates = 0;
+    iter->capacity = ss->vnmap[index].count;
+    iter->neighbors = ss->vnmap[index].indices;
+    iter->is_cached = true;
+    return;
+  }
+
   MeshElemMap *vert_map = &ss->pmap[index];
   iter->size = 0;
   iter->num_duplicates = 0;
   iter->capacity = SCULPT_VERTEX_NEIGHBOR_FIXED_CAPACITY;
   iter->neighbors = iter->neighbors_fixed;
+  iter->is_cached = false;
 
   for (int i = 0; i < ss->pmap[index].count; i++) {
     const MPoly *p = &ss->mpoly[vert_map->indices[i]];
@@ -658,6 +671,7 @@ static void sculpt_vertex_neighbors_get_grids(SculptSession *ss,
   iter->num_duplicates = neighbors.num_duplicates;
   iter->capacity = SCULPT_VERTEX_NEIGHBOR_FIXED_CAPACITY;
   iter->neighbors = iter->neighbors_fixed;
+  iter->is_cached = false;
 
   for (int i = 0; i < neighbors.size; i++) {
     sculpt_vertex_neighbor_add(iter,
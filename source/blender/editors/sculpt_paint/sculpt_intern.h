@@ -100,6 +100,9 @@ typedef struct SculptVertexNeighborIter {
   int size;
   int capacity;
   int neighbors_fixed[SCULPT_VERTEX_NEIGHBOR_FIXED_CAPACITY];
+  /* Set when the neighbors point into the cached adjacency on the
+   * #SculptSession, they must then not be modified or freed. */
+  bool is_cached;
 
   /* Internal iterator. */
   int num_duplicates;
@@ -134,7 +137,8 @@ void SCULPT_vertex_neighbors_get(struct SculptSession *ss,
 
 #define SCULPT_VERTEX_NEIGHBORS_ITER_END(neighbor_iterator) \
   } \
-  if (neighbor_iterator.neighbors != neighbor_iterator.neighbors_fixed) { \
+  if (!neighbor_iterator.is_cached && \
+      neighbor_iterator.neighbors != neighbor_iterator.neighbors_fixed) { \
     MEM_freeN(neighbor_iterator.neighbors); \
   } \
   ((void)0)
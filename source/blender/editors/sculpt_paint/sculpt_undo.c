@@ -1338,6 +1338,201 @@ void SCULPT_undo_push_end_ex(const bool use_nested_undo)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compacting
+ *
+ * Nodes store a full copy of the pre-stroke state of every vertex or grid of
+ * the touched PBVH nodes, while a stroke usually modifies only a fraction of
+ * them. Once the stroke is finished the mesh holds the final state, so
+ * entries whose stored values match the current state can never be changed by
+ * the undo swap and are dropped, keeping only the stroke's actual delta in
+ * memory. This runs on undo step encoding, off the interactive stroke path.
+ * \{ */
+
+static void sculpt_undo_node_compact_verts(UndoSculpt *usculpt,
+                                           SculptUndoNode *unode,
+                                           const Mesh *mesh)
+{
+  const bool use_coords = (unode->type == SCULPT_UNDO_COORDS);
+  const float *vmask = NULL;
+  if (!use_coords) {
+    vmask = CustomData_get_layer(&mesh->vdata, CD_PAINT_MASK);
+    if (vmask == NULL) {
+      return;
+    }
+  }
+  else if (unode->orig_co != NULL || unode->shapeName[0] != '\0') {
+    /* With deform modifiers or an active shape key the restore does not
+     * compare against the mesh coordinates, keep the full copy. */
+    return;
+  }
+  const MVert *mvert = mesh->mvert;
+  int tot_modified = 0;
+  for (int i = 0; i < unode->totvert; i++) {
+    if (use_coords ? !equals_v3v3(mvert[unode->index[i]].co, unode->co[i]) :
+                     (vmask[unode->index[i]] != unode->mask[i])) {
+      tot_modified++;
+    }
+  }
+  if (tot_modified == unode->totvert) {
+    return;
+  }
+  float(*co)[3] = NULL;
+  short(*no)[3] = NULL;
+  float *mask = NULL;
+  if (use_coords) {
+    co = MEM_mallocN(sizeof(float[3]) * tot_modified, "SculptUndoNode.co");
+    if (unode->no != NULL) {
+      no = MEM_mallocN(sizeof(short[3]) * tot_modified, "SculptUndoNode.no");
+    }
+  }
+  else {
+    mask = MEM_mallocN(sizeof(float) * tot_modified, "SculptUndoNode.mask");
+  }
+  int *index = MEM_mallocN(sizeof(int) * tot_modified, "SculptUndoNode.index");
+  size_t size_saved = 0;
+  for (int i = 0, j = 0; i < unode->totvert; i++) {
+    if (use_coords ? !equals_v3v3(mvert[unode->index[i]].co, unode->co[i]) :
+                     (vmask[unode->index[i]] != unode->mask[i])) {
+      if (use_coords) {
+        copy_v3_v3(co[j], unode->co[i]);
+        if (no != NULL) {
+          copy_v3_v3_short(no[j], unode->no[i]);
+        }
+      }
+      else {
+        mask[j] = unode->mask[i];
+      }
+      index[j] = unode->index[i];
+      j++;
+    }
+  }
+  if (use_coords) {
+    MEM_freeN(unode->co);
+    unode->co = co;
+    size_saved += sizeof(float[3]);
+    if (unode->no != NULL) {
+      MEM_freeN(unode->no);
+      unode->no = no;
+      size_saved += sizeof(short[3]);
+    }
+  }
+  else {
+    MEM_freeN(unode->mask);
+    unode->mask = mask;
+    size_saved += sizeof(float);
+  }
+  MEM_freeN(unode->index);
+  unode->index = index;
+  size_saved = (size_saved + sizeof(int)) * (unode->totvert - tot_modified);
+  unode->totvert = tot_modified;
+  unode->undo_size -= size_saved;
+  usculpt->undo_size -= size_saved;
+}
+
+static void sculpt_undo_node_compact_grids(UndoSculpt *usculpt,
+                                           SculptUndoNode *unode,
+                                           SubdivCCG *subdiv_ccg)
+{
+  if (unode->gridsize != subdiv_ccg->grid_size) {
+    return;
+  }
+  const bool use_coords = (unode->type == SCULPT_UNDO_COORDS);
+  CCGKey key;
+  BKE_subdiv_ccg_key_top_level(&key, subdiv_ccg);
+  if (!use_coords && !key.has_mask) {
+    return;
+  }
+  const int grid_area = unode->gridsize * unode->gridsize;
+  /* Keep only grids with at least one modified element, a stroke touches a
+   * fraction of the grids covered by the affected PBVH nodes. */
+  int tot_kept = 0;
+  BLI_bitmap *grid_modified = BLI_BITMAP_NEW(unode->totgrid, "grid_modified");
+  for (int j = 0; j < unode->totgrid; j++) {
+    CCGElem *grid = subdiv_ccg->grids[unode->grids[j]];
+    for (int i = 0; i < grid_area; i++) {
+      if (use_coords ?
+              !equals_v3v3(CCG_elem_offset_co(&key, grid, i), unode->co[j * grid_area + i]) :
+              (*CCG_elem_offset_mask(&key, grid, i) != unode->mask[j * grid_area + i])) {
+        BLI_BITMAP_ENABLE(grid_modified, j);
+        tot_kept++;
+        break;
+      }
+    }
+  }
+  if (tot_kept == unode->totgrid) {
+    MEM_freeN(grid_modified);
+    return;
+  }
+  float(*co)[3] = NULL;
+  float *mask = NULL;
+  size_t size_saved = 0;
+  if (use_coords) {
+    co = MEM_mallocN(sizeof(float[3]) * grid_area * tot_kept, "SculptUndoNode.co");
+    size_saved += sizeof(float[3]);
+  }
+  else {
+    mask = MEM_mallocN(sizeof(float) * grid_area * tot_kept, "SculptUndoNode.mask");
+    size_saved += sizeof(float);
+  }
+  int *grids = MEM_mallocN(sizeof(int) * tot_kept, "SculptUndoNode.grids");
+  for (int j = 0, j_kept = 0; j < unode->totgrid; j++) {
+    if (!BLI_BITMAP_TEST(grid_modified, j)) {
+      continue;
+    }
+    if (use_coords) {
+      memcpy(co[j_kept * grid_area], unode->co[j * grid_area], sizeof(float[3]) * grid_area);
+    }
+    else {
+      memcpy(&mask[j_kept * grid_area], &unode->mask[j * grid_area], sizeof(float) * grid_area);
+    }
+    grids[j_kept] = unode->grids[j];
+    j_kept++;
+  }
+  MEM_freeN(grid_modified);
+  if (use_coords) {
+    MEM_freeN(unode->co);
+    unode->co = co;
+    if (unode->no != NULL) {
+      /* Normals are already freed on the stroke end, no reason to compact. */
+      MEM_freeN(unode->no);
+      unode->no = NULL;
+    }
+  }
+  else {
+    MEM_freeN(unode->mask);
+    unode->mask = mask;
+  }
+  MEM_freeN(unode->grids);
+  unode->grids = grids;
+  size_saved = size_saved * grid_area * (unode->totgrid - tot_kept);
+  unode->totgrid = tot_kept;
+  unode->totvert = tot_kept * grid_area;
+  unode->undo_size -= size_saved;
+  usculpt->undo_size -= size_saved;
+}
+
+static void sculpt_undo_compact_nodes(struct Main *bmain, UndoSculpt *usculpt)
+{
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    if (!ELEM(unode->type, SCULPT_UNDO_COORDS, SCULPT_UNDO_MASK)) {
+      continue;
+    }
+    Object *ob = BLI_findstring(&bmain->objects, unode->idname + 2, offsetof(ID, name) + 2);
+    if (ob == NULL || ob->sculpt == NULL) {
+      continue;
+    }
+    if (unode->maxvert) {
+      sculpt_undo_node_compact_verts(usculpt, unode, ob->data);
+    }
+    else if (unode->maxgrid && ob->sculpt->subdiv_ccg != NULL) {
+      sculpt_undo_node_compact_grids(usculpt, unode, ob->sculpt->subdiv_ccg);
+    }
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Implements ED Undo System
  * \{ */
@@ -1362,6 +1557,11 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
   /* Dummy, encoding is done along the way by adding tiles
    * to the current 'SculptUndoStep' added by encode_init. */
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+
+  /* The stroke is finished, drop stored entries which match the final state
+   * of the mesh as they can never be restored. */
+  sculpt_undo_compact_nodes(bmain, &us->data);
+
   us->step.data_size = us->data.undo_size;
 
   SculptUndoNode *unode = us->data.nodes.last;
@@ -378,6 +378,12 @@ static int sound_mixdown_exec(bContext *C, wmOperator *op)
   const int start_frame = scene_eval->r.sfra;
   const int end_frame = scene_eval->r.efra;
 
+  /* Note on performance: the mixdown renders single threaded. Audaspace owns the render loop
+   * (FileWriter::writeReader) and pulls one reader over the shared sequence, which is not safe
+   * to read from multiple threads, so splitting the range over worker readers would need
+   * upstream changes in the library, not here. Video exports are not affected: the FFmpeg
+   * pipeline encodes audio interleaved with the video frames (see #write_audio_frames). */
+
   if (split) {
     result = AUD_mixdown_per_channel(scene_eval->sound_scene,
                                      start_frame * specs.rate / fps,
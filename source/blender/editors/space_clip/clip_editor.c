@@ -58,6 +58,7 @@
 #include "ED_clip.h"
 #include "ED_mask.h"
 #include "ED_screen.h"
+#include "ED_screen_types.h"
 #include "ED_select_utils.h"
 
 #include "WM_api.h"
@@ -720,6 +721,8 @@ typedef struct PrefetchJob {
   MovieClip *clip;
   int start_frame, current_frame, end_frame;
   short render_size, render_flag;
+  /* If true frames after the current one are prefetched first, see #clip_start_prefetch_job. */
+  bool forward;
 } PrefetchJob;
 
 typedef struct PrefetchQueue {
@@ -730,6 +733,9 @@ typedef struct PrefetchQueue {
    * otherwise it goes backwards in time (starting from current frame).
    */
   bool forward;
+  /* Direction the prefetch started in; used to switch direction only once, after the
+   * initial direction ran out of frames. */
+  bool initial_forward;
 
   SpinLock spin;
 
@@ -829,6 +835,7 @@ static uchar *prefetch_thread_next_frame(PrefetchQueue *queue,
                                          int *r_current_frame)
 {
   uchar *mem = NULL;
+  int frame_to_read = -1;
 
   BLI_spin_lock(&queue->spin);
   if (!*queue->stop && !check_prefetch_break() &&
@@ -843,7 +850,7 @@ static uchar *prefetch_thread_next_frame(PrefetchQueue *queue,
                                                    queue->render_flag,
                                                    1);
       /* switch direction if read frames from current up to scene end frames */
-      if (current_frame > queue->end_frame) {
+      if (current_frame > queue->end_frame && queue->initial_forward) {
         queue->current_frame = queue->initial_frame;
         queue->forward = false;
       }
@@ -856,20 +863,34 @@ static uchar *prefetch_thread_next_frame(PrefetchQueue *queue,
                                                    queue->render_size,
                                                    queue->render_flag,
                                                    -1);
+      /* switch direction if read frames from current down to scene start frames,
+       * when the prefetch was started backwards for reverse playback */
+      if (current_frame < queue->start_frame && !queue->initial_forward) {
+        queue->current_frame = queue->initial_frame;
+        queue->forward = true;
+        current_frame = prefetch_find_uncached_frame(clip,
+                                                     queue->current_frame + 1,
+                                                     queue->end_frame,
+                                                     queue->render_size,
+                                                     queue->render_flag,
+                                                     1);
+      }
     }
 
     if (IN_RANGE_INCL(current_frame, queue->start_frame, queue->end_frame)) {
       int frames_processed;
 
-      mem = prefetch_read_file_to_memory(
-          clip, current_frame, queue->render_size, queue->render_flag, r_size);
-
+      frame_to_read = current_frame;
       *r_current_frame = current_frame;
 
       queue->current_frame = current_frame;
 
-      if (queue->forward) {
-        frames_processed = queue->current_frame - queue->initial_frame;
+      if (queue->forward == queue->initial_forward) {
+        frames_processed = abs(queue->current_frame - queue->initial_frame);
+      }
+      else if (queue->forward) {
+        frames_processed = (queue->initial_frame - queue->start_frame) +
+                           (queue->current_frame - queue->initial_frame);
       }
       else {
         frames_processed = (queue->end_frame - queue->initial_frame) +
@@ -882,6 +903,14 @@ static uchar *prefetch_thread_next_frame(PrefetchQueue *queue,
   }
   BLI_spin_unlock(&queue->spin);
 
+  /* Read the file outside of the lock, so the other threads can pick their frames and read
+   * them at the same time. Storing the frame number in the queue above is enough to claim it:
+   * the uncached-frame searches start past #PrefetchQueue.current_frame. */
+  if (frame_to_read != -1) {
+    mem = prefetch_read_file_to_memory(
+        clip, frame_to_read, queue->render_size, queue->render_flag, r_size);
+  }
+
   return mem;
 }
 
@@ -937,6 +966,7 @@ static void start_prefetch_threads(MovieClip *clip,
                                    int end_frame,
                                    short render_size,
                                    short render_flag,
+                                   bool forward,
                                    short *stop,
                                    short *do_update,
                                    float *progress)
@@ -954,7 +984,8 @@ static void start_prefetch_threads(MovieClip *clip,
   queue.end_frame = end_frame;
   queue.render_size = render_size;
   queue.render_flag = render_flag;
-  queue.forward = 1;
+  queue.forward = forward;
+  queue.initial_forward = forward;
 
   queue.stop = stop;
   queue.do_update = do_update;
@@ -1014,6 +1045,7 @@ static void do_prefetch_movie(MovieClip *clip,
                               int end_frame,
                               short render_size,
                               short render_flag,
+                              bool forward,
                               short *stop,
                               short *do_update,
                               float *progress)
@@ -1021,28 +1053,36 @@ static void do_prefetch_movie(MovieClip *clip,
   int frame;
   int frames_processed = 0;
 
-  /* read frames starting from current frame up to scene end frame */
-  for (frame = current_frame; frame <= end_frame; frame++) {
-    if (!prefetch_movie_frame(clip, frame, render_size, render_flag, stop)) {
-      return;
-    }
+  /* With playback running backwards, read the frames before the current one first. */
+  for (int pass = 0; pass < 2; pass++) {
+    const bool pass_forward = forward ? (pass == 0) : (pass != 0);
 
-    frames_processed++;
+    if (pass_forward) {
+      /* read frames starting from current frame up to scene end frame */
+      for (frame = current_frame; frame <= end_frame; frame++) {
+        if (!prefetch_movie_frame(clip, frame, render_size, render_flag, stop)) {
+          return;
+        }
 
-    *do_update = 1;
-    *progress = (float)frames_processed / (end_frame - start_frame);
-  }
+        frames_processed++;
 
-  /* read frames starting from current frame up to scene start frame */
-  for (frame = current_frame; frame >= start_frame; frame--) {
-    if (!prefetch_movie_frame(clip, frame, render_size, render_flag, stop)) {
-      return;
+        *do_update = 1;
+        *progress = (float)frames_processed / (end_frame - start_frame);
+      }
     }
+    else {
+      /* read frames starting from current frame down to scene start frame */
+      for (frame = current_frame; frame >= start_frame; frame--) {
+        if (!prefetch_movie_frame(clip, frame, render_size, render_flag, stop)) {
+          return;
+        }
 
-    frames_processed++;
+        frames_processed++;
 
-    *do_update = 1;
-    *progress = (float)frames_processed / (end_frame - start_frame);
+        *do_update = 1;
+        *progress = (float)frames_processed / (end_frame - start_frame);
+      }
+    }
   }
 }
 
@@ -1058,6 +1098,7 @@ static void prefetch_startjob(void *pjv, short *stop, short *do_update, float *p
                            pj->end_frame,
                            pj->render_size,
                            pj->render_flag,
+                           pj->forward,
                            stop,
                            do_update,
                            progress);
@@ -1070,6 +1111,7 @@ static void prefetch_startjob(void *pjv, short *stop, short *do_update, float *p
                       pj->end_frame,
                       pj->render_size,
                       pj->render_flag,
+                      pj->forward,
                       stop,
                       do_update,
                       progress);
@@ -1170,6 +1212,15 @@ void clip_start_prefetch_job(const bContext *C)
   pj->render_size = sc->user.render_size;
   pj->render_flag = sc->user.render_flag;
 
+  /* Prefetch in the playback direction first, so the frames the user is about to see are
+   * decoded before the ones behind the current frame. */
+  pj->forward = true;
+  const bScreen *screen = CTX_wm_screen(C);
+  if (screen != NULL && screen->animtimer != NULL) {
+    const ScreenAnimData *sad = screen->animtimer->customdata;
+    pj->forward = (sad->flag & ANIMPLAY_FLAG_REVERSE) == 0;
+  }
+
   WM_jobs_customdata_set(wm_job, pj, prefetch_freejob);
   WM_jobs_timer(wm_job, 0.2, NC_MOVIECLIP | ND_DISPLAY, 0);
   WM_jobs_callbacks(wm_job, prefetch_startjob, NULL, NULL, NULL);
@@ -254,6 +254,9 @@ typedef struct FileListEntryCache {
   /* Previews handling. */
   TaskPool *previews_pool;
   ThreadQueue *previews_done;
+  /* Packed thumbnail database of the current directory, shared with the
+   * preview tasks (lookups and additions are thread-safe). */
+  struct IMB_ThumbDB *thumb_db;
 } FileListEntryCache;
 
 /* FileListCache.flags */
@@ -1297,9 +1300,24 @@ static void filelist_cache_preview_runf(TaskPool *__restrict pool, void *taskdat
     source = THB_SOURCE_FONT;
   }
 
-  IMB_thumb_path_lock(preview->path);
-  preview->img = IMB_thumb_manage(preview->path, THB_LARGE, source);
-  IMB_thumb_path_unlock(preview->path);
+  /* Try the packed per-directory database first, one memcpy instead of a PNG decode. */
+  BLI_stat_t st;
+  const bool has_stat = (BLI_stat(preview->path, &st) != -1);
+  if (has_stat && cache->thumb_db) {
+    preview->img = IMB_thumb_db_lookup(
+        cache->thumb_db, preview->path, (int64_t)st.st_mtime, (int64_t)st.st_size);
+  }
+
+  if (preview->img == NULL) {
+    IMB_thumb_path_lock(preview->path);
+    preview->img = IMB_thumb_manage(preview->path, THB_LARGE, source);
+    IMB_thumb_path_unlock(preview->path);
+
+    if (preview->img && has_stat && cache->thumb_db) {
+      IMB_thumb_db_add(
+          cache->thumb_db, preview->path, (int64_t)st.st_mtime, (int64_t)st.st_size, preview->img);
+    }
+  }
 
   /* That way task freeing function won't free th preview, since it does not own it anymore. */
   atomic_cas_ptr((void **)&preview_taskdata->preview, preview, NULL);
@@ -1349,6 +1367,14 @@ static void filelist_cache_previews_clear(FileListEntryCache *cache)
       MEM_freeN(preview);
     }
   }
+
+  /* Flush newly generated thumbnails to the packed database, so the next
+   * visit of this directory loads them all with a single read. */
+  if (cache->thumb_db) {
+    IMB_thumb_db_write(cache->thumb_db);
+    IMB_thumb_db_free(cache->thumb_db);
+    cache->thumb_db = NULL;
+  }
 }
 
 static void filelist_cache_previews_free(FileListEntryCache *cache)
@@ -1395,6 +1421,10 @@ static void filelist_cache_previews_push(FileList *filelist, FileDirEntry *entry
 
     filelist_cache_preview_ensure_running(cache);
 
+    if (cache->thumb_db == NULL) {
+      cache->thumb_db = IMB_thumb_db_read(filelist->filelist.root);
+    }
+
     FileListEntryPreviewTaskData *preview_taskdata = MEM_mallocN(sizeof(*preview_taskdata),
                                                                  __func__);
     preview_taskdata->preview = preview;
@@ -45,6 +45,7 @@
 #include "BKE_blender_version.h"
 #include "BKE_curve.h"
 #include "BKE_displist.h"
+#include "BKE_duplilist.h"
 #include "BKE_editmesh.h"
 #include "BKE_gpencil.h"
 #include "BKE_key.h"
@@ -121,13 +122,15 @@ static bool stats_mesheval(Mesh *me_eval, bool is_selected, SceneStats *stats)
   return true;
 }
 
-static void stats_object(Object *ob, SceneStats *stats, GSet *objects_gset)
+/* Note: \a base_flag is passed separately, for dupli instances it is inherited
+ * from the instancer's base instead of the instanced object. */
+static void stats_object(Object *ob, const int base_flag, SceneStats *stats, GSet *objects_gset)
 {
-  if ((ob->base_flag & BASE_VISIBLE_VIEWLAYER) == 0) {
+  if ((base_flag & BASE_VISIBLE_VIEWLAYER) == 0) {
     return;
   }
 
-  const bool is_selected = (ob->base_flag & BASE_SELECTED) != 0;
+  const bool is_selected = (base_flag & BASE_SELECTED) != 0;
 
   stats->totobj++;
   if (is_selected) {
@@ -212,6 +215,58 @@ static void stats_object(Object *ob, SceneStats *stats, GSet *objects_gset)
   }
 }
 
+static void stats_duplis(
+    Depsgraph *depsgraph, Scene *scene, Object *instancer, SceneStats *stats, GSet *objects_gset)
+{
+  /* Expanding instances through the depsgraph object iterator constructs a temporary
+   * object copy per instance, which is far too slow for scenes instancing many
+   * thousands of objects. Walk the dupli list directly instead: all instances of one
+   * object contribute the same geometry counts (deduplicated through objects_gset),
+   * so only cheap per-instance filtering remains. */
+  const eEvaluationMode eval_mode = DEG_get_mode(depsgraph);
+  const int base_flag = instancer->base_flag | BASE_FROM_DUPLI;
+  ListBase *duplilist = object_duplilist(depsgraph, scene, instancer);
+  Object *ob_prev = NULL;
+  bool ob_visible = false;
+
+  LISTBASE_FOREACH (DupliObject *, dob, duplilist) {
+    Object *ob = dob->ob;
+
+    if (dob->no_draw) {
+      continue;
+    }
+    if (ob->type == OB_MBALL) {
+      /* Metaballs are merged into the basis ball outside of the dupli system. */
+      continue;
+    }
+    /* Hide the original object when it is used for vertex/face instancing by its
+     * parent, matching deg_object_hide_original() in the depsgraph object iterator. */
+    const int hide_original_types = OB_DUPLIVERTS | OB_DUPLIFACES;
+    if ((dob->type & hide_original_types) == 0 && ob->parent &&
+        (ob->parent->transflag & hide_original_types)) {
+      continue;
+    }
+
+    if (ob != ob_prev) {
+      /* Visibility of an instance matches the temporary object the depsgraph iterator
+       * creates: the instanced object carrying the instancer's base flags. Instancers
+       * emit long runs of the same object, so only evaluate this per run. */
+      Object ob_temp = *ob;
+      ob_temp.base_flag = (short)(base_flag | BASE_VISIBLE_DEPSGRAPH);
+      ob_visible = (BKE_object_visibility(&ob_temp, eval_mode) &
+                    (OB_VISIBLE_SELF | OB_VISIBLE_PARTICLES)) != 0;
+      ob_prev = ob;
+    }
+    if (!ob_visible) {
+      continue;
+    }
+
+    stats_object(ob, base_flag, stats, objects_gset);
+  }
+
+  free_object_duplilist(duplilist);
+}
+
 static void stats_object_edit(Object *obedit, SceneStats *stats)
 {
   if (obedit->type == OB_MESH) {
@@ -390,11 +445,22 @@ static void stats_update(Depsgraph *depsgraph, ViewLayer *view_layer)
   }
   else {
     /* Objects */
+    Scene *scene = DEG_get_evaluated_scene(depsgraph);
+    const eEvaluationMode eval_mode = DEG_get_mode(depsgraph);
     GSet *objects_gset = BLI_gset_new(BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
-    DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob_iter) {
-      stats_object(ob_iter, &stats, objects_gset);
+    DEG_OBJECT_ITER_BEGIN (depsgraph,
+                           ob_iter,
+                           DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                               DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET) {
+      const int ob_visibility = BKE_object_visibility(ob_iter, eval_mode);
+      if (ob_visibility & (OB_VISIBLE_SELF | OB_VISIBLE_PARTICLES)) {
+        stats_object(ob_iter, ob_iter->base_flag, &stats, objects_gset);
+      }
+      if ((ob_visibility & OB_VISIBLE_INSTANCES) && (ob_iter->transflag & OB_DUPLI)) {
+        stats_duplis(depsgraph, scene, ob_iter, &stats, objects_gset);
+      }
     }
-    DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
+    DEG_OBJECT_ITER_END;
     BLI_gset_free(objects_gset, NULL);
   }
 
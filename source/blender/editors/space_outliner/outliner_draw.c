@@ -2965,6 +2965,37 @@ static void outliner_set_coord_tree_element(TreeElement *te, int startx, int sta
   }
 }
 
+/**
+ * Set coordinates for a subtree that is entirely below the view,
+ * mirrors the layout logic of #outliner_draw_tree_element without any drawing.
+ */
+static void outliner_set_coord_tree_element_offscreen(SpaceOutliner *soops,
+                                                      TreeElement *te,
+                                                      int startx,
+                                                      int *starty)
+{
+  TreeStoreElem *tselem = TREESTORE(te);
+
+  te->xs = startx;
+  te->ys = *starty;
+  te->xend = startx;
+
+  if (TSELEM_OPEN(tselem, soops)) {
+    *starty -= UI_UNIT_Y;
+
+    LISTBASE_FOREACH (TreeElement *, ten, &te->subtree) {
+      outliner_set_coord_tree_element_offscreen(soops, ten, startx + UI_UNIT_X, starty);
+    }
+  }
+  else {
+    LISTBASE_FOREACH (TreeElement *, ten, &te->subtree) {
+      outliner_set_coord_tree_element(ten, startx, *starty);
+    }
+
+    *starty -= UI_UNIT_Y;
+  }
+}
+
 static void outliner_draw_tree_element(bContext *C,
                                        uiBlock *block,
                                        const uiFontStyle *fstyle,
@@ -2982,12 +3013,15 @@ static void outliner_draw_tree_element(bContext *C,
   float ufac = UI_UNIT_X / 20.0f;
   int offsx = 0;
   eOLDrawState active = OL_DRAWSEL_NONE;
-  uchar text_color[4];
-  UI_GetThemeColor4ubv(TH_TEXT, text_color);
-  float icon_bgcolor[4], icon_border[4];
-  outliner_icon_background_colors(icon_bgcolor, icon_border);
 
   if (*starty + 2 * UI_UNIT_Y >= region->v2d.cur.ymin && *starty <= region->v2d.cur.ymax) {
+    /* Only resolve theme colors for rows that are actually drawn,
+     * with large trees most rows are scrolled out of view. */
+    uchar text_color[4];
+    UI_GetThemeColor4ubv(TH_TEXT, text_color);
+    float icon_bgcolor[4], icon_border[4];
+    outliner_icon_background_colors(icon_bgcolor, icon_border);
+
     const float alpha_fac = ((te->flag & TE_DISABLED) || (te->flag & TE_CHILD_NOT_IN_COLLECTION) ||
                              draw_grayed_out) ?
                                 0.5f :
@@ -3211,6 +3245,12 @@ static void outliner_draw_tree_element(bContext *C,
     *starty -= UI_UNIT_Y;
 
     LISTBASE_FOREACH (TreeElement *, ten, &te->subtree) {
+      /* The remaining rows are all below the view, only their coordinates are needed. */
+      if (*starty + 2 * UI_UNIT_Y < region->v2d.cur.ymin) {
+        outliner_set_coord_tree_element_offscreen(soops, ten, startx + UI_UNIT_X, starty);
+        continue;
+      }
+
       /* check if element needs to be drawn grayed out, but also gray out
        * childs of a grayed out parent (pass on draw_grayed_out to childs) */
       bool draw_childs_grayed_out = draw_grayed_out || (ten->flag & TE_DRAGGING);
@@ -3562,6 +3602,12 @@ static void outliner_draw_tree(bContext *C,
   starty = (int)region->v2d.tot.ymax - UI_UNIT_Y - OL_Y_OFFSET;
   startx = 0;
   LISTBASE_FOREACH (TreeElement *, te, &soops->tree) {
+    if (starty + 2 * UI_UNIT_Y < region->v2d.cur.ymin) {
+      /* The remaining rows are all below the view, only their coordinates are needed. */
+      outliner_set_coord_tree_element_offscreen(soops, te, startx, &starty);
+      continue;
+    }
+
     outliner_draw_tree_element(C,
                                block,
                                fstyle,
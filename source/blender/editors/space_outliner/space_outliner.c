@@ -106,17 +106,30 @@ static void outliner_main_region_free(ARegion *UNUSED(region))
 }
 
 static void outliner_main_region_listener(wmWindow *UNUSED(win),
-                                          ScrArea *UNUSED(area),
+                                          ScrArea *area,
                                           ARegion *region,
                                           wmNotifier *wmn,
                                           const Scene *UNUSED(scene))
 {
+  SpaceOutliner *soops = area->spacedata.first;
+
   /* context changes */
   switch (wmn->category) {
     case NC_SCENE:
       switch (wmn->data) {
         case ND_OB_ACTIVE:
         case ND_OB_SELECT:
+          /* Selection and the active element don't change the element hierarchy,
+           * keep the cached tree and only redraw. Unless an object state filter
+           * is active: then the tree contents depend on the selection state. */
+          if (SUPPORT_FILTER_OUTLINER(soops) &&
+              ELEM(soops->filter_state, SO_FILTER_OB_SELECTED, SO_FILTER_OB_ACTIVE)) {
+            ED_region_tag_redraw(region);
+          }
+          else {
+            ED_region_tag_redraw_no_rebuild(region);
+          }
+          break;
         case ND_OB_VISIBLE:
         case ND_OB_RENDER:
         case ND_MODE:
@@ -143,8 +156,11 @@ static void outliner_main_region_listener(wmWindow *UNUSED(win),
         case ND_BONE_ACTIVE:
         case ND_BONE_SELECT:
         case ND_DRAW:
-        case ND_PARENT:
         case ND_OB_SHADING:
+          /* Display changes only, the tree itself is unaffected. */
+          ED_region_tag_redraw_no_rebuild(region);
+          break;
+        case ND_PARENT:
           ED_region_tag_redraw(region);
           break;
         case ND_CONSTRAINT:
@@ -168,7 +184,7 @@ static void outliner_main_region_listener(wmWindow *UNUSED(win),
     case NC_LAMP:
       /* For updating light icons, when changing light type */
       if (wmn->data == ND_LIGHTING_DRAW) {
-        ED_region_tag_redraw(region);
+        ED_region_tag_redraw_no_rebuild(region);
       }
       break;
     case NC_SPACE:
@@ -294,6 +294,18 @@ static void draw_seq_waveform(View2D *v2d,
     /* Fcurve lookup is quite expensive, so do this after precondition. */
     FCurve *fcu = id_data_find_fcurve(&scene->id, seq, &RNA_Sequence, "volume", 0, NULL);
 
+    /* Pick the pyramid level whose resolution matches the pixel density, so the min/max scan
+     * below covers at most two entries per pixel however far the view is zoomed out. */
+    const float *wave_data = waveform->data;
+    int wave_length = waveform->length;
+    float scale = 1.0f;
+    for (int level = 0; samplestep / scale > 2.0f && level < waveform->num_levels; level++) {
+      scale *= 2.0f;
+      wave_data = waveform->levels[level];
+      wave_length = waveform->levels_length[level];
+    }
+    const float wave_step = samplestep / scale;
+
     GPU_blend(true);
     GPUVertFormat *format = immVertexFormat();
     uint pos = GPU_vertformat_attr_add(format, "pos", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
@@ -302,28 +314,28 @@ static void draw_seq_waveform(View2D *v2d,
     immBegin(GPU_PRIM_TRI_STRIP, length * 2);
 
     for (i = 0; i < length; i++) {
-      float sampleoffset = startsample + ((x1_offset - x1) / stepsize + i) * samplestep;
-      p = sampleoffset;
+      float sampleoffset = (startsample + ((x1_offset - x1) / stepsize + i) * samplestep) / scale;
+      p = min_ii(sampleoffset, wave_length - 1);
 
-      value1 = waveform->data[p * 3];
-      value2 = waveform->data[p * 3 + 1];
+      value1 = wave_data[p * 3];
+      value2 = wave_data[p * 3 + 1];
 
-      if (samplestep > 1.0f) {
-        for (j = p + 1; (j < waveform->length) && (j < p + samplestep); j++) {
-          if (value1 > waveform->data[j * 3]) {
-            value1 = waveform->data[j * 3];
+      if (wave_step > 1.0f) {
+        for (j = p + 1; (j < wave_length) && (j < p + wave_step); j++) {
+          if (value1 > wave_data[j * 3]) {
+            value1 = wave_data[j * 3];
           }
 
-          if (value2 < waveform->data[j * 3 + 1]) {
-            value2 = waveform->data[j * 3 + 1];
+          if (value2 < wave_data[j * 3 + 1]) {
+            value2 = wave_data[j * 3 + 1];
           }
         }
       }
-      else if (p + 1 < waveform->length) {
+      else if (p + 1 < wave_length) {
         /* Use simple linear interpolation. */
         float f = sampleoffset - p;
-        value1 = (1.0f - f) * value1 + f * waveform->data[p * 3 + 3];
-        value2 = (1.0f - f) * value2 + f * waveform->data[p * 3 + 4];
+        value1 = (1.0f - f) * value1 + f * wave_data[p * 3 + 3];
+        value2 = (1.0f - f) * value2 + f * wave_data[p * 3 + 4];
       }
 
       if (fcu && !BKE_fcurve_is_empty(fcu)) {
@@ -1067,6 +1079,101 @@ static void draw_seq_fcurve(
 }
 
 /* Draw visible strips. Bounds check are already made. */
+/* Draw cached thumbnails inside the strip body, one per thumbnail width. Frames that are
+ * not cached yet are queued for the background thumbnail job, they appear on a later
+ * redraw - drawing itself never decodes anything. */
+static void draw_seq_strip_thumbnails(const bContext *C,
+                                      Scene *scene,
+                                      View2D *v2d,
+                                      Sequence *seq,
+                                      float x1,
+                                      float y1,
+                                      float x2,
+                                      float y2,
+                                      float pixelx,
+                                      float pixely)
+{
+  const float thumb_height = y2 - y1;
+  const float thumb_height_px = thumb_height / pixely;
+
+  if (thumb_height_px < 8.0f) {
+    return;
+  }
+
+  /* Aspect of the source when known, guess 16:9 until the first frame was loaded. */
+  const StripElem *se = seq->strip->stripdata;
+  const float aspect = (se && se->orig_height > 0) ?
+                           (float)se->orig_width / (float)se->orig_height :
+                           16.0f / 9.0f;
+
+  /* Frames covered by one thumbnail. Keep it integer, so the cache keys requested here
+   * and the frames rendered by the job line up exactly. */
+  const int frame_step = max_ii(1, (int)roundf(thumb_height_px * aspect * pixelx));
+
+  /* Visible range, aligned to the step so keys stay stable while panning. */
+  int frame_start = (int)x1;
+  if (v2d->cur.xmin > frame_start) {
+    frame_start += ((int)(v2d->cur.xmin - frame_start) / frame_step) * frame_step;
+  }
+  const int frame_end = min_ii((int)ceilf(x2), (int)ceilf(v2d->cur.xmax) + frame_step);
+
+  bool missing = false;
+
+  GPU_blend(true);
+  IMMDrawPixelsTexState state = immDrawPixelsTexSetup(GPU_SHADER_2D_IMAGE_COLOR);
+
+  for (int cfra = frame_start; cfra < frame_end; cfra += frame_step) {
+    ImBuf *ibuf = BKE_sequencer_thumbnail_cache_get(scene, seq, cfra);
+    if (ibuf == NULL) {
+      missing = true;
+      continue;
+    }
+    if (ibuf->rect == NULL || ibuf->x < 1 || ibuf->y < 1) {
+      IMB_freeImBuf(ibuf);
+      continue;
+    }
+
+    const float zoom_y = thumb_height / (float)ibuf->y;
+    const float zoom_x = thumb_height_px * pixelx / (float)ibuf->y;
+
+    /* Crop the last thumbnail instead of drawing past the strip end. */
+    int draw_width = ibuf->x;
+    ImBuf *cropped = NULL;
+    if (cfra + ibuf->x * zoom_x > x2) {
+      draw_width = (int)((x2 - cfra) / zoom_x);
+      if (draw_width < 1) {
+        IMB_freeImBuf(ibuf);
+        break;
+      }
+      cropped = IMB_allocImBuf(draw_width, ibuf->y, 32, IB_rect);
+      IMB_rectcpy(cropped, ibuf, 0, 0, 0, 0, draw_width, ibuf->y);
+      IMB_freeImBuf(ibuf);
+      ibuf = cropped;
+    }
+
+    immDrawPixelsTex(&state,
+                     cfra,
+                     y1,
+                     draw_width,
+                     ibuf->y,
+                     GL_RGBA,
+                     GL_UNSIGNED_BYTE,
+                     GL_NEAREST,
+                     ibuf->rect,
+                     zoom_x,
+                     zoom_y,
+                     NULL);
+
+    IMB_freeImBuf(ibuf);
+  }
+
+  GPU_blend(false);
+
+  if (missing) {
+    sequencer_thumbnail_queue_strip(C, seq, frame_start, frame_end, frame_step);
+  }
+}
+
 static void draw_seq_strip(const bContext *C,
                            SpaceSeq *sseq,
                            Scene *scene,
@@ -1122,6 +1229,12 @@ static void draw_seq_strip(const bContext *C,
     drawmeta_contents(scene, seq, x1, y1, x2, y2);
   }
 
+  /* Draw strip thumbnails. */
+  if (y_threshold && ELEM(seq->type, SEQ_TYPE_MOVIE, SEQ_TYPE_IMAGE)) {
+    draw_seq_strip_thumbnails(
+        C, scene, v2d, seq, x1, y1 + 0.05f, x2, text_margin_y, pixelx, pixely);
+  }
+
   if (sseq->flag & SEQ_SHOW_FCURVES) {
     draw_seq_fcurve(scene, v2d, seq, x1, y1, x2, y2, pixelx);
   }
@@ -30,9 +30,12 @@
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_timecode.h"
 #include "BLI_utildefines.h"
 
+#include "atomic_ops.h"
+
 #include "BLT_translation.h"
 
 #include "DNA_scene_types.h"
@@ -143,23 +146,90 @@ static void proxy_freejob(void *pjv)
   MEM_freeN(pj);
 }
 
+typedef struct ProxyBuildTaskData {
+  struct SeqIndexBuildContext *context;
+
+  short *stop;
+  short *do_update;
+  /* Job progress, shared by all tasks: finished contexts / total contexts. */
+  float *progress;
+  int *num_finished;
+  int num_total;
+} ProxyBuildTaskData;
+
+static void proxy_build_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ProxyBuildTaskData *data = taskdata;
+  float task_progress = 0.0f;
+  short task_do_update = false;
+
+  BKE_sequencer_proxy_rebuild(data->context, data->stop, &task_do_update, &task_progress);
+
+  const int num_finished = atomic_add_and_fetch_int32(data->num_finished, 1);
+  *data->progress = (float)num_finished / data->num_total;
+  *data->do_update = true;
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, short *stop, short *do_update, float *progress)
 {
   ProxyJob *pj = pjv;
   LinkData *link;
+  const int num_total = BLI_listbase_count(&pj->queue);
+  int num_finished = 0;
+  int num_tasks = 0;
+  ProxyBuildTaskData *tasks_data = MEM_callocN(
+      sizeof(ProxyBuildTaskData) * max_ii(num_total, 1), "proxy build tasks");
+
+  /* Movie strips can be rebuilt concurrently, every context owns a private decoder. The
+   * remaining strip types render through the sequencer pipeline and are processed on this
+   * thread while the pool works. */
+  TaskPool *task_pool = BLI_task_pool_create(NULL, TASK_PRIORITY_LOW);
+
+  for (link = pj->queue.first; link; link = link->next) {
+    struct SeqIndexBuildContext *context = link->data;
+
+    if (BKE_sequencer_proxy_rebuild_parallel_supported(context)) {
+      ProxyBuildTaskData *data = &tasks_data[num_tasks++];
+
+      data->context = context;
+      data->stop = stop;
+      data->do_update = do_update;
+      data->progress = progress;
+      data->num_finished = &num_finished;
+      data->num_total = num_total;
+
+      BLI_task_pool_push(task_pool, proxy_build_task, data, false, NULL);
+    }
+  }
 
   for (link = pj->queue.first; link; link = link->next) {
     struct SeqIndexBuildContext *context = link->data;
 
+    if (BKE_sequencer_proxy_rebuild_parallel_supported(context)) {
+      continue;
+    }
+
     BKE_sequencer_proxy_rebuild(context, stop, do_update, progress);
 
+    atomic_add_and_fetch_int32(&num_finished, 1);
+    *progress = (float)num_finished / num_total;
+    *do_update = true;
+
     if (*stop) {
-      pj->stop = 1;
-      fprintf(stderr, "Canceling proxy rebuild on users request...\n");
       break;
     }
   }
+
+  /* A stop request is seen by the running tasks themselves, they check it per frame. */
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+  MEM_freeN(tasks_data);
+
+  if (*stop) {
+    pj->stop = 1;
+    fprintf(stderr, "Canceling proxy rebuild on users request...\n");
+  }
 }
 
 static void proxy_endjob(void *pjv)
@@ -200,6 +200,13 @@ void SEQUENCER_OT_view_ghost_border(struct wmOperatorType *ot);
 /* sequencer_preview.c */
 void sequencer_preview_add_sound(const struct bContext *C, struct Sequence *seq);
 
+/* sequencer_thumbnails.c */
+void sequencer_thumbnail_queue_strip(const struct bContext *C,
+                                     struct Sequence *seq,
+                                     int frame_start,
+                                     int frame_end,
+                                     int frame_step);
+
 /* sequencer_add.c */
 int sequencer_image_seq_get_minmax_frame(struct wmOperator *op,
                                          int sfra,
@@ -0,0 +1,155 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2001-2002 by NaN Holding BV.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup spseq
+ *
+ * Background job rendering strip thumbnails for the timeline. Requests are queued by the
+ * drawing code for frames that are visible but not in the thumbnail cache yet, decoding
+ * happens on the job thread so playback and scrubbing are never blocked.
+ */
+
+#include "DNA_sequence_types.h"
+
+#include "BLI_listbase.h"
+#include "BLI_threads.h"
+
+#include "BKE_context.h"
+#include "BKE_global.h"
+#include "BKE_sequencer.h"
+
+#include "WM_api.h"
+#include "WM_types.h"
+
+#include "ED_screen.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "sequencer_intern.h"
+
+typedef struct ThumbnailJob {
+  ListBase requests;
+  ThreadMutex *mutex;
+  struct Main *bmain;
+  Scene *scene;
+} ThumbnailJob;
+
+typedef struct ThumbnailRequest {
+  struct ThumbnailRequest *next, *prev;
+  Sequence *seq;
+  int frame_start;
+  int frame_end;
+  int frame_step;
+} ThumbnailRequest;
+
+static void free_thumbnail_job(void *data)
+{
+  ThumbnailJob *tj = (ThumbnailJob *)data;
+
+  BLI_mutex_free(tj->mutex);
+  BLI_freelistN(&tj->requests);
+  MEM_freeN(tj);
+}
+
+/* Only this runs inside thread. */
+static void thumbnail_startjob(void *data, short *stop, short *do_update, float *UNUSED(progress))
+{
+  ThumbnailJob *tj = data;
+
+  BLI_mutex_lock(tj->mutex);
+  ThumbnailRequest *req = tj->requests.first;
+  BLI_mutex_unlock(tj->mutex);
+
+  while (req && !*stop && !G.is_break) {
+    BKE_sequencer_thumbnails_render(
+        tj->bmain, tj->scene, req->seq, req->frame_start, req->frame_end, req->frame_step, stop);
+
+    *do_update = true;
+
+    BLI_mutex_lock(tj->mutex);
+    BLI_freelinkN(&tj->requests, req);
+    req = tj->requests.first;
+    BLI_mutex_unlock(tj->mutex);
+  }
+}
+
+static void thumbnail_endjob(void *data)
+{
+  ThumbnailJob *tj = data;
+
+  WM_main_add_notifier(NC_SCENE | ND_SEQUENCER, tj->scene);
+}
+
+void sequencer_thumbnail_queue_strip(
+    const bContext *C, Sequence *seq, int frame_start, int frame_end, int frame_step)
+{
+  wmJob *wm_job;
+  ThumbnailJob *tj;
+
+  wm_job = WM_jobs_get(CTX_wm_manager(C),
+                       CTX_wm_window(C),
+                       CTX_data_scene(C),
+                       "Strip Thumbnails",
+                       0,
+                       WM_JOB_TYPE_SEQ_BUILD_THUMBNAIL);
+
+  tj = WM_jobs_customdata_get(wm_job);
+
+  if (!tj) {
+    tj = MEM_callocN(sizeof(ThumbnailJob), "thumbnail job");
+
+    tj->mutex = BLI_mutex_alloc();
+    tj->bmain = CTX_data_main(C);
+    tj->scene = CTX_data_scene(C);
+
+    WM_jobs_customdata_set(wm_job, tj, free_thumbnail_job);
+    WM_jobs_timer(wm_job, 0.1, NC_SCENE | ND_SEQUENCER, NC_SCENE | ND_SEQUENCER);
+    WM_jobs_callbacks(wm_job, thumbnail_startjob, NULL, NULL, thumbnail_endjob);
+  }
+
+  BLI_mutex_lock(tj->mutex);
+
+  /* Update the pending request of this strip instead of queuing duplicates,
+   * drawing re-requests the same range on every redraw until thumbnails appear. */
+  ThumbnailRequest *req;
+  for (req = tj->requests.first; req; req = req->next) {
+    if (req->seq == seq) {
+      req->frame_start = frame_start;
+      req->frame_end = frame_end;
+      req->frame_step = frame_step;
+      break;
+    }
+  }
+
+  if (req == NULL) {
+    req = MEM_callocN(sizeof(ThumbnailRequest), "thumbnail request");
+    req->seq = seq;
+    req->frame_start = frame_start;
+    req->frame_end = frame_end;
+    req->frame_step = frame_step;
+    BLI_addtail(&tj->requests, req);
+  }
+
+  BLI_mutex_unlock(tj->mutex);
+
+  if (!WM_jobs_is_running(wm_job)) {
+    G.is_break = false;
+    WM_jobs_start(CTX_wm_manager(C), wm_job);
+  }
+}
@@ -156,7 +156,8 @@ static void text_listener(wmWindow *UNUSED(win),
         case NA_EDITED:
           if (st->text) {
             text_drawcache_tag_update(st, 1);
-            text_update_edited(st->text);
+            /* Line formats are freed by the edit functions themselves,
+             * drawing re-formats incrementally from the edited lines. */
           }
 
           ED_area_tag_redraw(area);
@@ -1596,12 +1596,14 @@ void draw_text_main(SpaceText *st, ARegion *region)
   /* update rects for scroll */
   calc_text_rcts(st, region, &scroll, &back); /* scroll will hold the entire bar size */
 
-  /* update syntax formatting if needed */
+  /* Update syntax formatting if needed. Lines with a format computed from an
+   * unchanged continuation state are kept, so this only re-formats from edited
+   * lines until the state converges (see #text_format_line_is_valid). */
   tft = ED_text_format_get(text);
   tmp = text->lines.first;
   lineno = 0;
   for (i = 0; i < st->top && tmp; i++) {
-    if (tdc.syntax_highlight && !tmp->format) {
+    if (tdc.syntax_highlight && !text_format_line_is_valid(tmp)) {
       tft->format_line(st, tmp, false);
     }
 
@@ -1661,7 +1663,7 @@ void draw_text_main(SpaceText *st, ARegion *region)
   UI_FontThemeColor(tdc.font_id, TH_TEXT);
 
   for (i = 0; y > clip_min_y && i < viewlines && tmp; i++, tmp = tmp->next) {
-    if (tdc.syntax_highlight && !tmp->format) {
+    if (tdc.syntax_highlight && !text_format_line_is_valid(tmp)) {
       tft->format_line(st, tmp, false);
     }
 
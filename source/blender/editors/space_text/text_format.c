@@ -123,17 +123,18 @@ int flatten_string_strlen(FlattenString *fs, const char *str)
  * as needed. Allocation is done here, alone, to ensure consistency. */
 int text_check_format_len(TextLine *line, uint len)
 {
+  /* Terminator, continuation char and the continuation the line started from. */
   if (line->format) {
     if (strlen(line->format) < len) {
       MEM_freeN(line->format);
-      line->format = MEM_mallocN(len + 2, "SyntaxFormat");
+      line->format = MEM_mallocN(len + 3, "SyntaxFormat");
       if (!line->format) {
         return 0;
       }
     }
   }
   else {
-    line->format = MEM_mallocN(len + 2, "SyntaxFormat");
+    line->format = MEM_mallocN(len + 3, "SyntaxFormat");
     if (!line->format) {
       return 0;
     }
@@ -142,6 +143,39 @@ int text_check_format_len(TextLine *line, uint len)
   return 1;
 }
 
+/* Continuation state that formatting of the next line should start from. */
+static char text_format_line_cont(const TextLine *line)
+{
+  if (line == NULL || line->format == NULL) {
+    return FMT_CONT_NOP;
+  }
+  return line->format[strlen(line->format) + 1];
+}
+
+/**
+ * Check that the stored format of \a line was computed with the continuation
+ * state that currently precedes it, so it can be reused as-is.
+ *
+ * This is what makes re-highlighting incremental: an edited line has its
+ * format freed, and when its new continuation state differs from before, the
+ * stored formats of the following lines fail this check one by one, until the
+ * state converges again. Unaffected lines keep their formats.
+ *
+ * Only valid when the previous lines have been validated already,
+ * process lines front to back.
+ */
+bool text_format_line_is_valid(const TextLine *line)
+{
+  if (line->format == NULL) {
+    return false;
+  }
+  if (line->prev != NULL && line->prev->format == NULL) {
+    /* State of the previous line is unknown. */
+    return false;
+  }
+  return line->format[strlen(line->format) + 2] == text_format_line_cont(line->prev);
+}
+
 /**
  * Fill the string with formatting constant,
  * advancing \a str_p and \a fmt_p
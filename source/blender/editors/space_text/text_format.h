@@ -52,6 +52,7 @@ void flatten_string_free(FlattenString *fs);
 int flatten_string_strlen(FlattenString *fs, const char *str);
 
 int text_check_format_len(TextLine *line, unsigned int len);
+bool text_format_line_is_valid(const TextLine *line);
 void text_format_fill(const char **str_p, char **fmt_p, const char type, const int len);
 void text_format_fill_ascii(const char **str_p, char **fmt_p, const char type, const int len);
 
@@ -66,7 +67,9 @@ typedef struct TextFormatType {
    * may contain any of the following characters:
    *
    * It is terminated with a null-terminator '\0' followed by a continuation
-   * flag indicating whether the line is part of a multi-line string.
+   * flag indicating whether the line is part of a multi-line string,
+   * followed by the continuation flag the line was formatted from
+   * (used by #text_format_line_is_valid for incremental re-highlighting).
    *
    * See: FMT_TYPE_ enums below
    */
@@ -206,7 +206,7 @@ static void txtfmt_osl_format_line(SpaceText *st, TextLine *line, const bool do_
   FlattenString fs;
   const char *str;
   char *fmt;
-  char cont_orig, cont, find, prev = ' ';
+  char cont_orig, cont, cont_prev, find, prev = ' ';
   int len, i;
 
   /* Get continuation from previous line */
@@ -218,6 +218,7 @@ static void txtfmt_osl_format_line(SpaceText *st, TextLine *line, const bool do_
   else {
     cont = FMT_CONT_NOP;
   }
+  cont_prev = cont;
 
   /* Get original continuation from this line */
   if (line->format != NULL) {
@@ -350,10 +351,13 @@ static void txtfmt_osl_format_line(SpaceText *st, TextLine *line, const bool do_
     str++;
   }
 
-  /* Terminate and add continuation char */
+  /* Terminate and add continuation char,
+   * and the continuation this line started from (see text_format_line_is_valid) */
   *fmt = '\0';
   fmt++;
   *fmt = cont;
+  fmt++;
+  *fmt = cont_prev;
 
   /* If continuation has changed and we're allowed, process the next line */
   if (cont != cont_orig && do_next && line->next) {
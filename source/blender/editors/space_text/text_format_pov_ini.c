@@ -364,7 +364,7 @@ static void txtfmt_pov_ini_format_line(SpaceText *st, TextLine *line, const bool
   FlattenString fs;
   const char *str;
   char *fmt;
-  char cont_orig, cont, find, prev = ' ';
+  char cont_orig, cont, cont_prev, find, prev = ' ';
   int len, i;
 
   /* Get continuation from previous line */
@@ -376,6 +376,7 @@ static void txtfmt_pov_ini_format_line(SpaceText *st, TextLine *line, const bool
   else {
     cont = FMT_CONT_NOP;
   }
+  cont_prev = cont;
 
   /* Get original continuation from this line */
   if (line->format != NULL) {
@@ -503,10 +504,13 @@ static void txtfmt_pov_ini_format_line(SpaceText *st, TextLine *line, const bool
     str++;
   }
 
-  /* Terminate and add continuation char */
+  /* Terminate and add continuation char,
+   * and the continuation this line started from (see text_format_line_is_valid) */
   *fmt = '\0';
   fmt++;
   *fmt = cont;
+  fmt++;
+  *fmt = cont_prev;
 
   /* If continuation has changed and we're allowed, process the next line */
   if (cont != cont_orig && do_next && line->next) {
@@ -31,6 +31,7 @@
 #include "BLI_linklist_stack.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_crazyspace.h"
@@ -667,10 +668,122 @@ static void VertsToTransData(TransInfo *t,
   }
 }
 
+struct TransMeshVertFillData {
+  TransInfo *t;
+  TransDataContainer *tc;
+  BMEditMesh *em;
+  const struct TransIslandData *island_data;
+
+  /** Maps vertex index to the slot in #TransDataContainer.data (-1 to skip). */
+  const int *dest_map;
+  const int *dists_index;
+  const float *dists;
+
+  float (*quats)[4];
+  float (*defmats)[3][3];
+  float (*mtx)[3];
+  float (*smtx)[3];
+
+  int cd_vert_bweight_offset;
+  int prop_mode;
+  bool is_snap_rotate;
+};
+
+static void createTransEditVerts_fill_fn(void *__restrict userdata,
+                                         const int a,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct TransMeshVertFillData *data = userdata;
+  TransDataContainer *tc = data->tc;
+  BMesh *bm = data->em->bm;
+
+  const int slot = data->dest_map[a];
+  if (slot == -1) {
+    return;
+  }
+
+  BMVert *eve = BM_vert_at_index(bm, a);
+  TransData *tob = &tc->data[slot];
+  TransDataExtension *tx = tc->data_ext ? &tc->data_ext[slot] : NULL;
+
+  int island_index = -1;
+  if (data->island_data->island_vert_map) {
+    const int connected_index = (data->dists_index && data->dists_index[a] != -1) ?
+                                    data->dists_index[a] :
+                                    a;
+    island_index = data->island_data->island_vert_map[connected_index];
+  }
+
+  float *bweight = (data->cd_vert_bweight_offset != -1) ?
+                       BM_ELEM_CD_GET_VOID_P(eve, data->cd_vert_bweight_offset) :
+                       NULL;
+
+  /* Do not use the island center in case we are using islands
+   * only to get axis for snap/rotate to normal... */
+  VertsToTransData(
+      data->t, tob, tx, data->em, eve, bweight, data->island_data, island_index, data->is_snap_rotate);
+
+  /* selected */
+  if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+    tob->flag |= TD_SELECTED;
+  }
+
+  if (data->prop_mode) {
+    if (data->prop_mode & T_PROP_CONNECTED) {
+      tob->dist = data->dists[a];
+    }
+    else {
+      tob->flag |= TD_NOTCONNECTED;
+      tob->dist = FLT_MAX;
+    }
+  }
+
+  /* CrazySpace */
+  const bool use_quats = data->quats && BM_elem_flag_test(eve, BM_ELEM_TAG);
+  if (use_quats || data->defmats) {
+    float mat[3][3], qmat[3][3], imat[3][3];
+
+    /* Use both or either quat and defmat correction. */
+    if (use_quats) {
+      quat_to_mat3(qmat, data->quats[BM_elem_index_get(eve)]);
+
+      if (data->defmats) {
+        mul_m3_series(mat, data->defmats[a], qmat, data->mtx);
+      }
+      else {
+        mul_m3_m3m3(mat, data->mtx, qmat);
+      }
+    }
+    else {
+      mul_m3_m3m3(mat, data->mtx, data->defmats[a]);
+    }
+
+    invert_m3_m3(imat, mat);
+
+    copy_m3_m3(tob->smtx, imat);
+    copy_m3_m3(tob->mtx, mat);
+  }
+  else {
+    copy_m3_m3(tob->smtx, data->smtx);
+    copy_m3_m3(tob->mtx, data->mtx);
+  }
+
+  if (tc->use_mirror_axis_any) {
+    if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_X;
+    }
+    if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Y;
+    }
+    if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Z;
+    }
+  }
+}
+
 void createTransEditVerts(TransInfo *t)
 {
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    TransDataExtension *tx = NULL;
     BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
     Mesh *me = tc->obedit->data;
     BMesh *bm = em->bm;
@@ -765,8 +878,7 @@ void createTransEditVerts(TransInfo *t)
        * but this stores loads of extra stuff, for TFM_SHRINKFATTEN its even more overkill
        * since we may not use the 'alt' transform mode to maintain shell thickness,
        * but with generic transform code its hard to lazy init vars */
-      tx = tc->data_ext = MEM_callocN(tc->data_len * sizeof(TransDataExtension),
-                                      "TransObData ext");
+      tc->data_ext = MEM_callocN(tc->data_len * sizeof(TransDataExtension), "TransObData ext");
     }
 
     copy_m3_m4(mtx, tc->obedit->obmat);
@@ -831,100 +943,63 @@ void createTransEditVerts(TransInfo *t)
       }
     }
 
-    TransData *tob = tc->data;
+    /* Mirror centers and the destination slot of every vertex are found in a cheap serial pass,
+     * the heavy per-vertex setup (#VertsToTransData, crazy-space correction)
+     * then runs in parallel over the vertex indices. */
+    int *dest_map = MEM_mallocN(sizeof(int) * bm->totvert, __func__);
     TransDataMirror *td_mirror = tc->data_mirror;
+    int tob_index = 0;
     BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, a) {
+      dest_map[a] = -1;
       if (BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
         continue;
       }
-      else {
+
+      if (mirror_bitmap && BLI_BITMAP_TEST(mirror_bitmap, a)) {
         int island_index = -1;
         if (island_data.island_vert_map) {
           const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
           island_index = island_data.island_vert_map[connected_index];
         }
 
-        if (mirror_bitmap && BLI_BITMAP_TEST(mirror_bitmap, a)) {
-          transdata_center_get(
-              &island_data, island_index, is_snap_rotate, td_mirror->iloc, td_mirror->center);
-
-          td_mirror++;
-        }
-        else if (prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          float *bweight = (cd_vert_bweight_offset != -1) ?
-                               BM_ELEM_CD_GET_VOID_P(eve, cd_vert_bweight_offset) :
-                               NULL;
-
-          /* Do not use the island center in case we are using islands
-           * only to get axis for snap/rotate to normal... */
-          VertsToTransData(
-              t, tob, tx, em, eve, bweight, &island_data, island_index, is_snap_rotate);
-          if (tx) {
-            tx++;
-          }
-
-          /* selected */
-          if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-            tob->flag |= TD_SELECTED;
-          }
+        transdata_center_get(
+            &island_data, island_index, is_snap_rotate, td_mirror->iloc, td_mirror->center);
 
-          if (prop_mode) {
-            if (prop_mode & T_PROP_CONNECTED) {
-              tob->dist = dists[a];
-            }
-            else {
-              tob->flag |= TD_NOTCONNECTED;
-              tob->dist = FLT_MAX;
-            }
-          }
-
-          /* CrazySpace */
-          const bool use_quats = quats && BM_elem_flag_test(eve, BM_ELEM_TAG);
-          if (use_quats || defmats) {
-            float mat[3][3], qmat[3][3], imat[3][3];
-
-            /* Use both or either quat and defmat correction. */
-            if (use_quats) {
-              quat_to_mat3(qmat, quats[BM_elem_index_get(eve)]);
-
-              if (defmats) {
-                mul_m3_series(mat, defmats[a], qmat, mtx);
-              }
-              else {
-                mul_m3_m3m3(mat, mtx, qmat);
-              }
-            }
-            else {
-              mul_m3_m3m3(mat, mtx, defmats[a]);
-            }
-
-            invert_m3_m3(imat, mat);
-
-            copy_m3_m3(tob->smtx, imat);
-            copy_m3_m3(tob->mtx, mat);
-          }
-          else {
-            copy_m3_m3(tob->smtx, smtx);
-            copy_m3_m3(tob->mtx, mtx);
-          }
+        td_mirror++;
+      }
+      else if (prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+        dest_map[a] = tob_index++;
+      }
+    }
+    BLI_assert(tob_index == tc->data_len);
 
-          if (tc->use_mirror_axis_any) {
-            if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
-              tob->flag |= TD_MIRROR_EDGE_X;
-            }
-            if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
-              tob->flag |= TD_MIRROR_EDGE_Y;
-            }
-            if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
-              tob->flag |= TD_MIRROR_EDGE_Z;
-            }
-          }
+    BM_mesh_elem_table_ensure(bm, BM_VERT);
 
-          tob++;
-        }
-      }
+    {
+      struct TransMeshVertFillData fill_data = {
+          .t = t,
+          .tc = tc,
+          .em = em,
+          .island_data = &island_data,
+          .dest_map = dest_map,
+          .dists_index = dists_index,
+          .dists = dists,
+          .quats = quats,
+          .defmats = defmats,
+          .mtx = mtx,
+          .smtx = smtx,
+          .cd_vert_bweight_offset = cd_vert_bweight_offset,
+          .prop_mode = prop_mode,
+          .is_snap_rotate = is_snap_rotate,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (bm->totvert > 1024);
+      BLI_task_parallel_range(0, bm->totvert, &fill_data, createTransEditVerts_fill_fn, &settings);
     }
 
+    MEM_freeN(dest_map);
+
     if (island_data.center) {
       MEM_freeN(island_data.center);
     }
@@ -1374,6 +1449,53 @@ static void transform_apply_to_mirror(TransInfo *t)
   }
 }
 
+/**
+ * Recompute the normals affected by the verts this container transforms,
+ * a full #BM_mesh_normals_update each mouse-move is wasted work on dense meshes.
+ */
+static void tc_mesh_normals_update(TransDataContainer *tc, BMEditMesh *em)
+{
+  BMesh *bm = em->bm;
+
+  /* With proportional editing (or nearly everything selected) most of the mesh moves,
+   * the full update is faster then since it avoids gathering the affected sets. */
+  if ((tc->data_len + tc->data_mirror_len) > (bm->totvert / 2)) {
+    EDBM_mesh_normals_update(em);
+    return;
+  }
+
+  BLI_bitmap *verts_mask = BLI_BITMAP_NEW(bm->totvert, __func__);
+  int verts_mask_count = 0;
+
+  BM_mesh_elem_index_ensure(bm, BM_VERT);
+
+  TransData *td = tc->data;
+  for (int i = 0; i < tc->data_len; i++, td++) {
+    const int v_index = BM_elem_index_get((BMVert *)td->extra);
+    if (!BLI_BITMAP_TEST(verts_mask, v_index)) {
+      BLI_BITMAP_ENABLE(verts_mask, v_index);
+      verts_mask_count++;
+    }
+  }
+
+  TransDataMirror *td_mirror = tc->data_mirror;
+  for (int i = 0; i < tc->data_mirror_len; i++, td_mirror++) {
+    const int v_index = BM_elem_index_get((BMVert *)td_mirror->extra);
+    if (!BLI_BITMAP_TEST(verts_mask, v_index)) {
+      BLI_BITMAP_ENABLE(verts_mask, v_index);
+      verts_mask_count++;
+    }
+  }
+
+  BMPartialUpdate *bmpinfo = BM_mesh_partial_create_from_verts(bm, verts_mask, verts_mask_count);
+
+  MEM_freeN(verts_mask);
+
+  BM_mesh_normals_update_with_partial(bmpinfo);
+
+  BM_mesh_partial_destroy(bmpinfo);
+}
+
 void recalcData_mesh(TransInfo *t)
 {
   /* mirror modifier clipping? */
@@ -1397,7 +1519,7 @@ void recalcData_mesh(TransInfo *t)
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
     DEG_id_tag_update(tc->obedit->data, 0); /* sets recalc flags */
     BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
-    EDBM_mesh_normals_update(em);
+    tc_mesh_normals_update(tc, em);
     BKE_editmesh_looptri_calc(em);
   }
 }
@@ -27,6 +27,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -590,6 +591,64 @@ static void editmesh_looptri_raycast_backface_culling_cb(void *userdata,
   }
 }
 
+/**
+ * Lookup (or lazily build) the looptri BVH-tree of \a me,
+ * updating cached pointers when the mesh changed since the last use.
+ *
+ * \return NULL when the mesh has no tree (no polygons).
+ */
+static BVHTreeFromMesh *raycast_mesh_treedata_ensure(SnapObjectContext *sctx,
+                                                     Object *ob,
+                                                     Mesh *me,
+                                                     bool use_hide)
+{
+  SnapObjectData *sod = snap_object_data_mesh_get(sctx, ob);
+
+  BVHTreeFromMesh *treedata = &sod->treedata_mesh;
+
+  /* The tree is owned by the Mesh and may have been freed since we last used. */
+  if (treedata->tree) {
+    BLI_assert(treedata->cached);
+    if (!bvhcache_has_tree(me->runtime.bvh_cache, treedata->tree)) {
+      free_bvhtree_from_mesh(treedata);
+    }
+    else {
+      /* Update Pointers. */
+      if (treedata->vert && treedata->vert_allocated == false) {
+        treedata->vert = me->mvert;
+      }
+      if (treedata->loop && treedata->loop_allocated == false) {
+        treedata->loop = me->mloop;
+      }
+      if (treedata->looptri && treedata->looptri_allocated == false) {
+        treedata->looptri = BKE_mesh_runtime_looptri_ensure(me);
+      }
+      /* required for snapping with occlusion. */
+      treedata->edge = me->medge;
+      sod->poly = me->mpoly;
+    }
+  }
+
+  if (treedata->tree == NULL) {
+    if (use_hide) {
+      BKE_bvhtree_from_mesh_get(treedata, me, BVHTREE_FROM_LOOPTRI_NO_HIDDEN, 4);
+    }
+    else {
+      BKE_bvhtree_from_mesh_get(treedata, me, BVHTREE_FROM_LOOPTRI, 4);
+    }
+
+    /* required for snapping with occlusion. */
+    treedata->edge = me->medge;
+    sod->poly = me->mpoly;
+
+    if (treedata->tree == NULL) {
+      return NULL;
+    }
+  }
+
+  return treedata;
+}
+
 static bool raycastMesh(SnapObjectContext *sctx,
                         const float ray_start[3],
                         const float ray_dir[3],
@@ -653,48 +712,9 @@ static bool raycastMesh(SnapObjectContext *sctx,
     len_diff = 0.0f;
   }
 
-  SnapObjectData *sod = snap_object_data_mesh_get(sctx, ob);
-
-  BVHTreeFromMesh *treedata = &sod->treedata_mesh;
-
-  /* The tree is owned by the Mesh and may have been freed since we last used. */
-  if (treedata->tree) {
-    BLI_assert(treedata->cached);
-    if (!bvhcache_has_tree(me->runtime.bvh_cache, treedata->tree)) {
-      free_bvhtree_from_mesh(treedata);
-    }
-    else {
-      /* Update Pointers. */
-      if (treedata->vert && treedata->vert_allocated == false) {
-        treedata->vert = me->mvert;
-      }
-      if (treedata->loop && treedata->loop_allocated == false) {
-        treedata->loop = me->mloop;
-      }
-      if (treedata->looptri && treedata->looptri_allocated == false) {
-        treedata->looptri = BKE_mesh_runtime_looptri_ensure(me);
-      }
-      /* required for snapping with occlusion. */
-      treedata->edge = me->medge;
-      sod->poly = me->mpoly;
-    }
-  }
-
-  if (treedata->tree == NULL) {
-    if (use_hide) {
-      BKE_bvhtree_from_mesh_get(treedata, me, BVHTREE_FROM_LOOPTRI_NO_HIDDEN, 4);
-    }
-    else {
-      BKE_bvhtree_from_mesh_get(treedata, me, BVHTREE_FROM_LOOPTRI, 4);
-    }
-
-    /* required for snapping with occlusion. */
-    treedata->edge = me->medge;
-    sod->poly = me->mpoly;
-
-    if (treedata->tree == NULL) {
-      return retval;
-    }
+  BVHTreeFromMesh *treedata = raycast_mesh_treedata_ensure(sctx, ob, me, use_hide);
+  if (treedata == NULL) {
+    return retval;
   }
 
   float timat[3][3]; /* transpose inverse matrix for normals */
@@ -765,6 +785,57 @@ static bool raycastMesh(SnapObjectContext *sctx,
   return retval;
 }
 
+/**
+ * Edit-mesh counterpart of #raycast_mesh_treedata_ensure,
+ * \a sod must already be initialized with #snap_object_data_editmesh_get.
+ */
+static BVHTreeFromEditMesh *raycast_editmesh_treedata_ensure(SnapObjectContext *sctx,
+                                                             SnapObjectData *sod,
+                                                             Object *ob)
+{
+  BVHTreeFromEditMesh *treedata = &sod->treedata_editmesh;
+
+  if (treedata->tree == NULL) {
+    /* Operators only update the editmesh looptris of the original mesh. */
+    BLI_assert(sod->treedata_editmesh.em == BKE_editmesh_from_object(DEG_get_original_object(ob)));
+    BMEditMesh *em = sod->treedata_editmesh.em;
+    UNUSED_VARS_NDEBUG(ob);
+
+    if (sctx->callbacks.edit_mesh.test_face_fn) {
+      BMesh *bm = em->bm;
+      BLI_assert(poly_to_tri_count(bm->totface, bm->totloop) == em->tottri);
+
+      BLI_bitmap *elem_mask = BLI_BITMAP_NEW(em->tottri, __func__);
+      int looptri_num_active = BM_iter_mesh_bitmap_from_filter_tessface(
+          bm,
+          elem_mask,
+          sctx->callbacks.edit_mesh.test_face_fn,
+          sctx->callbacks.edit_mesh.user_data);
+
+      bvhtree_from_editmesh_looptri_ex(
+          treedata, em, elem_mask, looptri_num_active, 0.0f, 4, 6, 0, NULL, NULL);
+
+      MEM_freeN(elem_mask);
+    }
+    else {
+      /* Only cache if bvhtree is created without a mask.
+       * This helps keep a standardized bvhtree in cache. */
+      BKE_bvhtree_from_editmesh_get(treedata,
+                                    em,
+                                    4,
+                                    BVHTREE_FROM_EM_LOOPTRI,
+                                    &sod->mesh_runtime->bvh_cache,
+                                    sod->mesh_runtime->eval_mutex);
+    }
+
+    if (treedata->tree == NULL) {
+      return NULL;
+    }
+  }
+
+  return treedata;
+}
+
 static bool raycastEditMesh(SnapObjectContext *sctx,
                             const float ray_start[3],
                             const float ray_dir[3],
@@ -827,43 +898,9 @@ static bool raycastEditMesh(SnapObjectContext *sctx,
     len_diff = 0.0f;
   }
 
-  BVHTreeFromEditMesh *treedata = &sod->treedata_editmesh;
-
-  if (treedata->tree == NULL) {
-    /* Operators only update the editmesh looptris of the original mesh. */
-    BLI_assert(sod->treedata_editmesh.em == BKE_editmesh_from_object(DEG_get_original_object(ob)));
-    em = sod->treedata_editmesh.em;
-
-    if (sctx->callbacks.edit_mesh.test_face_fn) {
-      BMesh *bm = em->bm;
-      BLI_assert(poly_to_tri_count(bm->totface, bm->totloop) == em->tottri);
-
-      BLI_bitmap *elem_mask = BLI_BITMAP_NEW(em->tottri, __func__);
-      int looptri_num_active = BM_iter_mesh_bitmap_from_filter_tessface(
-          bm,
-          elem_mask,
-          sctx->callbacks.edit_mesh.test_face_fn,
-          sctx->callbacks.edit_mesh.user_data);
-
-      bvhtree_from_editmesh_looptri_ex(
-          treedata, em, elem_mask, looptri_num_active, 0.0f, 4, 6, 0, NULL, NULL);
-
-      MEM_freeN(elem_mask);
-    }
-    else {
-      /* Only cache if bvhtree is created without a mask.
-       * This helps keep a standardized bvhtree in cache. */
-      BKE_bvhtree_from_editmesh_get(treedata,
-                                    em,
-                                    4,
-                                    BVHTREE_FROM_EM_LOOPTRI,
-                                    &sod->mesh_runtime->bvh_cache,
-                                    sod->mesh_runtime->eval_mutex);
-    }
-
-    if (treedata->tree == NULL) {
-      return retval;
-    }
+  BVHTreeFromEditMesh *treedata = raycast_editmesh_treedata_ensure(sctx, sod, ob);
+  if (treedata == NULL) {
+    return retval;
   }
 
   float timat[3][3]; /* transpose inverse matrix for normals */
@@ -1067,6 +1104,292 @@ static void raycast_obj_fn(SnapObjectContext *sctx,
   }
 }
 
+/* Parallel raycast.
+ *
+ * Candidate objects are collected serially (this is where the snap data cache and any
+ * missing BVH-trees are created, and where objects whose bounds the ray misses are
+ * rejected), the per object BVH raycasts then run in parallel on the immutable trees
+ * and the nearest hit is reduced afterwards. */
+
+typedef struct RaycastObjTask {
+  Object *ob;
+  float obmat[4][4];
+
+  /* Already built tree, with the ray transformed into object space. */
+  BVHTree *tree;
+  BVHTree_RayCastCallback raycast_callback;
+  void *bvh_userdata;
+
+  /* For looking up the index of a hit, 'looptri' for meshes, 'em' for edit-meshes. */
+  const MLoopTri *looptri;
+  BMEditMesh *em;
+
+  float ray_start_local[3], ray_normal_local[3];
+  float local_scale, local_depth, len_diff;
+  float timat[3][3];
+
+  /* Output. */
+  float loc[3], no[3];
+  float depth;
+  int index;
+  bool hit;
+} RaycastObjTask;
+
+struct RaycastObjsParallelData {
+  SnapObjectContext *sctx;
+  const float *ray_start;
+  const float *ray_dir;
+  float ray_depth;
+  bool use_occlusion_test;
+
+  RaycastObjTask *tasks;
+  int tasks_len;
+  int tasks_len_alloc;
+};
+
+static RaycastObjTask *raycast_obj_task_append(struct RaycastObjsParallelData *data)
+{
+  if (data->tasks_len == data->tasks_len_alloc) {
+    data->tasks_len_alloc = MAX2(data->tasks_len_alloc * 2, 64);
+    data->tasks = MEM_reallocN(data->tasks, sizeof(*data->tasks) * data->tasks_len_alloc);
+  }
+  return &data->tasks[data->tasks_len++];
+}
+
+static void raycast_obj_task_add_mesh(struct RaycastObjsParallelData *data,
+                                      Object *ob,
+                                      Mesh *me,
+                                      float obmat[4][4],
+                                      bool use_hide,
+                                      bool use_backface_culling)
+{
+  if (me->totpoly == 0) {
+    return;
+  }
+
+  float imat[4][4];
+  float ray_start_local[3], ray_normal_local[3];
+  float local_scale, local_depth, len_diff = 0.0f;
+
+  invert_m4_m4(imat, obmat);
+
+  copy_v3_v3(ray_start_local, data->ray_start);
+  copy_v3_v3(ray_normal_local, data->ray_dir);
+
+  mul_m4_v3(imat, ray_start_local);
+  mul_mat3_m4_v3(imat, ray_normal_local);
+
+  local_scale = normalize_v3(ray_normal_local);
+  local_depth = data->ray_depth;
+  if (local_depth != BVH_RAYCAST_DIST_MAX) {
+    local_depth *= local_scale;
+  }
+
+  /* Test BoundBox */
+  BoundBox *bb = BKE_mesh_boundbox_get(ob);
+  if (bb) {
+    if (!isect_ray_aabb_v3_simple(
+            ray_start_local, ray_normal_local, bb->vec[0], bb->vec[6], &len_diff, NULL)) {
+      return;
+    }
+  }
+  if (len_diff > 400.0f) {
+    len_diff -= local_scale; /* make temp start point a bit away from bbox hit point. */
+    madd_v3_v3fl(ray_start_local, ray_normal_local, len_diff);
+    local_depth -= len_diff;
+  }
+  else {
+    len_diff = 0.0f;
+  }
+
+  BVHTreeFromMesh *treedata = raycast_mesh_treedata_ensure(data->sctx, ob, me, use_hide);
+  if (treedata == NULL) {
+    return;
+  }
+
+  RaycastObjTask *task = raycast_obj_task_append(data);
+  task->ob = ob;
+  copy_m4_m4(task->obmat, obmat);
+  task->tree = treedata->tree;
+  task->raycast_callback = use_backface_culling ? mesh_looptri_raycast_backface_culling_cb :
+                                                  treedata->raycast_callback;
+  task->bvh_userdata = treedata;
+  task->looptri = treedata->looptri;
+  task->em = NULL;
+  copy_v3_v3(task->ray_start_local, ray_start_local);
+  copy_v3_v3(task->ray_normal_local, ray_normal_local);
+  task->local_scale = local_scale;
+  task->local_depth = local_depth;
+  task->len_diff = len_diff;
+  transpose_m3_m4(task->timat, imat);
+  task->hit = false;
+}
+
+static void raycast_obj_task_add_editmesh(struct RaycastObjsParallelData *data,
+                                          Object *ob,
+                                          BMEditMesh *em,
+                                          float obmat[4][4],
+                                          bool use_backface_culling)
+{
+  if (em->bm->totface == 0) {
+    return;
+  }
+
+  float imat[4][4];
+  float ray_start_local[3], ray_normal_local[3];
+  float local_scale, local_depth, len_diff = 0.0f;
+
+  invert_m4_m4(imat, obmat);
+
+  copy_v3_v3(ray_start_local, data->ray_start);
+  copy_v3_v3(ray_normal_local, data->ray_dir);
+
+  mul_m4_v3(imat, ray_start_local);
+  mul_mat3_m4_v3(imat, ray_normal_local);
+
+  local_scale = normalize_v3(ray_normal_local);
+  local_depth = data->ray_depth;
+  if (local_depth != BVH_RAYCAST_DIST_MAX) {
+    local_depth *= local_scale;
+  }
+
+  SnapObjectData *sod = snap_object_data_editmesh_get(data->sctx, ob, em);
+
+  /* Test BoundBox */
+  if (!isect_ray_aabb_v3_simple(
+          ray_start_local, ray_normal_local, sod->min, sod->max, &len_diff, NULL)) {
+    return;
+  }
+  if (len_diff > 400.0f) {
+    len_diff -= local_scale; /* make temp start point a bit away from bbox hit point. */
+    madd_v3_v3fl(ray_start_local, ray_normal_local, len_diff);
+    local_depth -= len_diff;
+  }
+  else {
+    len_diff = 0.0f;
+  }
+
+  BVHTreeFromEditMesh *treedata = raycast_editmesh_treedata_ensure(data->sctx, sod, ob);
+  if (treedata == NULL) {
+    return;
+  }
+
+  RaycastObjTask *task = raycast_obj_task_append(data);
+  task->ob = ob;
+  copy_m4_m4(task->obmat, obmat);
+  task->tree = treedata->tree;
+  task->raycast_callback = use_backface_culling ? editmesh_looptri_raycast_backface_culling_cb :
+                                                  treedata->raycast_callback;
+  task->bvh_userdata = treedata;
+  task->looptri = NULL;
+  task->em = sod->treedata_editmesh.em;
+  copy_v3_v3(task->ray_start_local, ray_start_local);
+  copy_v3_v3(task->ray_normal_local, ray_normal_local);
+  task->local_scale = local_scale;
+  task->local_depth = local_depth;
+  task->len_diff = len_diff;
+  transpose_m3_m4(task->timat, imat);
+  task->hit = false;
+}
+
+/**
+ * Collect counterpart of #raycast_obj_fn, the object type dispatch must stay in sync.
+ */
+static void raycast_obj_collect_fn(SnapObjectContext *sctx,
+                                   bool use_obedit,
+                                   bool use_backface_culling,
+                                   Object *ob,
+                                   float obmat[4][4],
+                                   void *data_v)
+{
+  struct RaycastObjsParallelData *data = data_v;
+
+  if (data->use_occlusion_test) {
+    if (use_obedit && sctx->use_v3d && XRAY_FLAG_ENABLED(sctx->v3d_data.v3d)) {
+      /* Use of occlude geometry in editing mode disabled. */
+      return;
+    }
+
+    if (ELEM(ob->dt, OB_BOUNDBOX, OB_WIRE)) {
+      /* Do not hit objects that are in wire or bounding box
+       * display mode. */
+      return;
+    }
+  }
+
+  switch (ob->type) {
+    case OB_MESH: {
+      Mesh *me = ob->data;
+      bool use_hide = false;
+      if (BKE_object_is_in_editmode(ob)) {
+        if (use_obedit || editmesh_eval_final_is_bmesh(me->edit_mesh)) {
+          /* Operators only update the editmesh looptris of the original mesh. */
+          BMEditMesh *em_orig = BKE_editmesh_from_object(DEG_get_original_object(ob));
+          raycast_obj_task_add_editmesh(data, ob, em_orig, obmat, use_backface_culling);
+          break;
+        }
+        else {
+          BMEditMesh *em = BKE_editmesh_from_object(ob);
+          if (em->mesh_eval_final) {
+            me = em->mesh_eval_final;
+            use_hide = true;
+          }
+        }
+      }
+      raycast_obj_task_add_mesh(data, ob, me, obmat, use_hide, use_backface_culling);
+      break;
+    }
+    case OB_CURVE:
+    case OB_SURF:
+    case OB_FONT: {
+      Mesh *mesh_eval = BKE_object_get_evaluated_mesh(ob);
+      if (mesh_eval) {
+        raycast_obj_task_add_mesh(data, ob, mesh_eval, obmat, false, use_backface_culling);
+      }
+      break;
+    }
+  }
+}
+
+static void raycast_obj_task_fn(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct RaycastObjsParallelData *data = userdata;
+  RaycastObjTask *task = &data->tasks[i];
+
+  BVHTreeRayHit hit = {
+      .index = -1,
+      .dist = task->local_depth,
+  };
+
+  if (BLI_bvhtree_ray_cast(task->tree,
+                           task->ray_start_local,
+                           task->ray_normal_local,
+                           0.0f,
+                           &hit,
+                           task->raycast_callback,
+                           task->bvh_userdata) != -1) {
+    hit.dist += task->len_diff;
+    hit.dist /= task->local_scale;
+    if (hit.dist <= data->ray_depth) {
+      task->depth = hit.dist;
+      copy_v3_v3(task->loc, hit.co);
+
+      /* back to worldspace */
+      mul_m4_v3(task->obmat, task->loc);
+
+      copy_v3_v3(task->no, hit.no);
+      mul_m3_v3(task->timat, task->no);
+      normalize_v3(task->no);
+
+      task->index = task->em ? BM_elem_index_get(task->em->looptris[hit.index][0]->f) :
+                               (int)task->looptri[hit.index].poly;
+      task->hit = true;
+    }
+  }
+}
+
 /**
  * Main RayCast Function
  * ======================
@@ -1110,6 +1433,52 @@ static bool raycastObjects(SnapObjectContext *sctx,
                            float r_obmat[4][4],
                            ListBase *r_hit_list)
 {
+  if (r_hit_list == NULL) {
+    /* Nearest hit only: collect the candidates and cast in parallel. */
+    struct RaycastObjsParallelData data = {
+        .sctx = sctx,
+        .ray_start = ray_start,
+        .ray_dir = ray_dir,
+        .ray_depth = *ray_depth,
+        .use_occlusion_test = params->use_occlusion_test,
+    };
+
+    iter_snap_objects(sctx, depsgraph, params, raycast_obj_collect_fn, &data);
+
+    if (data.tasks_len) {
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (data.tasks_len > 4);
+      BLI_task_parallel_range(0, data.tasks_len, &data, raycast_obj_task_fn, &settings);
+    }
+
+    bool retval = false;
+    for (int i = 0; i < data.tasks_len; i++) {
+      RaycastObjTask *task = &data.tasks[i];
+      if (task->hit && task->depth <= *ray_depth) {
+        *ray_depth = task->depth;
+        copy_v3_v3(r_loc, task->loc);
+        if (r_no) {
+          copy_v3_v3(r_no, task->no);
+        }
+        if (r_index) {
+          *r_index = task->index;
+        }
+        if (r_ob) {
+          *r_ob = task->ob;
+        }
+        if (r_obmat) {
+          copy_m4_m4(r_obmat, task->obmat);
+        }
+        retval = true;
+      }
+    }
+
+    MEM_SAFE_FREE(data.tasks);
+
+    return retval;
+  }
+
   struct RaycastObjUserData data = {
       .ray_start = ray_start,
       .ray_dir = ray_dir,
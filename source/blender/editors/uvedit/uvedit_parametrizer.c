@@ -28,6 +28,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "uvedit_parametrizer.h"
@@ -4731,7 +4732,42 @@ static void param_pack_rotate(ParamHandle *handle, bool ignore_pinned)
   }
 }
 
-void param_pack(ParamHandle *handle, float margin, bool do_rotate, bool ignore_pinned)
+typedef struct PPackBoundsData {
+  PHandle *phandle;
+  BoxPack *boxarray;
+  /** Per chart box slot, -1 for ignored pinned charts. */
+  const int *box_index;
+} PPackBoundsData;
+
+static void p_pack_chart_bounds_fn(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PPackBoundsData *data = userdata;
+  PChart *chart = data->phandle->charts[i];
+  BoxPack *box;
+  float trans[2];
+
+  if (data->box_index[i] == -1) {
+    return;
+  }
+
+  box = &data->boxarray[data->box_index[i]];
+
+  p_chart_uv_bbox(chart, trans, chart->u.pack.size);
+
+  trans[0] = -trans[0];
+  trans[1] = -trans[1];
+
+  p_chart_uv_translate(chart, trans);
+
+  box->w = chart->u.pack.size[0] + trans[0];
+  box->h = chart->u.pack.size[1] + trans[1];
+  box->index = i; /* warning this index skips PCHART_HAS_PINS boxes */
+}
+
+void param_pack(
+    ParamHandle *handle, float margin, bool do_rotate, bool ignore_pinned, bool use_fast_pack)
 {
   /* box packing variables */
   BoxPack *boxarray, *box;
@@ -4760,28 +4796,39 @@ void param_pack(ParamHandle *handle, float margin, bool do_rotate, bool ignore_p
   /* we may not use all these boxes */
   boxarray = MEM_mallocN(phandle->ncharts * sizeof(BoxPack), "BoxPack box");
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    chart = phandle->charts[i];
-
-    if (ignore_pinned && (chart->flag & PCHART_HAS_PINS)) {
-      unpacked++;
-      continue;
-    }
-
-    box = boxarray + (i - unpacked);
+  /* Box slots are assigned serially, the per chart bounds
+   * (and the translation to the origin) are computed in parallel. */
+  {
+    int *box_index = MEM_mallocN(sizeof(int) * phandle->ncharts, __func__);
 
-    p_chart_uv_bbox(chart, trans, chart->u.pack.size);
+    for (i = 0; i < phandle->ncharts; i++) {
+      chart = phandle->charts[i];
 
-    trans[0] = -trans[0];
-    trans[1] = -trans[1];
+      if (ignore_pinned && (chart->flag & PCHART_HAS_PINS)) {
+        box_index[i] = -1;
+        unpacked++;
+      }
+      else {
+        box_index[i] = i - unpacked;
+      }
+    }
 
-    p_chart_uv_translate(chart, trans);
+    PPackBoundsData data = {
+        .phandle = phandle,
+        .boxarray = boxarray,
+        .box_index = box_index,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (phandle->ncharts > 32);
+    BLI_task_parallel_range(0, phandle->ncharts, &data, p_pack_chart_bounds_fn, &settings);
 
-    box->w = chart->u.pack.size[0] + trans[0];
-    box->h = chart->u.pack.size[1] + trans[1];
-    box->index = i; /* warning this index skips PCHART_HAS_PINS boxes */
+    MEM_freeN(box_index);
+  }
 
-    if (margin > 0.0f) {
+  if (margin > 0.0f) {
+    for (i = 0; i < phandle->ncharts - unpacked; i++) {
+      box = boxarray + i;
       area += (double)sqrtf(box->w * box->h);
     }
   }
@@ -4810,7 +4857,12 @@ void param_pack(ParamHandle *handle, float margin, bool do_rotate, bool ignore_p
     }
   }
 
-  BLI_box_pack_2d(boxarray, phandle->ncharts - unpacked, &tot_width, &tot_height);
+  if (use_fast_pack) {
+    BLI_box_pack_2d_fast(boxarray, phandle->ncharts - unpacked, &tot_width, &tot_height);
+  }
+  else {
+    BLI_box_pack_2d(boxarray, phandle->ncharts - unpacked, &tot_width, &tot_height);
+  }
 
   if (tot_height > tot_width) {
     scale = 1.0f / tot_height;
@@ -91,7 +91,8 @@ void param_smooth_area(ParamHandle *handle);
 
 /* Packing */
 
-void param_pack(ParamHandle *handle, float margin, bool do_rotate, bool ignore_pinned);
+void param_pack(
+    ParamHandle *handle, float margin, bool do_rotate, bool ignore_pinned, bool use_fast_pack);
 
 /* Average area for all charts */
 
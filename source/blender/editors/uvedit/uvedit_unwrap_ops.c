@@ -944,7 +944,7 @@ static void uvedit_pack_islands(const Scene *scene, Object *ob, BMesh *bm)
 
   ParamHandle *handle;
   handle = construct_param_handle(scene, ob, bm, &options);
-  param_pack(handle, scene->toolsettings->uvcalc_margin, rotate, ignore_pinned);
+  param_pack(handle, scene->toolsettings->uvcalc_margin, rotate, ignore_pinned, false);
   param_flush(handle);
   param_delete(handle);
 }
@@ -954,11 +954,12 @@ static void uvedit_pack_islands_multi(const Scene *scene,
                                       const uint objects_len,
                                       const UnwrapOptions *options,
                                       bool rotate,
-                                      bool ignore_pinned)
+                                      bool ignore_pinned,
+                                      bool use_fast_pack)
 {
   ParamHandle *handle;
   handle = construct_param_handle_multi(scene, objects, objects_len, options);
-  param_pack(handle, scene->toolsettings->uvcalc_margin, rotate, ignore_pinned);
+  param_pack(handle, scene->toolsettings->uvcalc_margin, rotate, ignore_pinned, use_fast_pack);
   param_flush(handle);
   param_delete(handle);
 
@@ -982,6 +983,7 @@ static int pack_islands_exec(bContext *C, wmOperator *op)
   };
 
   bool rotate = RNA_boolean_get(op->ptr, "rotate");
+  bool use_fast_pack = RNA_boolean_get(op->ptr, "use_fast_pack");
   bool ignore_pinned = false;
 
   uint objects_len = 0;
@@ -1000,7 +1002,8 @@ static int pack_islands_exec(bContext *C, wmOperator *op)
     RNA_float_set(op->ptr, "margin", scene->toolsettings->uvcalc_margin);
   }
 
-  uvedit_pack_islands_multi(scene, objects, objects_len, &options, rotate, ignore_pinned);
+  uvedit_pack_islands_multi(
+      scene, objects, objects_len, &options, rotate, ignore_pinned, use_fast_pack);
 
   MEM_freeN(objects);
 
@@ -1022,6 +1025,12 @@ void UV_OT_pack_islands(wmOperatorType *ot)
 
   /* properties */
   RNA_def_boolean(ot->srna, "rotate", true, "Rotate", "Rotate islands for best fit");
+  RNA_def_boolean(ot->srna,
+                  "use_fast_pack",
+                  false,
+                  "Fast Pack",
+                  "Use a faster packing method, better suited to many islands "
+                  "at the cost of a slightly less tight result");
   RNA_def_float_factor(
       ot->srna, "margin", 0.001f, 0.0f, 1.0f, "Margin", "Space between islands", 0.0f, 1.0f);
 }
@@ -1648,7 +1657,8 @@ void ED_uvedit_live_unwrap(const Scene *scene, Object **objects, int objects_len
     bool ignore_pinned = true;
 
     uvedit_unwrap_multi(scene, objects, objects_len, &options);
-    uvedit_pack_islands_multi(scene, objects, objects_len, &options, rotate, ignore_pinned);
+    uvedit_pack_islands_multi(
+        scene, objects, objects_len, &options, rotate, ignore_pinned, false);
   }
 }
 
@@ -1776,7 +1786,7 @@ static int unwrap_exec(bContext *C, wmOperator *op)
 
   /* execute unwrap */
   uvedit_unwrap_multi(scene, objects, objects_len, &options);
-  uvedit_pack_islands_multi(scene, objects, objects_len, &options, rotate, ignore_pinned);
+  uvedit_pack_islands_multi(scene, objects, objects_len, &options, rotate, ignore_pinned, false);
 
   MEM_freeN(objects);
 
@@ -75,6 +75,14 @@ enum {
   GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS = (1 << 3),
 };
 
+/* Replace the mesh arrays the buffers point into, for when the buffers are
+ * kept across a rebuild that reallocated them. Threaded. */
+void GPU_pbvh_mesh_buffers_update_pointers(GPU_PBVH_Buffers *buffers,
+                                           const struct MPoly *mpoly,
+                                           const struct MLoop *mloop,
+                                           const struct MLoopTri *looptri,
+                                           const struct MVert *mvert);
+
 void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
                                   const struct MVert *mvert,
                                   const float *vmask,
@@ -130,6 +130,10 @@ void GPU_vertbuf_attr_get_raw_data(GPUVertBuf *, uint a_idx, GPUVertBufRaw *acce
 
 void GPU_vertbuf_use(GPUVertBuf *);
 
+/* Partially update an already uploaded buffer in place, without orphaning or
+ * re-sending the rest of the data. `start` and `len` are in bytes. */
+void GPU_vertbuf_update_sub(GPUVertBuf *verts, uint start, uint len, const void *data);
+
 /* Metrics */
 uint GPU_vertbuf_get_memory_usage(void);
 
@@ -134,10 +134,10 @@ void gpu_pbvh_exit()
  * Return is false it indicates that the memory map failed. */
 static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
 {
-  /* Keep so we can test #GPU_USAGE_DYNAMIC buffer use.
-   * Not that format initialization match in both blocks.
-   * Do this to keep braces balanced - otherwise indentation breaks. */
-#if 0
+  /* The data stays in main memory (#GPU_USAGE_DYNAMIC), so the threaded stroke
+   * updates only rewrite it instead of reallocating it every step, and the
+   * draw-time upload in #GPU_pbvh_buffers_update_flush orphans the VBO instead
+   * of synchronizing with in-flight draws (see #VertBuffer_upload_data). */
   if (buffers->vert_buf == NULL) {
     /* Initialize vertex buffer (match 'VertexBufferFormat'). */
     buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_DYNAMIC);
@@ -146,16 +146,6 @@ static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
   else if (vert_len != buffers->vert_buf->vertex_len) {
     GPU_vertbuf_data_resize(buffers->vert_buf, vert_len);
   }
-#else
-  if (buffers->vert_buf == NULL) {
-    /* Initialize vertex buffer (match 'VertexBufferFormat'). */
-    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_STATIC);
-  }
-  if (buffers->vert_buf->data == NULL || buffers->vert_buf->vertex_len != vert_len) {
-    /* Allocate buffer if not allocated yet or size changed. */
-    GPU_vertbuf_data_alloc(buffers->vert_buf, vert_len);
-  }
-#endif
 
   return buffers->vert_buf->data != NULL;
 }
@@ -431,6 +421,19 @@ GPU_PBVH_Buffers *GPU_pbvh_mesh_buffers_build(const MPoly *mpoly,
   return buffers;
 }
 
+/* Threaded - do not call any functions that use OpenGL calls! */
+void GPU_pbvh_mesh_buffers_update_pointers(GPU_PBVH_Buffers *buffers,
+                                           const MPoly *mpoly,
+                                           const MLoop *mloop,
+                                           const MLoopTri *looptri,
+                                           const MVert *mvert)
+{
+  buffers->mpoly = mpoly;
+  buffers->mloop = mloop;
+  buffers->looptri = looptri;
+  buffers->mvert = mvert;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
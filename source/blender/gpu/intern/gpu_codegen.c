@@ -38,6 +38,7 @@
 
 #include "PIL_time.h"
 
+#include "BKE_appdir.h"
 #include "BKE_material.h"
 
 #include "GPU_extensions.h"
@@ -1209,12 +1210,131 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
   return (total_samplers_len <= GPU_max_textures());
 }
 
+/* -------------------- On-Disk Shader Binary Cache ------------------ */
+/**
+ * Linked program binaries of material shaders are kept on disk in the user
+ * configuration folder, keyed by a hash of the generated sources and the exact
+ * driver, so that reopening a file turns recompilation of its materials into a
+ * disk read. Loading is strictly best effort: when the driver rejects a stored
+ * binary (driver update, different GPU) the pass falls back to compiling from
+ * source and the entry gets rewritten.
+ */
+
+static bool gpu_pass_binary_cache_filepath_get(char r_filepath[FILE_MAX], const GPUPass *pass)
+{
+  if (!GLEW_ARB_get_program_binary) {
+    return false;
+  }
+
+  const char *cache_dir = BKE_appdir_folder_id_create(BLENDER_USER_CONFIG, "shader-cache");
+  if (cache_dir == NULL) {
+    return false;
+  }
+
+  /* Two murmur hashes with different seeds; a single 32 bit hash collides too
+   * easily for use as a file identity. */
+  const uint32_t seeds[2] = {0, 0x9747b28c};
+  uint32_t hashes[2];
+  for (int i = 0; i < 2; i++) {
+    BLI_HashMurmur2A hm2a;
+    BLI_hash_mm2a_init(&hm2a, seeds[i]);
+#define HASH_STRING(str) \
+  if (str) { \
+    BLI_hash_mm2a_add(&hm2a, (const uchar *)(str), strlen(str)); \
+  } \
+  ((void)0)
+    HASH_STRING(pass->vertexcode);
+    HASH_STRING(pass->geometrycode);
+    HASH_STRING(pass->fragmentcode);
+    HASH_STRING(pass->defines);
+    /* Program binaries are only valid for the exact same driver and GPU. */
+    HASH_STRING((const char *)glGetString(GL_VENDOR));
+    HASH_STRING((const char *)glGetString(GL_RENDERER));
+    HASH_STRING((const char *)glGetString(GL_VERSION));
+#undef HASH_STRING
+    hashes[i] = BLI_hash_mm2a_end(&hm2a);
+  }
+
+  BLI_snprintf(r_filepath, FILE_MAX, "%s/%08x%08x.bin", cache_dir, hashes[0], hashes[1]);
+  return true;
+}
+
+static GPUShader *gpu_pass_shader_load_from_disk(const GPUPass *pass, const char *shname)
+{
+  char filepath[FILE_MAX];
+  if (!gpu_pass_binary_cache_filepath_get(filepath, pass)) {
+    return NULL;
+  }
+
+  size_t data_len;
+  /* Layout: uint32 binary format, followed by the raw program binary. */
+  uint32_t *data = BLI_file_read_binary_as_mem(filepath, 0, &data_len);
+  if (data == NULL) {
+    return NULL;
+  }
+  if (data_len <= sizeof(uint32_t)) {
+    MEM_freeN(data);
+    return NULL;
+  }
+
+  GPUShader *shader = GPU_shader_load_from_binary(
+      (char *)(data + 1), data[0], (int)(data_len - sizeof(uint32_t)), shname);
+  MEM_freeN(data);
+  return shader;
+}
+
+static void gpu_pass_shader_save_to_disk(const GPUPass *pass, GPUShader *shader)
+{
+  char filepath[FILE_MAX];
+  if (!gpu_pass_binary_cache_filepath_get(filepath, pass)) {
+    return;
+  }
+  if (BLI_exists(filepath)) {
+    return;
+  }
+
+  uint format;
+  int binary_len;
+  char *binary = GPU_shader_get_binary(shader, &format, &binary_len);
+  if (binary == NULL) {
+    return;
+  }
+
+  /* Write to a unique temporary name first so concurrent compile threads or
+   * instances never read a half written file, then atomically rename. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.%p.tmp", filepath, (const void *)pass);
+
+  FILE *fp = BLI_fopen(filepath_tmp, "wb");
+  if (fp != NULL) {
+    const uint32_t format_u32 = format;
+    const bool ok = (fwrite(&format_u32, sizeof(format_u32), 1, fp) == 1) &&
+                    (fwrite(binary, 1, binary_len, fp) == (size_t)binary_len);
+    fclose(fp);
+    if (ok) {
+      BLI_rename(filepath_tmp, filepath);
+    }
+    else {
+      BLI_delete(filepath_tmp, false, false);
+    }
+  }
+
+  MEM_freeN(binary);
+}
+
 bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
   bool success = true;
   if (!pass->compiled) {
-    GPUShader *shader = GPU_shader_create(
-        pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
+    bool from_disk_cache = false;
+    GPUShader *shader = gpu_pass_shader_load_from_disk(pass, shname);
+    if (shader != NULL) {
+      from_disk_cache = true;
+    }
+    else {
+      shader = GPU_shader_create(
+          pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
+    }
 
     /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
      * We need to make sure to count active samplers to avoid undefined behavior. */
@@ -1226,11 +1346,16 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
         shader = NULL;
       }
     }
-    else if (!BLI_thread_is_main() && GPU_context_local_shaders_workaround()) {
-      pass->binary.content = GPU_shader_get_binary(
-          shader, &pass->binary.format, &pass->binary.len);
-      GPU_shader_free(shader);
-      shader = NULL;
+    else {
+      if (!from_disk_cache) {
+        gpu_pass_shader_save_to_disk(pass, shader);
+      }
+      if (!BLI_thread_is_main() && GPU_context_local_shaders_workaround()) {
+        pass->binary.content = GPU_shader_get_binary(
+            shader, &pass->binary.format, &pass->binary.len);
+        GPU_shader_free(shader);
+        shader = NULL;
+      }
     }
 
     pass->shader = shader;
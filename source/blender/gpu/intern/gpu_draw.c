@@ -265,6 +265,9 @@ static uint gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
 {
   int arraywidth = 0, arrayheight = 0;
 
+  /* Read all tile files concurrently up front, instead of one by one while packing. */
+  BKE_image_load_all_tiles(ima);
+
   ListBase boxes = {NULL};
 
   LISTBASE_FOREACH (ImageTile *, tile, &ima->tiles) {
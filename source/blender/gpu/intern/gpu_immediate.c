@@ -27,6 +27,8 @@
 #  include "UI_resources.h"
 #endif
 
+#include "BLI_utildefines.h"
+
 #include "GPU_attr_binding.h"
 #include "GPU_immediate.h"
 
@@ -43,11 +45,23 @@
 extern void GPU_matrix_bind(const GPUShaderInterface *);
 extern bool GPU_matrix_dirty_get(void);
 
+/* Number of sections the persistent-mapped ring buffer is divided in.
+ * Each section is guarded by its own fence so the CPU only ever waits
+ * when it catches up with draws submitted two sections ago. */
+#define IMM_RING_SECTIONS 3
+
 typedef struct ImmediateDrawBuffer {
   GLuint vbo_id;
   GLubyte *buffer_data;
   uint buffer_offset;
   uint buffer_size;
+  /* Persistent mapping of the whole buffer (NULL when GL_ARB_buffer_storage
+   * is unsupported). The buffer is then used as a ring of #IMM_RING_SECTIONS
+   * sections instead of being orphaned and remapped for every draw. */
+  GLubyte *persistent_map;
+  /* Section the write head currently is in. */
+  uint ring_section;
+  GLsync ring_fences[IMM_RING_SECTIONS];
 } ImmediateDrawBuffer;
 
 typedef struct {
@@ -86,6 +100,92 @@ typedef struct {
 static bool initialized = false;
 static Immediate imm;
 
+static void imm_buffer_create(ImmediateDrawBuffer *buffer, uint buffer_size)
+{
+  buffer->vbo_id = GPU_buf_alloc();
+  buffer->buffer_size = buffer_size;
+  buffer->buffer_offset = 0;
+  buffer->ring_section = 0;
+  glBindBuffer(GL_ARRAY_BUFFER, buffer->vbo_id);
+  if (GLEW_ARB_buffer_storage) {
+    /* Map once and write directly into the buffer for its whole lifetime,
+     * avoiding the map/unmap & orphaning driver work on every draw. The
+     * coherent bit makes explicit flushes unnecessary too. */
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_ARRAY_BUFFER, buffer_size, NULL, flags);
+    buffer->persistent_map = glMapBufferRange(GL_ARRAY_BUFFER, 0, buffer_size, flags);
+#if TRUST_NO_ONE
+    assert(buffer->persistent_map != NULL);
+#endif
+  }
+  else {
+    buffer->persistent_map = NULL;
+    glBufferData(GL_ARRAY_BUFFER, buffer_size, NULL, GL_DYNAMIC_DRAW);
+  }
+}
+
+static void imm_buffer_discard(ImmediateDrawBuffer *buffer)
+{
+  if (buffer->persistent_map) {
+    glBindBuffer(GL_ARRAY_BUFFER, buffer->vbo_id);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    buffer->persistent_map = NULL;
+  }
+  for (int i = 0; i < IMM_RING_SECTIONS; i++) {
+    if (buffer->ring_fences[i]) {
+      glDeleteSync(buffer->ring_fences[i]);
+      buffer->ring_fences[i] = NULL;
+    }
+  }
+  /* GL defers the actual deletion until pending draws are done with it. */
+  GPU_buf_free(buffer->vbo_id);
+  buffer->vbo_id = 0;
+}
+
+/* Move the write head of a persistent-mapped ring buffer to a region of
+ * `bytes_needed` bytes that the GPU is done reading, wrapping and waiting on
+ * section fences as needed. */
+static void imm_ring_buffer_alloc(ImmediateDrawBuffer *buffer, uint bytes_needed, uint stride)
+{
+  if (bytes_needed > buffer->buffer_size / IMM_RING_SECTIONS) {
+    /* A single draw has to fit inside one section so it can never overwrite
+     * in-flight data. Persistent storage is immutable, so grow by recreating
+     * the buffer. It is kept at the grown size: draws this large tend to
+     * repeat every frame and there is no per-draw orphaning cost anymore. */
+    imm_buffer_discard(buffer);
+    imm_buffer_create(buffer, bytes_needed * IMM_RING_SECTIONS);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer->vbo_id);
+  }
+  const uint section_size = buffer->buffer_size / IMM_RING_SECTIONS;
+
+  /* ensure vertex data is aligned */
+  uint offset = buffer->buffer_offset + padding(buffer->buffer_offset, stride);
+  if (offset + bytes_needed > buffer->buffer_size) {
+    /* Wrap around. Sections between the write head and the end of the buffer
+     * only contain draws that are submitted by now, so fence them here. */
+    for (uint s = buffer->ring_section; s < IMM_RING_SECTIONS; s++) {
+      if (buffer->ring_fences[s] == NULL) {
+        buffer->ring_fences[s] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      }
+    }
+    offset = 0;
+    buffer->ring_section = 0;
+  }
+
+  /* Wait until the GPU is done with every section this write touches. */
+  uint section_last = (offset + bytes_needed - 1) / section_size;
+  CLAMP_MAX(section_last, IMM_RING_SECTIONS - 1);
+  for (uint s = offset / section_size; s <= section_last; s++) {
+    if (buffer->ring_fences[s]) {
+      glClientWaitSync(buffer->ring_fences[s], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+      glDeleteSync(buffer->ring_fences[s]);
+      buffer->ring_fences[s] = NULL;
+    }
+  }
+
+  buffer->buffer_offset = offset;
+}
+
 void immInit(void)
 {
 #if TRUST_NO_ONE
@@ -93,14 +193,8 @@ void immInit(void)
 #endif
   memset(&imm, 0, sizeof(Immediate));
 
-  imm.draw_buffer.vbo_id = GPU_buf_alloc();
-  imm.draw_buffer.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glBindBuffer(GL_ARRAY_BUFFER, imm.draw_buffer.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, imm.draw_buffer.buffer_size, NULL, GL_DYNAMIC_DRAW);
-  imm.draw_buffer_strict.vbo_id = GPU_buf_alloc();
-  imm.draw_buffer_strict.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glBindBuffer(GL_ARRAY_BUFFER, imm.draw_buffer_strict.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, imm.draw_buffer_strict.buffer_size, NULL, GL_DYNAMIC_DRAW);
+  imm_buffer_create(&imm.draw_buffer, DEFAULT_INTERNAL_BUFFER_SIZE);
+  imm_buffer_create(&imm.draw_buffer_strict, DEFAULT_INTERNAL_BUFFER_SIZE);
 
   imm.prim_type = GPU_PRIM_NONE;
   imm.strict_vertex_len = true;
@@ -134,8 +228,8 @@ void immDeactivate(void)
 
 void immDestroy(void)
 {
-  GPU_buf_free(imm.draw_buffer.vbo_id);
-  GPU_buf_free(imm.draw_buffer_strict.vbo_id);
+  imm_buffer_discard(&imm.draw_buffer);
+  imm_buffer_discard(&imm.draw_buffer_strict);
   initialized = false;
 }
 
@@ -239,57 +333,63 @@ void immBegin(GPUPrimType prim_type, uint vertex_len)
 
   glBindBuffer(GL_ARRAY_BUFFER, active_buffer->vbo_id);
 
-  /* does the current buffer have enough room? */
-  const uint available_bytes = active_buffer->buffer_size - active_buffer->buffer_offset;
-
-  bool recreate_buffer = false;
-  if (bytes_needed > active_buffer->buffer_size) {
-    /* expand the internal buffer */
-    active_buffer->buffer_size = bytes_needed;
-    recreate_buffer = true;
-  }
-  else if (bytes_needed < DEFAULT_INTERNAL_BUFFER_SIZE &&
-           active_buffer->buffer_size > DEFAULT_INTERNAL_BUFFER_SIZE) {
-    /* shrink the internal buffer */
-    active_buffer->buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-    recreate_buffer = true;
+  if (active_buffer->persistent_map) {
+    imm_ring_buffer_alloc(active_buffer, bytes_needed, imm.vertex_format.stride);
+    active_buffer->buffer_data = active_buffer->persistent_map + active_buffer->buffer_offset;
   }
+  else {
+    /* does the current buffer have enough room? */
+    const uint available_bytes = active_buffer->buffer_size - active_buffer->buffer_offset;
+
+    bool recreate_buffer = false;
+    if (bytes_needed > active_buffer->buffer_size) {
+      /* expand the internal buffer */
+      active_buffer->buffer_size = bytes_needed;
+      recreate_buffer = true;
+    }
+    else if (bytes_needed < DEFAULT_INTERNAL_BUFFER_SIZE &&
+             active_buffer->buffer_size > DEFAULT_INTERNAL_BUFFER_SIZE) {
+      /* shrink the internal buffer */
+      active_buffer->buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
+      recreate_buffer = true;
+    }
 
-  /* ensure vertex data is aligned */
-  /* Might waste a little space, but it's safe. */
-  const uint pre_padding = padding(active_buffer->buffer_offset, imm.vertex_format.stride);
+    /* ensure vertex data is aligned */
+    /* Might waste a little space, but it's safe. */
+    const uint pre_padding = padding(active_buffer->buffer_offset, imm.vertex_format.stride);
 
-  if (!recreate_buffer && ((bytes_needed + pre_padding) <= available_bytes)) {
-    active_buffer->buffer_offset += pre_padding;
-  }
-  else {
-    /* orphan this buffer & start with a fresh one */
-    /* this method works on all platforms, old & new */
-    glBufferData(GL_ARRAY_BUFFER, active_buffer->buffer_size, NULL, GL_DYNAMIC_DRAW);
+    if (!recreate_buffer && ((bytes_needed + pre_padding) <= available_bytes)) {
+      active_buffer->buffer_offset += pre_padding;
+    }
+    else {
+      /* orphan this buffer & start with a fresh one */
+      /* this method works on all platforms, old & new */
+      glBufferData(GL_ARRAY_BUFFER, active_buffer->buffer_size, NULL, GL_DYNAMIC_DRAW);
 
-    active_buffer->buffer_offset = 0;
-  }
+      active_buffer->buffer_offset = 0;
+    }
 
-  /*  printf("mapping %u to %u\n", imm.buffer_offset, imm.buffer_offset + bytes_needed - 1); */
+    /*  printf("mapping %u to %u\n", imm.buffer_offset, imm.buffer_offset + bytes_needed - 1); */
 
 #if TRUST_NO_ONE
-  {
-    GLint bufsize;
-    glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &bufsize);
-    assert(active_buffer->buffer_offset + bytes_needed <= bufsize);
-  }
+    {
+      GLint bufsize;
+      glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &bufsize);
+      assert(active_buffer->buffer_offset + bytes_needed <= bufsize);
+    }
 #endif
 
-  active_buffer->buffer_data = glMapBufferRange(
-      GL_ARRAY_BUFFER,
-      active_buffer->buffer_offset,
-      bytes_needed,
-      GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
-          (imm.strict_vertex_len ? 0 : GL_MAP_FLUSH_EXPLICIT_BIT));
+    active_buffer->buffer_data = glMapBufferRange(
+        GL_ARRAY_BUFFER,
+        active_buffer->buffer_offset,
+        bytes_needed,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+            (imm.strict_vertex_len ? 0 : GL_MAP_FLUSH_EXPLICIT_BIT));
 
 #if TRUST_NO_ONE
-  assert(active_buffer->buffer_data != NULL);
+    assert(active_buffer->buffer_data != NULL);
 #endif
+  }
 
   imm.buffer_bytes_mapped = bytes_needed;
   imm.vertex_data = active_buffer->buffer_data;
@@ -415,8 +515,10 @@ void immEnd(void)
       buffer_bytes_used = vertex_buffer_size(&imm.vertex_format, imm.vertex_len);
       /* unused buffer bytes are available to the next immBegin */
     }
-    /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
-    glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    if (imm.active_buffer && imm.active_buffer->persistent_map == NULL) {
+      /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    }
   }
 
   if (imm.batch) {
@@ -429,7 +531,9 @@ void immEnd(void)
     imm.batch = NULL; /* don't free, batch belongs to caller */
   }
   else {
-    glUnmapBuffer(GL_ARRAY_BUFFER);
+    if (imm.active_buffer->persistent_map == NULL) {
+      glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
 
     if (imm.vertex_len > 0) {
       immDrawSetup();
@@ -447,6 +551,22 @@ void immEnd(void)
     // glBindVertexArray(0);
     /* prep for next immBegin */
     imm.active_buffer->buffer_offset += buffer_bytes_used;
+
+    if (imm.active_buffer->persistent_map) {
+      ImmediateDrawBuffer *buffer = imm.active_buffer;
+      const uint section_size = buffer->buffer_size / IMM_RING_SECTIONS;
+      uint section = buffer->buffer_offset / section_size;
+      CLAMP_MAX(section, IMM_RING_SECTIONS - 1);
+      /* The draw calls of every section the write head moved past are
+       * submitted by now, fence them so the next lap around the ring can
+       * wait for the GPU to be done reading them. */
+      for (uint s = buffer->ring_section; s < section; s++) {
+        if (buffer->ring_fences[s] == NULL) {
+          buffer->ring_fences[s] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+      }
+      buffer->ring_section = section;
+    }
   }
 
   /* prep for next immBegin */
@@ -284,6 +284,19 @@ void GPU_vertbuf_use(GPUVertBuf *verts)
   }
 }
 
+void GPU_vertbuf_update_sub(GPUVertBuf *verts, uint start, uint len, const void *data)
+{
+#if TRUST_NO_ONE
+  /* The buffer must already exist on the GPU with up to date contents, a
+   * partial update of a buffer that still has pending data makes no sense. */
+  assert(verts->vbo_id != 0);
+  assert(!verts->dirty);
+  assert(start + len <= GPU_vertbuf_size_get(verts));
+#endif
+  glBindBuffer(GL_ARRAY_BUFFER, verts->vbo_id);
+  glBufferSubData(GL_ARRAY_BUFFER, start, len, data);
+}
+
 uint GPU_vertbuf_get_memory_usage(void)
 {
   return vbo_memory_usage;
@@ -123,7 +123,7 @@ uniform mat4 ModelViewProjectionMatrix;
 
 #define MAX_PARAM 11
 #ifdef USE_INSTANCE
-#  define MAX_INSTANCE 6
+#  define MAX_INSTANCE 16
 uniform vec4 parameters[MAX_PARAM * MAX_INSTANCE];
 #else
 uniform vec4 parameters[MAX_PARAM];
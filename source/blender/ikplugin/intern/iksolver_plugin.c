@@ -274,6 +274,13 @@ static void where_is_ik_bone(bPoseChannel *pchan,
 
 /* called from within the core BKE_pose_where_is loop, all animsystems and constraints
  * were executed & assigned. Now as last we do an IK pass */
+/* NOTE: Independent pose trees are not solved in a loop here: each tree root is its own
+ * depsgraph operation node (#BKE_pose_iktree_evaluate), so disjoint chains already run
+ * concurrently on the evaluation task scheduler. The solve is seeded from the current frame's
+ * animated pose; seeding from the previous frame's solution instead was rejected because pose
+ * evaluation must stay a pure function of the frame (random access and repeated evaluation of
+ * one frame have to give identical results). Rigs that want stateful, history-based solving can
+ * use the iTaSC solver in simulation mode, which carries solver state across frames. */
 static void execute_posetree(struct Depsgraph *depsgraph,
                              struct Scene *scene,
                              Object *ob,
@@ -24,6 +24,8 @@
 #ifndef __IMB_THUMBS_H__
 #define __IMB_THUMBS_H__
 
+#include "BLI_sys_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -82,6 +84,8 @@ struct ImBuf *IMB_thumb_load_blend(const char *blen_path,
                                    const char *blen_group,
                                    const char *blen_id);
 void IMB_thumb_overlay_blend(unsigned int *thumb, int width, int height, float aspect);
+/* free the in-process cache of blend file thumbnails */
+void IMB_thumb_blend_cache_free(void);
 
 /* special function for previewing fonts */
 struct ImBuf *IMB_thumb_load_font(const char *filename, unsigned int x, unsigned int y);
@@ -89,6 +93,29 @@ bool IMB_thumb_load_font_get_hash(char *r_hash);
 void IMB_thumb_clear_translations(void);
 void IMB_thumb_ensure_translations(void);
 
+/* Packed per-directory thumbnail database, defined in thumbs_db.c.
+ * Caches the decoded thumbnails of a whole directory in a single file,
+ * so revisiting a directory needs one read instead of one PNG per entry. */
+typedef struct IMB_ThumbDB IMB_ThumbDB;
+
+/* Read the database for a directory. Returns an empty database when there
+ * is none yet, NULL only when no cache location can be determined. */
+IMB_ThumbDB *IMB_thumb_db_read(const char *dir_path);
+/* Thread-safe, the stored data is immutable. Returns a new ImBuf, or NULL
+ * when there is no entry or the source file changed since it was recorded. */
+struct ImBuf *IMB_thumb_db_lookup(IMB_ThumbDB *db,
+                                  const char *file_path,
+                                  const int64_t mtime,
+                                  const int64_t size);
+/* Record a freshly generated thumbnail, written out by IMB_thumb_db_write.
+ * Thread-safe, references the image (does not copy it). */
+void IMB_thumb_db_add(
+    IMB_ThumbDB *db, const char *file_path, const int64_t mtime, const int64_t size, struct ImBuf *img);
+bool IMB_thumb_db_write(IMB_ThumbDB *db);
+void IMB_thumb_db_free(IMB_ThumbDB *db);
+
+bool IMB_thumb_db_path_from_dir(const char *dir_path, char *r_path, const size_t path_len);
+
 /* Threading */
 void IMB_thumb_locks_acquire(void);
 void IMB_thumb_locks_release(void);
@@ -54,6 +54,8 @@
 #  include "AVI_avi.h"
 #endif
 
+#include "DNA_listBase.h"
+
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
 
@@ -137,6 +139,15 @@ struct anim {
   int64_t last_pts;
   int64_t next_pts;
   AVPacket next_packet;
+
+  /* Decode-ahead: while the caller processes the current frame, a worker thread decodes the
+   * next one into prefetch_frame. The worker owns all FFmpeg state of this anim while it runs,
+   * fetches join it before touching the decoder again. */
+  struct ListBase prefetch_threads;
+  int prefetch_in_flight;
+  int prefetch_position;
+  int prefetch_tc; /* IMB_Timecode_Type */
+  struct ImBuf *prefetch_frame;
 #endif
 
   char index_dir[768];
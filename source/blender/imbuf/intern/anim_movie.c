@@ -55,6 +55,7 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "MEM_guardedalloc.h"
@@ -1202,12 +1203,78 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
   return anim->last_frame;
 }
 
+static void *ffmpeg_prefetch_startjob(void *anim_v)
+{
+  struct anim *anim = anim_v;
+
+  anim->prefetch_frame = ffmpeg_fetchibuf(
+      anim, anim->prefetch_position, (IMB_Timecode_Type)anim->prefetch_tc);
+
+  return NULL;
+}
+
+static void ffmpeg_prefetch_join(struct anim *anim)
+{
+  if (anim->prefetch_in_flight) {
+    BLI_threadpool_end(&anim->prefetch_threads);
+    anim->prefetch_in_flight = false;
+  }
+}
+
+/**
+ * Fetch a frame with decode-ahead: after handing out a frame of a sequential playback run, the
+ * next one is decoded on a worker thread so the caller's color management and compositing
+ * overlap with the decode instead of waiting for it. The decoder state is still owned by one
+ * thread at a time, fetches join the worker before touching FFmpeg again.
+ */
+static ImBuf *ffmpeg_fetchibuf_prefetch(struct anim *anim, int position, IMB_Timecode_Type tc)
+{
+  ImBuf *ibuf;
+  bool sequential;
+
+  ffmpeg_prefetch_join(anim);
+
+  if (anim->prefetch_frame && anim->prefetch_position == position &&
+      anim->prefetch_tc == (int)tc) {
+    /* The reference the worker's fetch added is passed on to the caller. */
+    ibuf = anim->prefetch_frame;
+    anim->prefetch_frame = NULL;
+    sequential = true;
+  }
+  else {
+    if (anim->prefetch_frame) {
+      IMB_freeImBuf(anim->prefetch_frame);
+      anim->prefetch_frame = NULL;
+    }
+    sequential = (position == anim->curposition + 1);
+    ibuf = ffmpeg_fetchibuf(anim, position, tc);
+  }
+
+  /* Only decode ahead when playback is sequential. For random scrubbing the speculative decode
+   * would make the next fetch wait on a frame it doesn't want. */
+  if (ibuf != NULL && sequential && position + 1 < anim->duration_in_frames) {
+    anim->prefetch_position = position + 1;
+    anim->prefetch_tc = (int)tc;
+    BLI_threadpool_init(&anim->prefetch_threads, ffmpeg_prefetch_startjob, 1);
+    BLI_threadpool_insert(&anim->prefetch_threads, anim);
+    anim->prefetch_in_flight = true;
+  }
+
+  return ibuf;
+}
+
 static void free_anim_ffmpeg(struct anim *anim)
 {
   if (anim == NULL) {
     return;
   }
 
+  ffmpeg_prefetch_join(anim);
+  if (anim->prefetch_frame) {
+    IMB_freeImBuf(anim->prefetch_frame);
+    anim->prefetch_frame = NULL;
+  }
+
   if (anim->pCodecCtx) {
     avcodec_close(anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -1388,10 +1455,11 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim,
 #endif
 #ifdef WITH_FFMPEG
     case ANIM_FFMPEG:
-      ibuf = ffmpeg_fetchibuf(anim, position, tc);
-      if (ibuf) {
-        anim->curposition = position;
-      }
+      ibuf = ffmpeg_fetchibuf_prefetch(anim, position, tc);
+      /* Unlike the other formats, curposition is not written here: ffmpeg_fetchibuf already
+       * updates it, and a prefetch worker may be past it fetching the next frame by now. A
+       * redundant store from this thread could overwrite the worker's value and make its seek
+       * decision see a stale position. */
       filter_y = 0; /* done internally */
       break;
 #endif
@@ -1401,7 +1469,9 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim,
     if (filter_y) {
       IMB_filtery(ibuf);
     }
-    BLI_snprintf(ibuf->name, sizeof(ibuf->name), "%s.%04d", anim->name, anim->curposition + 1);
+    /* Use the requested position, not curposition: for FFmpeg a prefetch worker may already
+     * have moved curposition to the frame it is decoding ahead. */
+    BLI_snprintf(ibuf->name, sizeof(ibuf->name), "%s.%04d", anim->name, position + 1);
   }
   return (ibuf);
 }
@@ -27,6 +27,10 @@
 #include <math.h>
 #include <string.h>
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 #include "DNA_color_types.h"
 #include "DNA_image_types.h"
 #include "DNA_movieclip_types.h"
@@ -101,6 +105,9 @@ typedef struct ColormanageProcessor {
   OCIO_ConstProcessorRcPtr *processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+  /* false when the processor handle is shared with the display processor cache and must not be
+   * released together with this ColormanageProcessor. */
+  bool owns_processor;
 } ColormanageProcessor;
 
 static struct global_glsl_state {
@@ -135,6 +142,27 @@ static struct global_color_picking_state {
   bool failed;
 } global_color_picking_state = {NULL};
 
+/* Display buffer processors are expensive to create (the whole OCIO transform chain is
+ * re-evaluated), while interactive playback requests one with identical settings for every
+ * frame. Keep the first distinct setting combinations around for re-use: OCIO processors are
+ * immutable and thread-safe, so a single handle can be shared by all threads, and entries are
+ * only released on exit so handed out processors stay valid for their whole lifetime. */
+#define DISPLAY_PROCESSOR_CACHE_SIZE 8
+
+typedef struct CachedDisplayProcessor {
+  char look[MAX_COLORSPACE_NAME];
+  char view_transform[MAX_COLORSPACE_NAME];
+  char display[MAX_COLORSPACE_NAME];
+  char from_colorspace[MAX_COLORSPACE_NAME];
+  float exposure, gamma;
+  OCIO_ConstProcessorRcPtr *processor;
+} CachedDisplayProcessor;
+
+static struct display_processor_cache {
+  CachedDisplayProcessor entries[DISPLAY_PROCESSOR_CACHE_SIZE];
+  int num_entries;
+} display_processor_cache = {{{{0}}}, 0};
+
 /*********************** Color managed cache *************************/
 
 /* Cache Implementation Notes
@@ -743,8 +771,13 @@ void colormanagement_exit(void)
     OCIO_processorRelease(global_color_picking_state.processor_from);
   }
 
+  for (int i = 0; i < display_processor_cache.num_entries; i++) {
+    OCIO_processorRelease(display_processor_cache.entries[i].processor);
+  }
+
   memset(&global_glsl_state, 0, sizeof(global_glsl_state));
   memset(&global_color_picking_state, 0, sizeof(global_color_picking_state));
+  memset(&display_processor_cache, 0, sizeof(display_processor_cache));
 
   colormanage_free_config();
 }
@@ -909,6 +942,62 @@ static OCIO_ConstProcessorRcPtr *create_display_buffer_processor(const char *loo
   return processor;
 }
 
+/**
+ * Get a display buffer processor from the cache, creating and caching it on first use.
+ * \a r_owned is set to true when the returned processor could not be cached and ownership is
+ * transferred to the caller. Only the non-linear output variant is cached, it is the one
+ * requested for every frame of display and playback.
+ */
+static OCIO_ConstProcessorRcPtr *display_buffer_processor_get_cached(const char *look,
+                                                                     const char *view_transform,
+                                                                     const char *display,
+                                                                     float exposure,
+                                                                     float gamma,
+                                                                     const char *from_colorspace,
+                                                                     bool *r_owned)
+{
+  OCIO_ConstProcessorRcPtr *processor;
+  int i;
+
+  BLI_mutex_lock(&processor_lock);
+
+  for (i = 0; i < display_processor_cache.num_entries; i++) {
+    CachedDisplayProcessor *entry = &display_processor_cache.entries[i];
+
+    if (STREQ(entry->look, look) && STREQ(entry->view_transform, view_transform) &&
+        STREQ(entry->display, display) && STREQ(entry->from_colorspace, from_colorspace) &&
+        entry->exposure == exposure && entry->gamma == gamma) {
+      BLI_mutex_unlock(&processor_lock);
+      *r_owned = false;
+      return entry->processor;
+    }
+  }
+
+  processor = create_display_buffer_processor(
+      look, view_transform, display, exposure, gamma, from_colorspace, false);
+
+  if (processor && display_processor_cache.num_entries < DISPLAY_PROCESSOR_CACHE_SIZE) {
+    CachedDisplayProcessor *entry =
+        &display_processor_cache.entries[display_processor_cache.num_entries++];
+
+    BLI_strncpy(entry->look, look, sizeof(entry->look));
+    BLI_strncpy(entry->view_transform, view_transform, sizeof(entry->view_transform));
+    BLI_strncpy(entry->display, display, sizeof(entry->display));
+    BLI_strncpy(entry->from_colorspace, from_colorspace, sizeof(entry->from_colorspace));
+    entry->exposure = exposure;
+    entry->gamma = gamma;
+    entry->processor = processor;
+
+    BLI_mutex_unlock(&processor_lock);
+    *r_owned = false;
+    return processor;
+  }
+
+  BLI_mutex_unlock(&processor_lock);
+  *r_owned = true;
+  return processor;
+}
+
 static OCIO_ConstProcessorRcPtr *create_display_encoded_buffer_processor(
     const char *UNUSED(display))
 {
@@ -2775,6 +2864,80 @@ unsigned char *IMB_display_buffer_acquire_ctx(const bContext *C, ImBuf *ibuf, vo
   return IMB_display_buffer_acquire(ibuf, view_settings, display_settings, cache_handle);
 }
 
+typedef struct DisplayTransformInitData {
+  ColormanageProcessor *cm_processor;
+  unsigned char *display_buffer;
+  const float *linear_buffer;
+  int width;
+  int channels;
+  bool predivide;
+} DisplayTransformInitData;
+
+typedef struct DisplayTransformThread {
+  ColormanageProcessor *cm_processor;
+  unsigned char *display_buffer;
+  const float *linear_buffer;
+  int width;
+  int tot_line;
+  int channels;
+  bool predivide;
+} DisplayTransformThread;
+
+static void display_transform_init_handle(void *handle_v,
+                                          int start_line,
+                                          int tot_line,
+                                          void *init_data_v)
+{
+  DisplayTransformThread *handle = (DisplayTransformThread *)handle_v;
+  DisplayTransformInitData *init_data = (DisplayTransformInitData *)init_data_v;
+
+  const size_t offset = (size_t)init_data->channels * start_line * init_data->width;
+  const size_t display_offset = (size_t)DISPLAY_BUFFER_CHANNELS * start_line * init_data->width;
+
+  handle->cm_processor = init_data->cm_processor;
+  handle->display_buffer = init_data->display_buffer + display_offset;
+  handle->linear_buffer = init_data->linear_buffer + offset;
+  handle->width = init_data->width;
+  handle->tot_line = tot_line;
+  handle->channels = init_data->channels;
+  handle->predivide = init_data->predivide;
+}
+
+static void *do_display_transform_thread(void *handle_v)
+{
+  DisplayTransformThread *handle = (DisplayTransformThread *)handle_v;
+
+  float *buffer = MEM_mallocN(
+      (size_t)handle->channels * handle->width * handle->tot_line * sizeof(float),
+      "display transform temp buffer");
+  memcpy(buffer,
+         handle->linear_buffer,
+         (size_t)handle->channels * handle->width * handle->tot_line * sizeof(float));
+
+  IMB_colormanagement_processor_apply(handle->cm_processor,
+                                      buffer,
+                                      handle->width,
+                                      handle->tot_line,
+                                      handle->channels,
+                                      handle->predivide);
+
+  IMB_buffer_byte_from_float(handle->display_buffer,
+                             buffer,
+                             handle->channels,
+                             0.0f,
+                             IB_PROFILE_SRGB,
+                             IB_PROFILE_SRGB,
+                             false,
+                             handle->width,
+                             handle->tot_line,
+                             handle->width,
+                             handle->width);
+
+  MEM_freeN(buffer);
+
+  return NULL;
+}
+
 void IMB_display_buffer_transform_apply(unsigned char *display_buffer,
                                         float *linear_buffer,
                                         int width,
@@ -2784,31 +2947,24 @@ void IMB_display_buffer_transform_apply(unsigned char *display_buffer,
                                         const ColorManagedDisplaySettings *display_settings,
                                         bool predivide)
 {
-  float *buffer;
   ColormanageProcessor *cm_processor = IMB_colormanagement_display_processor_new(view_settings,
                                                                                  display_settings);
 
-  buffer = MEM_mallocN((size_t)channels * width * height * sizeof(float),
-                       "display transform temp buffer");
-  memcpy(buffer, linear_buffer, (size_t)channels * width * height * sizeof(float));
+  DisplayTransformInitData init_data;
+  init_data.cm_processor = cm_processor;
+  init_data.display_buffer = display_buffer;
+  init_data.linear_buffer = linear_buffer;
+  init_data.width = width;
+  init_data.channels = channels;
+  init_data.predivide = predivide;
 
-  IMB_colormanagement_processor_apply(cm_processor, buffer, width, height, channels, predivide);
+  IMB_processor_apply_threaded(height,
+                               sizeof(DisplayTransformThread),
+                               &init_data,
+                               display_transform_init_handle,
+                               do_display_transform_thread);
 
   IMB_colormanagement_processor_free(cm_processor);
-
-  IMB_buffer_byte_from_float(display_buffer,
-                             buffer,
-                             channels,
-                             0.0f,
-                             IB_PROFILE_SRGB,
-                             IB_PROFILE_SRGB,
-                             false,
-                             width,
-                             height,
-                             width,
-                             width);
-
-  MEM_freeN(buffer);
 }
 
 void IMB_display_buffer_release(void *cache_handle)
@@ -3773,13 +3929,14 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
     cm_processor->is_data_result = display_space->is_data;
   }
 
-  cm_processor->processor = create_display_buffer_processor(applied_view_settings->look,
-                                                            applied_view_settings->view_transform,
-                                                            display_settings->display_device,
-                                                            applied_view_settings->exposure,
-                                                            applied_view_settings->gamma,
-                                                            global_role_scene_linear,
-                                                            false);
+  cm_processor->processor = display_buffer_processor_get_cached(
+      applied_view_settings->look,
+      applied_view_settings->view_transform,
+      display_settings->display_device,
+      applied_view_settings->exposure,
+      applied_view_settings->gamma,
+      global_role_scene_linear,
+      &cm_processor->owns_processor);
 
   if (applied_view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) {
     cm_processor->curve_mapping = BKE_curvemapping_copy(applied_view_settings->curve_mapping);
@@ -3801,6 +3958,7 @@ ColormanageProcessor *IMB_colormanagement_colorspace_processor_new(const char *f
   cm_processor->is_data_result = color_space->is_data;
 
   cm_processor->processor = create_colorspace_transform_processor(from_colorspace, to_colorspace);
+  cm_processor->owns_processor = true;
 
   return cm_processor;
 }
@@ -3903,6 +4061,56 @@ void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
   }
 }
 
+static void byte_row_to_float_row(float *dst, const unsigned char *src, int width)
+{
+  int x = 0;
+#ifdef __SSE2__
+  const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+  const __m128i zero = _mm_setzero_si128();
+  for (; x + 4 <= width; x += 4) {
+    const __m128i bytes = _mm_loadu_si128((const __m128i *)(src + 4 * x));
+    const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+    const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+    _mm_storeu_ps(dst + 4 * x + 0,
+                  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+    _mm_storeu_ps(dst + 4 * x + 4,
+                  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+    _mm_storeu_ps(dst + 4 * x + 8,
+                  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+    _mm_storeu_ps(dst + 4 * x + 12,
+                  _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+  }
+#endif
+  for (; x < width; x++) {
+    rgba_uchar_to_float(dst + 4 * x, src + 4 * x);
+  }
+}
+
+static void float_row_to_byte_row(unsigned char *dst, const float *src, int width)
+{
+  int x = 0;
+#ifdef __SSE2__
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 scale = _mm_set1_ps(255.0f);
+  for (; x + 4 <= width; x += 4) {
+    const __m128i a = _mm_cvtps_epi32(
+        _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 4 * x + 0), zero), one), scale));
+    const __m128i b = _mm_cvtps_epi32(
+        _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 4 * x + 4), zero), one), scale));
+    const __m128i c = _mm_cvtps_epi32(
+        _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 4 * x + 8), zero), one), scale));
+    const __m128i d = _mm_cvtps_epi32(
+        _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + 4 * x + 12), zero), one), scale));
+    _mm_storeu_si128((__m128i *)(dst + 4 * x),
+                     _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+  }
+#endif
+  for (; x < width; x++) {
+    rgba_float_to_uchar(dst + 4 * x, src + 4 * x);
+  }
+}
+
 void IMB_colormanagement_processor_apply_byte(
     ColormanageProcessor *cm_processor, unsigned char *buffer, int width, int height, int channels)
 {
@@ -3910,15 +4118,45 @@ void IMB_colormanagement_processor_apply_byte(
    * but for now it's not so important.
    */
   BLI_assert(channels == 4);
-  float pixel[4];
+
+  /* Rows are converted to float and handed to OCIO as whole scanlines: one processor
+   * invocation per row is much cheaper than the per-pixel calls used before. */
+  float *row_buffer = MEM_mallocN(sizeof(float) * 4 * width, __func__);
+  OCIO_PackedImageDesc *img = NULL;
+
+  if (cm_processor->processor) {
+    img = OCIO_createOCIO_PackedImageDesc(row_buffer,
+                                          width,
+                                          1,
+                                          4,
+                                          sizeof(float),
+                                          4 * sizeof(float),
+                                          4 * sizeof(float) * (size_t)width);
+  }
+
   for (int y = 0; y < height; y++) {
-    for (int x = 0; x < width; x++) {
-      size_t offset = channels * (((size_t)y) * width + x);
-      rgba_uchar_to_float(pixel, buffer + offset);
-      IMB_colormanagement_processor_apply_v4(cm_processor, pixel);
-      rgba_float_to_uchar(buffer + offset, pixel);
+    unsigned char *row = buffer + channels * (((size_t)y) * width);
+
+    byte_row_to_float_row(row_buffer, row, width);
+
+    if (cm_processor->curve_mapping) {
+      for (int x = 0; x < width; x++) {
+        BKE_curvemapping_evaluate_premulRGBF(
+            cm_processor->curve_mapping, row_buffer + 4 * x, row_buffer + 4 * x);
+      }
+    }
+
+    if (img) {
+      OCIO_processorApply(cm_processor->processor, img);
     }
+
+    float_row_to_byte_row(row, row_buffer, width);
   }
+
+  if (img) {
+    OCIO_PackedImageDescRelease(img);
+  }
+  MEM_freeN(row_buffer);
 }
 
 void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
@@ -3926,7 +4164,7 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_free(cm_processor->curve_mapping);
   }
-  if (cm_processor->processor) {
+  if (cm_processor->processor && cm_processor->owns_processor) {
     OCIO_processorRelease(cm_processor->processor);
   }
 
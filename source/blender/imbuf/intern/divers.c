@@ -35,6 +35,10 @@
 
 #include "MEM_guardedalloc.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 /************************* Floyd-Steinberg dithering *************************/
 
 typedef struct DitherContext {
@@ -96,6 +100,39 @@ MINLINE void float_to_byte_dither_v4(
   b[3] = unit_float_to_uchar_clamp(f[3]);
 }
 
+#ifdef __SSE2__
+
+/* SSE2 fast paths for the common 4 channel conversions, one pixel per vector with a lane per
+ * channel. The transfer curves reuse the vectorized versions from BLI_math_color, the dither
+ * and predivide code paths stay scalar. */
+
+BLI_INLINE __m128 pixel_byte_to_float_ps(const uchar *ptr)
+{
+  __m128i pixel_i = _mm_cvtsi32_si128(*(const int *)ptr);
+  pixel_i = _mm_unpacklo_epi8(pixel_i, _mm_setzero_si128());
+  pixel_i = _mm_unpacklo_epi16(pixel_i, _mm_setzero_si128());
+  return _mm_mul_ps(_mm_cvtepi32_ps(pixel_i), _mm_set1_ps(1.0f / 255.0f));
+}
+
+BLI_INLINE void pixel_float_to_byte_ps(uchar *ptr, __m128 pixel)
+{
+  pixel = _mm_max_ps(_mm_min_ps(pixel, _mm_set1_ps(1.0f)), _mm_setzero_ps());
+  __m128i pixel_i = _mm_cvtps_epi32(_mm_mul_ps(pixel, _mm_set1_ps(255.0f)));
+  pixel_i = _mm_packs_epi32(pixel_i, pixel_i);
+  pixel_i = _mm_packus_epi16(pixel_i, pixel_i);
+  *(int *)ptr = _mm_cvtsi128_si32(pixel_i);
+}
+
+/* Return \a color with its alpha lane replaced by the one from \a alpha, for transfer
+ * curves which only apply to the RGB channels. */
+BLI_INLINE __m128 pixel_keep_alpha_ps(__m128 color, __m128 alpha)
+{
+  const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+  return _bli_math_blend_sse(mask, alpha, color);
+}
+
+#endif /* __SSE2__ */
+
 /* Test if colorspace conversions of pixels in buffer need to take into account alpha. */
 bool IMB_alpha_affects_rgb(const ImBuf *ibuf)
 {
@@ -198,7 +235,11 @@ void IMB_buffer_byte_from_float(uchar *rect_to,
         }
         else {
           for (x = 0; x < width; x++, from += 4, to += 4) {
+#ifdef __SSE2__
+            pixel_float_to_byte_ps(to, _mm_loadu_ps(from));
+#else
             rgba_float_to_uchar(to, from);
+#endif
           }
         }
       }
@@ -229,8 +270,14 @@ void IMB_buffer_byte_from_float(uchar *rect_to,
         }
         else {
           for (x = 0; x < width; x++, from += 4, to += 4) {
+#ifdef __SSE2__
+            __m128 pixel = _mm_loadu_ps(from);
+            pixel_float_to_byte_ps(to,
+                                   pixel_keep_alpha_ps(linearrgb_to_srgb_v4_simd(pixel), pixel));
+#else
             linearrgb_to_srgb_ushort4(us, from);
             ushort_to_byte_v4(to, us);
+#endif
           }
         }
       }
@@ -256,8 +303,14 @@ void IMB_buffer_byte_from_float(uchar *rect_to,
         }
         else {
           for (x = 0; x < width; x++, from += 4, to += 4) {
+#ifdef __SSE2__
+            __m128 pixel = _mm_loadu_ps(from);
+            pixel_float_to_byte_ps(to,
+                                   pixel_keep_alpha_ps(srgb_to_linearrgb_v4_simd(pixel), pixel));
+#else
             srgb_to_linearrgb_v4(tmp, from);
             rgba_float_to_uchar(to, tmp);
+#endif
           }
         }
       }
@@ -386,7 +439,11 @@ void IMB_buffer_float_from_byte(float *rect_to,
     if (profile_to == profile_from) {
       /* no color space conversion */
       for (x = 0; x < width; x++, from += 4, to += 4) {
+#ifdef __SSE2__
+        _mm_storeu_ps(to, pixel_byte_to_float_ps(from));
+#else
         rgba_uchar_to_float(to, from);
+#endif
       }
     }
     else if (profile_to == IB_PROFILE_LINEAR_RGB) {
@@ -412,8 +469,13 @@ void IMB_buffer_float_from_byte(float *rect_to,
       }
       else {
         for (x = 0; x < width; x++, from += 4, to += 4) {
+#ifdef __SSE2__
+          __m128 pixel = pixel_byte_to_float_ps(from);
+          _mm_storeu_ps(to, pixel_keep_alpha_ps(linearrgb_to_srgb_v4_simd(pixel), pixel));
+#else
           rgba_uchar_to_float(tmp, from);
           linearrgb_to_srgb_v4(to, tmp);
+#endif
         }
       }
     }
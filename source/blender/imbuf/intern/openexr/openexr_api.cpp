@@ -31,6 +31,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 
 #include <Iex.h>
 #include <ImathBox.h>
@@ -78,6 +79,7 @@ _CRTIMP void __cdecl _invalid_parameter_noinfo(void)
 }
 #include "BLI_blenlib.h"
 #include "BLI_math_color.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_idprop.h"
@@ -1093,6 +1095,28 @@ void IMB_exr_clear_channels(void *handle)
   BLI_freelistN(&data->channels);
 }
 
+/* Userdata for the parallel float to half conversion when writing channels. */
+typedef struct ExrHalfConversionData {
+  std::vector<ExrChannel *> *channels;
+  half *rect_half;
+  size_t num_pixels;
+} ExrHalfConversionData;
+
+static void imb_exr_convert_half_cb(void *__restrict userdata,
+                                    const int n,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ExrHalfConversionData *convert_data = (ExrHalfConversionData *)userdata;
+  const ExrChannel *echan = (*convert_data->channels)[n];
+  const size_t num_pixels = convert_data->num_pixels;
+  const float *rect = echan->rect;
+  half *cur = convert_data->rect_half + (size_t)n * num_pixels;
+
+  for (size_t i = 0; i < num_pixels; i++, cur++) {
+    *cur = rect[i * echan->xstride];
+  }
+}
+
 void IMB_exr_write_channels(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
@@ -1102,22 +1126,21 @@ void IMB_exr_write_channels(void *handle)
   if (data->channels.first) {
     const size_t num_pixels = ((size_t)data->width) * data->height;
     half *rect_half = NULL, *current_rect_half = NULL;
+    std::vector<ExrChannel *> half_channels;
 
     /* We allocate teporary storage for half pixels for all the channels at once. */
     if (data->num_half_channels != 0) {
       rect_half = (half *)MEM_mallocN(sizeof(half) * data->num_half_channels * num_pixels,
                                       __func__);
       current_rect_half = rect_half;
+      half_channels.reserve(data->num_half_channels);
     }
 
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       /* Writing starts from last scanline, stride negative. */
       if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = rect[i * echan->xstride];
-        }
+        /* Conversion to half is deferred, so it runs in parallel over all channels below. */
+        half_channels.push_back(echan);
         half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
         frameBuffer.insert(
             echan->name,
@@ -1134,6 +1157,18 @@ void IMB_exr_write_channels(void *handle)
       }
     }
 
+    if (!half_channels.empty()) {
+      ExrHalfConversionData convert_data;
+      convert_data.channels = &half_channels;
+      convert_data.rect_half = rect_half;
+      convert_data.num_pixels = num_pixels;
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      BLI_task_parallel_range(
+          0, (int)half_channels.size(), &convert_data, imb_exr_convert_half_cb, &settings);
+    }
+
     data->ofile->setFrameBuffer(frameBuffer);
     try {
       data->ofile->writePixels(data->height);
@@ -1270,6 +1305,12 @@ void IMB_exr_read_channels(void *handle)
       }
     }
 
+    /* No requested channel lives in this part, skip it entirely so its compressed
+     * data is never read or decoded. */
+    if (frameBuffer.begin() == frameBuffer.end()) {
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
@@ -22,6 +22,7 @@
  * \ingroup imbuf
  */
 
+#include "BLI_math_base.h"
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
 #include "BLI_utildefines.h"
@@ -35,6 +36,10 @@
 
 #include "BLI_sys_types.h"  // for intptr_t support
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 static void imb_half_x_no_alloc(struct ImBuf *ibuf2, struct ImBuf *ibuf1)
 {
   uchar *p1, *_p1, *dest;
@@ -1760,6 +1765,43 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
 
 /* ******** threaded scaling ******** */
 
+#ifdef __SSE2__
+
+/* Helpers to run the per-pixel filter math on SSE vectors, one lane per channel. */
+
+BLI_INLINE __m128 pixel_load_byte_ps(const unsigned char *ptr)
+{
+  __m128i pixel_i = _mm_cvtsi32_si128(*(const int *)ptr);
+  pixel_i = _mm_unpacklo_epi8(pixel_i, _mm_setzero_si128());
+  pixel_i = _mm_unpacklo_epi16(pixel_i, _mm_setzero_si128());
+  return _mm_cvtepi32_ps(pixel_i);
+}
+
+BLI_INLINE void pixel_store_byte_ps(unsigned char *ptr, __m128 pixel)
+{
+  __m128i pixel_i = _mm_cvtps_epi32(pixel); /* Rounds to nearest. */
+  pixel_i = _mm_packs_epi32(pixel_i, pixel_i);
+  pixel_i = _mm_packus_epi16(pixel_i, pixel_i);
+  *(int *)ptr = _mm_cvtsi128_si32(pixel_i);
+}
+
+/**
+ * Weigh the four neighbouring pixels of a bilinear sample, matching the weighting of
+ * #BLI_bilinear_interpolation_fl. Only valid when all four neighbours lie inside the rect,
+ * the callers fall back to the generic BLI routines for border samples.
+ */
+BLI_INLINE __m128 bilinear_weigh_ps(
+    __m128 row1, __m128 row2, __m128 row3, __m128 row4, float a, float b)
+{
+  __m128 result = _mm_mul_ps(row1, _mm_set1_ps((1.0f - a) * (1.0f - b)));
+  result = _mm_add_ps(result, _mm_mul_ps(row3, _mm_set1_ps(a * (1.0f - b))));
+  result = _mm_add_ps(result, _mm_mul_ps(row2, _mm_set1_ps((1.0f - a) * b)));
+  result = _mm_add_ps(result, _mm_mul_ps(row4, _mm_set1_ps(a * b)));
+  return result;
+}
+
+#endif /* __SSE2__ */
+
 typedef struct ScaleTreadInitData {
   ImBuf *ibuf;
 
@@ -1816,17 +1858,164 @@ static void *do_scale_thread(void *data_v)
       float u = (float)x * factor_x;
       float v = (float)y * factor_y;
       int offset = y * data->newx + x;
+#ifdef __SSE2__
+      const int x1 = (int)u;
+      const int y1 = (int)v;
+      const bool interior = (x1 + 1 < ibuf->x && y1 + 1 < ibuf->y);
+#endif
 
       if (data->byte_buffer) {
         unsigned char *pixel = data->byte_buffer + 4 * offset;
-        BLI_bilinear_interpolation_char(
-            (unsigned char *)ibuf->rect, pixel, ibuf->x, ibuf->y, 4, u, v);
+#ifdef __SSE2__
+        if (interior) {
+          const unsigned char *row1 = (const unsigned char *)ibuf->rect +
+                                      ((size_t)y1 * ibuf->x + x1) * 4;
+          const unsigned char *row2 = row1 + (size_t)ibuf->x * 4;
+          pixel_store_byte_ps(pixel,
+                              bilinear_weigh_ps(pixel_load_byte_ps(row1),
+                                                pixel_load_byte_ps(row2),
+                                                pixel_load_byte_ps(row1 + 4),
+                                                pixel_load_byte_ps(row2 + 4),
+                                                u - (float)x1,
+                                                v - (float)y1));
+        }
+        else
+#endif
+        {
+          BLI_bilinear_interpolation_char(
+              (unsigned char *)ibuf->rect, pixel, ibuf->x, ibuf->y, 4, u, v);
+        }
       }
 
       if (data->float_buffer) {
         float *pixel = data->float_buffer + ibuf->channels * offset;
-        BLI_bilinear_interpolation_fl(
-            ibuf->rect_float, pixel, ibuf->x, ibuf->y, ibuf->channels, u, v);
+#ifdef __SSE2__
+        if (interior && ibuf->channels == 4) {
+          const float *row1 = ibuf->rect_float + ((size_t)y1 * ibuf->x + x1) * 4;
+          const float *row2 = row1 + (size_t)ibuf->x * 4;
+          _mm_storeu_ps(pixel,
+                        bilinear_weigh_ps(_mm_loadu_ps(row1),
+                                          _mm_loadu_ps(row2),
+                                          _mm_loadu_ps(row1 + 4),
+                                          _mm_loadu_ps(row2 + 4),
+                                          u - (float)x1,
+                                          v - (float)y1));
+        }
+        else
+#endif
+        {
+          BLI_bilinear_interpolation_fl(
+              ibuf->rect_float, pixel, ibuf->x, ibuf->y, ibuf->channels, u, v);
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * Area-weighted downsampling: every destination pixel averages the exact source rectangle it
+ * covers, with fractional weights on the border rows and columns. Unlike bilinear filtering,
+ * which only reads the four pixels around the sample position, this uses every source pixel
+ * once, so strong downscales (proxies, thumbnails) don't alias and don't need repeated
+ * half-scaling passes.
+ */
+static void *do_scale_area_thread(void *data_v)
+{
+  ScaleThreadData *data = (ScaleThreadData *)data_v;
+  ImBuf *ibuf = data->ibuf;
+  const float factor_x = (float)ibuf->x / data->newx;
+  const float factor_y = (float)ibuf->y / data->newy;
+  const float inv_area = 1.0f / (factor_x * factor_y);
+  int i;
+
+  for (i = 0; i < data->tot_line; i++) {
+    const int y = data->start_line + i;
+    const float sy0 = (float)y * factor_y;
+    const float sy1 = (float)(y + 1) * factor_y;
+    const int iy0 = (int)sy0;
+    const int iy1 = min_ii((int)ceilf(sy1), ibuf->y);
+    int x, sx, sy;
+
+    for (x = 0; x < data->newx; x++) {
+      const float sx0 = (float)x * factor_x;
+      const float sx1 = (float)(x + 1) * factor_x;
+      const int ix0 = (int)sx0;
+      const int ix1 = min_ii((int)ceilf(sx1), ibuf->x);
+      const int offset = y * data->newx + x;
+
+      if (data->byte_buffer) {
+        unsigned char *pixel = data->byte_buffer + 4 * offset;
+#ifdef __SSE2__
+        __m128 accum = _mm_setzero_ps();
+#else
+        float accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+#endif
+        for (sy = iy0; sy < iy1; sy++) {
+          const float weight_y = min_ff((float)(sy + 1), sy1) - max_ff((float)sy, sy0);
+          const unsigned char *row = (const unsigned char *)ibuf->rect +
+                                     ((size_t)sy * ibuf->x + ix0) * 4;
+          for (sx = ix0; sx < ix1; sx++, row += 4) {
+            const float weight = weight_y *
+                                 (min_ff((float)(sx + 1), sx1) - max_ff((float)sx, sx0));
+#ifdef __SSE2__
+            accum = _mm_add_ps(accum, _mm_mul_ps(pixel_load_byte_ps(row), _mm_set1_ps(weight)));
+#else
+            accum[0] += weight * row[0];
+            accum[1] += weight * row[1];
+            accum[2] += weight * row[2];
+            accum[3] += weight * row[3];
+#endif
+          }
+        }
+#ifdef __SSE2__
+        pixel_store_byte_ps(pixel, _mm_mul_ps(accum, _mm_set1_ps(inv_area)));
+#else
+        pixel[0] = (unsigned char)(accum[0] * inv_area + 0.5f);
+        pixel[1] = (unsigned char)(accum[1] * inv_area + 0.5f);
+        pixel[2] = (unsigned char)(accum[2] * inv_area + 0.5f);
+        pixel[3] = (unsigned char)(accum[3] * inv_area + 0.5f);
+#endif
+      }
+
+      if (data->float_buffer) {
+        const int channels = ibuf->channels;
+        float *pixel = data->float_buffer + channels * offset;
+#ifdef __SSE2__
+        if (channels == 4) {
+          __m128 accum = _mm_setzero_ps();
+          for (sy = iy0; sy < iy1; sy++) {
+            const float weight_y = min_ff((float)(sy + 1), sy1) - max_ff((float)sy, sy0);
+            const float *row = ibuf->rect_float + ((size_t)sy * ibuf->x + ix0) * 4;
+            for (sx = ix0; sx < ix1; sx++, row += 4) {
+              const float weight = weight_y *
+                                   (min_ff((float)(sx + 1), sx1) - max_ff((float)sx, sx0));
+              accum = _mm_add_ps(accum, _mm_mul_ps(_mm_loadu_ps(row), _mm_set1_ps(weight)));
+            }
+          }
+          _mm_storeu_ps(pixel, _mm_mul_ps(accum, _mm_set1_ps(inv_area)));
+        }
+        else
+#endif
+        {
+          float accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+          int c;
+          for (sy = iy0; sy < iy1; sy++) {
+            const float weight_y = min_ff((float)(sy + 1), sy1) - max_ff((float)sy, sy0);
+            const float *row = ibuf->rect_float + ((size_t)sy * ibuf->x + ix0) * channels;
+            for (sx = ix0; sx < ix1; sx++, row += channels) {
+              const float weight = weight_y *
+                                   (min_ff((float)(sx + 1), sx1) - max_ff((float)sx, sx0));
+              for (c = 0; c < channels; c++) {
+                accum[c] += weight * row[c];
+              }
+            }
+          }
+          for (c = 0; c < channels; c++) {
+            pixel[c] = accum[c] * inv_area;
+          }
+        }
       }
     }
   }
@@ -1854,9 +2043,15 @@ void IMB_scaleImBuf_threaded(ImBuf *ibuf, unsigned int newx, unsigned int newy)
                                          "threaded scale float buffer");
   }
 
-  /* actual scaling threads */
-  IMB_processor_apply_threaded(
-      newy, sizeof(ScaleThreadData), &init_data, scale_thread_init, do_scale_thread);
+  /* actual scaling threads, area-weighted when downsampling in both dimensions */
+  if (newx <= ibuf->x && newy <= ibuf->y) {
+    IMB_processor_apply_threaded(
+        newy, sizeof(ScaleThreadData), &init_data, scale_thread_init, do_scale_area_thread);
+  }
+  else {
+    IMB_processor_apply_threaded(
+        newy, sizeof(ScaleThreadData), &init_data, scale_thread_init, do_scale_thread);
+  }
 
   /* alter image buffer */
   ibuf->x = newx;
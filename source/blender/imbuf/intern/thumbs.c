@@ -82,10 +82,11 @@
 
 #define URI_MAX (FILE_MAX * 3 + 8)
 
-static bool get_thumb_dir(char *dir, ThumbSize size)
+/* Fill \a dir with the platform cache base directory,
+ * returns the position past the written prefix, or NULL on failure. */
+static char *get_thumb_cache_base(char *dir)
 {
   char *s = dir;
-  const char *subdir;
 #ifdef WIN32
   wchar_t dir_16[MAX_PATH];
   /* yes, applications shouldn't store data there, but so does GIMP :)*/
@@ -100,7 +101,7 @@ static bool get_thumb_dir(char *dir, ThumbSize size)
   const char *home = BLI_getenv("HOME");
 #  endif
   if (!home) {
-    return 0;
+    return NULL;
   }
   s += BLI_strncpy_rlen(s, home, FILE_MAX);
 
@@ -110,6 +111,17 @@ static bool get_thumb_dir(char *dir, ThumbSize size)
   }
 #  endif
 #endif
+  return s;
+}
+
+static bool get_thumb_dir(char *dir, ThumbSize size)
+{
+  char *s = get_thumb_cache_base(dir);
+  const char *subdir;
+
+  if (s == NULL) {
+    return 0;
+  }
   switch (size) {
     case THB_NORMAL:
       subdir = "/" THUMBNAILS "/normal/";
@@ -130,6 +142,19 @@ static bool get_thumb_dir(char *dir, ThumbSize size)
   return 1;
 }
 
+/* Directory for the packed per-directory thumbnail databases (.tdb),
+ * kept next to the freedesktop thumbnail directories (blender specific). */
+static bool get_thumb_db_dir(char *dir)
+{
+  char *s = get_thumb_cache_base(dir);
+
+  if (s == NULL) {
+    return false;
+  }
+  BLI_strncpy(s, "/" THUMBNAILS "/blender_packed/", FILE_MAX - (s - dir));
+  return true;
+}
+
 #undef THUMBNAILS
 
 /* --- Begin of adapted code from glib. --- */
@@ -302,6 +327,34 @@ static bool thumbpath_from_uri(const char *uri, char *path, const int path_len,
   return thumbpathname_from_uri(uri, path, path_len, NULL, 0, size);
 }
 
+/* Path of the packed thumbnail database for \a dir_path, see thumbs_db.c. */
+bool IMB_thumb_db_path_from_dir(const char *dir_path, char *r_path, const size_t path_len)
+{
+  char dir_norm[FILE_MAX];
+  char uri[URI_MAX];
+  char name[40];
+  char hexdigest[33];
+  unsigned char digest[16];
+  char tmppath[FILE_MAX];
+
+  /* Strip the trailing slash so the same directory always hashes the same. */
+  BLI_strncpy(dir_norm, dir_path, sizeof(dir_norm));
+  BLI_path_slash_rstrip(dir_norm);
+
+  if (!uri_from_filename(dir_norm, uri)) {
+    return false;
+  }
+  BLI_hash_md5_buffer(uri, strlen(uri), digest);
+  hexdigest[0] = '\0';
+  BLI_snprintf(name, sizeof(name), "%s.tdb", BLI_hash_md5_to_hexdigest(digest, hexdigest));
+
+  if (!get_thumb_db_dir(tmppath)) {
+    return false;
+  }
+  BLI_snprintf(r_path, path_len, "%s%s", tmppath, name);
+  return true;
+}
+
 void IMB_thumb_makedirs(void)
 {
   char tpath[FILE_MAX];
@@ -316,6 +369,9 @@ void IMB_thumb_makedirs(void)
   if (get_thumb_dir(tpath, THB_FAIL)) {
     BLI_dir_create_recursive(tpath);
   }
+  if (get_thumb_db_dir(tpath)) {
+    BLI_dir_create_recursive(tpath);
+  }
 }
 
 /* create thumbnail for file and returns new imbuf for thumbnail */
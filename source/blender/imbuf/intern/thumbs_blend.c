@@ -21,8 +21,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "BLI_fileops.h"
+#include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h" /* Needed due to import of BLO_readfile.h */
+#include "BLI_string.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BLO_blend_defs.h"
@@ -40,6 +44,136 @@
 
 #include "MEM_guardedalloc.h"
 
+/* -------------------------------------------------------------------- */
+/** \name In-Process Thumbnail Cache
+ *
+ * The file browser re-requests blend-file thumbnails a lot (refreshes, sorting, going back and
+ * forth between directories). Keep a small LRU of decoded thumbnails keyed by (path, mtime), so
+ * unchanged files are not read from storage again. Stale entries are detected via mtime.
+ * \{ */
+
+#define THUMB_BLEND_CACHE_MAX 256
+
+typedef struct ThumbBlendCacheEntry {
+  struct ThumbBlendCacheEntry *next, *prev;
+  char path[1024]; /* FILE_MAX */
+  int64_t mtime;
+  /** May be NULL for files that have no thumbnail (cached too, to avoid re-reading). */
+  ImBuf *ibuf;
+} ThumbBlendCacheEntry;
+
+static struct {
+  /** #ThumbBlendCacheEntry, most recently used first. */
+  ListBase entries;
+  /** Path -> entry, pointing into \a entries. */
+  GHash *path_map;
+  int entries_len;
+  ThreadMutex mutex;
+} thumb_blend_cache = {.mutex = BLI_MUTEX_INITIALIZER};
+
+static int64_t thumb_blend_file_mtime(const char *path)
+{
+  BLI_stat_t status;
+  if (BLI_stat(path, &status) == -1) {
+    return -1;
+  }
+  return (int64_t)status.st_mtime;
+}
+
+static bool thumb_blend_cache_lookup(const char *path, const int64_t mtime, ImBuf **r_ibuf)
+{
+  bool found = false;
+
+  BLI_mutex_lock(&thumb_blend_cache.mutex);
+  if (thumb_blend_cache.path_map != NULL) {
+    ThumbBlendCacheEntry *entry = BLI_ghash_lookup(thumb_blend_cache.path_map, path);
+    if (entry != NULL) {
+      if (entry->mtime == mtime) {
+        /* Move to the front of the LRU. */
+        BLI_remlink(&thumb_blend_cache.entries, entry);
+        BLI_addhead(&thumb_blend_cache.entries, entry);
+        *r_ibuf = entry->ibuf ? IMB_dupImBuf(entry->ibuf) : NULL;
+        found = true;
+      }
+      else {
+        /* File changed on disk, drop the stale entry. */
+        BLI_ghash_remove(thumb_blend_cache.path_map, entry->path, NULL, NULL);
+        BLI_remlink(&thumb_blend_cache.entries, entry);
+        if (entry->ibuf) {
+          IMB_freeImBuf(entry->ibuf);
+        }
+        MEM_freeN(entry);
+        thumb_blend_cache.entries_len--;
+      }
+    }
+  }
+  BLI_mutex_unlock(&thumb_blend_cache.mutex);
+
+  return found;
+}
+
+static void thumb_blend_cache_insert(const char *path, const int64_t mtime, ImBuf *ibuf)
+{
+  ThumbBlendCacheEntry *entry = MEM_callocN(sizeof(*entry), __func__);
+  BLI_strncpy(entry->path, path, sizeof(entry->path));
+  entry->mtime = mtime;
+  entry->ibuf = ibuf ? IMB_dupImBuf(ibuf) : NULL;
+
+  BLI_mutex_lock(&thumb_blend_cache.mutex);
+  if (thumb_blend_cache.path_map == NULL) {
+    thumb_blend_cache.path_map = BLI_ghash_str_new(__func__);
+  }
+
+  /* Callers check the cache first, but another thread may have inserted meanwhile. */
+  ThumbBlendCacheEntry *entry_existing = BLI_ghash_lookup(thumb_blend_cache.path_map, path);
+  if (entry_existing != NULL) {
+    BLI_ghash_remove(thumb_blend_cache.path_map, entry_existing->path, NULL, NULL);
+    BLI_remlink(&thumb_blend_cache.entries, entry_existing);
+    if (entry_existing->ibuf) {
+      IMB_freeImBuf(entry_existing->ibuf);
+    }
+    MEM_freeN(entry_existing);
+    thumb_blend_cache.entries_len--;
+  }
+
+  BLI_addhead(&thumb_blend_cache.entries, entry);
+  BLI_ghash_insert(thumb_blend_cache.path_map, entry->path, entry);
+  thumb_blend_cache.entries_len++;
+
+  /* Evict least recently used entries. */
+  while (thumb_blend_cache.entries_len > THUMB_BLEND_CACHE_MAX) {
+    ThumbBlendCacheEntry *entry_last = thumb_blend_cache.entries.last;
+    BLI_ghash_remove(thumb_blend_cache.path_map, entry_last->path, NULL, NULL);
+    BLI_remlink(&thumb_blend_cache.entries, entry_last);
+    if (entry_last->ibuf) {
+      IMB_freeImBuf(entry_last->ibuf);
+    }
+    MEM_freeN(entry_last);
+    thumb_blend_cache.entries_len--;
+  }
+  BLI_mutex_unlock(&thumb_blend_cache.mutex);
+}
+
+void IMB_thumb_blend_cache_free(void)
+{
+  BLI_mutex_lock(&thumb_blend_cache.mutex);
+  LISTBASE_FOREACH_MUTABLE (ThumbBlendCacheEntry *, entry, &thumb_blend_cache.entries) {
+    if (entry->ibuf) {
+      IMB_freeImBuf(entry->ibuf);
+    }
+    MEM_freeN(entry);
+  }
+  BLI_listbase_clear(&thumb_blend_cache.entries);
+  thumb_blend_cache.entries_len = 0;
+  if (thumb_blend_cache.path_map != NULL) {
+    BLI_ghash_free(thumb_blend_cache.path_map, NULL, NULL);
+    thumb_blend_cache.path_map = NULL;
+  }
+  BLI_mutex_unlock(&thumb_blend_cache.mutex);
+}
+
+/** \} */
+
 ImBuf *IMB_thumb_load_blend(const char *blen_path, const char *blen_group, const char *blen_id)
 {
   ImBuf *ima = NULL;
@@ -97,6 +231,11 @@ ImBuf *IMB_thumb_load_blend(const char *blen_path, const char *blen_group, const
   }
   else {
     BlendThumbnail *data;
+    const int64_t mtime = thumb_blend_file_mtime(blen_path);
+
+    if (mtime != -1 && thumb_blend_cache_lookup(blen_path, mtime, &ima)) {
+      return ima;
+    }
 
     data = BLO_thumbnail_from_file(blen_path);
     ima = BKE_main_thumbnail_to_imbuf(NULL, data);
@@ -104,6 +243,10 @@ ImBuf *IMB_thumb_load_blend(const char *blen_path, const char *blen_group, const
     if (data) {
       MEM_freeN(data);
     }
+
+    if (mtime != -1) {
+      thumb_blend_cache_insert(blen_path, mtime, ima);
+    }
   }
 
   return ima;
@@ -0,0 +1,328 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup imbuf
+ *
+ * Packed per-directory thumbnail database.
+ *
+ * The freedesktop thumbnail cache stores one PNG per file, so filling the
+ * previews of a large directory costs one stat + open + decode per entry.
+ * This database packs the decoded thumbnails of a whole directory into a
+ * single file (an index header followed by raw RGBA rects), so revisiting
+ * a directory takes one read and a memcpy per entry.
+ *
+ * Entries are validated against the source file's size and modification
+ * time, stale ones are dropped when the database is rewritten. The file is
+ * located in the thumbnail cache directory, named after the MD5 of the
+ * directory URI (see #IMB_thumb_db_path_from_dir).
+ *
+ * Lookups are thread-safe once the database is read (the data is immutable),
+ * additions lock internally so the preview job threads can record new
+ * thumbnails concurrently.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_ghash.h"
+#include "BLI_listbase.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_sys_types.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+#include "IMB_imbuf.h"
+#include "IMB_imbuf_types.h"
+#include "IMB_thumbs.h"
+
+#define THUMB_DB_MAGIC "BThumbDB"
+#define THUMB_DB_VERSION 1
+
+/* Don't pack thumbnails above this size, they don't come from our own
+ * thumbnail code and would bloat the database. */
+#define THUMB_DB_IMAGE_SIZE_MAX 1024
+
+/* On-disk layout: ThumbDBHeader, ThumbDBIndexEntry[entries_len],
+ * then the name and pixel payloads the index offsets point into. */
+
+typedef struct ThumbDBHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t entries_len;
+} ThumbDBHeader;
+
+typedef struct ThumbDBIndexEntry {
+  /** Offset of the nul-terminated file path, relative to the file start. */
+  uint64_t name_offset;
+  uint32_t name_size;
+  uint32_t x, y;
+  /** Offset of the `x * y` RGBA pixels, relative to the file start. */
+  uint64_t data_offset;
+  /** Source file stat info used for validation. */
+  int64_t mtime;
+  int64_t size;
+} ThumbDBIndexEntry;
+
+/** A thumbnail recorded since the database was read, not yet on disk. */
+typedef struct ThumbDBPendingEntry {
+  struct ThumbDBPendingEntry *next, *prev;
+  char *file_path;
+  int64_t mtime;
+  int64_t size;
+  ImBuf *img;
+} ThumbDBPendingEntry;
+
+struct IMB_ThumbDB {
+  char dir_path[FILE_MAX];
+
+  /** Whole database file, NULL when there was none. Index entries and the
+   * hash values point into this buffer, it is immutable once read. */
+  void *data;
+  size_t data_len;
+
+  /** File path -> #ThumbDBIndexEntry, for entries read from disk. */
+  GHash *index;
+
+  /** #ThumbDBPendingEntry, additions since reading. */
+  ListBase pending;
+  ThreadMutex pending_mutex;
+};
+
+BLI_INLINE const char *thumb_db_entry_name(const IMB_ThumbDB *db, const ThumbDBIndexEntry *entry)
+{
+  return (const char *)db->data + entry->name_offset;
+}
+
+static bool thumb_db_entry_valid(const IMB_ThumbDB *db, const ThumbDBIndexEntry *entry)
+{
+  const uint64_t data_size = (uint64_t)entry->x * entry->y * sizeof(uint);
+
+  if (entry->name_size == 0 || entry->x == 0 || entry->y == 0 ||
+      entry->x > THUMB_DB_IMAGE_SIZE_MAX || entry->y > THUMB_DB_IMAGE_SIZE_MAX) {
+    return false;
+  }
+  if (entry->name_offset > db->data_len || entry->name_size > db->data_len - entry->name_offset) {
+    return false;
+  }
+  if (entry->data_offset > db->data_len || data_size > db->data_len - entry->data_offset) {
+    return false;
+  }
+  /* The name must be nul terminated where the index says it ends. */
+  if (thumb_db_entry_name(db, entry)[entry->name_size - 1] != '\0') {
+    return false;
+  }
+  return true;
+}
+
+IMB_ThumbDB *IMB_thumb_db_read(const char *dir_path)
+{
+  char db_path[FILE_MAX];
+
+  if (!IMB_thumb_db_path_from_dir(dir_path, db_path, sizeof(db_path))) {
+    return NULL;
+  }
+
+  IMB_ThumbDB *db = MEM_callocN(sizeof(*db), __func__);
+  BLI_strncpy(db->dir_path, dir_path, sizeof(db->dir_path));
+  db->index = BLI_ghash_str_new(__func__);
+  BLI_mutex_init(&db->pending_mutex);
+
+  /* A single read of the whole file, this is the point of the database. */
+  db->data = BLI_file_read_binary_as_mem(db_path, 0, &db->data_len);
+  if (db->data == NULL) {
+    /* No database yet, start empty and collect entries to write. */
+    return db;
+  }
+
+  const ThumbDBHeader *header = db->data;
+  if (db->data_len < sizeof(ThumbDBHeader) ||
+      !STREQLEN(header->magic, THUMB_DB_MAGIC, sizeof(header->magic)) ||
+      header->version != THUMB_DB_VERSION ||
+      (uint64_t)header->entries_len >
+          (db->data_len - sizeof(ThumbDBHeader)) / sizeof(ThumbDBIndexEntry)) {
+    /* Unknown or corrupted file, it will be overwritten on the next flush. */
+    MEM_freeN(db->data);
+    db->data = NULL;
+    db->data_len = 0;
+    return db;
+  }
+
+  const ThumbDBIndexEntry *index = (const ThumbDBIndexEntry *)(header + 1);
+  for (uint32_t i = 0; i < header->entries_len; i++) {
+    const ThumbDBIndexEntry *entry = &index[i];
+    if (thumb_db_entry_valid(db, entry)) {
+      BLI_ghash_reinsert(db->index, (void *)thumb_db_entry_name(db, entry), (void *)entry, NULL, NULL);
+    }
+  }
+
+  return db;
+}
+
+ImBuf *IMB_thumb_db_lookup(IMB_ThumbDB *db,
+                           const char *file_path,
+                           const int64_t mtime,
+                           const int64_t size)
+{
+  const ThumbDBIndexEntry *entry = BLI_ghash_lookup(db->index, file_path);
+
+  if (entry == NULL || entry->mtime != mtime || entry->size != size) {
+    return NULL;
+  }
+
+  return IMB_allocFromBuffer(
+      (const uint *)((const char *)db->data + entry->data_offset), NULL, entry->x, entry->y, 4);
+}
+
+void IMB_thumb_db_add(
+    IMB_ThumbDB *db, const char *file_path, const int64_t mtime, const int64_t size, ImBuf *img)
+{
+  if (img->rect == NULL || img->x > THUMB_DB_IMAGE_SIZE_MAX || img->y > THUMB_DB_IMAGE_SIZE_MAX) {
+    return;
+  }
+
+  ThumbDBPendingEntry *pending = MEM_callocN(sizeof(*pending), __func__);
+  pending->file_path = BLI_strdup(file_path);
+  pending->mtime = mtime;
+  pending->size = size;
+  pending->img = img;
+  IMB_refImBuf(img);
+
+  BLI_mutex_lock(&db->pending_mutex);
+  BLI_addtail(&db->pending, pending);
+  BLI_mutex_unlock(&db->pending_mutex);
+}
+
+static void thumb_db_pending_free(ThumbDBPendingEntry *pending)
+{
+  IMB_freeImBuf(pending->img);
+  MEM_freeN(pending->file_path);
+  MEM_freeN(pending);
+}
+
+/**
+ * Write the database back to disk when new thumbnails were recorded,
+ * merging them with the still valid entries read from disk.
+ *
+ * Not thread-safe, call after the preview threads are done.
+ */
+bool IMB_thumb_db_write(IMB_ThumbDB *db)
+{
+  char db_path[FILE_MAX];
+
+  if (BLI_listbase_is_empty(&db->pending)) {
+    return false;
+  }
+  if (!IMB_thumb_db_path_from_dir(db->dir_path, db_path, sizeof(db_path))) {
+    return false;
+  }
+
+  /* Pending entries supersede on-disk ones with the same path. */
+  LISTBASE_FOREACH (ThumbDBPendingEntry *, pending, &db->pending) {
+    BLI_ghash_remove(db->index, pending->file_path, NULL, NULL);
+  }
+
+  const uint32_t entries_len = (uint32_t)(BLI_ghash_len(db->index) +
+                                          BLI_listbase_count(&db->pending));
+  ThumbDBHeader header = {{0}};
+  memcpy(header.magic, THUMB_DB_MAGIC, sizeof(header.magic));
+  header.version = THUMB_DB_VERSION;
+  header.entries_len = entries_len;
+
+  ThumbDBIndexEntry *index = MEM_callocN(sizeof(*index) * entries_len, __func__);
+
+  /* Lay out the payload: names first, then pixel data. */
+  uint64_t offset = sizeof(ThumbDBHeader) + sizeof(ThumbDBIndexEntry) * (uint64_t)entries_len;
+  uint32_t i = 0;
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, db->index) {
+    const ThumbDBIndexEntry *src = BLI_ghashIterator_getValue(&gh_iter);
+    index[i] = *src;
+    index[i].name_offset = offset;
+    offset += src->name_size;
+    i++;
+  }
+  LISTBASE_FOREACH (ThumbDBPendingEntry *, pending, &db->pending) {
+    index[i].name_size = (uint32_t)strlen(pending->file_path) + 1;
+    index[i].name_offset = offset;
+    index[i].x = (uint32_t)pending->img->x;
+    index[i].y = (uint32_t)pending->img->y;
+    index[i].mtime = pending->mtime;
+    index[i].size = pending->size;
+    offset += index[i].name_size;
+    i++;
+  }
+  for (i = 0; i < entries_len; i++) {
+    index[i].data_offset = offset;
+    offset += (uint64_t)index[i].x * index[i].y * sizeof(uint);
+  }
+
+  BLI_make_existing_file(db_path);
+  FILE *file = BLI_fopen(db_path, "wb");
+  if (file == NULL) {
+    MEM_freeN(index);
+    return false;
+  }
+
+  bool ok = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+            (fwrite(index, sizeof(*index), entries_len, file) == entries_len);
+
+  /* Names, in index order. */
+  GHASH_ITER (gh_iter, db->index) {
+    const ThumbDBIndexEntry *src = BLI_ghashIterator_getValue(&gh_iter);
+    ok = ok && (fwrite(thumb_db_entry_name(db, src), src->name_size, 1, file) == 1);
+  }
+  LISTBASE_FOREACH (ThumbDBPendingEntry *, pending, &db->pending) {
+    ok = ok && (fwrite(pending->file_path, strlen(pending->file_path) + 1, 1, file) == 1);
+  }
+
+  /* Pixel data, in index order. */
+  GHASH_ITER (gh_iter, db->index) {
+    const ThumbDBIndexEntry *src = BLI_ghashIterator_getValue(&gh_iter);
+    const size_t data_size = (size_t)src->x * src->y * sizeof(uint);
+    ok = ok && (fwrite((const char *)db->data + src->data_offset, data_size, 1, file) == 1);
+  }
+  LISTBASE_FOREACH (ThumbDBPendingEntry *, pending, &db->pending) {
+    const size_t data_size = (size_t)pending->img->x * pending->img->y * sizeof(uint);
+    ok = ok && (fwrite(pending->img->rect, data_size, 1, file) == 1);
+  }
+
+  fclose(file);
+  if (!ok) {
+    /* Don't leave a truncated database behind. */
+    BLI_delete(db_path, false, false);
+  }
+
+  MEM_freeN(index);
+  return ok;
+}
+
+void IMB_thumb_db_free(IMB_ThumbDB *db)
+{
+  LISTBASE_FOREACH_MUTABLE (ThumbDBPendingEntry *, pending, &db->pending) {
+    thumb_db_pending_free(pending);
+  }
+  BLI_ghash_free(db->index, NULL, NULL);
+  if (db->data) {
+    MEM_freeN(db->data);
+  }
+  BLI_mutex_end(&db->pending_mutex);
+  MEM_freeN(db);
+}
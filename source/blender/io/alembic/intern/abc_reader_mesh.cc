@@ -33,6 +33,7 @@
 #include "DNA_object_types.h"
 
 #include "BLI_math_geom.h"
+#include "BLI_task.h"
 
 #include "BKE_main.h"
 #include "BKE_material.h"
@@ -129,22 +130,48 @@ struct AbcMeshData {
   UInt32ArraySamplePtr uvs_indices;
 };
 
+/* The conversion loops below iterate over millions of elements for production
+ * caches, so they are spread over all cores with the task scheduler. Small
+ * meshes stay single threaded through `min_iter_per_thread`. */
+
+struct ReadMVertsInterpData {
+  MVert *mverts;
+  const Imath::V3f *floor_positions;
+  const Imath::V3f *ceil_positions;
+  float weight;
+};
+
+static void read_mverts_interp_fn(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReadMVertsInterpData *data = static_cast<ReadMVertsInterpData *>(userdata);
+  MVert &mvert = data->mverts[i];
+  float tmp[3];
+
+  interp_v3_v3v3(
+      tmp, data->floor_positions[i].getValue(), data->ceil_positions[i].getValue(), data->weight);
+  copy_zup_from_yup(mvert.co, tmp);
+
+  mvert.bweight = 0;
+}
+
 static void read_mverts_interp(MVert *mverts,
                                const P3fArraySamplePtr &positions,
                                const P3fArraySamplePtr &ceil_positions,
                                const float weight)
 {
-  float tmp[3];
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    const Imath::V3f &floor_pos = (*positions)[i];
-    const Imath::V3f &ceil_pos = (*ceil_positions)[i];
-
-    interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), weight);
-    copy_zup_from_yup(mvert.co, tmp);
-
-    mvert.bweight = 0;
-  }
+  ReadMVertsInterpData data;
+  data.mverts = mverts;
+  data.floor_positions = positions->get();
+  data.ceil_positions = ceil_positions->get();
+  data.weight = weight;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8192;
+  BLI_task_parallel_range(
+      0, static_cast<int>(positions->size()), &data, read_mverts_interp_fn, &settings);
 }
 
 static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -161,27 +188,110 @@ static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
   read_mverts(mverts, positions, nullptr);
 }
 
+struct ReadMVertsData {
+  MVert *mverts;
+  const Imath::V3f *positions;
+  const Imath::V3f *normals;
+};
+
+static void read_mverts_fn(void *__restrict userdata,
+                           const int i,
+                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReadMVertsData *data = static_cast<ReadMVertsData *>(userdata);
+  MVert &mvert = data->mverts[i];
+
+  copy_zup_from_yup(mvert.co, data->positions[i].getValue());
+
+  mvert.bweight = 0;
+
+  if (data->normals) {
+    short no[3];
+    normal_float_to_short_v3(no, data->normals[i].getValue());
+
+    copy_zup_from_yup(mvert.no, no);
+  }
+}
+
 void read_mverts(MVert *mverts, const P3fArraySamplePtr positions, const N3fArraySamplePtr normals)
 {
-  for (int i = 0; i < positions->size(); i++) {
-    MVert &mvert = mverts[i];
-    Imath::V3f pos_in = (*positions)[i];
+  ReadMVertsData data;
+  data.mverts = mverts;
+  data.positions = positions->get();
+  data.normals = normals ? normals->get() : nullptr;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8192;
+  BLI_task_parallel_range(
+      0, static_cast<int>(positions->size()), &data, read_mverts_fn, &settings);
+}
+
+struct ReadMPolysData {
+  MPoly *mpolys;
+  MLoop *mloops;
+  MLoopUV *mloopuvs;
+  const int32_t *face_indices;
+  const uint32_t *uvs_indices;
+  const Imath::V2f *uvs;
+  size_t uvs_size;
+  bool do_uvs;
+};
+
+struct ReadMPolysTLSData {
+  bool seen_invalid_geometry;
+};
+
+static void read_mpolys_fn(void *__restrict userdata,
+                           const int i,
+                           const TaskParallelTLS *__restrict tls)
+{
+  ReadMPolysData *data = static_cast<ReadMPolysData *>(userdata);
+  ReadMPolysTLSData *tls_data = static_cast<ReadMPolysTLSData *>(tls->userdata_chunk);
+
+  const MPoly &poly = data->mpolys[i];
+  unsigned int loop_index = (unsigned int)poly.loopstart;
 
-    copy_zup_from_yup(mvert.co, pos_in.getValue());
+  /* NOTE: Alembic data is stored in the reverse order. */
+  unsigned int rev_loop_index = loop_index + (unsigned int)(poly.totloop - 1);
 
-    mvert.bweight = 0;
+  uint last_vertex_index = 0;
+  for (int f = 0; f < poly.totloop; f++, loop_index++, rev_loop_index--) {
+    MLoop &loop = data->mloops[rev_loop_index];
+    loop.v = (uint)data->face_indices[loop_index];
 
-    if (normals) {
-      Imath::V3f nor_in = (*normals)[i];
+    if (f > 0 && loop.v == last_vertex_index) {
+      /* This face is invalid, as it has consecutive loops from the same vertex. This is caused
+       * by invalid geometry in the Alembic file, such as in T76514. */
+      tls_data->seen_invalid_geometry = true;
+    }
+    last_vertex_index = loop.v;
+
+    if (data->do_uvs) {
+      MLoopUV &loopuv = data->mloopuvs[rev_loop_index];
 
-      short no[3];
-      normal_float_to_short_v3(no, nor_in.getValue());
+      const unsigned int uv_index = data->uvs_indices[loop_index];
+
+      /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
+      if (uv_index >= data->uvs_size) {
+        continue;
+      }
 
-      copy_zup_from_yup(mvert.no, no);
+      loopuv.uv[0] = data->uvs[uv_index][0];
+      loopuv.uv[1] = data->uvs[uv_index][1];
     }
   }
 }
 
+static void read_mpolys_reduce(const void *__restrict UNUSED(userdata),
+                               void *__restrict chunk_join,
+                               void *__restrict chunk)
+{
+  ReadMPolysTLSData *join = static_cast<ReadMPolysTLSData *>(chunk_join);
+  ReadMPolysTLSData *tls_data = static_cast<ReadMPolysTLSData *>(chunk);
+  join->seen_invalid_geometry |= tls_data->seen_invalid_geometry;
+}
+
 static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
 {
   MPoly *mpolys = config.mpoly;
@@ -197,55 +307,48 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
 
   const bool do_uvs = (mloopuvs && uvs && uvs_indices) &&
                       (uvs_indices->size() == face_indices->size());
-  unsigned int loop_index = 0;
-  unsigned int rev_loop_index = 0;
-  unsigned int uv_index = 0;
-  bool seen_invalid_geometry = false;
 
+  /* Compute the loop offsets serially, filling the loops of a polygon below
+   * depends on the offsets of all polygons before it. */
+  unsigned int loop_index = 0;
   for (int i = 0; i < face_counts->size(); i++) {
     const int face_size = (*face_counts)[i];
 
     MPoly &poly = mpolys[i];
-    poly.loopstart = loop_index;
+    poly.loopstart = (int)loop_index;
     poly.totloop = face_size;
 
     /* Polygons are always assumed to be smooth-shaded. If the Alembic mesh should be flat-shaded,
      * this is encoded in custom loop normals. See T71246. */
     poly.flag |= ME_SMOOTH;
 
-    /* NOTE: Alembic data is stored in the reverse order. */
-    rev_loop_index = loop_index + (face_size - 1);
-
-    uint last_vertex_index = 0;
-    for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
-      MLoop &loop = mloops[rev_loop_index];
-      loop.v = (*face_indices)[loop_index];
-
-      if (f > 0 && loop.v == last_vertex_index) {
-        /* This face is invalid, as it has consecutive loops from the same vertex. This is caused
-         * by invalid geometry in the Alembic file, such as in T76514. */
-        seen_invalid_geometry = true;
-      }
-      last_vertex_index = loop.v;
-
-      if (do_uvs) {
-        MLoopUV &loopuv = mloopuvs[rev_loop_index];
-
-        uv_index = (*uvs_indices)[loop_index];
-
-        /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
-        if (uv_index >= uvs_size) {
-          continue;
-        }
-
-        loopuv.uv[0] = (*uvs)[uv_index][0];
-        loopuv.uv[1] = (*uvs)[uv_index][1];
-      }
-    }
+    loop_index += (unsigned int)face_size;
   }
 
+  ReadMPolysData data;
+  data.mpolys = mpolys;
+  data.mloops = mloops;
+  data.mloopuvs = mloopuvs;
+  data.face_indices = face_indices->get();
+  data.uvs_indices = do_uvs ? uvs_indices->get() : nullptr;
+  data.uvs = do_uvs ? uvs->get() : nullptr;
+  data.uvs_size = uvs_size;
+  data.do_uvs = do_uvs;
+
+  ReadMPolysTLSData tls_data;
+  tls_data.seen_invalid_geometry = false;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 2048;
+  settings.userdata_chunk = &tls_data;
+  settings.userdata_chunk_size = sizeof(tls_data);
+  settings.func_reduce = read_mpolys_reduce;
+  BLI_task_parallel_range(
+      0, static_cast<int>(face_counts->size()), &data, read_mpolys_fn, &settings);
+
   BKE_mesh_calc_edges(config.mesh, false, false);
-  if (seen_invalid_geometry) {
+  if (tls_data.seen_invalid_geometry) {
     if (config.modifier_error_message) {
       *config.modifier_error_message = "Mesh hash invalid geometry; more details on the console";
     }
@@ -259,6 +362,30 @@ static void process_no_normals(CDStreamConfig &config)
   BKE_mesh_calc_normals(config.mesh);
 }
 
+struct ProcessLoopNormalsData {
+  float(*lnors)[3];
+  const MPoly *mpolys;
+  const Imath::V3f *loop_normals;
+};
+
+static void process_loop_normals_fn(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ProcessLoopNormalsData *data = static_cast<ProcessLoopNormalsData *>(userdata);
+  const MPoly &poly = data->mpolys[i];
+
+  /* Polygons and their loops are converted in file order, so the Alembic loop
+   * offset of a polygon matches its `loopstart`. */
+  int abc_index = poly.loopstart;
+
+  /* As usual, ABC orders the loops in reverse. */
+  for (int j = poly.totloop - 1; j >= 0; j--, abc_index++) {
+    int blender_index = poly.loopstart + j;
+    copy_zup_from_yup(data->lnors[blender_index], data->loop_normals[abc_index].getValue());
+  }
+}
+
 static void process_loop_normals(CDStreamConfig &config, const N3fArraySamplePtr loop_normals_ptr)
 {
   size_t loop_count = loop_normals_ptr->size();
@@ -272,16 +399,16 @@ static void process_loop_normals(CDStreamConfig &config, const N3fArraySamplePtr
       MEM_malloc_arrayN(loop_count, sizeof(float[3]), "ABC::FaceNormals"));
 
   Mesh *mesh = config.mesh;
-  MPoly *mpoly = mesh->mpoly;
-  const N3fArraySample &loop_normals = *loop_normals_ptr;
-  int abc_index = 0;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mpoly++) {
-    /* As usual, ABC orders the loops in reverse. */
-    for (int j = mpoly->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mpoly->loopstart + j;
-      copy_zup_from_yup(lnors[blender_index], loop_normals[abc_index].getValue());
-    }
-  }
+
+  ProcessLoopNormalsData data;
+  data.lnors = lnors;
+  data.mpolys = mesh->mpoly;
+  data.loop_normals = loop_normals_ptr->get();
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 2048;
+  BLI_task_parallel_range(0, mesh->totpoly, &data, process_loop_normals_fn, &settings);
 
   mesh->flag |= ME_AUTOSMOOTH;
   BKE_mesh_set_custom_normals(mesh, lnors);
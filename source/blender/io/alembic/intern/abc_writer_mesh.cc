@@ -27,6 +27,8 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_object_fluidsim_types.h"
 
+#include "BLI_task.h"
+
 #include "BKE_anim_data.h"
 #include "BKE_key.h"
 #include "BKE_lib_id.h"
@@ -60,15 +62,60 @@ using Alembic::AbcGeom::UInt32ArraySample;
 
 /* NOTE: Alembic's polygon winding order is clockwise, to match with Renderman. */
 
+/* The conversion loops below iterate over millions of elements for production
+ * meshes, so they are spread over all cores with the task scheduler. Small
+ * meshes stay single threaded through `min_iter_per_thread`. */
+
+struct GetVerticesData {
+  Imath::V3f *points;
+  const MVert *verts;
+};
+
+static void get_vertices_fn(void *__restrict userdata,
+                            const int i,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GetVerticesData *data = static_cast<GetVerticesData *>(userdata);
+  copy_yup_from_zup(data->points[i].getValue(), data->verts[i].co);
+}
+
 static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
 {
   points.clear();
   points.resize(mesh->totvert);
 
-  MVert *verts = mesh->mvert;
+  GetVerticesData data;
+  data.points = points.data();
+  data.verts = mesh->mvert;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8192;
+  BLI_task_parallel_range(0, mesh->totvert, &data, get_vertices_fn, &settings);
+}
 
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
+struct GetTopologyData {
+  int32_t *poly_verts;
+  const MPoly *mpolys;
+  const MLoop *mloops;
+};
+
+static void get_topology_fn(void *__restrict userdata,
+                            const int i,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GetTopologyData *data = static_cast<GetTopologyData *>(userdata);
+  const MPoly &poly = data->mpolys[i];
+
+  /* Polygons are converted in mesh order, so the Alembic loop offset of a
+   * polygon matches its `loopstart`. */
+  int32_t *abc_verts = data->poly_verts + poly.loopstart;
+
+  /* NOTE: data needs to be written in the reverse order. */
+  const MLoop *loop = data->mloops + poly.loopstart + (poly.totloop - 1);
+
+  for (int j = 0; j < poly.totloop; j++, loop--) {
+    abc_verts[j] = static_cast<int32_t>(loop->v);
   }
 }
 
@@ -79,28 +126,30 @@ static void get_topology(struct Mesh *mesh,
 {
   const int num_poly = mesh->totpoly;
   const int num_loops = mesh->totloop;
-  MLoop *mloop = mesh->mloop;
   MPoly *mpoly = mesh->mpoly;
   r_has_flat_shaded_poly = false;
 
   poly_verts.clear();
   loop_counts.clear();
-  poly_verts.reserve(num_loops);
-  loop_counts.reserve(num_poly);
+  poly_verts.resize(num_loops);
+  loop_counts.resize(num_poly);
 
-  /* NOTE: data needs to be written in the reverse order. */
   for (int i = 0; i < num_poly; i++) {
     MPoly &poly = mpoly[i];
-    loop_counts.push_back(poly.totloop);
+    loop_counts[i] = poly.totloop;
 
     r_has_flat_shaded_poly |= (poly.flag & ME_SMOOTH) == 0;
+  }
 
-    MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
+  GetTopologyData data;
+  data.poly_verts = poly_verts.data();
+  data.mpolys = mpoly;
+  data.mloops = mesh->mloop;
 
-    for (int j = 0; j < poly.totloop; j++, loop--) {
-      poly_verts.push_back(loop->v);
-    }
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 2048;
+  BLI_task_parallel_range(0, num_poly, &data, get_topology_fn, &settings);
 }
 
 static void get_creases(struct Mesh *mesh,
@@ -129,6 +178,30 @@ static void get_creases(struct Mesh *mesh,
   lengths.resize(sharpnesses.size(), 2);
 }
 
+struct GetLoopNormalsData {
+  Imath::V3f *normals;
+  const MPoly *mpolys;
+  const float (*lnors)[3];
+};
+
+static void get_loop_normals_fn(void *__restrict userdata,
+                                const int i,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GetLoopNormalsData *data = static_cast<GetLoopNormalsData *>(userdata);
+  const MPoly &poly = data->mpolys[i];
+
+  /* Polygons are converted in mesh order, so the Alembic loop offset of a
+   * polygon matches its `loopstart`. */
+  int abc_index = poly.loopstart;
+
+  /* NOTE: data needs to be written in the reverse order. */
+  for (int j = poly.totloop - 1; j >= 0; j--, abc_index++) {
+    int blender_index = poly.loopstart + j;
+    copy_yup_from_zup(data->normals[abc_index].getValue(), data->lnors[blender_index]);
+  }
+}
+
 static void get_loop_normals(struct Mesh *mesh,
                              std::vector<Imath::V3f> &normals,
                              bool has_flat_shaded_poly)
@@ -148,15 +221,15 @@ static void get_loop_normals(struct Mesh *mesh,
 
   normals.resize(mesh->totloop);
 
-  /* NOTE: data needs to be written in the reverse order. */
-  int abc_index = 0;
-  MPoly *mp = mesh->mpoly;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mp++) {
-    for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mp->loopstart + j;
-      copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
-    }
-  }
+  GetLoopNormalsData data;
+  data.normals = normals.data();
+  data.mpolys = mesh->mpoly;
+  data.lnors = lnors;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 2048;
+  BLI_task_parallel_range(0, mesh->totpoly, &data, get_loop_normals_fn, &settings);
 }
 
 /* *************** Modifiers *************** */
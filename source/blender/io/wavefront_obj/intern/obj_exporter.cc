@@ -0,0 +1,270 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include "obj_exporter.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+
+#include "IO_wavefront_obj.h"
+
+#include "DNA_layer_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "BLI_assert.h"
+#include "BLI_fileops.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
+
+#include "BKE_blender_version.h"
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "DEG_depsgraph_query.h"
+
+#include "WM_api.h"
+
+/* NOTE: the OBJ coordinate system is right handed with Y up and -Z forward,
+ * vertices are written as (x, z, -y). Polygon winding is counter-clockwise in
+ * both OBJ and Blender, so loops are written in mesh order. */
+
+namespace OBJ {
+
+/* Writes are buffered in memory and flushed in large blocks, formatting
+ * millions of small `fprintf` calls directly to the file is much slower. */
+class OBJFileWriter {
+ private:
+  FILE *file_;
+  std::string buffer_;
+
+  static const size_t flush_limit_ = 65536;
+
+ public:
+  explicit OBJFileWriter(FILE *file) : file_(file)
+  {
+    buffer_.reserve(flush_limit_ + 1024);
+  }
+
+  ~OBJFileWriter()
+  {
+    flush();
+  }
+
+  void write(const char *format, ...)
+  {
+    char scratch[256];
+    va_list args;
+
+    va_start(args, format);
+    const int len = vsnprintf(scratch, sizeof(scratch), format, args);
+    va_end(args);
+
+    BLI_assert(len >= 0 && len < (int)sizeof(scratch));
+    buffer_.append(scratch, (size_t)len);
+
+    if (buffer_.size() >= flush_limit_) {
+      flush();
+    }
+  }
+
+  void flush()
+  {
+    if (!buffer_.empty()) {
+      fwrite(buffer_.data(), 1, buffer_.size(), file_);
+      buffer_.clear();
+    }
+  }
+};
+
+/* Running 1-based index offsets, OBJ files index vertices, UVs and normals
+ * over the whole file, not per object. */
+struct OBJIndexOffsets {
+  int vertex;
+  int uv;
+  int normal;
+};
+
+static void write_object_name(OBJFileWriter &writer, const Object *object)
+{
+  writer.write("o %s\n", object->id.name + 2);
+}
+
+static void write_vertices(OBJFileWriter &writer, const Object *object, const Mesh *mesh)
+{
+  const MVert *mvert = mesh->mvert;
+
+  for (int i = 0; i < mesh->totvert; i++) {
+    float co[3];
+    mul_v3_m4v3(co, object->obmat, mvert[i].co);
+    writer.write("v %.6f %.6f %.6f\n", co[0], co[2], -co[1]);
+  }
+}
+
+static bool write_uvs(OBJFileWriter &writer, const Mesh *mesh)
+{
+  const MLoopUV *mloopuv = static_cast<const MLoopUV *>(
+      CustomData_get_layer(&mesh->ldata, CD_MLOOPUV));
+
+  if (mloopuv == nullptr) {
+    return false;
+  }
+
+  for (int i = 0; i < mesh->totloop; i++) {
+    writer.write("vt %.6f %.6f\n", mloopuv[i].uv[0], mloopuv[i].uv[1]);
+  }
+
+  return true;
+}
+
+static bool write_normals(OBJFileWriter &writer, const Object *object, Mesh *mesh)
+{
+  BKE_mesh_calc_normals_split(mesh);
+  const float(*lnors)[3] = static_cast<const float(*)[3]>(
+      CustomData_get_layer(&mesh->ldata, CD_NORMAL));
+
+  if (lnors == nullptr) {
+    return false;
+  }
+
+  /* Normals transform with the inverse transpose of the object matrix, to
+   * stay perpendicular under non-uniform scaling. */
+  float normal_matrix[3][3];
+  copy_m3_m4(normal_matrix, object->obmat);
+  invert_m3(normal_matrix);
+  transpose_m3(normal_matrix);
+
+  for (int i = 0; i < mesh->totloop; i++) {
+    float normal[3];
+    mul_v3_m3v3(normal, normal_matrix, lnors[i]);
+    normalize_v3(normal);
+    writer.write("vn %.4f %.4f %.4f\n", normal[0], normal[2], -normal[1]);
+  }
+
+  return true;
+}
+
+static void write_polygons(OBJFileWriter &writer,
+                           const Mesh *mesh,
+                           const OBJIndexOffsets &offsets,
+                           const bool has_uvs,
+                           const bool has_normals)
+{
+  const MPoly *mpoly = mesh->mpoly;
+  const MLoop *mloop = mesh->mloop;
+
+  for (int i = 0; i < mesh->totpoly; i++) {
+    const MPoly &poly = mpoly[i];
+
+    writer.write("f");
+
+    for (int j = 0; j < poly.totloop; j++) {
+      const int loop_index = poly.loopstart + j;
+      const int vert = offsets.vertex + (int)mloop[loop_index].v + 1;
+
+      if (has_uvs && has_normals) {
+        writer.write(" %d/%d/%d", vert, offsets.uv + loop_index + 1, offsets.normal + loop_index + 1);
+      }
+      else if (has_uvs) {
+        writer.write(" %d/%d", vert, offsets.uv + loop_index + 1);
+      }
+      else if (has_normals) {
+        writer.write(" %d//%d", vert, offsets.normal + loop_index + 1);
+      }
+      else {
+        writer.write(" %d", vert);
+      }
+    }
+
+    writer.write("\n");
+  }
+}
+
+static void write_mesh_object(OBJFileWriter &writer,
+                              const OBJExportParams &params,
+                              Object *object,
+                              Mesh *mesh,
+                              OBJIndexOffsets &offsets)
+{
+  write_object_name(writer, object);
+  write_vertices(writer, object, mesh);
+
+  const bool has_uvs = params.export_uvmaps && write_uvs(writer, mesh);
+  const bool has_normals = params.export_normals && write_normals(writer, object, mesh);
+
+  write_polygons(writer, mesh, offsets, has_uvs, has_normals);
+
+  offsets.vertex += mesh->totvert;
+  if (has_uvs) {
+    offsets.uv += mesh->totloop;
+  }
+  if (has_normals) {
+    offsets.normal += mesh->totloop;
+  }
+}
+
+bool exporter_main(Depsgraph *depsgraph, const OBJExportParams &params, const char *filepath)
+{
+  FILE *file = BLI_fopen(filepath, "wb");
+
+  if (file == nullptr) {
+    WM_reportf(RPT_ERROR, "OBJ Export: unable to open file '%s' for writing", filepath);
+    return false;
+  }
+
+  OBJFileWriter writer(file);
+  writer.write("# Blender v%s OBJ File\n", BKE_blender_version_string());
+
+  OBJIndexOffsets offsets = {0, 0, 0};
+
+  DEG_OBJECT_ITER_BEGIN (depsgraph,
+                         object,
+                         DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                             DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET |
+                             DEG_ITER_OBJECT_FLAG_VISIBLE | DEG_ITER_OBJECT_FLAG_DUPLI) {
+    if (params.selected_objects_only && (object->base_flag & BASE_SELECTED) == 0) {
+      continue;
+    }
+    if (object->type != OB_MESH) {
+      continue;
+    }
+
+    Mesh *mesh = BKE_object_get_evaluated_mesh(object);
+    if (mesh == nullptr) {
+      continue;
+    }
+
+    write_mesh_object(writer, params, object, mesh, offsets);
+  }
+  DEG_OBJECT_ITER_END;
+
+  writer.flush();
+  fclose(file);
+
+  return true;
+}
+
+}  // namespace OBJ
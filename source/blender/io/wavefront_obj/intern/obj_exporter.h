@@ -0,0 +1,40 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup obj
+ */
+
+#ifndef __OBJ_EXPORTER_H__
+#define __OBJ_EXPORTER_H__
+
+struct Depsgraph;
+struct OBJExportParams;
+
+namespace OBJ {
+
+/* Write all exportable objects of the evaluated depsgraph to an OBJ file.
+ * Returns false when the file could not be written. */
+bool exporter_main(struct Depsgraph *depsgraph,
+                   const struct OBJExportParams &params,
+                   const char *filepath);
+
+}  // namespace OBJ
+
+#endif /* __OBJ_EXPORTER_H__ */
@@ -673,7 +673,12 @@ typedef struct bAction {
    * (if 0, will be set to whatever ID first evaluates it).
    */
   int idroot;
-  char _pad[4];
+  /**
+   * Runtime: incremented on every copy of the action, used by NLA strip caches
+   * to detect that the action contents they were built from have changed.
+   * Not meaningful in saved files.
+   */
+  unsigned int eval_version;
 } bAction;
 
 /* Flags for the action */
@@ -566,6 +566,18 @@ typedef struct FPoint {
 } FPoint;
 
 /* 'Function-Curve' - defines values over time for a given setting (fcu) */
+/* Runtime baked cache of F-Curve values over the keyframed frame range, used
+ * to turn playback evaluation into a memory read. Built lazily during
+ * playback, freed on any edit of the curve, never saved in files. */
+typedef struct FCurveSampleCache {
+  /** Sampled values, one per frame, with F-Modifier effects applied. */
+  float *values;
+  /** First frame covered by the cache. */
+  int start;
+  /** Number of samples. */
+  int len;
+} FCurveSampleCache;
+
 typedef struct FCurve {
   struct FCurve *next, *prev;
 
@@ -585,13 +597,18 @@ typedef struct FCurve {
   BezTriple *bezt;
   /** 'baked/imported' motion samples (array). */
   FPoint *fpt;
+  /** Runtime playback cache, see #FCurveSampleCache. */
+  struct FCurveSampleCache *sample_cache;
   /** Total number of points which define the curve (i.e. size of arrays in FPoints). */
   unsigned int totvert;
 
   /* value cache + settings */
   /** Value stored from last time curve was evaluated (not threadsafe, debug display only!). */
   float curval;
-  char _pad2[4];
+  /** Index of the keyframe segment used by the previous evaluation. Runtime cursor which is
+   * only a hint: it is validated before use, stale or garbage values merely cost a binary
+   * search. */
+  unsigned int last_eval_index;
   /** User-editable settings for this curve. */
   short flag;
   /** Value-extending mode for this curve (does not cover). */
@@ -692,6 +709,23 @@ typedef enum eFCurve_Smoothing {
  * A NLA Strip is a container for the reuse of Action data, defining parameters
  * to control the remapping of the Action data to some destination.
  */
+/**
+ * Runtime cache of the raw values an action-clip strip evaluates to at one
+ * strip-local time, before influence and blending are applied. Rebuilt when
+ * the strip time or the action changes, never saved to files.
+ */
+typedef struct NlaStripCache {
+  /** Values of the eligible F-Curves of the action, in channel order
+   * (stored in the same allocation, right after this struct). */
+  float *values;
+  /** Strip-local time the values were evaluated at. */
+  float strip_time;
+  /** #bAction.eval_version of the action the values were read from. */
+  unsigned int act_version;
+  int num_values;
+  char _pad[4];
+} NlaStripCache;
+
 typedef struct NlaStrip {
   struct NlaStrip *next, *prev;
 
@@ -745,7 +779,8 @@ typedef struct NlaStrip {
   /* Pointer to an original NLA strip. */
   struct NlaStrip *orig_strip;
 
-  void *_pad3;
+  /** Runtime cache of evaluated strip values (not saved in files). */
+  struct NlaStripCache *cache;
 } NlaStrip;
 
 /* NLA Strip Blending Mode */
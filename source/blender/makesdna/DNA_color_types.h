@@ -175,6 +175,8 @@ typedef struct Scopes {
   float *vecscope;
   int waveform_tot;
   char _pad[4];
+  /** Content hash of the image the scopes were last built from, runtime only. */
+  uint64_t buffer_hash;
 } Scopes;
 
 /* scopes->wavefrm_mode */
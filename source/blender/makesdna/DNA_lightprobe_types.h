@@ -183,6 +183,9 @@ typedef struct LightCache {
   /* All lightprobes data contained in the cache. */
   LightProbeCache *cube_data;
   LightGridCache *grid_data;
+  /** Runtime only: bounds of objects changed since the last bake, used to limit
+   * incremental bakes to the probes that can see the change. Not saved. */
+  struct LightCacheDirtyVolumes *dirty_volumes;
 } LightCache;
 
 /* Bump the version number for lightcache data structure changes. */
@@ -204,6 +207,8 @@ enum {
   LIGHTCACHE_UPDATE_GRID = (1 << 5),
   LIGHTCACHE_UPDATE_WORLD = (1 << 6),
   LIGHTCACHE_UPDATE_AUTO = (1 << 7),
+  /* Only rebake probes made stale by accumulated scene changes. */
+  LIGHTCACHE_INCREMENTAL = (1 << 8),
 };
 
 /* EEVEE_LightCacheTexture->data_type */
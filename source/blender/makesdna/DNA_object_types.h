@@ -166,6 +166,13 @@ typedef struct Object_Runtime {
    */
   struct Mesh *mesh_deform_eval;
 
+  /**
+   * BVH trees (a #BVHCache) taken from the previously evaluated mesh when it was freed,
+   * so the next evaluation can refit them instead of rebuilding from scratch when the
+   * topology did not change (see #BKE_object_free_derived_caches).
+   */
+  void *bvh_cache_stash;
+
   /**
    * Original grease pencil bGPdata pointer, before object->data was changed to point
    * to gpd_eval.
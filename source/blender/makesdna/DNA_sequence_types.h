@@ -275,6 +275,10 @@ typedef struct Editing {
   float recycle_max_cost;
   int cache_flag;
 
+  /** Number of frames to render ahead of the playhead, 0 prefetches until the cache is full. */
+  int prefetch_frames;
+  char _pad[4];
+
   struct PrefetchJob *prefetch_job;
 
   /* Must be initialized only by BKE_sequencer_cache_create() */
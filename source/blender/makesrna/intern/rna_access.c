@@ -80,7 +80,14 @@ void RNA_init(void)
 
   for (srna = BLENDER_RNA.structs.first; srna; srna = srna->cont.next) {
     if (!srna->cont.prophash) {
-      srna->cont.prophash = BLI_ghash_str_new("RNA_init gh");
+      uint props_len = 0;
+      for (prop = srna->cont.properties.first; prop; prop = prop->next) {
+        if (!(prop->flag_internal & PROP_INTERN_BUILTIN)) {
+          props_len += 1;
+        }
+      }
+
+      srna->cont.prophash = BLI_ghash_str_new_ex("RNA_init gh", props_len);
 
       for (prop = srna->cont.properties.first; prop; prop = prop->next) {
         if (!(prop->flag_internal & PROP_INTERN_BUILTIN)) {
@@ -851,10 +858,12 @@ PropertyRNA *RNA_struct_find_property(PointerRNA *ptr, const char *identifier)
   }
   else {
     /* most common case */
-    PropertyRNA *iterprop = RNA_struct_iterator_property(ptr->type);
     PointerRNA propptr;
 
-    if (RNA_property_collection_lookup_string(ptr, iterprop, identifier, &propptr)) {
+    /* The properties collection of every struct resolves to
+     * #rna_builtin_properties_lookup_string, call it directly instead of
+     * looking up the iterator property and its collection callbacks. */
+    if (rna_builtin_properties_lookup_string(ptr, identifier, &propptr)) {
       return propptr.data;
     }
   }
@@ -4418,6 +4427,18 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        if (out.stride == size) {
+          /* Values are tightly packed in memory, copy the whole array at once. */
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
@@ -4432,9 +4453,36 @@ static int rna_raw_access(ReportList *reports,
 
         return 1;
       }
+      else {
+        /* Non-matching raw types, convert values one by one. Still a plain
+         * typed loop over both arrays, much cheaper than the property
+         * get/set fallback below. A double holds every raw type exactly. */
+        RawArray out_item;
+        int a, j;
 
-      /* could also be faster with non-matching types,
-       * for now we just do slower loop .. */
+        out_item.type = out.type;
+        out_item.len = arraylen;
+        out_item.stride = 0;
+
+        for (a = 0; a < out.len; a++) {
+          out_item.array = (char *)out.array + (size_t)a * out.stride;
+
+          for (j = 0; j < arraylen; j++) {
+            double value;
+
+            if (set) {
+              RAW_GET(double, value, in, a * arraylen + j);
+              RAW_SET(double, out_item, j, value);
+            }
+            else {
+              RAW_GET(double, value, out_item, j);
+              RAW_SET(double, in, a * arraylen + j, value);
+            }
+          }
+        }
+
+        return 1;
+      }
     }
   }
 
@@ -810,6 +810,11 @@ void RNA_struct_free(BlenderRNA *brna, StructRNA *srna)
   }
 #  endif
 
+  if (srna->cont.prophash) {
+    BLI_ghash_free(srna->cont.prophash, NULL, NULL);
+    srna->cont.prophash = NULL;
+  }
+
   for (prop = srna->cont.properties.first; prop; prop = nextprop) {
     nextprop = prop->next;
 
@@ -1044,6 +1049,20 @@ StructRNA *RNA_def_struct_ptr(BlenderRNA *brna, const char *identifier, StructRN
     }
   }
 
+#ifdef RNA_RUNTIME
+  if (!DefRNA.preprocess) {
+    /* Runtime registered structs are not covered by the hash built in #RNA_init,
+     * create it here so property lookup doesn't fall back to a linear search.
+     * #RNA_def_property adds properties defined after this point. */
+    srna->cont.prophash = BLI_ghash_str_new(__func__);
+    for (prop = srna->cont.properties.first; prop; prop = prop->next) {
+      if (!(prop->flag_internal & PROP_INTERN_BUILTIN)) {
+        BLI_ghash_insert(srna->cont.prophash, (void *)prop->identifier, prop);
+      }
+    }
+  }
+#endif
+
   return srna;
 }
 
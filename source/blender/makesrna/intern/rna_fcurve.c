@@ -750,6 +750,9 @@ static void rna_FModifier_update(Main *bmain, Scene *UNUSED(scene), PointerRNA *
   if (fcm->curve && fcm->type == FMODIFIER_TYPE_CYCLES) {
     calchandles_fcurve(fcm->curve);
   }
+  if (fcm->curve) {
+    BKE_fcurve_sample_cache_free(fcm->curve);
+  }
 
   rna_tag_animation_update(bmain, id, true);
 }
@@ -27,6 +27,7 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_kdtree.h"
 #include "BLI_math.h"
 
 #include "BLT_translation.h"
@@ -116,53 +117,16 @@ static void updateDepsgraph(ModifierData *md, const ModifierUpdateDepsgraphConte
   }
 }
 
-BLI_INLINE float sum_v3(const float v[3])
-{
-  return v[0] + v[1] + v[2];
-}
-
-/* Structure used for sorting vertices, when processing doubles */
-typedef struct SortVertsElem {
-  int vertex_num; /* The original index of the vertex, prior to sorting */
-  float co[3];    /* Its coordinates */
-  float sum_co;   /* sum_v3(co), just so we don't do the sum many times.  */
-} SortVertsElem;
-
-static int svert_sum_cmp(const void *e1, const void *e2)
-{
-  const SortVertsElem *sv1 = e1;
-  const SortVertsElem *sv2 = e2;
-
-  if (sv1->sum_co > sv2->sum_co) {
-    return 1;
-  }
-  else if (sv1->sum_co < sv2->sum_co) {
-    return -1;
-  }
-  else {
-    return 0;
-  }
-}
-
-static void svert_from_mvert(SortVertsElem *sv,
-                             const MVert *mv,
-                             const int i_begin,
-                             const int i_end)
-{
-  int i;
-  for (i = i_begin; i < i_end; i++, sv++, mv++) {
-    sv->vertex_num = i;
-    copy_v3_v3(sv->co, mv->co);
-    sv->sum_co = sum_v3(mv->co);
-  }
-}
-
 /**
  * Take as inputs two sets of verts, to be processed for detection of doubles and mapping.
  * Each set of verts is defined by its start within mverts array and its num_verts;
  * It builds a mapping for all vertices within source,
  * to vertices within target, or -1 if no double found.
  * The int doubles_map[num_verts_source] array must have been allocated by caller.
+ *
+ * Chunks only touch along their seam, so both sides are first clipped against the
+ * other side's bounding box (expanded by \a dist): the kd-tree is built over seam
+ * target verts only, and only seam source verts are queried (in parallel).
  */
 static void dm_mvert_map_doubles(int *doubles_map,
                                  const MVert *mverts,
@@ -172,110 +136,91 @@ static void dm_mvert_map_doubles(int *doubles_map,
                                  const int source_num_verts,
                                  const float dist)
 {
-  const float dist3 = ((float)M_SQRT3 + 0.00005f) * dist; /* Just above sqrt(3) */
-  int i_source, i_target, i_target_low_bound, target_end, source_end;
-  SortVertsElem *sorted_verts_target, *sorted_verts_source;
-  SortVertsElem *sve_source, *sve_target, *sve_target_low_bound;
-  bool target_scan_completed;
-
-  target_end = target_start + target_num_verts;
-  source_end = source_start + source_num_verts;
-
-  /* build array of MVerts to be tested for merging */
-  sorted_verts_target = MEM_malloc_arrayN(target_num_verts, sizeof(SortVertsElem), __func__);
-  sorted_verts_source = MEM_malloc_arrayN(source_num_verts, sizeof(SortVertsElem), __func__);
-
-  /* Copy target vertices index and cos into SortVertsElem array */
-  svert_from_mvert(sorted_verts_target, mverts + target_start, target_start, target_end);
-
-  /* Copy source vertices index and cos into SortVertsElem array */
-  svert_from_mvert(sorted_verts_source, mverts + source_start, source_start, source_end);
-
-  /* sort arrays according to sum of vertex coordinates (sumco) */
-  qsort(sorted_verts_target, target_num_verts, sizeof(SortVertsElem), svert_sum_cmp);
-  qsort(sorted_verts_source, source_num_verts, sizeof(SortVertsElem), svert_sum_cmp);
+  const int target_end = target_start + target_num_verts;
+  const int source_end = source_start + source_num_verts;
+  float target_min[3], target_max[3], source_min[3], source_max[3];
+  int i;
 
-  sve_target_low_bound = sorted_verts_target;
-  i_target_low_bound = 0;
-  target_scan_completed = false;
+  INIT_MINMAX(target_min, target_max);
+  for (i = target_start; i < target_end; i++) {
+    minmax_v3v3_v3(target_min, target_max, mverts[i].co);
+  }
+  INIT_MINMAX(source_min, source_max);
+  for (i = source_start; i < source_end; i++) {
+    minmax_v3v3_v3(source_min, source_max, mverts[i].co);
+  }
+  for (i = 0; i < 3; i++) {
+    target_min[i] -= dist;
+    target_max[i] += dist;
+    source_min[i] -= dist;
+    source_max[i] += dist;
+  }
+
+  /* Build the tree over target verts which can possibly be doubled,
+   * i.e. those within merge distance of the source bounding box. */
+  KDTree_3d *tree = BLI_kdtree_3d_new(target_num_verts);
+  int tree_num_verts = 0;
+  for (i = target_start; i < target_end; i++) {
+    const float *co = mverts[i].co;
+    if (co[0] >= source_min[0] && co[0] <= source_max[0] && co[1] >= source_min[1] &&
+        co[1] <= source_max[1] && co[2] >= source_min[2] && co[2] <= source_max[2]) {
+      BLI_kdtree_3d_insert(tree, i, co);
+      tree_num_verts++;
+    }
+  }
 
-  /* Scan source vertices, in SortVertsElem sorted array, */
-  /* all the while maintaining the lower bound of possible doubles in target vertices */
-  for (i_source = 0, sve_source = sorted_verts_source; i_source < source_num_verts;
-       i_source++, sve_source++) {
-    int best_target_vertex = -1;
-    float best_dist_sq = dist * dist;
-    float sve_source_sumco;
+  if (tree_num_verts == 0) {
+    /* No possible doubles, source entries not mapped by earlier calls are -1 already. */
+    BLI_kdtree_3d_free(tree);
+    return;
+  }
+  BLI_kdtree_3d_balance(tree);
 
+  /* Collect the seam source verts which still need mapping. */
+  int *queries = MEM_malloc_arrayN(source_num_verts, sizeof(int), __func__);
+  float(*queries_co)[3] = MEM_malloc_arrayN(source_num_verts, sizeof(*queries_co), __func__);
+  int num_queries = 0;
+  for (i = source_start; i < source_end; i++) {
+    const float *co = mverts[i].co;
     /* If source has already been assigned to a target (in an earlier call, with other chunks) */
-    if (doubles_map[sve_source->vertex_num] != -1) {
+    if (doubles_map[i] != -1) {
       continue;
     }
-
-    /* If target fully scanned already, then all remaining source vertices cannot have a double */
-    if (target_scan_completed) {
-      doubles_map[sve_source->vertex_num] = -1;
-      continue;
+    if (co[0] >= target_min[0] && co[0] <= target_max[0] && co[1] >= target_min[1] &&
+        co[1] <= target_max[1] && co[2] >= target_min[2] && co[2] <= target_max[2]) {
+      queries[num_queries] = i;
+      copy_v3_v3(queries_co[num_queries], co);
+      num_queries++;
     }
+  }
 
-    sve_source_sumco = sum_v3(sve_source->co);
+  KDTreeNearest_3d *nearest = MEM_malloc_arrayN(source_num_verts, sizeof(*nearest), __func__);
+  BLI_kdtree_3d_find_nearest_batched(tree, queries_co, num_queries, nearest);
 
-    /* Skip all target vertices that are more than dist3 lower in terms of sumco */
-    /* and advance the overall lower bound, applicable to all remaining vertices as well. */
-    while ((i_target_low_bound < target_num_verts) &&
-           (sve_target_low_bound->sum_co < sve_source_sumco - dist3)) {
-      i_target_low_bound++;
-      sve_target_low_bound++;
-    }
-    /* If end of target list reached, then no more possible doubles */
-    if (i_target_low_bound >= target_num_verts) {
-      doubles_map[sve_source->vertex_num] = -1;
-      target_scan_completed = true;
+  for (i = 0; i < num_queries; i++) {
+    int best_target_vertex = nearest[i].index;
+    if (best_target_vertex == -1 || nearest[i].dist > dist) {
       continue;
     }
-    /* Test target candidates starting at the low bound of possible doubles,
-     * ordered in terms of sumco. */
-    i_target = i_target_low_bound;
-    sve_target = sve_target_low_bound;
-
-    /* i_target will scan vertices in the
-     * [v_source_sumco - dist3;  v_source_sumco + dist3] range */
-
-    while ((i_target < target_num_verts) && (sve_target->sum_co <= sve_source_sumco + dist3)) {
-      /* Testing distance for candidate double in target */
-      /* v_target is within dist3 of v_source in terms of sumco;  check real distance */
-      float dist_sq;
-      if ((dist_sq = len_squared_v3v3(sve_source->co, sve_target->co)) <= best_dist_sq) {
-        /* Potential double found */
-        best_dist_sq = dist_sq;
-        best_target_vertex = sve_target->vertex_num;
-
-        /* If target is already mapped, we only follow that mapping if final target remains
-         * close enough from current vert (otherwise no mapping at all).
-         * Note that if we later find another target closer than this one, then we check it.
-         * But if other potential targets are farther,
-         * then there will be no mapping at all for this source. */
-        while (best_target_vertex != -1 &&
-               !ELEM(doubles_map[best_target_vertex], -1, best_target_vertex)) {
-          if (compare_len_v3v3(mverts[sve_source->vertex_num].co,
-                               mverts[doubles_map[best_target_vertex]].co,
-                               dist)) {
-            best_target_vertex = doubles_map[best_target_vertex];
-          }
-          else {
-            best_target_vertex = -1;
-          }
-        }
+    /* If target is already mapped, we only follow that mapping if final target remains
+     * close enough from current vert (otherwise no mapping at all). */
+    while (best_target_vertex != -1 &&
+           !ELEM(doubles_map[best_target_vertex], -1, best_target_vertex)) {
+      if (compare_len_v3v3(
+              mverts[queries[i]].co, mverts[doubles_map[best_target_vertex]].co, dist)) {
+        best_target_vertex = doubles_map[best_target_vertex];
+      }
+      else {
+        best_target_vertex = -1;
       }
-      i_target++;
-      sve_target++;
     }
-    /* End of candidate scan: if none found then no doubles */
-    doubles_map[sve_source->vertex_num] = best_target_vertex;
+    doubles_map[queries[i]] = best_target_vertex;
   }
 
-  MEM_freeN(sorted_verts_source);
-  MEM_freeN(sorted_verts_target);
+  MEM_freeN(nearest);
+  MEM_freeN(queries_co);
+  MEM_freeN(queries);
+  BLI_kdtree_3d_free(tree);
 }
 
 static void mesh_merge_transform(Mesh *result,
@@ -243,6 +243,11 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
   /* TODO(sergey): Decide whether we ever want to use CCG for subsurf,
    * maybe when it is a last modifier in the stack? */
   if (true) {
+    /* TODO: For viewport evaluation this always pays for a full CPU mesh rebuild, even
+     * during animation playback where the result is only consumed by the draw engine.
+     * Keeping the limit surface on the GPU needs a Mesh wrapper type the draw cache can
+     * extract from and a GL context on the evaluation thread; the evaluator type can
+     * already be requested per consumer, see openSubdiv_createEvaluatorFromTopologyRefiner. */
     result = subdiv_as_mesh(smd, ctx, mesh, subdiv);
   }
   else {
@@ -149,22 +149,27 @@ void MOD_get_texture_coords(MappingInfoModifierData *dmd,
     }
   }
 
+  /* The mapping is uniform over the mesh, so branch on it once instead of per vertex,
+   * and for object mapping compose the two transforms into a single matrix up front. */
   MVert *mv = mesh->mvert;
-  for (i = 0; i < numVerts; i++, mv++, r_texco++) {
-    switch (texmapping) {
-      case MOD_DISP_MAP_LOCAL:
-        copy_v3_v3(*r_texco, cos != NULL ? *cos : mv->co);
-        break;
-      case MOD_DISP_MAP_GLOBAL:
-        mul_v3_m4v3(*r_texco, ob->obmat, cos != NULL ? *cos : mv->co);
-        break;
-      case MOD_DISP_MAP_OBJECT:
-        mul_v3_m4v3(*r_texco, ob->obmat, cos != NULL ? *cos : mv->co);
-        mul_m4_v3(mapref_imat, *r_texco);
-        break;
-    }
-    if (cos != NULL) {
-      cos++;
+  switch (texmapping) {
+    case MOD_DISP_MAP_LOCAL:
+      for (i = 0; i < numVerts; i++, mv++, r_texco++) {
+        copy_v3_v3(*r_texco, cos != NULL ? cos[i] : mv->co);
+      }
+      break;
+    case MOD_DISP_MAP_GLOBAL:
+      for (i = 0; i < numVerts; i++, mv++, r_texco++) {
+        mul_v3_m4v3(*r_texco, ob->obmat, cos != NULL ? cos[i] : mv->co);
+      }
+      break;
+    case MOD_DISP_MAP_OBJECT: {
+      float mapping_mat[4][4];
+      mul_m4_m4m4(mapping_mat, mapref_imat, ob->obmat);
+      for (i = 0; i < numVerts; i++, mv++, r_texco++) {
+        mul_v3_m4v3(*r_texco, mapping_mat, cos != NULL ? cos[i] : mv->co);
+      }
+      break;
     }
   }
 }
@@ -382,70 +382,86 @@ static void weld_assert_poly_len(const WeldPoly *wp, const WeldLoop *wloop)
 /** \name Weld Vert API
  * \{ */
 
-static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
-                                          const BVHTreeOverlap *overlap,
-                                          const uint overlap_len,
-                                          uint *r_vert_dest_map,
-                                          WeldVert **r_wvert,
-                                          uint *r_wvert_len,
-                                          uint *r_vert_kill_len)
+static uint weld_vert_find_root(uint *vert_dest_map, uint v)
 {
-  uint *v_dest_iter = &r_vert_dest_map[0];
-  for (uint i = mvert_len; i--; v_dest_iter++) {
-    *v_dest_iter = OUT_OF_CONTEXT;
+  uint root = v;
+  while (vert_dest_map[root] != root) {
+    root = vert_dest_map[root];
+  }
+  /* Compress the path for later lookups. */
+  while (vert_dest_map[v] != root) {
+    const uint v_next = vert_dest_map[v];
+    vert_dest_map[v] = root;
+    v = v_next;
   }
+  return root;
+}
 
-  uint vert_kill_len = 0;
+/**
+ * Merge the connected components of the overlap pairs with a union-find
+ * (the old implementation rescanned all previous pairs on every late merge,
+ * which was quadratic on meshes with many vertices welded into the same group).
+ *
+ * \param r_vert_dest_map: Must be initialized to #OUT_OF_CONTEXT.
+ * \return The number of vertices to be merged away.
+ */
+static uint weld_vert_dest_map_setup_from_overlap(const BVHTreeOverlap *overlap,
+                                                  const uint overlap_len,
+                                                  const uint mvert_len,
+                                                  uint *r_vert_dest_map)
+{
   const BVHTreeOverlap *overlap_iter = &overlap[0];
   for (uint i = 0; i < overlap_len; i++, overlap_iter++) {
-    uint indexA = overlap_iter->indexA;
-    uint indexB = overlap_iter->indexB;
+    const uint indexA = overlap_iter->indexA;
+    const uint indexB = overlap_iter->indexB;
 
     BLI_assert(indexA < indexB);
 
-    uint va_dst = r_vert_dest_map[indexA];
-    uint vb_dst = r_vert_dest_map[indexB];
-    if (va_dst == OUT_OF_CONTEXT) {
-      if (vb_dst == OUT_OF_CONTEXT) {
-        vb_dst = indexA;
-        r_vert_dest_map[indexB] = vb_dst;
-      }
-      r_vert_dest_map[indexA] = vb_dst;
-      vert_kill_len++;
+    if (r_vert_dest_map[indexA] == OUT_OF_CONTEXT) {
+      r_vert_dest_map[indexA] = indexA;
     }
-    else if (vb_dst == OUT_OF_CONTEXT) {
-      r_vert_dest_map[indexB] = va_dst;
-      vert_kill_len++;
+    if (r_vert_dest_map[indexB] == OUT_OF_CONTEXT) {
+      r_vert_dest_map[indexB] = indexB;
     }
-    else if (va_dst != vb_dst) {
-      uint v_new, v_old;
-      if (va_dst < vb_dst) {
-        v_new = va_dst;
-        v_old = vb_dst;
+    const uint root_a = weld_vert_find_root(r_vert_dest_map, indexA);
+    const uint root_b = weld_vert_find_root(r_vert_dest_map, indexB);
+    if (root_a != root_b) {
+      /* The lowest index is the merge destination, matching the old behavior. */
+      if (root_a < root_b) {
+        r_vert_dest_map[root_b] = root_a;
       }
       else {
-        v_new = vb_dst;
-        v_old = va_dst;
+        r_vert_dest_map[root_a] = root_b;
       }
-      BLI_assert(r_vert_dest_map[v_old] == v_old);
-      BLI_assert(r_vert_dest_map[v_new] == v_new);
-      vert_kill_len++;
+    }
+  }
 
-      const BVHTreeOverlap *overlap_iter_b = &overlap[0];
-      for (uint j = i + 1; j--; overlap_iter_b++) {
-        indexA = overlap_iter_b->indexA;
-        indexB = overlap_iter_b->indexB;
-        va_dst = r_vert_dest_map[indexA];
-        vb_dst = r_vert_dest_map[indexB];
-        if (ELEM(v_old, vb_dst, va_dst)) {
-          r_vert_dest_map[indexA] = v_new;
-          r_vert_dest_map[indexB] = v_new;
-        }
-      }
-      BLI_assert(r_vert_dest_map[v_old] == v_new);
+  /* Flatten, so that every vertex in context points directly at its destination. */
+  uint vert_kill_len = 0;
+  uint *v_dest_iter = &r_vert_dest_map[0];
+  for (uint i = 0; i < mvert_len; i++, v_dest_iter++) {
+    if (*v_dest_iter == OUT_OF_CONTEXT) {
+      continue;
+    }
+    const uint root = weld_vert_find_root(r_vert_dest_map, i);
+    *v_dest_iter = root;
+    if (root != i) {
+      vert_kill_len++;
     }
   }
 
+#ifdef USE_WELD_DEBUG
+  weld_assert_vert_dest_map_setup(overlap, overlap_len, r_vert_dest_map);
+#endif
+
+  return vert_kill_len;
+}
+
+static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
+                                          const uint *vert_dest_map,
+                                          WeldVert **r_wvert,
+                                          uint *r_wvert_len)
+{
   /* Vert Context. */
   uint wvert_len = 0;
 
@@ -453,7 +469,7 @@ static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
   wvert = MEM_mallocN(sizeof(*wvert) * mvert_len, __func__);
   wv = &wvert[0];
 
-  v_dest_iter = &r_vert_dest_map[0];
+  const uint *v_dest_iter = &vert_dest_map[0];
   for (uint i = 0; i < mvert_len; i++, v_dest_iter++) {
     if (*v_dest_iter != OUT_OF_CONTEXT) {
       wv->vert_dest = *v_dest_iter;
@@ -463,13 +479,8 @@ static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
     }
   }
 
-#ifdef USE_WELD_DEBUG
-  weld_assert_vert_dest_map_setup(overlap, overlap_len, r_vert_dest_map);
-#endif
-
   *r_wvert = MEM_reallocN(wvert, sizeof(*wvert) * wvert_len);
   *r_wvert_len = wvert_len;
-  *r_vert_kill_len = vert_kill_len;
 }
 
 static void weld_vert_groups_setup(const uint mvert_len,
@@ -1394,9 +1405,14 @@ static void weld_poly_loop_ctx_setup(const MLoop *mloop,
 /** \name Weld Mesh API
  * \{ */
 
+/**
+ * \param vert_dest_map: Pre-computed merge destination of each vertex
+ * (flattened, #OUT_OF_CONTEXT for vertices not involved in any merge).
+ * Ownership is transferred to \a r_weld_mesh.
+ */
 static void weld_mesh_context_create(const Mesh *mesh,
-                                     BVHTreeOverlap *overlap,
-                                     const uint overlap_len,
+                                     uint *vert_dest_map,
+                                     const uint vert_kill_len,
                                      WeldMesh *r_weld_mesh)
 {
   const MEdge *medge = mesh->medge;
@@ -1407,19 +1423,14 @@ static void weld_mesh_context_create(const Mesh *mesh,
   const uint mloop_len = mesh->totloop;
   const uint mpoly_len = mesh->totpoly;
 
-  uint *vert_dest_map = MEM_mallocN(sizeof(*vert_dest_map) * mvert_len, __func__);
   uint *edge_dest_map = MEM_mallocN(sizeof(*edge_dest_map) * medge_len, __func__);
   struct WeldGroup *v_links = MEM_callocN(sizeof(*v_links) * mvert_len, __func__);
 
+  r_weld_mesh->vert_kill_len = vert_kill_len;
+
   WeldVert *wvert;
   uint wvert_len;
-  weld_vert_ctx_alloc_and_setup(mvert_len,
-                                overlap,
-                                overlap_len,
-                                vert_dest_map,
-                                &wvert,
-                                &wvert_len,
-                                &r_weld_mesh->vert_kill_len);
+  weld_vert_ctx_alloc_and_setup(mvert_len, vert_dest_map, &wvert, &wvert_len);
 
   uint *edge_ctx_map;
   WeldEdge *wedge;
@@ -1685,48 +1696,89 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
     }
   }
 
-  /* Get overlap map. */
-  /* TODO: For a better performanse use KD-Tree. */
-  struct BVHTreeFromMesh treedata;
-  BVHTree *bvhtree = bvhtree_from_mesh_verts_ex(&treedata,
-                                                mvert,
-                                                totvert,
-                                                false,
-                                                v_mask,
-                                                v_mask_act,
-                                                wmd->merge_dist / 2,
-                                                2,
-                                                6,
-                                                0,
-                                                NULL,
-                                                NULL);
-
-  if (v_mask) {
-    MEM_freeN(v_mask);
-  }
+  uint *vert_dest_map = MEM_mallocN(sizeof(*vert_dest_map) * totvert, __func__);
+  uint vert_kill_len = 0;
+
+  if ((wmd->max_interactions == 0) && (v_mask == NULL)) {
+    /* Unlimited interactions without a vertex group: parallel spatial-hash bucketing plus
+     * union-find merge beats building a BVH and resolving its overlap pairs. */
+    int *vtargetmap;
+    const int tot_vtargetmap = BKE_mesh_merge_verts_map_create_by_distance(
+        mvert, (int)totvert, wmd->merge_dist, &vtargetmap);
 
-  if (bvhtree == NULL) {
-    return result;
+    uint *v_dest_iter = &vert_dest_map[0];
+    for (i = totvert; i--; v_dest_iter++) {
+      *v_dest_iter = OUT_OF_CONTEXT;
+    }
+    if (tot_vtargetmap != 0) {
+      for (i = 0; i < totvert; i++) {
+        const int v_target = vtargetmap[i];
+        if (v_target != -1) {
+          vert_dest_map[i] = (uint)v_target;
+          /* Merge targets are in context too, mapping onto themselves. */
+          vert_dest_map[v_target] = (uint)v_target;
+          vert_kill_len++;
+        }
+      }
+    }
+    MEM_freeN(vtargetmap);
   }
+  else {
+    /* Get overlap map. */
+    struct BVHTreeFromMesh treedata;
+    BVHTree *bvhtree = bvhtree_from_mesh_verts_ex(&treedata,
+                                                  mvert,
+                                                  totvert,
+                                                  false,
+                                                  v_mask,
+                                                  v_mask_act,
+                                                  wmd->merge_dist / 2,
+                                                  2,
+                                                  6,
+                                                  0,
+                                                  NULL,
+                                                  NULL);
+
+    if (v_mask) {
+      MEM_freeN(v_mask);
+    }
+
+    if (bvhtree == NULL) {
+      MEM_freeN(vert_dest_map);
+      return result;
+    }
 
-  struct WeldOverlapData data;
-  data.mvert = mvert;
-  data.merge_dist_sq = square_f(wmd->merge_dist);
+    struct WeldOverlapData data;
+    data.mvert = mvert;
+    data.merge_dist_sq = square_f(wmd->merge_dist);
 
-  uint overlap_len;
-  BVHTreeOverlap *overlap = BLI_bvhtree_overlap_ex(bvhtree,
-                                                   bvhtree,
-                                                   &overlap_len,
-                                                   bvhtree_weld_overlap_cb,
-                                                   &data,
-                                                   wmd->max_interactions,
-                                                   BVH_OVERLAP_RETURN_PAIRS);
+    uint overlap_len;
+    BVHTreeOverlap *overlap = BLI_bvhtree_overlap_ex(bvhtree,
+                                                     bvhtree,
+                                                     &overlap_len,
+                                                     bvhtree_weld_overlap_cb,
+                                                     &data,
+                                                     wmd->max_interactions,
+                                                     BVH_OVERLAP_RETURN_PAIRS);
 
-  free_bvhtree_from_mesh(&treedata);
+    free_bvhtree_from_mesh(&treedata);
 
-  if (overlap_len) {
+    uint *v_dest_iter = &vert_dest_map[0];
+    for (i = totvert; i--; v_dest_iter++) {
+      *v_dest_iter = OUT_OF_CONTEXT;
+    }
+    if (overlap_len) {
+      vert_kill_len = weld_vert_dest_map_setup_from_overlap(
+          overlap, overlap_len, totvert, vert_dest_map);
+    }
+    if (overlap) {
+      MEM_freeN(overlap);
+    }
+  }
+
+  if (vert_kill_len) {
     WeldMesh weld_mesh;
-    weld_mesh_context_create(mesh, overlap, overlap_len, &weld_mesh);
+    weld_mesh_context_create(mesh, vert_dest_map, vert_kill_len, &weld_mesh);
 
     mloop = mesh->mloop;
     mpoly = mesh->mpoly;
@@ -1918,8 +1970,10 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
 
     weld_mesh_context_free(&weld_mesh);
   }
+  else {
+    MEM_freeN(vert_dest_map);
+  }
 
-  MEM_freeN(overlap);
   return result;
 }
 
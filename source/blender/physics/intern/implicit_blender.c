@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -50,6 +51,9 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Minimum vertex count before the row-indexed matrix-vector product is threaded. */
+#  define CLOTH_PARALLEL_LIMIT 512
+
 //#define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -638,6 +642,99 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/* Build a per-row index over the sparse block layout, so the matrix-vector product can be
+ * computed one result row at a time without write conflicts. Entries encode the block index
+ * in the upper bits and whether the block contributes transposed (lower triangle block whose
+ * column is this row) in the lowest bit. All matrices of an Implicit_Data share the same
+ * layout, so one index serves every product of a solve. */
+static void build_bfmatrix_row_index(fmatrix3x3 *matrix,
+                                     unsigned int *r_offsets,
+                                     unsigned int *r_entries)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int tcount = vcount + matrix[0].scount;
+  unsigned int i;
+
+  memset(r_offsets, 0, sizeof(*r_offsets) * (vcount + 1));
+  for (i = 0; i < vcount; i++) {
+    r_offsets[i + 1]++;
+  }
+  for (i = vcount; i < tcount; i++) {
+    r_offsets[matrix[i].r + 1]++;
+    r_offsets[matrix[i].c + 1]++;
+  }
+  for (i = 1; i <= vcount; i++) {
+    r_offsets[i] += r_offsets[i - 1];
+  }
+
+  /* Fill using the offsets as running cursors, then shift them back in place. */
+  for (i = 0; i < vcount; i++) {
+    r_entries[r_offsets[i]++] = (i << 1);
+  }
+  for (i = vcount; i < tcount; i++) {
+    r_entries[r_offsets[matrix[i].r]++] = (i << 1);
+    r_entries[r_offsets[matrix[i].c]++] = (i << 1) | 1;
+  }
+  for (i = vcount; i > 0; i--) {
+    r_offsets[i] = r_offsets[i - 1];
+  }
+  r_offsets[0] = 0;
+}
+
+typedef struct MulBfmatrixRowsData {
+  fmatrix3x3 *from;
+  lfVector *vec;
+  lfVector *to;
+  const unsigned int *row_offsets;
+  const unsigned int *row_entries;
+} MulBfmatrixRowsData;
+
+static void mul_bfmatrix_lfvector_rows_task_cb(void *__restrict userdata,
+                                               const int row,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MulBfmatrixRowsData *data = userdata;
+  fmatrix3x3 *from = data->from;
+  unsigned int j;
+
+  zero_v3(data->to[row]);
+  for (j = data->row_offsets[row]; j < data->row_offsets[row + 1]; j++) {
+    const unsigned int entry = data->row_entries[j];
+    fmatrix3x3 *block = &from[entry >> 1];
+
+    if (entry & 1) {
+      muladd_fmatrixT_fvector(data->to[row], block->m, data->vec[block->r]);
+    }
+    else {
+      muladd_fmatrix_fvector(data->to[row], block->m, data->vec[block->c]);
+    }
+  }
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector, threaded over result rows.
+ * Produces the same result as mul_bfmatrix_lfvector() but needs the row index built
+ * by build_bfmatrix_row_index(). */
+static void mul_bfmatrix_lfvector_rows(float (*to)[3],
+                                       fmatrix3x3 *from,
+                                       lfVector *fLongVector,
+                                       const unsigned int *row_offsets,
+                                       const unsigned int *row_entries)
+{
+  MulBfmatrixRowsData data = {
+      .from = from,
+      .vec = fLongVector,
+      .to = to,
+      .row_offsets = row_offsets,
+      .row_entries = row_entries,
+  };
+  TaskParallelSettings settings;
+
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (from[0].vcount > CLOTH_PARALLEL_LIMIT);
+  BLI_task_parallel_range(
+      0, (int)from[0].vcount, &data, mul_bfmatrix_lfvector_rows_task_cb, &settings);
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix*/
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
@@ -677,6 +774,11 @@ typedef struct Implicit_Data {
   lfVector *z;          /* target velocity in constrained directions */
   fmatrix3x3 *S;        /* filtering matrix for constraints */
   fmatrix3x3 *P, *Pinv; /* pre-conditioning matrix */
+
+  /* row index over the sparse block layout, rebuilt each solve (see
+   * build_bfmatrix_row_index) */
+  unsigned int *row_offsets;
+  unsigned int *row_entries;
 } Implicit_Data;
 
 Implicit_Data *BPH_mass_spring_solver_create(int numverts, int numsprings)
@@ -702,6 +804,11 @@ Implicit_Data *BPH_mass_spring_solver_create(int numverts, int numsprings)
   id->dV = create_lfvector(numverts);
   id->z = create_lfvector(numverts);
 
+  id->row_offsets = MEM_mallocN(sizeof(*id->row_offsets) * (numverts + 1),
+                                "implicit row offsets");
+  id->row_entries = MEM_mallocN(sizeof(*id->row_entries) * (numverts + 2 * numsprings),
+                                "implicit row entries");
+
   initdiag_bfmatrix(id->bigI, I);
 
   return id;
@@ -728,6 +835,9 @@ void BPH_mass_spring_solver_free(Implicit_Data *id)
   del_lfvector(id->dV);
   del_lfvector(id->z);
 
+  MEM_freeN(id->row_offsets);
+  MEM_freeN(id->row_entries);
+
   MEM_freeN(id);
 }
 
@@ -843,6 +953,8 @@ static int cg_filtered(lfVector *ldV,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
+                       const unsigned int *row_offsets,
+                       const unsigned int *row_entries,
                        ImplicitSolverResult *result)
 {
   // Solves for unknown X in equation AX=B
@@ -867,7 +979,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_rows(AdV, lA, ldV, row_offsets, row_entries);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -890,7 +1002,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector_rows(q, lA, c, row_offsets, row_entries);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1150,7 +1262,9 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  build_bfmatrix_row_index(data->A, data->row_offsets, data->row_entries);
+
+  mul_bfmatrix_lfvector_rows(dFdXmV, data->dFdX, data->V, data->row_offsets, data->row_entries);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1159,7 +1273,8 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(
+      data->dV, data->A, data->B, data->z, data->S, data->row_offsets, data->row_entries, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
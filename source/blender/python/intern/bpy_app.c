@@ -42,6 +42,9 @@
 #include "bpy_driver.h"
 
 /* modules */
+#include "bpy_app_depsgraph_trace.h"
+#include "bpy_app_eval_stats.h"
+#include "bpy_app_event_latency.h"
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
 
@@ -123,6 +126,9 @@ static PyStructSequence_Field app_info_fields[] = {
     /* Modules (not struct sequence). */
     {"icons", "Manage custom icons"},
     {"timers", "Manage timers"},
+    {"eval_stats", "Mesh evaluation statistics"},
+    {"depsgraph_trace", "Dependency graph operation tracing"},
+    {"event_latency", "Input event latency samples"},
     {NULL},
 };
 
@@ -217,6 +223,9 @@ static PyObject *make_app_info(void)
   /* modules */
   SetObjItem(BPY_app_icons_module());
   SetObjItem(BPY_app_timers_module());
+  SetObjItem(BPY_app_eval_stats_module());
+  SetObjItem(BPY_app_depsgraph_trace_module());
+  SetObjItem(BPY_app_event_latency_module());
 
 #undef SetIntItem
 #undef SetStrItem
@@ -0,0 +1,186 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * Access to the dependency graph operation tracing, for finding which
+ * operations are the most expensive during playback.
+ */
+
+#include <Python.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "DEG_depsgraph_debug.h"
+
+#include "bpy_app_depsgraph_trace.h"
+
+PyDoc_STRVAR(bpy_app_depsgraph_trace_enable_doc,
+             ".. function:: enable(max_events=65536)\n"
+             "\n"
+             "   Start recording evaluated dependency graph operations into a ring\n"
+             "   buffer. Re-enabling clears previously recorded events.\n"
+             "\n"
+             "   :arg max_events: Capacity of the ring buffer.\n"
+             "   :type max_events: int\n");
+static PyObject *bpy_app_depsgraph_trace_enable(PyObject *UNUSED(self),
+                                                PyObject *args,
+                                                PyObject *kw)
+{
+  int max_events = 65536;
+
+  static const char *_keywords[] = {"max_events", NULL};
+  static _PyArg_Parser _parser = {"|$i:enable", _keywords, 0};
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, &max_events)) {
+    return NULL;
+  }
+
+  DEG_debug_trace_enable(max_events);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_depsgraph_trace_disable_doc,
+             ".. function:: disable()\n"
+             "\n"
+             "   Stop recording and discard all recorded events.\n");
+static PyObject *bpy_app_depsgraph_trace_disable(PyObject *UNUSED(self))
+{
+  DEG_debug_trace_disable();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_depsgraph_trace_is_enabled_doc,
+             ".. function:: is_enabled()\n"
+             "\n"
+             "   Check whether operations are being recorded.\n"
+             "\n"
+             "   :return: True when recording is enabled.\n"
+             "   :rtype: bool\n");
+static PyObject *bpy_app_depsgraph_trace_is_enabled(PyObject *UNUSED(self))
+{
+  return PyBool_FromLong(DEG_debug_trace_is_enabled());
+}
+
+PyDoc_STRVAR(bpy_app_depsgraph_trace_export_chrome_trace_doc,
+             ".. function:: export_chrome_trace(filepath)\n"
+             "\n"
+             "   Write all recorded events as Chrome trace JSON, to be opened in\n"
+             "   chrome://tracing or a compatible viewer.\n"
+             "\n"
+             "   :arg filepath: Path of the JSON file to write.\n"
+             "   :type filepath: string\n"
+             "   :return: True when the file was written.\n"
+             "   :rtype: bool\n");
+static PyObject *bpy_app_depsgraph_trace_export_chrome_trace(PyObject *UNUSED(self),
+                                                             PyObject *args,
+                                                             PyObject *kw)
+{
+  const char *filepath;
+
+  static const char *_keywords[] = {"filepath", NULL};
+  static _PyArg_Parser _parser = {"s:export_chrome_trace", _keywords, 0};
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, &filepath)) {
+    return NULL;
+  }
+
+  return PyBool_FromLong(DEG_debug_trace_export_chrome_json(filepath));
+}
+
+PyDoc_STRVAR(bpy_app_depsgraph_trace_slowest_doc,
+             ".. function:: slowest(max_per_frame=10)\n"
+             "\n"
+             "   Aggregate the recorded events into the slowest operations of every\n"
+             "   recorded frame.\n"
+             "\n"
+             "   :arg max_per_frame: Maximum number of operations reported per frame.\n"
+             "   :type max_per_frame: int\n"
+             "   :return: List of (frame, operation name, time in seconds) tuples,\n"
+             "      ordered by frame, then by time.\n"
+             "   :rtype: list of tuples\n");
+static PyObject *bpy_app_depsgraph_trace_slowest(PyObject *UNUSED(self),
+                                                 PyObject *args,
+                                                 PyObject *kw)
+{
+  int max_per_frame = 10;
+
+  static const char *_keywords[] = {"max_per_frame", NULL};
+  static _PyArg_Parser _parser = {"|$i:slowest", _keywords, 0};
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, &max_per_frame)) {
+    return NULL;
+  }
+
+  int num_entries;
+  DEGTraceSlowestEntry *entries = DEG_debug_trace_slowest_table(max_per_frame, &num_entries);
+  PyObject *result = PyList_New(num_entries);
+  for (int i = 0; i < num_entries; i++) {
+    const DEGTraceSlowestEntry *entry = &entries[i];
+    PyList_SET_ITEM(result, i, Py_BuildValue("(fsd)", entry->frame, entry->name, entry->time));
+  }
+  if (entries != NULL) {
+    MEM_freeN(entries);
+  }
+  return result;
+}
+
+static struct PyMethodDef M_AppDepsgraphTrace_methods[] = {
+    {"enable",
+     (PyCFunction)bpy_app_depsgraph_trace_enable,
+     METH_VARARGS | METH_KEYWORDS,
+     bpy_app_depsgraph_trace_enable_doc},
+    {"disable",
+     (PyCFunction)bpy_app_depsgraph_trace_disable,
+     METH_NOARGS,
+     bpy_app_depsgraph_trace_disable_doc},
+    {"is_enabled",
+     (PyCFunction)bpy_app_depsgraph_trace_is_enabled,
+     METH_NOARGS,
+     bpy_app_depsgraph_trace_is_enabled_doc},
+    {"export_chrome_trace",
+     (PyCFunction)bpy_app_depsgraph_trace_export_chrome_trace,
+     METH_VARARGS | METH_KEYWORDS,
+     bpy_app_depsgraph_trace_export_chrome_trace_doc},
+    {"slowest",
+     (PyCFunction)bpy_app_depsgraph_trace_slowest,
+     METH_VARARGS | METH_KEYWORDS,
+     bpy_app_depsgraph_trace_slowest_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef M_AppDepsgraphTrace_module_def = {
+    PyModuleDef_HEAD_INIT,
+    "bpy.app.depsgraph_trace",   /* m_name */
+    NULL,                        /* m_doc */
+    0,                           /* m_size */
+    M_AppDepsgraphTrace_methods, /* m_methods */
+    NULL,                        /* m_reload */
+    NULL,                        /* m_traverse */
+    NULL,                        /* m_clear */
+    NULL,                        /* m_free */
+};
+
+PyObject *BPY_app_depsgraph_trace_module(void)
+{
+  PyObject *sys_modules = PyImport_GetModuleDict();
+
+  PyObject *mod = PyModule_Create(&M_AppDepsgraphTrace_module_def);
+
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(mod), mod);
+
+  return mod;
+}
@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * Access to the named mesh evaluation statistics, for tracking evaluation
+ * time regressions from scripts.
+ */
+
+#include <Python.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "BKE_eval_stats.h"
+
+#include "bpy_app_eval_stats.h"
+
+PyDoc_STRVAR(bpy_app_eval_stats_enable_doc,
+             ".. function:: enable(enable=True)\n"
+             "\n"
+             "   Enable or disable collection of mesh evaluation statistics.\n"
+             "\n"
+             "   :arg enable: Collection state to set.\n"
+             "   :type enable: bool\n");
+static PyObject *bpy_app_eval_stats_enable(PyObject *UNUSED(self), PyObject *args, PyObject *kw)
+{
+  int enable = true;
+
+  static const char *_keywords[] = {"enable", NULL};
+  static _PyArg_Parser _parser = {"|$p:enable", _keywords, 0};
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, &enable)) {
+    return NULL;
+  }
+
+  BKE_eval_stats_enable(enable);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_eval_stats_is_enabled_doc,
+             ".. function:: is_enabled()\n"
+             "\n"
+             "   Check whether mesh evaluation statistics are being collected.\n"
+             "\n"
+             "   :return: True when statistics are collected.\n"
+             "   :rtype: bool\n");
+static PyObject *bpy_app_eval_stats_is_enabled(PyObject *UNUSED(self))
+{
+  return PyBool_FromLong(BKE_eval_stats_is_enabled());
+}
+
+PyDoc_STRVAR(bpy_app_eval_stats_reset_doc,
+             ".. function:: reset()\n"
+             "\n"
+             "   Clear all accumulated statistics.\n");
+static PyObject *bpy_app_eval_stats_reset(PyObject *UNUSED(self))
+{
+  BKE_eval_stats_reset();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_eval_stats_as_json_doc,
+             ".. function:: as_json()\n"
+             "\n"
+             "   Serialize the accumulated statistics.\n"
+             "\n"
+             "   :return: JSON object mapping each name to its total time in seconds\n"
+             "      and number of samples.\n"
+             "   :rtype: string\n");
+static PyObject *bpy_app_eval_stats_as_json(PyObject *UNUSED(self))
+{
+  char *json = BKE_eval_stats_as_json();
+  PyObject *result = PyUnicode_FromString(json);
+  MEM_freeN(json);
+  return result;
+}
+
+static struct PyMethodDef M_AppEvalStats_methods[] = {
+    {"enable",
+     (PyCFunction)bpy_app_eval_stats_enable,
+     METH_VARARGS | METH_KEYWORDS,
+     bpy_app_eval_stats_enable_doc},
+    {"is_enabled",
+     (PyCFunction)bpy_app_eval_stats_is_enabled,
+     METH_NOARGS,
+     bpy_app_eval_stats_is_enabled_doc},
+    {"reset", (PyCFunction)bpy_app_eval_stats_reset, METH_NOARGS, bpy_app_eval_stats_reset_doc},
+    {"as_json",
+     (PyCFunction)bpy_app_eval_stats_as_json,
+     METH_NOARGS,
+     bpy_app_eval_stats_as_json_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef M_AppEvalStats_module_def = {
+    PyModuleDef_HEAD_INIT,
+    "bpy.app.eval_stats",   /* m_name */
+    NULL,                   /* m_doc */
+    0,                      /* m_size */
+    M_AppEvalStats_methods, /* m_methods */
+    NULL,                   /* m_reload */
+    NULL,                   /* m_traverse */
+    NULL,                   /* m_clear */
+    NULL,                   /* m_free */
+};
+
+PyObject *BPY_app_eval_stats_module(void)
+{
+  PyObject *sys_modules = PyImport_GetModuleDict();
+
+  PyObject *mod = PyModule_Create(&M_AppEvalStats_module_def);
+
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(mod), mod);
+
+  return mod;
+}
@@ -0,0 +1,100 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * Access to the window manager event-to-photon latency samples,
+ * for tracking interaction latency regressions from scripts.
+ */
+
+#include <Python.h>
+
+#include "BLI_utildefines.h"
+
+#include "WM_api.h"
+
+#include "bpy_app_event_latency.h"
+
+PyDoc_STRVAR(bpy_app_event_latency_samples_doc,
+             ".. function:: samples()\n"
+             "\n"
+             "   Return the recorded input latency samples, oldest first.\n"
+             "\n"
+             "   :return: List of (queue, handlers, draw) stage times in milliseconds,\n"
+             "      one tuple per sampled input event.\n"
+             "   :rtype: list of tuple of float\n");
+static PyObject *bpy_app_event_latency_samples(PyObject *UNUSED(self))
+{
+  WM_EventLatencySample samples[WM_EVENT_LATENCY_SAMPLES_MAX];
+  const int samples_len = WM_event_latency_samples_get(samples, WM_EVENT_LATENCY_SAMPLES_MAX);
+
+  PyObject *result = PyList_New(samples_len);
+  for (int i = 0; i < samples_len; i++) {
+    PyList_SET_ITEM(result,
+                    i,
+                    Py_BuildValue("(ddd)",
+                                  samples[i].queue_ms,
+                                  samples[i].handlers_ms,
+                                  samples[i].draw_ms));
+  }
+  return result;
+}
+
+PyDoc_STRVAR(bpy_app_event_latency_reset_doc,
+             ".. function:: reset()\n"
+             "\n"
+             "   Discard all recorded samples.\n");
+static PyObject *bpy_app_event_latency_reset(PyObject *UNUSED(self))
+{
+  WM_event_latency_reset();
+  Py_RETURN_NONE;
+}
+
+static struct PyMethodDef M_AppEventLatency_methods[] = {
+    {"samples",
+     (PyCFunction)bpy_app_event_latency_samples,
+     METH_NOARGS,
+     bpy_app_event_latency_samples_doc},
+    {"reset",
+     (PyCFunction)bpy_app_event_latency_reset,
+     METH_NOARGS,
+     bpy_app_event_latency_reset_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef M_AppEventLatency_module_def = {
+    PyModuleDef_HEAD_INIT,
+    "bpy.app.event_latency",   /* m_name */
+    NULL,                      /* m_doc */
+    0,                         /* m_size */
+    M_AppEventLatency_methods, /* m_methods */
+    NULL,                      /* m_reload */
+    NULL,                      /* m_traverse */
+    NULL,                      /* m_clear */
+    NULL,                      /* m_free */
+};
+
+PyObject *BPY_app_event_latency_module(void)
+{
+  PyObject *sys_modules = PyImport_GetModuleDict();
+
+  PyObject *mod = PyModule_Create(&M_AppEventLatency_module_def);
+
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(mod), mod);
+
+  return mod;
+}
@@ -5243,6 +5243,40 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/* Map the format of an incompatible (but known) buffer to a raw type,
+ * so raw access can convert values instead of the slow sequence fallback.
+ * Formats whose size depends on the platform ('l', 'q', ...) are excluded. */
+static bool foreach_raw_type_from_buffer_format(const char *format, RawPropertyType *r_raw_type)
+{
+  char f = format ? *format : 'B'; /* B is assumed when not set */
+
+  switch (f) {
+    case 'b':
+    case 'B':
+      *r_raw_type = PROP_RAW_CHAR;
+      return true;
+    case 'h':
+    case 'H':
+      *r_raw_type = PROP_RAW_SHORT;
+      return true;
+    case 'i':
+    case 'I':
+      *r_raw_type = PROP_RAW_INT;
+      return true;
+    case '?':
+      *r_raw_type = PROP_RAW_BOOLEAN;
+      return true;
+    case 'f':
+      *r_raw_type = PROP_RAW_FLOAT;
+      return true;
+    case 'd':
+      *r_raw_type = PROP_RAW_DOUBLE;
+      return true;
+  }
+
+  return false;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5280,6 +5314,17 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_set(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        /* The buffer holds a different element type (a float64 numpy array
+         * against a float layer for example), raw access converts between
+         * raw types so the values can still be copied in a typed loop. */
+        RawPropertyType buf_raw_type;
+        if (foreach_raw_type_from_buffer_format(buf.format, &buf_raw_type)) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_set(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -5336,6 +5381,15 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_get(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        /* See the matching note in the set branch above. */
+        RawPropertyType buf_raw_type;
+        if (foreach_raw_type_from_buffer_format(buf.format, &buf_raw_type)) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_get(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
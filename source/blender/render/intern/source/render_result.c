@@ -1419,6 +1419,11 @@ static void render_result_exr_file_cache_path(Scene *sce, const char *root, char
   BLI_make_file_string(dirname, r_path, root, filename_full);
 }
 
+/* NOTE: This runs synchronously on the render thread, once per render (not per layer). Moving it
+ * to a background writer thread would need a stable snapshot of the result, which is mutated by
+ * compositing right after and may be re-read through #render_result_exr_file_cache_read before a
+ * deferred write completes. The expensive part, EXR compression, already runs on the OpenEXR
+ * global thread pool (see #imb_initopenexr), so only the file I/O itself is serial here. */
 void render_result_exr_file_cache_write(Render *re)
 {
   RenderResult *rr = re->result;
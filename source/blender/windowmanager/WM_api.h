@@ -32,6 +32,7 @@
 
 /* dna-savable wmStructs here */
 #include "BLI_compiler_attrs.h"
+#include "BLI_sys_types.h"
 #include "DNA_windowmanager_types.h"
 #include "WM_keymap.h"
 
@@ -712,6 +713,7 @@ enum {
   WM_JOB_TYPE_CLIP_PREFETCH,
   WM_JOB_TYPE_SEQ_BUILD_PROXY,
   WM_JOB_TYPE_SEQ_BUILD_PREVIEW,
+  WM_JOB_TYPE_SEQ_BUILD_THUMBNAIL,
   WM_JOB_TYPE_POINTCACHE,
   WM_JOB_TYPE_DPAINT_BAKE,
   WM_JOB_TYPE_ALEMBIC,
@@ -720,6 +722,7 @@ enum {
   WM_JOB_TYPE_LIGHT_BAKE,
   WM_JOB_TYPE_FSMENU_BOOKMARK_VALIDATE,
   WM_JOB_TYPE_QUADRIFLOW_REMESH,
+  WM_JOB_TYPE_VOXEL_REMESH,
   /* add as needed, bake, seq proxy build
    * if having hard coded values is a problem */
 };
@@ -846,6 +849,25 @@ bool WM_event_is_tablet(const struct wmEvent *event);
 bool WM_event_is_ime_switch(const struct wmEvent *event);
 #endif
 
+/* wm_event_latency.c */
+#define WM_EVENT_LATENCY_SAMPLES_MAX 256
+
+/** Per-event latency breakdown, all values in milliseconds. */
+typedef struct WM_EventLatencySample {
+  /** Time spent in the GHOST queue before the window manager received the event. */
+  double queue_ms;
+  /** Handler dispatch, including notifiers and depsgraph updates. */
+  double handlers_ms;
+  /** Draw submission up to the buffer swap. */
+  double draw_ms;
+} WM_EventLatencySample;
+
+void WM_event_latency_mark_event(uint64_t event_time_ms, uint64_t now_ms);
+void WM_event_latency_mark_handled(void);
+void WM_event_latency_mark_swap(void);
+int WM_event_latency_samples_get(WM_EventLatencySample *samples, int samples_max);
+void WM_event_latency_reset(void);
+
 /* wm_tooltip.c */
 typedef struct ARegion *(*wmTooltipInitFn)(struct bContext *C,
                                            struct ARegion *region,
@@ -40,6 +40,7 @@
 #include "BLI_utildefines.h"
 
 #include "BKE_context.h"
+#include "BKE_global.h"
 #include "BKE_image.h"
 #include "BKE_main.h"
 #include "BKE_scene.h"
@@ -47,8 +48,13 @@
 
 #include "GHOST_C-api.h"
 
+#include "BLF_api.h"
+
+#include "PIL_time.h"
+
 #include "ED_node.h"
 #include "ED_screen.h"
+#include "ED_screen_types.h"
 #include "ED_view3d.h"
 
 #include "GPU_draw.h"
@@ -723,6 +729,49 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
   }
 }
 
+/** Event-to-photon latency HUD, enabled with `--debug-events`. */
+static void wm_draw_event_latency_hud(wmWindow *win)
+{
+  WM_EventLatencySample samples[WM_EVENT_LATENCY_SAMPLES_MAX];
+  const int samples_len = WM_event_latency_samples_get(samples, WM_EVENT_LATENCY_SAMPLES_MAX);
+  if (samples_len == 0) {
+    return;
+  }
+
+  /* Note: the last sample is from the previous swap,
+   * the redraw we are part of has not been committed yet. */
+  const WM_EventLatencySample *last = &samples[samples_len - 1];
+  double average = 0.0;
+  for (int i = 0; i < samples_len; i++) {
+    average += samples[i].queue_ms + samples[i].handlers_ms + samples[i].draw_ms;
+  }
+  average /= samples_len;
+
+  char printable[96];
+  BLI_snprintf(printable,
+               sizeof(printable),
+               "latency: %.1f ms (queue %.1f, handlers %.1f, draw %.1f), avg %.1f ms",
+               last->queue_ms + last->handlers_ms + last->draw_ms,
+               last->queue_ms,
+               last->handlers_ms,
+               last->draw_ms,
+               average);
+
+  const int font_id = BLF_default();
+  BLF_color3f(font_id, 1.0f, 1.0f, 1.0f);
+  BLF_enable(font_id, BLF_SHADOW);
+  BLF_shadow(font_id, 5, (const float[4]){0.0f, 0.0f, 0.0f, 1.0f});
+  BLF_shadow_offset(font_id, 1, -1);
+
+  BLF_draw_default(10.0f * U.dpi_fac,
+                   (float)WM_window_pixels_y(win) - 20.0f * U.dpi_fac,
+                   0.0f,
+                   printable,
+                   sizeof(printable));
+
+  BLF_disable(font_id, BLF_SHADOW);
+}
+
 static void wm_draw_window_onscreen(bContext *C, wmWindow *win, int view)
 {
   wmWindowManager *wm = CTX_wm_manager(C);
@@ -798,6 +847,10 @@ static void wm_draw_window_onscreen(bContext *C, wmWindow *win, int view)
   if (wm->drags.first) {
     wm_drags_draw(C, win, NULL);
   }
+
+  if (G.debug & G_DEBUG_EVENTS) {
+    wm_draw_event_latency_hud(win);
+  }
 }
 
 static void wm_draw_window(bContext *C, wmWindow *win)
@@ -1013,6 +1066,18 @@ void wm_draw_update(bContext *C)
       wm_draw_update_clear_window(C, win);
 
       wm_window_swap_buffers(win);
+
+      /* With vsync the swap blocks until presentation, so the time measured here tracks
+       * actual present intervals. Feed it to the playback FPS meter, which is more honest
+       * than the animation timer period it used to show (see #ED_refresh_viewport_fps). */
+      if (screen->animtimer != NULL) {
+        Scene *scene = WM_window_get_active_scene(win);
+        ScreenFrameRateInfo *fpsi = scene->fps_info;
+        if (fpsi != NULL) {
+          fpsi->redrawtime = fpsi->lredrawtime;
+          fpsi->lredrawtime = PIL_check_seconds_timer();
+        }
+      }
     }
   }
 
@@ -1020,6 +1085,9 @@ void wm_draw_update(bContext *C)
 
   /* Draw non-windows (surfaces) */
   wm_surfaces_iter(C, wm_draw_surface);
+
+  /* All windows have swapped, the pending input event is on screen now. */
+  WM_event_latency_mark_swap();
 }
 
 void wm_draw_region_clear(wmWindow *win, ARegion *UNUSED(region))
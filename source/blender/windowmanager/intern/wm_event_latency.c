@@ -0,0 +1,109 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup wm
+ *
+ * Event-to-photon latency tracking.
+ *
+ * Samples the time an input event spends in each stage of the main loop:
+ * waiting in the GHOST queue, handler dispatch (which includes notifier and
+ * depsgraph updates) and draw submission up to the buffer swap. Samples are
+ * kept in a ring buffer so scripts (`bpy.app.event_latency`) and the
+ * `--debug-events` HUD can quantify stroke latency and catch regressions.
+ *
+ * All marks are called from the main loop, no locking is needed.
+ */
+
+#include <string.h>
+
+#include "BLI_utildefines.h"
+
+#include "PIL_time.h"
+
+#include "WM_api.h"
+
+static struct {
+  WM_EventLatencySample ring[WM_EVENT_LATENCY_SAMPLES_MAX];
+  int head;
+  int count;
+
+  /** An event was received and its presentation has not been sampled yet. */
+  bool pending;
+  double queue_ms;
+  /** #PIL_check_seconds_timer values. */
+  double start_time;
+  double handled_time;
+} g_latency = {{{0}}};
+
+void WM_event_latency_mark_event(uint64_t event_time_ms, uint64_t now_ms)
+{
+  if (g_latency.pending) {
+    /* Keep the oldest event that has not been presented yet,
+     * multiple events are usually handled per redraw. */
+    return;
+  }
+  g_latency.pending = true;
+  g_latency.queue_ms = (now_ms > event_time_ms) ? (double)(now_ms - event_time_ms) : 0.0;
+  g_latency.start_time = PIL_check_seconds_timer();
+  g_latency.handled_time = g_latency.start_time;
+}
+
+void WM_event_latency_mark_handled(void)
+{
+  if (!g_latency.pending) {
+    return;
+  }
+  g_latency.handled_time = PIL_check_seconds_timer();
+}
+
+void WM_event_latency_mark_swap(void)
+{
+  if (!g_latency.pending) {
+    return;
+  }
+  const double now = PIL_check_seconds_timer();
+
+  WM_EventLatencySample *sample = &g_latency.ring[g_latency.head];
+  sample->queue_ms = g_latency.queue_ms;
+  sample->handlers_ms = (g_latency.handled_time - g_latency.start_time) * 1000.0;
+  sample->draw_ms = (now - g_latency.handled_time) * 1000.0;
+
+  g_latency.head = (g_latency.head + 1) % WM_EVENT_LATENCY_SAMPLES_MAX;
+  g_latency.count = MIN2(g_latency.count + 1, WM_EVENT_LATENCY_SAMPLES_MAX);
+  g_latency.pending = false;
+}
+
+/**
+ * Copy the recorded samples into \a samples (oldest first).
+ *
+ * \return the number of samples written, at most \a samples_max.
+ */
+int WM_event_latency_samples_get(WM_EventLatencySample *samples, int samples_max)
+{
+  const int count = MIN2(g_latency.count, samples_max);
+  for (int i = 0; i < count; i++) {
+    const int index = (g_latency.head - count + i + WM_EVENT_LATENCY_SAMPLES_MAX) %
+                      WM_EVENT_LATENCY_SAMPLES_MAX;
+    samples[i] = g_latency.ring[index];
+  }
+  return count;
+}
+
+void WM_event_latency_reset(void)
+{
+  memset(&g_latency, 0x0, sizeof(g_latency));
+}
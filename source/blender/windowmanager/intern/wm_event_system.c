@@ -558,6 +558,10 @@ void wm_event_do_notifiers(bContext *C)
 
   /* Autorun warning */
   wm_test_autorun_warning(C);
+
+  /* Handlers, notifiers and the depsgraph refresh are all done,
+   * anything after this is accounted to drawing. */
+  WM_event_latency_mark_handled();
 }
 
 static int wm_event_always_pass(const wmEvent *event)
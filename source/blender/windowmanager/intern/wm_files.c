@@ -1552,6 +1552,60 @@ static bool wm_file_write(bContext *C, const char *filepath, int fileflags, Repo
 /** \name Auto-Save API
  * \{ */
 
+/* Asynchronous auto-save: the undo memfile already is a consistent snapshot of Main, so the only
+ * work left on the main thread is flattening it into one buffer. Streaming that buffer to disk
+ * (the expensive part on heavy files) runs on a worker thread, so the UI never blocks on IO. */
+
+typedef struct AutoSaveThreadData {
+  char filepath[FILE_MAX];
+  /** Flattened memfile snapshot, owned (and freed) by the thread. */
+  void *buffer;
+  size_t buffer_size;
+} AutoSaveThreadData;
+
+static ListBase autosave_threadbase = {NULL, NULL};
+static bool autosave_thread_active = false;
+
+static void *wm_autosave_write_thread_fn(void *arg)
+{
+  AutoSaveThreadData *data = arg;
+
+  BLO_memfile_buffer_write_file(data->buffer, data->buffer_size, data->filepath);
+
+  MEM_freeN(data->buffer);
+  MEM_freeN(data);
+  return NULL;
+}
+
+/* Wait for a previous asynchronous auto-save to hit the disk, no-op when none is in flight.
+ * Must be called before reading back or deleting the auto-save file. */
+static void wm_autosave_write_join(void)
+{
+  if (autosave_thread_active) {
+    BLI_threadpool_end(&autosave_threadbase);
+    autosave_thread_active = false;
+  }
+}
+
+static void wm_autosave_write_async(MemFile *memfile, const char *filepath)
+{
+  /* Only one auto-save may be in flight at a time (it is normally long finished by the time the
+   * next timer fires, so this does not stall in practice). */
+  wm_autosave_write_join();
+
+  AutoSaveThreadData *data = MEM_mallocN(sizeof(*data), __func__);
+  BLI_strncpy(data->filepath, filepath, sizeof(data->filepath));
+  data->buffer = BLO_memfile_flatten(memfile, &data->buffer_size);
+  if (data->buffer == NULL) {
+    MEM_freeN(data);
+    return;
+  }
+
+  BLI_threadpool_init(&autosave_threadbase, wm_autosave_write_thread_fn, 1);
+  BLI_threadpool_insert(&autosave_threadbase, data);
+  autosave_thread_active = true;
+}
+
 void wm_autosave_location(char *filepath)
 {
   const int pid = abs(getpid());
@@ -1625,7 +1679,8 @@ void wm_autosave_timer(Main *bmain, wmWindowManager *wm, wmTimer *UNUSED(wt))
     /* fast save of last undobuffer, now with UI */
     struct MemFile *memfile = ED_undosys_stack_memfile_get_active(wm->undo_stack);
     if (memfile) {
-      BLO_memfile_write_file(memfile, filepath);
+      /* Stream to disk from a worker thread, so heavy shots don't freeze the UI. */
+      wm_autosave_write_async(memfile, filepath);
     }
   }
   else {
@@ -1653,6 +1708,9 @@ void wm_autosave_delete(void)
 {
   char filename[FILE_MAX];
 
+  /* May still be streaming to the file we are about to delete/rename. */
+  wm_autosave_write_join();
+
   wm_autosave_location(filename);
 
   if (BLI_exists(filename)) {
@@ -1673,6 +1731,9 @@ void wm_autosave_read(bContext *C, ReportList *reports)
 {
   char filename[FILE_MAX];
 
+  /* Ensure any in-flight auto-save is complete before reading it back. */
+  wm_autosave_write_join();
+
   wm_autosave_location(filename);
   WM_file_read(C, filename, reports);
 }
@@ -290,6 +290,8 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   BLI_assert((G.fileflags & G_FILE_NO_UI) == 0);
 
+  BKE_blender_startup_profile_stage("wm_init_types");
+
   wm_homefile_read(C,
                    NULL,
                    G.factory_startup,
@@ -300,6 +302,8 @@ void WM_init(bContext *C, int argc, const char **argv)
                    WM_init_state_app_template_get(),
                    &is_factory_startup);
 
+  BKE_blender_startup_profile_stage("startup_blend");
+
   /* Call again to set from userpreferences... */
   BLT_lang_set(NULL);
 
@@ -339,6 +343,8 @@ void WM_init(bContext *C, int argc, const char **argv)
   BPY_python_start(argc, argv);
 
   BPY_python_reset(C);
+
+  BKE_blender_startup_profile_stage("python_init");
 #else
   (void)argc; /* unused */
   (void)argv; /* unused */
@@ -67,6 +67,18 @@
  *
  * When job is done:
  * - it puts timer to sleep (or removes?)
+ *
+ * Scheduling notes:
+ * - Every running job owns exactly one thread; the heavy lifting inside a job goes through
+ *   the shared BLI_task scheduler, so the total number of workers stays bounded no matter
+ *   how many jobs run at once. There is no separate per-job worker budget to negotiate.
+ * - Jobs with the same #wmJob.startjob callback serialize through suspension (see
+ *   #wm_jobs_test_suspend_stop); unrelated jobs run concurrently and only contend inside
+ *   the task scheduler. #WM_JOB_PRIORITY lets a new job stop its running rivals, and
+ *   #WM_JOB_EXCL_RENDER keeps render jobs exclusive among themselves.
+ * - CPU/NUMA placement is handled centrally in BLI_threads (see
+ *   #BLI_thread_put_process_on_fast_node); per-job affinity masks would fight that logic
+ *   and the OS scheduler, so they are deliberately not exposed here.
  */
 
 struct wmJob {
@@ -3336,6 +3336,7 @@ static void WM_OT_redraw_timer(wmOperatorType *ot)
 static int memory_statistics_exec(bContext *UNUSED(C), wmOperator *UNUSED(op))
 {
   MEM_printmemlist_stats();
+  MEM_printmemlist_samples();
   return OPERATOR_FINISHED;
 }
 
@@ -1176,6 +1176,18 @@ static int ghost_event_proc(GHOST_EventHandle evt, GHOST_TUserDataPtr C_void_ptr
   uint64_t time = GHOST_GetEventTime(evt);
 #endif
 
+  /* Track input latency from the GHOST time-stamp (both clocks are GHOST milliseconds). */
+  if (ELEM(type,
+           GHOST_kEventCursorMove,
+           GHOST_kEventButtonDown,
+           GHOST_kEventButtonUp,
+           GHOST_kEventWheel,
+           GHOST_kEventTrackpad,
+           GHOST_kEventKeyDown,
+           GHOST_kEventKeyUp)) {
+    WM_event_latency_mark_event(GHOST_GetEventTime(evt), GHOST_GetMilliSeconds(g_system));
+  }
+
   if (type == GHOST_kEventQuitRequest) {
     /* Find an active window to display quit dialog in. */
     GHOST_WindowHandle ghostwin = GHOST_GetEventWindow(evt);
@@ -1622,6 +1634,19 @@ static int wm_window_timer(const bContext *C)
   return retval;
 }
 
+/* Smallest 'ntime' of all awake timers, -1 when there is none. */
+static double wm_window_timer_next_time(const wmWindowManager *wm)
+{
+  double ntime_min = -1.0;
+
+  LISTBASE_FOREACH (const wmTimer *, wt, &wm->timers) {
+    if ((wt->sleep == 0) && (ntime_min < 0.0 || wt->ntime < ntime_min)) {
+      ntime_min = wt->ntime;
+    }
+  }
+  return ntime_min;
+}
+
 void wm_window_process_events(const bContext *C)
 {
   int hasevent;
@@ -1640,9 +1665,18 @@ void wm_window_process_events(const bContext *C)
   hasevent |= wm_xr_events_handle(CTX_wm_manager(C));
 #endif
 
-  /* no event, we sleep 5 milliseconds */
+  /* No event, sleep until the next timer deadline (at most 5 milliseconds). A fixed
+   * sleep quantizes timer delivery, making animation playback beat against the
+   * display refresh rate. */
   if (hasevent == 0) {
-    PIL_sleep_ms(5);
+    const double ntime = wm_window_timer_next_time(CTX_wm_manager(C));
+    int sleep_ms = 5;
+
+    if (ntime >= 0.0) {
+      const double remaining = ntime - PIL_check_seconds_timer();
+      sleep_ms = min_ii(sleep_ms, max_ii(1, (int)ceil(remaining * 1000.0)));
+    }
+    PIL_sleep_ms(sleep_ms);
   }
 }
 
@@ -293,6 +293,21 @@ int main(int argc,
     }
   }
 
+  /* Enable startup profiling before any of the timed stages run,
+   * the argument itself is parsed (and documented) in `creator_args.c`. */
+  {
+    int i;
+    for (i = 0; i < argc; i++) {
+      if (STREQ(argv[i], "--startup-profile")) {
+        BKE_blender_startup_profile_enable();
+        break;
+      }
+      else if (STREQ(argv[i], "--")) {
+        break;
+      }
+    }
+  }
+
 #ifdef BUILD_DATE
   {
     time_t temp_time = build_commit_timestamp;
@@ -367,6 +382,8 @@ int main(int argc,
 
   DNA_sdna_current_init();
 
+  BKE_blender_startup_profile_stage("dna_init");
+
   BKE_blender_globals_init(); /* blender.c */
 
   BKE_idtype_init();
@@ -384,6 +401,8 @@ int main(int argc,
 
   BKE_callback_global_init();
 
+  BKE_blender_startup_profile_stage("bke_init");
+
   /* First test for background-mode (#Global.background) */
 #ifndef WITH_PYTHON_MODULE
   ba = BLI_argsInit(argc, (const char **)argv); /* skip binary path */
@@ -412,6 +431,8 @@ int main(int argc,
   /* After level 1 arguments, this is so #WM_main_playanim skips #RNA_init. */
   RNA_init();
 
+  BKE_blender_startup_profile_stage("rna_init");
+
   RE_engines_init();
   init_nodesystem();
   psys_init_rng();
@@ -481,6 +502,9 @@ int main(int argc,
   CTX_py_init_set(C, true);
   WM_keyconfig_init(C);
 
+  BKE_blender_startup_profile_stage("wm_keyconfig_init");
+  BKE_blender_startup_profile_print();
+
 #ifdef WITH_FREESTYLE
   /* Initialize Freestyle. */
   FRS_initialize();
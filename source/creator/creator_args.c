@@ -40,11 +40,13 @@
 #  include "BLI_string.h"
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
+#  include "BLI_task.h"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 
 #  include "BLO_readfile.h" /* only for BLO_has_bfile_extension */
 
+#  include "BKE_blender.h"
 #  include "BKE_blender_version.h"
 #  include "BKE_context.h"
 
@@ -569,6 +571,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_argsPrintArgDoc(ba, "--log-show-basename");
   BLI_argsPrintArgDoc(ba, "--log-show-backtrace");
   BLI_argsPrintArgDoc(ba, "--log-show-timestamp");
+  BLI_argsPrintArgDoc(ba, "--log-buffer");
   BLI_argsPrintArgDoc(ba, "--log-file");
 
   printf("\n");
@@ -589,6 +592,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_argsPrintArgDoc(ba, "--debug-cycles");
 #  endif
   BLI_argsPrintArgDoc(ba, "--debug-memory");
+  BLI_argsPrintArgDoc(ba, "--debug-memory-sample");
   BLI_argsPrintArgDoc(ba, "--debug-jobs");
   BLI_argsPrintArgDoc(ba, "--debug-python");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph");
@@ -598,6 +602,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-no-threads");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-time");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-pretty");
+  BLI_argsPrintArgDoc(ba, "--debug-depsgraph-cache");
   BLI_argsPrintArgDoc(ba, "--debug-gpu");
   BLI_argsPrintArgDoc(ba, "--debug-gpumem");
   BLI_argsPrintArgDoc(ba, "--debug-gpu-shaders");
@@ -612,6 +617,8 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
 
   printf("\n");
   BLI_argsPrintArgDoc(ba, "--debug-fpe");
+  BLI_argsPrintArgDoc(ba, "--debug-task-trace");
+  BLI_argsPrintArgDoc(ba, "--startup-profile");
   BLI_argsPrintArgDoc(ba, "--disable-crash-handler");
   BLI_argsPrintArgDoc(ba, "--disable-abort-handler");
 
@@ -826,6 +833,18 @@ static int arg_handle_log_show_timestamp_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_log_buffer_set_doc[] =
+    "\n\t"
+    "Queue log messages in memory and write them from a background thread.\n"
+    "\tAvoids slowing down the logging threads, at the cost of delayed output.";
+static int arg_handle_log_buffer_set(int UNUSED(argc),
+                                     const char **UNUSED(argv),
+                                     void *UNUSED(data))
+{
+  CLG_output_buffered_set(true);
+  return 0;
+}
+
 static const char arg_handle_log_file_set_doc[] =
     "<filename>\n"
     "\tSet a file to output the log to.";
@@ -981,6 +1000,9 @@ static const char arg_handle_debug_mode_generic_set_doc_depsgraph_no_threads[] =
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_pretty[] =
     "\n\t"
     "Enable colors for dependency graph debug messages.";
+static const char arg_handle_debug_mode_generic_set_doc_depsgraph_cache[] =
+    "\n\t"
+    "Enable an on-disk cache of dependency graph relations next to the .blend file.";
 static const char arg_handle_debug_mode_generic_set_doc_gpumem[] =
     "\n\t"
     "Enable GPU memory stats in status bar.";
@@ -993,6 +1015,41 @@ static int arg_handle_debug_mode_generic_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_startup_profile_enable_doc[] =
+    "\n\t"
+    "Print per-stage startup timings as a single JSON line on exit of initialization.";
+static int arg_handle_startup_profile_enable(int UNUSED(argc),
+                                             const char **UNUSED(argv),
+                                             void *UNUSED(data))
+{
+  /* Also scanned for before argument parsing in `main()`,
+   * so the measurement covers the earliest stages. */
+  BKE_blender_startup_profile_enable();
+  return 0;
+}
+
+static void task_trace_write_atexit(void *user_data)
+{
+  BLI_task_trace_stop_and_write(user_data);
+}
+
+static const char arg_handle_debug_task_trace_set_doc[] =
+    "<file>\n"
+    "\tRecord task scheduler activity and write a Chrome trace JSON file "
+    "(open in chrome://tracing) on exit.";
+static int arg_handle_debug_task_trace_set(int argc, const char **argv, void *UNUSED(data))
+{
+  if (argc > 1) {
+    static char trace_filepath[FILE_MAX];
+    BLI_strncpy(trace_filepath, argv[1], sizeof(trace_filepath));
+    BLI_task_trace_start();
+    BKE_blender_atexit_register(task_trace_write_atexit, trace_filepath);
+    return 1;
+  }
+  printf("\nError: you must specify an output file after '%s'.\n", argv[0]);
+  return 0;
+}
+
 static const char arg_handle_debug_mode_io_doc[] =
     "\n\t"
     "Enable debug messages for I/O (Collada, ...).";
@@ -1059,6 +1116,20 @@ static int arg_handle_debug_mode_memory_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_debug_mode_memory_sample_set_doc[] =
+    "\n\t"
+    "Sample allocations to attribute memory use to call sites\n"
+    "\t(much cheaper than --debug-memory, sizes are estimates).\n"
+    "\tPrint the result with the Memory Statistics operator.";
+static int arg_handle_debug_mode_memory_sample_set(int UNUSED(argc),
+                                                   const char **UNUSED(argv),
+                                                   void *UNUSED(data))
+{
+  /* A prime interval avoids sampling in step with allocation patterns. */
+  MEM_set_memory_sampling(61);
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -2076,6 +2147,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_argsAdd(ba, 1, NULL, "--log-show-basename", CB(arg_handle_log_show_basename_set), ba);
   BLI_argsAdd(ba, 1, NULL, "--log-show-backtrace", CB(arg_handle_log_show_backtrace_set), ba);
   BLI_argsAdd(ba, 1, NULL, "--log-show-timestamp", CB(arg_handle_log_show_timestamp_set), ba);
+  BLI_argsAdd(ba, 1, NULL, "--log-buffer", CB(arg_handle_log_buffer_set), ba);
   BLI_argsAdd(ba, 1, NULL, "--log-file", CB(arg_handle_log_file_set), ba);
 
   BLI_argsAdd(ba, 1, "-d", "--debug", CB(arg_handle_debug_mode_set), ba);
@@ -2147,6 +2219,12 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_argsAdd(ba, 1, NULL, "--debug-cycles", CB(arg_handle_debug_mode_cycles), NULL);
 #  endif
   BLI_argsAdd(ba, 1, NULL, "--debug-memory", CB(arg_handle_debug_mode_memory_set), NULL);
+  BLI_argsAdd(
+      ba, 1, NULL, "--debug-memory-sample", CB(arg_handle_debug_mode_memory_sample_set), NULL);
+
+  BLI_argsAdd(ba, 1, NULL, "--startup-profile", CB(arg_handle_startup_profile_enable), NULL);
+
+  BLI_argsAdd(ba, 1, NULL, "--debug-task-trace", CB(arg_handle_debug_task_trace_set), NULL);
 
   BLI_argsAdd(ba, 1, NULL, "--debug-value", CB(arg_handle_debug_value_set), NULL);
   BLI_argsAdd(ba,
@@ -2203,6 +2281,12 @@ void main_args_setup(bContext *C, bArgs *ba)
               "--debug-depsgraph-pretty",
               CB_EX(arg_handle_debug_mode_generic_set, depsgraph_pretty),
               (void *)G_DEBUG_DEPSGRAPH_PRETTY);
+  BLI_argsAdd(ba,
+              1,
+              NULL,
+              "--debug-depsgraph-cache",
+              CB_EX(arg_handle_debug_mode_generic_set, depsgraph_cache),
+              (void *)G_DEBUG_DEPSGRAPH_CACHE);
   BLI_argsAdd(ba,
               1,
               NULL,
@@ -51,6 +51,8 @@
 #  include "BLI_utildefines.h"
 #  include BLI_SYSTEM_PID_H
 
+#  include "CLG_log.h"
+
 #  include "BKE_appdir.h" /* BKE_tempdir_base */
 #  include "BKE_blender_version.h"
 #  include "BKE_global.h"
@@ -105,6 +107,10 @@ static void sig_handle_crash(int signum)
   /* Might be called after WM/Main exit, so needs to be careful about NULL-checking before
    * de-referencing. */
 
+  /* When log output is buffered, write out what's queued before anything else,
+   * those messages are likely the most useful clue to the crash. */
+  CLG_buffered_flush();
+
   wmWindowManager *wm = G_MAIN ? G_MAIN->wm.first : NULL;
 
 #  ifdef USE_WRITE_CRASH_BLEND
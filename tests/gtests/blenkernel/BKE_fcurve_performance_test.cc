@@ -0,0 +1,83 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 by Blender Foundation.
+ */
+#include "testing/testing.h"
+
+#include <cmath>
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BKE_fcurve.h"
+
+#include "ED_keyframing.h"
+
+#include "DNA_anim_types.h"
+
+#include "PIL_time.h"
+}
+
+#define NUM_RUN_AVERAGED 8
+#define NUM_KEYFRAMES 10000
+#define NUM_SAMPLES 100000
+
+/* Print a greppable single line result, so throughput can be tracked per commit:
+ * $ BKE_fcurve_performance | grep BENCHMARK_JSON */
+static void print_json_result(const char *name, const int items, const double avg_seconds)
+{
+  printf("BENCHMARK_JSON {\"name\": \"%s\", \"items\": %d, \"avg_seconds\": %.9f}\n",
+         name,
+         items,
+         avg_seconds);
+}
+
+TEST(fcurve_performance, EvaluateSweep)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 0; i < NUM_KEYFRAMES; i++) {
+    insert_vert_fcurve(
+        fcu, (float)i, (float)(i % 7), BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+  }
+
+  /* Sample well inside the keyed range, stepping by a non-integer amount so both the
+   * 'on key' and 'between keyframes' code paths are exercised. */
+  const float step = (float)(NUM_KEYFRAMES - 2) / (float)NUM_SAMPLES;
+  double averaged_timing = 0.0;
+  float sink = 0.0f;
+
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    const double time_start = PIL_check_seconds_timer();
+
+    float evaltime = 0.5f;
+    for (int i = 0; i < NUM_SAMPLES; i++, evaltime += step) {
+      sink += evaluate_fcurve(fcu, evaltime);
+    }
+
+    averaged_timing += PIL_check_seconds_timer() - time_start;
+  }
+
+  printf("\tfcurve_evaluate_sweep: done in %fs on average over %d runs (sink %f)\n",
+         averaged_timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED,
+         sink);
+  print_json_result("fcurve_evaluate_sweep", NUM_KEYFRAMES, averaged_timing / NUM_RUN_AVERAGED);
+
+  EXPECT_TRUE(std::isfinite(sink));
+
+  BKE_fcurve_free(fcu);
+}
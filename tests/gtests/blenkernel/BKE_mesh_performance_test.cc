@@ -0,0 +1,105 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 by Blender Foundation.
+ */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BKE_mesh.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+
+#include "PIL_time.h"
+}
+
+#define NUM_RUN_AVERAGED 8
+/* A GRID_DIM^2 quad grid, in the size range of a production sculpt/animation mesh. */
+#define GRID_DIM 512
+
+/* Print a greppable single line result, so throughput can be tracked per commit:
+ * $ BKE_mesh_performance | grep BENCHMARK_JSON */
+static void print_json_result(const char *name, const int items, const double avg_seconds)
+{
+  printf("BENCHMARK_JSON {\"name\": \"%s\", \"items\": %d, \"avg_seconds\": %.9f}\n",
+         name,
+         items,
+         avg_seconds);
+}
+
+TEST(mesh_performance, CalcNormalsPolyGrid)
+{
+  const int verts_dim = GRID_DIM + 1;
+  const int totvert = verts_dim * verts_dim;
+  const int totpoly = GRID_DIM * GRID_DIM;
+  const int totloop = totpoly * 4;
+
+  MVert *mvert = (MVert *)MEM_callocN(sizeof(*mvert) * totvert, __func__);
+  MPoly *mpoly = (MPoly *)MEM_callocN(sizeof(*mpoly) * totpoly, __func__);
+  MLoop *mloop = (MLoop *)MEM_callocN(sizeof(*mloop) * totloop, __func__);
+  float(*poly_normals)[3] = (float(*)[3])MEM_mallocN(sizeof(*poly_normals) * totpoly, __func__);
+
+  for (int y = 0; y < verts_dim; y++) {
+    for (int x = 0; x < verts_dim; x++) {
+      MVert *mv = &mvert[y * verts_dim + x];
+      mv->co[0] = (float)x;
+      mv->co[1] = (float)y;
+      /* Not flat, so normals actually vary. */
+      mv->co[2] = (float)((x * y) % 5);
+    }
+  }
+
+  for (int y = 0; y < GRID_DIM; y++) {
+    for (int x = 0; x < GRID_DIM; x++) {
+      const int poly_index = y * GRID_DIM + x;
+      MPoly *mp = &mpoly[poly_index];
+      MLoop *ml = &mloop[poly_index * 4];
+
+      mp->loopstart = poly_index * 4;
+      mp->totloop = 4;
+      ml[0].v = y * verts_dim + x;
+      ml[1].v = y * verts_dim + x + 1;
+      ml[2].v = (y + 1) * verts_dim + x + 1;
+      ml[3].v = (y + 1) * verts_dim + x;
+    }
+  }
+
+  double averaged_timing = 0.0;
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    const double time_start = PIL_check_seconds_timer();
+
+    BKE_mesh_calc_normals_poly(
+        mvert, NULL, totvert, mloop, mpoly, totloop, totpoly, poly_normals, false);
+
+    averaged_timing += PIL_check_seconds_timer() - time_start;
+  }
+
+  printf("\tmesh_calc_normals_poly: done in %fs on average over %d runs\n",
+         averaged_timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED);
+  print_json_result("mesh_calc_normals_poly", totpoly, averaged_timing / NUM_RUN_AVERAGED);
+
+  /* Quads share the same winding, all normals must point up-ish. */
+  EXPECT_GT(poly_normals[0][2], 0.0f);
+  EXPECT_GT(poly_normals[totpoly - 1][2], 0.0f);
+
+  MEM_freeN(poly_normals);
+  MEM_freeN(mloop);
+  MEM_freeN(mpoly);
+  MEM_freeN(mvert);
+}
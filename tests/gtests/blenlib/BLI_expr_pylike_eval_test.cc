@@ -102,6 +102,10 @@ TEST_PARSE_FAIL(BadArgCount2, "sqrt(1,2)")
 TEST_PARSE_FAIL(BadArgCount3, "pi()")
 TEST_PARSE_FAIL(BadArgCount4, "max()")
 TEST_PARSE_FAIL(BadArgCount5, "min()")
+TEST_PARSE_FAIL(BadArgCount6, "lerp(1,2)")
+TEST_PARSE_FAIL(BadArgCount7, "clamp()")
+TEST_PARSE_FAIL(BadArgCount8, "clamp(1,2)")
+TEST_PARSE_FAIL(BadArgCount9, "smoothstep(0,1,2,3)")
 
 TEST_PARSE_FAIL(Truncated1, "(1+2")
 TEST_PARSE_FAIL(Truncated2, "1 if 2")
@@ -157,6 +161,27 @@ TEST_EVAL(FMod, "fmod(x, 2)", 3.5, 1.5)
 TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
+TEST_CONST(Lerp1, "lerp(-10,10,0)", -10.0)
+TEST_CONST(Lerp2, "lerp(-10,10,0.25)", -5.0)
+TEST_CONST(Lerp3, "lerp(-10,10,1)", 10.0)
+TEST_EVAL(Lerp1, "lerp(-10,10,x)", 0.75, 5.0)
+TEST_EVAL(Lerp2, "lerp(-10,x,0.25)", 10.0, -5.0)
+
+TEST_CONST(Clamp1, "clamp(-0.1)", 0.0)
+TEST_CONST(Clamp2, "clamp(0.5)", 0.5)
+TEST_CONST(Clamp3, "clamp(1.5)", 1.0)
+TEST_EVAL(Clamp1, "clamp(x)", 1.5, 1.0)
+TEST_EVAL(Clamp2, "clamp(x,0.2,0.7)", 0.5, 0.5)
+TEST_EVAL(Clamp3, "clamp(x,0.2,0.7)", 1.5, 0.7)
+TEST_EVAL(Clamp4, "clamp(x,0.2,0.7)", 0.0, 0.2)
+
+TEST_CONST(Smoothstep1, "smoothstep(0,1,0)", 0.0)
+TEST_CONST(Smoothstep2, "smoothstep(0,1,1)", 1.0)
+TEST_CONST(Smoothstep3, "smoothstep(0,1,0.5)", 0.5)
+TEST_EVAL(Smoothstep1, "smoothstep(-10,10,x)", -10.0, 0.0)
+TEST_EVAL(Smoothstep2, "smoothstep(-10,10,x)", -5.0, 0.15625)
+TEST_EVAL(Smoothstep3, "smoothstep(-10,10,x)", 10.0, 1.0)
+
 TEST_RESULT(Min1, "min(3,1,2)", 1.0)
 TEST_RESULT(Max1, "max(3,1,2)", 3.0)
 TEST_RESULT(Min2, "min(1,2,3)", 1.0)
@@ -0,0 +1,132 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include "BLI_flathash.h"
+#include "BLI_ghash.h"
+#include "BLI_rand.h"
+#include "BLI_utildefines.h"
+}
+
+#define TESTCASE_SIZE 10000
+
+/* Keys/data are mere random integers stored in pointers, like in the GHash tests. */
+
+static void init_keys(unsigned int keys[TESTCASE_SIZE], const int seed)
+{
+  RNG *rng = BLI_rng_new(seed);
+  unsigned int *k;
+  int i;
+
+  for (i = 0, k = keys; i < TESTCASE_SIZE;) {
+    int j, t = BLI_rng_get_uint(rng);
+    for (j = i; j--;) {
+      if (keys[j] == (unsigned int)t) {
+        continue;
+      }
+    }
+    *k = t;
+    i++;
+    k++;
+  }
+  BLI_rng_free(rng);
+}
+
+/* Insert then lookup all keys, ensuring we do get back the expected stored 'data'. */
+TEST(flathash, InsertLookup)
+{
+  FlatHash *fh = BLI_flathash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+  unsigned int keys[TESTCASE_SIZE], *k;
+  int i;
+
+  init_keys(keys, 0);
+
+  for (i = TESTCASE_SIZE, k = keys; i--; k++) {
+    BLI_flathash_insert(fh, POINTER_FROM_UINT(*k), POINTER_FROM_UINT(*k));
+  }
+
+  EXPECT_EQ(BLI_flathash_len(fh), TESTCASE_SIZE);
+
+  for (i = TESTCASE_SIZE, k = keys; i--; k++) {
+    void *v = BLI_flathash_lookup(fh, POINTER_FROM_UINT(*k));
+    EXPECT_EQ(POINTER_AS_UINT(v), *k);
+  }
+
+  EXPECT_FALSE(BLI_flathash_haskey(fh, POINTER_FROM_UINT(0xffffffff)));
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+/* Insert, remove all, then re-insert, exercising deleted-slot reuse and rehashing. */
+TEST(flathash, InsertRemove)
+{
+  FlatHash *fh = BLI_flathash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+  unsigned int keys[TESTCASE_SIZE], *k;
+  int i;
+
+  init_keys(keys, 10);
+
+  for (i = TESTCASE_SIZE, k = keys; i--; k++) {
+    BLI_flathash_insert(fh, POINTER_FROM_UINT(*k), POINTER_FROM_UINT(*k));
+  }
+
+  EXPECT_EQ(BLI_flathash_len(fh), TESTCASE_SIZE);
+
+  for (i = TESTCASE_SIZE, k = keys; i--; k++) {
+    EXPECT_TRUE(BLI_flathash_remove(fh, POINTER_FROM_UINT(*k), NULL, NULL));
+  }
+
+  EXPECT_EQ(BLI_flathash_len(fh), 0);
+
+  for (i = TESTCASE_SIZE, k = keys; i--; k++) {
+    EXPECT_EQ(BLI_flathash_lookup(fh, POINTER_FROM_UINT(*k)), (void *)NULL);
+    BLI_flathash_insert(fh, POINTER_FROM_UINT(*k), POINTER_FROM_UINT(*k));
+  }
+
+  EXPECT_EQ(BLI_flathash_len(fh), TESTCASE_SIZE);
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+/* Reinsert semantics: overwrites existing pairs, returns whether one was replaced. */
+TEST(flathash, Reinsert)
+{
+  FlatHash *fh = BLI_flathash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+
+  EXPECT_FALSE(BLI_flathash_reinsert(fh, POINTER_FROM_UINT(10), POINTER_FROM_UINT(1), NULL, NULL));
+  EXPECT_TRUE(BLI_flathash_reinsert(fh, POINTER_FROM_UINT(10), POINTER_FROM_UINT(2), NULL, NULL));
+  EXPECT_EQ(BLI_flathash_len(fh), 1);
+  EXPECT_EQ(POINTER_AS_UINT(BLI_flathash_lookup(fh, POINTER_FROM_UINT(10))), 2);
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
+
+/* Iterate all entries exactly once. */
+TEST(flathash, Iter)
+{
+  FlatHash *fh = BLI_flathash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+  unsigned int keys[TESTCASE_SIZE], *k;
+  unsigned long long sum_keys = 0, sum_iter = 0;
+  int i;
+
+  init_keys(keys, 30);
+
+  for (i = TESTCASE_SIZE, k = keys; i--; k++) {
+    BLI_flathash_insert(fh, POINTER_FROM_UINT(*k), POINTER_FROM_UINT(*k));
+    sum_keys += *k;
+  }
+
+  FlatHashIterator fhi;
+  int len = 0;
+  FLATHASH_ITER (fhi, fh) {
+    EXPECT_EQ(BLI_flathashIterator_getKey(&fhi), BLI_flathashIterator_getValue(&fhi));
+    sum_iter += POINTER_AS_UINT(BLI_flathashIterator_getKey(&fhi));
+    len++;
+  }
+
+  EXPECT_EQ(len, TESTCASE_SIZE);
+  EXPECT_EQ(sum_iter, sum_keys);
+
+  BLI_flathash_free(fh, NULL, NULL);
+}
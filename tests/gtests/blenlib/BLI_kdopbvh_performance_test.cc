@@ -0,0 +1,101 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_kdopbvh.h"
+#include "BLI_math.h"
+#include "BLI_rand.h"
+#include "BLI_utildefines.h"
+
+#include "PIL_time.h"
+}
+
+#define NUM_RUN_AVERAGED 8
+#define NUM_RAYS 100000
+
+/* Print a greppable single line result, so throughput can be tracked per commit:
+ * $ BLI_kdopbvh_performance | grep BENCHMARK_JSON */
+static void print_json_result(const char *name, const int items, const double avg_seconds)
+{
+  printf("BENCHMARK_JSON {\"name\": \"%s\", \"items\": %d, \"avg_seconds\": %.9f}\n",
+         name,
+         items,
+         avg_seconds);
+}
+
+static BVHTree *bvhtree_from_random_points(RNG *rng, float (*points)[3], const int tot_points)
+{
+  BVHTree *tree = BLI_bvhtree_new(tot_points, 0.0f, 4, 6);
+
+  for (int i = 0; i < tot_points; i++) {
+    points[i][0] = BLI_rng_get_float(rng);
+    points[i][1] = BLI_rng_get_float(rng);
+    points[i][2] = BLI_rng_get_float(rng);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  return tree;
+}
+
+static void bvhtree_raycast_bench(const int tot_points, const char *id)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  RNG *rng = BLI_rng_new(0);
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(*points) * tot_points, __func__);
+  BVHTree *tree = bvhtree_from_random_points(rng, points, tot_points);
+
+  const float dir[3] = {0.0f, 0.0f, -1.0f};
+  int tot_hits = 0;
+  double averaged_timing = 0.0;
+
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    const double time_start = PIL_check_seconds_timer();
+
+    for (int i = 0; i < NUM_RAYS; i++) {
+      float co[3];
+      BVHTreeRayHit hit;
+
+      co[0] = BLI_rng_get_float(rng);
+      co[1] = BLI_rng_get_float(rng);
+      co[2] = 2.0f;
+
+      hit.index = -1;
+      hit.dist = BVH_RAYCAST_DIST_MAX;
+      if (BLI_bvhtree_ray_cast(tree, co, dir, 0.1f, &hit, NULL, NULL) != -1) {
+        tot_hits++;
+      }
+    }
+
+    averaged_timing += PIL_check_seconds_timer() - time_start;
+  }
+
+  printf("\t%s: done in %fs on average over %d runs (%d hits)\n",
+         id,
+         averaged_timing / NUM_RUN_AVERAGED,
+         NUM_RUN_AVERAGED,
+         tot_hits);
+  print_json_result(id, tot_points, averaged_timing / NUM_RUN_AVERAGED);
+
+  EXPECT_GT(tot_hits, 0);
+
+  BLI_bvhtree_free(tree);
+  MEM_freeN(points);
+  BLI_rng_free(rng);
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(kdopbvh_performance, RayCast10K)
+{
+  bvhtree_raycast_bench(10000, "bvhtree_raycast_10K");
+}
+
+TEST(kdopbvh_performance, RayCast1M)
+{
+  bvhtree_raycast_bench(1000000, "bvhtree_raycast_1M");
+}
@@ -98,6 +98,32 @@ TEST(listbase, FindLinkOrIndex)
   BLI_freelistN(&lb);
 }
 
+TEST(listbase, AsArray)
+{
+  ListBase lb;
+  void *link1 = MEM_callocN(sizeof(Link), "link1");
+  void *link2 = MEM_callocN(sizeof(Link), "link2");
+  int array_len;
+  void **array;
+
+  /* Empty list */
+  BLI_listbase_clear(&lb);
+  array = BLI_listbase_as_array(&lb, &array_len);
+  EXPECT_EQ(array, (void **)NULL);
+  EXPECT_EQ(array_len, 0);
+
+  /* Two links, in order */
+  BLI_addtail(&lb, link1);
+  BLI_addtail(&lb, link2);
+  array = BLI_listbase_as_array(&lb, &array_len);
+  EXPECT_EQ(array_len, 2);
+  EXPECT_EQ(array[0], link1);
+  EXPECT_EQ(array[1], link2);
+  MEM_freeN(array);
+
+  BLI_freelistN(&lb);
+}
+
 /* -------------------------------------------------------------------- */
 /* Sort utilities & test */
 
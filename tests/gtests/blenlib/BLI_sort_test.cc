@@ -0,0 +1,80 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_rand.h"
+#include "BLI_sort.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+}
+
+#define NUM_ITEMS 100000
+
+struct SortItem {
+  int key;
+  /* Original position, to check stability. */
+  int index;
+};
+
+static int sort_item_cmp(const void *a, const void *b, void *UNUSED(thunk))
+{
+  const SortItem *item_a = (const SortItem *)a;
+  const SortItem *item_b = (const SortItem *)b;
+  return (item_a->key > item_b->key) - (item_a->key < item_b->key);
+}
+
+static void sort_items_init(SortItem *items, int items_len, int keys_num)
+{
+  RNG *rng = BLI_rng_new(0);
+  for (int i = 0; i < items_len; i++) {
+    /* Few distinct keys, so there are plenty of ties to check stability with. */
+    items[i].key = BLI_rng_get_int(rng) % keys_num;
+    items[i].index = i;
+  }
+  BLI_rng_free(rng);
+}
+
+TEST(sort, ParallelStable)
+{
+  SortItem *items = (SortItem *)MEM_mallocN(sizeof(*items) * NUM_ITEMS, __func__);
+
+  BLI_threadapi_init();
+
+  sort_items_init(items, NUM_ITEMS, 64);
+  BLI_sort_parallel(items, NUM_ITEMS, sizeof(*items), sort_item_cmp, NULL);
+
+  for (int i = 1; i < NUM_ITEMS; i++) {
+    EXPECT_LE(items[i - 1].key, items[i].key);
+    if (items[i - 1].key == items[i].key) {
+      /* Stability: ties keep their original order. */
+      EXPECT_LT(items[i - 1].index, items[i].index);
+    }
+  }
+
+  BLI_threadapi_exit();
+
+  MEM_freeN(items);
+}
+
+TEST(sort, ParallelSmall)
+{
+  /* Small arrays take the serial fallback. */
+  SortItem items[7];
+
+  BLI_threadapi_init();
+
+  sort_items_init(items, ARRAY_SIZE(items), 3);
+  BLI_sort_parallel(items, ARRAY_SIZE(items), sizeof(*items), sort_item_cmp, NULL);
+
+  for (int i = 1; i < (int)ARRAY_SIZE(items); i++) {
+    EXPECT_LE(items[i - 1].key, items[i].key);
+    if (items[i - 1].key == items[i].key) {
+      EXPECT_LT(items[i - 1].index, items[i].index);
+    }
+  }
+
+  BLI_threadapi_exit();
+}